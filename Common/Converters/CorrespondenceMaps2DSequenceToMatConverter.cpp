@@ -29,6 +29,7 @@
 
 #include "CorrespondenceMaps2DSequenceToMatConverter.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 #include<iostream>
 
 namespace Converters {
@@ -45,6 +46,7 @@ using namespace BaseTypesWrapper;
 
 const cv::Mat CorrespondenceMaps2DSequenceToMatConverter::Convert(const CorrespondenceMap2DWrapper::CorrespondenceMaps2DSequenceConstPtr& correspondenceMapsSequence)
 	{
+	TRACE_SCOPE_CATEGORY("CorrespondenceMaps2DSequenceToMatConverter", "Converter");
 	return ComputeMeasurementMatrix(*correspondenceMapsSequence);
 	}
 
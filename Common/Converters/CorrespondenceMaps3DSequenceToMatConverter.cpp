@@ -29,6 +29,7 @@
 
 #include "CorrespondenceMaps3DSequenceToMatConverter.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 #include<iostream>
 
 namespace Converters {
@@ -45,6 +46,7 @@ using namespace BaseTypesWrapper;
 
 const cv::Mat CorrespondenceMaps3DSequenceToMatConverter::Convert(const CorrespondenceMap3DWrapper::CorrespondenceMaps3DSequenceConstPtr& correspondenceMapsSequence)
 	{
+	TRACE_SCOPE_CATEGORY("CorrespondenceMaps3DSequenceToMatConverter", "Converter");
 	return ComputeMeasurementMatrix(*correspondenceMapsSequence);
 	}
 
@@ -29,6 +29,7 @@
 
 #include "EigenTransformToTransform3DConverter.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 #include <Eigen/Geometry>
 
 namespace Converters {
@@ -43,6 +44,7 @@ using namespace PoseWrapper;
  */
 const PoseWrapper::Transform3DConstPtr EigenTransformToTransform3DConverter::Convert(const Eigen::Matrix4f& transform)
 	{
+	TRACE_SCOPE_CATEGORY("EigenTransformToTransform3DConverter", "Converter");
 	ASSERT(transform(3,0) == 0 && transform(3,1) == 0 && transform(3,2) == 0 && transform(3,3) == 1, "EigenTransformToTransform3DConverter, An invalid transformation matrix was passed.")
 	Eigen::Matrix3f eigenRotationMatrix = transform.block(0,0,3,3);
 	ASSERT_CLOSE(std::abs(eigenRotationMatrix.determinant()), 1.00, 0.00001, "EigenTransformToTransform3DConverter, An invalid rotation was passed during conversion.")
@@ -29,6 +29,7 @@
 
 #include "FrameToMatConverter.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 #include<iostream>
 
 namespace Converters {
@@ -44,7 +45,7 @@ using namespace FrameWrapper;
 
 const cv::Mat FrameToMatConverter::Convert(const FrameWrapper::FrameConstPtr& frame)
 	{
-
+	TRACE_SCOPE_CATEGORY("FrameToMatConverter", "Converter");
 	if (GetFrameHeight(*frame) == 0 && GetFrameWidth(*frame) == 0)
 		{
 		return cv::Mat();
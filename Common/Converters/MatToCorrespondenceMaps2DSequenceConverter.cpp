@@ -29,6 +29,7 @@
 
 #include "MatToCorrespondenceMaps2DSequenceConverter.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 #include<iostream>
 
 namespace Converters {
@@ -44,6 +45,7 @@ using namespace CorrespondenceMap2DWrapper;
 
 CorrespondenceMaps2DSequenceConstPtr MatToCorrespondenceMaps2DSequenceConverter::Convert(const cv::Mat&  measurementMatrix)
 	{
+	TRACE_SCOPE_CATEGORY("MatToCorrespondenceMaps2DSequenceConverter", "Converter");
 	CorrespondenceMaps2DSequencePtr conversion = NewCorrespondenceMaps2DSequence();
 	
 	ASSERT( measurementMatrix.rows % 2 == 0, "MatToCorrespondenceMaps2DSequenceConverter error, measumentMatrix row number should be even");
@@ -29,6 +29,7 @@
 
 #include "MatToCorrespondenceMaps3DSequenceConverter.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 #include<iostream>
 
 namespace Converters {
@@ -44,6 +45,7 @@ using namespace CorrespondenceMap3DWrapper;
 
 CorrespondenceMaps3DSequenceConstPtr MatToCorrespondenceMaps3DSequenceConverter::Convert(const cv::Mat&  measurementMatrix)
 	{
+	TRACE_SCOPE_CATEGORY("MatToCorrespondenceMaps3DSequenceConverter", "Converter");
 	CorrespondenceMaps3DSequencePtr conversion = NewCorrespondenceMaps3DSequence();
 	
 	ASSERT( measurementMatrix.rows % 2 == 0, "MatToCorrespondenceMaps3DSequenceConverter error, measumentMatrix row number should be even");
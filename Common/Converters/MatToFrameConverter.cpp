@@ -29,6 +29,7 @@
 
 #include "MatToFrameConverter.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 namespace Converters {
 
@@ -43,6 +44,7 @@ using namespace FrameWrapper;
 
 FrameConstPtr MatToFrameConverter::Convert(const cv::Mat& image)
 	{
+	TRACE_SCOPE_CATEGORY("MatToFrameConverter", "Converter");
 	FramePtr frame = FrameWrapper::NewFrame();
 	if (image.rows == 0 && image.cols == 0)
 		//set status empty
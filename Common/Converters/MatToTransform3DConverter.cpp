@@ -29,6 +29,7 @@
 
 #include "MatToTransform3DConverter.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 #include <Eigen/Geometry>
 
 namespace Converters {
@@ -43,6 +44,7 @@ using namespace PoseWrapper;
  */
 const PoseWrapper::Transform3DConstPtr MatToTransform3DConverter::Convert(const cv::Mat transform)
 	{
+	TRACE_SCOPE_CATEGORY("MatToTransform3DConverter", "Converter");
 	ASSERT(transform.rows >= 3 && transform.cols >= 4, "MatToTransform3DConverter Error, an invalid matrix was passed");
 	ASSERT(transform.type() == CV_32FC1 || transform.type() == CV_64FC1, "MatToTransform3DConverter Error, an invalid matrix type was passed");
 
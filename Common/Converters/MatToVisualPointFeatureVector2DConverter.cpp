@@ -29,6 +29,7 @@
 
 #include "MatToVisualPointFeatureVector2DConverter.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 
 namespace Converters {
@@ -43,6 +44,7 @@ using namespace VisualPointFeatureVector2DWrapper;
  */
 VisualPointFeatureVector2DConstPtr MatToVisualPointFeatureVector2DConverter::Convert(const cv::Mat& featuresMatrix)
 	{
+	TRACE_SCOPE_CATEGORY("MatToVisualPointFeatureVector2DConverter", "Converter");
 	VisualPointFeatureVector2DPtr conversion = new VisualPointFeatureVector2D();
 
 	if (featuresMatrix.cols == 0 && featuresMatrix.rows == 0)
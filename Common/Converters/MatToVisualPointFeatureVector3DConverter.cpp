@@ -29,6 +29,7 @@
 
 #include "MatToVisualPointFeatureVector3DConverter.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 
 namespace Converters {
@@ -43,6 +44,7 @@ using namespace VisualPointFeatureVector3DWrapper;
  */
 VisualPointFeatureVector3DConstPtr MatToVisualPointFeatureVector3DConverter::Convert(const cv::Mat& featuresMatrix)
 	{
+	TRACE_SCOPE_CATEGORY("MatToVisualPointFeatureVector3DConverter", "Converter");
 	VisualPointFeatureVector3DPtr conversion = NewVisualPointFeatureVector3D();
 
 	if (featuresMatrix.cols == 0 && featuresMatrix.rows == 0)
@@ -23,6 +23,7 @@
 #include "OctreeToPclOctreeConverter.hpp"
 #include <Converters/PointCloudToPclPointCloudConverter.hpp>
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 namespace Converters
 {
@@ -30,6 +31,7 @@ namespace Converters
 //=====================================================================================================================
 const pcl::octree::OctreePointCloudSearch<pcl::PointXYZ> OctreeToPclOctreeConverter::Convert(const asn1SccOctree& data)
 {
+    TRACE_SCOPE_CATEGORY("OctreeToPclOctreeConverter", "Converter");
     pcl::octree::OctreePointCloudSearch<pcl::PointXYZ> pcl_octree (data.resolution);
     pcl_octree.setInputCloud (Converters::PointCloudToPclPointCloudConverter().Convert(&data.pointCloud));
     pcl_octree.addPointsFromInputCloud();
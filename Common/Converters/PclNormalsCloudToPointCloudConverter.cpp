@@ -29,6 +29,7 @@
 
 #include "PclNormalsCloudToPointCloudConverter.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 #include <stdio.h>
 #include <math.h>
 
@@ -44,6 +45,7 @@ using namespace PointCloudWrapper;
  */
 PointCloudConstPtr PclNormalsCloudToPointCloudConverter::Convert(const pcl::PointCloud<pcl::Normal>::ConstPtr& pointCloud)
 	{
+	TRACE_SCOPE_CATEGORY("PclNormalsCloudToPointCloudConverter", "Converter");
 	PointCloudPtr asnPointCloud = new PointCloud();
 	for(unsigned pointIndex = 0; pointIndex < pointCloud->points.size(); pointIndex++)
 		{
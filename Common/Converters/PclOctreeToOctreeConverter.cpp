@@ -23,6 +23,7 @@
 #include "PclOctreeToOctreeConverter.hpp"
 #include <Converters/PclPointCloudToPointCloudConverter.hpp>
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 #include <stdio.h>
 
 namespace Converters
@@ -31,6 +32,7 @@ namespace Converters
 //=====================================================================================================================
 asn1SccOctree * PclOctreeToOctreeConverter::Convert(const pcl::octree::OctreePointCloudSearch<pcl::PointXYZ>& tree)
 {
+    TRACE_SCOPE_CATEGORY("PclOctreeToOctreeConverter", "Converter");
     asn1SccOctree * output_octree = new asn1SccOctree();
     output_octree->pointCloud = *Converters::PclPointCloudToPointCloudConverter().Convert(tree.getInputCloud());
     output_octree->resolution = tree.getResolution();
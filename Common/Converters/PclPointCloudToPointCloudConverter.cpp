@@ -29,6 +29,7 @@
 
 #include "PclPointCloudToPointCloudConverter.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 #include <stdio.h>
 #include <math.h>
 
@@ -44,6 +45,7 @@ using namespace PointCloudWrapper;
  */
 PointCloudConstPtr PclPointCloudToPointCloudConverter::Convert(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr& pointCloud)
 	{
+	TRACE_SCOPE_CATEGORY("PclPointCloudToPointCloudConverter", "Converter");
 	PointCloudPtr asnPointCloud = new PointCloud();
 	for(unsigned pointIndex = 0; pointIndex < pointCloud->points.size(); pointIndex++)
 		{
@@ -29,6 +29,7 @@
 
 #include "PclPointCloudToVisualPointFeatureVector3DConverter.hpp"
 #include <Errors/AssertOnTest.hpp>
+#include <Macros/TracingMacros.hpp>
 #include <boost/make_shared.hpp>
 
 
@@ -45,6 +46,7 @@ using namespace SupportTypes;
  */
 const VisualPointFeatureVector3DConstPtr PclPointCloudToVisualPointFeatureVector3DConverter::Convert(const PointCloudWithFeatures<MaxSizeHistogram>& featuresCloud)
 	{
+	TRACE_SCOPE_CATEGORY("PclPointCloudToVisualPointFeatureVector3DConverter", "Converter");
 	VisualPointFeatureVector3DWrapper::VisualPointFeatureVector3DPtr conversion = VisualPointFeatureVector3DWrapper::NewVisualPointFeatureVector3D();
 	
 	for(unsigned pointIndex = 0; pointIndex < featuresCloud.pointCloud->points.size(); pointIndex++)
@@ -63,6 +65,7 @@ const VisualPointFeatureVector3DConstPtr PclPointCloudToVisualPointFeatureVector
 
 const VisualPointFeatureVector3DConstPtr PclPointCloudToVisualPointFeatureVector3DConverter::Convert(const PointCloudWithFeatures<pcl::SHOT352>& featuresCloud)
 	{	
+	TRACE_SCOPE_CATEGORY("PclPointCloudToVisualPointFeatureVector3DConverter", "Converter");
 	VisualPointFeatureVector3DPtr conversion = NewVisualPointFeatureVector3D();
 	
 	for(unsigned pointIndex = 0; pointIndex < featuresCloud.pointCloud->points.size(); pointIndex++)
@@ -81,6 +84,7 @@ const VisualPointFeatureVector3DConstPtr PclPointCloudToVisualPointFeatureVector
 
 const VisualPointFeatureVector3DConstPtr PclPointCloudToVisualPointFeatureVector3DConverter::Convert(const PointCloudWithFeatures<pcl::PFHSignature125>& featuresCloud)
 	{	
+	TRACE_SCOPE_CATEGORY("PclPointCloudToVisualPointFeatureVector3DConverter", "Converter");
 	VisualPointFeatureVector3DPtr conversion = NewVisualPointFeatureVector3D();
 	
 	for(unsigned pointIndex = 0; pointIndex < featuresCloud.pointCloud->points.size(); pointIndex++)
@@ -29,6 +29,7 @@
 
 #include "PointCloudToPclNormalsCloudConverter.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 #include <stdio.h>
 #include <math.h>
 #include <boost/smart_ptr.hpp>
@@ -46,6 +47,7 @@ using namespace PointCloudWrapper;
  */
  pcl::PointCloud<pcl::Normal>::ConstPtr PointCloudToPclNormalsCloudConverter::Convert(const  PointCloudConstPtr& pointCloud)
 	{
+	TRACE_SCOPE_CATEGORY("PointCloudToPclNormalsCloudConverter", "Converter");
 	pcl::PointCloud<pcl::Normal>::Ptr pclNormalsCloud = boost::make_shared<pcl::PointCloud<pcl::Normal> >();
 	for(int pointIndex = 0; pointIndex < GetNumberOfPoints(*pointCloud); pointIndex++)
 		{
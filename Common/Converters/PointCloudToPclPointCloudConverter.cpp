@@ -29,6 +29,7 @@
 
 #include "PointCloudToPclPointCloudConverter.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 #include <stdio.h>
 #include <math.h>
 #include <boost/smart_ptr.hpp>
@@ -46,6 +47,7 @@ using namespace PointCloudWrapper;
  */
  pcl::PointCloud<pcl::PointXYZ>::ConstPtr PointCloudToPclPointCloudConverter::Convert(const  PointCloudConstPtr& pointCloud)
 	{
+	TRACE_SCOPE_CATEGORY("PointCloudToPclPointCloudConverter", "Converter");
 	pcl::PointCloud<pcl::PointXYZ>::Ptr pclPointCloud = boost::make_shared<pcl::PointCloud<pcl::PointXYZ> >();
 	for(int pointIndex = 0; pointIndex < GetNumberOfPoints(*pointCloud); pointIndex++)
 		{
@@ -25,6 +25,7 @@
 
 #include "StdVectorOfStringsToStringSequenceConverter.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 #include <string.h>
 
 namespace Converters
@@ -32,6 +33,7 @@ namespace Converters
 
 const asn1SccStringSequence StdVectorOfStringsToStringSequenceConverter::Convert(const std::vector<std::string>& stringVector)
 {
+    TRACE_SCOPE_CATEGORY("StdVectorOfStringsToStringSequenceConverter", "Converter");
     asn1SccStringSequence stringSequence;
     stringSequence.nCount = stringVector.size();
     unsigned int size = stringVector.size();
@@ -33,12 +33,14 @@
 
 #include "StringSequenceToStdVectorOfStringsConverter.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 namespace Converters
 {
 
 const std::vector<std::string> StringSequenceToStdVectorOfStringsConverter::Convert(const asn1SccStringSequence& stringSequence)
 {
+    TRACE_SCOPE_CATEGORY("StringSequenceToStdVectorOfStringsConverter", "Converter");
     std::vector<std::string> strings_vector;
     for( int index = 0; index < stringSequence.nCount; index ++ )
     {
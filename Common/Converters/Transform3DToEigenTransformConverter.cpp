@@ -29,6 +29,7 @@
 
 #include "Transform3DToEigenTransformConverter.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 #include <Eigen/Geometry>
 
 namespace Converters {
@@ -43,6 +44,7 @@ using namespace PoseWrapper;
  */
 const Eigen::Matrix4f Transform3DToEigenTransformConverter::Convert(const PoseWrapper::Transform3DConstPtr& transform)
 	{
+	TRACE_SCOPE_CATEGORY("Transform3DToEigenTransformConverter", "Converter");
 	Eigen::Matrix4f conversion;
 
 	Eigen::Quaternionf eigenRotation( GetWOrientation(*transform), GetXOrientation(*transform), GetYOrientation(*transform), GetZOrientation(*transform));
@@ -29,6 +29,7 @@
 
 #include "Transform3DToMatConverter.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 #include <Eigen/Geometry>
 
 namespace Converters {
@@ -43,6 +44,7 @@ using namespace PoseWrapper;
  */
 const cv::Mat Transform3DToMatConverter::Convert(const PoseWrapper::Transform3DConstPtr& transform)
 	{
+	TRACE_SCOPE_CATEGORY("Transform3DToMatConverter", "Converter");
 	Eigen::Matrix4f conversion;
 
 	Eigen::Quaternionf eigenRotation( GetWOrientation(*transform), GetXOrientation(*transform), GetYOrientation(*transform), GetZOrientation(*transform));
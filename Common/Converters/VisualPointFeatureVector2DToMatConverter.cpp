@@ -29,6 +29,7 @@
 
 #include "VisualPointFeatureVector2DToMatConverter.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 
 namespace Converters {
@@ -43,16 +44,28 @@ using namespace VisualPointFeatureVector2DWrapper;
  */
 const cv::Mat VisualPointFeatureVector2DToMatConverter::Convert(const VisualPointFeatureVector2DConstPtr& featuresVector)
 	{
+	TRACE_SCOPE_CATEGORY("VisualPointFeatureVector2DToMatConverter", "Converter");
 	if (GetNumberOfPoints(*featuresVector) == 0)
 		return cv::Mat();
 
-	int descriptorSize = GetNumberOfDescriptorComponents(*featuresVector, 0);	
+	// Binary descriptors are expanded to one float component per byte
+	bool binaryDescriptors = (GetDescriptorType(*featuresVector) == BINARY_DESCRIPTORS);
+	int descriptorSize = binaryDescriptors ? GetNumberOfBinaryDescriptorBytes(*featuresVector, 0) : GetNumberOfDescriptorComponents(*featuresVector, 0);
 	cv::Mat conversion(GetNumberOfPoints(*featuresVector), 2 + descriptorSize, CV_32FC1, cv::Scalar(0));
 	for(int pointIndex = 0; pointIndex < GetNumberOfPoints(*featuresVector); pointIndex++)
 		{
 		conversion.at<float>(pointIndex, 0) = GetXCoordinate(*featuresVector, pointIndex);
 		conversion.at<float>(pointIndex, 1) = GetYCoordinate(*featuresVector, pointIndex);
 
+		if (binaryDescriptors)
+			{
+			ASSERT(descriptorSize == GetNumberOfBinaryDescriptorBytes(*featuresVector, pointIndex), "VisualPointFeatureVector2DToMatConverter: Descriptors do not have the same size.");
+			const uint8_t* descriptor = GetBinaryDescriptor(*featuresVector, pointIndex);
+			for(int byteIndex = 0; byteIndex < descriptorSize; byteIndex++)
+				conversion.at<float>(pointIndex, byteIndex + 2) = descriptor[byteIndex];
+			continue;
+			}
+
 		ASSERT(descriptorSize == GetNumberOfDescriptorComponents(*featuresVector, pointIndex), "VisualPointFeatureVector2DToMatConverter: Descriptors do not have the same size.");
 		for(int componentIndex = 0; componentIndex < descriptorSize; componentIndex++)
 			conversion.at<float>(pointIndex, componentIndex + 2) = GetDescriptorComponent(*featuresVector, pointIndex, componentIndex);
@@ -29,6 +29,7 @@
 
 #include "VisualPointFeatureVector3DToMatConverter.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 
 namespace Converters {
@@ -43,6 +44,7 @@ using namespace VisualPointFeatureVector3DWrapper;
  */
 const cv::Mat VisualPointFeatureVector3DToMatConverter::Convert(const VisualPointFeatureVector3DConstPtr& featuresVector)
 	{	
+	TRACE_SCOPE_CATEGORY("VisualPointFeatureVector3DToMatConverter", "Converter");
 	if (GetNumberOfPoints(*featuresVector) == 0)
 		{
 		return cv::Mat();
@@ -29,6 +29,7 @@
 
 #include "VisualPointFeatureVector3DToPclPointCloudConverter.hpp"
 #include <Errors/AssertOnTest.hpp>
+#include <Macros/TracingMacros.hpp>
 #include <boost/make_shared.hpp>
 
 
@@ -45,6 +46,7 @@ using namespace SupportTypes;
  */
 pcl::PointCloud<pcl::PointXYZ>::ConstPtr VisualPointFeatureVector3DToPclPointCloudConverter::ExtractPointCloud(const VisualPointFeatureVector3DConstPtr& featuresVector)
 	{
+	TRACE_SCOPE_CATEGORY("VisualPointFeatureVector3DToPclPointCloudConverter", "Converter");
 	pcl::PointCloud<pcl::PointXYZ>::Ptr pointCloud = boost::make_shared<pcl::PointCloud<pcl::PointXYZ> >();
 
 	for(int pointIndex = 0; pointIndex < GetNumberOfPoints(*featuresVector); pointIndex++)
@@ -61,6 +63,7 @@ pcl::PointCloud<pcl::PointXYZ>::ConstPtr VisualPointFeatureVector3DToPclPointClo
 
 void VisualPointFeatureVector3DToPclPointCloudConverter::ExtractFeaturesCloud(const VisualPointFeatureVector3DConstPtr& featuresVector, PointCloudWithFeatures<MaxSizeHistogram>& conversion)
 	{
+	TRACE_SCOPE_CATEGORY("VisualPointFeatureVector3DToPclPointCloudConverter", "Converter");
 	pcl::PointCloud<MaxSizeHistogram >::Ptr featureCloud = boost::make_shared<pcl::PointCloud<MaxSizeHistogram > >();
 	conversion.featureCloud = featureCloud;	
 
@@ -87,6 +90,7 @@ void VisualPointFeatureVector3DToPclPointCloudConverter::ExtractFeaturesCloud(co
 
 void VisualPointFeatureVector3DToPclPointCloudConverter::ExtractFeaturesCloud(const VisualPointFeatureVector3DConstPtr& featuresVector, PointCloudWithFeatures<pcl::SHOT352>& conversion)
 	{
+	TRACE_SCOPE_CATEGORY("VisualPointFeatureVector3DToPclPointCloudConverter", "Converter");
 	pcl::PointCloud<pcl::SHOT352>::Ptr featureCloud = boost::make_shared<pcl::PointCloud<pcl::SHOT352> >();
 
 	conversion.featureCloud = featureCloud;	
@@ -110,6 +114,7 @@ void VisualPointFeatureVector3DToPclPointCloudConverter::ExtractFeaturesCloud(co
 
 void VisualPointFeatureVector3DToPclPointCloudConverter::ExtractFeaturesCloud(const VisualPointFeatureVector3DConstPtr& featuresVector, PointCloudWithFeatures<pcl::PFHSignature125>& conversion)
 	{
+	TRACE_SCOPE_CATEGORY("VisualPointFeatureVector3DToPclPointCloudConverter", "Converter");
 	pcl::PointCloud<pcl::PFHSignature125>::Ptr featureCloud = boost::make_shared<pcl::PointCloud<pcl::PFHSignature125> >();
 
 	conversion.featureCloud = featureCloud;	
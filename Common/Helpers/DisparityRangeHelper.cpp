@@ -0,0 +1,87 @@
+/* --------------------------------------------------------------------------
+*
+* (C) Copyright …
+*
+* ---------------------------------------------------------------------------
+*/
+
+/*!
+ * @file DisparityRangeHelper.cpp
+ * @date 19/10/2026
+ */
+
+/*!
+ * @addtogroup Helpers
+ *
+ * Implementation of the disparity range prediction
+ *
+ * @{
+ */
+/* --------------------------------------------------------------------------
+ *
+ * Includes
+ *
+ * --------------------------------------------------------------------------
+ */
+#include "DisparityRangeHelper.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace Helpers
+{
+/* --------------------------------------------------------------------------
+ *
+ * Functions
+ *
+ * --------------------------------------------------------------------------
+ */
+
+DisparityRange PredictDisparityRange(const int16_t* disparities, int numberOfRows, int numberOfColumns, int rowStride, int disparityScale, int16_t minimumValidDisparity,
+	const DisparityRange& fullRange, int margin)
+	{
+	const int fullNumberOfDisparities = fullRange.numberOfDisparities;
+
+	//Histogram of the valid previous disparities rounded to whole pixels
+	std::vector<int> histogram(fullNumberOfDisparities, 0);
+	int validCount = 0;
+	for (int row = 0; row < numberOfRows; row++)
+		{
+		const int16_t* disparityRow = disparities + row * rowStride;
+		for (int column = 0; column < numberOfColumns; column++)
+			{
+			if (disparityRow[column] >= minimumValidDisparity)
+				{
+				int index = (disparityRow[column] + disparityScale / 2) / disparityScale - fullRange.minimumDisparity;
+				histogram[std::min(fullNumberOfDisparities - 1, std::max(0, index))]++;
+				validCount++;
+				}
+			}
+		}
+	if (validCount * 20 < numberOfRows * numberOfColumns)
+		{
+		return fullRange;
+		}
+
+	const int outliers = validCount / 100;
+	int low = 0;
+	for (int count = histogram[0]; count <= outliers; count += histogram[low])
+		{
+		low++;
+		}
+	int high = fullNumberOfDisparities - 1;
+	for (int count = histogram[high]; count <= outliers; count += histogram[high])
+		{
+		high--;
+		}
+
+	low = std::max(0, low - margin);
+	high = std::min(fullNumberOfDisparities - 1, high + margin);
+	DisparityRange range;
+	range.numberOfDisparities = std::min(fullNumberOfDisparities, ((high - low + 16) / 16) * 16);
+	range.minimumDisparity = fullRange.minimumDisparity + std::min(low, fullNumberOfDisparities - range.numberOfDisparities);
+	return range;
+	}
+
+}
+
+/** @} */
@@ -0,0 +1,67 @@
+/* --------------------------------------------------------------------------
+*
+* (C) Copyright …
+*
+* --------------------------------------------------------------------------
+*/
+
+/*!
+ * @file DisparityRangeHelper.hpp
+ * @date 19/10/2026
+ */
+
+/*!
+ * @addtogroup Helpers
+ *
+ *  Prediction of the disparity range of an image band from the disparities the band had in the previous frame, shared by the stereo matching DFNs that search
+ *  a reduced range on slowly changing views.
+ *
+ * @{
+ */
+
+#ifndef DISPARITY_RANGE_HELPER_HPP
+#define DISPARITY_RANGE_HELPER_HPP
+
+/* --------------------------------------------------------------------------
+ *
+ * Includes
+ *
+ * --------------------------------------------------------------------------
+ */
+#include <stdint.h>
+
+namespace Helpers
+{
+/* --------------------------------------------------------------------------
+ *
+ * Types
+ *
+ * --------------------------------------------------------------------------
+ */
+struct DisparityRange
+	{
+	int minimumDisparity; //in whole pixels
+	int numberOfDisparities;
+	};
+
+/* --------------------------------------------------------------------------
+ *
+ * Functions
+ *
+ * --------------------------------------------------------------------------
+ */
+
+/**
+ * Predicts the range searched by a band from its previous disparities, in fixed point with disparityScale steps per pixel, numberOfRows rows of numberOfColumns values
+ * with rowStride values between the starts of two rows. Disparities below minimumValidDisparity are invalid.
+ *
+ * The predicted range spans the previous disparities without the 1% smallest and the 1% largest ones, extended by the margin on both sides, rounded up to a multiple
+ * of 16 and kept inside fullRange. The full range is returned if fewer than 5% of the previous disparities are valid.
+ */
+DisparityRange PredictDisparityRange(const int16_t* disparities, int numberOfRows, int numberOfColumns, int rowStride, int disparityScale, int16_t minimumValidDisparity,
+	const DisparityRange& fullRange, int margin);
+
+}
+#endif
+/* DisparityRangeHelper.hpp */
+/** @} */
@@ -0,0 +1,52 @@
+/* --------------------------------------------------------------------------
+*
+* (C) Copyright …
+*
+* --------------------------------------------------------------------------
+*/
+
+/*!
+ * @file TracingMacros.hpp
+ * @date 19/10/2026
+ * @author Alessandro Bianco
+ */
+
+/*!
+ * @addtogroup Common
+ *
+ *  This is a collection of macros for emitting scoped trace events, see Tracers/ChromeTracer.hpp. The macros are empty in builds without the TRACING preprocessor
+ *  definition (cmake -D TRACING_ENABLED=ON), so instrumented code has no run time cost unless tracing was requested at compile time.
+ *
+ * @{
+ */
+
+#ifndef TRACING_MACROS_HPP
+#define TRACING_MACROS_HPP
+
+#ifndef TRACING // These macros are empty strings in non-TRACING builds
+
+	#define TRACE_SCOPE(name)
+	#define TRACE_SCOPE_CATEGORY(name, category)
+	#define TRACE_START()
+	#define TRACE_STOP()
+	#define TRACE_EXPORT(filePath)
+
+#else
+
+#include <Tracers/ChromeTracer.hpp>
+
+	#define TRACE_CONCATENATE_IMPLEMENTATION(a, b) a##b
+	#define TRACE_CONCATENATE(a, b) TRACE_CONCATENATE_IMPLEMENTATION(a, b)
+
+	#define TRACE_SCOPE_CATEGORY(name, category) \
+		Tracers::ScopedTraceEvent TRACE_CONCATENATE(scopedTraceEvent, __LINE__)(name, category)
+	#define TRACE_SCOPE(name) TRACE_SCOPE_CATEGORY(name, "CDFF")
+	#define TRACE_START() Tracers::ChromeTracer::Start()
+	#define TRACE_STOP() Tracers::ChromeTracer::Stop()
+	#define TRACE_EXPORT(filePath) Tracers::ChromeTracer::Export(filePath)
+
+#endif
+#endif
+
+/* TracingMacros.hpp */
+/** @} */
@@ -0,0 +1,103 @@
+/* --------------------------------------------------------------------------
+*
+* (C) Copyright …
+*
+* --------------------------------------------------------------------------
+*/
+
+/*!
+ * @file EstimationProblem.hpp
+ * @date 19/10/2026
+ * @author Alessandro Bianco
+ */
+
+/*!
+ * @addtogroup Common
+ *
+ *  Interface of a model estimation problem solved by the RobustEstimator: it fits models on minimal samples of its data, and it computes the error of its data
+ *  with respect to a model. The data are indexed from 0 to GetNumberOfData() - 1, a model is an array of GetModelSize() doubles.
+ *
+ *  The methods are const and they are called concurrently by the threads of the estimator, so they must not modify any state of the problem.
+ *
+ * @{
+ */
+
+#ifndef ESTIMATION_PROBLEM_HPP
+#define ESTIMATION_PROBLEM_HPP
+
+/* --------------------------------------------------------------------------
+ *
+ * Includes
+ *
+ * --------------------------------------------------------------------------
+ */
+#include <vector>
+
+namespace RobustEstimation
+{
+
+/* --------------------------------------------------------------------------
+ *
+ * Class definition
+ *
+ * --------------------------------------------------------------------------
+ */
+class EstimationProblem
+	{
+	/* --------------------------------------------------------------------
+	 * Public
+	 * --------------------------------------------------------------------
+	 */
+	public:
+		virtual ~EstimationProblem()
+			{
+
+			}
+
+		virtual int GetNumberOfData() const = 0;
+
+		/*
+		* @brief The number of data in a minimal sample.
+		*/
+		virtual int GetSampleSize() const = 0;
+
+		virtual int GetModelSize() const = 0;
+
+		/*
+		* @brief The maximum number of models fitted on a minimal sample.
+		*/
+		virtual int GetMaximumNumberOfModels() const = 0;
+
+		/*
+		* @brief Fits the models of a minimal sample.
+		*
+		* @param sample, the indices of the GetSampleSize() sampled data.
+		* @param models, the fitted models are written one after the other, it has room for GetMaximumNumberOfModels() models.
+		* @output, the number of fitted models, zero if the sample is degenerate.
+		*/
+		virtual int FitModels(const int* sample, double* models) const = 0;
+
+		/*
+		* @brief Computes the errors of the listed data with respect to the model, the error of data index dataIndices[i] is written in errors[i].
+		* The errors are compared with the inlier threshold of the estimator, so they have to be in the units of the threshold.
+		*/
+		virtual void ComputeErrors(const double* model, const int* dataIndices, int numberOfIndices, float* errors) const = 0;
+
+		/*
+		* @brief Fits the model again on all its inliers, for example by least squares.
+		*
+		* @param inliers, the indices of the inliers of the model.
+		* @param model, on input the model, on output the refined model.
+		* @output, false if the problem does not refine models or the refinement failed, the model is then unchanged.
+		*/
+		virtual bool RefineModel(const std::vector<int>& inliers, double* model) const
+			{
+			return false;
+			}
+	};
+
+}
+
+#endif
+/* EstimationProblem.hpp */
+/** @} */
@@ -0,0 +1,386 @@
+/* --------------------------------------------------------------------------
+*
+* (C) Copyright …
+*
+* ---------------------------------------------------------------------------
+*/
+
+/*!
+ * @file FundamentalMatrixProblem.cpp
+ * @date 19/10/2026
+ * @author Alessandro Bianco
+ */
+
+/*!
+ * @addtogroup Common
+ *
+ * Implementation of the FundamentalMatrixProblem class
+ *
+ *
+ * @{
+ */
+/* --------------------------------------------------------------------------
+ *
+ * Includes
+ *
+ * --------------------------------------------------------------------------
+ */
+#include "FundamentalMatrixProblem.hpp"
+
+#include <Eigen/Core>
+#include <Eigen/Dense>
+#include <Eigen/Eigenvalues>
+
+#include <cmath>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+	#include <immintrin.h>
+	#define ROBUST_ESTIMATION_HAVE_X86_SIMD
+#endif
+
+namespace RobustEstimation
+{
+
+namespace
+	{
+	const int SAMPLE_SIZE = 7;
+	const int MODEL_SIZE = 9;
+	const int MAXIMUM_NUMBER_OF_MODELS = 3;
+	const int GATHER_BLOCK_SIZE = 256;
+
+	inline void ComputeSampsonErrorsRange(const float* model, const float* sourceXList, const float* sourceYList, const float* sinkXList, const float* sinkYList,
+		int firstError, int endError, float* errors)
+		{
+		for (int errorIndex = firstError; errorIndex < endError; errorIndex++)
+			{
+			const float sourceX = sourceXList[errorIndex];
+			const float sourceY = sourceYList[errorIndex];
+			const float sinkX = sinkXList[errorIndex];
+			const float sinkY = sinkYList[errorIndex];
+			const float sinkLineA = model[0] * sourceX + model[1] * sourceY + model[2];
+			const float sinkLineB = model[3] * sourceX + model[4] * sourceY + model[5];
+			const float sinkLineC = model[6] * sourceX + model[7] * sourceY + model[8];
+			const float sourceLineA = model[0] * sinkX + model[3] * sinkY + model[6];
+			const float sourceLineB = model[1] * sinkX + model[4] * sinkY + model[7];
+			const float epipolarError = sinkX * sinkLineA + sinkY * sinkLineB + sinkLineC;
+			const float gradientNorm = sinkLineA * sinkLineA + sinkLineB * sinkLineB + sourceLineA * sourceLineA + sourceLineB * sourceLineB;
+			errors[errorIndex] = epipolarError * epipolarError / gradientNorm;
+			}
+		}
+
+	void ComputeSampsonErrorsScalar(const float* model, const float* sourceXList, const float* sourceYList, const float* sinkXList, const float* sinkYList, int numberOfErrors, float* errors)
+		{
+		ComputeSampsonErrorsRange(model, sourceXList, sourceYList, sinkXList, sinkYList, 0, numberOfErrors, errors);
+		}
+
+#ifdef ROBUST_ESTIMATION_HAVE_X86_SIMD
+	/**
+	 * Eight correspondences at a time with fused multiply-add instructions, the remaining ones one at a time.
+	 */
+	__attribute__((target("avx2,fma")))
+	void ComputeSampsonErrorsAvx2(const float* model, const float* sourceXList, const float* sourceYList, const float* sinkXList, const float* sinkYList, int numberOfErrors, float* errors)
+		{
+		__m256 modelElements[MODEL_SIZE];
+		for (int element = 0; element < MODEL_SIZE; element++)
+			{
+			modelElements[element] = _mm256_set1_ps(model[element]);
+			}
+
+		int errorIndex = 0;
+		for (; errorIndex + 8 <= numberOfErrors; errorIndex += 8)
+			{
+			const __m256 sourceX = _mm256_loadu_ps(sourceXList + errorIndex);
+			const __m256 sourceY = _mm256_loadu_ps(sourceYList + errorIndex);
+			const __m256 sinkX = _mm256_loadu_ps(sinkXList + errorIndex);
+			const __m256 sinkY = _mm256_loadu_ps(sinkYList + errorIndex);
+			const __m256 sinkLineA = _mm256_fmadd_ps(modelElements[0], sourceX, _mm256_fmadd_ps(modelElements[1], sourceY, modelElements[2]));
+			const __m256 sinkLineB = _mm256_fmadd_ps(modelElements[3], sourceX, _mm256_fmadd_ps(modelElements[4], sourceY, modelElements[5]));
+			const __m256 sinkLineC = _mm256_fmadd_ps(modelElements[6], sourceX, _mm256_fmadd_ps(modelElements[7], sourceY, modelElements[8]));
+			const __m256 sourceLineA = _mm256_fmadd_ps(modelElements[0], sinkX, _mm256_fmadd_ps(modelElements[3], sinkY, modelElements[6]));
+			const __m256 sourceLineB = _mm256_fmadd_ps(modelElements[1], sinkX, _mm256_fmadd_ps(modelElements[4], sinkY, modelElements[7]));
+			const __m256 epipolarError = _mm256_fmadd_ps(sinkX, sinkLineA, _mm256_fmadd_ps(sinkY, sinkLineB, sinkLineC));
+			__m256 gradientNorm = _mm256_mul_ps(sinkLineA, sinkLineA);
+			gradientNorm = _mm256_fmadd_ps(sinkLineB, sinkLineB, gradientNorm);
+			gradientNorm = _mm256_fmadd_ps(sourceLineA, sourceLineA, gradientNorm);
+			gradientNorm = _mm256_fmadd_ps(sourceLineB, sourceLineB, gradientNorm);
+			_mm256_storeu_ps(errors + errorIndex, _mm256_div_ps(_mm256_mul_ps(epipolarError, epipolarError), gradientNorm));
+			}
+		ComputeSampsonErrorsRange(model, sourceXList, sourceYList, sinkXList, sinkYList, errorIndex, numberOfErrors, errors);
+		}
+#endif
+
+	/**
+	 * The real roots of c3*x^3 + c2*x^2 + c1*x + c0, by the trigonometric or the Cardano formula, or of the lower degree polynomial when c3 is negligible.
+	 */
+	int SolveCubic(double c3, double c2, double c1, double c0, double* roots)
+		{
+		const double scale = std::max( std::abs(c2), std::max(std::abs(c1), std::abs(c0)) );
+		if (std::abs(c3) <= 1e-12 * scale)
+			{
+			if (std::abs(c2) <= 1e-12 * scale)
+				{
+				if (c1 == 0)
+					{
+					return 0;
+					}
+				roots[0] = -c0 / c1;
+				return 1;
+				}
+			const double discriminant = c1 * c1 - 4 * c2 * c0;
+			if (discriminant < 0)
+				{
+				return 0;
+				}
+			roots[0] = (-c1 + std::sqrt(discriminant)) / (2 * c2);
+			roots[1] = (-c1 - std::sqrt(discriminant)) / (2 * c2);
+			return 2;
+			}
+
+		const double a = c2 / c3;
+		const double b = c1 / c3;
+		const double c = c0 / c3;
+		const double q = (a * a - 3 * b) / 9;
+		const double r = (2 * a * a * a - 9 * a * b + 27 * c) / 54;
+		if (r * r < q * q * q)
+			{
+			const double angle = std::acos( r / std::sqrt(q * q * q) );
+			const double amplitude = -2 * std::sqrt(q);
+			roots[0] = amplitude * std::cos(angle / 3) - a / 3;
+			roots[1] = amplitude * std::cos( (angle + 2 * M_PI) / 3 ) - a / 3;
+			roots[2] = amplitude * std::cos( (angle - 2 * M_PI) / 3 ) - a / 3;
+			return 3;
+			}
+		const double first = -std::copysign( std::cbrt( std::abs(r) + std::sqrt(r * r - q * q * q) ), r );
+		const double second = (first == 0) ? 0 : q / first;
+		roots[0] = first + second - a / 3;
+		return 1;
+		}
+
+	/**
+	 * The similarity that moves the centroid of the points to the origin and their average distance from it to sqrt(2), false if all points coincide.
+	 */
+	bool ComputeNormalization(const float* xList, const float* yList, const int* indices, int numberOfIndices, Eigen::Matrix3d& normalization)
+		{
+		double centroidX = 0;
+		double centroidY = 0;
+		for (int index = 0; index < numberOfIndices; index++)
+			{
+			centroidX += xList[indices[index]];
+			centroidY += yList[indices[index]];
+			}
+		centroidX /= numberOfIndices;
+		centroidY /= numberOfIndices;
+
+		double averageDistance = 0;
+		for (int index = 0; index < numberOfIndices; index++)
+			{
+			averageDistance += std::sqrt( (xList[indices[index]] - centroidX) * (xList[indices[index]] - centroidX) + (yList[indices[index]] - centroidY) * (yList[indices[index]] - centroidY) );
+			}
+		averageDistance /= numberOfIndices;
+		if (averageDistance <= 0)
+			{
+			return false;
+			}
+
+		const double scale = std::sqrt(2.0) / averageDistance;
+		normalization << scale, 0, -scale * centroidX,
+			0, scale, -scale * centroidY,
+			0, 0, 1;
+		return true;
+		}
+	}
+
+/* --------------------------------------------------------------------------
+ *
+ * Public Member Functions
+ *
+ * --------------------------------------------------------------------------
+ */
+
+FundamentalMatrixProblem::FundamentalMatrixProblem() :
+	errorsFunction( SelectErrorsFunction() )
+	{
+
+	}
+
+FundamentalMatrixProblem::~FundamentalMatrixProblem()
+	{
+
+	}
+
+void FundamentalMatrixProblem::ClearCorrespondences()
+	{
+	sourceXList.clear();
+	sourceYList.clear();
+	sinkXList.clear();
+	sinkYList.clear();
+	}
+
+void FundamentalMatrixProblem::AddCorrespondence(float sourceX, float sourceY, float sinkX, float sinkY)
+	{
+	sourceXList.push_back(sourceX);
+	sourceYList.push_back(sourceY);
+	sinkXList.push_back(sinkX);
+	sinkYList.push_back(sinkY);
+	}
+
+int FundamentalMatrixProblem::GetNumberOfData() const
+	{
+	return static_cast<int>( sourceXList.size() );
+	}
+
+int FundamentalMatrixProblem::GetSampleSize() const
+	{
+	return SAMPLE_SIZE;
+	}
+
+int FundamentalMatrixProblem::GetModelSize() const
+	{
+	return MODEL_SIZE;
+	}
+
+int FundamentalMatrixProblem::GetMaximumNumberOfModels() const
+	{
+	return MAXIMUM_NUMBER_OF_MODELS;
+	}
+
+int FundamentalMatrixProblem::FitModels(const int* sample, double* models) const
+	{
+	return FitFundamentalMatrices(sample, SAMPLE_SIZE, models);
+	}
+
+/**
+ * The coordinates of the listed correspondences are gathered in contiguous blocks, so that the errors of a block are computed together.
+ */
+void FundamentalMatrixProblem::ComputeErrors(const double* model, const int* dataIndices, int numberOfIndices, float* errors) const
+	{
+	float floatModel[MODEL_SIZE];
+	for (int element = 0; element < MODEL_SIZE; element++)
+		{
+		floatModel[element] = static_cast<float>(model[element]);
+		}
+
+	float sourceXBlock[GATHER_BLOCK_SIZE], sourceYBlock[GATHER_BLOCK_SIZE], sinkXBlock[GATHER_BLOCK_SIZE], sinkYBlock[GATHER_BLOCK_SIZE];
+	for (int firstIndex = 0; firstIndex < numberOfIndices; firstIndex += GATHER_BLOCK_SIZE)
+		{
+		const int blockSize = std::min(GATHER_BLOCK_SIZE, numberOfIndices - firstIndex);
+		for (int blockIndex = 0; blockIndex < blockSize; blockIndex++)
+			{
+			const int dataIndex = dataIndices[firstIndex + blockIndex];
+			sourceXBlock[blockIndex] = sourceXList[dataIndex];
+			sourceYBlock[blockIndex] = sourceYList[dataIndex];
+			sinkXBlock[blockIndex] = sinkXList[dataIndex];
+			sinkYBlock[blockIndex] = sinkYList[dataIndex];
+			}
+		errorsFunction(floatModel, sourceXBlock, sourceYBlock, sinkXBlock, sinkYBlock, blockSize, errors + firstIndex);
+		}
+	}
+
+bool FundamentalMatrixProblem::RefineModel(const std::vector<int>& inliers, double* model) const
+	{
+	if (inliers.size() < 8)
+		{
+		return false;
+		}
+	return FitFundamentalMatrices(inliers.data(), static_cast<int>(inliers.size()), model) == 1;
+	}
+
+/* --------------------------------------------------------------------------
+ *
+ * Private Member Functions
+ *
+ * --------------------------------------------------------------------------
+ */
+
+/**
+ * Each correspondence gives a linear equation in the nine elements of F. With seven correspondences the solutions are the combinations a*F1 + (1-a)*F2 of the
+ * two null vectors F1 and F2, and the rank two constraint det(F) = 0 is a cubic in a, whose coefficients are interpolated from its values at a = 0, 1, -1 and 2.
+ * With more correspondences the solution is the least squares null vector, whose smallest singular value is then set to zero. The null vectors are the
+ * eigenvectors of the smallest eigenvalues of A^T * A, and the matrices are scaled to unit Frobenius norm.
+ */
+int FundamentalMatrixProblem::FitFundamentalMatrices(const int* indices, int numberOfIndices, double* models) const
+	{
+	Eigen::Matrix3d sourceNormalization, sinkNormalization;
+	if (!ComputeNormalization(sourceXList.data(), sourceYList.data(), indices, numberOfIndices, sourceNormalization) ||
+		!ComputeNormalization(sinkXList.data(), sinkYList.data(), indices, numberOfIndices, sinkNormalization))
+		{
+		return 0;
+		}
+
+	Eigen::Matrix<double, 9, 9> normalMatrix = Eigen::Matrix<double, 9, 9>::Zero();
+	for (int index = 0; index < numberOfIndices; index++)
+		{
+		const int dataIndex = indices[index];
+		const double sourceX = sourceNormalization(0, 0) * sourceXList[dataIndex] + sourceNormalization(0, 2);
+		const double sourceY = sourceNormalization(1, 1) * sourceYList[dataIndex] + sourceNormalization(1, 2);
+		const double sinkX = sinkNormalization(0, 0) * sinkXList[dataIndex] + sinkNormalization(0, 2);
+		const double sinkY = sinkNormalization(1, 1) * sinkYList[dataIndex] + sinkNormalization(1, 2);
+		Eigen::Matrix<double, 9, 1> row;
+		row << sinkX * sourceX, sinkX * sourceY, sinkX, sinkY * sourceX, sinkY * sourceY, sinkY, sourceX, sourceY, 1;
+		normalMatrix.selfadjointView<Eigen::Lower>().rankUpdate(row);
+		}
+	Eigen::SelfAdjointEigenSolver< Eigen::Matrix<double, 9, 9> > eigenSolver(normalMatrix.selfadjointView<Eigen::Lower>());
+	const Eigen::Matrix<double, 9, 9>& eigenvectors = eigenSolver.eigenvectors();
+
+	Eigen::Matrix3d normalizedModels[MAXIMUM_NUMBER_OF_MODELS];
+	int numberOfModels = 0;
+	if (numberOfIndices == SAMPLE_SIZE)
+		{
+		Eigen::Matrix3d firstNullMatrix = Eigen::Map<const Eigen::Matrix<double, 3, 3, Eigen::RowMajor> >( eigenvectors.col(0).data() );
+		Eigen::Matrix3d secondNullMatrix = Eigen::Map<const Eigen::Matrix<double, 3, 3, Eigen::RowMajor> >( eigenvectors.col(1).data() );
+		const double determinantAtZero = secondNullMatrix.determinant();
+		const double determinantAtOne = firstNullMatrix.determinant();
+		const double determinantAtMinusOne = (2 * secondNullMatrix - firstNullMatrix).determinant();
+		const double determinantAtTwo = (2 * firstNullMatrix - secondNullMatrix).determinant();
+		const double c0 = determinantAtZero;
+		const double c2 = (determinantAtOne + determinantAtMinusOne) / 2 - c0;
+		const double oddSum = (determinantAtOne - determinantAtMinusOne) / 2;
+		const double c3 = (determinantAtTwo - 4 * c2 - c0 - 2 * oddSum) / 6;
+		const double c1 = oddSum - c3;
+
+		double roots[3];
+		const int numberOfRoots = SolveCubic(c3, c2, c1, c0, roots);
+		for (int rootIndex = 0; rootIndex < numberOfRoots; rootIndex++)
+			{
+			normalizedModels[numberOfModels++] = roots[rootIndex] * firstNullMatrix + (1 - roots[rootIndex]) * secondNullMatrix;
+			}
+		}
+	else
+		{
+		Eigen::Matrix3d leastSquaresMatrix = Eigen::Map<const Eigen::Matrix<double, 3, 3, Eigen::RowMajor> >( eigenvectors.col(0).data() );
+		Eigen::JacobiSVD<Eigen::Matrix3d> svd(leastSquaresMatrix, Eigen::ComputeFullU | Eigen::ComputeFullV);
+		Eigen::Vector3d singularValues = svd.singularValues();
+		singularValues(2) = 0;
+		normalizedModels[numberOfModels++] = svd.matrixU() * singularValues.asDiagonal() * svd.matrixV().transpose();
+		}
+
+	int numberOfValidModels = 0;
+	for (int modelIndex = 0; modelIndex < numberOfModels; modelIndex++)
+		{
+		Eigen::Matrix3d fundamentalMatrix = sinkNormalization.transpose() * normalizedModels[modelIndex] * sourceNormalization;
+		const double norm = fundamentalMatrix.norm();
+		if (!(norm > 0) || !std::isfinite(norm))
+			{
+			continue;
+			}
+		Eigen::Map< Eigen::Matrix<double, 3, 3, Eigen::RowMajor> >(models + numberOfValidModels * MODEL_SIZE) = fundamentalMatrix / norm;
+		numberOfValidModels++;
+		}
+	return numberOfValidModels;
+	}
+
+FundamentalMatrixProblem::ErrorsFunction FundamentalMatrixProblem::SelectErrorsFunction()
+	{
+#ifdef ROBUST_ESTIMATION_HAVE_X86_SIMD
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+		{
+		return &ComputeSampsonErrorsAvx2;
+		}
+#endif
+	return &ComputeSampsonErrorsScalar;
+	}
+
+}
+
+/** @} */
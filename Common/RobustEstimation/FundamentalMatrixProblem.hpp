@@ -0,0 +1,101 @@
+/* --------------------------------------------------------------------------
+*
+* (C) Copyright …
+*
+* --------------------------------------------------------------------------
+*/
+
+/*!
+ * @file FundamentalMatrixProblem.hpp
+ * @date 19/10/2026
+ * @author Alessandro Bianco
+ */
+
+/*!
+ * @addtogroup Common
+ *
+ *  Estimation of the fundamental matrix F of a camera pair from 2D correspondences, such that sink^T * F * source = 0 for each inlier correspondence.
+ *  The models are fitted on minimal samples of seven correspondences, and refined on their inliers by the normalized eight point algorithm.
+ *  The error of a correspondence is its squared Sampson distance in pixels, computed with AVX2 instructions on x86 processors that support them, chosen at run time.
+ *  A model is a 3x3 matrix stored row by row.
+ *
+ * @{
+ */
+
+#ifndef FUNDAMENTAL_MATRIX_PROBLEM_HPP
+#define FUNDAMENTAL_MATRIX_PROBLEM_HPP
+
+/* --------------------------------------------------------------------------
+ *
+ * Includes
+ *
+ * --------------------------------------------------------------------------
+ */
+#include "EstimationProblem.hpp"
+
+#include <vector>
+
+namespace RobustEstimation
+{
+
+/* --------------------------------------------------------------------------
+ *
+ * Class definition
+ *
+ * --------------------------------------------------------------------------
+ */
+class FundamentalMatrixProblem : public EstimationProblem
+	{
+	/* --------------------------------------------------------------------
+	 * Public
+	 * --------------------------------------------------------------------
+	 */
+	public:
+		FundamentalMatrixProblem();
+		~FundamentalMatrixProblem();
+
+		void ClearCorrespondences();
+		void AddCorrespondence(float sourceX, float sourceY, float sinkX, float sinkY);
+
+		int GetNumberOfData() const override;
+		int GetSampleSize() const override;
+		int GetModelSize() const override;
+		int GetMaximumNumberOfModels() const override;
+		int FitModels(const int* sample, double* models) const override;
+		void ComputeErrors(const double* model, const int* dataIndices, int numberOfIndices, float* errors) const override;
+		bool RefineModel(const std::vector<int>& inliers, double* model) const override;
+
+	/* --------------------------------------------------------------------
+	 * Protected
+	 * --------------------------------------------------------------------
+	 */
+	protected:
+
+	/* --------------------------------------------------------------------
+	 * Private
+	 * --------------------------------------------------------------------
+	 */
+	private:
+		typedef void (*ErrorsFunction)(const float* model, const float* sourceXList, const float* sourceYList, const float* sinkXList, const float* sinkYList, int numberOfErrors, float* errors);
+
+		//The coordinates are stored in separate arrays, as the errors functions take them
+		std::vector<float> sourceXList;
+		std::vector<float> sourceYList;
+		std::vector<float> sinkXList;
+		std::vector<float> sinkYList;
+		ErrorsFunction errorsFunction;
+
+		/*
+		* @brief Fits the fundamental matrices whose epipolar constraints are satisfied by the listed correspondences, by least squares when there are more than eight,
+		* with rank two enforced; the points are normalized as in Richard Hartley (1997), "In Defense of the Eight-Point Algorithm".
+		*/
+		int FitFundamentalMatrices(const int* indices, int numberOfIndices, double* models) const;
+
+		static ErrorsFunction SelectErrorsFunction();
+	};
+
+}
+
+#endif
+/* FundamentalMatrixProblem.hpp */
+/** @} */
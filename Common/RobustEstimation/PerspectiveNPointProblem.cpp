@@ -0,0 +1,439 @@
+/* --------------------------------------------------------------------------
+*
+* (C) Copyright …
+*
+* ---------------------------------------------------------------------------
+*/
+
+/*!
+ * @file PerspectiveNPointProblem.cpp
+ * @date 19/10/2026
+ * @author Alessandro Bianco
+ */
+
+/*!
+ * @addtogroup Common
+ *
+ * Implementation of the PerspectiveNPointProblem class
+ *
+ *
+ * @{
+ */
+/* --------------------------------------------------------------------------
+ *
+ * Includes
+ *
+ * --------------------------------------------------------------------------
+ */
+#include "PerspectiveNPointProblem.hpp"
+
+#include <Eigen/Core>
+#include <Eigen/Dense>
+#include <Eigen/Eigenvalues>
+#include <Eigen/Geometry>
+
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+#include <complex>
+
+namespace RobustEstimation
+{
+
+namespace
+	{
+	const int SAMPLE_SIZE = 3;
+	const int MODEL_SIZE = 12;
+	const int MAXIMUM_NUMBER_OF_MODELS = 4;
+
+	typedef Eigen::Matrix<double, 3, 4, Eigen::RowMajor> PoseMatrix;
+
+	/**
+	 * The coefficients of the polynomials are in increasing order of power.
+	 */
+	std::vector<double> MultiplyPolynomials(const std::vector<double>& first, const std::vector<double>& second)
+		{
+		std::vector<double> product(first.size() + second.size() - 1, 0);
+		for (unsigned firstIndex = 0; firstIndex < first.size(); firstIndex++)
+			{
+			for (unsigned secondIndex = 0; secondIndex < second.size(); secondIndex++)
+				{
+				product.at(firstIndex + secondIndex) += first.at(firstIndex) * second.at(secondIndex);
+				}
+			}
+		return product;
+		}
+
+	std::vector<double> AddPolynomials(const std::vector<double>& first, const std::vector<double>& second, double secondFactor)
+		{
+		std::vector<double> sum( std::max(first.size(), second.size()), 0 );
+		for (unsigned index = 0; index < first.size(); index++)
+			{
+			sum.at(index) += first.at(index);
+			}
+		for (unsigned index = 0; index < second.size(); index++)
+			{
+			sum.at(index) += secondFactor * second.at(index);
+			}
+		return sum;
+		}
+
+	double EvaluatePolynomial(const std::vector<double>& coefficients, double value)
+		{
+		double result = 0;
+		for (int index = static_cast<int>(coefficients.size()) - 1; index >= 0; index--)
+			{
+			result = result * value + coefficients.at(index);
+			}
+		return result;
+		}
+
+	/**
+	 * The real roots are the real eigenvalues of the companion matrix, polished by a few Newton steps; the negligible leading coefficients are dropped first.
+	 */
+	std::vector<double> SolvePolynomial(std::vector<double> coefficients)
+		{
+		std::vector<double> roots;
+		double largestCoefficient = 0;
+		for (unsigned index = 0; index < coefficients.size(); index++)
+			{
+			largestCoefficient = std::max(largestCoefficient, std::abs(coefficients.at(index)));
+			}
+		while (coefficients.size() > 1 && std::abs(coefficients.back()) <= 1e-12 * largestCoefficient)
+			{
+			coefficients.pop_back();
+			}
+		const int degree = static_cast<int>(coefficients.size()) - 1;
+		if (degree < 1)
+			{
+			return roots;
+			}
+
+		Eigen::MatrixXd companionMatrix = Eigen::MatrixXd::Zero(degree, degree);
+		for (int index = 0; index < degree; index++)
+			{
+			companionMatrix(0, index) = -coefficients.at(degree - 1 - index) / coefficients.at(degree);
+			if (index > 0)
+				{
+				companionMatrix(index, index - 1) = 1;
+				}
+			}
+		Eigen::EigenSolver<Eigen::MatrixXd> eigenSolver(companionMatrix, false);
+
+		std::vector<double> derivative;
+		for (int index = 1; index <= degree; index++)
+			{
+			derivative.push_back(index * coefficients.at(index));
+			}
+		for (int index = 0; index < degree; index++)
+			{
+			std::complex<double> eigenvalue = eigenSolver.eigenvalues()(index);
+			if (std::abs(eigenvalue.imag()) > 1e-6 * (1 + std::abs(eigenvalue.real())))
+				{
+				continue;
+				}
+			double root = eigenvalue.real();
+			for (int step = 0; step < 3; step++)
+				{
+				const double slope = EvaluatePolynomial(derivative, root);
+				if (slope == 0)
+					{
+					break;
+					}
+				root -= EvaluatePolynomial(coefficients, root) / slope;
+				}
+			roots.push_back(root);
+			}
+		return roots;
+		}
+
+	Eigen::Matrix3d CrossProductMatrix(const Eigen::Vector3d& vector)
+		{
+		Eigen::Matrix3d matrix;
+		matrix << 0, -vector(2), vector(1), vector(2), 0, -vector(0), -vector(1), vector(0), 0;
+		return matrix;
+		}
+	}
+
+/* --------------------------------------------------------------------------
+ *
+ * Public Member Functions
+ *
+ * --------------------------------------------------------------------------
+ */
+
+PerspectiveNPointProblem::PerspectiveNPointProblem() :
+	focalLengthX(1),
+	focalLengthY(1),
+	principalPointX(0),
+	principalPointY(0)
+	{
+
+	}
+
+PerspectiveNPointProblem::~PerspectiveNPointProblem()
+	{
+
+	}
+
+void PerspectiveNPointProblem::SetCameraMatrix(double focalLengthX, double focalLengthY, double principalPointX, double principalPointY)
+	{
+	this->focalLengthX = focalLengthX;
+	this->focalLengthY = focalLengthY;
+	this->principalPointX = principalPointX;
+	this->principalPointY = principalPointY;
+	}
+
+void PerspectiveNPointProblem::ClearPoints()
+	{
+	xList.clear();
+	yList.clear();
+	zList.clear();
+	projectionXList.clear();
+	projectionYList.clear();
+	}
+
+void PerspectiveNPointProblem::AddPoint(double x, double y, double z, double projectionX, double projectionY)
+	{
+	xList.push_back(x);
+	yList.push_back(y);
+	zList.push_back(z);
+	projectionXList.push_back(projectionX);
+	projectionYList.push_back(projectionY);
+	}
+
+int PerspectiveNPointProblem::GetNumberOfData() const
+	{
+	return static_cast<int>( xList.size() );
+	}
+
+int PerspectiveNPointProblem::GetSampleSize() const
+	{
+	return SAMPLE_SIZE;
+	}
+
+int PerspectiveNPointProblem::GetModelSize() const
+	{
+	return MODEL_SIZE;
+	}
+
+int PerspectiveNPointProblem::GetMaximumNumberOfModels() const
+	{
+	return MAXIMUM_NUMBER_OF_MODELS;
+	}
+
+/**
+ * Grunert's solution, as reviewed in Robert Haralick et al. (1994), "Review and Analysis of Solutions of the Three Point Perspective Pose Estimation Problem".
+ * With a, b and c the distances between the points 2-3, 1-3 and 1-2, and alpha, beta and gamma the angles between the corresponding viewing rays, the depths
+ * s1, s2 = u*s1 and s3 = v*s1 of the points satisfy the law of cosines of the three triangles. Their differences give u as a rational function N(v) / D(v), and
+ * the last equation becomes a quartic in v. The pose follows from the absolute orientation of the points in the two frames.
+ */
+int PerspectiveNPointProblem::FitModels(const int* sample, double* models) const
+	{
+	Eigen::Matrix3d worldPoints, rays;
+	for (int sampleIndex = 0; sampleIndex < SAMPLE_SIZE; sampleIndex++)
+		{
+		const int dataIndex = sample[sampleIndex];
+		worldPoints.col(sampleIndex) << xList[dataIndex], yList[dataIndex], zList[dataIndex];
+		rays.col(sampleIndex) = Eigen::Vector3d( (projectionXList[dataIndex] - principalPointX) / focalLengthX, (projectionYList[dataIndex] - principalPointY) / focalLengthY, 1).normalized();
+		}
+
+	const double squaredA = (worldPoints.col(1) - worldPoints.col(2)).squaredNorm();
+	const double squaredB = (worldPoints.col(0) - worldPoints.col(2)).squaredNorm();
+	const double squaredC = (worldPoints.col(0) - worldPoints.col(1)).squaredNorm();
+	const double collinearity = ( (worldPoints.col(1) - worldPoints.col(0)).cross(worldPoints.col(2) - worldPoints.col(0)) ).squaredNorm();
+	if (collinearity <= 1e-12 * squaredB * squaredC)
+		{
+		return 0;
+		}
+
+	const double cosAlpha = rays.col(1).dot(rays.col(2));
+	const double cosBeta = rays.col(0).dot(rays.col(2));
+	const double cosGamma = rays.col(0).dot(rays.col(1));
+	const double ratioK = (squaredA - squaredC) / squaredB;
+	const double ratioC = squaredC / squaredB;
+
+	const std::vector<double> numerator = { 1 + ratioK, -2 * ratioK * cosBeta, ratioK - 1 };
+	const std::vector<double> denominator = { 2 * cosGamma, -2 * cosAlpha };
+	const std::vector<double> remainder = { 1 - ratioC, 2 * ratioC * cosBeta, -ratioC };
+	std::vector<double> quartic = MultiplyPolynomials(numerator, numerator);
+	quartic = AddPolynomials(quartic, MultiplyPolynomials(numerator, denominator), -2 * cosGamma);
+	quartic = AddPolynomials(quartic, MultiplyPolynomials(remainder, MultiplyPolynomials(denominator, denominator)), 1);
+
+	std::vector<double> roots = SolvePolynomial(quartic);
+	int numberOfModels = 0;
+	for (unsigned rootIndex = 0; rootIndex < roots.size() && numberOfModels < MAXIMUM_NUMBER_OF_MODELS; rootIndex++)
+		{
+		const double v = roots.at(rootIndex);
+		const double denominatorValue = EvaluatePolynomial(denominator, v);
+		const double firstDepthDenominator = 1 + v * v - 2 * v * cosBeta;
+		if (v <= 0 || std::abs(denominatorValue) < 1e-12 || firstDepthDenominator <= 0)
+			{
+			continue;
+			}
+		const double u = EvaluatePolynomial(numerator, v) / denominatorValue;
+		if (u <= 0)
+			{
+			continue;
+			}
+
+		const double firstDepth = std::sqrt(squaredB / firstDepthDenominator);
+		Eigen::Matrix3d cameraPoints;
+		cameraPoints.col(0) = firstDepth * rays.col(0);
+		cameraPoints.col(1) = u * firstDepth * rays.col(1);
+		cameraPoints.col(2) = v * firstDepth * rays.col(2);
+
+		Eigen::Matrix4d transform = Eigen::umeyama(worldPoints, cameraPoints, false);
+		if (!transform.allFinite())
+			{
+			continue;
+			}
+		Eigen::Map<PoseMatrix>(models + numberOfModels * MODEL_SIZE) = transform.topRows<3>();
+		numberOfModels++;
+		}
+	return numberOfModels;
+	}
+
+/**
+ * A point behind the camera has the largest error.
+ */
+void PerspectiveNPointProblem::ComputeErrors(const double* model, const int* dataIndices, int numberOfIndices, float* errors) const
+	{
+	for (int index = 0; index < numberOfIndices; index++)
+		{
+		const int dataIndex = dataIndices[index];
+		const double x = xList[dataIndex];
+		const double y = yList[dataIndex];
+		const double z = zList[dataIndex];
+		const double cameraZ = model[8] * x + model[9] * y + model[10] * z + model[11];
+		if (cameraZ <= 0)
+			{
+			errors[index] = FLT_MAX;
+			continue;
+			}
+		const double cameraX = model[0] * x + model[1] * y + model[2] * z + model[3];
+		const double cameraY = model[4] * x + model[5] * y + model[6] * z + model[7];
+		const double differenceX = focalLengthX * cameraX / cameraZ + principalPointX - projectionXList[dataIndex];
+		const double differenceY = focalLengthY * cameraY / cameraZ + principalPointY - projectionYList[dataIndex];
+		errors[index] = static_cast<float>( std::min(differenceX * differenceX + differenceY * differenceY, static_cast<double>(FLT_MAX)) );
+		}
+	}
+
+/**
+ * Levenberg-Marquardt minimization of the sum of the squared reprojection errors of the inliers. The pose is updated as R' = exp([w]x) * R and t' = t + d,
+ * so that the derivative of a camera point q = R * p + t is -[R * p]x with respect to w and the identity with respect to d.
+ */
+bool PerspectiveNPointProblem::RefineModel(const std::vector<int>& inliers, double* model) const
+	{
+	if (inliers.size() < 4)
+		{
+		return false;
+		}
+
+	PoseMatrix pose = Eigen::Map<const PoseMatrix>(model);
+	const double initialCost = ComputeCost(inliers, pose.data());
+	double cost = initialCost;
+	double damping = 1e-3;
+	bool converged = false;
+	for (int iteration = 0; iteration < MAXIMUM_REFINEMENT_ITERATIONS && !converged; iteration++)
+		{
+		Eigen::Matrix<double, 6, 6> normalMatrix = Eigen::Matrix<double, 6, 6>::Zero();
+		Eigen::Matrix<double, 6, 1> gradient = Eigen::Matrix<double, 6, 1>::Zero();
+		for (unsigned inlierIndex = 0; inlierIndex < inliers.size(); inlierIndex++)
+			{
+			const int dataIndex = inliers.at(inlierIndex);
+			const Eigen::Vector3d rotatedPoint = pose.leftCols<3>() * Eigen::Vector3d(xList[dataIndex], yList[dataIndex], zList[dataIndex]);
+			const Eigen::Vector3d cameraPoint = rotatedPoint + pose.col(3);
+			if (cameraPoint(2) <= 0)
+				{
+				continue;
+				}
+			Eigen::Matrix<double, 2, 3> projectionJacobian;
+			projectionJacobian << focalLengthX / cameraPoint(2), 0, -focalLengthX * cameraPoint(0) / (cameraPoint(2) * cameraPoint(2)),
+				0, focalLengthY / cameraPoint(2), -focalLengthY * cameraPoint(1) / (cameraPoint(2) * cameraPoint(2));
+			Eigen::Matrix<double, 2, 6> jacobian;
+			jacobian.leftCols<3>() = -projectionJacobian * CrossProductMatrix(rotatedPoint);
+			jacobian.rightCols<3>() = projectionJacobian;
+			const Eigen::Vector2d residual(focalLengthX * cameraPoint(0) / cameraPoint(2) + principalPointX - projectionXList[dataIndex],
+				focalLengthY * cameraPoint(1) / cameraPoint(2) + principalPointY - projectionYList[dataIndex]);
+			normalMatrix += jacobian.transpose() * jacobian;
+			gradient += jacobian.transpose() * residual;
+			}
+
+		bool improved = false;
+		while (!improved && damping < 1e10)
+			{
+			Eigen::Matrix<double, 6, 6> dampedMatrix = normalMatrix;
+			dampedMatrix.diagonal() += damping * normalMatrix.diagonal();
+			const Eigen::Matrix<double, 6, 1> step = dampedMatrix.ldlt().solve(-gradient);
+			if (!step.allFinite())
+				{
+				damping *= 10;
+				continue;
+				}
+
+			PoseMatrix candidatePose;
+			const double angle = step.head<3>().norm();
+			const Eigen::Matrix3d rotationStep = (angle > 0) ? Eigen::AngleAxisd(angle, step.head<3>() / angle).toRotationMatrix() : Eigen::Matrix3d::Identity();
+			candidatePose.leftCols<3>() = rotationStep * pose.leftCols<3>();
+			candidatePose.col(3) = pose.col(3) + step.tail<3>();
+			const double candidateCost = ComputeCost(inliers, candidatePose.data());
+			if (candidateCost < cost)
+				{
+				improved = true;
+				converged = (cost - candidateCost) < 1e-10 * cost;
+				pose = candidatePose;
+				cost = candidateCost;
+				damping = std::max(damping / 10, 1e-9);
+				}
+			else
+				{
+				damping *= 10;
+				}
+			}
+		if (!improved)
+			{
+			break;
+			}
+		}
+
+	if (!(cost < initialCost))
+		{
+		return false;
+		}
+	Eigen::Map<PoseMatrix> refinedModel(model);
+	refinedModel = pose;
+	return true;
+	}
+
+/* --------------------------------------------------------------------------
+ *
+ * Private Member Variables
+ *
+ * --------------------------------------------------------------------------
+ */
+
+const int PerspectiveNPointProblem::MAXIMUM_REFINEMENT_ITERATIONS = 20;
+
+/* --------------------------------------------------------------------------
+ *
+ * Private Member Functions
+ *
+ * --------------------------------------------------------------------------
+ */
+
+double PerspectiveNPointProblem::ComputeCost(const std::vector<int>& indices, const double* model) const
+	{
+	std::vector<float> errors(indices.size());
+	ComputeErrors(model, indices.data(), static_cast<int>(indices.size()), errors.data());
+	double cost = 0;
+	for (unsigned index = 0; index < errors.size(); index++)
+		{
+		cost += errors.at(index);
+		}
+	return cost;
+	}
+
+}
+
+/** @} */
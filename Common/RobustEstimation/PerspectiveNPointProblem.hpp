@@ -0,0 +1,103 @@
+/* --------------------------------------------------------------------------
+*
+* (C) Copyright …
+*
+* --------------------------------------------------------------------------
+*/
+
+/*!
+ * @file PerspectiveNPointProblem.hpp
+ * @date 19/10/2026
+ * @author Alessandro Bianco
+ */
+
+/*!
+ * @addtogroup Common
+ *
+ *  Estimation of the pose of a camera from 3D points and their projections in the camera image (Perspective-n-Point problem).
+ *  The models are fitted on minimal samples of three points by the P3P solver of Grunert, and refined on their inliers by Levenberg-Marquardt minimization
+ *  of the reprojection errors. The error of a point is its squared reprojection error in pixels.
+ *  A model is the transform [R|t] from the points reference frame to the camera frame, stored row by row as a 3x4 matrix.
+ *
+ * @{
+ */
+
+#ifndef PERSPECTIVE_N_POINT_PROBLEM_HPP
+#define PERSPECTIVE_N_POINT_PROBLEM_HPP
+
+/* --------------------------------------------------------------------------
+ *
+ * Includes
+ *
+ * --------------------------------------------------------------------------
+ */
+#include "EstimationProblem.hpp"
+
+#include <vector>
+
+namespace RobustEstimation
+{
+
+/* --------------------------------------------------------------------------
+ *
+ * Class definition
+ *
+ * --------------------------------------------------------------------------
+ */
+class PerspectiveNPointProblem : public EstimationProblem
+	{
+	/* --------------------------------------------------------------------
+	 * Public
+	 * --------------------------------------------------------------------
+	 */
+	public:
+		PerspectiveNPointProblem();
+		~PerspectiveNPointProblem();
+
+		void SetCameraMatrix(double focalLengthX, double focalLengthY, double principalPointX, double principalPointY);
+		void ClearPoints();
+		void AddPoint(double x, double y, double z, double projectionX, double projectionY);
+
+		int GetNumberOfData() const override;
+		int GetSampleSize() const override;
+		int GetModelSize() const override;
+		int GetMaximumNumberOfModels() const override;
+		int FitModels(const int* sample, double* models) const override;
+		void ComputeErrors(const double* model, const int* dataIndices, int numberOfIndices, float* errors) const override;
+		bool RefineModel(const std::vector<int>& inliers, double* model) const override;
+
+	/* --------------------------------------------------------------------
+	 * Protected
+	 * --------------------------------------------------------------------
+	 */
+	protected:
+
+	/* --------------------------------------------------------------------
+	 * Private
+	 * --------------------------------------------------------------------
+	 */
+	private:
+		static const int MAXIMUM_REFINEMENT_ITERATIONS;
+
+		double focalLengthX;
+		double focalLengthY;
+		double principalPointX;
+		double principalPointY;
+
+		std::vector<double> xList;
+		std::vector<double> yList;
+		std::vector<double> zList;
+		std::vector<double> projectionXList;
+		std::vector<double> projectionYList;
+
+		/*
+		* @brief The sum of the squared reprojection errors of the listed points.
+		*/
+		double ComputeCost(const std::vector<int>& indices, const double* model) const;
+	};
+
+}
+
+#endif
+/* PerspectiveNPointProblem.hpp */
+/** @} */
@@ -0,0 +1,552 @@
+/* --------------------------------------------------------------------------
+*
+* (C) Copyright …
+*
+* ---------------------------------------------------------------------------
+*/
+
+/*!
+ * @file RobustEstimator.cpp
+ * @date 19/10/2026
+ * @author Alessandro Bianco
+ */
+
+/*!
+ * @addtogroup Common
+ *
+ * Implementation of the RobustEstimator class
+ *
+ *
+ * @{
+ */
+/* --------------------------------------------------------------------------
+ *
+ * Includes
+ *
+ * --------------------------------------------------------------------------
+ */
+#include "RobustEstimator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <thread>
+#include <limits>
+
+namespace RobustEstimation
+{
+
+/* --------------------------------------------------------------------------
+ *
+ * Public Member Functions
+ *
+ * --------------------------------------------------------------------------
+ */
+
+const RobustEstimator::Options RobustEstimator::DEFAULT_OPTIONS =
+	{
+	/*.inlierThreshold =*/ 1.0,
+	/*.confidence =*/ 0.99,
+	/*.maximumIterations =*/ 2000,
+	/*.useProsac =*/ true,
+	/*.useSprt =*/ true,
+	/*.numberOfThreads =*/ 0,
+	/*.seed =*/ 5489,
+	/*.maximumTime =*/ 0,
+	/*.preemptiveHypotheses =*/ 0
+	};
+
+RobustEstimator::RobustEstimator() :
+	options(DEFAULT_OPTIONS),
+	threadsNumber(1),
+	currentProblem(NULL),
+	numberOfData(0),
+	sampleSize(0),
+	nextIteration(0),
+	iterationLimit(0),
+	bestInliersNumber(0),
+	sprtEpsilon(0),
+	sprtDelta(SPRT_INITIAL_DELTA),
+	sprtDeltaSum(0),
+	sprtDeltaCount(0),
+	sprtLogThreshold(0),
+	rejectedModelsNumber(0),
+	survivorsNumber(0),
+	scoredDataStart(0),
+	scoredDataEnd(0)
+	{
+
+	}
+
+RobustEstimator::~RobustEstimator()
+	{
+
+	}
+
+void RobustEstimator::SetOptions(const Options& options)
+	{
+	this->options = options;
+	}
+
+const RobustEstimator::Options& RobustEstimator::GetOptions() const
+	{
+	return options;
+	}
+
+bool RobustEstimator::Estimate(const EstimationProblem& problem, const std::vector<float>& scores, std::vector<double>& model, std::vector<int>& inliers)
+	{
+	currentProblem = &problem;
+	numberOfData = problem.GetNumberOfData();
+	sampleSize = problem.GetSampleSize();
+	nextIteration.store(0);
+	iterationLimit.store(options.maximumIterations);
+	bestInliersNumber = 0;
+	bestModel.assign(problem.GetModelSize(), 0);
+	sprtEpsilon = 0;
+	sprtDelta = SPRT_INITIAL_DELTA;
+	sprtDeltaSum = 0;
+	sprtDeltaCount = 0;
+	sprtLogThreshold = 0;
+	rejectedModelsNumber = 0;
+	inliers.clear();
+	if (numberOfData < sampleSize || sampleSize <= 0)
+		{
+		return false;
+		}
+
+	startTime = std::chrono::steady_clock::now();
+	PrepareSampling(scores);
+
+	threadsNumber = options.numberOfThreads > 0 ? options.numberOfThreads : static_cast<int>( std::thread::hardware_concurrency() );
+	if (options.preemptiveHypotheses > 0)
+		{
+		iterationLimit.store(options.preemptiveHypotheses);
+		threadsNumber = std::max(1, std::min(threadsNumber, options.preemptiveHypotheses));
+		SelectPreemptively();
+		}
+	else
+		{
+		threadsNumber = std::max(1, std::min(threadsNumber, options.maximumIterations));
+		RunThreads(&RobustEstimator::GenerateHypotheses, threadsNumber);
+		}
+
+	if (bestInliersNumber <= sampleSize)
+		{
+		return false;
+		}
+
+	model = bestModel;
+	CollectInliers(model.data(), inliers);
+
+	std::vector<double> refinedModel = model;
+	std::vector<int> refinedInliers;
+	if (problem.RefineModel(inliers, refinedModel.data()) && CollectInliers(refinedModel.data(), refinedInliers) >= static_cast<int>(inliers.size()))
+		{
+		model.swap(refinedModel);
+		inliers.swap(refinedInliers);
+		}
+	return true;
+	}
+
+int RobustEstimator::GetNumberOfIterations() const
+	{
+	return std::min(nextIteration.load(), iterationLimit.load());
+	}
+
+int RobustEstimator::GetNumberOfRejectedModels() const
+	{
+	return rejectedModelsNumber;
+	}
+
+/* --------------------------------------------------------------------------
+ *
+ * Private Member Variables
+ *
+ * --------------------------------------------------------------------------
+ */
+
+const int RobustEstimator::BATCH_SIZE = 64;
+const double RobustEstimator::SPRT_INITIAL_DELTA = 0.05;
+const double RobustEstimator::SPRT_MODEL_COST = 200;
+
+/* --------------------------------------------------------------------------
+ *
+ * Private Member Functions
+ *
+ * --------------------------------------------------------------------------
+ */
+
+/**
+ * The PROSAC schedule follows Ondrej Chum and Jiri Matas (2005), "Matching with PROSAC - Progressive Sample Consensus", with the maximum number of samples as
+ * the number of samples after which the sampling is uniform: T_n is the expected number of samples, out of the maximum number, drawn only from the n best data,
+ * and the n-th best datum enters the samples after ceil(T_n) - ceil(T_(n-1)) more iterations. The verification order is drawn here too.
+ */
+void RobustEstimator::PrepareSampling(const std::vector<float>& scores)
+	{
+	verificationOrder.resize(numberOfData);
+	std::iota(verificationOrder.begin(), verificationOrder.end(), 0);
+	std::mt19937 generator(options.seed);
+	std::shuffle(verificationOrder.begin(), verificationOrder.end(), generator);
+
+	dataOrder.resize(numberOfData);
+	std::iota(dataOrder.begin(), dataOrder.end(), 0);
+	prosacSchedule.clear();
+	if (!options.useProsac || static_cast<int>(scores.size()) != numberOfData)
+		{
+		return;
+		}
+
+	std::stable_sort(dataOrder.begin(), dataOrder.end(), [&scores](int first, int second) { return scores.at(first) > scores.at(second); });
+
+	double expectedSamples = (options.preemptiveHypotheses > 0) ? options.preemptiveHypotheses : options.maximumIterations;
+	for (int sampleIndex = 0; sampleIndex < sampleSize; sampleIndex++)
+		{
+		expectedSamples *= static_cast<double>(sampleSize - sampleIndex) / (numberOfData - sampleIndex);
+		}
+	prosacSchedule.resize(numberOfData + 1, 0);
+	prosacSchedule.at(sampleSize) = 1;
+	for (int setSize = sampleSize; setSize < numberOfData; setSize++)
+		{
+		double nextExpectedSamples = expectedSamples * (setSize + 1) / (setSize + 1 - sampleSize);
+		prosacSchedule.at(setSize + 1) = prosacSchedule.at(setSize) + std::ceil(nextExpectedSamples - expectedSamples);
+		expectedSamples = nextExpectedSamples;
+		}
+	}
+
+/**
+ * The first share of the work runs in the calling thread.
+ */
+void RobustEstimator::RunThreads(void (RobustEstimator::*threadFunction)(int), int numberOfThreads)
+	{
+	std::vector<std::thread> threadsList;
+	for (int threadIndex = 1; threadIndex < numberOfThreads; threadIndex++)
+		{
+		threadsList.push_back( std::thread(threadFunction, this, threadIndex) );
+		}
+	(this->*threadFunction)(0);
+	for (unsigned threadIndex = 0; threadIndex < threadsList.size(); threadIndex++)
+		{
+		threadsList.at(threadIndex).join();
+		}
+	}
+
+void RobustEstimator::GenerateHypotheses(int threadIndex)
+	{
+	const EstimationProblem& problem = *currentProblem;
+	const int modelSize = problem.GetModelSize();
+	std::mt19937 generator(options.seed + threadIndex);
+	std::vector<int> sample(sampleSize);
+	std::vector<double> modelsList(problem.GetMaximumNumberOfModels() * modelSize);
+	std::vector<float> errors(BATCH_SIZE);
+
+	while (true)
+		{
+		const int iteration = nextIteration.fetch_add(1) + 1;
+		if (iteration > iterationLimit.load())
+			{
+			break;
+			}
+		if (IsTimeOver())
+			{
+			LowerIterationLimit(iteration - 1);
+			break;
+			}
+
+		DrawSample(iteration, generator, sample.data());
+		const int numberOfModels = problem.FitModels(sample.data(), modelsList.data());
+		for (int modelIndex = 0; modelIndex < numberOfModels; modelIndex++)
+			{
+			const double* model = modelsList.data() + modelIndex * modelSize;
+			VerificationState verificationState = GetVerificationState();
+			int verifiedData = 0;
+			int inliersNumber = VerifyModel(model, verificationState, errors, verifiedData);
+			if (verifiedData < numberOfData && inliersNumber >= 0)
+				{
+				UpdateRejectionStatistics(inliersNumber, verifiedData);
+				}
+			else if (inliersNumber > verificationState.bestInliersNumber)
+				{
+				UpdateBestModel(model, inliersNumber);
+				}
+			}
+		}
+	}
+
+/**
+ * The hypotheses are scored by their number of inliers on the batches of data in the verification order. After each batch only the best half of the hypotheses
+ * is kept, until one is left or all data are scored.
+ */
+void RobustEstimator::SelectPreemptively()
+	{
+	const int modelSize = currentProblem->GetModelSize();
+	hypothesesList.clear();
+	RunThreads(&RobustEstimator::GeneratePreemptiveHypotheses, threadsNumber);
+
+	const int numberOfHypotheses = static_cast<int>( hypothesesList.size() ) / modelSize;
+	if (numberOfHypotheses == 0)
+		{
+		return;
+		}
+	hypothesesOrder.resize(numberOfHypotheses);
+	std::iota(hypothesesOrder.begin(), hypothesesOrder.end(), 0);
+	hypothesesScores.assign(numberOfHypotheses, 0);
+	survivorsNumber = numberOfHypotheses;
+	for (scoredDataStart = 0; scoredDataStart < numberOfData && survivorsNumber > 1; scoredDataStart += BATCH_SIZE)
+		{
+		scoredDataEnd = std::min(scoredDataStart + BATCH_SIZE, numberOfData);
+		RunThreads(&RobustEstimator::ScoreHypotheses, std::min(threadsNumber, survivorsNumber));
+
+		const std::vector<int>& scoresList = hypothesesScores;
+		std::stable_sort(hypothesesOrder.begin(), hypothesesOrder.begin() + survivorsNumber,
+			[&scoresList](int first, int second) { return scoresList.at(first) > scoresList.at(second); });
+		survivorsNumber = std::max(1, survivorsNumber / 2);
+		}
+
+	const double* bestHypothesis = hypothesesList.data() + hypothesesOrder.at(0) * modelSize;
+	std::copy(bestHypothesis, bestHypothesis + modelSize, bestModel.begin());
+	std::vector<int> inliers;
+	bestInliersNumber = CollectInliers(bestModel.data(), inliers);
+	}
+
+void RobustEstimator::GeneratePreemptiveHypotheses(int threadIndex)
+	{
+	const EstimationProblem& problem = *currentProblem;
+	const int modelSize = problem.GetModelSize();
+	std::mt19937 generator(options.seed + threadIndex);
+	std::vector<int> sample(sampleSize);
+	std::vector<double> modelsList(problem.GetMaximumNumberOfModels() * modelSize);
+
+	while (true)
+		{
+		const int iteration = nextIteration.fetch_add(1) + 1;
+		if (iteration > iterationLimit.load())
+			{
+			break;
+			}
+		if (IsTimeOver())
+			{
+			LowerIterationLimit(iteration - 1);
+			break;
+			}
+
+		DrawSample(iteration, generator, sample.data());
+		const int numberOfModels = problem.FitModels(sample.data(), modelsList.data());
+		std::lock_guard<std::mutex> stateLock(stateMutex);
+		hypothesesList.insert(hypothesesList.end(), modelsList.begin(), modelsList.begin() + numberOfModels * modelSize);
+		}
+	}
+
+/**
+ * The thread scores one in every threadsNumber surviving hypotheses on the current batch of data.
+ */
+void RobustEstimator::ScoreHypotheses(int threadIndex)
+	{
+	const int modelSize = currentProblem->GetModelSize();
+	const int scoringThreadsNumber = std::min(threadsNumber, survivorsNumber);
+	std::vector<float> errors(scoredDataEnd - scoredDataStart);
+	for (int survivorIndex = threadIndex; survivorIndex < survivorsNumber; survivorIndex += scoringThreadsNumber)
+		{
+		const int hypothesisIndex = hypothesesOrder.at(survivorIndex);
+		currentProblem->ComputeErrors(hypothesesList.data() + hypothesisIndex * modelSize, verificationOrder.data() + scoredDataStart, scoredDataEnd - scoredDataStart, errors.data());
+		hypothesesScores.at(hypothesisIndex) += std::count_if(errors.begin(), errors.end(), [this](float error) { return error < options.inlierThreshold; });
+		}
+	}
+
+/**
+ * With PROSAC, an iteration samples from the n best data, where n is the smallest size whose schedule reaches the iteration: the sample holds the n-th best datum
+ * and sampleSize - 1 data drawn from the n - 1 best ones. Past the end of the schedule, and without PROSAC, the samples are drawn uniformly from all data.
+ */
+void RobustEstimator::DrawSample(int iteration, std::mt19937& generator, int* sample)
+	{
+	if (prosacSchedule.size() == 0 || iteration > prosacSchedule.back())
+		{
+		DrawFromBest(numberOfData, sampleSize, generator, sample);
+		return;
+		}
+
+	const int setSize = static_cast<int>( std::lower_bound(prosacSchedule.begin() + sampleSize, prosacSchedule.end(), static_cast<double>(iteration)) - prosacSchedule.begin() );
+	DrawFromBest(setSize - 1, sampleSize - 1, generator, sample);
+	sample[sampleSize - 1] = dataOrder.at(setSize - 1);
+	}
+
+/**
+ * Draws count distinct data among the setSize best ones, by rejection of the repeated draws since count is small.
+ */
+void RobustEstimator::DrawFromBest(int setSize, int count, std::mt19937& generator, int* sample)
+	{
+	if (count == 0)
+		{
+		return;
+		}
+	std::uniform_int_distribution<int> distribution(0, setSize - 1);
+	for (int sampleIndex = 0; sampleIndex < count; sampleIndex++)
+		{
+		bool repeated = true;
+		while (repeated)
+			{
+			sample[sampleIndex] = dataOrder[ distribution(generator) ];
+			repeated = std::find(sample, sample + sampleIndex, sample[sampleIndex]) != sample + sampleIndex;
+			}
+		}
+	}
+
+/**
+ * The errors are computed in batches, in the verification order, so that the problem can compute them with SIMD instructions. After each batch the verification stops if the model cannot
+ * have more inliers than the best model, in which case -1 is returned, or if the SPRT likelihood ratio of the verified data exceeds the SPRT threshold, in which
+ * case the inliers found so far are returned with verifiedData less than the number of data. The SPRT follows Jiri Matas and Ondrej Chum (2005), "Randomized
+ * RANSAC with Sequential Probability Ratio Test", International Conference on Computer Vision.
+ */
+int RobustEstimator::VerifyModel(const double* model, const VerificationState& verificationState, std::vector<float>& errors, int& verifiedData)
+	{
+	const float threshold = options.inlierThreshold;
+	int inliersNumber = 0;
+	double logLikelihoodRatio = 0;
+	for (int firstData = 0; firstData < numberOfData; firstData += BATCH_SIZE)
+		{
+		const int endData = std::min(firstData + BATCH_SIZE, numberOfData);
+		currentProblem->ComputeErrors(model, verificationOrder.data() + firstData, endData - firstData, errors.data());
+		int batchInliersNumber = 0;
+		for (int errorIndex = 0; errorIndex < endData - firstData; errorIndex++)
+			{
+			batchInliersNumber += (errors[errorIndex] < threshold) ? 1 : 0;
+			}
+		inliersNumber += batchInliersNumber;
+		verifiedData = endData;
+
+		if (inliersNumber + (numberOfData - endData) <= verificationState.bestInliersNumber)
+			{
+			return -1;
+			}
+		if (verificationState.sprtActive)
+			{
+			logLikelihoodRatio += batchInliersNumber * verificationState.logInlierRatio + (endData - firstData - batchInliersNumber) * verificationState.logOutlierRatio;
+			if (logLikelihoodRatio > verificationState.logThreshold && endData < numberOfData)
+				{
+				return inliersNumber;
+				}
+			}
+		}
+	return inliersNumber;
+	}
+
+RobustEstimator::VerificationState RobustEstimator::GetVerificationState()
+	{
+	std::lock_guard<std::mutex> stateLock(stateMutex);
+	VerificationState verificationState;
+	verificationState.bestInliersNumber = bestInliersNumber;
+	verificationState.sprtActive = options.useSprt && sprtEpsilon > sprtDelta;
+	verificationState.logInlierRatio = verificationState.sprtActive ? std::log(sprtDelta / sprtEpsilon) : 0;
+	verificationState.logOutlierRatio = verificationState.sprtActive ? std::log( (1 - sprtDelta) / (1 - sprtEpsilon) ) : 0;
+	verificationState.logThreshold = sprtLogThreshold;
+	return verificationState;
+	}
+
+void RobustEstimator::UpdateBestModel(const double* model, int inliersNumber)
+	{
+	std::lock_guard<std::mutex> stateLock(stateMutex);
+	if (inliersNumber <= bestInliersNumber)
+		{
+		return;
+		}
+
+	bestInliersNumber = inliersNumber;
+	std::copy(model, model + bestModel.size(), bestModel.begin());
+	sprtEpsilon = std::min(static_cast<double>(inliersNumber) / numberOfData, 0.999);
+	UpdateSprtThreshold();
+
+	LowerIterationLimit( ComputeIterationLimit(inliersNumber) );
+	}
+
+void RobustEstimator::LowerIterationLimit(int newIterationLimit)
+	{
+	int currentIterationLimit = iterationLimit.load();
+	while (newIterationLimit < currentIterationLimit && !iterationLimit.compare_exchange_weak(currentIterationLimit, newIterationLimit))
+		{
+		}
+	}
+
+bool RobustEstimator::IsTimeOver() const
+	{
+	return options.maximumTime > 0 && std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() > options.maximumTime;
+	}
+
+/**
+ * The probability delta that a datum is an inlier of a bad model is the average inlier ratio of the rejected models, the threshold is updated when it changes by more than 5%.
+ */
+void RobustEstimator::UpdateRejectionStatistics(int inliersNumber, int verifiedData)
+	{
+	std::lock_guard<std::mutex> stateLock(stateMutex);
+	rejectedModelsNumber++;
+	sprtDeltaSum += static_cast<double>(inliersNumber) / verifiedData;
+	sprtDeltaCount++;
+	const double delta = std::max(sprtDeltaSum / sprtDeltaCount, 1e-3);
+	if (std::abs(delta - sprtDelta) > 0.05 * sprtDelta)
+		{
+		sprtDelta = delta;
+		UpdateSprtThreshold();
+		}
+	}
+
+/**
+ * The threshold A is the fixed point of A = K + log(A), where K = SPRT_MODEL_COST * C + 1 and C is the expected log likelihood ratio of a datum under a bad model:
+ * the cost of fitting a sample is taken as SPRT_MODEL_COST verifications of a datum.
+ */
+void RobustEstimator::UpdateSprtThreshold()
+	{
+	if (sprtEpsilon <= sprtDelta)
+		{
+		return;
+		}
+	const double expectedRatio = (1 - sprtDelta) * std::log( (1 - sprtDelta) / (1 - sprtEpsilon) ) + sprtDelta * std::log(sprtDelta / sprtEpsilon);
+	const double constant = SPRT_MODEL_COST * expectedRatio + 1;
+	double threshold = constant;
+	for (int iteration = 0; iteration < 10; iteration++)
+		{
+		threshold = constant + std::log(threshold);
+		}
+	sprtLogThreshold = std::log(threshold);
+	}
+
+/**
+ * The number of samples needed to draw an all-inlier sample with the required confidence, given the inlier ratio of the best model; a good model passes the SPRT
+ * with probability 1 - 1/A.
+ */
+int RobustEstimator::ComputeIterationLimit(int inliersNumber) const
+	{
+	double goodSampleProbability = std::pow(static_cast<double>(inliersNumber) / numberOfData, sampleSize);
+	if (options.useSprt && sprtEpsilon > sprtDelta)
+		{
+		goodSampleProbability *= 1 - std::exp(-sprtLogThreshold);
+		}
+	if (goodSampleProbability >= 1)
+		{
+		return 1;
+		}
+	if (goodSampleProbability <= std::numeric_limits<double>::epsilon())
+		{
+		return options.maximumIterations;
+		}
+	double iterations = std::ceil( std::log(1 - options.confidence) / std::log(1 - goodSampleProbability) );
+	return static_cast<int>( std::min(iterations, static_cast<double>(options.maximumIterations)) );
+	}
+
+int RobustEstimator::CollectInliers(const double* model, std::vector<int>& inliers) const
+	{
+	std::vector<int> dataIndices(numberOfData);
+	std::iota(dataIndices.begin(), dataIndices.end(), 0);
+	std::vector<float> errors(numberOfData);
+	currentProblem->ComputeErrors(model, dataIndices.data(), numberOfData, errors.data());
+	inliers.clear();
+	for (int dataIndex = 0; dataIndex < numberOfData; dataIndex++)
+		{
+		if (errors.at(dataIndex) < options.inlierThreshold)
+			{
+			inliers.push_back(dataIndex);
+			}
+		}
+	return static_cast<int>( inliers.size() );
+	}
+
+}
+
+/** @} */
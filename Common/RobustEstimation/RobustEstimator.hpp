@@ -0,0 +1,188 @@
+/* --------------------------------------------------------------------------
+*
+* (C) Copyright …
+*
+* --------------------------------------------------------------------------
+*/
+
+/*!
+ * @file RobustEstimator.hpp
+ * @date 19/10/2026
+ * @author Alessandro Bianco
+ */
+
+/*!
+ * @addtogroup Common
+ *
+ *  Robust estimation of the model of an EstimationProblem from data that include outliers, by random sampling of minimal samples and consensus (RANSAC) with:
+ *
+ *  - PROSAC sampling: when the data have a quality score (e.g. the score of a match), the samples are first drawn from the best data and then from a growing set of data;
+ *  - SPRT verification: the data are verified in batches, in random order, and a model is rejected as soon as a sequential probability ratio test decides it is bad, or as soon as it
+ *    cannot beat the best model any more;
+ *  - adaptive termination: the number of iterations is reduced whenever a better model is found, so that the best model is found with the required confidence;
+ *  - parallel hypotheses: the threads draw and verify their own hypotheses and share the best model and the iterations count;
+ *  - time budget: no more hypotheses are drawn once the maximum time is over.
+ *
+ *  Alternatively, the preemptive scoring of David Nister (2005), "Preemptive RANSAC for Live Structure and Motion Estimation", draws a fixed number of hypotheses
+ *  and scores all of them on a batch of data at a time, keeping only the best half after each batch, so that the time of an estimation is bounded whatever the
+ *  inlier ratio.
+ *
+ *  The best model is finally fitted again on its inliers, if the problem supports it.
+ *
+ * @{
+ */
+
+#ifndef ROBUST_ESTIMATOR_HPP
+#define ROBUST_ESTIMATOR_HPP
+
+/* --------------------------------------------------------------------------
+ *
+ * Includes
+ *
+ * --------------------------------------------------------------------------
+ */
+#include "EstimationProblem.hpp"
+
+#include <vector>
+#include <random>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+namespace RobustEstimation
+{
+
+/* --------------------------------------------------------------------------
+ *
+ * Class definition
+ *
+ * --------------------------------------------------------------------------
+ */
+class RobustEstimator
+	{
+	/* --------------------------------------------------------------------
+	 * Public
+	 * --------------------------------------------------------------------
+	 */
+	public:
+		struct Options
+			{
+			float inlierThreshold; //a datum is an inlier of a model if its error is below the threshold, in the units of the errors of the problem
+			double confidence; //the required probability of finding the best model, in (0, 1)
+			int maximumIterations;
+			bool useProsac;
+			bool useSprt;
+			int numberOfThreads; //zero means the number of hardware threads
+			unsigned seed;
+			double maximumTime; //in seconds, zero means no limit
+			int preemptiveHypotheses; //when positive, the number of samples drawn for preemptive scoring, which replaces the adaptive sampling and the SPRT
+			};
+		static const Options DEFAULT_OPTIONS;
+
+		RobustEstimator();
+		~RobustEstimator();
+
+		void SetOptions(const Options& options);
+		const Options& GetOptions() const;
+
+		/*
+		* @brief Estimates the model of the problem that has the most inliers.
+		*
+		* @param problem, the estimation problem.
+		* @param scores, the quality score of each datum, higher is better, it defines the PROSAC order; when empty the samples are drawn uniformly.
+		* @param model, the estimated model.
+		* @param inliers, the indices of the inliers of the estimated model, in increasing order.
+		* @output, true if a model with more inliers than the size of a minimal sample was found.
+		*/
+		bool Estimate(const EstimationProblem& problem, const std::vector<float>& scores, std::vector<double>& model, std::vector<int>& inliers);
+
+		/*
+		* @brief The number of samples drawn by the latest estimation.
+		*/
+		int GetNumberOfIterations() const;
+
+		/*
+		* @brief The number of models rejected by the SPRT in the latest estimation.
+		*/
+		int GetNumberOfRejectedModels() const;
+
+	/* --------------------------------------------------------------------
+	 * Protected
+	 * --------------------------------------------------------------------
+	 */
+	protected:
+
+	/* --------------------------------------------------------------------
+	 * Private
+	 * --------------------------------------------------------------------
+	 */
+	private:
+		static const int BATCH_SIZE;
+		static const double SPRT_INITIAL_DELTA;
+		static const double SPRT_MODEL_COST;
+
+		//The SPRT parameters used to verify one model, copied from the shared state when the verification starts
+		struct VerificationState
+			{
+			int bestInliersNumber;
+			bool sprtActive;
+			double logInlierRatio; //the log likelihood ratio added by an inlier
+			double logOutlierRatio; //the log likelihood ratio added by an outlier
+			double logThreshold;
+			};
+
+		Options options;
+		int threadsNumber;
+		std::chrono::steady_clock::time_point startTime;
+
+		//The state of an estimation shared by the threads, the mutex protects everything but the atomic counters
+		const EstimationProblem* currentProblem;
+		int numberOfData;
+		int sampleSize;
+		std::vector<int> dataOrder; //the data indices in decreasing order of score
+		std::vector<double> prosacSchedule; //for each size n of the sampled set, the last iteration that samples from the n best data
+		std::vector<int> verificationOrder; //a random permutation of the data indices, the SPRT assumes that the data are verified in random order
+		std::atomic<int> nextIteration;
+		std::atomic<int> iterationLimit;
+		std::mutex stateMutex;
+		int bestInliersNumber;
+		std::vector<double> bestModel;
+		double sprtEpsilon; //the probability that a datum is an inlier of a good model
+		double sprtDelta; //the probability that a datum is an inlier of a bad model
+		double sprtDeltaSum;
+		int sprtDeltaCount;
+		double sprtLogThreshold;
+		int rejectedModelsNumber;
+
+		//The state of the preemptive scoring
+		std::vector<double> hypothesesList;
+		std::vector<int> hypothesesOrder; //the hypotheses in decreasing order of score, the first survivorsNumber are still scored
+		std::vector<int> hypothesesScores;
+		int survivorsNumber;
+		int scoredDataStart;
+		int scoredDataEnd;
+
+		void PrepareSampling(const std::vector<float>& scores);
+		void RunThreads(void (RobustEstimator::*threadFunction)(int), int numberOfThreads);
+		void GenerateHypotheses(int threadIndex);
+		void SelectPreemptively();
+		void GeneratePreemptiveHypotheses(int threadIndex);
+		void ScoreHypotheses(int threadIndex);
+		void DrawSample(int iteration, std::mt19937& generator, int* sample);
+		void DrawFromBest(int setSize, int count, std::mt19937& generator, int* sample);
+		int VerifyModel(const double* model, const VerificationState& verificationState, std::vector<float>& errors, int& verifiedData);
+		VerificationState GetVerificationState();
+		void UpdateBestModel(const double* model, int inliersNumber);
+		void LowerIterationLimit(int newIterationLimit);
+		bool IsTimeOver() const;
+		void UpdateRejectionStatistics(int inliersNumber, int verifiedData);
+		void UpdateSprtThreshold();
+		int ComputeIterationLimit(int inliersNumber) const;
+		int CollectInliers(const double* model, std::vector<int>& inliers) const;
+	};
+
+}
+
+#endif
+/* RobustEstimator.hpp */
+/** @} */
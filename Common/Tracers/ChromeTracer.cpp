@@ -0,0 +1,172 @@
+/* --------------------------------------------------------------------------
+*
+* (C) Copyright …
+*
+* ---------------------------------------------------------------------------
+*/
+
+/*!
+ * @file ChromeTracer.cpp
+ * @date 19/10/2026
+ * @author Alessandro Bianco
+ */
+
+/*!
+ * @addtogroup Common
+ *
+ * Implementation of the ChromeTracer class
+ *
+ *
+ * @{
+ */
+/* --------------------------------------------------------------------------
+ *
+ * Includes
+ *
+ * --------------------------------------------------------------------------
+ */
+#include "ChromeTracer.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <unistd.h>
+
+namespace Tracers
+{
+
+/* --------------------------------------------------------------------------
+ *
+ * Public Member Functions
+ *
+ * --------------------------------------------------------------------------
+ */
+
+void ChromeTracer::Start()
+	{
+	Now(); //makes sure the epoch is set before the first event
+	recording.store(true);
+	}
+
+void ChromeTracer::Stop()
+	{
+	recording.store(false);
+	}
+
+void ChromeTracer::Clear()
+	{
+	std::lock_guard<std::mutex> buffersLock(buffersMutex);
+	for(unsigned bufferIndex = 0; bufferIndex < buffersList.size(); bufferIndex++)
+		{
+		std::lock_guard<std::mutex> eventsLock(buffersList.at(bufferIndex)->mutex);
+		buffersList.at(bufferIndex)->eventsList.clear();
+		}
+	}
+
+bool ChromeTracer::Export(const std::string& filePath)
+	{
+	std::ofstream file(filePath.c_str());
+	if (!file.good())
+		{
+		return false;
+		}
+
+	const long processId = static_cast<long>( getpid() );
+	bool firstEvent = true;
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+	std::lock_guard<std::mutex> buffersLock(buffersMutex);
+	for(unsigned bufferIndex = 0; bufferIndex < buffersList.size(); bufferIndex++)
+		{
+		ThreadBuffer& buffer = *(buffersList.at(bufferIndex));
+		std::lock_guard<std::mutex> eventsLock(buffer.mutex);
+
+		file << (firstEvent ? "\n" : ",\n");
+		file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << processId << ",\"tid\":" << buffer.threadId;
+		file << ",\"args\":{\"name\":\"cdff thread " << buffer.threadId << "\"}}";
+		firstEvent = false;
+
+		for(std::vector<TraceEvent>::const_iterator event = buffer.eventsList.begin(); event != buffer.eventsList.end(); ++event)
+			{
+			file << ",\n{\"name\":";
+			WriteEscapedString(file, event->name);
+			file << ",\"cat\":";
+			WriteEscapedString(file, event->category);
+			file << ",\"ph\":\"X\",\"ts\":" << event->startTime << ",\"dur\":" << event->duration;
+			file << ",\"pid\":" << processId << ",\"tid\":" << buffer.threadId << "}";
+			}
+		}
+
+	file << "\n]}\n";
+	return file.good();
+	}
+
+uint64_t ChromeTracer::Now()
+	{
+	static const std::chrono::steady_clock::time_point EPOCH = std::chrono::steady_clock::now();
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - EPOCH).count();
+	}
+
+void ChromeTracer::AddCompleteEvent(const char* name, const char* category, uint64_t startTime, uint64_t duration)
+	{
+	ThreadBuffer& buffer = GetThreadBuffer();
+	TraceEvent event = { name, category, startTime, duration };
+
+	//The lock is only ever contended by Export() and Clear()
+	std::lock_guard<std::mutex> eventsLock(buffer.mutex);
+	buffer.eventsList.push_back(event);
+	}
+
+/* --------------------------------------------------------------------------
+ *
+ * Private Member Variables
+ *
+ * --------------------------------------------------------------------------
+ */
+
+std::atomic<bool> ChromeTracer::recording(false);
+std::mutex ChromeTracer::buffersMutex;
+std::vector< std::shared_ptr<ChromeTracer::ThreadBuffer> > ChromeTracer::buffersList;
+
+/* --------------------------------------------------------------------------
+ *
+ * Private Member Functions
+ *
+ * --------------------------------------------------------------------------
+ */
+
+ChromeTracer::ThreadBuffer& ChromeTracer::GetThreadBuffer()
+	{
+	static const unsigned INITIAL_BUFFER_CAPACITY = 4096;
+	thread_local std::shared_ptr<ThreadBuffer> threadBuffer;
+
+	if (!threadBuffer)
+		{
+		threadBuffer = std::make_shared<ThreadBuffer>();
+		threadBuffer->eventsList.reserve(INITIAL_BUFFER_CAPACITY);
+
+		//Buffers are kept alive by the list after their thread terminates, so that their events can still be exported
+		std::lock_guard<std::mutex> buffersLock(buffersMutex);
+		threadBuffer->threadId = buffersList.size();
+		buffersList.push_back(threadBuffer);
+		}
+
+	return *threadBuffer;
+	}
+
+void ChromeTracer::WriteEscapedString(std::ostream& stream, const char* string)
+	{
+	stream << '"';
+	for(const char* character = string; *character != '\0'; character++)
+		{
+		if (*character == '"' || *character == '\\')
+			{
+			stream << '\\';
+			}
+		stream << *character;
+		}
+	stream << '"';
+	}
+
+}
+
+/** @} */
@@ -0,0 +1,166 @@
+/* --------------------------------------------------------------------------
+*
+* (C) Copyright …
+*
+* --------------------------------------------------------------------------
+*/
+
+/*!
+ * @file ChromeTracer.hpp
+ * @date 19/10/2026
+ * @author Alessandro Bianco
+ */
+
+/*!
+ * @addtogroup Common
+ *
+ *  The Chrome tracer collects timed events (e.g. DFPC runs, DFN executions, type conversions and copies) into one buffer per thread, and exports them as a Chrome trace JSON file
+ *  that can be opened in chrome://tracing or in the Perfetto UI. Events are only recorded between a call to Start() and a call to Stop().
+ *
+ *  Do not use this class directly to instrument code, use the macros in Macros/TracingMacros.hpp instead: they compile to nothing unless the TRACING preprocessor definition is set.
+ *
+ * @{
+ */
+
+#ifndef CHROME_TRACER_HPP
+#define CHROME_TRACER_HPP
+
+/* --------------------------------------------------------------------------
+ *
+ * Includes
+ *
+ * --------------------------------------------------------------------------
+ */
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+
+namespace Tracers
+{
+
+/* --------------------------------------------------------------------------
+ *
+ * Class definition
+ *
+ * --------------------------------------------------------------------------
+ */
+class ChromeTracer
+	{
+	/* --------------------------------------------------------------------
+	 * Public
+	 * --------------------------------------------------------------------
+	 */
+	public:
+		static void Start();
+		static void Stop();
+		static void Clear();
+
+		/*
+		* @brief Writes all the events recorded so far, by all threads, to a Chrome trace JSON file.
+		*
+		* @param filePath, path of the output file.
+		* @output, true if the file could be written.
+		*/
+		static bool Export(const std::string& filePath);
+
+		static inline bool IsRecording()
+			{
+			return recording.load(std::memory_order_relaxed);
+			}
+
+		/*
+		* @brief Timestamp in microseconds since the tracer epoch, taken from a monotonic clock.
+		*/
+		static uint64_t Now();
+
+		/*
+		* @brief Adds a complete event to the buffer of the calling thread. Name and category have to be string literals, only their pointers are stored.
+		*/
+		static void AddCompleteEvent(const char* name, const char* category, uint64_t startTime, uint64_t duration);
+
+	/* --------------------------------------------------------------------
+	 * Protected
+	 * --------------------------------------------------------------------
+	 */
+	protected:
+
+	/* --------------------------------------------------------------------
+	 * Private
+	 * --------------------------------------------------------------------
+	 */
+	private:
+		struct TraceEvent
+			{
+			const char* name;
+			const char* category;
+			uint64_t startTime;
+			uint64_t duration;
+			};
+
+		struct ThreadBuffer
+			{
+			uint32_t threadId;
+			std::mutex mutex;
+			std::vector<TraceEvent> eventsList;
+			};
+
+		static std::atomic<bool> recording;
+		static std::mutex buffersMutex;
+		static std::vector< std::shared_ptr<ThreadBuffer> > buffersList;
+
+		static ThreadBuffer& GetThreadBuffer();
+		static void WriteEscapedString(std::ostream& stream, const char* string);
+	};
+
+/* --------------------------------------------------------------------------
+ *
+ * Class definition
+ *
+ * --------------------------------------------------------------------------
+ */
+class ScopedTraceEvent
+	{
+	/* --------------------------------------------------------------------
+	 * Public
+	 * --------------------------------------------------------------------
+	 */
+	public:
+		inline ScopedTraceEvent(const char* name, const char* category) :
+			name(name),
+			category(category),
+			active( ChromeTracer::IsRecording() ),
+			startTime( active ? ChromeTracer::Now() : 0 )
+			{
+
+			}
+
+		inline ~ScopedTraceEvent()
+			{
+			if (active)
+				{
+				ChromeTracer::AddCompleteEvent(name, category, startTime, ChromeTracer::Now() - startTime);
+				}
+			}
+
+	/* --------------------------------------------------------------------
+	 * Private
+	 * --------------------------------------------------------------------
+	 */
+	private:
+		const char* name;
+		const char* category;
+		bool active;
+		uint64_t startTime;
+
+		ScopedTraceEvent(const ScopedTraceEvent&);
+		ScopedTraceEvent& operator=(const ScopedTraceEvent&);
+	};
+
+}
+
+#endif
+/* ChromeTracer.hpp */
+/** @} */
@@ -8,6 +8,7 @@
  */
 
 #include "Array3D.hpp"
+#include "Macros/TracingMacros.hpp"
 
 namespace Array3DWrapper
 {
@@ -24,6 +25,7 @@ using namespace BaseTypesWrapper;
 
 void Copy(const Array3D& source, Array3D& destination)
 {
+	TRACE_SCOPE_CATEGORY("Copy Array3D", "Copy");
 	destination.msgVersion = source.msgVersion;
     destination.rows = source.rows;
     destination.cols = source.cols;
@@ -9,6 +9,7 @@
 
 #include "CorrespondenceMap2D.hpp"
 #include "Errors/AssertOnTest.hpp"
+#include "Macros/TracingMacros.hpp"
 
 namespace CorrespondenceMap2DWrapper
 {
@@ -17,6 +18,7 @@ using namespace BaseTypesWrapper;
 
 void Copy(const CorrespondenceMap2D& source, CorrespondenceMap2D& destination)
 {
+	TRACE_SCOPE_CATEGORY("Copy CorrespondenceMap2D", "Copy");
 	ClearCorrespondences(destination);
 	int numberOfCorrespondences = GetNumberOfCorrespondences(source);
 	for (int correspondenceIndex = 0; correspondenceIndex < numberOfCorrespondences; correspondenceIndex++)
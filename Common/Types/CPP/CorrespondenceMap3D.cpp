@@ -9,6 +9,7 @@
 
 #include "CorrespondenceMap3D.hpp"
 #include "Errors/AssertOnTest.hpp"
+#include "Macros/TracingMacros.hpp"
 
 namespace CorrespondenceMap3DWrapper
 {
@@ -17,6 +18,7 @@ using namespace BaseTypesWrapper;
 
 void Copy(const CorrespondenceMap3D& source, CorrespondenceMap3D& destination)
 {
+	TRACE_SCOPE_CATEGORY("Copy CorrespondenceMap3D", "Copy");
 	ClearCorrespondences(destination);
 	int numberOfCorrespondences = GetNumberOfCorrespondences(source);
 	for (int correspondenceIndex = 0; correspondenceIndex < numberOfCorrespondences; correspondenceIndex++)
@@ -9,6 +9,7 @@
 
 #include "CorrespondenceMaps2DSequence.hpp"
 #include "Errors/AssertOnTest.hpp"
+#include "Macros/TracingMacros.hpp"
 
 namespace CorrespondenceMap2DWrapper
 {
@@ -17,6 +18,7 @@ using namespace BaseTypesWrapper;
 
 void Copy(const CorrespondenceMaps2DSequence& source, CorrespondenceMaps2DSequence& destination)
 {
+	TRACE_SCOPE_CATEGORY("Copy CorrespondenceMaps2DSequence", "Copy");
 	Clear(destination);
 	T_UInt32 numberOfMaps = GetNumberOfCorrespondenceMaps(source);
 	for(T_UInt32 correspondenceMapIndex = 0; correspondenceMapIndex < numberOfMaps; correspondenceMapIndex++)
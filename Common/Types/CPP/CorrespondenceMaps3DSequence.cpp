@@ -9,6 +9,7 @@
 
 #include "CorrespondenceMaps3DSequence.hpp"
 #include "Errors/AssertOnTest.hpp"
+#include "Macros/TracingMacros.hpp"
 
 namespace CorrespondenceMap3DWrapper
 {
@@ -17,6 +18,7 @@ using namespace BaseTypesWrapper;
 
 void Copy(const CorrespondenceMaps3DSequence& source, CorrespondenceMaps3DSequence& destination)
 {
+	TRACE_SCOPE_CATEGORY("Copy CorrespondenceMaps3DSequence", "Copy");
 	Clear(destination);
 	T_UInt32 numberOfMaps = GetNumberOfCorrespondenceMaps(source);
 	for(T_UInt32 correspondenceMapIndex = 0; correspondenceMapIndex < numberOfMaps; correspondenceMapIndex++)
@@ -8,6 +8,7 @@
  */
 
 #include "Frame.hpp"
+#include "Macros/TracingMacros.hpp"
 
 namespace FrameWrapper
 {
@@ -46,7 +47,7 @@ using namespace BaseTypesWrapper;
 
 void Copy(const Frame& source, Frame& destination)
 {
-
+	TRACE_SCOPE_CATEGORY("Copy Frame", "Copy");
 	destination.msgVersion = source.msgVersion;
 	destination.metadata.msgVersion = source.metadata.msgVersion;
 	destination.metadata.timeStamp = source.metadata.timeStamp;
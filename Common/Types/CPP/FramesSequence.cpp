@@ -9,6 +9,7 @@
 
 #include "FramesSequence.hpp"
 #include "Errors/AssertOnTest.hpp"
+#include "Macros/TracingMacros.hpp"
 
 namespace FrameWrapper
 {
@@ -17,6 +18,7 @@ using namespace BaseTypesWrapper;
 
 void Copy(const FramesSequence& source, FramesSequence& destination)
 {
+	TRACE_SCOPE_CATEGORY("Copy FramesSequence", "Copy");
 	Clear(destination);
 	T_UInt32 numberOfFrames = GetNumberOfFrames(destination);
 	for(T_UInt32 frameIndex = 0; frameIndex < numberOfFrames; frameIndex++)
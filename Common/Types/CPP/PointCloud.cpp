@@ -9,6 +9,7 @@
 
 #include "PointCloud.hpp"
 #include "Errors/AssertOnTest.hpp"
+#include "Macros/TracingMacros.hpp"
 
 namespace PointCloudWrapper
 {
@@ -17,6 +18,7 @@ using namespace BaseTypesWrapper;
 
 void Copy(const PointCloud& source, PointCloud& destination)
 {
+	TRACE_SCOPE_CATEGORY("Copy PointCloud", "Copy");
 	ClearPoints(destination);
 	int numberOfPoints = GetNumberOfPoints(source);
 	for (int pointIndex = 0; pointIndex < numberOfPoints; pointIndex++)
@@ -54,6 +56,19 @@ void AddPoint(PointCloud& pointCloud, T_Double x, T_Double y, T_Double z)
 	pointCloud.data.points.nCount++;
 }
 
+void AddPoints(PointCloud& pointCloud, const T_Double* coordinatesList, int numberOfPoints)
+{
+	ASSERT_ON_TEST(numberOfPoints >= 0 && pointCloud.data.points.nCount + numberOfPoints <= MAX_CLOUD_SIZE, "Point Cloud maximum capacity has been reached");
+	int firstIndex = pointCloud.data.points.nCount;
+	for(int pointIndex = 0; pointIndex < numberOfPoints; pointIndex++)
+	{
+		pointCloud.data.points.arr[firstIndex + pointIndex].arr[0] = coordinatesList[3*pointIndex];
+		pointCloud.data.points.arr[firstIndex + pointIndex].arr[1] = coordinatesList[3*pointIndex + 1];
+		pointCloud.data.points.arr[firstIndex + pointIndex].arr[2] = coordinatesList[3*pointIndex + 2];
+	}
+	pointCloud.data.points.nCount = firstIndex + numberOfPoints;
+}
+
 void AddColorToLastPoint(PointCloud& pointCloud, BaseTypesWrapper::T_Double r, BaseTypesWrapper::T_Double g, BaseTypesWrapper::T_Double b, BaseTypesWrapper::T_Double alpha)
 	{
 	int lastAddedIndex = pointCloud.data.points.nCount - 1;
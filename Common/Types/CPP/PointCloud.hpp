@@ -48,6 +48,7 @@ PointCloudSharedPtr NewSharedPointCloud();
 void Initialize(PointCloud& pointCloud);
 
 void AddPoint(PointCloud& pointCloud, BaseTypesWrapper::T_Double x, BaseTypesWrapper::T_Double y, BaseTypesWrapper::T_Double z);
+void AddPoints(PointCloud& pointCloud, const BaseTypesWrapper::T_Double* coordinatesList, int numberOfPoints); // coordinatesList is x0 y0 z0 x1 y1 z1 ...
 void AddColorToLastPoint(PointCloud& pointCloud, BaseTypesWrapper::T_Double r, BaseTypesWrapper::T_Double g, BaseTypesWrapper::T_Double b, BaseTypesWrapper::T_Double alpha);
 void ClearPoints(PointCloud& pointCloud);
 int GetNumberOfPoints(const PointCloud& pointCloud);
@@ -9,6 +9,7 @@
 
 #include "PosesSequence.hpp"
 #include "Errors/AssertOnTest.hpp"
+#include "Macros/TracingMacros.hpp"
 
 namespace PoseWrapper
 {
@@ -17,6 +18,7 @@ using namespace BaseTypesWrapper;
 
 void Copy(const Poses3DSequence& source, Poses3DSequence& destination)
 {
+	TRACE_SCOPE_CATEGORY("Copy Poses3DSequence", "Copy");
 	Clear(destination);
 	T_UInt32 numberOfPoses = GetNumberOfPoses(source);
 	for(T_UInt32 poseIndex = 0; poseIndex < numberOfPoses; poseIndex++)
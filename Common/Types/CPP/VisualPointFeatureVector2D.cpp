@@ -9,8 +9,11 @@
 
 #include "VisualPointFeatureVector2D.hpp"
 #include "Errors/AssertOnTest.hpp"
+#include "Macros/TracingMacros.hpp"
 #include "BaseTypes.hpp"
 
+#include <algorithm>
+
 using namespace BaseTypesWrapper;
 
 namespace VisualPointFeatureVector2DWrapper
@@ -18,11 +21,18 @@ namespace VisualPointFeatureVector2DWrapper
 
 void Copy(const VisualPointFeatureVector2D& source, VisualPointFeatureVector2D& destination)
 {
+	TRACE_SCOPE_CATEGORY("Copy VisualPointFeatureVector2D", "Copy");
 	ClearPoints(destination);
+	SetDescriptorType(destination, GetDescriptorType(source));
 	int numberOfPoints = GetNumberOfPoints(source);
 	for (int pointIndex = 0; pointIndex < numberOfPoints; pointIndex++)
 	{
 		AddPoint(destination, GetXCoordinate(source, pointIndex), GetYCoordinate(source, pointIndex));
+		if (GetDescriptorType(source) == BINARY_DESCRIPTORS)
+		{
+			SetBinaryDescriptor(destination, pointIndex, GetBinaryDescriptor(source, pointIndex), GetNumberOfBinaryDescriptorBytes(source, pointIndex));
+			continue;
+		}
 		ClearDescriptor(destination, pointIndex);
 		int numberOfDescriptorComponents = GetNumberOfDescriptorComponents(source, pointIndex);
 		for (int componentIndex = 0; componentIndex < numberOfDescriptorComponents; componentIndex++)
@@ -49,66 +59,101 @@ VisualPointFeatureVector2DSharedPtr NewSharedVisualPointFeatureVector2D()
 void Initialize(VisualPointFeatureVector2D& featuresVector)
 {
 	ClearPoints(featuresVector);
+	featuresVector.descriptor_type = FLOAT_DESCRIPTORS;
 }
 
 void AddPoint(VisualPointFeatureVector2D& featuresVector, uint16_t x, uint16_t y)
 {
-	ASSERT_ON_TEST(featuresVector.nCount < MAX_FEATURE_2D_POINTS, "Features descriptor vector maximum capacity has been reached");
-	int currentIndex = featuresVector.nCount;
-	featuresVector.arr[currentIndex].point.arr[0] = x;
-	featuresVector.arr[currentIndex].point.arr[1] = y;
-	featuresVector.arr[currentIndex].descriptor.nCount = 0;
-	featuresVector.nCount++;
+	ASSERT_ON_TEST(featuresVector.list.nCount < MAX_FEATURE_2D_POINTS, "Features descriptor vector maximum capacity has been reached");
+	int currentIndex = featuresVector.list.nCount;
+	featuresVector.list.arr[currentIndex].point.arr[0] = x;
+	featuresVector.list.arr[currentIndex].point.arr[1] = y;
+	featuresVector.list.arr[currentIndex].descriptor.nCount = 0;
+	featuresVector.list.arr[currentIndex].binary_descriptor.nCount = 0;
+	featuresVector.list.nCount++;
 }
 
 void ClearPoints(VisualPointFeatureVector2D& featuresVector)
 {
-	featuresVector.nCount = 0;
+	featuresVector.list.nCount = 0;
 }
 
 int GetNumberOfPoints(const VisualPointFeatureVector2D& featuresVector)
 {
-	return featuresVector.nCount;
+	return featuresVector.list.nCount;
 }
 
 int GetXCoordinate(const VisualPointFeatureVector2D& featuresVector, int pointIndex)
 {
-	ASSERT_ON_TEST(pointIndex < featuresVector.nCount, "A missing point was requested from a features vector 2D");
-	return featuresVector.arr[pointIndex].point.arr[0];
+	ASSERT_ON_TEST(pointIndex < featuresVector.list.nCount, "A missing point was requested from a features vector 2D");
+	return featuresVector.list.arr[pointIndex].point.arr[0];
 }
 
 int GetYCoordinate(const VisualPointFeatureVector2D& featuresVector, int pointIndex)
 {
-	ASSERT_ON_TEST(pointIndex < featuresVector.nCount, "A missing point was requested from a features vector 2D");
-	return featuresVector.arr[pointIndex].point.arr[1];
+	ASSERT_ON_TEST(pointIndex < featuresVector.list.nCount, "A missing point was requested from a features vector 2D");
+	return featuresVector.list.arr[pointIndex].point.arr[1];
 }
 
 void AddDescriptorComponent(VisualPointFeatureVector2D& featuresVector, int pointIndex, float component)
 {
-	ASSERT_ON_TEST(pointIndex < featuresVector.nCount, "A missing point was requested from a features vector 2D");
-	ASSERT_ON_TEST(featuresVector.arr[pointIndex].descriptor.nCount < MAX_DESCRIPTOR_2D_LENGTH, "Descriptor maximum capacity has been reached");
-	int currentIndex = featuresVector.arr[pointIndex].descriptor.nCount;
-	featuresVector.arr[pointIndex].descriptor.arr[currentIndex] = component;
-	featuresVector.arr[pointIndex].descriptor.nCount++;
+	ASSERT_ON_TEST(featuresVector.descriptor_type == FLOAT_DESCRIPTORS, "A float descriptor component was added to a binary features vector 2D");
+	ASSERT_ON_TEST(pointIndex < featuresVector.list.nCount, "A missing point was requested from a features vector 2D");
+	ASSERT_ON_TEST(featuresVector.list.arr[pointIndex].descriptor.nCount < MAX_DESCRIPTOR_2D_LENGTH, "Descriptor maximum capacity has been reached");
+	int currentIndex = featuresVector.list.arr[pointIndex].descriptor.nCount;
+	featuresVector.list.arr[pointIndex].descriptor.arr[currentIndex] = component;
+	featuresVector.list.arr[pointIndex].descriptor.nCount++;
 }
 
 void ClearDescriptor(VisualPointFeatureVector2D& featuresVector, int pointIndex)
 {
-	ASSERT_ON_TEST(pointIndex < featuresVector.nCount, "A missing point was requested from a features vector 2D");
-	featuresVector.arr[pointIndex].descriptor.nCount = 0;
+	ASSERT_ON_TEST(pointIndex < featuresVector.list.nCount, "A missing point was requested from a features vector 2D");
+	featuresVector.list.arr[pointIndex].descriptor.nCount = 0;
 }
 
 int GetNumberOfDescriptorComponents(const VisualPointFeatureVector2D& featuresVector, int pointIndex)
 {
-	ASSERT_ON_TEST(pointIndex < featuresVector.nCount, "A missing point was requested from a features vector 2D");
-	return featuresVector.arr[pointIndex].descriptor.nCount;
+	ASSERT_ON_TEST(pointIndex < featuresVector.list.nCount, "A missing point was requested from a features vector 2D");
+	return featuresVector.list.arr[pointIndex].descriptor.nCount;
 }
 
 float GetDescriptorComponent(const VisualPointFeatureVector2D& featuresVector, int pointIndex, int componentIndex)
 {
-	ASSERT_ON_TEST(pointIndex < featuresVector.nCount, "A missing point was requested from a features vector 2D");
-	ASSERT_ON_TEST(componentIndex < featuresVector.arr[pointIndex].descriptor.nCount, "A missing descriptor component was requested from a features vector 2D");
-	return featuresVector.arr[pointIndex].descriptor.arr[componentIndex];
+	ASSERT_ON_TEST(pointIndex < featuresVector.list.nCount, "A missing point was requested from a features vector 2D");
+	ASSERT_ON_TEST(componentIndex < featuresVector.list.arr[pointIndex].descriptor.nCount, "A missing descriptor component was requested from a features vector 2D");
+	return featuresVector.list.arr[pointIndex].descriptor.arr[componentIndex];
+}
+
+void SetDescriptorType(VisualPointFeatureVector2D& featuresVector, VisualPointDescriptor2DType descriptorType)
+{
+	ASSERT_ON_TEST(featuresVector.list.nCount == 0 || featuresVector.descriptor_type == descriptorType, "The descriptor type of a non-empty features vector 2D cannot be changed");
+	featuresVector.descriptor_type = descriptorType;
+}
+
+VisualPointDescriptor2DType GetDescriptorType(const VisualPointFeatureVector2D& featuresVector)
+{
+	return featuresVector.descriptor_type;
+}
+
+void SetBinaryDescriptor(VisualPointFeatureVector2D& featuresVector, int pointIndex, const uint8_t* descriptor, int numberOfBytes)
+{
+	ASSERT_ON_TEST(pointIndex < featuresVector.list.nCount, "A missing point was requested from a features vector 2D");
+	ASSERT_ON_TEST(featuresVector.descriptor_type == BINARY_DESCRIPTORS, "A binary descriptor was added to a float features vector 2D");
+	ASSERT_ON_TEST(numberOfBytes <= MAX_BINARY_DESCRIPTOR_2D_LENGTH, "Binary descriptor maximum capacity has been exceeded");
+	std::copy(descriptor, descriptor + numberOfBytes, featuresVector.list.arr[pointIndex].binary_descriptor.arr);
+	featuresVector.list.arr[pointIndex].binary_descriptor.nCount = numberOfBytes;
+}
+
+int GetNumberOfBinaryDescriptorBytes(const VisualPointFeatureVector2D& featuresVector, int pointIndex)
+{
+	ASSERT_ON_TEST(pointIndex < featuresVector.list.nCount, "A missing point was requested from a features vector 2D");
+	return featuresVector.list.arr[pointIndex].binary_descriptor.nCount;
+}
+
+const uint8_t* GetBinaryDescriptor(const VisualPointFeatureVector2D& featuresVector, int pointIndex)
+{
+	ASSERT_ON_TEST(pointIndex < featuresVector.list.nCount, "A missing point was requested from a features vector 2D");
+	return reinterpret_cast<const uint8_t*>(featuresVector.list.arr[pointIndex].binary_descriptor.arr);
 }
 
 BitStream ConvertToBitStream(const VisualPointFeatureVector2D& vector)
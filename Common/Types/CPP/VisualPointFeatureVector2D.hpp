@@ -17,6 +17,7 @@
 
 #include "BaseTypes.hpp"
 #include <stdlib.h>
+#include <stdint.h>
 #include <memory>
 
 namespace VisualPointFeatureVector2DWrapper
@@ -27,11 +28,18 @@ namespace VisualPointFeatureVector2DWrapper
 typedef asn1SccVisualPointFeature2D_descriptor VisualPointDescriptor2D;
 typedef asn1SccVisualPointFeature2D VisualPointFeature2D;
 typedef asn1SccVisualPointFeatureVector2D VisualPointFeatureVector2D;
+typedef asn1SccVisualPointDescriptor2DType VisualPointDescriptor2DType;
+
+// Enumerated types
+
+const VisualPointDescriptor2DType FLOAT_DESCRIPTORS = asn1Sccfloat_descriptors;
+const VisualPointDescriptor2DType BINARY_DESCRIPTORS = asn1Sccbinary_descriptors;
 
 // Global constant variables
 
 const int MAX_FEATURE_2D_POINTS = static_cast<int>(features2DElementsMax);
 const int MAX_DESCRIPTOR_2D_LENGTH = static_cast<int>(descriptor2DNameLength);
+const int MAX_BINARY_DESCRIPTOR_2D_LENGTH = static_cast<int>(binaryDescriptor2DLength);
 
 // Pointer types
 
@@ -58,6 +66,17 @@ void ClearDescriptor(VisualPointFeatureVector2D& featuresVector, int pointIndex)
 int GetNumberOfDescriptorComponents(const VisualPointFeatureVector2D& featuresVector, int pointIndex);
 float GetDescriptorComponent(const VisualPointFeatureVector2D& featuresVector, int pointIndex, int componentIndex);
 
+/**
+ * A vector holds either float descriptors, made of components, or binary descriptors, made of packed bytes compared by Hamming distance.
+ * The type can be changed only while the vector is empty, the float type is the default.
+ */
+void SetDescriptorType(VisualPointFeatureVector2D& featuresVector, VisualPointDescriptor2DType descriptorType);
+VisualPointDescriptor2DType GetDescriptorType(const VisualPointFeatureVector2D& featuresVector);
+
+void SetBinaryDescriptor(VisualPointFeatureVector2D& featuresVector, int pointIndex, const uint8_t* descriptor, int numberOfBytes);
+int GetNumberOfBinaryDescriptorBytes(const VisualPointFeatureVector2D& featuresVector, int pointIndex);
+const uint8_t* GetBinaryDescriptor(const VisualPointFeatureVector2D& featuresVector, int pointIndex);
+
 BitStream ConvertToBitStream(const VisualPointFeatureVector2D& vector);
 void ConvertFromBitStream(BitStream bitStream, VisualPointFeatureVector2D& vector);
 
@@ -9,6 +9,7 @@
 
 #include "VisualPointFeatureVector3D.hpp"
 #include "Errors/AssertOnTest.hpp"
+#include "Macros/TracingMacros.hpp"
 #include "BaseTypes.hpp"
 
 using namespace BaseTypesWrapper;
@@ -18,6 +19,7 @@ namespace VisualPointFeatureVector3DWrapper
 
 void Copy(const VisualPointFeatureVector3D& source, VisualPointFeatureVector3D& destination)
 {
+	TRACE_SCOPE_CATEGORY("Copy VisualPointFeatureVector3D", "Copy");
 	ClearPoints(destination);
 	int numberOfPoints = GetNumberOfPoints(source);
 	for (int pointIndex = 0; pointIndex < numberOfPoints; pointIndex++)
@@ -21,6 +21,7 @@
 #include <FeaturesExtraction2D/HarrisDetector2D.hpp>
 #include <FeaturesExtraction2D/OrbDetectorDescriptor.hpp>
 #include <FeaturesMatching2D/FlannMatcher.hpp>
+#include <FeaturesTracking2D/LucasKanadeTracker.hpp>
 #include <FundamentalMatrixComputation/FundamentalMatrixRansac.hpp>
 #include <ImageDegradation/ImageDegradation.hpp>
 #include <ImageFiltering/ImageUndistortion.hpp>
@@ -77,8 +78,12 @@
 #include <StereoSlam/StereoSlamOrb.hpp>
 #endif
 
+#include <FeaturesMatching2D/HammingMatcher.hpp>
 #include <FeaturesMatching3D/BestDescriptorMatch.hpp>
 #include <ForceMeshGenerator/ThresholdForce.hpp>
+#include <PerspectiveNPointSolving/RansacPnpSolver.hpp>
+#include <StereoReconstruction/SemiGlobalMatching.hpp>
+#include <StereoReconstruction/PyramidalBlockMatching.hpp>
 
 #ifdef HAVE_EDRES
 #include <ImageDegradation/ImageDegradationEdres.hpp>
@@ -148,6 +153,10 @@ DFNCommonInterface* DFNsBuilder::CreateDFN(const std::string& dfnType, const std
 	{
 		return CreateFeaturesMatching3D(dfnImplementation);
 	}
+	else if (dfnType == "FeaturesTracking2D")
+	{
+		return CreateFeaturesTracking2D(dfnImplementation);
+	}
 	else if (dfnType == "FundamentalMatrixComputation")
 	{
 		return CreateFundamentalMatrixComputation(dfnImplementation);
@@ -397,6 +406,10 @@ FeaturesExtraction3DInterface* DFNsBuilder::CreateFeaturesExtraction3D(const std
 
 FeaturesMatching2DInterface* DFNsBuilder::CreateFeaturesMatching2D(const std::string& dfnImplementation)
 {
+	if (dfnImplementation == "HammingMatcher")
+	{
+		return new FeaturesMatching2D::HammingMatcher;
+	}
 #ifdef HAVE_OPENCV
 	if (dfnImplementation == "FlannMatcher")
 	{
@@ -427,6 +440,18 @@ FeaturesMatching3DInterface* DFNsBuilder::CreateFeaturesMatching3D(const std::st
 	return NULL;
 }
 
+FeaturesTracking2DInterface* DFNsBuilder::CreateFeaturesTracking2D(const std::string& dfnImplementation)
+{
+#ifdef HAVE_OPENCV
+	if (dfnImplementation == "LucasKanadeTracker")
+	{
+		return new FeaturesTracking2D::LucasKanadeTracker;
+	}
+#endif
+	ASSERT(false, "DFNsBuilder Error: unhandled DFN FeaturesTracking2D implementation");
+	return NULL;
+}
+
 FundamentalMatrixComputationInterface* DFNsBuilder::CreateFundamentalMatrixComputation(const std::string& dfnImplementation)
 {
 #ifdef HAVE_OPENCV
@@ -513,6 +538,10 @@ ImageRectificationInterface* DFNsBuilder::CreateImageRectification(const std::st
 
 PerspectiveNPointSolvingInterface* DFNsBuilder::CreatePerspectiveNPointSolving(const std::string& dfnImplementation)
 {
+	if (dfnImplementation == "RansacPnpSolver")
+	{
+		return new PerspectiveNPointSolving::RansacPnpSolver;
+	}
 #ifdef HAVE_OPENCV
 	if (dfnImplementation == "IterativePnpSolver")
 	{
@@ -603,6 +632,14 @@ StereoMotionEstimationInterface* DFNsBuilder::CreateStereoMotionEstimation(const
 
 StereoReconstructionInterface* DFNsBuilder::CreateStereoReconstruction(const std::string& dfnImplementation)
 {
+	if (dfnImplementation == "SemiGlobalMatching")
+	{
+		return new StereoReconstruction::SemiGlobalMatching;
+	}
+	if (dfnImplementation == "PyramidalBlockMatching")
+	{
+		return new StereoReconstruction::PyramidalBlockMatching;
+	}
 #ifdef HAVE_OPENCV
 	if (dfnImplementation == "DisparityMapping")
 	{
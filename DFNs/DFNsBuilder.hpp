@@ -24,6 +24,7 @@
 #include <FeaturesExtraction3D/FeaturesExtraction3DInterface.hpp>
 #include <FeaturesMatching2D/FeaturesMatching2DInterface.hpp>
 #include <FeaturesMatching3D/FeaturesMatching3DInterface.hpp>
+#include <FeaturesTracking2D/FeaturesTracking2DInterface.hpp>
 #include <FundamentalMatrixComputation/FundamentalMatrixComputationInterface.hpp>
 #include <ImageDegradation/ImageDegradationInterface.hpp>
 #include <ImageFiltering/ImageFilteringInterface.hpp>
@@ -76,6 +77,7 @@ namespace DFN
 			static FeaturesExtraction3DInterface* CreateFeaturesExtraction3D(const std::string& dfnImplementation);
 			static FeaturesMatching2DInterface* CreateFeaturesMatching2D(const std::string& dfnImplementation);
 			static FeaturesMatching3DInterface* CreateFeaturesMatching3D(const std::string& dfnImplementation);
+			static FeaturesTracking2DInterface* CreateFeaturesTracking2D(const std::string& dfnImplementation);
 			static FundamentalMatrixComputationInterface* CreateFundamentalMatrixComputation(const std::string& dfnImplementation);
             static ImageDegradationInterface* CreateImageDegradation(const std::string& dfnImplementation);
 			static ImageFilteringInterface* CreateImageFiltering(const std::string& dfnImplementation);
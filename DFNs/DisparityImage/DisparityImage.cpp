@@ -5,6 +5,10 @@
 
 #include "DisparityImage.hpp"
 
+#include <Helpers/DisparityRangeHelper.hpp>
+
+#include <algorithm>
+
 namespace CDFF
 {
 namespace DFN
@@ -33,6 +37,13 @@ DisparityImage::DisparityImage()
     parametersHelper.AddParameter<int>("stereoSGBMParams", "P2", parameters.stereoMatcher.sgbmParams.P2, DEFAULT_PARAMETERS.stereoMatcher.sgbmParams.P2);
     parametersHelper.AddParameter<int>("stereoSGBMParams", "mode", parameters.stereoMatcher.sgbmParams.mode, DEFAULT_PARAMETERS.stereoMatcher.sgbmParams.mode);
 
+    parametersHelper.AddParameter<int>("bandsParams", "numBands", parameters.bands.numBands, DEFAULT_PARAMETERS.bands.numBands);
+    parametersHelper.AddParameter<int>("bandsParams", "bandOverlap", parameters.bands.bandOverlap, DEFAULT_PARAMETERS.bands.bandOverlap);
+
+    parametersHelper.AddParameter<bool>("temporalParams", "usePrediction", parameters.temporal.usePrediction, DEFAULT_PARAMETERS.temporal.usePrediction);
+    parametersHelper.AddParameter<int>("temporalParams", "margin", parameters.temporal.margin, DEFAULT_PARAMETERS.temporal.margin);
+    parametersHelper.AddParameter<int>("temporalParams", "refreshPeriod", parameters.temporal.refreshPeriod, DEFAULT_PARAMETERS.temporal.refreshPeriod);
+
 #if WITH_XIMGPROC
     parametersHelper.AddParameter<bool>("filterParams", "useFilter", parameters.filter.useFilter, DEFAULT_PARAMETERS.filter.useFilter);
     parametersHelper.AddParameter<bool>("filterParams", "useConfidence", parameters.filter.useConfidence, DEFAULT_PARAMETERS.filter.useConfidence);
@@ -45,6 +56,7 @@ DisparityImage::DisparityImage()
     _useConfidence = false;
 #endif
 
+    _framesSinceFullRange = 0;
     configurationFilePath = "";
 }
 
@@ -67,141 +79,214 @@ void DisparityImage::process()
     cv::Mat imgRight(static_cast<int>(inFramePair.right.data.rows), static_cast<int>(inFramePair.right.data.cols), CV_MAKETYPE(static_cast<int>(inFramePair.right.data.depth), static_cast<int>(inFramePair.right.data.channels)), inFramePair.right.data.data.arr, inFramePair.right.data.rowSize);
     cv::Mat disparity;
 
+    bool resetFilter = false;
+    bool resetMatcher = false;
+#if WITH_XIMGPROC
+    if(parameters.stereoMatcher.algorithm != _algorithm){
+        _algorithm = parameters.stereoMatcher.algorithm;
+        resetFilter = true;
+        resetMatcher = true;
+    }
+    else if(parameters.filter.useConfidence != _useConfidence){
+        _useConfidence = parameters.filter.useConfidence;
+        resetFilter = true;
+    }
+#endif
+
+    // Bands smaller than their overlap would be mostly overlap
+    int numBands = std::max(1, std::min(parameters.bands.numBands, imgLeft.rows / std::max(1, parameters.bands.bandOverlap)));
+    if(static_cast<int>(_bands.size()) != numBands){
+        _bands.resize(static_cast<size_t>(numBands));
+    }
+
+    // The previous disparities are used only if they come from an image of the same size
+    bool fullRange = !parameters.temporal.usePrediction || _previousDisparity.size() != imgLeft.size() || _framesSinceFullRange >= parameters.temporal.refreshPeriod;
+    _framesSinceFullRange = fullRange ? 0 : _framesSinceFullRange + 1;
+
+    if(numBands == 1){
+        predictDisparityRange(_bands[0], _previousDisparity, fullRange);
+        computeDisparity(_bands[0], imgLeft, imgRight, disparity, resetFilter, resetMatcher);
+    }
+    else{
+        // Each band is matched with its overlap rows and only its own rows are copied into the full disparity image
+        disparity.create(imgLeft.rows, imgLeft.cols, CV_16S);
+        cv::parallel_for_(cv::Range(0, numBands), [&](const cv::Range& range){
+            for(int bandIndex = range.start; bandIndex < range.end; bandIndex++){
+                int firstRow = (imgLeft.rows * bandIndex) / numBands;
+                int endRow = (imgLeft.rows * (bandIndex + 1)) / numBands;
+                int firstMatchedRow = std::max(0, firstRow - parameters.bands.bandOverlap);
+                int endMatchedRow = std::min(imgLeft.rows, endRow + parameters.bands.bandOverlap);
+
+                cv::Mat bandDisparity;
+                predictDisparityRange(_bands[static_cast<size_t>(bandIndex)], fullRange ? cv::Mat() : _previousDisparity.rowRange(firstRow, endRow), fullRange);
+                computeDisparity(_bands[static_cast<size_t>(bandIndex)], imgLeft.rowRange(firstMatchedRow, endMatchedRow), imgRight.rowRange(firstMatchedRow, endMatchedRow), bandDisparity, resetFilter, resetMatcher);
+                bandDisparity.rowRange(firstRow - firstMatchedRow, endRow - firstMatchedRow).copyTo(disparity.rowRange(firstRow, endRow));
+            }
+        }, numBands);
+    }
+    _previousDisparity = disparity;
+
+    // Convert Mat to ASN.1
+    outDisparity.metadata.msgVersion = frame_Version;
+    outDisparity.metadata = inFramePair.left.metadata;
+    outDisparity.intrinsic = inFramePair.left.intrinsic;
+    outDisparity.extrinsic = inFramePair.left.extrinsic;
+
+    outDisparity.metadata.mode = asn1Sccmode_UNDEF;
+    outDisparity.metadata.pixelModel = asn1Sccpix_DISP;
+    outDisparity.metadata.errValues.arr[0].type = asn1Sccerror_UNDEFINED;
+    outDisparity.metadata.errValues.arr[0].value = -16.0;
+    outDisparity.metadata.errValues.nCount = 1;
+
+    double minDisp, maxDisp;
+    cv::minMaxLoc(disparity, &minDisp, &maxDisp);
+    outDisparity.metadata.pixelCoeffs.arr[0] = 16.0;
+    outDisparity.metadata.pixelCoeffs.arr[1] = 0.0;
+    outDisparity.metadata.pixelCoeffs.arr[2] = inFramePair.baseline;
+    outDisparity.metadata.pixelCoeffs.arr[3] = maxDisp;
+    outDisparity.metadata.pixelCoeffs.arr[4] = minDisp;
+
+    outDisparity.data.msgVersion = array3D_Version;
+    outDisparity.data.channels = static_cast<asn1SccT_UInt32>(disparity.channels());
+    outDisparity.data.rows = static_cast<asn1SccT_UInt32>(inFramePair.left.data.rows);
+    outDisparity.data.cols = static_cast<asn1SccT_UInt32>(inFramePair.left.data.cols);
+    outDisparity.data.depth = static_cast<asn1SccArray3D_depth_t>(disparity.depth());
+    outDisparity.data.rowSize = disparity.step[0];
+    outDisparity.data.data.nCount =  static_cast<int>(outDisparity.data.rows * outDisparity.data.rowSize);
+    memcpy(outDisparity.data.data.arr, disparity.data, static_cast<size_t>(outDisparity.data.data.nCount));
+}
+
+void DisparityImage::predictDisparityRange(BandMatchers& band, const cv::Mat& previousDisparity, bool fullRange)
+{
+    const int minDisparity = parameters.stereoMatcher.minDisparity;
+    const int numDisparities = parameters.stereoMatcher.numDisparities;
+    band._minDisparity = minDisparity;
+    band._numDisparities = numDisparities;
+    if(fullRange){
+        return;
+    }
+
+    // The invalid disparities of the OpenCV matchers are below minDisparity
+    Helpers::DisparityRange fullDisparityRange = {minDisparity, numDisparities};
+    Helpers::DisparityRange range = Helpers::PredictDisparityRange(previousDisparity.ptr<short>(0), previousDisparity.rows, previousDisparity.cols, static_cast<int>(previousDisparity.step1()),
+        16, static_cast<int16_t>(minDisparity * 16), fullDisparityRange, parameters.temporal.margin);
+    band._minDisparity = range.minimumDisparity;
+    band._numDisparities = range.numberOfDisparities;
+}
+
+void DisparityImage::computeDisparity(BandMatchers& band, const cv::Mat& imgLeft, const cv::Mat& imgRight, cv::Mat& disparity, bool resetFilter, bool resetMatcher)
+{
     // Using Algorithm StereoBM
     if(parameters.stereoMatcher.algorithm == 0){
-        if(_bm.empty()){
-            _bm = cv::StereoBM::create(parameters.stereoMatcher.numDisparities, parameters.stereoMatcher.blockSize);
+        if(band._bm.empty()){
+            band._bm = cv::StereoBM::create(band._numDisparities, parameters.stereoMatcher.blockSize);
+        }
+        else if(band._bm->getMinDisparity() != band._minDisparity || band._bm->getNumDisparities() != band._numDisparities){
+            // The right matcher and the filter copy the range of the matcher they are created from
+            resetFilter = true;
+            resetMatcher = true;
         }
 
-        _bm->setBlockSize(parameters.stereoMatcher.blockSize);
-        _bm->setDisp12MaxDiff(parameters.stereoMatcher.disp12MaxDiff);
-        _bm->setMinDisparity(parameters.stereoMatcher.minDisparity);
-        _bm->setNumDisparities(parameters.stereoMatcher.numDisparities);
-        _bm->setPreFilterCap(parameters.stereoMatcher.preFilterCap);
-        _bm->setPreFilterSize(parameters.stereoMatcher.bmParams.preFilterSize);
-        _bm->setPreFilterType(parameters.stereoMatcher.bmParams.preFilterType);
-        _bm->setSpeckleRange(parameters.stereoMatcher.speckleRange);
-        _bm->setSpeckleWindowSize(parameters.stereoMatcher.speckleWindowSize);
-        _bm->setTextureThreshold(parameters.stereoMatcher.bmParams.textureThreshold);
-        _bm->setUniquenessRatio(parameters.stereoMatcher.uniquenessRatio);
+        band._bm->setBlockSize(parameters.stereoMatcher.blockSize);
+        band._bm->setDisp12MaxDiff(parameters.stereoMatcher.disp12MaxDiff);
+        band._bm->setMinDisparity(band._minDisparity);
+        band._bm->setNumDisparities(band._numDisparities);
+        band._bm->setPreFilterCap(parameters.stereoMatcher.preFilterCap);
+        band._bm->setPreFilterSize(parameters.stereoMatcher.bmParams.preFilterSize);
+        band._bm->setPreFilterType(parameters.stereoMatcher.bmParams.preFilterType);
+        band._bm->setSpeckleRange(parameters.stereoMatcher.speckleRange);
+        band._bm->setSpeckleWindowSize(parameters.stereoMatcher.speckleWindowSize);
+        band._bm->setTextureThreshold(parameters.stereoMatcher.bmParams.textureThreshold);
+        band._bm->setUniquenessRatio(parameters.stereoMatcher.uniquenessRatio);
 
-        _bm->compute(imgLeft, imgRight, disparity);
+        band._bm->compute(imgLeft, imgRight, disparity);
 
     }
     // Using Algorithm StereoSGBM
     else if(parameters.stereoMatcher.algorithm == 1){
-        if(_sgbm.empty()){
-            _sgbm = cv::StereoSGBM::create(parameters.stereoMatcher.minDisparity, parameters.stereoMatcher.numDisparities, parameters.stereoMatcher.blockSize, parameters.stereoMatcher.sgbmParams.P1, parameters.stereoMatcher.sgbmParams.P2, parameters.stereoMatcher.disp12MaxDiff, parameters.stereoMatcher.preFilterCap, parameters.stereoMatcher.uniquenessRatio, parameters.stereoMatcher.speckleWindowSize, parameters.stereoMatcher.speckleRange, parameters.stereoMatcher.sgbmParams.mode);
+        if(band._sgbm.empty()){
+            band._sgbm = cv::StereoSGBM::create(band._minDisparity, band._numDisparities, parameters.stereoMatcher.blockSize, parameters.stereoMatcher.sgbmParams.P1, parameters.stereoMatcher.sgbmParams.P2, parameters.stereoMatcher.disp12MaxDiff, parameters.stereoMatcher.preFilterCap, parameters.stereoMatcher.uniquenessRatio, parameters.stereoMatcher.speckleWindowSize, parameters.stereoMatcher.speckleRange, parameters.stereoMatcher.sgbmParams.mode);
+        }
+        else if(band._sgbm->getMinDisparity() != band._minDisparity || band._sgbm->getNumDisparities() != band._numDisparities){
+            resetFilter = true;
+            resetMatcher = true;
         }
 
-        _sgbm->setBlockSize(parameters.stereoMatcher.blockSize);
-        _sgbm->setDisp12MaxDiff(parameters.stereoMatcher.disp12MaxDiff);
-        _sgbm->setMinDisparity(parameters.stereoMatcher.minDisparity);
-        _sgbm->setMode(parameters.stereoMatcher.sgbmParams.mode);
-        _sgbm->setNumDisparities(parameters.stereoMatcher.numDisparities);
-        _sgbm->setP1(parameters.stereoMatcher.sgbmParams.P1);
-        _sgbm->setP2(parameters.stereoMatcher.sgbmParams.P2);
-        _sgbm->setPreFilterCap(parameters.stereoMatcher.preFilterCap);
-        _sgbm->setSpeckleRange(parameters.stereoMatcher.speckleRange);
-        _sgbm->setSpeckleWindowSize(parameters.stereoMatcher.speckleWindowSize);
-        _sgbm->setUniquenessRatio(parameters.stereoMatcher.uniquenessRatio);
-
-        _sgbm->compute(imgLeft, imgRight, disparity);
+        band._sgbm->setBlockSize(parameters.stereoMatcher.blockSize);
+        band._sgbm->setDisp12MaxDiff(parameters.stereoMatcher.disp12MaxDiff);
+        band._sgbm->setMinDisparity(band._minDisparity);
+        band._sgbm->setMode(parameters.stereoMatcher.sgbmParams.mode);
+        band._sgbm->setNumDisparities(band._numDisparities);
+        band._sgbm->setP1(parameters.stereoMatcher.sgbmParams.P1);
+        band._sgbm->setP2(parameters.stereoMatcher.sgbmParams.P2);
+        band._sgbm->setPreFilterCap(parameters.stereoMatcher.preFilterCap);
+        band._sgbm->setSpeckleRange(parameters.stereoMatcher.speckleRange);
+        band._sgbm->setSpeckleWindowSize(parameters.stereoMatcher.speckleWindowSize);
+        band._sgbm->setUniquenessRatio(parameters.stereoMatcher.uniquenessRatio);
+
+        band._sgbm->compute(imgLeft, imgRight, disparity);
     }
 
-#if WITH_XIMGPROC
-    bool resetFilter = false;
-    bool resetMatcher = false;
-    if(parameters.stereoMatcher.algorithm != _algorithm){
-        _algorithm = parameters.stereoMatcher.algorithm;
-        resetFilter = true;
-        resetMatcher = true;
-    }
-    else if(parameters.filter.useConfidence != _useConfidence){
-        _useConfidence = parameters.filter.useConfidence;
-        resetFilter = true;
+    // Unmatched pixels of a predicted range are marked one below its minimum, they are brought back to the invalid value of the whole range
+    if(band._minDisparity != parameters.stereoMatcher.minDisparity){
+        disparity.setTo((parameters.stereoMatcher.minDisparity - 1) * 16, disparity < band._minDisparity * 16);
     }
 
+#if WITH_XIMGPROC
     if(parameters.filter.useFilter){
         cv::Mat disparityFiltered;
 
         if(parameters.filter.useConfidence){
             cv::Mat disparityRight;
-            if(_rightMatcher.empty() || resetMatcher){
+            if(band._rightMatcher.empty() || resetMatcher){
                 switch(_algorithm){
                 case 0:
-                    _rightMatcher = cv::ximgproc::createRightMatcher(_bm);
+                    band._rightMatcher = cv::ximgproc::createRightMatcher(band._bm);
                     break;
                 case 1:
-                    _rightMatcher = cv::ximgproc::createRightMatcher(_sgbm);
+                    band._rightMatcher = cv::ximgproc::createRightMatcher(band._sgbm);
                     break;
                 }
             }
 
-            _rightMatcher->compute(imgRight, imgLeft, disparityRight);
+            band._rightMatcher->compute(imgRight, imgLeft, disparityRight);
 
-            if(_filter.empty() || resetFilter){
+            if(band._filter.empty() || resetFilter){
                 switch(_algorithm){
                 case 0:
-                    _filter = cv::ximgproc::createDisparityWLSFilter(_bm);
+                    band._filter = cv::ximgproc::createDisparityWLSFilter(band._bm);
                     break;
                 case 1:
-                    _filter = cv::ximgproc::createDisparityWLSFilter(_sgbm);
+                    band._filter = cv::ximgproc::createDisparityWLSFilter(band._sgbm);
                     break;
                 }
             }
 
-            _filter->setDepthDiscontinuityRadius(parameters.filter.depthDiscontinuityRadius);
-            _filter->setLambda(parameters.filter.lambda);
-            _filter->setLRCthresh(parameters.filter.lrcThresh);
-            _filter->setSigmaColor(parameters.filter.sigmaColor);
+            band._filter->setDepthDiscontinuityRadius(parameters.filter.depthDiscontinuityRadius);
+            band._filter->setLambda(parameters.filter.lambda);
+            band._filter->setLRCthresh(parameters.filter.lrcThresh);
+            band._filter->setSigmaColor(parameters.filter.sigmaColor);
 
-            _filter->filter(disparity, imgLeft, disparityFiltered, disparityRight);
+            band._filter->filter(disparity, imgLeft, disparityFiltered, disparityRight);
         }
         else{
-            if(_filter.empty() || resetFilter){
-                _filter = cv::ximgproc::createDisparityWLSFilterGeneric(false);
+            if(band._filter.empty() || resetFilter){
+                band._filter = cv::ximgproc::createDisparityWLSFilterGeneric(false);
             }
 
-            _filter->setDepthDiscontinuityRadius(parameters.filter.depthDiscontinuityRadius);
-            _filter->setLambda(parameters.filter.lambda);
-            _filter->setSigmaColor(parameters.filter.sigmaColor);
+            band._filter->setDepthDiscontinuityRadius(parameters.filter.depthDiscontinuityRadius);
+            band._filter->setLambda(parameters.filter.lambda);
+            band._filter->setSigmaColor(parameters.filter.sigmaColor);
 
-            _filter->filter(disparity, imgLeft, disparityFiltered);
+            band._filter->filter(disparity, imgLeft, disparityFiltered);
         }
 
         disparity = disparityFiltered;
     }
+#else
+    (void)resetFilter;
+    (void)resetMatcher;
 #endif
-
-    // Convert Mat to ASN.1
-    outDisparity.metadata.msgVersion = frame_Version;
-    outDisparity.metadata = inFramePair.left.metadata;
-    outDisparity.intrinsic = inFramePair.left.intrinsic;
-    outDisparity.extrinsic = inFramePair.left.extrinsic;
-
-    outDisparity.metadata.mode = asn1Sccmode_UNDEF;
-    outDisparity.metadata.pixelModel = asn1Sccpix_DISP;
-    outDisparity.metadata.errValues.arr[0].type = asn1Sccerror_UNDEFINED;
-    outDisparity.metadata.errValues.arr[0].value = -16.0;
-    outDisparity.metadata.errValues.nCount = 1;
-
-    double minDisp, maxDisp;
-    cv::minMaxLoc(disparity, &minDisp, &maxDisp);
-    outDisparity.metadata.pixelCoeffs.arr[0] = 16.0;
-    outDisparity.metadata.pixelCoeffs.arr[1] = 0.0;
-    outDisparity.metadata.pixelCoeffs.arr[2] = inFramePair.baseline;
-    outDisparity.metadata.pixelCoeffs.arr[3] = maxDisp;
-    outDisparity.metadata.pixelCoeffs.arr[4] = minDisp;
-
-    outDisparity.data.msgVersion = array3D_Version;
-    outDisparity.data.channels = static_cast<asn1SccT_UInt32>(disparity.channels());
-    outDisparity.data.rows = static_cast<asn1SccT_UInt32>(inFramePair.left.data.rows);
-    outDisparity.data.cols = static_cast<asn1SccT_UInt32>(inFramePair.left.data.cols);
-    outDisparity.data.depth = static_cast<asn1SccArray3D_depth_t>(disparity.depth());
-    outDisparity.data.rowSize = disparity.step[0];
-    outDisparity.data.data.nCount =  static_cast<int>(outDisparity.data.rows * outDisparity.data.rowSize);
-    memcpy(outDisparity.data.data.arr, disparity.data, static_cast<size_t>(outDisparity.data.data.nCount));
 }
 
 void DisparityImage::ValidateParameters()
@@ -229,6 +314,10 @@ void DisparityImage::ValidateParameters()
         ASSERT(parameters.stereoMatcher.sgbmParams.P2 >= 0 && parameters.stereoMatcher.sgbmParams.P2 > parameters.stereoMatcher.sgbmParams.P1, "stereoMatcher.sgbmParams.P2 must be positive & stereoMatcher.sgbmParams.P2 > stereoMatcher.sgbmParams.P1");
     }
     ASSERT(parameters.stereoMatcher.sgbmParams.mode >= cv::StereoSGBM::MODE_SGBM && parameters.stereoMatcher.sgbmParams.mode <= cv::StereoSGBM::MODE_HH4, "stereoMatcher.sgbmParams.mode must be in the [0..3] range");
+    ASSERT(parameters.bands.numBands >= 1, "bands.numBands must be at least 1");
+    ASSERT(parameters.temporal.margin >= 0, "temporal.margin must be positive");
+    ASSERT(parameters.temporal.refreshPeriod >= 0, "temporal.refreshPeriod must be positive");
+    ASSERT(parameters.bands.numBands == 1 || 2 * parameters.bands.bandOverlap >= parameters.stereoMatcher.blockSize + parameters.stereoMatcher.bmParams.preFilterSize, "bands.bandOverlap must cover half of the block and of the pre-filter window");
 
 #if WITH_XIMGPROC
     ASSERT(parameters.filter.depthDiscontinuityRadius >= 0, "filter.depthDiscontinuityRadius must be positive");
@@ -259,6 +348,15 @@ const DisparityImage::DisparityImageParams DisparityImage::DEFAULT_PARAMETERS =
             .P2 = 0,
             .mode = cv::StereoSGBM::MODE_SGBM
         }
+    },
+    {
+        .numBands = 1,
+        .bandOverlap = 32
+    },
+    {
+        .usePrediction = false,
+        .margin = 8,
+        .refreshPeriod = 10
     }
     #if WITH_XIMGPROC
     ,
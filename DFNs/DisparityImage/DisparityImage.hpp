@@ -10,6 +10,7 @@
 #include "Helpers/ParametersListHelper.hpp"
 
 #include <opencv2/calib3d.hpp>
+#include <vector>
 
 #if WITH_XIMGPROC
 #include <opencv2/ximgproc.hpp>
@@ -195,9 +196,46 @@ namespace DisparityImage
                 double sigmaColor;
             };
 
+            struct bandsParams
+            {
+                /**
+                 * @brief Number of horizontal bands of the image whose disparities are computed in parallel on the OpenCV thread pool.
+                 * The right-matcher and the filter also run per band. Set it to 1 to process the whole image at once.
+                 */
+                int numBands;
+
+                /**
+                 * @brief Number of rows by which each band is extended above and below before matching, the extra rows are discarded when the bands are stitched.
+                 * It has to cover the matching block and the pre-filter window, larger values bring SGBM and the filter closer to their full image result.
+                 */
+                int bandOverlap;
+            };
+
+            struct temporalParams
+            {
+                /**
+                 * @brief Set to true to search each band only around the disparities the band had in the previous frame, instead of the whole [minDisparity, minDisparity + numDisparities) range.
+                 * The search range of a band spans the previous disparities of the band, without the 1% most extreme ones on each side, extended by the margin and rounded up to a multiple of 16.
+                 * More bands give tighter ranges.
+                 */
+                bool usePrediction;
+
+                /**
+                 * @brief Number of disparities by which the predicted range is extended on each side, it has to cover the disparity change between two frames.
+                 */
+                int margin;
+
+                /**
+                 * @brief Number of frames with a predicted range after which the whole range is searched again, so that objects entering the view are not missed.
+                 */
+                int refreshPeriod;
+            };
+
             struct DisparityImageParams
             {
                 stereoMatcherParams stereoMatcher;
+                bandsParams bands;
+                temporalParams temporal;
 #if WITH_XIMGPROC
                 filterParams filter;
 #endif
@@ -209,14 +247,31 @@ namespace DisparityImage
             void ValidateParameters();
 
         private:
-            cv::Ptr<cv::StereoBM> _bm;
-            cv::Ptr<cv::StereoSGBM> _sgbm;
+            /**
+             * @brief Matchers and filter of one band, OpenCV matchers keep their working buffers so each band needs its own
+             */
+            struct BandMatchers
+            {
+                int _minDisparity;
+                int _numDisparities;
+                cv::Ptr<cv::StereoBM> _bm;
+                cv::Ptr<cv::StereoSGBM> _sgbm;
+#if WITH_XIMGPROC
+                cv::Ptr<cv::ximgproc::DisparityWLSFilter> _filter;
+                cv::Ptr<cv::StereoMatcher> _rightMatcher;
+#endif
+            };
+
+            std::vector<BandMatchers> _bands;
+            cv::Mat _previousDisparity;
+            int _framesSinceFullRange;
 #if WITH_XIMGPROC
             int _algorithm;
             bool _useConfidence;
-            cv::Ptr<cv::ximgproc::DisparityWLSFilter> _filter;
-            cv::Ptr<cv::StereoMatcher> _rightMatcher;
 #endif
+
+            void predictDisparityRange(BandMatchers& band, const cv::Mat& previousDisparity, bool fullRange);
+            void computeDisparity(BandMatchers& band, const cv::Mat& imgLeft, const cv::Mat& imgRight, cv::Mat& disparity, bool resetFilter, bool resetMatcher);
     };
 }
 }
@@ -7,6 +7,12 @@
 #include <opencv2/core.hpp>
 #include <Errors/Assert.hpp>
 
+#include <limits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace CDFF
 {
 namespace DFN
@@ -15,7 +21,12 @@ namespace DisparityToPointCloud
 {
 
 DisparityToPointCloud::DisparityToPointCloud()
+: parameters(DEFAULT_PARAMETERS)
 {
+    parametersHelper.AddParameter<bool>("DisparityToPointCloudParams", "organized", parameters.organized, DEFAULT_PARAMETERS.organized);
+    parametersHelper.AddParameter<int>("DisparityToPointCloudParams", "stride", parameters.stride, DEFAULT_PARAMETERS.stride);
+
+    configurationFilePath = "";
 }
 
 DisparityToPointCloud::~DisparityToPointCloud()
@@ -24,6 +35,10 @@ DisparityToPointCloud::~DisparityToPointCloud()
 
 void DisparityToPointCloud::configure()
 {
+    if(configurationFilePath != ""){
+        parametersHelper.ReadFile(configurationFilePath);
+    }
+    ValidateParameters();
 }
 
 void DisparityToPointCloud::process()
@@ -65,11 +80,14 @@ template<typename T>
 bool DisparityToPointCloud::disp2ptcloud(asn1SccFrame &disp, asn1SccPointcloud &ptCloud)
 {
     if( disp.metadata.pixelModel != asn1Sccpix_DISP ){
-       	PRINT_ERROR("DisparityToPointCloud: Bad input data");
+        PRINT_ERROR("DisparityToPointCloud: Bad input data");
         return false;
     }
 
-    if( (disp.data.rows * disp.data.cols) > maxPointcloudSize ){
+    const int stride = parameters.stride;
+    const int sampledRows = (static_cast<int>(disp.data.rows) + stride - 1) / stride;
+    const int sampledCols = (static_cast<int>(disp.data.cols) + stride - 1) / stride;
+    if( (sampledRows * sampledCols) > maxPointcloudSize ){
         PRINT_ERROR("DisparityToPointCloud: Too many pixels to reproject, image needs to be degraded first");
         return false;
     }
@@ -78,9 +96,6 @@ bool DisparityToPointCloud::disp2ptcloud(asn1SccFrame &disp, asn1SccPointcloud &
     ptCloud.metadata.frameId = disp.extrinsic.pose_robotFrame_sensorFrame.metadata.childFrameId;
     ptCloud.metadata.timeStamp = disp.metadata.timeStamp;
     ptCloud.metadata.isRegistered = false;
-    ptCloud.metadata.isOrdered = true;
-    ptCloud.metadata.height = disp.data.rows;
-    ptCloud.metadata.width = disp.data.cols;
     ptCloud.metadata.hasFixedTransform = disp.extrinsic.hasFixedTransform;
     ptCloud.metadata.pose_robotFrame_sensorFrame = disp.extrinsic.pose_robotFrame_sensorFrame;
     ptCloud.metadata.pose_fixedFrame_robotFrame = disp.extrinsic.pose_fixedFrame_robotFrame;
@@ -89,29 +104,123 @@ bool DisparityToPointCloud::disp2ptcloud(asn1SccFrame &disp, asn1SccPointcloud &
 
     cv::Mat tmp(static_cast<int>(disp.data.rows), static_cast<int>(disp.data.cols), CV_MAKETYPE(static_cast<int>(disp.data.depth), static_cast<int>(disp.data.channels)), disp.data.data.arr, disp.data.rowSize);
 
+    // Factors shared by all the pixels of a column, of a row, or of the image
+    const double fx = disp.intrinsic.cameraMatrix.arr[0].arr[0];
+    const double fy = disp.intrinsic.cameraMatrix.arr[1].arr[1];
+    const double cx = disp.intrinsic.cameraMatrix.arr[0].arr[2];
+    const double cy = disp.intrinsic.cameraMatrix.arr[1].arr[2];
+    const double baseline = disp.metadata.pixelCoeffs.arr[2];
+    const double scale = disp.metadata.pixelCoeffs.arr[0];
+    const double offset = disp.metadata.pixelCoeffs.arr[1];
+    const double depthFactor = baseline * fx;
+
+    const size_t count = static_cast<size_t>(sampledCols);
+    _disparities.resize(count);
+    _columnFactors.resize(count);
+    _x.resize(count);
+    _y.resize(count);
+    _z.resize(count);
+    for (size_t k = 0; k < count; k++)
+    {
+        _columnFactors[k] = (static_cast<double>(k * stride) - cx) * baseline;
+    }
+
     ptCloud.data.points.nCount = 0;
-    for (int i = 0; i < tmp.rows; i++)
+    for (int i = 0; i < tmp.rows; i += stride)
     {
-        for (int j = 0; j < tmp.cols; j++)
+        const T* row = tmp.ptr<T>(i);
+        for (size_t k = 0; k < count; k++)
         {
-            ptCloud.data.points.arr[ptCloud.data.points.nCount].arr[2] = (disp.metadata.pixelCoeffs.arr[2] * disp.intrinsic.cameraMatrix.arr[0].arr[0]) / ((tmp.at<T>(i, j) * disp.metadata.pixelCoeffs.arr[0]) + disp.metadata.pixelCoeffs.arr[1]);
-            ptCloud.data.points.arr[ptCloud.data.points.nCount].arr[0] = ((j - disp.intrinsic.cameraMatrix.arr[0].arr[2]) / disp.intrinsic.cameraMatrix.arr[0].arr[0]) * ptCloud.data.points.arr[ptCloud.data.points.nCount].arr[2];
-            ptCloud.data.points.arr[ptCloud.data.points.nCount].arr[1] = ((i - disp.intrinsic.cameraMatrix.arr[1].arr[2]) / disp.intrinsic.cameraMatrix.arr[1].arr[1]) * ptCloud.data.points.arr[ptCloud.data.points.nCount].arr[2];
-            
-            if (std::isinf(ptCloud.data.points.arr[ptCloud.data.points.nCount].arr[0]) || std::isinf(ptCloud.data.points.arr[ptCloud.data.points.nCount].arr[1]) || std::isinf(ptCloud.data.points.arr[ptCloud.data.points.nCount].arr[2]))
+            _disparities[k] = static_cast<double>(row[k * stride]);
+        }
+        reprojectRow(count, scale, offset, (i - cy) * baseline * fx / fy, depthFactor);
+
+        for (size_t k = 0; k < count; k++)
+        {
+            if (parameters.organized || _z[k] == _z[k])
             {
-                ptCloud.data.points.arr[ptCloud.data.points.nCount].arr[2] = 0;
-                ptCloud.data.points.arr[ptCloud.data.points.nCount].arr[0] = 0;
-                ptCloud.data.points.arr[ptCloud.data.points.nCount].arr[1] = 0;
+                ptCloud.data.points.arr[ptCloud.data.points.nCount].arr[0] = _x[k];
+                ptCloud.data.points.arr[ptCloud.data.points.nCount].arr[1] = _y[k];
+                ptCloud.data.points.arr[ptCloud.data.points.nCount].arr[2] = _z[k];
+                ptCloud.data.points.nCount++;
             }
-            ptCloud.data.points.nCount++;
         }
     }
 
+    if (parameters.organized)
+    {
+        ptCloud.metadata.isOrdered = true;
+        ptCloud.metadata.height = static_cast<asn1SccT_UInt32>(sampledRows);
+        ptCloud.metadata.width = static_cast<asn1SccT_UInt32>(sampledCols);
+    }
+    else
+    {
+        ptCloud.metadata.isOrdered = false;
+        ptCloud.metadata.height = 1;
+        ptCloud.metadata.width = static_cast<asn1SccT_UInt32>(ptCloud.data.points.nCount);
+    }
+
     return true;
+}
+
+/**
+ * Reprojects the disparities of one row: d = raw * scale + offset, x = columnFactor / d, y = rowFactor / d, z = depthFactor / d, the coordinates are NaN if d is not positive and finite.
+ */
+void DisparityToPointCloud::reprojectRow(size_t count, double scale, double offset, double rowFactor, double depthFactor)
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    size_t k = 0;
+#if defined(__SSE2__)
+    const __m128d scaleVector = _mm_set1_pd(scale);
+    const __m128d offsetVector = _mm_set1_pd(offset);
+    const __m128d rowFactorVector = _mm_set1_pd(rowFactor);
+    const __m128d depthFactorVector = _mm_set1_pd(depthFactor);
+    const __m128d zeroVector = _mm_setzero_pd();
+    const __m128d infinityVector = _mm_set1_pd(std::numeric_limits<double>::infinity());
+    const __m128d nanVector = _mm_set1_pd(nan);
+    for (; k + 2 <= count; k += 2)
+    {
+        __m128d disparity = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(&_disparities[k]), scaleVector), offsetVector);
+        __m128d valid = _mm_and_pd(_mm_cmpgt_pd(disparity, zeroVector), _mm_cmplt_pd(disparity, infinityVector));
+        __m128d inverse = _mm_div_pd(_mm_set1_pd(1.0), disparity);
+        __m128d x = _mm_mul_pd(_mm_loadu_pd(&_columnFactors[k]), inverse);
+        __m128d y = _mm_mul_pd(rowFactorVector, inverse);
+        __m128d z = _mm_mul_pd(depthFactorVector, inverse);
+        _mm_storeu_pd(&_x[k], _mm_or_pd(_mm_and_pd(valid, x), _mm_andnot_pd(valid, nanVector)));
+        _mm_storeu_pd(&_y[k], _mm_or_pd(_mm_and_pd(valid, y), _mm_andnot_pd(valid, nanVector)));
+        _mm_storeu_pd(&_z[k], _mm_or_pd(_mm_and_pd(valid, z), _mm_andnot_pd(valid, nanVector)));
+    }
+#endif
+    for (; k < count; k++)
+    {
+        double disparity = _disparities[k] * scale + offset;
+        if (disparity > 0 && disparity < std::numeric_limits<double>::infinity())
+        {
+            double inverse = 1.0 / disparity;
+            _x[k] = _columnFactors[k] * inverse;
+            _y[k] = rowFactor * inverse;
+            _z[k] = depthFactor * inverse;
+        }
+        else
+        {
+            _x[k] = nan;
+            _y[k] = nan;
+            _z[k] = nan;
+        }
     }
 }
 
+void DisparityToPointCloud::ValidateParameters()
+{
+    ASSERT(parameters.stride >= 1, "DisparityToPointCloud: stride must be at least 1");
+}
+
+const DisparityToPointCloud::DisparityToPointCloudParams DisparityToPointCloud::DEFAULT_PARAMETERS = {
+    .organized = true,
+    .stride = 1
+};
+
+}
 }
 }
 
@@ -7,6 +7,9 @@
 #define DISPARITYTOPOINTCLOUD_DISPARITYTOPOINTCLOUD_HPP
 
 #include "DisparityToPointCloudInterface.hpp"
+#include "Helpers/ParametersListHelper.hpp"
+
+#include <vector>
 
 namespace CDFF
 {
@@ -15,7 +18,9 @@ namespace DFN
 namespace DisparityToPointCloud
 {
     /**
-     * TODO Class documentation
+     * @brief Reprojection of a disparity image into a pointcloud with the pinhole intrinsics of the image and the baseline stored in its pixel coefficients.
+     * The point of pixel (row, col) with disparity d is (col - cx) * b / d, (row - cy) * b * fx / (fy * d), b * fx / d, each row of the image is reprojected
+     * with vector instructions from per-column and per-row factors computed once per image. A pixel is invalid if its disparity is not positive and finite.
      */
     class DisparityToPointCloud : public DisparityToPointCloudInterface
     {
@@ -26,10 +31,36 @@ namespace DisparityToPointCloud
 
             virtual void configure();
             virtual void process();
-        
+
+            struct DisparityToPointCloudParams
+            {
+                /**
+                 * @brief Set to true to output an organized pointcloud with one point per sampled pixel and NaN coordinates for invalid pixels,
+                 * set to false to drop the invalid pixels and output an unorganized pointcloud.
+                 */
+                bool organized;
+
+                /**
+                 * @brief Only one row every stride rows and one column every stride columns is reprojected, 1 reprojects every pixel.
+                 */
+                int stride;
+            };
+
+            Helpers::ParametersListHelper parametersHelper;
+            DisparityToPointCloudParams parameters;
+            static const DisparityToPointCloudParams DEFAULT_PARAMETERS;
+            void ValidateParameters();
+
         private:
+            std::vector<double> _disparities;
+            std::vector<double> _columnFactors;
+            std::vector<double> _x;
+            std::vector<double> _y;
+            std::vector<double> _z;
+
             template<typename T>
             bool disp2ptcloud(asn1SccFrame &disp, asn1SccPointcloud &ptCloud);
+            void reprojectRow(size_t count, double scale, double offset, double rowFactor, double depthFactor);
     };
 }
 }
@@ -5,6 +5,7 @@
 
 #include "BundleAdjustmentExecutor.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 using namespace CorrespondenceMap2DWrapper;
 using namespace PoseWrapper;
@@ -30,6 +31,7 @@ void Execute(BundleAdjustmentInterface* dfn, CorrespondenceMaps2DSequenceConstPt
 
 void Execute(BundleAdjustmentInterface* dfn, const CorrespondenceMaps2DSequence& inputMatches, Poses3DSequenceConstPtr& outputTransforms, bool& success, float& error)
 	{
+	TRACE_SCOPE_CATEGORY("BundleAdjustment", "DFN");
 	ASSERT( dfn!= NULL, "BundleAdjustmentExecutor, input dfn is null");
 	ASSERT( outputTransforms == NULL, "BundleAdjustmentExecutor, Calling instance creation executor with a non-NULL pointer");
 	dfn->correspondenceMapsSequenceInput(inputMatches);
@@ -41,6 +43,7 @@ void Execute(BundleAdjustmentInterface* dfn, const CorrespondenceMaps2DSequence&
 
 void Execute(BundleAdjustmentInterface* dfn, const CorrespondenceMaps2DSequence& inputMatches, Poses3DSequence& outputTransforms, bool& success, float& error)
 	{
+	TRACE_SCOPE_CATEGORY("BundleAdjustment", "DFN");
 	ASSERT( dfn!= NULL, "BundleAdjustmentExecutor, input dfn is null");
 	dfn->correspondenceMapsSequenceInput(inputMatches);
 	dfn->process();
@@ -65,6 +68,7 @@ void Execute(BundleAdjustmentInterface* dfn, CorrespondenceMaps2DSequenceConstPt
 void Execute(BundleAdjustmentInterface* dfn, const CorrespondenceMaps2DSequence& inputMatches, const Poses3DSequence& poseGuess, const PointCloud& cloudGuess, 
 	Poses3DSequenceConstPtr& outputTransforms, bool& success, float& error)
 	{
+	TRACE_SCOPE_CATEGORY("BundleAdjustment", "DFN");
 	ASSERT( dfn!= NULL, "BundleAdjustmentExecutor, input dfn is null");
 	ASSERT( outputTransforms == NULL, "BundleAdjustmentExecutor, Calling instance creation executor with a non-NULL pointer");
 	dfn->correspondenceMapsSequenceInput(inputMatches);
@@ -79,6 +83,7 @@ void Execute(BundleAdjustmentInterface* dfn, const CorrespondenceMaps2DSequence&
 void Execute(BundleAdjustmentInterface* dfn, const CorrespondenceMaps2DSequence& inputMatches, const Poses3DSequence& poseGuess, const PointCloud& cloudGuess, 
 	Poses3DSequence& outputTransforms, bool& success, float& error)
 	{
+	TRACE_SCOPE_CATEGORY("BundleAdjustment", "DFN");
 	ASSERT( dfn!= NULL, "BundleAdjustmentExecutor, input dfn is null");
 	dfn->correspondenceMapsSequenceInput(inputMatches);
 	dfn->guessedPosesSequenceInput(poseGuess);
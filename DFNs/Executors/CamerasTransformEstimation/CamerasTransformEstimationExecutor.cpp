@@ -5,6 +5,7 @@
 
 #include "CamerasTransformEstimationExecutor.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 using namespace MatrixWrapper;
 using namespace CorrespondenceMap2DWrapper;
@@ -30,6 +31,7 @@ void Execute(CamerasTransformEstimationInterface* dfn, Matrix3dConstPtr inputMat
 
 void Execute(CamerasTransformEstimationInterface* dfn, const Matrix3d& inputMatrix, const CorrespondenceMap2D& inputMatches, Pose3DConstPtr& outputTransform, bool& success)
 	{
+	TRACE_SCOPE_CATEGORY("CamerasTransformEstimation", "DFN");
 	ASSERT( dfn!= NULL, "CamerasTransformEstimationExecutor, input dfn is null");
 	ASSERT( outputTransform == NULL, "CamerasTransformEstimationExecutor, Calling instance creation executor with a non-NULL pointer");
 	dfn->fundamentalMatrixInput(inputMatrix);
@@ -41,6 +43,7 @@ void Execute(CamerasTransformEstimationInterface* dfn, const Matrix3d& inputMatr
 
 void Execute(CamerasTransformEstimationInterface* dfn, const Matrix3d& inputMatrix, const CorrespondenceMap2D& inputMatches, Pose3D& outputTransform, bool& success)
 	{
+	TRACE_SCOPE_CATEGORY("CamerasTransformEstimation", "DFN");
 	ASSERT( dfn!= NULL, "CamerasTransformEstimationExecutor, input dfn is null");
 	dfn->fundamentalMatrixInput(inputMatrix);
 	dfn->matchesInput(inputMatches);
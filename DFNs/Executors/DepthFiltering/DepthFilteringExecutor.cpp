@@ -5,6 +5,7 @@
 
 #include "DepthFilteringExecutor.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 namespace CDFF
 {
@@ -29,6 +30,7 @@ void Execute(DepthFilteringInterface* dfn, FrameWrapper::FrameConstPtr inputFram
 //=====================================================================================================================
 void Execute(DepthFilteringInterface* dfn, const FrameWrapper::Frame& inputFrame, FrameWrapper::FrameConstPtr& outputFrame)
 {
+TRACE_SCOPE_CATEGORY("DepthFiltering", "DFN");
     ASSERT( dfn!= NULL, "DepthFilteringExecutor, input dfn is null");
     ASSERT( outputFrame == NULL, "DepthFilteringExecutor, Calling instance creation executor with a non-NULL pointer");
     dfn->frameInput(inputFrame);
@@ -39,6 +41,7 @@ void Execute(DepthFilteringInterface* dfn, const FrameWrapper::Frame& inputFrame
 //=====================================================================================================================
 void Execute(DepthFilteringInterface* dfn, const FrameWrapper::Frame& inputFrame, FrameWrapper::Frame& outputFrame)
 {
+TRACE_SCOPE_CATEGORY("DepthFiltering", "DFN");
     ASSERT( dfn!= NULL, "DepthFilteringExecutor, input dfn is null");
     dfn->frameInput(inputFrame);
     dfn->process();
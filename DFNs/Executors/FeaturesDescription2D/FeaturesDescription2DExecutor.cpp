@@ -5,6 +5,7 @@
 
 #include "FeaturesDescription2DExecutor.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 using namespace FrameWrapper;
 using namespace VisualPointFeatureVector2DWrapper;
@@ -29,6 +30,7 @@ void Execute(FeaturesDescription2DInterface* dfn, FrameConstPtr inputFrame, Visu
 
 void Execute(FeaturesDescription2DInterface* dfn, const Frame& inputFrame, const VisualPointFeatureVector2D& inputVector, VisualPointFeatureVector2DConstPtr& outputVector)
 	{
+	TRACE_SCOPE_CATEGORY("FeaturesDescription2D", "DFN");
 	ASSERT( outputVector == NULL, "FeaturesDescription2DExecutor, Calling instance creation executor with a non-NULL pointer");
 	if (dfn == NULL)
 		{
@@ -43,6 +45,7 @@ void Execute(FeaturesDescription2DInterface* dfn, const Frame& inputFrame, const
 
 void Execute(FeaturesDescription2DInterface* dfn, const Frame& inputFrame, const VisualPointFeatureVector2D& inputVector, VisualPointFeatureVector2D& outputVector)
 	{
+	TRACE_SCOPE_CATEGORY("FeaturesDescription2D", "DFN");
 	if (dfn == NULL)
 		{
 		Copy(inputVector, outputVector);
@@ -5,6 +5,7 @@
 
 #include "FeaturesDescription3DExecutor.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 using namespace PointCloudWrapper;
 using namespace VisualPointFeatureVector3DWrapper;
@@ -29,6 +30,7 @@ void Execute(FeaturesDescription3DInterface* dfn, PointCloudConstPtr inputCloud,
 
 void Execute(FeaturesDescription3DInterface* dfn, const PointCloud& inputCloud, const VisualPointFeatureVector3D& inputVector, VisualPointFeatureVector3DConstPtr& outputVector)
 	{
+	TRACE_SCOPE_CATEGORY("FeaturesDescription3D", "DFN");
 	ASSERT( outputVector == NULL, "FeaturesDescription3DExecutor, Calling instance creation executor with a non-NULL pointer");
 	if (dfn == NULL)
 		{
@@ -42,6 +44,7 @@ void Execute(FeaturesDescription3DInterface* dfn, const PointCloud& inputCloud,
 
 void Execute(FeaturesDescription3DInterface* dfn, const PointCloud& inputCloud, const VisualPointFeatureVector3D& inputVector, VisualPointFeatureVector3D& outputVector)
 	{
+	TRACE_SCOPE_CATEGORY("FeaturesDescription3D", "DFN");
 	if (dfn == NULL)
 		{
 		Copy(inputVector, outputVector);
@@ -68,6 +71,7 @@ void Execute(FeaturesDescription3DInterface* dfn, PointCloudConstPtr inputCloud,
 void Execute(FeaturesDescription3DInterface* dfn, const PointCloud& inputCloud, const VisualPointFeatureVector3D& inputVector, const PointCloud& normalCloud, 
 	VisualPointFeatureVector3DConstPtr& outputVector)
 	{
+	TRACE_SCOPE_CATEGORY("FeaturesDescription3D", "DFN");
 	ASSERT( outputVector == NULL, "FeaturesDescription3DExecutor, Calling instance creation executor with a non-NULL pointer");
 	if (dfn == NULL)
 		{
@@ -84,6 +88,7 @@ void Execute(FeaturesDescription3DInterface* dfn, const PointCloud& inputCloud,
 void Execute(FeaturesDescription3DInterface* dfn, const PointCloud& inputCloud, const VisualPointFeatureVector3D& inputVector, const PointCloud& normalCloud, 
 	VisualPointFeatureVector3D& outputVector)
 	{
+	TRACE_SCOPE_CATEGORY("FeaturesDescription3D", "DFN");
 	if (dfn == NULL)
 		{
 		Copy(inputVector, outputVector);
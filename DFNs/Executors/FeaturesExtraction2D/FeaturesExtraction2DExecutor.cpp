@@ -5,6 +5,7 @@
 
 #include "FeaturesExtraction2DExecutor.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 using namespace FrameWrapper;
 using namespace VisualPointFeatureVector2DWrapper;
@@ -29,6 +30,7 @@ void Execute(FeaturesExtraction2DInterface* dfn, FrameConstPtr inputFrame, Visua
 
 void Execute(FeaturesExtraction2DInterface* dfn, const Frame& inputFrame, VisualPointFeatureVector2DConstPtr& outputVector)
 	{
+	TRACE_SCOPE_CATEGORY("FeaturesExtraction2D", "DFN");
 	ASSERT( dfn!= NULL, "FeaturesExtraction2DExecutor, input dfn is null");
 	ASSERT( outputVector == NULL, "FeaturesExtraction2DExecutor, Calling instance creation executor with a non-NULL pointer");
 	dfn->frameInput(inputFrame);
@@ -38,6 +40,7 @@ void Execute(FeaturesExtraction2DInterface* dfn, const Frame& inputFrame, Visual
 
 void Execute(FeaturesExtraction2DInterface* dfn, const Frame& inputFrame, VisualPointFeatureVector2D& outputVector)
 	{
+	TRACE_SCOPE_CATEGORY("FeaturesExtraction2D", "DFN");
 	ASSERT( dfn!= NULL, "FeaturesExtraction2DExecutor, input dfn is null");
 	dfn->frameInput(inputFrame);
 	dfn->process();
@@ -5,6 +5,7 @@
 
 #include "FeaturesExtraction3DExecutor.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 using namespace PointCloudWrapper;
 using namespace VisualPointFeatureVector3DWrapper;
@@ -29,6 +30,7 @@ void Execute(FeaturesExtraction3DInterface* dfn, PointCloudConstPtr inputCloud,
 
 void Execute(FeaturesExtraction3DInterface* dfn, const PointCloud& inputCloud, VisualPointFeatureVector3DConstPtr& outputVector)
 	{
+	TRACE_SCOPE_CATEGORY("FeaturesExtraction3D", "DFN");
 	ASSERT( dfn!= NULL, "FeaturesExtraction3DExecutor, input dfn is null");
 	ASSERT( outputVector == NULL, "FeaturesExtraction3DExecutor, Calling instance creation executor with a non-NULL pointer");
 	dfn->pointcloudInput(inputCloud);
@@ -38,6 +40,7 @@ void Execute(FeaturesExtraction3DInterface* dfn, const PointCloud& inputCloud, V
 
 void Execute(FeaturesExtraction3DInterface* dfn, const PointCloud& inputCloud, VisualPointFeatureVector3D& outputVector)
 	{
+	TRACE_SCOPE_CATEGORY("FeaturesExtraction3D", "DFN");
 	ASSERT( dfn!= NULL, "FeaturesExtraction3DExecutor, input dfn is null");
 	dfn->pointcloudInput(inputCloud);
 	dfn->process();
@@ -5,6 +5,7 @@
 
 #include "FeaturesMatching2DExecutor.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 using namespace CorrespondenceMap2DWrapper;
 using namespace VisualPointFeatureVector2DWrapper;
@@ -32,6 +33,7 @@ void Execute(FeaturesMatching2DInterface* dfn, VisualPointFeatureVector2DConstPt
 void Execute(FeaturesMatching2DInterface* dfn, const VisualPointFeatureVector2D& inputSourceVector, 
 	const VisualPointFeatureVector2D& inputSinkVector, CorrespondenceMap2DConstPtr& outputMatches)
 	{
+	TRACE_SCOPE_CATEGORY("FeaturesMatching2D", "DFN");
 	ASSERT( dfn!= NULL, "FeaturesMatching2DExecutor, input dfn is null");
 	ASSERT( outputMatches == NULL, "FeaturesMatching2DExecutor, Calling instance creation executor with a non-NULL pointer");
 	dfn->sourceFeaturesInput(inputSourceVector);
@@ -43,6 +45,7 @@ void Execute(FeaturesMatching2DInterface* dfn, const VisualPointFeatureVector2D&
 void Execute(FeaturesMatching2DInterface* dfn, const VisualPointFeatureVector2D& inputSourceVector, 
 	const VisualPointFeatureVector2D& inputSinkVector, CorrespondenceMap2D& outputMatches)
 	{
+	TRACE_SCOPE_CATEGORY("FeaturesMatching2D", "DFN");
 	ASSERT( dfn!= NULL, "FeaturesMatching2DExecutor, input dfn is null");
 	dfn->sourceFeaturesInput(inputSourceVector);
 	dfn->sinkFeaturesInput(inputSinkVector);
@@ -5,6 +5,7 @@
 
 #include "FeaturesMatching3DExecutor.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 using namespace PoseWrapper;
 using namespace VisualPointFeatureVector3DWrapper;
@@ -32,6 +33,7 @@ void Execute(FeaturesMatching3DInterface* dfn, VisualPointFeatureVector3DConstPt
 void Execute(FeaturesMatching3DInterface* dfn, const VisualPointFeatureVector3D& inputSourceVector, 
 	const VisualPointFeatureVector3D& inputSinkVector, Pose3DConstPtr& outputTransform, bool& success)
 	{
+	TRACE_SCOPE_CATEGORY("FeaturesMatching3D", "DFN");
 	ASSERT( dfn!= NULL, "FeaturesMatching3DExecutor, input dfn is null");
 	ASSERT( outputTransform == NULL, "FeaturesMatching3DExecutor, Calling instance creation executor with a non-NULL pointer");
 	dfn->sourceFeaturesInput(inputSourceVector);
@@ -44,6 +46,7 @@ void Execute(FeaturesMatching3DInterface* dfn, const VisualPointFeatureVector3D&
 void Execute(FeaturesMatching3DInterface* dfn, const VisualPointFeatureVector3D& inputSourceVector, 
 	const VisualPointFeatureVector3D& inputSinkVector, Pose3D& outputTransform, bool& success)
 	{
+	TRACE_SCOPE_CATEGORY("FeaturesMatching3D", "DFN");
 	ASSERT( dfn!= NULL, "FeaturesMatching3DExecutor, input dfn is null");
 	dfn->sourceFeaturesInput(inputSourceVector);
 	dfn->sinkFeaturesInput(inputSinkVector);
@@ -5,6 +5,7 @@
 
 #include "ForceMeshGeneratorExecutor.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 namespace CDFF
 {
@@ -34,6 +35,7 @@ void Execute(
     PointCloudWrapper::PointCloud & outputPointCloud
     )
 {
+TRACE_SCOPE_CATEGORY("ForceMeshGenerator", "DFN");
     ASSERT( dfn!= NULL, "ForceMeshGeneratorExecutor, input dfn is null");
     dfn->armBasePoseInput(armBasePose);
     dfn->armEndEffectorPoseInput(armEndEffectorPose);
@@ -5,6 +5,7 @@
 
 #include "FundamentalMatrixComputationExecutor.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 using namespace CorrespondenceMap2DWrapper;
 using namespace MatrixWrapper;
@@ -29,6 +30,7 @@ void Execute(FundamentalMatrixComputationInterface* dfn, CorrespondenceMap2DCons
 
 void Execute(FundamentalMatrixComputationInterface* dfn, const CorrespondenceMap2D& inputMatches, MatrixWrapper::Matrix3dConstPtr& outputMatrix, bool& success)
 	{
+	TRACE_SCOPE_CATEGORY("FundamentalMatrixComputation", "DFN");
 	ASSERT( dfn!= NULL, "FundamentalMatrixComputationExecutor, input dfn is null");
 	ASSERT( outputMatrix == NULL, "FundamentalMatrixComputationExecutor, Calling instance creation executor with a non-NULL pointer");
 	dfn->matchesInput(inputMatches);
@@ -39,6 +41,7 @@ void Execute(FundamentalMatrixComputationInterface* dfn, const CorrespondenceMap
 
 void Execute(FundamentalMatrixComputationInterface* dfn, const CorrespondenceMap2D& inputMatches, MatrixWrapper::Matrix3d& outputMatrix, bool& success)
 	{
+	TRACE_SCOPE_CATEGORY("FundamentalMatrixComputation", "DFN");
 	ASSERT( dfn!= NULL, "FundamentalMatrixComputationExecutor, input dfn is null");
 	dfn->matchesInput(inputMatches);
 	dfn->process();
@@ -62,6 +65,7 @@ void Execute(FundamentalMatrixComputationInterface* dfn, CorrespondenceMap2DCons
 void Execute(FundamentalMatrixComputationInterface* dfn, const CorrespondenceMap2D& inputMatches, MatrixWrapper::Matrix3dConstPtr& outputMatrix, bool& success, 
 	CorrespondenceMap2DConstPtr& outputInlierMatches)
 	{
+	TRACE_SCOPE_CATEGORY("FundamentalMatrixComputation", "DFN");
 	ASSERT( dfn!= NULL, "FundamentalMatrixComputationExecutor, input dfn is null");
 	ASSERT( outputMatrix == NULL && outputInlierMatches == NULL, "FundamentalMatrixComputationExecutor, Calling instance creation executor with a non-NULL pointer");
 	dfn->matchesInput(inputMatches);
@@ -74,6 +78,7 @@ void Execute(FundamentalMatrixComputationInterface* dfn, const CorrespondenceMap
 void Execute(FundamentalMatrixComputationInterface* dfn, const CorrespondenceMap2D& inputMatches, MatrixWrapper::Matrix3d& outputMatrix, bool& success, 
 	CorrespondenceMap2D& outputInlierMatches)
 	{
+	TRACE_SCOPE_CATEGORY("FundamentalMatrixComputation", "DFN");
 	ASSERT( dfn!= NULL, "FundamentalMatrixComputationExecutor, input dfn is null");
 	dfn->matchesInput(inputMatches);
 	dfn->process();
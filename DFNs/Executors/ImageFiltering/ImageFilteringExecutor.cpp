@@ -5,6 +5,7 @@
 
 #include "ImageFilteringExecutor.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 using namespace FrameWrapper;
 
@@ -28,6 +29,7 @@ void Execute(ImageFilteringInterface* dfn, FrameConstPtr inputFrame, FramePtr ou
 
 void Execute(ImageFilteringInterface* dfn, const Frame& inputFrame, FrameConstPtr& outputFrame)
 	{
+	TRACE_SCOPE_CATEGORY("ImageFiltering", "DFN");
 	ASSERT( outputFrame == NULL, "ImageFilteringExecutor, Calling instance creation executor with a non-NULL pointer");
 	if (dfn == NULL)
 		{
@@ -41,6 +43,7 @@ void Execute(ImageFilteringInterface* dfn, const Frame& inputFrame, FrameConstPt
 
 void Execute(ImageFilteringInterface* dfn, const Frame& inputFrame, Frame& outputFrame)
 	{
+	TRACE_SCOPE_CATEGORY("ImageFiltering", "DFN");
 	if (dfn == NULL)
 		{
 		Copy(inputFrame, outputFrame);
@@ -5,6 +5,7 @@
 
 #include "PerspectiveNPointSolvingExecutor.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 using namespace VisualPointFeatureVector2DWrapper;
 using namespace PoseWrapper;
@@ -32,6 +33,7 @@ void Execute(PerspectiveNPointSolvingInterface* dfn, PointCloudConstPtr inputClo
 void Execute(PerspectiveNPointSolvingInterface* dfn, const PointCloud& inputCloud, const VisualPointFeatureVector2D& inputKeypoints, 
 	PoseWrapper::Pose3DConstPtr& outputPose, bool& success)
 	{
+	TRACE_SCOPE_CATEGORY("PerspectiveNPointSolving", "DFN");
 	ASSERT( dfn!= NULL, "PerspectiveNPointSolvingExecutor, input dfn is null");
 	ASSERT( outputPose == NULL, "PerspectiveNPointSolvingExecutor, Calling instance creation executor with a non-NULL pointer");
 	dfn->pointsInput(inputCloud);
@@ -43,6 +45,7 @@ void Execute(PerspectiveNPointSolvingInterface* dfn, const PointCloud& inputClou
 
 void Execute(PerspectiveNPointSolvingInterface* dfn, const PointCloud& inputCloud, const VisualPointFeatureVector2D& inputKeypoints, PoseWrapper::Pose3D& outputPose, bool& success)
 	{
+	TRACE_SCOPE_CATEGORY("PerspectiveNPointSolving", "DFN");
 	ASSERT( dfn!= NULL, "PerspectiveNPointSolvingExecutor, input dfn is null");
 	dfn->pointsInput(inputCloud);
 	dfn->projectionsInput(inputKeypoints);
@@ -5,6 +5,7 @@
 
 #include "PointCloudAssemblyExecutor.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 using namespace PointCloudWrapper;
 using namespace PoseWrapper;
@@ -29,6 +30,7 @@ void Execute(PointCloudAssemblyInterface* dfn, PointCloudConstPtr inputFirstClou
 
 void Execute(PointCloudAssemblyInterface* dfn, const PointCloud& inputFirstCloud, const PointCloud& inputSecondCloud, PointCloudConstPtr& outputAssembledCloud)
 	{
+	TRACE_SCOPE_CATEGORY("PointCloudAssembly", "DFN");
 	ASSERT( dfn!= NULL, "PointCloudAssemblyExecutor, input dfn is null");
 	ASSERT( outputAssembledCloud == NULL, "PointCloudAssemblyExecutor, Calling instance creation executor with a non-NULL pointer");
 	dfn->firstPointCloudInput(inputFirstCloud);
@@ -39,6 +41,7 @@ void Execute(PointCloudAssemblyInterface* dfn, const PointCloud& inputFirstCloud
 
 void Execute(PointCloudAssemblyInterface* dfn, const PointCloud& inputFirstCloud, const PointCloud& inputSecondCloud, PointCloud& outputAssembledCloud)
 	{
+	TRACE_SCOPE_CATEGORY("PointCloudAssembly", "DFN");
 	ASSERT( dfn!= NULL, "PointCloudAssemblyExecutor, input dfn is null");
 	dfn->firstPointCloudInput(inputFirstCloud);
 	dfn->secondPointCloudInput(inputSecondCloud);
@@ -59,6 +62,7 @@ void Execute(PointCloudAssemblyInterface* dfn, PointCloudConstPtr cloud, Pose3DC
 
 void Execute(PointCloudAssemblyInterface* dfn, const PointCloud& cloud, const Pose3D& viewCenter, float viewRadius, PointCloudConstPtr& outputAssembledCloud)
 	{
+	TRACE_SCOPE_CATEGORY("PointCloudAssembly", "DFN");
 	ASSERT( dfn!= NULL, "PointCloudAssemblyExecutor, input dfn is null");
 	ASSERT( outputAssembledCloud == NULL, "PointCloudAssemblyExecutor, Calling instance creation executor with a non-NULL pointer");
 	dfn->firstPointCloudInput(cloud);
@@ -70,6 +74,7 @@ void Execute(PointCloudAssemblyInterface* dfn, const PointCloud& cloud, const Po
 
 void Execute(PointCloudAssemblyInterface* dfn, const PointCloud& cloud, const Pose3D& viewCenter, float viewRadius, PointCloud& outputAssembledCloud)
 	{
+	TRACE_SCOPE_CATEGORY("PointCloudAssembly", "DFN");
 	ASSERT( dfn!= NULL, "PointCloudAssemblyExecutor, input dfn is null");
 	dfn->firstPointCloudInput(cloud);
 	dfn->viewCenterInput(viewCenter);
@@ -5,6 +5,7 @@
 
 #include "PointCloudFilteringExecutor.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 using namespace PointCloudWrapper;
 using namespace PoseWrapper;
@@ -29,6 +30,7 @@ void Execute(PointCloudFilteringInterface* dfn, PointCloudConstPtr inputCloud, P
 
 void Execute(PointCloudFilteringInterface* dfn, const PointCloud& inputCloud, PointCloudConstPtr& outputCloud)
 	{
+	TRACE_SCOPE_CATEGORY("PointCloudFiltering", "DFN");
 	ASSERT( outputCloud == NULL, "PointCloudFilteringExecutor, Calling instance creation executor with a non-NULL pointer");
 	if (dfn == NULL)
 		{
@@ -42,6 +44,7 @@ void Execute(PointCloudFilteringInterface* dfn, const PointCloud& inputCloud, Po
 
 void Execute(PointCloudFilteringInterface* dfn, const PointCloud& inputCloud, PointCloud& outputCloud)
 	{
+	TRACE_SCOPE_CATEGORY("PointCloudFiltering", "DFN");
 	if (dfn == NULL)
 		{
 		Copy(inputCloud, outputCloud);
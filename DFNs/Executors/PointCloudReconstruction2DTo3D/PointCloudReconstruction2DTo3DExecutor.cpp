@@ -5,6 +5,7 @@
 
 #include "PointCloudReconstruction2DTo3DExecutor.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 using namespace CorrespondenceMap2DWrapper;
 using namespace PoseWrapper;
@@ -30,6 +31,7 @@ void Execute(PointCloudReconstruction2DTo3DInterface* dfn, CorrespondenceMap2DCo
 
 void Execute(PointCloudReconstruction2DTo3DInterface* dfn, const CorrespondenceMap2D& inputMatches, const Pose3D& inputPose, PointCloudConstPtr& outputCloud)
 	{
+	TRACE_SCOPE_CATEGORY("PointCloudReconstruction2DTo3D", "DFN");
 	ASSERT( dfn!= NULL, "PointCloudReconstruction2DTo3DExecutor, input dfn is null");
 	ASSERT( outputCloud == NULL, "PointCloudReconstruction2DTo3DExecutor, Calling instance creation executor with a non-NULL pointer");
 	dfn->matchesInput(inputMatches);
@@ -40,6 +42,7 @@ void Execute(PointCloudReconstruction2DTo3DInterface* dfn, const CorrespondenceM
 
 void Execute(PointCloudReconstruction2DTo3DInterface* dfn, const CorrespondenceMap2D& inputMatches, const Pose3D& inputPose, PointCloud& outputCloud)
 	{
+	TRACE_SCOPE_CATEGORY("PointCloudReconstruction2DTo3D", "DFN");
 	ASSERT( dfn!= NULL, "PointCloudReconstruction2DTo3DExecutor, input dfn is null");
 	dfn->matchesInput(inputMatches);
 	dfn->poseInput(inputPose);
@@ -5,6 +5,7 @@
 
 #include "PointCloudTransformationExecutor.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 using namespace PointCloudWrapper;
 using namespace PoseWrapper;
@@ -29,6 +30,7 @@ void Execute(PointCloudTransformationInterface* dfn, PointCloudConstPtr inputClo
 
 void Execute(PointCloudTransformationInterface* dfn, const PointCloud& inputCloud, const Pose3D& inputPose, PointCloudConstPtr& outputCloud)
 	{
+	TRACE_SCOPE_CATEGORY("PointCloudTransformation", "DFN");
 	ASSERT( dfn!= NULL, "PointCloudTransformationExecutor, input dfn is null");
 	ASSERT( outputCloud == NULL, "PointCloudTransformationExecutor, Calling instance creation executor with a non-NULL pointer");
 	dfn->pointCloudInput(inputCloud);
@@ -39,6 +41,7 @@ void Execute(PointCloudTransformationInterface* dfn, const PointCloud& inputClou
 
 void Execute(PointCloudTransformationInterface* dfn, const PointCloud& inputCloud, const Pose3D& inputPose, PointCloud& outputCloud)
 	{
+	TRACE_SCOPE_CATEGORY("PointCloudTransformation", "DFN");
 	ASSERT( dfn!= NULL, "PointCloudTransformationExecutor, input dfn is null");
 	dfn->poseInput(inputPose);
 	dfn->process();
@@ -5,6 +5,7 @@
 
 #include "PrimitiveMatchingExecutor.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 using namespace FrameWrapper;
 using namespace BaseTypesWrapper;
@@ -25,6 +26,7 @@ void Execute(PrimitiveMatchingInterface* dfn, FrameConstPtr inputFrame, const as
 //=====================================================================================================================
 void Execute(PrimitiveMatchingInterface* dfn, const Frame& inputFrame, const asn1SccStringSequence& inputPrimitiveSequence, asn1SccStringSequence& outputPrimitiveSequence)
 {
+	TRACE_SCOPE_CATEGORY("PrimitiveMatching", "DFN");
 	ASSERT( dfn!= NULL, "PrimitiveMatchingExecutor, input dfn is null");
 	dfn->imageInput(inputFrame);
 	dfn->primitivesInput(inputPrimitiveSequence);
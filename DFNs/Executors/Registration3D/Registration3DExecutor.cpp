@@ -5,6 +5,7 @@
 
 #include "Registration3DExecutor.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 using namespace PointCloudWrapper;
 using namespace PoseWrapper;
@@ -29,6 +30,7 @@ void Execute(Registration3DInterface* dfn, PointCloudConstPtr inputSourceCloud,
 
 void Execute(Registration3DInterface* dfn, const PointCloud& inputSourceCloud, const PointCloud& inputSinkCloud, Pose3DConstPtr& outputTransform, bool& success)
 	{
+	TRACE_SCOPE_CATEGORY("Registration3D", "DFN");
 	ASSERT( dfn!= NULL, "Registration3DExecutor, input dfn is null");
 	ASSERT( outputTransform == NULL, "Registration3DExecutor, Calling instance creation executor with a non-NULL pointer");
 	dfn->sourceCloudInput(inputSourceCloud);
@@ -42,6 +44,7 @@ void Execute(Registration3DInterface* dfn, const PointCloud& inputSourceCloud, c
 
 void Execute(Registration3DInterface* dfn, const PointCloud& inputSourceCloud, const PointCloud& inputSinkCloud, Pose3D& outputTransform, bool& success)
 	{
+	TRACE_SCOPE_CATEGORY("Registration3D", "DFN");
 	ASSERT( dfn!= NULL, "Registration3DExecutor, input dfn is null");
 	dfn->sourceCloudInput(inputSourceCloud);
 	dfn->sinkCloudInput(inputSinkCloud);
@@ -66,6 +69,7 @@ void Execute(Registration3DInterface* dfn, PointCloudConstPtr inputSourceCloud,
 
 void Execute(Registration3DInterface* dfn, const PointCloud& inputSourceCloud, const PointCloud& inputSinkCloud, const Pose3D& poseGuess, Pose3DConstPtr& outputTransform, bool& success)
 	{
+	TRACE_SCOPE_CATEGORY("Registration3D", "DFN");
 	ASSERT( dfn!= NULL, "Registration3DExecutor, input dfn is null");
 	ASSERT( outputTransform == NULL, "Registration3DExecutor, Calling instance creation executor with a non-NULL pointer");
 	dfn->sourceCloudInput(inputSourceCloud);
@@ -80,6 +84,7 @@ void Execute(Registration3DInterface* dfn, const PointCloud& inputSourceCloud, c
 
 void Execute(Registration3DInterface* dfn, const PointCloud& inputSourceCloud, const PointCloud& inputSinkCloud, const Pose3D& poseGuess, Pose3D& outputTransform, bool& success)
 	{
+	TRACE_SCOPE_CATEGORY("Registration3D", "DFN");
 	ASSERT( dfn!= NULL, "Registration3DExecutor, input dfn is null");
 	dfn->sourceCloudInput(inputSourceCloud);
 	dfn->sinkCloudInput(inputSinkCloud);
@@ -91,6 +96,23 @@ void Execute(Registration3DInterface* dfn, const PointCloud& inputSourceCloud, c
 	success = dfn->successOutput();
 	}
 
+void Execute(Registration3DInterface* dfn, const PointCloud& inputSourceCloud, Registration3D::IncrementalTargetCloud* sinkTarget, const Pose3D& poseGuess, Pose3D& outputTransform, bool& success)
+	{
+	TRACE_SCOPE_CATEGORY("Registration3D", "DFN");
+	ASSERT( dfn!= NULL, "Registration3DExecutor, input dfn is null");
+	ASSERT( sinkTarget != NULL, "Registration3DExecutor, input sink target is null");
+	bool targetSupported = dfn->setSinkTarget(sinkTarget);
+	ASSERT( targetSupported, "Registration3DExecutor, the dfn does not support an incremental sink target");
+	dfn->sourceCloudInput(inputSourceCloud);
+	bool guessInput = true;
+	dfn->useGuessInput(guessInput);
+	dfn->transformGuessInput(poseGuess);
+	dfn->process();
+	dfn->setSinkTarget(NULL);
+	Copy( dfn->transformOutput(), outputTransform);
+	success = dfn->successOutput();
+	}
+
 }
 }
 }
@@ -38,6 +38,13 @@ namespace Executors
 * Methods (i) and (iii) are non-creation methods, they give constant pointers as output, the output is just the output reference in the DFN;
 * When using creation methods, the output has to be initialized to NULL.
 * Methods (ii) and (iv) are creation methods, they copy the output of the DFN in the referenced output variable. Method (ii) takes a pointer, method (iv) takes a reference.
+*
+* The last method replaces the sink cloud by an incremental sink target maintained by the caller, see Registration3DInterface::setSinkTarget, it takes the following parameters:
+* @param inputSourceCloud: input source cloud;
+* @param sinkTarget: the sink, in the coordinate frame of the output transform; the DFN implementation has to support it;
+* @param poseGuess: initial estimation of the pose of the source cloud in the reference of the sink;
+* @param outputTransform: pose of the source cloud in the reference of the sink, it is copied into the referenced output variable;
+* @param success: boolean telling whether the computation was successfull.
 */
 void Execute(Registration3DInterface* dfn, PointCloudWrapper::PointCloudConstPtr inputSourceCloud, PointCloudWrapper::PointCloudConstPtr inputSinkCloud, 
 	PoseWrapper::Pose3DConstPtr& outputTransform, bool& success);
@@ -63,6 +70,9 @@ void Execute(Registration3DInterface* dfn, const PointCloudWrapper::PointCloud&
 void Execute(Registration3DInterface* dfn, const PointCloudWrapper::PointCloud& inputSourceCloud, const PointCloudWrapper::PointCloud& inputSinkCloud, 
 	const PoseWrapper::Pose3D& poseGuess, PoseWrapper::Pose3D& outputTransform, bool& success);
 
+void Execute(Registration3DInterface* dfn, const PointCloudWrapper::PointCloud& inputSourceCloud, Registration3D::IncrementalTargetCloud* sinkTarget,
+	const PoseWrapper::Pose3D& poseGuess, PoseWrapper::Pose3D& outputTransform, bool& success);
+
 }
 }
 }
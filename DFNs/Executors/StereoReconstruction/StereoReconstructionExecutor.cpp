@@ -5,6 +5,7 @@
 
 #include "StereoReconstructionExecutor.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 using namespace FrameWrapper;
 using namespace PointCloudWrapper;
@@ -29,6 +30,7 @@ void Execute(StereoReconstructionInterface* dfn, FrameConstPtr leftInputFrame, F
 
 void Execute(StereoReconstructionInterface* dfn, const Frame& leftInputFrame, const Frame& rightInputFrame, PointCloudConstPtr& outputCloud)
 	{
+	TRACE_SCOPE_CATEGORY("StereoReconstruction", "DFN");
 	ASSERT( dfn!= NULL, "StereoReconstructionExecutor, input dfn is null");
 	ASSERT( outputCloud == NULL, "StereoReconstructionExecutor, Calling instance creation executor with a non-NULL pointer");
 	dfn->leftInput(leftInputFrame);
@@ -39,6 +41,7 @@ void Execute(StereoReconstructionInterface* dfn, const Frame& leftInputFrame, co
 
 void Execute(StereoReconstructionInterface* dfn, const Frame& leftInputFrame, const Frame& rightInputFrame, PointCloud& outputCloud)
 	{
+	TRACE_SCOPE_CATEGORY("StereoReconstruction", "DFN");
 	ASSERT( dfn!= NULL, "StereoReconstructionExecutor, input dfn is null");
 	dfn->leftInput(leftInputFrame);
 	dfn->rightInput(rightInputFrame);
@@ -5,6 +5,7 @@
 
 #include "Transform3DEstimationExecutor.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 using namespace CorrespondenceMap3DWrapper;
 using namespace PoseWrapper;
@@ -29,6 +30,7 @@ void Execute(Transform3DEstimationInterface* dfn, CorrespondenceMaps3DSequenceCo
 
 void Execute(Transform3DEstimationInterface* dfn, const CorrespondenceMaps3DSequence& inputMatches, Poses3DSequenceConstPtr& outputTransforms, bool& success, float& error)
 	{
+	TRACE_SCOPE_CATEGORY("Transform3DEstimation", "DFN");
 	ASSERT( dfn!= NULL, "Transform3DEstimationExecutor, input dfn is null");
 	ASSERT( outputTransforms == NULL, "Transform3DEstimationExecutor, Calling instance creation executor with a non-NULL pointer");
 	dfn->matchesInput(inputMatches);
@@ -40,6 +42,7 @@ void Execute(Transform3DEstimationInterface* dfn, const CorrespondenceMaps3DSequ
 
 void Execute(Transform3DEstimationInterface* dfn, const CorrespondenceMaps3DSequence& inputMatches, Poses3DSequence& outputTransforms, bool& success, float& error)
 	{
+	TRACE_SCOPE_CATEGORY("Transform3DEstimation", "DFN");
 	ASSERT( dfn!= NULL, "Transform3DEstimationExecutor, input dfn is null");
 	dfn->matchesInput(inputMatches);
 	dfn->process();
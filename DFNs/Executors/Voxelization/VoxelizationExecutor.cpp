@@ -5,6 +5,7 @@
 
 #include "VoxelizationExecutor.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 
 namespace CDFF
 {
@@ -29,6 +30,7 @@ void Execute(VoxelizationInterface* dfn, FrameWrapper::FrameConstPtr inputFrame,
 //=====================================================================================================================
 void Execute(VoxelizationInterface* dfn, const FrameWrapper::Frame& inputFrame, OctreeConstPtr& outputOctree)
 {
+TRACE_SCOPE_CATEGORY("Voxelization", "DFN");
     ASSERT( dfn!= NULL, "VoxelizationExecutor, input dfn is null");
     ASSERT( outputOctree == NULL, "VoxelizationExecutor, Calling instance creation executor with a non-NULL pointer");
     dfn->depthInput(inputFrame);
@@ -39,6 +41,7 @@ void Execute(VoxelizationInterface* dfn, const FrameWrapper::Frame& inputFrame,
 //=====================================================================================================================
 void Execute(VoxelizationInterface* dfn, const FrameWrapper::Frame& inputFrame, asn1SccOctree& outputOctree)
 {
+TRACE_SCOPE_CATEGORY("Voxelization", "DFN");
     ASSERT( dfn!= NULL, "VoxelizationExecutor, input dfn is null");
     dfn->depthInput(inputFrame);
     dfn->process();
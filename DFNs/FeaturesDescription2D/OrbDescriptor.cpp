@@ -9,7 +9,6 @@
 
 #include "OrbDescriptor.hpp"
 #include <Converters/FrameToMatConverter.hpp>
-#include <Converters/MatToVisualPointFeatureVector2DConverter.hpp>
 #include <Errors/Assert.hpp>
 #include <stdlib.h>
 #include <fstream>
@@ -42,6 +41,7 @@ OrbDescriptor::OrbDescriptor()
 	parametersHelper.AddParameter<int>("GeneralParameters", "SizeOfBrightnessTestSet", parameters.sizeOfBrightnessTestSet, DEFAULT_PARAMETERS.sizeOfBrightnessTestSet);
 
 	configurationFilePath = "";
+	CreateOrb();
 }
 
 OrbDescriptor::~OrbDescriptor()
@@ -52,6 +52,7 @@ void OrbDescriptor::configure()
 {
 	parametersHelper.ReadFile(configurationFilePath);
 	ValidateParameters();
+	CreateOrb();
 }
 
 void OrbDescriptor::process()
@@ -62,12 +63,11 @@ void OrbDescriptor::process()
 
 	// Process data
 	ValidateInputs(inputImage, keypointsVector);
-	cv::Mat orbFeatures = ComputeOrbFeatures(inputImage, keypointsVector);
+	cv::Mat descriptorsMatrix;
+	ComputeOrbFeatures(inputImage, keypointsVector, descriptorsMatrix);
 
 	// Write data to output port
-	VisualPointFeatureVector2DConstPtr tmp = matToVisualPointFeatureVector2D.Convert(orbFeatures);
-	Copy(*tmp, outFeatures);
-	delete(tmp);
+	WriteOutputFeatures(keypointsVector, descriptorsMatrix);
 }
 
 const OrbDescriptor::OrbOptionsSet OrbDescriptor::DEFAULT_PARAMETERS =
@@ -124,40 +124,38 @@ std::vector<cv::KeyPoint> OrbDescriptor::Convert(const VisualPointFeatureVector2
 	return keypointsVector;
 }
 
-cv::Mat OrbDescriptor::ComputeOrbFeatures(cv::Mat inputImage, std::vector<cv::KeyPoint> keypointsVector)
+void OrbDescriptor::CreateOrb()
 {
-	cv::Ptr<cv::ORB> orb = cv::ORB::create();
-	orb->setEdgeThreshold(parameters.edgeThreshold);
-	orb->setFastThreshold(parameters.fastThreshold);
-	orb->setFirstLevel(parameters.firstLevel);
-	orb->setMaxFeatures(parameters.maxFeaturesNumber);
-	orb->setNLevels(parameters.levelsNumber);
-	orb->setPatchSize(parameters.patchSize);
-	orb->setScaleFactor(parameters.scaleFactor);
-	orb->setScoreType(parameters.scoreType);
-	orb->setWTA_K(parameters.sizeOfBrightnessTestSet);
+	orb = cv::ORB::create(
+		parameters.maxFeaturesNumber,
+		parameters.scaleFactor,
+		parameters.levelsNumber,
+		parameters.edgeThreshold,
+		parameters.firstLevel,
+		parameters.sizeOfBrightnessTestSet,
+		parameters.scoreType,
+		parameters.patchSize,
+		parameters.fastThreshold
+		);
+}
 
-	cv::Mat descriptorsMatrix;
+void OrbDescriptor::ComputeOrbFeatures(cv::Mat inputImage, std::vector<cv::KeyPoint>& keypointsVector, cv::Mat& descriptorsMatrix)
+{
 	cv::Mat mask = cv::Mat();
 	orb->detectAndCompute(inputImage, mask, keypointsVector, descriptorsMatrix, true);
 	ASSERT(keypointsVector.size() == descriptorsMatrix.rows, "Orb Error: keypoints vector size does not match descriptorMatrix rows number");
+}
 
-	if (keypointsVector.size() == 0)
-	{
-		return cv::Mat();
-	}
-
-	cv::Mat orbFeaturesMatrix(keypointsVector.size(), descriptorsMatrix.cols + 2, CV_32FC1);
-	cv::Mat descriptorsSubmatrix = orbFeaturesMatrix( cv::Rect(2, 0, orbFeaturesMatrix.cols-2, orbFeaturesMatrix.rows) );
-	descriptorsMatrix.convertTo(descriptorsSubmatrix, CV_32FC1);
+void OrbDescriptor::WriteOutputFeatures(const std::vector<cv::KeyPoint>& keypointsVector, cv::Mat descriptorsMatrix)
+{
+	ClearPoints(outFeatures);
+	SetDescriptorType(outFeatures, BINARY_DESCRIPTORS);
 
 	for (unsigned pointIndex = 0; pointIndex < keypointsVector.size(); pointIndex++)
 	{
-		orbFeaturesMatrix.at<float>(pointIndex, 0) = keypointsVector.at(pointIndex).pt.x;
-		orbFeaturesMatrix.at<float>(pointIndex, 1) = keypointsVector.at(pointIndex).pt.y;
+		AddPoint(outFeatures, keypointsVector.at(pointIndex).pt.x, keypointsVector.at(pointIndex).pt.y);
+		SetBinaryDescriptor(outFeatures, pointIndex, descriptorsMatrix.ptr<uint8_t>(pointIndex), descriptorsMatrix.cols);
 	}
-
-	return orbFeaturesMatrix;
 }
 
 void OrbDescriptor::ValidateParameters()
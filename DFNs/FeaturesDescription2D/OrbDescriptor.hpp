@@ -14,7 +14,6 @@
 #include <Types/CPP/Frame.hpp>
 #include <Types/CPP/VisualPointFeatureVector2D.hpp>
 #include <Converters/FrameToMatConverter.hpp>
-#include <Converters/MatToVisualPointFeatureVector2DConverter.hpp>
 #include <Helpers/ParametersListHelper.hpp>
 #include <opencv2/core/core.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
@@ -29,7 +28,7 @@ namespace FeaturesDescription2D
 {
 	/**
 	 * Computation of descriptors for input 2D keypoints using ORB (rotated
-	 * BRIEF descriptor).
+	 * BRIEF descriptor). Descriptors are returned as packed binary descriptors.
 	 *
 	 * @param generalParameters.edgeThreshold
 	 * @param generalParameters.fastThreshold
@@ -72,16 +71,20 @@ namespace FeaturesDescription2D
 			OrbOptionsSet parameters;
 			static const OrbOptionsSet DEFAULT_PARAMETERS;
 
+			//The extractor is created at configuration and kept across frames
+			cv::Ptr<cv::ORB> orb;
+
 			//External conversion helpers			
 			Converters::FrameToMatConverter frameToMat;
-			Converters::MatToVisualPointFeatureVector2DConverter matToVisualPointFeatureVector2D;
 
 			//Type conversion methods
 			static int ConvertToScoreType(const std::string& scoreType);
 			std::vector<cv::KeyPoint> Convert(const VisualPointFeatureVector2DWrapper::VisualPointFeatureVector2D& featuresVector);
 
 			//Core computation methods
-			cv::Mat ComputeOrbFeatures(cv::Mat inputImage, std::vector<cv::KeyPoint> keypointsVector);
+			void CreateOrb();
+			void ComputeOrbFeatures(cv::Mat inputImage, std::vector<cv::KeyPoint>& keypointsVector, cv::Mat& descriptorsMatrix);
+			void WriteOutputFeatures(const std::vector<cv::KeyPoint>& keypointsVector, cv::Mat descriptorsMatrix);
 
 			//Input Validation methods
 			void ValidateParameters();
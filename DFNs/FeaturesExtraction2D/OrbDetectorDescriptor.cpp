@@ -9,10 +9,11 @@
 
 #include "OrbDetectorDescriptor.hpp"
 #include <Converters/FrameToMatConverter.hpp>
-#include <Converters/MatToVisualPointFeatureVector2DConverter.hpp>
 #include <Errors/Assert.hpp>
 #include <stdlib.h>
 #include <fstream>
+#include <algorithm>
+#include <cmath>
 
 using namespace Converters;
 using namespace VisualPointFeatureVector2DWrapper;
@@ -29,19 +30,24 @@ OrbDetectorDescriptor::OrbDetectorDescriptor()
 {
 	parameters = DEFAULT_PARAMETERS;
 
-	parametersHelper.AddParameter<int>("GeneralParameters", "EdgeThreshold", parameters.edgeThreshold, DEFAULT_PARAMETERS.edgeThreshold);
-	parametersHelper.AddParameter<int>("GeneralParameters", "FastThreshold", parameters.fastThreshold, DEFAULT_PARAMETERS.fastThreshold);
-	parametersHelper.AddParameter<int>("GeneralParameters", "FirstLevel", parameters.firstLevel, DEFAULT_PARAMETERS.firstLevel);
-	parametersHelper.AddParameter<int>("GeneralParameters", "MaxFeaturesNumber", parameters.maxFeaturesNumber, DEFAULT_PARAMETERS.maxFeaturesNumber);
+	parametersHelper.AddParameter<int>("GeneralParameters", "EdgeThreshold", parameters.generalParameters.edgeThreshold, DEFAULT_PARAMETERS.generalParameters.edgeThreshold);
+	parametersHelper.AddParameter<int>("GeneralParameters", "FastThreshold", parameters.generalParameters.fastThreshold, DEFAULT_PARAMETERS.generalParameters.fastThreshold);
+	parametersHelper.AddParameter<int>("GeneralParameters", "FirstLevel", parameters.generalParameters.firstLevel, DEFAULT_PARAMETERS.generalParameters.firstLevel);
+	parametersHelper.AddParameter<int>("GeneralParameters", "MaxFeaturesNumber", parameters.generalParameters.maxFeaturesNumber, DEFAULT_PARAMETERS.generalParameters.maxFeaturesNumber);
 
-	parametersHelper.AddParameter<int>("GeneralParameters", "LevelsNumber", parameters.levelsNumber, DEFAULT_PARAMETERS.levelsNumber);
-	parametersHelper.AddParameter<int>("GeneralParameters", "PatchSize", parameters.patchSize, DEFAULT_PARAMETERS.patchSize);
-	parametersHelper.AddParameter<double>("GeneralParameters", "ScaleFactor", parameters.scaleFactor, DEFAULT_PARAMETERS.scaleFactor);
-	parametersHelper.AddParameter<int>("GeneralParameters", "ScoreType", parameters.scoreType, DEFAULT_PARAMETERS.scoreType);
+	parametersHelper.AddParameter<int>("GeneralParameters", "LevelsNumber", parameters.generalParameters.levelsNumber, DEFAULT_PARAMETERS.generalParameters.levelsNumber);
+	parametersHelper.AddParameter<int>("GeneralParameters", "PatchSize", parameters.generalParameters.patchSize, DEFAULT_PARAMETERS.generalParameters.patchSize);
+	parametersHelper.AddParameter<double>("GeneralParameters", "ScaleFactor", parameters.generalParameters.scaleFactor, DEFAULT_PARAMETERS.generalParameters.scaleFactor);
+	parametersHelper.AddParameter<int>("GeneralParameters", "ScoreType", parameters.generalParameters.scoreType, DEFAULT_PARAMETERS.generalParameters.scoreType);
 
-	parametersHelper.AddParameter<int>("GeneralParameters", "SizeOfBrightnessTestSet", parameters.sizeOfBrightnessTestSet, DEFAULT_PARAMETERS.sizeOfBrightnessTestSet);
+	parametersHelper.AddParameter<int>("GeneralParameters", "SizeOfBrightnessTestSet", parameters.generalParameters.sizeOfBrightnessTestSet, DEFAULT_PARAMETERS.generalParameters.sizeOfBrightnessTestSet);
+
+	parametersHelper.AddParameter<bool>("GridParameters", "UseGrid", parameters.gridParameters.useGrid, DEFAULT_PARAMETERS.gridParameters.useGrid);
+	parametersHelper.AddParameter<int>("GridParameters", "CellSize", parameters.gridParameters.cellSize, DEFAULT_PARAMETERS.gridParameters.cellSize);
+	parametersHelper.AddParameter<int>("GridParameters", "MinimumFastThreshold", parameters.gridParameters.minimumFastThreshold, DEFAULT_PARAMETERS.gridParameters.minimumFastThreshold);
 
 	configurationFilePath = "";
+	CreateExtractors();
 }
 
 OrbDetectorDescriptor::~OrbDetectorDescriptor()
@@ -52,6 +58,7 @@ void OrbDetectorDescriptor::configure()
 {
 	parametersHelper.ReadFile(configurationFilePath);
 	ValidateParameters();
+	CreateExtractors();
 }
 
 void OrbDetectorDescriptor::process()
@@ -61,25 +68,41 @@ void OrbDetectorDescriptor::process()
 
 	// Process data
 	ValidateInputs(inputImage);
-	cv::Mat orbFeatures = ComputeOrbFeatures(inputImage);
+	std::vector<cv::KeyPoint> keypointsVector;
+	cv::Mat descriptorsMatrix;
+	if (parameters.gridParameters.useGrid)
+	{
+		ComputeGridOrbFeatures(inputImage, keypointsVector, descriptorsMatrix);
+	}
+	else
+	{
+		ComputeOrbFeatures(inputImage, keypointsVector, descriptorsMatrix);
+	}
 
 	// Write data to output port
-	VisualPointFeatureVector2DConstPtr tmp = matToVisualPointFeatureVector2D.Convert(orbFeatures);
-	Copy(*tmp, outFeatures);
-	delete(tmp);
-}
-
-const OrbDetectorDescriptor::OrbOptionsSet OrbDetectorDescriptor::DEFAULT_PARAMETERS =
-{
-	/*.edgeThreshold =*/ 31,
-	/*.fastThreshold =*/ 20,
-	/*.firstLevel =*/ 0,
-	/*.maxFeaturesNumber =*/ 500,
-	/*.levelsNumber =*/ 8,
-	/*.patchSize =*/ 31,
-	/*.scaleFactor =*/ 1.2,
-	/*.scoreType =*/ 0,
-	/*.sizeOfBrightnessTestSet =*/ 2
+	WriteOutputFeatures(keypointsVector, descriptorsMatrix);
+}
+
+const OrbDetectorDescriptor::OrbDetectorDescriptorOptionsSet OrbDetectorDescriptor::DEFAULT_PARAMETERS =
+{
+	//.generalParameters =
+	{
+		/*.edgeThreshold =*/ 31,
+		/*.fastThreshold =*/ 20,
+		/*.firstLevel =*/ 0,
+		/*.maxFeaturesNumber =*/ 500,
+		/*.levelsNumber =*/ 8,
+		/*.patchSize =*/ 31,
+		/*.scaleFactor =*/ 1.2,
+		/*.scoreType =*/ 0,
+		/*.sizeOfBrightnessTestSet =*/ 2
+	},
+	//.gridParameters =
+	{
+		/*.useGrid =*/ false,
+		/*.cellSize =*/ 30,
+		/*.minimumFastThreshold =*/ 7
+	}
 };
 
 int OrbDetectorDescriptor::ConvertToScoreType(const std::string& scoreType)
@@ -95,56 +118,280 @@ int OrbDetectorDescriptor::ConvertToScoreType(const std::string& scoreType)
 	ASSERT(false, "Orb Detector Descriptor Configuration Error: Score type should be either HarrisScore or FastScore (1, or 2)");
 }
 
-cv::Mat OrbDetectorDescriptor::ComputeOrbFeatures(cv::Mat inputImage)
+void OrbDetectorDescriptor::CreateExtractors()
 {
-	cv::Ptr<cv::ORB> orb = cv::ORB::create();
-	orb->setEdgeThreshold(parameters.edgeThreshold);
-	orb->setFastThreshold(parameters.fastThreshold);
-	orb->setFirstLevel(parameters.firstLevel);
-	orb->setMaxFeatures(parameters.maxFeaturesNumber);
-	orb->setNLevels(parameters.levelsNumber);
-	orb->setPatchSize(parameters.patchSize);
-	orb->setScaleFactor(parameters.scaleFactor);
-	orb->setScoreType(parameters.scoreType);
-	orb->setWTA_K(parameters.sizeOfBrightnessTestSet);
+	const OrbOptionsSet& orbParameters = parameters.generalParameters;
+	orb = cv::ORB::create(
+		orbParameters.maxFeaturesNumber,
+		orbParameters.scaleFactor,
+		orbParameters.levelsNumber,
+		orbParameters.edgeThreshold,
+		orbParameters.firstLevel,
+		orbParameters.sizeOfBrightnessTestSet,
+		orbParameters.scoreType,
+		orbParameters.patchSize,
+		orbParameters.fastThreshold
+		);
+	// OpenCV does not guarantee that a Feature2D object can be used by several threads at once
+	levelDescriptorsExtractors.resize(orbParameters.levelsNumber);
+	for (int level = 0; level < orbParameters.levelsNumber; level++)
+	{
+		levelDescriptorsExtractors.at(level) = cv::ORB::create(
+			orbParameters.maxFeaturesNumber,
+			orbParameters.scaleFactor,
+			1,
+			orbParameters.edgeThreshold,
+			0,
+			orbParameters.sizeOfBrightnessTestSet,
+			orbParameters.scoreType,
+			orbParameters.patchSize,
+			orbParameters.fastThreshold
+			);
+	}
 
-	std::vector<cv::KeyPoint> keypointsVector;
-	cv::Mat descriptorsMatrix;
+	const int halfPatchSize = orbParameters.patchSize / 2;
+	patchRowHalfWidths.resize(halfPatchSize + 1);
+	for (int row = 0; row <= halfPatchSize; row++)
+	{
+		patchRowHalfWidths.at(row) = cvRound( std::sqrt( static_cast<double>(halfPatchSize * halfPatchSize - row * row) ) );
+	}
+}
+
+void OrbDetectorDescriptor::ComputeOrbFeatures(cv::Mat inputImage, std::vector<cv::KeyPoint>& keypointsVector, cv::Mat& descriptorsMatrix)
+{
 	cv::Mat mask = cv::Mat();
 	orb->detectAndCompute(inputImage, mask, keypointsVector, descriptorsMatrix);
 	ASSERT(keypointsVector.size() == descriptorsMatrix.rows, "Orb Error: keypoints vector size does not match descriptorMatrix rows number");
+}
+
+/**
+ * Each level receives a share of the features that decreases geometrically with the level area, as in ORB-SLAM. The levels are then processed in parallel:
+ * keypoints are detected on a grid, oriented by the intensity centroid of their patch and described at their level, finally their coordinates are scaled to the input image.
+ */
+void OrbDetectorDescriptor::ComputeGridOrbFeatures(cv::Mat inputImage, std::vector<cv::KeyPoint>& keypointsVector, cv::Mat& descriptorsMatrix)
+{
+	const OrbOptionsSet& orbParameters = parameters.generalParameters;
+	BuildPyramid(inputImage);
+	const int numberOfLevels = pyramid.size();
 
-	if (keypointsVector.size() == 0)
+	std::vector<int> levelFeaturesNumbers(numberOfLevels);
+	const double inverseScaleFactor = 1 / orbParameters.scaleFactor;
+	double levelShare = orbParameters.maxFeaturesNumber * (1 - inverseScaleFactor) / (1 - std::pow(inverseScaleFactor, numberOfLevels));
+	int assignedFeatures = 0;
+	for (int level = 0; level < numberOfLevels - 1; level++)
 	{
-		return cv::Mat();
+		levelFeaturesNumbers.at(level) = cvRound(levelShare);
+		assignedFeatures += levelFeaturesNumbers.at(level);
+		levelShare *= inverseScaleFactor;
 	}
+	levelFeaturesNumbers.at(numberOfLevels - 1) = std::max(orbParameters.maxFeaturesNumber - assignedFeatures, 0);
+
+	levelKeypointsList.resize(numberOfLevels);
+	levelDescriptorsList.resize(numberOfLevels);
+	cv::parallel_for_(cv::Range(0, numberOfLevels), [&](const cv::Range& range)
+	{
+		for (int level = range.start; level < range.end; level++)
+		{
+			std::vector<cv::KeyPoint>& levelKeypoints = levelKeypointsList.at(level);
+			DetectGridKeypoints(level, levelFeaturesNumbers.at(level), levelKeypoints);
+			levelDescriptorsExtractors.at(level)->compute(pyramid.at(level), levelKeypoints, levelDescriptorsList.at(level));
 
-	unsigned numberOfFeatures = (keypointsVector.size() <= parameters.maxFeaturesNumber) ? keypointsVector.size() : parameters.maxFeaturesNumber;
-	cv::Mat orbFeaturesMatrix(numberOfFeatures, descriptorsMatrix.cols + 2, CV_32FC1);
-	cv::Mat descriptorsSubmatrix = orbFeaturesMatrix( cv::Rect(2, 0, orbFeaturesMatrix.cols-2, orbFeaturesMatrix.rows) );
-	descriptorsMatrix.convertTo(descriptorsSubmatrix, CV_32FC1);
+			const float levelScale = std::pow(orbParameters.scaleFactor, level);
+			for (unsigned pointIndex = 0; pointIndex < levelKeypoints.size(); pointIndex++)
+			{
+				levelKeypoints.at(pointIndex).pt *= levelScale;
+				levelKeypoints.at(pointIndex).size = orbParameters.patchSize * levelScale;
+				levelKeypoints.at(pointIndex).octave = level;
+			}
+		}
+	});
 
-	for (unsigned point = 0; point < numberOfFeatures; point++)
+	keypointsVector.clear();
+	std::vector<cv::Mat> nonEmptyDescriptorsList;
+	for (int level = 0; level < numberOfLevels; level++)
+	{
+		keypointsVector.insert(keypointsVector.end(), levelKeypointsList.at(level).begin(), levelKeypointsList.at(level).end());
+		if (levelKeypointsList.at(level).size() > 0)
+		{
+			nonEmptyDescriptorsList.push_back(levelDescriptorsList.at(level));
+		}
+	}
+	if (nonEmptyDescriptorsList.size() > 0)
 	{
-		orbFeaturesMatrix.at<float>(point, 0) = keypointsVector.at(point).pt.x;
-		orbFeaturesMatrix.at<float>(point, 1) = keypointsVector.at(point).pt.y;
+		cv::vconcat(nonEmptyDescriptorsList, descriptorsMatrix);
 	}
+	ASSERT(keypointsVector.size() == descriptorsMatrix.rows, "Orb Error: keypoints vector size does not match descriptorMatrix rows number");
+}
+
+/**
+ * The levels are reduced by the scale factor from the previous one, as in OpenCV; the matrices keep their memory while the image size does not change.
+ */
+void OrbDetectorDescriptor::BuildPyramid(cv::Mat inputImage)
+{
+	const OrbOptionsSet& orbParameters = parameters.generalParameters;
+	const int minimumLevelSize = 2 * orbParameters.edgeThreshold + 1;
+	pyramid.resize(orbParameters.levelsNumber);
 
-	return orbFeaturesMatrix;
+	if (inputImage.type() == CV_8UC3)
+	{
+		cv::cvtColor(inputImage, pyramid.at(0), cv::COLOR_BGR2GRAY);
+	}
+	else
+	{
+		inputImage.copyTo(pyramid.at(0));
+	}
+
+	for (int level = 1; level < orbParameters.levelsNumber; level++)
+	{
+		const double levelScale = std::pow(orbParameters.scaleFactor, level);
+		cv::Size levelSize( cvRound(inputImage.cols / levelScale), cvRound(inputImage.rows / levelScale) );
+		if (levelSize.width < minimumLevelSize || levelSize.height < minimumLevelSize)
+		{
+			pyramid.resize(level);
+			break;
+		}
+		cv::resize(pyramid.at(level - 1), pyramid.at(level), levelSize, 0, 0, cv::INTER_LINEAR);
+	}
+}
+
+/**
+ * The area of the level away from the edge threshold is split into cells of about cellSize pixels. FAST runs on each cell with the fast threshold, and again with the minimum
+ * fast threshold when the cell has no keypoint. The keypoints are then taken in turn from each cell in order of FAST score, so that textured cells do not use up the level share.
+ */
+void OrbDetectorDescriptor::DetectGridKeypoints(int level, int numberOfFeatures, std::vector<cv::KeyPoint>& keypointsVector)
+{
+	static const int FAST_RADIUS = 3;
+	const cv::Mat& image = pyramid.at(level);
+	const int border = std::max(parameters.generalParameters.edgeThreshold, parameters.generalParameters.patchSize / 2 + 1);
+	const int areaWidth = image.cols - 2 * border;
+	const int areaHeight = image.rows - 2 * border;
+	keypointsVector.clear();
+	if (areaWidth <= 0 || areaHeight <= 0 || numberOfFeatures == 0)
+	{
+		return;
+	}
+
+	const int numberOfColumns = std::max(1, areaWidth / parameters.gridParameters.cellSize);
+	const int numberOfRows = std::max(1, areaHeight / parameters.gridParameters.cellSize);
+	const int cellWidth = (areaWidth + numberOfColumns - 1) / numberOfColumns;
+	const int cellHeight = (areaHeight + numberOfRows - 1) / numberOfRows;
+
+	std::vector< std::vector<cv::KeyPoint> > cellKeypointsList(numberOfRows * numberOfColumns);
+	for (int row = 0; row < numberOfRows; row++)
+	{
+		for (int column = 0; column < numberOfColumns; column++)
+		{
+			const int cellX = border + column * cellWidth;
+			const int cellY = border + row * cellHeight;
+			const int endX = std::min(cellX + cellWidth, image.cols - border);
+			const int endY = std::min(cellY + cellHeight, image.rows - border);
+			if (endX <= cellX || endY <= cellY)
+			{
+				continue;
+			}
+
+			//The detection window includes the pixels needed by the FAST circle around the cell, FAST does not return keypoints in those pixels
+			cv::Rect window(cellX - FAST_RADIUS, cellY - FAST_RADIUS, endX - cellX + 2 * FAST_RADIUS, endY - cellY + 2 * FAST_RADIUS);
+			std::vector<cv::KeyPoint>& cellKeypoints = cellKeypointsList.at(row * numberOfColumns + column);
+			cv::FAST(image(window), cellKeypoints, parameters.generalParameters.fastThreshold, true);
+			if (cellKeypoints.size() == 0)
+			{
+				cv::FAST(image(window), cellKeypoints, parameters.gridParameters.minimumFastThreshold, true);
+			}
+
+			for (unsigned pointIndex = 0; pointIndex < cellKeypoints.size(); pointIndex++)
+			{
+				cellKeypoints.at(pointIndex).pt += cv::Point2f(window.x, window.y);
+			}
+			std::sort(cellKeypoints.begin(), cellKeypoints.end(), [](const cv::KeyPoint& first, const cv::KeyPoint& second) { return first.response > second.response; });
+		}
+	}
+
+	bool cellsLeft = true;
+	for (unsigned rank = 0; cellsLeft && static_cast<int>(keypointsVector.size()) < numberOfFeatures; rank++)
+	{
+		cellsLeft = false;
+		for (unsigned cellIndex = 0; cellIndex < cellKeypointsList.size() && static_cast<int>(keypointsVector.size()) < numberOfFeatures; cellIndex++)
+		{
+			if (rank < cellKeypointsList.at(cellIndex).size())
+			{
+				keypointsVector.push_back(cellKeypointsList.at(cellIndex).at(rank));
+				cellsLeft = true;
+			}
+		}
+	}
+
+	for (unsigned pointIndex = 0; pointIndex < keypointsVector.size(); pointIndex++)
+	{
+		cv::KeyPoint& keypoint = keypointsVector.at(pointIndex);
+		keypoint.angle = ComputeOrientation(image, keypoint.pt);
+		keypoint.size = parameters.generalParameters.patchSize;
+		keypoint.octave = 0;
+	}
+}
+
+/**
+ * The orientation in degrees of the vector from the keypoint to the intensity centroid of its circular patch.
+ */
+float OrbDetectorDescriptor::ComputeOrientation(const cv::Mat& image, const cv::Point2f& point)
+{
+	const int halfPatchSize = parameters.generalParameters.patchSize / 2;
+	const int step = static_cast<int>(image.step1());
+	const uchar* center = &image.at<uchar>(cvRound(point.y), cvRound(point.x));
+
+	int firstOrderColumnMoment = 0;
+	int firstOrderRowMoment = 0;
+	for (int column = -halfPatchSize; column <= halfPatchSize; column++)
+	{
+		firstOrderColumnMoment += column * center[column];
+	}
+	for (int row = 1; row <= halfPatchSize; row++)
+	{
+		int rowDifferenceSum = 0;
+		const int halfWidth = patchRowHalfWidths.at(row);
+		for (int column = -halfWidth; column <= halfWidth; column++)
+		{
+			int lowerValue = center[column + row * step];
+			int upperValue = center[column - row * step];
+			rowDifferenceSum += lowerValue - upperValue;
+			firstOrderColumnMoment += column * (lowerValue + upperValue);
+		}
+		firstOrderRowMoment += row * rowDifferenceSum;
+	}
+
+	return cv::fastAtan2(static_cast<float>(firstOrderRowMoment), static_cast<float>(firstOrderColumnMoment));
 }
 
+/**
+ * The descriptors are written as packed binary descriptors, at most maxFeaturesNumber of them.
+ */
+void OrbDetectorDescriptor::WriteOutputFeatures(const std::vector<cv::KeyPoint>& keypointsVector, cv::Mat descriptorsMatrix)
+{
+	ClearPoints(outFeatures);
+	SetDescriptorType(outFeatures, BINARY_DESCRIPTORS);
+
+	int numberOfFeatures = std::min(static_cast<int>(keypointsVector.size()), parameters.generalParameters.maxFeaturesNumber);
+	for (int pointIndex = 0; pointIndex < numberOfFeatures; pointIndex++)
+	{
+		AddPoint(outFeatures, keypointsVector.at(pointIndex).pt.x, keypointsVector.at(pointIndex).pt.y);
+		SetBinaryDescriptor(outFeatures, pointIndex, descriptorsMatrix.ptr<uint8_t>(pointIndex), descriptorsMatrix.cols);
+	}
+}
 
 void OrbDetectorDescriptor::ValidateParameters()
 {
-	ASSERT(parameters.edgeThreshold > 0, "Orb Detector Descriptor Configuration Error: edge threshold should be strictly positive");
-	ASSERT(parameters.fastThreshold > 0, "Orb Detector Descriptor Configuration Error: fast threshold should be strictly positive");
-	ASSERT(parameters.firstLevel == 0, "Orb Detector Descriptor Configuration Error: first level should be 0");
-	ASSERT(parameters.maxFeaturesNumber > 0, "Orb Detector Descriptor Configuration Error: max features number should be strictly positive");
-	ASSERT(parameters.levelsNumber > 0, "Orb Detector Descriptor Configuration Error: pyramid levels number should be strictly positive");
-	ASSERT(parameters.patchSize > 0, "Orb Detector Descriptor Configuration Error: patch size should be strictly positive");
-	ASSERT(parameters.scaleFactor > 1, "Orb Detector Descriptor Configuration Error: scale factor should be greater than 1");
-	ASSERT(parameters.scoreType == cv::ORB::HARRIS_SCORE || parameters.scoreType == cv::ORB::FAST_SCORE, "Orb Detector Descriptor Configuration Error: scoreType should be HarrisScore or FastScore");
-	ASSERT(parameters.sizeOfBrightnessTestSet >= 2 && parameters.sizeOfBrightnessTestSet <= 4, "Orb Detector Descriptor Configuration Error: size of brightness test set should be 2, 3, or 4");
+	ASSERT(parameters.generalParameters.edgeThreshold > 0, "Orb Detector Descriptor Configuration Error: edge threshold should be strictly positive");
+	ASSERT(parameters.generalParameters.fastThreshold > 0, "Orb Detector Descriptor Configuration Error: fast threshold should be strictly positive");
+	ASSERT(parameters.generalParameters.firstLevel == 0, "Orb Detector Descriptor Configuration Error: first level should be 0");
+	ASSERT(parameters.generalParameters.maxFeaturesNumber > 0, "Orb Detector Descriptor Configuration Error: max features number should be strictly positive");
+	ASSERT(parameters.generalParameters.levelsNumber > 0, "Orb Detector Descriptor Configuration Error: pyramid levels number should be strictly positive");
+	ASSERT(parameters.generalParameters.patchSize > 0, "Orb Detector Descriptor Configuration Error: patch size should be strictly positive");
+	ASSERT(parameters.generalParameters.scaleFactor > 1, "Orb Detector Descriptor Configuration Error: scale factor should be greater than 1");
+	ASSERT(parameters.generalParameters.scoreType == cv::ORB::HARRIS_SCORE || parameters.generalParameters.scoreType == cv::ORB::FAST_SCORE, "Orb Detector Descriptor Configuration Error: scoreType should be HarrisScore or FastScore");
+	ASSERT(parameters.generalParameters.sizeOfBrightnessTestSet >= 2 && parameters.generalParameters.sizeOfBrightnessTestSet <= 4, "Orb Detector Descriptor Configuration Error: size of brightness test set should be 2, 3, or 4");
+	ASSERT(parameters.gridParameters.cellSize > 0, "Orb Detector Descriptor Configuration Error: grid cell size should be strictly positive");
+	ASSERT(parameters.gridParameters.minimumFastThreshold > 0 && parameters.gridParameters.minimumFastThreshold <= parameters.generalParameters.fastThreshold,
+		"Orb Detector Descriptor Configuration Error: minimum fast threshold should be strictly positive and not greater than the fast threshold");
 }
 
 void OrbDetectorDescriptor::ValidateInputs(cv::Mat inputImage)
@@ -14,7 +14,6 @@
 #include <Types/CPP/Frame.hpp>
 #include <Types/CPP/VisualPointFeatureVector2D.hpp>
 #include <Converters/FrameToMatConverter.hpp>
-#include <Converters/MatToVisualPointFeatureVector2DConverter.hpp>
 #include <Helpers/ParametersListHelper.hpp>
 #include <opencv2/core/core.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
@@ -29,7 +28,7 @@ namespace FeaturesExtraction2D
 {
 	/**
 	 * Extraction of keypoints from a 2D image using ORB (modified FAST detector
-	 * and BRIEF descriptor). Descriptors are returned.
+	 * and BRIEF descriptor). Descriptors are returned as packed binary descriptors.
 	 *
 	 * @param generalParameters.edgeThreshold
 	 * @param generalParameters.fastThreshold
@@ -41,6 +40,15 @@ namespace FeaturesExtraction2D
 	 * @param generalParameters.scaleFactor
 	 * @param generalParameters.scoreType
 	 * @param generalParameters.sizeOfBrightnessTestSet
+	 *
+	 * @param gridParameters.useGrid
+	 *        whether keypoints are detected cell by cell on a regular grid of each pyramid level, so that they spread over the whole image instead of clustering
+	 *        on the most textured regions; the keypoints of each level are then taken in turn from each cell, in order of FAST score, and the pyramid levels
+	 *        are processed in parallel
+	 * @param gridParameters.cellSize
+	 *        the approximate side in pixels of the grid cells at each pyramid level
+	 * @param gridParameters.minimumFastThreshold
+	 *        the FAST threshold used again in a cell where the fast threshold finds no keypoint, it has to be smaller than the fast threshold
 	 */
 	class OrbDetectorDescriptor : public FeaturesExtraction2DInterface
 	{
@@ -68,19 +76,45 @@ namespace FeaturesExtraction2D
 				int sizeOfBrightnessTestSet;
 			};
 
+			struct GridOptionsSet
+			{
+				bool useGrid;
+				int cellSize;
+				int minimumFastThreshold;
+			};
+
+			struct OrbDetectorDescriptorOptionsSet
+			{
+				OrbOptionsSet generalParameters;
+				GridOptionsSet gridParameters;
+			};
+
 			Helpers::ParametersListHelper parametersHelper;
-			OrbOptionsSet parameters;
-			static const OrbOptionsSet DEFAULT_PARAMETERS;
+			OrbDetectorDescriptorOptionsSet parameters;
+			static const OrbDetectorDescriptorOptionsSet DEFAULT_PARAMETERS;
+
+			//The extractors and the pyramid are kept across frames, the extractors are created at configuration
+			cv::Ptr<cv::ORB> orb;
+			std::vector< cv::Ptr<cv::ORB> > levelDescriptorsExtractors; //one per pyramid level in grid mode, as the levels are described concurrently
+			std::vector<cv::Mat> pyramid;
+			std::vector<int> patchRowHalfWidths; //the half width of each row of the circular patch used for the orientation
+			std::vector< std::vector<cv::KeyPoint> > levelKeypointsList;
+			std::vector<cv::Mat> levelDescriptorsList;
 
 			//External conversion helpers
 			Converters::FrameToMatConverter frameToMat;
-			Converters::MatToVisualPointFeatureVector2DConverter matToVisualPointFeatureVector2D;
 
 			//Type conversion methods
 			static int ConvertToScoreType(const std::string& scoreType);
 
 			//Core computation methods
-			cv::Mat ComputeOrbFeatures(cv::Mat inputImage);
+			void CreateExtractors();
+			void ComputeOrbFeatures(cv::Mat inputImage, std::vector<cv::KeyPoint>& keypointsVector, cv::Mat& descriptorsMatrix);
+			void ComputeGridOrbFeatures(cv::Mat inputImage, std::vector<cv::KeyPoint>& keypointsVector, cv::Mat& descriptorsMatrix);
+			void BuildPyramid(cv::Mat inputImage);
+			void DetectGridKeypoints(int level, int numberOfFeatures, std::vector<cv::KeyPoint>& keypointsVector);
+			float ComputeOrientation(const cv::Mat& image, const cv::Point2f& point);
+			void WriteOutputFeatures(const std::vector<cv::KeyPoint>& keypointsVector, cv::Mat descriptorsMatrix);
 
 			//Input Validation methods
 			void ValidateParameters();
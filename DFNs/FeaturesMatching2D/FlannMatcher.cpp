@@ -15,6 +15,8 @@
 
 #include <stdlib.h>
 #include <fstream>
+#include <cmath>
+#include <cstring>
 
 using namespace Converters;
 using namespace VisualPointFeatureVector2DWrapper;
@@ -42,6 +44,7 @@ FlannMatcher::FlannMatcher()
 	ADD_PARAMETER(float, "GeneralParameters", "Epsilon", generalOptionsSet, epsilon);
 	ADD_PARAMETER(bool, "GeneralParameters", "SortedSearch", generalOptionsSet, sortedSearch);
 	ADD_PARAMETER(float, "GeneralParameters", "AcceptanceRatio", generalOptionsSet, acceptanceRatio);
+	ADD_PARAMETER(int, "GeneralParameters", "IndexCacheSize", generalOptionsSet, indexCacheSize);
 
 	ADD_PARAMETER(int, "KdTreeSearchParameters", "NumberOfTrees", kdTreeSearchOptionsSet, numberOfTrees);
 
@@ -82,6 +85,7 @@ void FlannMatcher::configure()
 {
 	parametersHelper.ReadFile(configurationFilePath);
 	ValidateParameters();
+	indexCache.clear();
 }
 
 void FlannMatcher::process()
@@ -198,7 +202,8 @@ const FlannMatcher::FlannMatcherOptionsSet FlannMatcher::DEFAULT_PARAMETERS =
 		/*.epsilon =*/ 0,
 		/*.sortedSearch =*/ false,
 		/*.matcherMethod =*/ KD_TREE_SEARCH,
-		/*.acceptanceRatio =*/ 0.75
+		/*.acceptanceRatio =*/ 0.75,
+		/*.indexCacheSize =*/ 8
 	},
 	//.kdTreeSearchOptionsSet =
 	{
@@ -340,31 +345,96 @@ std::vector<cv::DMatch> FlannMatcher::ComputeMatches(cv::Mat sourceDescriptorsMa
 	cv::Mat validTypeSourceDescriptorsMatrix = ConvertToValidType(sourceDescriptorsMatrix);
 	cv::Mat validTypeSinkDescriptorsMatrix = ConvertToValidType(sinkDescriptorsMatrix);
 
-	cv::Ptr<cv::flann::SearchParams> searchParams =
-		new cv::flann::SearchParams(parameters.generalOptionsSet.numberOfChecks, parameters.generalOptionsSet.epsilon, parameters.generalOptionsSet.sortedSearch);
-	cv::Ptr<cv::flann::IndexParams> indexParams = ConvertParameters();
+	cv::flann::SearchParams searchParams(parameters.generalOptionsSet.numberOfChecks, parameters.generalOptionsSet.epsilon, parameters.generalOptionsSet.sortedSearch);
+	cv::Ptr<cv::flann::Index> sinkIndex = GetSinkIndex(validTypeSinkDescriptorsMatrix);
+
+	const int NumberOfBestMatchesToCompare = 2;
+	cv::Mat indicesMatrix, distancesMatrix;
+	sinkIndex->knnSearch(validTypeSourceDescriptorsMatrix, indicesMatrix, distancesMatrix, NumberOfBestMatchesToCompare, searchParams);
+
+	// As in cv::FlannBasedMatcher, Hamming distances are integers and L2 distances are returned squared
+	std::vector<cv::DMatch> sequenceOfSelectedMatches;
+	for (int sourceIndex = 0; sourceIndex < indicesMatrix.rows; sourceIndex++)
+	{
+		if (indicesMatrix.at<int>(sourceIndex, 0) < 0 || indicesMatrix.at<int>(sourceIndex, 1) < 0)
+		{
+			continue;
+		}
+		float bestDistance, secondDistance;
+		if (distancesMatrix.type() == CV_32S)
+		{
+			bestDistance = static_cast<float>( distancesMatrix.at<int>(sourceIndex, 0) );
+			secondDistance = static_cast<float>( distancesMatrix.at<int>(sourceIndex, 1) );
+		}
+		else
+		{
+			bestDistance = std::sqrt( distancesMatrix.at<float>(sourceIndex, 0) );
+			secondDistance = std::sqrt( distancesMatrix.at<float>(sourceIndex, 1) );
+		}
 
-	cv::FlannBasedMatcher matcher(indexParams, searchParams);
+		if (bestDistance < secondDistance * parameters.generalOptionsSet.acceptanceRatio)
+		{
+			sequenceOfSelectedMatches.push_back( cv::DMatch(sourceIndex, indicesMatrix.at<int>(sourceIndex, 0), 0, bestDistance) );
+		}
+	}
 
-	typedef std::vector<cv::DMatch> MatchesSequence;
-	const unsigned NumberOfBestMatchingSequencesToCompare = 2;
+	return sequenceOfSelectedMatches;
+}
 
-	std::vector<MatchesSequence> bestMatchingSequencesVector;
-	matcher.knnMatch(validTypeSourceDescriptorsMatrix, validTypeSinkDescriptorsMatrix, bestMatchingSequencesVector, NumberOfBestMatchingSequencesToCompare);
+/**
+ * A cached index is used only if its descriptors are equal to the sink descriptors, so that a hash collision cannot return a wrong index.
+ */
+cv::Ptr<cv::flann::Index> FlannMatcher::GetSinkIndex(cv::Mat sinkDescriptorsMatrix)
+{
+	uint64_t descriptorsHash = ComputeHash(sinkDescriptorsMatrix);
+	size_t descriptorsSize = sinkDescriptorsMatrix.total() * sinkDescriptorsMatrix.elemSize();
+	for (std::list<CachedIndex>::iterator cachedIndex = indexCache.begin(); cachedIndex != indexCache.end(); ++cachedIndex)
+	{
+		const cv::Mat& cachedDescriptors = cachedIndex->descriptorsMatrix;
+		if (cachedIndex->descriptorsHash == descriptorsHash && cachedDescriptors.rows == sinkDescriptorsMatrix.rows && cachedDescriptors.cols == sinkDescriptorsMatrix.cols &&
+			cachedDescriptors.type() == sinkDescriptorsMatrix.type() && std::memcmp(cachedDescriptors.data, sinkDescriptorsMatrix.data, descriptorsSize) == 0)
+		{
+			indexCache.splice(indexCache.begin(), indexCache, cachedIndex);
+			return indexCache.front().index;
+		}
+	}
 
-	MatchesSequence sequenceOfSelectedMatches;
-	for (unsigned sequenceIndex = 0; sequenceIndex < bestMatchingSequencesVector.size(); sequenceIndex++)
+	cv::Ptr<cv::flann::IndexParams> indexParams = ConvertParameters();
+	cvflann::flann_distance_t distanceType = (parameters.generalOptionsSet.matcherMethod == LOCALITY_SENSITIVE_HASHING) ? cvflann::FLANN_DIST_HAMMING : cvflann::FLANN_DIST_L2;
+	cv::Ptr<cv::flann::Index> sinkIndex = cv::makePtr<cv::flann::Index>(sinkDescriptorsMatrix, *indexParams, distanceType);
+	if (parameters.generalOptionsSet.indexCacheSize > 0)
 	{
-		if (bestMatchingSequencesVector[sequenceIndex].size() >= 2)
+		CachedIndex newEntry = { descriptorsHash, sinkDescriptorsMatrix, sinkIndex };
+		indexCache.push_front(newEntry);
+		if (static_cast<int>(indexCache.size()) > parameters.generalOptionsSet.indexCacheSize)
 		{
-			if (bestMatchingSequencesVector[sequenceIndex][0].distance < bestMatchingSequencesVector[sequenceIndex][1].distance * parameters.generalOptionsSet.acceptanceRatio)
-			{
-				sequenceOfSelectedMatches.push_back(bestMatchingSequencesVector[sequenceIndex][0]);
-			}
+			indexCache.pop_back();
 		}
 	}
+	return sinkIndex;
+}
+
+/**
+ * FNV-1a hash of the size, type and content of a continuous matrix.
+ */
+uint64_t FlannMatcher::ComputeHash(cv::Mat descriptorsMatrix)
+{
+	const uint64_t FnvPrime = 1099511628211ULL;
+	uint64_t hash = 14695981039346656037ULL;
+	int header[3] = { descriptorsMatrix.rows, descriptorsMatrix.cols, descriptorsMatrix.type() };
+	const unsigned char* headerBytes = reinterpret_cast<const unsigned char*>(header);
+	for (size_t byteIndex = 0; byteIndex < sizeof(header); byteIndex++)
+	{
+		hash = (hash ^ headerBytes[byteIndex]) * FnvPrime;
+	}
 
-	return sequenceOfSelectedMatches;
+	const unsigned char* dataBytes = descriptorsMatrix.data;
+	size_t dataSize = descriptorsMatrix.total() * descriptorsMatrix.elemSize();
+	for (size_t byteIndex = 0; byteIndex < dataSize; byteIndex++)
+	{
+		hash = (hash ^ dataBytes[byteIndex]) * FnvPrime;
+	}
+	return hash;
 }
 
 void FlannMatcher::CleanLowScoringMatches(CorrespondenceMap2DConstPtr correspondenceMap, CorrespondenceMap2DPtr cleanMap)
@@ -402,6 +472,7 @@ void FlannMatcher::ValidateParameters()
 	ASSERT(parameters.generalOptionsSet.numberOfChecks > 0, "FlannMatcher Error: number of checks is not positive");
 	ASSERT(parameters.generalOptionsSet.epsilon >= 0, "FlannMatcher Error: epsilon is negative");
 	ASSERT(parameters.generalOptionsSet.acceptanceRatio >= 0 && parameters.generalOptionsSet.acceptanceRatio <= 1, "FlannMatcher Error: acceptanceRatio has to be between 0 and 1");
+	ASSERT(parameters.generalOptionsSet.indexCacheSize >= 0, "FlannMatcher Error: indexCacheSize is negative");
 
 	if (parameters.generalOptionsSet.matcherMethod == KD_TREE_SEARCH)
 	{
@@ -22,6 +22,9 @@
 #include <opencv2/opencv_modules.hpp>
 #include <yaml-cpp/yaml.h>
 
+#include <list>
+#include <cstdint>
+
 namespace CDFF
 {
 namespace DFN
@@ -36,6 +39,11 @@ namespace FeaturesMatching2D
 	 * (iii) filtering of the best matches: only those that satisfy the
 	 * acceptanceRatio are kept.
 	 *
+	 * The indices built on the sink descriptors are cached by content, so that
+	 * matching again against the same sink features skips the construction
+	 * of the index. The least recently used index is evicted when the cache
+	 * is full.
+	 *
 	 * @param distanceThreshold
 	 * @param numberOfChecks
 	 * @param epsilon
@@ -43,6 +51,9 @@ namespace FeaturesMatching2D
 	 * @param acceptanceRatio
 	 *        a value between 0 and 1 that defines whether a good match is kept
 	 *        and returned
+	 * @param indexCacheSize
+	 *        the maximum number of sink indices kept in the cache, zero
+	 *        disables the cache
 	 * @param matcherMethod
 	 *        method used for matching: KdTreeSearch, KMeansClustering,
 	 *        AutotunedSearch, HierarchichalClustering, LocalitySensitiveHashing,
@@ -124,6 +135,7 @@ namespace FeaturesMatching2D
 				bool sortedSearch;
 				MatcherMethod matcherMethod;
 				float acceptanceRatio;
+				int indexCacheSize;
 			};
 
 			struct KdTreeSearchOptionsSet
@@ -186,6 +198,15 @@ namespace FeaturesMatching2D
 			FlannMatcherOptionsSet parameters;
 			static const FlannMatcherOptionsSet DEFAULT_PARAMETERS;
 
+			//An index built on a set of sink descriptors, the descriptors are kept as the index refers to their data
+			struct CachedIndex
+			{
+				uint64_t descriptorsHash;
+				cv::Mat descriptorsMatrix;
+				cv::Ptr<cv::flann::Index> index;
+			};
+			std::list<CachedIndex> indexCache; //ordered from the most to the least recently used
+
 			//External conversion helpers
 			Converters::VisualPointFeatureVector2DToMatConverter visualPointFeatureVector2DToMat;
 
@@ -196,6 +217,8 @@ namespace FeaturesMatching2D
 
 			//Core computation methods
 			std::vector< cv::DMatch > ComputeMatches(cv::Mat sourceDescriptorsMatrix, cv::Mat sinkDescriptorsMatrix);
+			cv::Ptr<cv::flann::Index> GetSinkIndex(cv::Mat sinkDescriptorsMatrix);
+			static uint64_t ComputeHash(cv::Mat descriptorsMatrix);
 			void CleanLowScoringMatches(CorrespondenceMap2DWrapper::CorrespondenceMap2DConstPtr correspondenceMap, 
 				CorrespondenceMap2DWrapper::CorrespondenceMap2DPtr cleanMap);
 
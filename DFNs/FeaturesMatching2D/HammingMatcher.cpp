@@ -0,0 +1,783 @@
+/**
+ * @author Alessandro Bianco
+ */
+
+/**
+ * @addtogroup DFNs
+ * @{
+ */
+
+#include "HammingMatcher.hpp"
+
+#include <Errors/Assert.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include <sstream>
+
+#if defined(__x86_64__) || defined(__i386__)
+	#include <immintrin.h>
+	#define HAMMING_HAVE_X86_SIMD
+#endif
+
+using namespace VisualPointFeatureVector2DWrapper;
+using namespace CorrespondenceMap2DWrapper;
+
+namespace CDFF
+{
+namespace DFN
+{
+namespace FeaturesMatching2D
+{
+
+namespace
+{
+	inline const uint64_t* GetDescriptor(const uint64_t* descriptors, const int* indices, int descriptorIndex, int numberOfWords)
+	{
+		int index = (indices == NULL) ? descriptorIndex : indices[descriptorIndex];
+		return descriptors + static_cast<size_t>(index) * numberOfWords;
+	}
+
+	void ComputeDistancesScalar(const uint64_t* query, const uint64_t* descriptors, const int* indices, int numberOfDescriptors, int numberOfWords, int* distances)
+	{
+		for (int descriptorIndex = 0; descriptorIndex < numberOfDescriptors; descriptorIndex++)
+		{
+			const uint64_t* descriptor = GetDescriptor(descriptors, indices, descriptorIndex, numberOfWords);
+			int distance = 0;
+			for (int word = 0; word < numberOfWords; word++)
+			{
+				distance += __builtin_popcountll(query[word] ^ descriptor[word]);
+			}
+			distances[descriptorIndex] = distance;
+		}
+	}
+
+#ifdef HAMMING_HAVE_X86_SIMD
+	__attribute__((target("popcnt")))
+	void ComputeDistancesPopcnt(const uint64_t* query, const uint64_t* descriptors, const int* indices, int numberOfDescriptors, int numberOfWords, int* distances)
+	{
+		for (int descriptorIndex = 0; descriptorIndex < numberOfDescriptors; descriptorIndex++)
+		{
+			const uint64_t* descriptor = GetDescriptor(descriptors, indices, descriptorIndex, numberOfWords);
+			int distance = 0;
+			for (int word = 0; word < numberOfWords; word++)
+			{
+				distance += __builtin_popcountll(query[word] ^ descriptor[word]);
+			}
+			distances[descriptorIndex] = distance;
+		}
+	}
+
+	/**
+	 * Four descriptors at a time: the bits of each 256 bit block are counted by nibble lookup and summed into four 64 bit lanes per descriptor,
+	 * the lanes of the four descriptors are then interleaved and added so that the four distances are stored with one instruction.
+	 */
+	__attribute__((target("avx2,popcnt")))
+	void ComputeDistancesAvx2(const uint64_t* query, const uint64_t* descriptors, const int* indices, int numberOfDescriptors, int numberOfWords, int* distances)
+	{
+		if (numberOfWords % 4 != 0)
+		{
+			ComputeDistancesPopcnt(query, descriptors, indices, numberOfDescriptors, numberOfWords, distances);
+			return;
+		}
+
+		const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+		const __m256i lowNibbleMask = _mm256_set1_epi8(0x0F);
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i firstQueryBlock = _mm256_loadu_si256( reinterpret_cast<const __m256i*>(query) ); //kept in a register for the common 256 bit descriptors
+
+		int descriptorIndex = 0;
+		for (; descriptorIndex + 4 <= numberOfDescriptors; descriptorIndex += 4)
+		{
+			__m256i sums[4];
+			for (int lane = 0; lane < 4; lane++)
+			{
+				const uint64_t* descriptor = GetDescriptor(descriptors, indices, descriptorIndex + lane, numberOfWords);
+				__m256i sum = zero;
+				for (int word = 0; word < numberOfWords; word += 4)
+				{
+					__m256i queryBlock = (word == 0) ? firstQueryBlock : _mm256_loadu_si256( reinterpret_cast<const __m256i*>(query + word) );
+					__m256i difference = _mm256_xor_si256( queryBlock,
+						_mm256_loadu_si256( reinterpret_cast<const __m256i*>(descriptor + word) ) );
+					__m256i lowCounts = _mm256_shuffle_epi8( lookup, _mm256_and_si256(difference, lowNibbleMask) );
+					__m256i highCounts = _mm256_shuffle_epi8( lookup, _mm256_and_si256(_mm256_srli_epi16(difference, 4), lowNibbleMask) );
+					sum = _mm256_add_epi64( sum, _mm256_sad_epu8(_mm256_add_epi8(lowCounts, highCounts), zero) );
+				}
+				sums[lane] = sum;
+			}
+			__m256i sums01 = _mm256_or_si256( sums[0], _mm256_slli_epi64(sums[1], 32) );
+			__m256i sums23 = _mm256_or_si256( sums[2], _mm256_slli_epi64(sums[3], 32) );
+			__m256i pairSums = _mm256_add_epi32( _mm256_unpacklo_epi64(sums01, sums23), _mm256_unpackhi_epi64(sums01, sums23) );
+			__m128i totals = _mm_add_epi32( _mm256_castsi256_si128(pairSums), _mm256_extracti128_si256(pairSums, 1) );
+			_mm_storeu_si128( reinterpret_cast<__m128i*>(distances + descriptorIndex), totals );
+		}
+
+		const int* remainingIndices = (indices == NULL) ? NULL : indices + descriptorIndex;
+		const uint64_t* remainingDescriptors = (indices == NULL) ? descriptors + static_cast<size_t>(descriptorIndex) * numberOfWords : descriptors;
+		ComputeDistancesPopcnt(query, remainingDescriptors, remainingIndices, numberOfDescriptors - descriptorIndex, numberOfWords, distances + descriptorIndex);
+	}
+#endif
+
+	//Keeps the smallest and the second smallest distance, the first index wins ties
+	inline void UpdateNearest(int index, int distance, int& bestIndex, int& bestDistance, int& secondDistance)
+	{
+		if (distance < bestDistance)
+		{
+			secondDistance = bestDistance;
+			bestDistance = distance;
+			bestIndex = index;
+		}
+		else if (distance < secondDistance)
+		{
+			secondDistance = distance;
+		}
+	}
+}
+
+HammingMatcher::HammingMatcher()
+{
+	#define ADD_PARAMETER(type, groupName, parameterName, groupVariable, parameterVariable) \
+		parametersHelper.AddParameter<type>(groupName, parameterName, parameters.groupVariable.parameterVariable, DEFAULT_PARAMETERS.groupVariable.parameterVariable);
+	#define ADD_PARAMETER_WITH_HELPER(type, helperType, groupName, parameterName, groupVariable, parameterVariable) \
+		parametersHelper.AddParameter<type, helperType>(groupName, parameterName, parameters.groupVariable.parameterVariable, DEFAULT_PARAMETERS.groupVariable.parameterVariable);
+
+	parameters = DEFAULT_PARAMETERS;
+
+	ADD_PARAMETER_WITH_HELPER(MatcherMethod, MatcherMethodHelper, "GeneralParameters", "MatcherMethod", generalOptionsSet, matcherMethod);
+	ADD_PARAMETER(float, "GeneralParameters", "AcceptanceRatio", generalOptionsSet, acceptanceRatio);
+	ADD_PARAMETER(int, "GeneralParameters", "MaximumDistance", generalOptionsSet, maximumDistance);
+	ADD_PARAMETER(bool, "GeneralParameters", "CrossCheck", generalOptionsSet, crossCheck);
+
+	ADD_PARAMETER(int, "LocalitySensitiveHashingParameters", "TableNumber", localitySensitiveHashingOptionsSet, tableNumber);
+	ADD_PARAMETER(int, "LocalitySensitiveHashingParameters", "KeySize", localitySensitiveHashingOptionsSet, keySize);
+	ADD_PARAMETER(int, "LocalitySensitiveHashingParameters", "MultiProbeLevel", localitySensitiveHashingOptionsSet, multiProbeLevel);
+
+	ADD_PARAMETER_WITH_HELPER(ConstraintType, ConstraintTypeHelper, "GuidedSearchParameters", "ConstraintType", guidedSearchOptionsSet, constraintType);
+	ADD_PARAMETER(float, "GuidedSearchParameters", "SearchRadius", guidedSearchOptionsSet, searchRadius);
+	ADD_PARAMETER(int, "GuidedSearchParameters", "CellSize", guidedSearchOptionsSet, cellSize);
+	ADD_PARAMETER(float, "GuidedSearchParameters", "PredictedOffsetX", guidedSearchOptionsSet, predictedOffsetX);
+	ADD_PARAMETER(float, "GuidedSearchParameters", "PredictedOffsetY", guidedSearchOptionsSet, predictedOffsetY);
+
+	for (int row = 0; row < 3; row++)
+	{
+		for (int column = 0; column < 3; column++)
+		{
+			std::stringstream elementStream;
+			elementStream << "Element_" << row << "_" << column;
+			parametersHelper.AddParameter<double>("FundamentalMatrix", elementStream.str(), parameters.fundamentalMatrix[3*row+column], DEFAULT_PARAMETERS.fundamentalMatrix[3*row+column]);
+		}
+	}
+
+	distancesFunction = SelectDistancesFunction();
+	numberOfBits = 0;
+	numberOfWords = 0;
+	configurationFilePath = "";
+}
+
+HammingMatcher::~HammingMatcher()
+{
+}
+
+void HammingMatcher::configure()
+{
+	parametersHelper.ReadFile(configurationFilePath);
+	ValidateParameters();
+	sampledBitsList.clear();
+}
+
+void HammingMatcher::process()
+{
+	ClearCorrespondences(outMatches);
+	if (GetNumberOfPoints(inSourceFeatures) == 0 || GetNumberOfPoints(inSinkFeatures) == 0)
+	{
+		return;
+	}
+
+	// Read data from input port
+	ValidateInputs();
+	PackDescriptors(inSourceFeatures, sourceSet);
+	PackDescriptors(inSinkFeatures, sinkSet);
+
+	// Process data
+	if (parameters.generalOptionsSet.matcherMethod == BRUTE_FORCE)
+	{
+		FindNearestByBruteForce(sourceSet, sinkSet, sourceNearestList, parameters.generalOptionsSet.crossCheck ? &sinkNearestList : NULL);
+	}
+	else if (parameters.generalOptionsSet.matcherMethod == GUIDED)
+	{
+		BuildGrid(sinkSet);
+		FindNearestByGuidedSearch(sourceSet, sinkSet, sourceNearestList, false);
+		if (parameters.generalOptionsSet.crossCheck)
+		{
+			BuildGrid(sourceSet);
+			FindNearestByGuidedSearch(sinkSet, sourceSet, sinkNearestList, true);
+		}
+	}
+	else
+	{
+		if (sampledBitsList.size() == 0)
+		{
+			SampleHashBits();
+		}
+		BuildHashTables(sinkSet);
+		FindNearestByHashing(sourceSet, sinkSet, sourceNearestList);
+		if (parameters.generalOptionsSet.crossCheck)
+		{
+			BuildHashTables(sourceSet);
+			FindNearestByHashing(sinkSet, sourceSet, sinkNearestList);
+		}
+	}
+
+	// Write data to output port
+	SelectMatches();
+}
+
+const int HammingMatcher::MAXIMUM_KEY_SIZE = 20;
+const unsigned HammingMatcher::HASH_SEED = 5489;
+
+HammingMatcher::MatcherMethodHelper::MatcherMethodHelper(const std::string& parameterName, MatcherMethod& boundVariable, const MatcherMethod& defaultValue) :
+	ParameterHelper(parameterName, boundVariable, defaultValue)
+{
+}
+
+HammingMatcher::MatcherMethod HammingMatcher::MatcherMethodHelper::Convert(const std::string& matcherMethod)
+{
+	if (matcherMethod == "BruteForce" || matcherMethod == "0")
+	{
+		return BRUTE_FORCE;
+	}
+	else if (matcherMethod == "MultiProbeLsh" || matcherMethod == "1")
+	{
+		return MULTI_PROBE_LSH;
+	}
+	else if (matcherMethod == "Guided" || matcherMethod == "2")
+	{
+		return GUIDED;
+	}
+	ASSERT(false, "HammingMatcher Configuration Error: matcher method has to be one of BruteForce, MultiProbeLsh or Guided");
+	return BRUTE_FORCE;
+}
+
+HammingMatcher::ConstraintTypeHelper::ConstraintTypeHelper(const std::string& parameterName, ConstraintType& boundVariable, const ConstraintType& defaultValue) :
+	ParameterHelper(parameterName, boundVariable, defaultValue)
+{
+}
+
+HammingMatcher::ConstraintType HammingMatcher::ConstraintTypeHelper::Convert(const std::string& constraintType)
+{
+	if (constraintType == "RowBand" || constraintType == "0")
+	{
+		return ROW_BAND;
+	}
+	else if (constraintType == "EpipolarLine" || constraintType == "1")
+	{
+		return EPIPOLAR_LINE;
+	}
+	else if (constraintType == "PredictedLocation" || constraintType == "2")
+	{
+		return PREDICTED_LOCATION;
+	}
+	ASSERT(false, "HammingMatcher Configuration Error: constraint type has to be one of RowBand, EpipolarLine or PredictedLocation");
+	return ROW_BAND;
+}
+
+const HammingMatcher::HammingMatcherOptionsSet HammingMatcher::DEFAULT_PARAMETERS =
+{
+	//.generalOptionsSet =
+	{
+		/*.matcherMethod =*/ BRUTE_FORCE,
+		/*.acceptanceRatio =*/ 0.8,
+		/*.maximumDistance =*/ 64,
+		/*.crossCheck =*/ true
+	},
+	//.localitySensitiveHashingOptionsSet =
+	{
+		/*.tableNumber =*/ 6,
+		/*.keySize =*/ 12,
+		/*.multiProbeLevel =*/ 1
+	},
+	//.guidedSearchOptionsSet =
+	{
+		/*.constraintType =*/ ROW_BAND,
+		/*.searchRadius =*/ 2,
+		/*.cellSize =*/ 32,
+		/*.predictedOffsetX =*/ 0,
+		/*.predictedOffsetY =*/ 0
+	},
+	/*.fundamentalMatrix =*/ {0, 0, 0, 0, 0, -1, 0, 1, 0}
+};
+
+/**
+ * The bytes of each descriptor are copied into 64 bit words, the last word is padded with zeros which do not change the distances.
+ */
+void HammingMatcher::PackDescriptors(const VisualPointFeatureVector2D& featuresVector, DescriptorsSet& descriptorsSet)
+{
+	descriptorsSet.numberOfDescriptors = GetNumberOfPoints(featuresVector);
+	descriptorsSet.words.assign(static_cast<size_t>(descriptorsSet.numberOfDescriptors) * numberOfWords, 0);
+	descriptorsSet.xList.resize(descriptorsSet.numberOfDescriptors);
+	descriptorsSet.yList.resize(descriptorsSet.numberOfDescriptors);
+
+	for (int pointIndex = 0; pointIndex < descriptorsSet.numberOfDescriptors; pointIndex++)
+	{
+		uint64_t* descriptor = descriptorsSet.words.data() + static_cast<size_t>(pointIndex) * numberOfWords;
+		std::memcpy(descriptor, GetBinaryDescriptor(featuresVector, pointIndex), GetNumberOfBinaryDescriptorBytes(featuresVector, pointIndex));
+		descriptorsSet.xList.at(pointIndex) = GetXCoordinate(featuresVector, pointIndex);
+		descriptorsSet.yList.at(pointIndex) = GetYCoordinate(featuresVector, pointIndex);
+	}
+}
+
+/**
+ * Each table samples keySize distinct bits of the descriptor, the fixed seed makes the matches repeatable.
+ */
+void HammingMatcher::SampleHashBits()
+{
+	const LocalitySensitiveHashingOptionsSet& hashing = parameters.localitySensitiveHashingOptionsSet;
+	std::mt19937 generator(HASH_SEED);
+	std::vector<int> bitsList(numberOfBits);
+	std::iota(bitsList.begin(), bitsList.end(), 0);
+
+	sampledBitsList.resize(hashing.tableNumber * hashing.keySize);
+	for (int table = 0; table < hashing.tableNumber; table++)
+	{
+		for (int keyBit = 0; keyBit < hashing.keySize; keyBit++)
+		{
+			std::uniform_int_distribution<int> distribution(keyBit, numberOfBits - 1);
+			std::swap(bitsList.at(keyBit), bitsList.at(distribution(generator)));
+			sampledBitsList.at(table * hashing.keySize + keyBit) = bitsList.at(keyBit);
+		}
+	}
+}
+
+/**
+ * The buckets of each table are stored contiguously: the descriptors are counted per key, the counts are turned into bucket starts,
+ * and the descriptors are placed at the starts which are then shifted back by one bucket.
+ */
+void HammingMatcher::BuildHashTables(DescriptorsSet& descriptorsSet)
+{
+	const int numberOfBuckets = 1 << parameters.localitySensitiveHashingOptionsSet.keySize;
+	const int tableNumber = parameters.localitySensitiveHashingOptionsSet.tableNumber;
+	const int numberOfDescriptors = descriptorsSet.numberOfDescriptors;
+	descriptorsSet.bucketStarts.assign(static_cast<size_t>(tableNumber) * (numberOfBuckets + 1), 0);
+	descriptorsSet.bucketEntries.resize(static_cast<size_t>(tableNumber) * numberOfDescriptors);
+
+	for (int table = 0; table < tableNumber; table++)
+	{
+		int* starts = descriptorsSet.bucketStarts.data() + static_cast<size_t>(table) * (numberOfBuckets + 1);
+		int* entries = descriptorsSet.bucketEntries.data() + static_cast<size_t>(table) * numberOfDescriptors;
+
+		for (int descriptorIndex = 0; descriptorIndex < numberOfDescriptors; descriptorIndex++)
+		{
+			starts[ ComputeKey(descriptorsSet.words.data() + static_cast<size_t>(descriptorIndex) * numberOfWords, table) + 1 ]++;
+		}
+		for (int key = 0; key < numberOfBuckets; key++)
+		{
+			starts[key + 1] += starts[key];
+		}
+		for (int descriptorIndex = 0; descriptorIndex < numberOfDescriptors; descriptorIndex++)
+		{
+			int key = ComputeKey(descriptorsSet.words.data() + static_cast<size_t>(descriptorIndex) * numberOfWords, table);
+			entries[ starts[key]++ ] = descriptorIndex;
+		}
+		for (int key = numberOfBuckets; key > 0; key--)
+		{
+			starts[key] = starts[key - 1];
+		}
+		starts[0] = 0;
+	}
+}
+
+int HammingMatcher::ComputeKey(const uint64_t* descriptor, int table)
+{
+	const int keySize = parameters.localitySensitiveHashingOptionsSet.keySize;
+	const int* sampledBits = sampledBitsList.data() + table * keySize;
+	int key = 0;
+	for (int keyBit = 0; keyBit < keySize; keyBit++)
+	{
+		int bit = sampledBits[keyBit];
+		key |= static_cast<int>( (descriptor[bit >> 6] >> (bit & 63)) & 1 ) << keyBit;
+	}
+	return key;
+}
+
+/**
+ * The probed keys are the key itself and the keys that differ from it in up to multiProbeLevel bits.
+ */
+void HammingMatcher::ComputeProbeKeys(int key)
+{
+	const int keySize = parameters.localitySensitiveHashingOptionsSet.keySize;
+	const int multiProbeLevel = parameters.localitySensitiveHashingOptionsSet.multiProbeLevel;
+	probeKeysList.clear();
+	probeKeysList.push_back(key);
+	for (int firstBit = 0; firstBit < keySize && multiProbeLevel >= 1; firstBit++)
+	{
+		probeKeysList.push_back(key ^ (1 << firstBit));
+		for (int secondBit = firstBit + 1; secondBit < keySize && multiProbeLevel >= 2; secondBit++)
+		{
+			probeKeysList.push_back(key ^ (1 << firstBit) ^ (1 << secondBit));
+		}
+	}
+}
+
+/**
+ * Each row of distances between a query and all searched descriptors also updates the nearest query of every searched descriptor, when the reverse list is requested,
+ * so that the cross check costs no further distance computation.
+ */
+void HammingMatcher::FindNearestByBruteForce(const DescriptorsSet& querySet, const DescriptorsSet& searchedSet, std::vector<NearestDescriptors>& nearestList,
+	std::vector<NearestDescriptors>* reverseNearestList)
+{
+	const NearestDescriptors noDescriptor = { -1, numberOfBits + 1, numberOfBits + 1 };
+	nearestList.assign(querySet.numberOfDescriptors, noDescriptor);
+	if (reverseNearestList != NULL)
+	{
+		reverseNearestList->assign(searchedSet.numberOfDescriptors, noDescriptor);
+	}
+	distancesList.resize(searchedSet.numberOfDescriptors);
+
+	for (int queryIndex = 0; queryIndex < querySet.numberOfDescriptors; queryIndex++)
+	{
+		const uint64_t* query = querySet.words.data() + static_cast<size_t>(queryIndex) * numberOfWords;
+		distancesFunction(query, searchedSet.words.data(), NULL, searchedSet.numberOfDescriptors, numberOfWords, distancesList.data());
+
+		NearestDescriptors& nearest = nearestList.at(queryIndex);
+		for (int searchedIndex = 0; searchedIndex < searchedSet.numberOfDescriptors; searchedIndex++)
+		{
+			int distance = distancesList[searchedIndex];
+			UpdateNearest(searchedIndex, distance, nearest.bestIndex, nearest.bestDistance, nearest.secondDistance);
+			if (reverseNearestList != NULL)
+			{
+				NearestDescriptors& reverseNearest = (*reverseNearestList)[searchedIndex];
+				UpdateNearest(queryIndex, distance, reverseNearest.bestIndex, reverseNearest.bestDistance, reverseNearest.secondDistance);
+			}
+		}
+	}
+}
+
+/**
+ * The candidates of a query are the searched descriptors that share a probed bucket with it in at least one table, only their distances are computed.
+ */
+void HammingMatcher::FindNearestByHashing(const DescriptorsSet& querySet, const DescriptorsSet& searchedSet, std::vector<NearestDescriptors>& nearestList)
+{
+	const int numberOfBuckets = 1 << parameters.localitySensitiveHashingOptionsSet.keySize;
+	const int tableNumber = parameters.localitySensitiveHashingOptionsSet.tableNumber;
+	const NearestDescriptors noDescriptor = { -1, numberOfBits + 1, numberOfBits + 1 };
+	nearestList.assign(querySet.numberOfDescriptors, noDescriptor);
+	candidateStamps.assign(searchedSet.numberOfDescriptors, -1);
+	distancesList.resize(searchedSet.numberOfDescriptors);
+
+	for (int queryIndex = 0; queryIndex < querySet.numberOfDescriptors; queryIndex++)
+	{
+		const uint64_t* query = querySet.words.data() + static_cast<size_t>(queryIndex) * numberOfWords;
+		candidatesList.clear();
+		for (int table = 0; table < tableNumber; table++)
+		{
+			const int* starts = searchedSet.bucketStarts.data() + static_cast<size_t>(table) * (numberOfBuckets + 1);
+			const int* entries = searchedSet.bucketEntries.data() + static_cast<size_t>(table) * searchedSet.numberOfDescriptors;
+			ComputeProbeKeys( ComputeKey(query, table) );
+			for (unsigned probeIndex = 0; probeIndex < probeKeysList.size(); probeIndex++)
+			{
+				int key = probeKeysList[probeIndex];
+				for (int entry = starts[key]; entry < starts[key + 1]; entry++)
+				{
+					int searchedIndex = entries[entry];
+					if (candidateStamps[searchedIndex] != queryIndex)
+					{
+						candidateStamps[searchedIndex] = queryIndex;
+						candidatesList.push_back(searchedIndex);
+					}
+				}
+			}
+		}
+
+		UpdateNearestCandidates(query, searchedSet, nearestList.at(queryIndex));
+	}
+}
+
+/**
+ * The grid covers the points from the origin to the largest coordinates, the cells are filled as the buckets of the hash tables.
+ */
+void HammingMatcher::BuildGrid(DescriptorsSet& descriptorsSet)
+{
+	const int cellSize = parameters.guidedSearchOptionsSet.cellSize;
+	float maximumX = 0;
+	float maximumY = 0;
+	for (int descriptorIndex = 0; descriptorIndex < descriptorsSet.numberOfDescriptors; descriptorIndex++)
+	{
+		maximumX = std::max(maximumX, descriptorsSet.xList[descriptorIndex]);
+		maximumY = std::max(maximumY, descriptorsSet.yList[descriptorIndex]);
+	}
+	descriptorsSet.gridColumns = static_cast<int>(maximumX) / cellSize + 1;
+	descriptorsSet.gridRows = static_cast<int>(maximumY) / cellSize + 1;
+	const int numberOfCells = descriptorsSet.gridColumns * descriptorsSet.gridRows;
+	descriptorsSet.cellStarts.assign(numberOfCells + 1, 0);
+	descriptorsSet.cellEntries.resize(descriptorsSet.numberOfDescriptors);
+
+	std::vector<int>& starts = descriptorsSet.cellStarts;
+	for (int descriptorIndex = 0; descriptorIndex < descriptorsSet.numberOfDescriptors; descriptorIndex++)
+	{
+		int cell = static_cast<int>(descriptorsSet.yList[descriptorIndex]) / cellSize * descriptorsSet.gridColumns + static_cast<int>(descriptorsSet.xList[descriptorIndex]) / cellSize;
+		starts[cell + 1]++;
+	}
+	for (int cell = 0; cell < numberOfCells; cell++)
+	{
+		starts[cell + 1] += starts[cell];
+	}
+	for (int descriptorIndex = 0; descriptorIndex < descriptorsSet.numberOfDescriptors; descriptorIndex++)
+	{
+		int cell = static_cast<int>(descriptorsSet.yList[descriptorIndex]) / cellSize * descriptorsSet.gridColumns + static_cast<int>(descriptorsSet.xList[descriptorIndex]) / cellSize;
+		descriptorsSet.cellEntries[ starts[cell]++ ] = descriptorIndex;
+	}
+	for (int cell = numberOfCells; cell > 0; cell--)
+	{
+		starts[cell] = starts[cell - 1];
+	}
+	starts[0] = 0;
+}
+
+/**
+ * When the query points are sink points, the epipolar line is given by the transposed fundamental matrix and the predicted offset is reversed.
+ */
+void HammingMatcher::FindNearestByGuidedSearch(const DescriptorsSet& querySet, const DescriptorsSet& searchedSet, std::vector<NearestDescriptors>& nearestList, bool fromSink)
+{
+	const GuidedSearchOptionsSet& guidedSearch = parameters.guidedSearchOptionsSet;
+	const double* F = parameters.fundamentalMatrix;
+	const NearestDescriptors noDescriptor = { -1, numberOfBits + 1, numberOfBits + 1 };
+	nearestList.assign(querySet.numberOfDescriptors, noDescriptor);
+	distancesList.resize(searchedSet.numberOfDescriptors);
+
+	for (int queryIndex = 0; queryIndex < querySet.numberOfDescriptors; queryIndex++)
+	{
+		float x = querySet.xList[queryIndex];
+		float y = querySet.yList[queryIndex];
+		candidatesList.clear();
+		if (guidedSearch.constraintType == ROW_BAND)
+		{
+			CollectLineCandidates(searchedSet, 0, 1, -y);
+		}
+		else if (guidedSearch.constraintType == EPIPOLAR_LINE && !fromSink)
+		{
+			CollectLineCandidates(searchedSet, F[0]*x + F[1]*y + F[2], F[3]*x + F[4]*y + F[5], F[6]*x + F[7]*y + F[8]);
+		}
+		else if (guidedSearch.constraintType == EPIPOLAR_LINE)
+		{
+			CollectLineCandidates(searchedSet, F[0]*x + F[3]*y + F[6], F[1]*x + F[4]*y + F[7], F[2]*x + F[5]*y + F[8]);
+		}
+		else
+		{
+			float direction = fromSink ? -1 : 1;
+			CollectDiskCandidates(searchedSet, x + direction * guidedSearch.predictedOffsetX, y + direction * guidedSearch.predictedOffsetY);
+		}
+
+		UpdateNearestCandidates(querySet.words.data() + static_cast<size_t>(queryIndex) * numberOfWords, searchedSet, nearestList.at(queryIndex));
+	}
+}
+
+/**
+ * The band of points within the search radius of the line a*x + b*y + c = 0 crosses a range of rows of cells, and within each row a range of columns of cells
+ * whose points are stored contiguously; the exact distance of each point in those cells is then checked.
+ */
+void HammingMatcher::CollectLineCandidates(const DescriptorsSet& searchedSet, double a, double b, double c)
+{
+	double norm = std::sqrt(a*a + b*b);
+	if (norm == 0)
+	{
+		return;
+	}
+	a /= norm;
+	b /= norm;
+	c /= norm;
+
+	const int cellSize = parameters.guidedSearchOptionsSet.cellSize;
+	const double searchRadius = parameters.guidedSearchOptionsSet.searchRadius;
+	const double width = searchedSet.gridColumns * cellSize;
+	const double height = searchedSet.gridRows * cellSize;
+
+	int firstRow = 0;
+	int lastRow = searchedSet.gridRows - 1;
+	if (b != 0)
+	{
+		double leftY = -c / b;
+		double rightY = -(a * width + c) / b;
+		double lowest = std::max( std::min(leftY, rightY) - searchRadius / std::abs(b), 0.0 );
+		double highest = std::min( std::max(leftY, rightY) + searchRadius / std::abs(b), height - 1 );
+		if (lowest > highest)
+		{
+			return;
+		}
+		firstRow = static_cast<int>(lowest) / cellSize;
+		lastRow = static_cast<int>(highest) / cellSize;
+	}
+
+	for (int row = firstRow; row <= lastRow; row++)
+	{
+		int firstColumn = 0;
+		int lastColumn = searchedSet.gridColumns - 1;
+		if (a != 0)
+		{
+			double topX = -(b * row * cellSize + c) / a;
+			double bottomX = -(b * (row + 1) * cellSize + c) / a;
+			double leftmost = std::max( std::min(topX, bottomX) - searchRadius / std::abs(a), 0.0 );
+			double rightmost = std::min( std::max(topX, bottomX) + searchRadius / std::abs(a), width - 1 );
+			if (leftmost > rightmost)
+			{
+				continue;
+			}
+			firstColumn = static_cast<int>(leftmost) / cellSize;
+			lastColumn = static_cast<int>(rightmost) / cellSize;
+		}
+
+		const int rowStart = row * searchedSet.gridColumns;
+		for (int entry = searchedSet.cellStarts[rowStart + firstColumn]; entry < searchedSet.cellStarts[rowStart + lastColumn + 1]; entry++)
+		{
+			int searchedIndex = searchedSet.cellEntries[entry];
+			if (std::abs(a * searchedSet.xList[searchedIndex] + b * searchedSet.yList[searchedIndex] + c) <= searchRadius)
+			{
+				candidatesList.push_back(searchedIndex);
+			}
+		}
+	}
+}
+
+void HammingMatcher::CollectDiskCandidates(const DescriptorsSet& searchedSet, float centerX, float centerY)
+{
+	const int cellSize = parameters.guidedSearchOptionsSet.cellSize;
+	const float searchRadius = parameters.guidedSearchOptionsSet.searchRadius;
+	if (centerX + searchRadius < 0 || centerY + searchRadius < 0)
+	{
+		return;
+	}
+
+	int firstColumn = static_cast<int>( std::max(centerX - searchRadius, 0.0f) ) / cellSize;
+	int lastColumn = std::min( static_cast<int>(centerX + searchRadius) / cellSize, searchedSet.gridColumns - 1 );
+	int firstRow = static_cast<int>( std::max(centerY - searchRadius, 0.0f) ) / cellSize;
+	int lastRow = std::min( static_cast<int>(centerY + searchRadius) / cellSize, searchedSet.gridRows - 1 );
+	for (int row = firstRow; row <= lastRow; row++)
+	{
+		for (int column = firstColumn; column <= lastColumn; column++)
+		{
+			int cell = row * searchedSet.gridColumns + column;
+			for (int entry = searchedSet.cellStarts[cell]; entry < searchedSet.cellStarts[cell + 1]; entry++)
+			{
+				int searchedIndex = searchedSet.cellEntries[entry];
+				float differenceX = searchedSet.xList[searchedIndex] - centerX;
+				float differenceY = searchedSet.yList[searchedIndex] - centerY;
+				if (differenceX * differenceX + differenceY * differenceY <= searchRadius * searchRadius)
+				{
+					candidatesList.push_back(searchedIndex);
+				}
+			}
+		}
+	}
+}
+
+void HammingMatcher::UpdateNearestCandidates(const uint64_t* query, const DescriptorsSet& searchedSet, NearestDescriptors& nearest)
+{
+	int numberOfCandidates = static_cast<int>( candidatesList.size() );
+	distancesFunction(query, searchedSet.words.data(), candidatesList.data(), numberOfCandidates, numberOfWords, distancesList.data());
+	for (int candidateIndex = 0; candidateIndex < numberOfCandidates; candidateIndex++)
+	{
+		UpdateNearest(candidatesList[candidateIndex], distancesList[candidateIndex], nearest.bestIndex, nearest.bestDistance, nearest.secondDistance);
+	}
+}
+
+/**
+ * A match without a second best candidate passes the ratio test. The probability of a match decreases linearly with its distance.
+ */
+void HammingMatcher::SelectMatches()
+{
+	for (int sourceIndex = 0; sourceIndex < sourceSet.numberOfDescriptors; sourceIndex++)
+	{
+		const NearestDescriptors& nearest = sourceNearestList.at(sourceIndex);
+		if (nearest.bestIndex < 0 || nearest.bestDistance > parameters.generalOptionsSet.maximumDistance)
+		{
+			continue;
+		}
+		if (nearest.secondDistance <= numberOfBits && nearest.bestDistance >= parameters.generalOptionsSet.acceptanceRatio * nearest.secondDistance)
+		{
+			continue;
+		}
+		if (parameters.generalOptionsSet.crossCheck && sinkNearestList.at(nearest.bestIndex).bestIndex != sourceIndex)
+		{
+			continue;
+		}
+
+		BaseTypesWrapper::Point2D sourcePoint, sinkPoint;
+		sourcePoint.x = GetXCoordinate(inSourceFeatures, sourceIndex);
+		sourcePoint.y = GetYCoordinate(inSourceFeatures, sourceIndex);
+		sinkPoint.x = GetXCoordinate(inSinkFeatures, nearest.bestIndex);
+		sinkPoint.y = GetYCoordinate(inSinkFeatures, nearest.bestIndex);
+		AddCorrespondence(outMatches, sourcePoint, sinkPoint, 1 - static_cast<float>(nearest.bestDistance) / numberOfBits);
+	}
+}
+
+HammingMatcher::DistancesFunction HammingMatcher::SelectDistancesFunction()
+{
+#ifdef HAMMING_HAVE_X86_SIMD
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+	{
+		return &ComputeDistancesAvx2;
+	}
+	if (__builtin_cpu_supports("popcnt"))
+	{
+		return &ComputeDistancesPopcnt;
+	}
+#endif
+	return &ComputeDistancesScalar;
+}
+
+void HammingMatcher::ValidateParameters()
+{
+	ASSERT(parameters.generalOptionsSet.acceptanceRatio >= 0 && parameters.generalOptionsSet.acceptanceRatio <= 1, "HammingMatcher Configuration Error: AcceptanceRatio has to be between 0 and 1");
+	ASSERT(parameters.generalOptionsSet.maximumDistance >= 0, "HammingMatcher Configuration Error: MaximumDistance cannot be negative");
+	if (parameters.generalOptionsSet.matcherMethod == MULTI_PROBE_LSH)
+	{
+		ASSERT(parameters.localitySensitiveHashingOptionsSet.tableNumber > 0, "HammingMatcher Configuration Error: TableNumber has to be positive");
+		ASSERT(parameters.localitySensitiveHashingOptionsSet.keySize > 0 && parameters.localitySensitiveHashingOptionsSet.keySize <= MAXIMUM_KEY_SIZE,
+			"HammingMatcher Configuration Error: KeySize has to be between 1 and 20");
+		ASSERT(parameters.localitySensitiveHashingOptionsSet.multiProbeLevel >= 0 && parameters.localitySensitiveHashingOptionsSet.multiProbeLevel <= 2,
+			"HammingMatcher Configuration Error: MultiProbeLevel has to be 0, 1 or 2");
+	}
+	if (parameters.generalOptionsSet.matcherMethod == GUIDED)
+	{
+		ASSERT(parameters.guidedSearchOptionsSet.searchRadius >= 0, "HammingMatcher Configuration Error: SearchRadius cannot be negative");
+		ASSERT(parameters.guidedSearchOptionsSet.cellSize > 0, "HammingMatcher Configuration Error: CellSize has to be positive");
+	}
+}
+
+void HammingMatcher::ValidateInputs()
+{
+	// The descriptor type comes first, the number of bytes of float descriptors is zero
+	ASSERT(GetDescriptorType(inSourceFeatures) == BINARY_DESCRIPTORS && GetDescriptorType(inSinkFeatures) == BINARY_DESCRIPTORS,
+		"HammingMatcher Error: input features do not have binary descriptors");
+	int numberOfBytes = GetNumberOfBinaryDescriptorBytes(inSourceFeatures, 0);
+	ASSERT(numberOfBytes > 0, "HammingMatcher Error: descriptors are empty");
+	if (numberOfBytes * 8 != numberOfBits)
+	{
+		numberOfBits = numberOfBytes * 8;
+		numberOfWords = (numberOfBytes + 7) / 8;
+		sampledBitsList.clear();
+	}
+
+	ValidateFeatures(inSourceFeatures);
+	ValidateFeatures(inSinkFeatures);
+	if (parameters.generalOptionsSet.matcherMethod == MULTI_PROBE_LSH)
+	{
+		ASSERT(parameters.localitySensitiveHashingOptionsSet.keySize <= numberOfBits, "HammingMatcher Error: KeySize is larger than the number of descriptor bits");
+	}
+}
+
+void HammingMatcher::ValidateFeatures(const VisualPointFeatureVector2D& featuresVector)
+{
+	for (int pointIndex = 0; pointIndex < GetNumberOfPoints(featuresVector); pointIndex++)
+	{
+		ASSERT(GetNumberOfBinaryDescriptorBytes(featuresVector, pointIndex) * 8 == numberOfBits, "HammingMatcher Error: descriptors do not have the same length");
+	}
+}
+
+}
+}
+}
+
+/** @} */
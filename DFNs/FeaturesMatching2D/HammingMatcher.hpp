@@ -0,0 +1,226 @@
+/**
+ * @author Alessandro Bianco
+ */
+
+/**
+ * @addtogroup DFNs
+ * @{
+ */
+
+#ifndef FEATURESMATCHING2D_HAMMINGMATCHER_HPP
+#define FEATURESMATCHING2D_HAMMINGMATCHER_HPP
+
+#include "FeaturesMatching2DInterface.hpp"
+
+#include <Types/CPP/VisualPointFeatureVector2D.hpp>
+#include <Types/CPP/CorrespondenceMap2D.hpp>
+#include <Helpers/ParametersListHelper.hpp>
+
+#include <vector>
+#include <cstdint>
+
+namespace CDFF
+{
+namespace DFN
+{
+namespace FeaturesMatching2D
+{
+	/**
+	 * 2D feature matching of binary descriptors (such as ORB or BRIEF) by Hamming distance, with a native implementation that does not depend on OpenCV.
+	 * Both input vectors have to hold binary descriptors of the same length.
+	 *
+	 * Processing steps: (i) packing of the descriptors into 64 bit words, (ii) search of the two nearest sink descriptors of each source descriptor, either by brute force,
+	 * among the candidates found by multi-probe locality sensitive hashing, or among the sink points that satisfy a geometric search constraint,
+	 * (iii) rejection of the matches that fail the ratio test or exceed the maximum distance, (iv) optionally, rejection of the matches whose source descriptor is not also
+	 * the nearest source descriptor of the sink descriptor. The distances are computed with AVX2 or POPCNT instructions on x86, chosen at run time.
+	 *
+	 * The guided search buckets the sink points into a grid of square cells and compares a source descriptor only with the sink points, in the cells crossed by
+	 * the constraint, that lie within the search radius of: the row of the source point (rectified stereo pairs), the epipolar line of the source point given by
+	 * a fundamental matrix F such that sink^T * F * source = 0, or the predicted location of the source point (temporal matching).
+	 *
+	 * @param generalParameters.matcherMethod
+	 *        method used for matching: BruteForce, MultiProbeLsh or Guided
+	 * @param generalParameters.acceptanceRatio
+	 *        a value between 0 and 1, a match is kept only if its distance is less than acceptanceRatio times the distance of the second best match
+	 * @param generalParameters.maximumDistance
+	 *        the maximum Hamming distance in bits of an accepted match
+	 * @param generalParameters.crossCheck
+	 *        whether a match is kept only if the source descriptor is also the nearest one to the sink descriptor
+	 *
+	 * @param localitySensitiveHashingOptionsSet.tableNumber
+	 *        the number of hash tables
+	 * @param localitySensitiveHashingOptionsSet.keySize
+	 *        the number of descriptor bits sampled by each hash table
+	 * @param localitySensitiveHashingOptionsSet.multiProbeLevel
+	 *        the maximum number of key bits flipped when probing the buckets neighbouring the bucket of a descriptor, 0, 1 or 2
+	 *
+	 * @param guidedSearchOptionsSet.constraintType
+	 *        the search constraint of the guided method: RowBand, EpipolarLine or PredictedLocation
+	 * @param guidedSearchOptionsSet.searchRadius
+	 *        the maximum distance in pixels of a sink point from the row, from the epipolar line, or from the predicted location of the source point
+	 * @param guidedSearchOptionsSet.cellSize
+	 *        the side in pixels of the grid cells
+	 * @param guidedSearchOptionsSet.predictedOffsetX
+	 *        the predicted displacement along x of the sink points with respect to the source points, for the PredictedLocation constraint
+	 * @param guidedSearchOptionsSet.predictedOffsetY
+	 *        the predicted displacement along y of the sink points with respect to the source points, for the PredictedLocation constraint
+	 * @param fundamentalMatrix
+	 *        the fundamental matrix for the EpipolarLine constraint: provide its elements via parameters called Element_X_Y, where X and Y are between 0 and 2
+	 *
+	 * @reference The multi-probe hashing follows Qin Lv, William Josephson, Zhe Wang, Moses Charikar and Kai Li (2007), "Multi-Probe LSH: Efficient Indexing
+	 *            for High-Dimensional Similarity Search", International Conference on Very Large Data Bases.
+	 */
+	class HammingMatcher : public FeaturesMatching2DInterface
+	{
+		public:
+
+			HammingMatcher();
+			virtual ~HammingMatcher();
+
+			virtual void configure() override;
+			virtual void process() override;
+
+		private:
+
+			static const int MAXIMUM_KEY_SIZE;
+			static const unsigned HASH_SEED;
+
+			//DFN Parameters
+			enum MatcherMethod
+			{
+				BRUTE_FORCE,
+				MULTI_PROBE_LSH,
+				GUIDED
+			};
+			class MatcherMethodHelper : public Helpers::ParameterHelper<MatcherMethod, std::string>
+			{
+				public:
+					MatcherMethodHelper(const std::string& parameterName, MatcherMethod& boundVariable, const MatcherMethod& defaultValue);
+				private:
+					MatcherMethod Convert(const std::string& value) override;
+			};
+
+			enum ConstraintType
+			{
+				ROW_BAND,
+				EPIPOLAR_LINE,
+				PREDICTED_LOCATION
+			};
+			class ConstraintTypeHelper : public Helpers::ParameterHelper<ConstraintType, std::string>
+			{
+				public:
+					ConstraintTypeHelper(const std::string& parameterName, ConstraintType& boundVariable, const ConstraintType& defaultValue);
+				private:
+					ConstraintType Convert(const std::string& value) override;
+			};
+
+			struct GeneralOptionsSet
+			{
+				MatcherMethod matcherMethod;
+				float acceptanceRatio;
+				int maximumDistance;
+				bool crossCheck;
+			};
+
+			struct LocalitySensitiveHashingOptionsSet
+			{
+				int tableNumber;
+				int keySize;
+				int multiProbeLevel;
+			};
+
+			struct GuidedSearchOptionsSet
+			{
+				ConstraintType constraintType;
+				float searchRadius;
+				int cellSize;
+				float predictedOffsetX;
+				float predictedOffsetY;
+			};
+
+			typedef double FundamentalMatrix[9];
+			struct HammingMatcherOptionsSet
+			{
+				GeneralOptionsSet generalOptionsSet;
+				LocalitySensitiveHashingOptionsSet localitySensitiveHashingOptionsSet;
+				GuidedSearchOptionsSet guidedSearchOptionsSet;
+				FundamentalMatrix fundamentalMatrix;
+			};
+
+			Helpers::ParametersListHelper parametersHelper;
+			HammingMatcherOptionsSet parameters;
+			static const HammingMatcherOptionsSet DEFAULT_PARAMETERS;
+
+			/**
+			 * Computes the Hamming distance between the query descriptor and each of the listed descriptors, all descriptors are numberOfWords 64 bit words long.
+			 * If indices is NULL the first numberOfDescriptors descriptors are used, otherwise the descriptors at the given indices.
+			 */
+			typedef void (*DistancesFunction)(const uint64_t* query, const uint64_t* descriptors, const int* indices, int numberOfDescriptors, int numberOfWords, int* distances);
+
+			//The packed descriptors and the points of one input vector and, for the hashing and guided methods, its hash tables and its grid;
+			//they are kept across calls so that no memory is allocated
+			struct DescriptorsSet
+			{
+				int numberOfDescriptors;
+				std::vector<uint64_t> words;
+				std::vector<float> xList;
+				std::vector<float> yList;
+				std::vector<int> bucketStarts; //for each table, the start of each bucket in bucketEntries, with one extra element at the end of each table
+				std::vector<int> bucketEntries; //for each table, the indices of the descriptors sorted by bucket
+				int gridColumns;
+				int gridRows;
+				std::vector<int> cellStarts; //the start of each cell in cellEntries, cells are stored row by row with one extra element at the end
+				std::vector<int> cellEntries; //the indices of the descriptors sorted by cell
+			};
+
+			//The best and second best distance of a query descriptor, and the index of the best descriptor
+			struct NearestDescriptors
+			{
+				int bestIndex;
+				int bestDistance;
+				int secondDistance;
+			};
+
+			DistancesFunction distancesFunction;
+			int numberOfBits;
+			int numberOfWords;
+			std::vector<int> sampledBitsList; //the descriptor bits sampled by each hash table, keySize bits per table
+			DescriptorsSet sourceSet;
+			DescriptorsSet sinkSet;
+			std::vector<NearestDescriptors> sourceNearestList;
+			std::vector<NearestDescriptors> sinkNearestList;
+			std::vector<int> distancesList;
+			std::vector<int> candidatesList;
+			std::vector<int> candidateStamps; //the last query that added each descriptor to the candidates, to avoid duplicates
+			std::vector<int> probeKeysList;
+
+			//Core computation methods
+			void PackDescriptors(const VisualPointFeatureVector2DWrapper::VisualPointFeatureVector2D& featuresVector, DescriptorsSet& descriptorsSet);
+			void SampleHashBits();
+			void BuildHashTables(DescriptorsSet& descriptorsSet);
+			int ComputeKey(const uint64_t* descriptor, int table);
+			void ComputeProbeKeys(int key);
+			void FindNearestByBruteForce(const DescriptorsSet& querySet, const DescriptorsSet& searchedSet, std::vector<NearestDescriptors>& nearestList,
+				std::vector<NearestDescriptors>* reverseNearestList);
+			void FindNearestByHashing(const DescriptorsSet& querySet, const DescriptorsSet& searchedSet, std::vector<NearestDescriptors>& nearestList);
+			void BuildGrid(DescriptorsSet& descriptorsSet);
+			void FindNearestByGuidedSearch(const DescriptorsSet& querySet, const DescriptorsSet& searchedSet, std::vector<NearestDescriptors>& nearestList, bool fromSink);
+			void CollectLineCandidates(const DescriptorsSet& searchedSet, double a, double b, double c);
+			void CollectDiskCandidates(const DescriptorsSet& searchedSet, float centerX, float centerY);
+			void UpdateNearestCandidates(const uint64_t* query, const DescriptorsSet& searchedSet, NearestDescriptors& nearest);
+			void SelectMatches();
+
+			static DistancesFunction SelectDistancesFunction();
+
+			//Input Validation methods
+			void ValidateParameters();
+			void ValidateInputs();
+			void ValidateFeatures(const VisualPointFeatureVector2DWrapper::VisualPointFeatureVector2D& featuresVector);
+	};
+}
+}
+}
+
+#endif // FEATURESMATCHING2D_HAMMINGMATCHER_HPP
+
+/** @} */
@@ -0,0 +1,36 @@
+/**
+ * @addtogroup DFNs
+ * @{
+ */
+
+#include "FeaturesTracking2DInterface.hpp"
+
+namespace CDFF
+{
+namespace DFN
+{
+
+FeaturesTracking2DInterface::FeaturesTracking2DInterface()
+{
+    asn1SccFrame_Initialize(&inFrame) ;
+    asn1SccCorrespondenceMap2D_Initialize(&outMatches) ;
+}
+
+FeaturesTracking2DInterface::~FeaturesTracking2DInterface()
+{
+}
+
+void FeaturesTracking2DInterface::frameInput(const asn1SccFrame& data)
+{
+    inFrame = data;
+}
+
+const asn1SccCorrespondenceMap2D& FeaturesTracking2DInterface::matchesOutput() const
+{
+    return outMatches;
+}
+
+}
+}
+
+/** @} */
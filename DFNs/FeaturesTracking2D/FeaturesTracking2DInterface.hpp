@@ -0,0 +1,49 @@
+/**
+ * @addtogroup DFNs
+ * @{
+ */
+
+#ifndef FEATURESTRACKING2D_FEATURESTRACKING2DINTERFACE_HPP
+#define FEATURESTRACKING2D_FEATURESTRACKING2DINTERFACE_HPP
+
+#include "DFNCommonInterface.hpp"
+#include <Types/C/Frame.h>
+#include <Types/C/CorrespondenceMap2D.h>
+
+namespace CDFF
+{
+namespace DFN
+{
+    /**
+     * DFN that tracks 2D keypoints from the previous image to the current one
+     */
+    class FeaturesTracking2DInterface : public DFNCommonInterface
+    {
+        public:
+
+            FeaturesTracking2DInterface();
+            virtual ~FeaturesTracking2DInterface();
+
+            /**
+             * Send value to input port "frame"
+             * @param frame: 2D image captured by a camera
+             */
+            virtual void frameInput(const asn1SccFrame& data);
+
+            /**
+             * Query value from output port "matches"
+             * @return matches: matches between the keypoints of the previous image (source) and their tracked positions in the current image (sink)
+             */
+            virtual const asn1SccCorrespondenceMap2D& matchesOutput() const;
+
+        protected:
+
+            asn1SccFrame inFrame;
+            asn1SccCorrespondenceMap2D outMatches;
+    };
+}
+}
+
+#endif // FEATURESTRACKING2D_FEATURESTRACKING2DINTERFACE_HPP
+
+/** @} */
@@ -0,0 +1,286 @@
+/**
+ * @author Alessandro Bianco
+ */
+
+/**
+ * @addtogroup DFNs
+ * @{
+ */
+
+#include "LucasKanadeTracker.hpp"
+
+#include <Errors/Assert.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Converters;
+using namespace CorrespondenceMap2DWrapper;
+
+namespace CDFF
+{
+namespace DFN
+{
+namespace FeaturesTracking2D
+{
+
+LucasKanadeTracker::LucasKanadeTracker()
+{
+	#define ADD_PARAMETER(type, groupName, parameterName, groupVariable, parameterVariable) \
+		parametersHelper.AddParameter<type>(groupName, parameterName, parameters.groupVariable.parameterVariable, DEFAULT_PARAMETERS.groupVariable.parameterVariable);
+
+	parameters = DEFAULT_PARAMETERS;
+
+	ADD_PARAMETER(int, "GeneralParameters", "MaximumFeaturesNumber", generalOptionsSet, maximumFeaturesNumber);
+
+	ADD_PARAMETER(int, "OpticalFlowParameters", "WindowSize", opticalFlowOptionsSet, windowSize);
+	ADD_PARAMETER(int, "OpticalFlowParameters", "PyramidLevels", opticalFlowOptionsSet, pyramidLevels);
+	ADD_PARAMETER(int, "OpticalFlowParameters", "MaximumIterations", opticalFlowOptionsSet, maximumIterations);
+	ADD_PARAMETER(double, "OpticalFlowParameters", "Epsilon", opticalFlowOptionsSet, epsilon);
+	ADD_PARAMETER(double, "OpticalFlowParameters", "MinimumEigenvalue", opticalFlowOptionsSet, minimumEigenvalue);
+	ADD_PARAMETER(float, "OpticalFlowParameters", "ForwardBackwardThreshold", opticalFlowOptionsSet, forwardBackwardThreshold);
+
+	ADD_PARAMETER(int, "DetectionParameters", "CellSize", detectionOptionsSet, cellSize);
+	ADD_PARAMETER(int, "DetectionParameters", "FeaturesPerCell", detectionOptionsSet, featuresPerCell);
+	ADD_PARAMETER(double, "DetectionParameters", "QualityLevel", detectionOptionsSet, qualityLevel);
+	ADD_PARAMETER(double, "DetectionParameters", "MinimumDistance", detectionOptionsSet, minimumDistance);
+	ADD_PARAMETER(int, "DetectionParameters", "BlockSize", detectionOptionsSet, blockSize);
+
+	configurationFilePath = "";
+}
+
+LucasKanadeTracker::~LucasKanadeTracker()
+{
+}
+
+void LucasKanadeTracker::configure()
+{
+	parametersHelper.ReadFile(configurationFilePath);
+	ValidateParameters();
+	ResetTracking();
+}
+
+void LucasKanadeTracker::process()
+{
+	ClearCorrespondences(outMatches);
+
+	// Read data from input port
+	cv::Mat inputImage = frameToMat.Convert(&inFrame);
+
+	// Process data
+	ValidateInputs(inputImage);
+	ConvertToGrey(inputImage);
+	if (previousPyramid.size() > 0 && previousPyramid.at(0).size() != greyImage.size())
+	{
+		ResetTracking();
+	}
+
+	const int windowSize = parameters.opticalFlowOptionsSet.windowSize;
+	cv::buildOpticalFlowPyramid(greyImage, currentPyramid, cv::Size(windowSize, windowSize), parameters.opticalFlowOptionsSet.pyramidLevels);
+
+	// Write data to output port, the matches are written while the keypoints are tracked
+	TrackPoints();
+	DetectNewPoints();
+
+	// The current image becomes the previous one
+	std::swap(previousPoints, trackedPoints);
+	std::swap(previousPyramid, currentPyramid);
+}
+
+const LucasKanadeTracker::LucasKanadeTrackerOptionsSet LucasKanadeTracker::DEFAULT_PARAMETERS =
+{
+	//.generalOptionsSet =
+	{
+		/*.maximumFeaturesNumber =*/ 500
+	},
+	//.opticalFlowOptionsSet =
+	{
+		/*.windowSize =*/ 21,
+		/*.pyramidLevels =*/ 3,
+		/*.maximumIterations =*/ 30,
+		/*.epsilon =*/ 0.01,
+		/*.minimumEigenvalue =*/ 1e-4,
+		/*.forwardBackwardThreshold =*/ 1.0
+	},
+	//.detectionOptionsSet =
+	{
+		/*.cellSize =*/ 40,
+		/*.featuresPerCell =*/ 2,
+		/*.qualityLevel =*/ 0.01,
+		/*.minimumDistance =*/ 10,
+		/*.blockSize =*/ 3
+	}
+};
+
+void LucasKanadeTracker::ConvertToGrey(cv::Mat inputImage)
+{
+	if (inputImage.type() == CV_8UC3)
+	{
+		cv::cvtColor(inputImage, greyImage, cv::COLOR_BGR2GRAY);
+	}
+	else
+	{
+		inputImage.copyTo(greyImage);
+	}
+}
+
+/**
+ * Only the keypoints found by the forward tracking are tracked back, starting from their initial positions. A keypoint is kept if the backward tracking succeeds,
+ * if it returns within the forward-backward threshold of its initial position, and if its tracked position lies inside the image. The probability of a match
+ * decreases with the forward-backward distance.
+ */
+void LucasKanadeTracker::TrackPoints()
+{
+	trackedPoints.clear();
+	if (previousPoints.size() == 0)
+	{
+		return;
+	}
+
+	const OpticalFlowOptionsSet& opticalFlowOptions = parameters.opticalFlowOptionsSet;
+	const cv::Size windowSize(opticalFlowOptions.windowSize, opticalFlowOptions.windowSize);
+	const cv::TermCriteria criteria(cv::TermCriteria::COUNT + cv::TermCriteria::EPS, opticalFlowOptions.maximumIterations, opticalFlowOptions.epsilon);
+	cv::calcOpticalFlowPyrLK(previousPyramid, currentPyramid, previousPoints, trackedPoints, forwardStatus, trackingErrors,
+		windowSize, opticalFlowOptions.pyramidLevels, criteria, 0, opticalFlowOptions.minimumEigenvalue);
+
+	int numberOfForwardPoints = 0;
+	for (unsigned pointIndex = 0; pointIndex < previousPoints.size(); pointIndex++)
+	{
+		if (forwardStatus.at(pointIndex))
+		{
+			previousPoints.at(numberOfForwardPoints) = previousPoints.at(pointIndex);
+			trackedPoints.at(numberOfForwardPoints) = trackedPoints.at(pointIndex);
+			numberOfForwardPoints++;
+		}
+	}
+	previousPoints.resize(numberOfForwardPoints);
+	trackedPoints.resize(numberOfForwardPoints);
+	if (numberOfForwardPoints == 0)
+	{
+		return;
+	}
+
+	backtrackedPoints.assign(previousPoints.begin(), previousPoints.end());
+	cv::calcOpticalFlowPyrLK(currentPyramid, previousPyramid, trackedPoints, backtrackedPoints, backwardStatus, trackingErrors,
+		windowSize, opticalFlowOptions.pyramidLevels, criteria, cv::OPTFLOW_USE_INITIAL_FLOW, opticalFlowOptions.minimumEigenvalue);
+
+	const float width = static_cast<float>(greyImage.cols);
+	const float height = static_cast<float>(greyImage.rows);
+	int numberOfKeptPoints = 0;
+	for (int pointIndex = 0; pointIndex < numberOfForwardPoints; pointIndex++)
+	{
+		const cv::Point2f& previousPoint = previousPoints.at(pointIndex);
+		const cv::Point2f& trackedPoint = trackedPoints.at(pointIndex);
+		const cv::Point2f difference = backtrackedPoints.at(pointIndex) - previousPoint;
+		const float forwardBackwardDistance = std::sqrt(difference.dot(difference));
+		if (!backwardStatus.at(pointIndex) || forwardBackwardDistance > opticalFlowOptions.forwardBackwardThreshold ||
+			trackedPoint.x < 0 || trackedPoint.y < 0 || trackedPoint.x >= width || trackedPoint.y >= height)
+		{
+			continue;
+		}
+
+		BaseTypesWrapper::Point2D sourcePoint, sinkPoint;
+		sourcePoint.x = previousPoint.x;
+		sourcePoint.y = previousPoint.y;
+		sinkPoint.x = trackedPoint.x;
+		sinkPoint.y = trackedPoint.y;
+		AddCorrespondence(outMatches, sourcePoint, sinkPoint, 1 / (1 + forwardBackwardDistance));
+
+		trackedPoints.at(numberOfKeptPoints) = trackedPoint;
+		numberOfKeptPoints++;
+	}
+	trackedPoints.resize(numberOfKeptPoints);
+}
+
+/**
+ * The tracked keypoints are counted in each grid cell, and Shi-Tomasi corners are detected on a mask that covers the cells holding fewer than featuresPerCell keypoints.
+ * The corners are then taken in order of quality while their cell holds fewer than featuresPerCell keypoints and the maximum number of features is not reached.
+ */
+void LucasKanadeTracker::DetectNewPoints()
+{
+	const DetectionOptionsSet& detectionOptions = parameters.detectionOptionsSet;
+	int availableFeatures = parameters.generalOptionsSet.maximumFeaturesNumber - static_cast<int>(trackedPoints.size());
+	if (availableFeatures <= 0)
+	{
+		return;
+	}
+
+	const int cellSize = detectionOptions.cellSize;
+	const int numberOfColumns = (greyImage.cols + cellSize - 1) / cellSize;
+	const int numberOfRows = (greyImage.rows + cellSize - 1) / cellSize;
+	cellCounts.assign(numberOfColumns * numberOfRows, 0);
+	for (unsigned pointIndex = 0; pointIndex < trackedPoints.size(); pointIndex++)
+	{
+		const cv::Point2f& point = trackedPoints.at(pointIndex);
+		cellCounts.at( static_cast<int>(point.y) / cellSize * numberOfColumns + static_cast<int>(point.x) / cellSize )++;
+	}
+
+	detectionMask.create(greyImage.size(), CV_8UC1);
+	detectionMask.setTo(0);
+	bool emptyCellFound = false;
+	for (int row = 0; row < numberOfRows; row++)
+	{
+		for (int column = 0; column < numberOfColumns; column++)
+		{
+			if (cellCounts.at(row * numberOfColumns + column) < detectionOptions.featuresPerCell)
+			{
+				const int cellX = column * cellSize;
+				const int cellY = row * cellSize;
+				detectionMask( cv::Rect(cellX, cellY, std::min(cellSize, greyImage.cols - cellX), std::min(cellSize, greyImage.rows - cellY)) ).setTo(255);
+				emptyCellFound = true;
+			}
+		}
+	}
+	if (!emptyCellFound)
+	{
+		return;
+	}
+
+	cv::goodFeaturesToTrack(greyImage, cornersList, 0, detectionOptions.qualityLevel, detectionOptions.minimumDistance, detectionMask, detectionOptions.blockSize);
+	for (unsigned cornerIndex = 0; cornerIndex < cornersList.size() && availableFeatures > 0; cornerIndex++)
+	{
+		const cv::Point2f& corner = cornersList.at(cornerIndex);
+		int& cellCount = cellCounts.at( static_cast<int>(corner.y) / cellSize * numberOfColumns + static_cast<int>(corner.x) / cellSize );
+		if (cellCount < detectionOptions.featuresPerCell)
+		{
+			trackedPoints.push_back(corner);
+			cellCount++;
+			availableFeatures--;
+		}
+	}
+}
+
+void LucasKanadeTracker::ResetTracking()
+{
+	previousPoints.clear();
+	previousPyramid.clear();
+}
+
+void LucasKanadeTracker::ValidateParameters()
+{
+	ASSERT(parameters.generalOptionsSet.maximumFeaturesNumber > 0 && parameters.generalOptionsSet.maximumFeaturesNumber <= MAX_CORRESPONDENCES_2D,
+		"LucasKanadeTracker Configuration Error: maximum features number has to be positive and not greater than the maximum number of 2D correspondences");
+	ASSERT(parameters.opticalFlowOptionsSet.windowSize >= 3, "LucasKanadeTracker Configuration Error: window size has to be at least 3");
+	ASSERT(parameters.opticalFlowOptionsSet.pyramidLevels >= 0, "LucasKanadeTracker Configuration Error: pyramid levels has to be non negative");
+	ASSERT(parameters.opticalFlowOptionsSet.maximumIterations > 0, "LucasKanadeTracker Configuration Error: maximum iterations has to be positive");
+	ASSERT(parameters.opticalFlowOptionsSet.epsilon > 0, "LucasKanadeTracker Configuration Error: epsilon has to be positive");
+	ASSERT(parameters.opticalFlowOptionsSet.minimumEigenvalue >= 0, "LucasKanadeTracker Configuration Error: minimum eigenvalue has to be non negative");
+	ASSERT(parameters.opticalFlowOptionsSet.forwardBackwardThreshold >= 0, "LucasKanadeTracker Configuration Error: forward backward threshold has to be non negative");
+	ASSERT(parameters.detectionOptionsSet.cellSize > 0, "LucasKanadeTracker Configuration Error: cell size has to be positive");
+	ASSERT(parameters.detectionOptionsSet.featuresPerCell > 0, "LucasKanadeTracker Configuration Error: features per cell has to be positive");
+	ASSERT(parameters.detectionOptionsSet.qualityLevel > 0 && parameters.detectionOptionsSet.qualityLevel < 1, "LucasKanadeTracker Configuration Error: quality level has to be in (0, 1)");
+	ASSERT(parameters.detectionOptionsSet.minimumDistance >= 0, "LucasKanadeTracker Configuration Error: minimum distance has to be non negative");
+	ASSERT(parameters.detectionOptionsSet.blockSize > 0, "LucasKanadeTracker Configuration Error: block size has to be positive");
+}
+
+void LucasKanadeTracker::ValidateInputs(cv::Mat inputImage)
+{
+	ASSERT(inputImage.type() == CV_8UC3 || inputImage.type() == CV_8UC1, "LucasKanadeTracker Error: input image is not of type CV_8UC3 or CV_8UC1");
+	ASSERT(inputImage.rows > 0 && inputImage.cols > 0, "LucasKanadeTracker Error: input image is empty");
+}
+
+}
+}
+}
+
+/** @} */
@@ -0,0 +1,153 @@
+/**
+ * @author Alessandro Bianco
+ */
+
+/**
+ * @addtogroup DFNs
+ * @{
+ */
+
+#ifndef FEATURESTRACKING2D_LUCASKANADETRACKER_HPP
+#define FEATURESTRACKING2D_LUCASKANADETRACKER_HPP
+
+#include "FeaturesTracking2DInterface.hpp"
+
+#include <Types/CPP/Frame.hpp>
+#include <Types/CPP/CorrespondenceMap2D.hpp>
+#include <Converters/FrameToMatConverter.hpp>
+#include <Helpers/ParametersListHelper.hpp>
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+#include <opencv2/video/tracking.hpp>
+
+#include <vector>
+
+namespace CDFF
+{
+namespace DFN
+{
+namespace FeaturesTracking2D
+{
+	/**
+	 * Tracking of 2D keypoints from the previous image to the current one with the pyramidal Lucas-Kanade optical flow (provided by OpenCV),
+	 * as a cheap alternative to the detection, description and matching of keypoints on every image.
+	 *
+	 * Processing steps: (i) construction of the image pyramid of the current image, (ii) tracking of the keypoints of the previous image into the current image,
+	 * (iii) tracking of the found keypoints back into the previous image, a keypoint is kept only if it lands close to where it started (forward-backward check),
+	 * (iv) detection of new Shi-Tomasi corners only in the cells of a regular grid that hold too few tracked keypoints, the new corners are tracked from the next image on.
+	 * The output matches go from the keypoints of the previous image (source) to their positions in the current image (sink), there are no matches on the first image.
+	 * The pyramid of an image is kept and used again as the previous pyramid for the next image.
+	 *
+	 * @param generalParameters.maximumFeaturesNumber
+	 *        the maximum number of keypoints tracked at the same time
+	 *
+	 * @param opticalFlowParameters.windowSize
+	 *        the side in pixels of the square window tracked at each pyramid level
+	 * @param opticalFlowParameters.pyramidLevels
+	 *        the number of pyramid levels above the full resolution image
+	 * @param opticalFlowParameters.maximumIterations
+	 *        the maximum number of iterations of the search at each pyramid level
+	 * @param opticalFlowParameters.epsilon
+	 *        the search at a pyramid level stops when the window moves by less than epsilon pixels
+	 * @param opticalFlowParameters.minimumEigenvalue
+	 *        a keypoint is lost when the minimum eigenvalue of the gradient matrix of its window, divided by the number of pixels in the window, is below this threshold
+	 * @param opticalFlowParameters.forwardBackwardThreshold
+	 *        the maximum distance in pixels between a keypoint of the previous image and the position found by tracking it forward and then back
+	 *
+	 * @param detectionParameters.cellSize
+	 *        the side in pixels of the grid cells
+	 * @param detectionParameters.featuresPerCell
+	 *        new corners are detected only in the cells that hold fewer tracked keypoints than this number, and up to this number
+	 * @param detectionParameters.qualityLevel
+	 *        a corner is kept if its minimum eigenvalue is at least qualityLevel times the best one in the searched cells
+	 * @param detectionParameters.minimumDistance
+	 *        the minimum distance in pixels between two new corners
+	 * @param detectionParameters.blockSize
+	 *        the side of the window on which the gradient matrix of a corner is computed
+	 *
+	 * @reference The forward-backward check follows Zdenek Kalal, Krystian Mikolajczyk and Jiri Matas (2010), "Forward-Backward Error: Automatic Detection
+	 *            of Tracking Failures", International Conference on Pattern Recognition.
+	 */
+	class LucasKanadeTracker : public FeaturesTracking2DInterface
+	{
+		public:
+
+			LucasKanadeTracker();
+			virtual ~LucasKanadeTracker();
+
+			virtual void configure() override;
+			virtual void process() override;
+
+		private:
+
+			//DFN Parameters
+			struct GeneralOptionsSet
+			{
+				int maximumFeaturesNumber;
+			};
+
+			struct OpticalFlowOptionsSet
+			{
+				int windowSize;
+				int pyramidLevels;
+				int maximumIterations;
+				double epsilon;
+				double minimumEigenvalue;
+				float forwardBackwardThreshold;
+			};
+
+			struct DetectionOptionsSet
+			{
+				int cellSize;
+				int featuresPerCell;
+				double qualityLevel;
+				double minimumDistance;
+				int blockSize;
+			};
+
+			struct LucasKanadeTrackerOptionsSet
+			{
+				GeneralOptionsSet generalOptionsSet;
+				OpticalFlowOptionsSet opticalFlowOptionsSet;
+				DetectionOptionsSet detectionOptionsSet;
+			};
+
+			Helpers::ParametersListHelper parametersHelper;
+			LucasKanadeTrackerOptionsSet parameters;
+			static const LucasKanadeTrackerOptionsSet DEFAULT_PARAMETERS;
+
+			//The state carried from the previous image, and the buffers that are kept across calls so that no memory is allocated when the image size does not change
+			cv::Mat greyImage;
+			std::vector<cv::Mat> previousPyramid;
+			std::vector<cv::Mat> currentPyramid;
+			std::vector<cv::Point2f> previousPoints; //the keypoints of the previous image, tracked into the current image
+			std::vector<cv::Point2f> trackedPoints;
+			std::vector<cv::Point2f> backtrackedPoints;
+			std::vector<uchar> forwardStatus;
+			std::vector<uchar> backwardStatus;
+			std::vector<float> trackingErrors;
+			std::vector<int> cellCounts; //the number of keypoints in each grid cell, row by row
+			cv::Mat detectionMask;
+			std::vector<cv::Point2f> cornersList;
+
+			//External conversion helpers
+			Converters::FrameToMatConverter frameToMat;
+
+			//Core computation methods
+			void ConvertToGrey(cv::Mat inputImage);
+			void TrackPoints();
+			void DetectNewPoints();
+			void ResetTracking();
+
+			//Input Validation methods
+			void ValidateParameters();
+			void ValidateInputs(cv::Mat inputImage);
+	};
+}
+}
+}
+
+#endif // FEATURESTRACKING2D_LUCASKANADETRACKER_HPP
+
+/** @} */
@@ -12,10 +12,10 @@
 #include <Macros/YamlcppMacros.hpp>
 #include <Errors/Assert.hpp>
 
-#include <opencv2/calib3d.hpp>
-
 #include <stdlib.h>
 #include <fstream>
+#include <cfloat>
+#include <cmath>
 
 using namespace MatrixWrapper;
 using namespace CorrespondenceMap2DWrapper;
@@ -35,6 +35,10 @@ FundamentalMatrixRansac::FundamentalMatrixRansac()
 	parametersHelper.AddParameter<double>("GeneralParameters", "OutlierThreshold", parameters.outlierThreshold, DEFAULT_PARAMETERS.outlierThreshold);
 	parametersHelper.AddParameter<double>("GeneralParameters", "Confidence", parameters.confidence, DEFAULT_PARAMETERS.confidence);
 	parametersHelper.AddParameter<double>("GeneralParameters", "MaximumSymmetricEpipolarDistance", parameters.maximumSymmetricEpipolarDistance, DEFAULT_PARAMETERS.maximumSymmetricEpipolarDistance);
+	parametersHelper.AddParameter<int>("GeneralParameters", "MaximumIterations", parameters.maximumIterations, DEFAULT_PARAMETERS.maximumIterations);
+	parametersHelper.AddParameter<bool>("GeneralParameters", "UseProsac", parameters.useProsac, DEFAULT_PARAMETERS.useProsac);
+	parametersHelper.AddParameter<bool>("GeneralParameters", "UseSprt", parameters.useSprt, DEFAULT_PARAMETERS.useSprt);
+	parametersHelper.AddParameter<int>("GeneralParameters", "NumberOfThreads", parameters.numberOfThreads, DEFAULT_PARAMETERS.numberOfThreads);
 
 	configurationFilePath = "";
 }
@@ -133,29 +137,55 @@ const FundamentalMatrixRansac::FundamentalMatrixRansacOptionsSet FundamentalMatr
 {
 	/*.outlierThreshold =*/ 1.3,
 	/*.confidence =*/ 0.99,
-	/*.maximumSymmetricEpipolarDistance =*/ 1.3
+	/*.maximumSymmetricEpipolarDistance =*/ 1.3,
+	/*.maximumIterations =*/ 2000,
+	/*.useProsac =*/ true,
+	/*.useSprt =*/ true,
+	/*.numberOfThreads =*/ 0
 };
 
+/**
+ * The probabilities of the input correspondences are the PROSAC scores. The error of a correspondence is its squared Sampson distance, so it is compared with
+ * the square of the outlier threshold. As in OpenCV, the matrix is scaled so that its last element is one, unless it is close to zero.
+ */
 cv::Mat FundamentalMatrixRansac::ComputeFundamentalMatrix(const std::vector<cv::Point2d>& firstImagePointsVector, const std::vector<cv::Point2d>& secondImagePointsVector)
 {
-	static const int METHOD = CV_FM_RANSAC;
+	fundamentalMatrixProblem.ClearCorrespondences();
+	std::vector<float> scoresList;
+	for (unsigned pointIndex = 0; pointIndex < firstImagePointsVector.size(); pointIndex++)
+	{
+		const cv::Point2d& firstPoint = firstImagePointsVector.at(pointIndex);
+		const cv::Point2d& secondPoint = secondImagePointsVector.at(pointIndex);
+		fundamentalMatrixProblem.AddCorrespondence(firstPoint.x, firstPoint.y, secondPoint.x, secondPoint.y);
+		scoresList.push_back( GetProbability(inMatches, pointIndex) );
+	}
 
-	cv::Mat fundamentalMatrix = cv::findFundamentalMat(
-		firstImagePointsVector,
-		secondImagePointsVector,
-		METHOD,
-		parameters.outlierThreshold,
-		parameters.confidence
-	);
+	RobustEstimation::RobustEstimator::Options options = RobustEstimation::RobustEstimator::DEFAULT_OPTIONS;
+	options.inlierThreshold = parameters.outlierThreshold * parameters.outlierThreshold;
+	options.confidence = parameters.confidence;
+	options.maximumIterations = parameters.maximumIterations;
+	options.useProsac = parameters.useProsac;
+	options.useSprt = parameters.useSprt;
+	options.numberOfThreads = parameters.numberOfThreads;
+	robustEstimator.SetOptions(options);
+
+	std::vector<double> model;
+	std::vector<int> inliersList;
+	if (!robustEstimator.Estimate(fundamentalMatrixProblem, scoresList, model, inliersList))
+	{
+		return cv::Mat();
+	}
 
-	if (fundamentalMatrix.rows > 3 && fundamentalMatrix.cols > 3)
-		{
-		return fundamentalMatrix(cv::Rect(0, 0, 3, 3));
-		}
-	else
+	cv::Mat fundamentalMatrix(3, 3, CV_64FC1);
+	const double scale = std::abs(model.at(8)) > FLT_EPSILON ? 1 / model.at(8) : 1;
+	for (int rowIndex = 0; rowIndex < 3; rowIndex++)
+	{
+		for (int columnIndex = 0; columnIndex < 3; columnIndex++)
 		{
-		return fundamentalMatrix;
+			fundamentalMatrix.at<double>(rowIndex, columnIndex) = scale * model.at(3 * rowIndex + columnIndex);
 		}
+	}
+	return fundamentalMatrix;
 }
 
 /**
@@ -218,6 +248,8 @@ void FundamentalMatrixRansac::ValidateParameters()
 	ASSERT(parameters.outlierThreshold >= 0, "FundamentalMatrixRansac Configuration Error: outlierThreshold is negative");
 	ASSERT(parameters.confidence >= 0 && parameters.confidence <= 1, "FundamentalMatrixRansac Configuration Error: confidence should be a probability value between 0 and 1");
 	ASSERT(parameters.maximumSymmetricEpipolarDistance >= 0, "FundamentalMatrixRansac Configuration Error: maximumSymmetricEpipolarDistance is negative");
+	ASSERT(parameters.maximumIterations > 0, "FundamentalMatrixRansac Configuration Error: maximumIterations is not positive");
+	ASSERT(parameters.numberOfThreads >= 0, "FundamentalMatrixRansac Configuration Error: numberOfThreads is negative");
 }
 
 void FundamentalMatrixRansac::ValidateInputs(const std::vector<cv::Point2d>& firstImagePointsVector, const std::vector<cv::Point2d>& secondImagePointsVector)
@@ -16,6 +16,8 @@
 #include <Types/CPP/Matrix.hpp>
 #include <Types/CPP/BaseTypes.hpp>
 #include <Helpers/ParametersListHelper.hpp>
+#include <RobustEstimation/RobustEstimator.hpp>
+#include <RobustEstimation/FundamentalMatrixProblem.hpp>
 
 #include <opencv2/core/core.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
@@ -29,12 +31,16 @@ namespace FundamentalMatrixComputation
 {
 	/**
 	 * Estimation of the fundamental matrix of a camera pair from a set of 2D
-	 * keypoint pairs, using RANSAC (RANdom SAmple Consensus, provided by
-	 * OpenCV).
+	 * keypoint pairs, using RANSAC (RANdom SAmple Consensus) on samples of
+	 * seven keypoint pairs. The samples are drawn first from the pairs with
+	 * the highest probability (PROSAC), the models are verified with a
+	 * sequential probability ratio test (SPRT) and the number of iterations
+	 * adapts to the inlier ratio of the best model.
 	 *
 	 * @param outlierThreshold
 	 *        Pixel distance that determines whether an input point (a keypoint
-	 *        pair, in our case) is an outlier in the RANSAC model.
+	 *        pair, in our case) is an outlier in the RANSAC model, it is
+	 *        compared with the Sampson distance of the pair.
 	 *        Recommended values: 1, 2, and 3.
 	 * @param confidence
 	 *        Lowest accepted value for the probability that a RANSAC model
@@ -42,6 +48,16 @@ namespace FundamentalMatrixComputation
 	 * @param maximumSymmetricEpipolarDistance
 	 *	  Lowest accepted symmetric epipolar distance error to accept
 	 *	  a correspondence as an inlier.
+	 * @param maximumIterations
+	 *        Maximum number of samples drawn by RANSAC.
+	 * @param useProsac
+	 *        Whether the samples are drawn first from the keypoint pairs with
+	 *        the highest probability.
+	 * @param useSprt
+	 *        Whether the models are rejected early by the SPRT.
+	 * @param numberOfThreads
+	 *        Number of threads that draw and verify the samples, 0 means the
+	 *        number of hardware threads.
 	 */
 	class FundamentalMatrixRansac : public FundamentalMatrixComputationInterface
 	{
@@ -60,12 +76,19 @@ namespace FundamentalMatrixComputation
 				double outlierThreshold; // in pixels
 				double confidence;       // probability value (in [0,1])
 				double maximumSymmetricEpipolarDistance; //in pixels
+				int maximumIterations;
+				bool useProsac;
+				bool useSprt;
+				int numberOfThreads;
 			};
 
 			Helpers::ParametersListHelper parametersHelper;
 			FundamentalMatrixRansacOptionsSet parameters;
 			static const FundamentalMatrixRansacOptionsSet DEFAULT_PARAMETERS;
 
+			RobustEstimation::FundamentalMatrixProblem fundamentalMatrixProblem;
+			RobustEstimation::RobustEstimator robustEstimator;
+
 			cv::Mat ComputeFundamentalMatrix(
 				const std::vector<cv::Point2d>& firstImagePointsVector,
 				const std::vector<cv::Point2d>& secondImagePointsVector);
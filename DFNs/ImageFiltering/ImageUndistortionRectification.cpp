@@ -35,6 +35,8 @@ ImageUndistortionRectification::ImageUndistortionRectification()
 	parametersHelper.AddParameter<InterpolationMethod, InterpolationMethodHelper>("GeneralParameters", "InterpolationMethod", parameters.interpolationMethod, DEFAULT_PARAMETERS.interpolationMethod);
 	parametersHelper.AddParameter<CameraConfigurationMode, CameraConfigurationModeHelper>("GeneralParameters", "CameraConfigurationMode", parameters.cameraConfigurationMode, DEFAULT_PARAMETERS.cameraConfigurationMode);
 	parametersHelper.AddParameter<BorderMode, BorderModeHelper>("GeneralParameters", "BorderMode", parameters.borderMode, DEFAULT_PARAMETERS.borderMode);
+	parametersHelper.AddParameter<bool>("GeneralParameters", "FixedPointMaps", parameters.fixedPointMaps, DEFAULT_PARAMETERS.fixedPointMaps);
+	parametersHelper.AddParameter<bool>("GeneralParameters", "Grayscale", parameters.grayscale, DEFAULT_PARAMETERS.grayscale);
 
 	parametersHelper.AddParameter<float>("CameraMatrix", "FocalLengthX", parameters.cameraMatrix.focalLengthX, DEFAULT_PARAMETERS.cameraMatrix.focalLengthX);
 	parametersHelper.AddParameter<float>("CameraMatrix", "FocalLengthY", parameters.cameraMatrix.focalLengthY, DEFAULT_PARAMETERS.cameraMatrix.focalLengthY);
@@ -87,6 +89,10 @@ void ImageUndistortionRectification::configure()
 	{
 		LoadUndistortionRectificationMaps();
 	}
+	if (parameters.fixedPointMaps)
+	{
+		ConvertMapsToFixedPoint();
+	}
 	ValidateParameters();
 }
 
@@ -97,7 +103,7 @@ void ImageUndistortionRectification::process()
 
 	// Process data
 	ValidateInputs(inputImage);
-	cv::Mat filteredImage = UndistortAndRectify(inputImage);
+	cv::Mat filteredImage = UndistortAndRectify(inputImage, GetFrameMode(inImage));
 
 	// Write data to output port
 	FrameConstPtr tmp = matToFrame.Convert(filteredImage);
@@ -182,6 +188,8 @@ const ImageUndistortionRectification::ImageUndistortionRectificationOptionsSet I
 	/*.constantBorderValue =*/ 0,
 	/*.transformMapsFilePath =*/ "../../tests/ConfigurationFiles/DFNs/ImageFiltering/ImageUndistortionRectificationTransformMapsRight.yaml",
 	/*.cameraConfigurationMode =*/ EXTERNAL_RECTIFICATION_TRANSFORM,
+	/*.fixedPointMaps =*/ true,
+	/*.grayscale =*/ false,
 	//.cameraMatrix =
 	{
 		/*.focalLengthX =*/ 1,
@@ -276,7 +284,23 @@ void ImageUndistortionRectification::LoadUndistortionRectificationMaps()
 	file.release();
 }
 
-cv::Mat ImageUndistortionRectification::UndistortAndRectify(cv::Mat inputImage)
+void ImageUndistortionRectification::ConvertMapsToFixedPoint()
+{
+	// Maps that are already packed, for example when loaded from file, are kept as they are
+	if (transformMap1.type() != CV_32FC1 || transformMap2.type() != CV_32FC1)
+	{
+		return;
+	}
+
+	cv::Mat fixedPointMap1, fixedPointMap2;
+	bool nearestNeighbourOnly = (parameters.interpolationMethod == NEAREST);
+	cv::convertMaps(transformMap1, transformMap2, fixedPointMap1, fixedPointMap2, CV_16SC2, nearestNeighbourOnly);
+	// Nearest neighbour remapping needs no interpolation table, cv::remap accepts an empty second map with a CV_16SC2 first map
+	transformMap1 = fixedPointMap1;
+	transformMap2 = nearestNeighbourOnly ? cv::Mat() : fixedPointMap2;
+}
+
+cv::Mat ImageUndistortionRectification::UndistortAndRectify(cv::Mat inputImage, FrameMode mode)
 {
 	int borderMode;
 	switch(parameters.borderMode)
@@ -297,6 +321,14 @@ cv::Mat ImageUndistortionRectification::UndistortAndRectify(cv::Mat inputImage)
 		default: ASSERT(false, "ImageUndistortionRectification: Unhandled interpolation method");
 	}
 
+	// The color conversion comes first, so that the remap moves a single channel
+	if (parameters.grayscale && inputImage.channels() == 3)
+	{
+		cv::Mat grayImage;
+		cv::cvtColor(inputImage, grayImage, mode == MODE_RGB ? cv::COLOR_RGB2GRAY : cv::COLOR_BGR2GRAY);
+		inputImage = grayImage;
+	}
+
 	cv::Mat filteredImage;
 	cv::remap(inputImage, filteredImage, transformMap1, transformMap2, interpolationMethod, borderMode, parameters.constantBorderValue);
 
@@ -306,7 +338,7 @@ cv::Mat ImageUndistortionRectification::UndistortAndRectify(cv::Mat inputImage)
 void ImageUndistortionRectification::ValidateParameters()
 {
 	ASSERT(transformMap1.cols > 0 && transformMap1.rows > 0, "Image Undistortion error: transformMap1 is empty");
-	ASSERT(transformMap1.size() == transformMap2.size(), "Image Undistortion error: transformMap1 size does not match transformMap2 size");
+	ASSERT(transformMap2.empty() ? transformMap1.type() == CV_16SC2 : transformMap1.size() == transformMap2.size(), "Image Undistortion error: transformMap1 size does not match transformMap2 size");
 
 	ASSERT(parameters.cameraMatrix.focalLengthX > 0 && parameters.cameraMatrix.focalLengthY > 0, "Image Undistortion Configuration error: focal length has to be positive");
 	ASSERT(!parameters.distortionParametersSet.useK4ToK6 || parameters.distortionParametersSet.useK3, "Image Undistortion Configuration error: cannot use K4,K5,K6 without K3");
@@ -21,6 +21,8 @@ ImageRectification::ImageRectification()
     parametersHelper.AddParameter<double>("ImageRectificationParams", "scaling", parameters.scaling, DEFAULT_PARAMETERS.scaling);
     parametersHelper.AddParameter<bool>("ImageRectificationParams", "centerPrincipalPoint", parameters.centerPrincipalPoint, DEFAULT_PARAMETERS.centerPrincipalPoint);
     parametersHelper.AddParameter<bool>("ImageRectificationParams", "fisheye", parameters.fisheye, DEFAULT_PARAMETERS.fisheye);
+    parametersHelper.AddParameter<bool>("ImageRectificationParams", "fixedPointMaps", parameters.fixedPointMaps, DEFAULT_PARAMETERS.fixedPointMaps);
+    parametersHelper.AddParameter<bool>("ImageRectificationParams", "grayscale", parameters.grayscale, DEFAULT_PARAMETERS.grayscale);
 
     configurationFilePath = "";
 }
@@ -48,13 +50,15 @@ void ImageRectification::process()
             parameters.yratio != _yratio ||
             parameters.scaling != _scaling ||
             parameters.centerPrincipalPoint != _centerPrincipalPoint ||
-            parameters.fisheye != _fisheye){
+            parameters.fisheye != _fisheye ||
+            parameters.fixedPointMaps != _fixedPointMaps){
         _sensorId = std::string(reinterpret_cast<char const *>(inOriginalImage.intrinsic.sensorId.arr));
         _xratio = parameters.xratio;
         _yratio = parameters.yratio;
         _scaling = parameters.scaling;
         _centerPrincipalPoint =parameters.centerPrincipalPoint;
         _fisheye = parameters.fisheye;
+        _fixedPointMaps = parameters.fixedPointMaps;
 
         cv::Mat1d cameraMatrix(3,3, Eigen::Map<Eigen::Matrix3d>(inOriginalImage.intrinsic.cameraMatrix.arr[0].arr, 3, 3).data());
 
@@ -68,9 +72,33 @@ void ImageRectification::process()
             _newCameraMatrix = cv::getOptimalNewCameraMatrix(cameraMatrix, distCoeffs, cv::Size(in.cols, in.rows), _scaling, cv::Size(in.cols / _xratio, in.rows / _yratio), 0, _centerPrincipalPoint);
             cv::initUndistortRectifyMap(cameraMatrix, distCoeffs, cv::Mat(), _newCameraMatrix, cv::Size(in.cols / _xratio, in.rows / _yratio), CV_32F, _mapx, _mapy);
         }
+
+        // The maps are packed once, each remap then reads 6 bytes per pixel instead of 8
+        if(_fixedPointMaps){
+            cv::Mat map1;
+            cv::Mat map2;
+            cv::convertMaps(_mapx, _mapy, map1, map2, CV_16SC2);
+            _mapx = map1;
+            _mapy = map2;
+        }
     }
 
-    cv::remap(in, out, _mapx, _mapy, cv::INTER_LINEAR);
+    // The color conversion comes first, so that the remap moves a single channel
+    if(parameters.grayscale && in.channels() > 1){
+        cv::Mat gray;
+        int code;
+        switch(inOriginalImage.metadata.mode){
+            case asn1Sccmode_RGB: code = cv::COLOR_RGB2GRAY; break;
+            case asn1Sccmode_RGBA: code = cv::COLOR_RGBA2GRAY; break;
+            case asn1Sccmode_BGRA: code = cv::COLOR_BGRA2GRAY; break;
+            default: code = (in.channels() == 4) ? cv::COLOR_BGRA2GRAY : cv::COLOR_BGR2GRAY; break;
+        }
+        cv::cvtColor(in, gray, code);
+        cv::remap(gray, out, _mapx, _mapy, cv::INTER_LINEAR);
+    }
+    else{
+        cv::remap(in, out, _mapx, _mapy, cv::INTER_LINEAR);
+    }
 
     // Getting image
     {
@@ -93,6 +121,9 @@ void ImageRectification::process()
 
         outRectifiedImage.extrinsic = inOriginalImage.extrinsic;
         outRectifiedImage.metadata = inOriginalImage.metadata;
+        if(parameters.grayscale){
+            outRectifiedImage.metadata.mode = asn1Sccmode_GRAY;
+        }
 
         // Array3D
         {
@@ -121,7 +152,9 @@ const ImageRectification::ImageRectificationParams ImageRectification::DEFAULT_P
     .yratio = 1,
     .scaling = -1,
     .centerPrincipalPoint = false,
-    .fisheye = false
+    .fisheye = false,
+    .fixedPointMaps = true,
+    .grayscale = false
 };
 
 }
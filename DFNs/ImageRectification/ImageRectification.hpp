@@ -67,6 +67,18 @@ namespace ImageRectification
                  * Otherwise the pinhole projection model will be used.
                  */
                 bool fisheye;
+
+                /**
+                 * @brief Set to true to convert the rectification maps once to the packed fixed-point form of OpenCV (CV_16SC2 coordinates and an interpolation table index),
+                 * so that each remap reads fewer bytes and uses integer arithmetic, at the cost of a 1/32 pixel precision.
+                 * Set to false to keep the CV_32F maps.
+                 */
+                bool fixedPointMaps;
+
+                /**
+                 * @brief Set to true to convert a color image to grayscale before it is remapped, the rectified image is then grayscale.
+                 */
+                bool grayscale;
             };
 
             Helpers::ParametersListHelper parametersHelper;
@@ -81,6 +93,7 @@ namespace ImageRectification
             double _scaling = -1;
             bool _centerPrincipalPoint = false;
             bool _fisheye = false;
+            bool _fixedPointMaps = false;
 
             cv::Mat _mapx;
             cv::Mat _mapy;
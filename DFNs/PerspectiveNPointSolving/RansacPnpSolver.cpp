@@ -0,0 +1,162 @@
+/**
+ * @author Alessandro Bianco
+ */
+
+/**
+ * @addtogroup DFNs
+ * @{
+ */
+
+#include "RansacPnpSolver.hpp"
+
+#include <Errors/Assert.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+using namespace PoseWrapper;
+using namespace PointCloudWrapper;
+using namespace VisualPointFeatureVector2DWrapper;
+
+namespace CDFF
+{
+namespace DFN
+{
+namespace PerspectiveNPointSolving
+{
+
+RansacPnpSolver::RansacPnpSolver()
+{
+	parameters = DEFAULT_PARAMETERS;
+
+	#define ADD_PARAMETER(type, groupName, parameterName, groupVariable, parameterVariable) \
+		parametersHelper.AddParameter<type>(groupName, parameterName, parameters.groupVariable.parameterVariable, DEFAULT_PARAMETERS.groupVariable.parameterVariable);
+
+	ADD_PARAMETER(float, "CameraMatrix", "FocalLengthX", cameraMatrix, focalLengthX);
+	ADD_PARAMETER(float, "CameraMatrix", "FocalLengthY", cameraMatrix, focalLengthY);
+	ADD_PARAMETER(float, "CameraMatrix", "PrinciplePointX", cameraMatrix, principalPointX);
+	ADD_PARAMETER(float, "CameraMatrix", "PrinciplePointY", cameraMatrix, principalPointY);
+
+	ADD_PARAMETER(float, "RansacParameters", "ReprojectionThreshold", ransacOptionsSet, reprojectionThreshold);
+	ADD_PARAMETER(double, "RansacParameters", "Confidence", ransacOptionsSet, confidence);
+	ADD_PARAMETER(int, "RansacParameters", "MaximumIterations", ransacOptionsSet, maximumIterations);
+	ADD_PARAMETER(bool, "RansacParameters", "UseSprt", ransacOptionsSet, useSprt);
+	ADD_PARAMETER(int, "RansacParameters", "NumberOfThreads", ransacOptionsSet, numberOfThreads);
+	ADD_PARAMETER(double, "RansacParameters", "MaximumTime", ransacOptionsSet, maximumTime);
+	ADD_PARAMETER(int, "RansacParameters", "PreemptiveHypotheses", ransacOptionsSet, preemptiveHypotheses);
+	ADD_PARAMETER(int, "RansacParameters", "MinimumInliers", ransacOptionsSet, minimumInliers);
+
+	configurationFilePath = "";
+}
+
+RansacPnpSolver::~RansacPnpSolver()
+{
+}
+
+void RansacPnpSolver::configure()
+{
+	parametersHelper.ReadFile(configurationFilePath);
+	ValidateParameters();
+}
+
+void RansacPnpSolver::process()
+{
+	if (GetNumberOfPoints(inPoints) < 4)
+	{
+		outSuccess = false;
+		return;
+	}
+
+	// Process data and write the pose to the output port
+	ValidateInputs();
+	outSuccess = ComputePose(outCamera);
+}
+
+const RansacPnpSolver::RansacPnpOptionsSet RansacPnpSolver::DEFAULT_PARAMETERS =
+{
+	//.cameraMatrix =
+	{
+		/*.focalLengthX =*/ 1,
+		/*.focalLengthY =*/ 1,
+		/*.principalPointX =*/ 0,
+		/*.principalPointY =*/ 0
+	},
+	//.ransacOptionsSet =
+	{
+		/*.reprojectionThreshold =*/ 2,
+		/*.confidence =*/ 0.99,
+		/*.maximumIterations =*/ 1000,
+		/*.useSprt =*/ true,
+		/*.numberOfThreads =*/ 0,
+		/*.maximumTime =*/ 0,
+		/*.preemptiveHypotheses =*/ 0,
+		/*.minimumInliers =*/ 6
+	}
+};
+
+/**
+ * The errors of the estimator are squared reprojection errors, so they are compared with the square of the reprojection threshold. The pose is the transform
+ * [R|t] from the reference frame of the points to the camera frame, it is written only on success.
+ */
+bool RansacPnpSolver::ComputePose(Pose3D& pose)
+{
+	perspectiveNPointProblem.SetCameraMatrix(parameters.cameraMatrix.focalLengthX, parameters.cameraMatrix.focalLengthY,
+		parameters.cameraMatrix.principalPointX, parameters.cameraMatrix.principalPointY);
+	perspectiveNPointProblem.ClearPoints();
+	int numberOfPoints = GetNumberOfPoints(inPoints);
+	for (int pointIndex = 0; pointIndex < numberOfPoints; pointIndex++)
+	{
+		perspectiveNPointProblem.AddPoint(GetXCoordinate(inPoints, pointIndex), GetYCoordinate(inPoints, pointIndex), GetZCoordinate(inPoints, pointIndex),
+			GetXCoordinate(inProjections, pointIndex), GetYCoordinate(inProjections, pointIndex));
+	}
+
+	RobustEstimation::RobustEstimator::Options options = RobustEstimation::RobustEstimator::DEFAULT_OPTIONS;
+	options.inlierThreshold = parameters.ransacOptionsSet.reprojectionThreshold * parameters.ransacOptionsSet.reprojectionThreshold;
+	options.confidence = parameters.ransacOptionsSet.confidence;
+	options.maximumIterations = parameters.ransacOptionsSet.maximumIterations;
+	options.useProsac = false;
+	options.useSprt = parameters.ransacOptionsSet.useSprt;
+	options.numberOfThreads = parameters.ransacOptionsSet.numberOfThreads;
+	options.maximumTime = parameters.ransacOptionsSet.maximumTime;
+	options.preemptiveHypotheses = parameters.ransacOptionsSet.preemptiveHypotheses;
+	robustEstimator.SetOptions(options);
+
+	std::vector<double> model;
+	std::vector<int> inliersList;
+	if (!robustEstimator.Estimate(perspectiveNPointProblem, std::vector<float>(), model, inliersList) ||
+		static_cast<int>(inliersList.size()) < parameters.ransacOptionsSet.minimumInliers)
+	{
+		return false;
+	}
+
+	Eigen::Matrix<double, 3, 4, Eigen::RowMajor> poseMatrix = Eigen::Map<const Eigen::Matrix<double, 3, 4, Eigen::RowMajor> >(model.data());
+	Eigen::Quaterniond orientation(poseMatrix.leftCols<3>());
+	SetPosition(pose, poseMatrix(0, 3), poseMatrix(1, 3), poseMatrix(2, 3));
+	SetOrientation(pose, orientation.x(), orientation.y(), orientation.z(), orientation.w());
+	return true;
+}
+
+void RansacPnpSolver::ValidateParameters()
+{
+	ASSERT(parameters.cameraMatrix.focalLengthX > 0 && parameters.cameraMatrix.focalLengthY > 0,
+		"RansacPnpSolver Configuration Error: focal length is not strictly positive");
+	ASSERT(parameters.ransacOptionsSet.reprojectionThreshold > 0, "RansacPnpSolver Configuration Error: ReprojectionThreshold is not strictly positive");
+	ASSERT(parameters.ransacOptionsSet.confidence > 0 && parameters.ransacOptionsSet.confidence < 1, "RansacPnpSolver Configuration Error: Confidence has to be between 0 and 1");
+	ASSERT(parameters.ransacOptionsSet.maximumIterations > 0, "RansacPnpSolver Configuration Error: MaximumIterations is not strictly positive");
+	ASSERT(parameters.ransacOptionsSet.numberOfThreads >= 0, "RansacPnpSolver Configuration Error: NumberOfThreads is negative");
+	ASSERT(parameters.ransacOptionsSet.maximumTime >= 0, "RansacPnpSolver Configuration Error: MaximumTime is negative");
+	ASSERT(parameters.ransacOptionsSet.preemptiveHypotheses >= 0, "RansacPnpSolver Configuration Error: PreemptiveHypotheses is negative");
+	ASSERT(parameters.ransacOptionsSet.minimumInliers >= 4, "RansacPnpSolver Configuration Error: MinimumInliers has to be at least 4");
+}
+
+void RansacPnpSolver::ValidateInputs()
+{
+	ASSERT(GetNumberOfPoints(inPoints) == GetNumberOfPoints(inProjections),
+		"RansacPnpSolver Error: the points and their projections are in a different number");
+}
+
+}
+}
+}
+
+/** @} */
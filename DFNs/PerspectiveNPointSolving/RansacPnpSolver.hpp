@@ -0,0 +1,113 @@
+/**
+ * @author Alessandro Bianco
+ */
+
+/**
+ * @addtogroup DFNs
+ * @{
+ */
+
+#ifndef PERSPECTIVENPOINTSOLVING_RANSACPNPSOLVER_HPP
+#define PERSPECTIVENPOINTSOLVING_RANSACPNPSOLVER_HPP
+
+#include "PerspectiveNPointSolvingInterface.hpp"
+
+#include <Types/CPP/PointCloud.hpp>
+#include <Types/CPP/VisualPointFeatureVector2D.hpp>
+#include <Types/CPP/Pose.hpp>
+#include <Helpers/ParametersListHelper.hpp>
+#include <RobustEstimation/RobustEstimator.hpp>
+#include <RobustEstimation/PerspectiveNPointProblem.hpp>
+
+namespace CDFF
+{
+namespace DFN
+{
+namespace PerspectiveNPointSolving
+{
+	/**
+	 * Perspective-n-Point solving robust to outliers, with a native implementation that does not depend on OpenCV: RANSAC hypotheses are fitted on samples
+	 * of three points by a P3P solver and verified in parallel, the pose with the most inliers is then refined on its inliers by Levenberg-Marquardt minimization
+	 * of the reprojection errors. The latency is bounded by a time budget, or by the preemptive scoring of a fixed number of hypotheses.
+	 *
+	 * @param cameraMatrix
+	 *        intrinsic camera parameters (focal length and principal points)
+	 *
+	 * @param ransacOptionsSet.reprojectionThreshold
+	 *        the maximum reprojection error in pixels of an inlier point
+	 * @param ransacOptionsSet.confidence
+	 *        the required probability of finding the pose with the most inliers, it sets the number of hypotheses from the inlier ratio
+	 * @param ransacOptionsSet.maximumIterations
+	 *        the maximum number of samples of three points
+	 * @param ransacOptionsSet.useSprt
+	 *        whether the hypotheses are rejected early by a sequential probability ratio test on their inliers
+	 * @param ransacOptionsSet.numberOfThreads
+	 *        the number of threads that fit and verify the hypotheses, 0 means the number of hardware threads
+	 * @param ransacOptionsSet.maximumTime
+	 *        the time budget in seconds after which no more hypotheses are fitted, 0 means no limit
+	 * @param ransacOptionsSet.preemptiveHypotheses
+	 *        when positive, the number of samples whose hypotheses are scored preemptively: they are verified on a batch of points at a time and only the best
+	 *        half is kept after each batch. This replaces the adaptive number of hypotheses and the sequential test
+	 * @param ransacOptionsSet.minimumInliers
+	 *        the minimum number of inliers of a successful estimation
+	 */
+	class RansacPnpSolver : public PerspectiveNPointSolvingInterface
+	{
+		public:
+
+			RansacPnpSolver();
+			virtual ~RansacPnpSolver();
+
+			virtual void configure() override;
+			virtual void process() override;
+
+		private:
+
+			//DFN Parameters
+			struct CameraMatrix
+			{
+				float focalLengthX;
+				float focalLengthY;
+				float principalPointX;
+				float principalPointY;
+			};
+
+			struct RansacOptionsSet
+			{
+				float reprojectionThreshold;
+				double confidence;
+				int maximumIterations;
+				bool useSprt;
+				int numberOfThreads;
+				double maximumTime;
+				int preemptiveHypotheses;
+				int minimumInliers;
+			};
+
+			struct RansacPnpOptionsSet
+			{
+				CameraMatrix cameraMatrix;
+				RansacOptionsSet ransacOptionsSet;
+			};
+
+			Helpers::ParametersListHelper parametersHelper;
+			RansacPnpOptionsSet parameters;
+			static const RansacPnpOptionsSet DEFAULT_PARAMETERS;
+
+			RobustEstimation::PerspectiveNPointProblem perspectiveNPointProblem;
+			RobustEstimation::RobustEstimator robustEstimator;
+
+			//Core computation methods
+			bool ComputePose(PoseWrapper::Pose3D& pose);
+
+			//Input Validation methods
+			void ValidateParameters();
+			void ValidateInputs();
+	};
+}
+}
+}
+
+#endif // PERSPECTIVENPOINTSOLVING_RANSACPNPSOLVER_HPP
+
+/** @} */
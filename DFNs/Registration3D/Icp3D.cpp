@@ -53,6 +53,12 @@ void Icp3D::configure()
 
 void Icp3D::process()
 {
+	if (sinkTarget != NULL)
+	{
+		ProcessOnSinkTarget();
+		return;
+	}
+
 	// Handle empty pointclouds
 	if (GetNumberOfPoints(inSourceCloud) == 0 || GetNumberOfPoints(inSinkCloud) == 0)
 	{
@@ -76,6 +82,12 @@ void Icp3D::process()
 	delete transform;
 }
 
+bool Icp3D::setSinkTarget(IncrementalTargetCloud* target)
+{
+	sinkTarget = target;
+	return true;
+}
+
 const Icp3D::IcpOptionsSet Icp3D::DEFAULT_PARAMETERS =
 {
 	/*.maxCorrespondenceDistance =*/ 0.05,
@@ -97,11 +109,7 @@ Pose3DConstPtr Icp3D::ComputeTransform(pcl::PointCloud<pcl::PointXYZ>::ConstPtr
 	pcl::IterativeClosestPoint<pcl::PointXYZ, pcl::PointXYZ> icp;
 	icp.setInputCloud(sourceCloud);
 	icp.setInputTarget(sinkCloud);
-
-	icp.setMaxCorrespondenceDistance(parameters.maxCorrespondenceDistance);
-	icp.setMaximumIterations(parameters.maximumIterations);
-	icp.setTransformationEpsilon(parameters.transformationEpsilon);
-	icp.setEuclideanFitnessEpsilon(parameters.euclideanFitnessEpsilon);
+	SetupIcp(icp);
 
 	// Setup output
 	pcl::PointCloud<pcl::PointXYZ>::Ptr outputCloud(new pcl::PointCloud<pcl::PointXYZ>);
@@ -109,6 +117,37 @@ Pose3DConstPtr Icp3D::ComputeTransform(pcl::PointCloud<pcl::PointXYZ>::ConstPtr
 	// Run ICP
 	icp.align(*outputCloud);
 
+	return ExtractTransform(icp);
+}
+
+/**
+ * This function registers the source cloud on an incremental sink target. The target cloud keeps the slots of removed points as NaN points, they are never
+ * returned by the search tree of the target, which is passed with force_no_recompute so that PCL does not build a kd-tree on the target cloud.
+ */
+Pose3DConstPtr Icp3D::ComputeTransform(pcl::PointCloud<pcl::PointXYZ>::ConstPtr sourceCloud, IncrementalTargetCloud* target, const Eigen::Matrix4f& guess)
+{
+	pcl::IterativeClosestPoint<pcl::PointXYZ, pcl::PointXYZ> icp;
+	icp.setInputCloud(sourceCloud);
+	icp.setInputTarget(target->GetCloud());
+	icp.setSearchMethodTarget(target->GetSearchTree(parameters.maxCorrespondenceDistance), true);
+	SetupIcp(icp);
+
+	pcl::PointCloud<pcl::PointXYZ>::Ptr outputCloud(new pcl::PointCloud<pcl::PointXYZ>);
+	icp.align(*outputCloud, guess);
+
+	return ExtractTransform(icp);
+}
+
+void Icp3D::SetupIcp(pcl::IterativeClosestPoint<pcl::PointXYZ, pcl::PointXYZ>& icp)
+{
+	icp.setMaxCorrespondenceDistance(parameters.maxCorrespondenceDistance);
+	icp.setMaximumIterations(parameters.maximumIterations);
+	icp.setTransformationEpsilon(parameters.transformationEpsilon);
+	icp.setEuclideanFitnessEpsilon(parameters.euclideanFitnessEpsilon);
+}
+
+Pose3DConstPtr Icp3D::ExtractTransform(pcl::IterativeClosestPoint<pcl::PointXYZ, pcl::PointXYZ>& icp)
+{
 	// Check convergence
 	outSuccess = icp.hasConverged();
 	if (outSuccess)
@@ -123,6 +162,25 @@ Pose3DConstPtr Icp3D::ComputeTransform(pcl::PointCloud<pcl::PointXYZ>::ConstPtr
 	}
 }
 
+void Icp3D::ProcessOnSinkTarget()
+{
+	if (GetNumberOfPoints(inSourceCloud) == 0 || sinkTarget->GetNumberOfPoints() == 0)
+	{
+		outSuccess = false;
+		return;
+	}
+	ASSERT(parameters.maxCorrespondenceDistance > 0, "Icp3D Error, a sink target requires a positive Max Correspondence Distance");
+
+	pcl::PointCloud<pcl::PointXYZ>::ConstPtr inputSourceCloud = pointCloudToPclPointCloud.Convert(&inSourceCloud);
+	ValidateCloud(inputSourceCloud);
+
+	Eigen::Matrix4f guess = inUseGuess ? transform3DToEigenTransform.Convert(&inTransformGuess) : Eigen::Matrix4f::Identity();
+	Pose3DConstPtr transform = ComputeTransform(inputSourceCloud, sinkTarget, guess);
+
+	Copy(*transform, outTransform);
+	delete transform;
+}
+
 void Icp3D::ValidateParameters()
 {
 	ASSERT(parameters.maxCorrespondenceDistance >= 0, "Icp3D Configuration error, Max Correspondence Distance is negative");
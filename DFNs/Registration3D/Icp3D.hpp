@@ -11,14 +11,17 @@
 #define REGISTRATION3D_ICP3D_HPP
 
 #include "Registration3DInterface.hpp"
+#include "IncrementalTargetCloud.hpp"
 
 #include <Types/CPP/Pose.hpp>
 #include <Converters/PointCloudToPclPointCloudConverter.hpp>
 #include <Converters/EigenTransformToTransform3DConverter.hpp>
+#include <Converters/Transform3DToEigenTransformConverter.hpp>
 #include <Helpers/ParametersListHelper.hpp>
 
 #include <pcl/point_cloud.h>
 #include <pcl/point_types.h>
+#include <pcl/registration/icp.h>
 
 namespace CDFF
 {
@@ -33,6 +36,8 @@ namespace Registration3D
 	 * @param MaximumIterations
 	 * @param TransformationEpsilon
 	 * @param EuclideanFitnessEpsilon
+	 *
+	 * An incremental sink target is supported, in that case the transform guess is used as initial transform and the search tree of the target replaces the kd-tree of the sink.
 	 */
 	class Icp3D : public Registration3DInterface
 	{
@@ -43,6 +48,7 @@ namespace Registration3D
 
 			virtual void configure() override;
 			virtual void process() override;
+			virtual bool setSinkTarget(IncrementalTargetCloud* target) override;
 
 		private:
 
@@ -62,9 +68,15 @@ namespace Registration3D
 			//External conversion helpers			
 			Converters::PointCloudToPclPointCloudConverter pointCloudToPclPointCloud;
 			Converters::EigenTransformToTransform3DConverter eigenTransformToTransform3D;
+			Converters::Transform3DToEigenTransformConverter transform3DToEigenTransform;
 
 			//Core computation methods
 			PoseWrapper::Pose3DConstPtr ComputeTransform(pcl::PointCloud<pcl::PointXYZ>::ConstPtr sourceCloud, pcl::PointCloud<pcl::PointXYZ>::ConstPtr sinkCloud);
+			PoseWrapper::Pose3DConstPtr ComputeTransform(pcl::PointCloud<pcl::PointXYZ>::ConstPtr sourceCloud, IncrementalTargetCloud* target, const Eigen::Matrix4f& guess);
+			void SetupIcp(pcl::IterativeClosestPoint<pcl::PointXYZ, pcl::PointXYZ>& icp);
+			PoseWrapper::Pose3DConstPtr ExtractTransform(pcl::IterativeClosestPoint<pcl::PointXYZ, pcl::PointXYZ>& icp);
+
+			void ProcessOnSinkTarget();
 
 			//Input Validation methods
 			void ValidateParameters();
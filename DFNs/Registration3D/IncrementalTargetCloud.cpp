@@ -0,0 +1,399 @@
+/**
+ * @author Alessandro Bianco
+ */
+
+/**
+ * @addtogroup DFNs
+ * @{
+ */
+
+#include "IncrementalTargetCloud.hpp"
+
+#include <Errors/Assert.hpp>
+
+#include <Eigen/Geometry>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace PointCloudWrapper;
+using namespace PoseWrapper;
+
+namespace CDFF
+{
+namespace DFN
+{
+namespace Registration3D
+{
+
+IncrementalTargetCloud::SearchTree::SearchTree(const IncrementalTargetCloud& target) :
+	pcl::search::KdTree<pcl::PointXYZ>(true),
+	target(target)
+{
+}
+
+int IncrementalTargetCloud::SearchTree::nearestKSearch(const pcl::PointXYZ& point, int k, std::vector<int>& indicesList, std::vector<float>& squaredDistancesList) const
+{
+	indicesList.clear();
+	squaredDistancesList.clear();
+
+	std::vector<std::pair<float, int> > neighboursList;
+	target.CollectNeighbours(point, target.searchDistance, neighboursList);
+
+	unsigned numberOfNeighbours = std::min(static_cast<unsigned>(std::max(k, 0)), static_cast<unsigned>(neighboursList.size()));
+	std::partial_sort(neighboursList.begin(), neighboursList.begin() + numberOfNeighbours, neighboursList.end());
+	for (unsigned neighbourIndex = 0; neighbourIndex < numberOfNeighbours; neighbourIndex++)
+	{
+		indicesList.push_back(neighboursList.at(neighbourIndex).second);
+		squaredDistancesList.push_back(neighboursList.at(neighbourIndex).first);
+	}
+
+	if (numberOfNeighbours == 0)
+	{
+		indicesList.push_back(0);
+		squaredDistancesList.push_back(std::numeric_limits<float>::max());
+	}
+	return numberOfNeighbours;
+}
+
+int IncrementalTargetCloud::SearchTree::radiusSearch(const pcl::PointXYZ& point, double radius, std::vector<int>& indicesList, std::vector<float>& squaredDistancesList, unsigned int maximumNumberOfNeighbours) const
+{
+	indicesList.clear();
+	squaredDistancesList.clear();
+
+	std::vector<std::pair<float, int> > neighboursList;
+	target.CollectNeighbours(point, std::min(static_cast<float>(radius), target.searchDistance), neighboursList);
+	std::sort(neighboursList.begin(), neighboursList.end());
+
+	unsigned numberOfNeighbours = neighboursList.size();
+	if (maximumNumberOfNeighbours > 0 && maximumNumberOfNeighbours < numberOfNeighbours)
+	{
+		numberOfNeighbours = maximumNumberOfNeighbours;
+	}
+	for (unsigned neighbourIndex = 0; neighbourIndex < numberOfNeighbours; neighbourIndex++)
+	{
+		indicesList.push_back(neighboursList.at(neighbourIndex).second);
+		squaredDistancesList.push_back(neighboursList.at(neighbourIndex).first);
+	}
+	return numberOfNeighbours;
+}
+
+IncrementalTargetCloud::IncrementalTargetCloud() :
+	cloud(new pcl::PointCloud<pcl::PointXYZ>)
+{
+	resolution = DEFAULT_RESOLUTION;
+	searchCellFactor = 1;
+	searchDistance = DEFAULT_RESOLUTION;
+	numberOfPoints = 0;
+	searchTree = SearchTree::Ptr(new SearchTree(*this));
+}
+
+IncrementalTargetCloud::~IncrementalTargetCloud()
+{
+}
+
+void IncrementalTargetCloud::SetResolution(float resolution)
+{
+	ASSERT(resolution > 0, "IncrementalTargetCloud Error, resolution has to be positive");
+	if (resolution == this->resolution)
+	{
+		return;
+	}
+
+	pcl::PointCloud<pcl::PointXYZ>::Ptr oldCloud = cloud;
+	Clear();
+	this->resolution = resolution;
+	searchCellFactor = std::max(1, static_cast<int32_t>( std::ceil(searchDistance / resolution) ));
+	for (unsigned slot = 0; slot < oldCloud->points.size(); slot++)
+	{
+		const pcl::PointXYZ& point = oldCloud->points.at(slot);
+		if (point.x == point.x)
+		{
+			AddPoint(point);
+		}
+	}
+}
+
+void IncrementalTargetCloud::AddPoints(const PointCloud& cloud)
+{
+	int numberOfCloudPoints = PointCloudWrapper::GetNumberOfPoints(cloud);
+	for (int pointIndex = 0; pointIndex < numberOfCloudPoints; pointIndex++)
+	{
+		pcl::PointXYZ point( GetXCoordinate(cloud, pointIndex), GetYCoordinate(cloud, pointIndex), GetZCoordinate(cloud, pointIndex) );
+		if (std::isfinite(point.x) && std::isfinite(point.y) && std::isfinite(point.z))
+		{
+			AddPoint(point);
+		}
+	}
+}
+
+void IncrementalTargetCloud::AddPoints(const PointCloud& cloud, const Pose3D& cloudPose)
+{
+	Eigen::Quaternionf rotation( GetWOrientation(cloudPose), GetXOrientation(cloudPose), GetYOrientation(cloudPose), GetZOrientation(cloudPose) );
+	Eigen::Vector3f translation( GetXPosition(cloudPose), GetYPosition(cloudPose), GetZPosition(cloudPose) );
+	Eigen::Matrix3f rotationMatrix = rotation.normalized().toRotationMatrix();
+
+	int numberOfCloudPoints = PointCloudWrapper::GetNumberOfPoints(cloud);
+	for (int pointIndex = 0; pointIndex < numberOfCloudPoints; pointIndex++)
+	{
+		Eigen::Vector3f cloudPoint( GetXCoordinate(cloud, pointIndex), GetYCoordinate(cloud, pointIndex), GetZCoordinate(cloud, pointIndex) );
+		if (!cloudPoint.allFinite())
+		{
+			continue;
+		}
+		Eigen::Vector3f targetPoint = rotationMatrix * cloudPoint + translation;
+		AddPoint( pcl::PointXYZ(targetPoint.x(), targetPoint.y(), targetPoint.z()) );
+	}
+}
+
+void IncrementalTargetCloud::RemovePointsOutside(const Pose3D& center, float radius)
+{
+	ASSERT(radius >= 0, "IncrementalTargetCloud Error, radius cannot be negative");
+	float centerX = GetXPosition(center);
+	float centerY = GetYPosition(center);
+	float centerZ = GetZPosition(center);
+	float squaredRadius = radius * radius;
+	float cellSide = resolution * searchCellFactor;
+
+	std::vector<uint32_t> removedSlotsList;
+	for (SearchCellsMap::iterator cell = searchCellsMap.begin(); cell != searchCellsMap.end(); ++cell)
+	{
+		const CellKey& key = cell->first;
+		float minimumX = key.x * cellSide;
+		float minimumY = key.y * cellSide;
+		float minimumZ = key.z * cellSide;
+
+		float nearestX = std::max(minimumX - centerX, std::max(0.f, centerX - minimumX - cellSide));
+		float nearestY = std::max(minimumY - centerY, std::max(0.f, centerY - minimumY - cellSide));
+		float nearestZ = std::max(minimumZ - centerZ, std::max(0.f, centerZ - minimumZ - cellSide));
+		float farthestX = std::max(std::abs(minimumX - centerX), std::abs(minimumX + cellSide - centerX));
+		float farthestY = std::max(std::abs(minimumY - centerY), std::abs(minimumY + cellSide - centerY));
+		float farthestZ = std::max(std::abs(minimumZ - centerZ), std::abs(minimumZ + cellSide - centerZ));
+
+		if (farthestX*farthestX + farthestY*farthestY + farthestZ*farthestZ <= squaredRadius)
+		{
+			continue;
+		}
+		bool cellOutside = (nearestX*nearestX + nearestY*nearestY + nearestZ*nearestZ > squaredRadius);
+		for (std::vector<uint32_t>::const_iterator slot = cell->second.begin(); slot != cell->second.end(); ++slot)
+		{
+			const pcl::PointXYZ& point = cloud->points.at(*slot);
+			float differenceX = point.x - centerX;
+			float differenceY = point.y - centerY;
+			float differenceZ = point.z - centerZ;
+			if (cellOutside || differenceX*differenceX + differenceY*differenceY + differenceZ*differenceZ > squaredRadius)
+			{
+				removedSlotsList.push_back(*slot);
+			}
+		}
+	}
+
+	for (std::vector<uint32_t>::const_iterator slot = removedSlotsList.begin(); slot != removedSlotsList.end(); ++slot)
+	{
+		RemoveSlot(*slot);
+	}
+}
+
+void IncrementalTargetCloud::Clear()
+{
+	cloud = pcl::PointCloud<pcl::PointXYZ>::Ptr(new pcl::PointCloud<pcl::PointXYZ>);
+	slotPointsCountList.clear();
+	slotVoxelKeysList.clear();
+	freeSlotsList.clear();
+	voxelsMap.clear();
+	searchCellsMap.clear();
+	numberOfPoints = 0;
+}
+
+unsigned IncrementalTargetCloud::GetNumberOfPoints() const
+{
+	return numberOfPoints;
+}
+
+pcl::PointCloud<pcl::PointXYZ>::ConstPtr IncrementalTargetCloud::GetCloud() const
+{
+	return cloud;
+}
+
+IncrementalTargetCloud::SearchTree::Ptr IncrementalTargetCloud::GetSearchTree(float searchDistance)
+{
+	ASSERT(searchDistance > 0, "IncrementalTargetCloud Error, search distance has to be positive");
+	this->searchDistance = searchDistance;
+
+	int32_t requiredCellFactor = std::max(1, static_cast<int32_t>( std::ceil(searchDistance / resolution) ));
+	if (requiredCellFactor > searchCellFactor)
+	{
+		searchCellFactor = requiredCellFactor;
+		RebuildSearchCells();
+	}
+	return searchTree;
+}
+
+int IncrementalTargetCloud::FindNearestPoint(const pcl::PointXYZ& point, float& squaredDistance) const
+{
+	std::vector<std::pair<float, int> > neighboursList;
+	CollectNeighbours(point, searchDistance, neighboursList);
+	if (neighboursList.size() == 0)
+	{
+		squaredDistance = std::numeric_limits<float>::max();
+		return -1;
+	}
+
+	std::vector<std::pair<float, int> >::const_iterator nearest = std::min_element(neighboursList.begin(), neighboursList.end());
+	squaredDistance = nearest->first;
+	return nearest->second;
+}
+
+const float IncrementalTargetCloud::DEFAULT_RESOLUTION = 0.01;
+
+/**
+ * A point falling in an occupied voxel moves the voxel point towards the centroid of the points of the voxel, otherwise it takes a free slot, or a new one at the end of the cloud.
+ * The voxel always stays in the same search cell, as the search cells are aligned to the voxels.
+ */
+void IncrementalTargetCloud::AddPoint(const pcl::PointXYZ& point)
+{
+	CellKey voxelKey = ComputeVoxelKey(point);
+	VoxelsMap::iterator voxel = voxelsMap.find(voxelKey);
+	if (voxel != voxelsMap.end())
+	{
+		uint32_t slot = voxel->second;
+		pcl::PointXYZ& voxelPoint = cloud->points.at(slot);
+		uint32_t& count = slotPointsCountList.at(slot);
+		count++;
+		voxelPoint.x += (point.x - voxelPoint.x) / count;
+		voxelPoint.y += (point.y - voxelPoint.y) / count;
+		voxelPoint.z += (point.z - voxelPoint.z) / count;
+		return;
+	}
+
+	uint32_t slot;
+	if (freeSlotsList.size() > 0)
+	{
+		slot = freeSlotsList.back();
+		freeSlotsList.pop_back();
+		cloud->points.at(slot) = point;
+		slotPointsCountList.at(slot) = 1;
+		slotVoxelKeysList.at(slot) = voxelKey;
+	}
+	else
+	{
+		slot = cloud->points.size();
+		cloud->points.push_back(point);
+		slotPointsCountList.push_back(1);
+		slotVoxelKeysList.push_back(voxelKey);
+		cloud->width = cloud->points.size();
+		cloud->height = 1;
+	}
+	cloud->is_dense = false;
+
+	voxelsMap[voxelKey] = slot;
+	searchCellsMap[ComputeSearchCellKey(voxelKey)].push_back(slot);
+	numberOfPoints++;
+}
+
+void IncrementalTargetCloud::RemoveSlot(uint32_t slot)
+{
+	const CellKey& voxelKey = slotVoxelKeysList.at(slot);
+	voxelsMap.erase(voxelKey);
+
+	SearchCellsMap::iterator cell = searchCellsMap.find( ComputeSearchCellKey(voxelKey) );
+	ASSERT(cell != searchCellsMap.end(), "IncrementalTargetCloud Error, removed point is not in the search cells");
+	std::vector<uint32_t>& slotsList = cell->second;
+	std::vector<uint32_t>::iterator position = std::find(slotsList.begin(), slotsList.end(), slot);
+	*position = slotsList.back();
+	slotsList.pop_back();
+	if (slotsList.size() == 0)
+	{
+		searchCellsMap.erase(cell);
+	}
+
+	pcl::PointXYZ& point = cloud->points.at(slot);
+	point.x = point.y = point.z = std::numeric_limits<float>::quiet_NaN();
+	slotPointsCountList.at(slot) = 0;
+	freeSlotsList.push_back(slot);
+	numberOfPoints--;
+}
+
+void IncrementalTargetCloud::RebuildSearchCells()
+{
+	searchCellsMap.clear();
+	for (VoxelsMap::const_iterator voxel = voxelsMap.begin(); voxel != voxelsMap.end(); ++voxel)
+	{
+		searchCellsMap[ComputeSearchCellKey(voxel->first)].push_back(voxel->second);
+	}
+}
+
+/**
+ * The side of a search cell is at least the search distance, so the neighbours of a point within radius lie in the 27 cells around the cell of the point.
+ */
+void IncrementalTargetCloud::CollectNeighbours(const pcl::PointXYZ& point, float radius, std::vector<std::pair<float, int> >& neighboursList) const
+{
+	if (!std::isfinite(point.x) || !std::isfinite(point.y) || !std::isfinite(point.z))
+	{
+		return;
+	}
+
+	float squaredRadius = radius * radius;
+	CellKey centerKey = ComputeSearchCellKey( ComputeVoxelKey(point) );
+	for (int32_t offsetX = -1; offsetX <= 1; offsetX++)
+	{
+		for (int32_t offsetY = -1; offsetY <= 1; offsetY++)
+		{
+			for (int32_t offsetZ = -1; offsetZ <= 1; offsetZ++)
+			{
+				CellKey key = { centerKey.x + offsetX, centerKey.y + offsetY, centerKey.z + offsetZ };
+				SearchCellsMap::const_iterator cell = searchCellsMap.find(key);
+				if (cell == searchCellsMap.end())
+				{
+					continue;
+				}
+				for (std::vector<uint32_t>::const_iterator slot = cell->second.begin(); slot != cell->second.end(); ++slot)
+				{
+					const pcl::PointXYZ& neighbour = cloud->points.at(*slot);
+					float differenceX = neighbour.x - point.x;
+					float differenceY = neighbour.y - point.y;
+					float differenceZ = neighbour.z - point.z;
+					float squaredDistance = differenceX*differenceX + differenceY*differenceY + differenceZ*differenceZ;
+					if (squaredDistance <= squaredRadius)
+					{
+						neighboursList.push_back( std::pair<float, int>(squaredDistance, static_cast<int>(*slot)) );
+					}
+				}
+			}
+		}
+	}
+}
+
+IncrementalTargetCloud::CellKey IncrementalTargetCloud::ComputeVoxelKey(const pcl::PointXYZ& point) const
+{
+	CellKey key;
+	key.x = static_cast<int32_t>( std::floor(point.x / resolution) );
+	key.y = static_cast<int32_t>( std::floor(point.y / resolution) );
+	key.z = static_cast<int32_t>( std::floor(point.z / resolution) );
+	return key;
+}
+
+IncrementalTargetCloud::CellKey IncrementalTargetCloud::ComputeSearchCellKey(const CellKey& voxelKey) const
+{
+	CellKey key;
+	key.x = FloorDivide(voxelKey.x, searchCellFactor);
+	key.y = FloorDivide(voxelKey.y, searchCellFactor);
+	key.z = FloorDivide(voxelKey.z, searchCellFactor);
+	return key;
+}
+
+int32_t IncrementalTargetCloud::FloorDivide(int32_t dividend, int32_t divisor)
+{
+	int32_t quotient = dividend / divisor;
+	if ((dividend % divisor != 0) && ((dividend < 0) != (divisor < 0)))
+	{
+		quotient--;
+	}
+	return quotient;
+}
+
+}
+}
+}
+
+/** @} */
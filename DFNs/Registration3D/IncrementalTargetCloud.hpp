@@ -0,0 +1,160 @@
+/**
+ * @author Alessandro Bianco
+ */
+
+/**
+ * @addtogroup DFNs
+ * @{
+ */
+
+#ifndef REGISTRATION3D_INCREMENTALTARGETCLOUD_HPP
+#define REGISTRATION3D_INCREMENTALTARGETCLOUD_HPP
+
+#include <Types/CPP/PointCloud.hpp>
+#include <Types/CPP/Pose.hpp>
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <pcl/search/kdtree.h>
+
+#include <vector>
+#include <unordered_map>
+
+namespace CDFF
+{
+namespace DFN
+{
+namespace Registration3D
+{
+	/**
+	 * Persistent sink of a registration, maintained by the caller across frames, see Registration3DInterface::setSinkTarget.
+	 *
+	 * The points are merged into voxels of a given resolution, so that adding the same surface twice does not grow the target, and each voxel keeps the centroid of its points.
+	 * Points can be added and removed one cloud at a time, without rebuilding anything: the voxels are indexed by a hash map, and for nearest neighbour search by a second
+	 * hash map of search cells whose side is at least the search distance, so that the nearest point within that distance is in one of the 27 cells around the query.
+	 * The points are stored in a pcl cloud whose slots are reused, the slots of removed points hold NaN coordinates and are never returned by a search.
+	 */
+	class IncrementalTargetCloud
+	{
+		public:
+
+			/**
+			 * Adapter exposing the search cells of a target through the pcl search interface, pcl registration uses it in place of its own kd-tree when it is passed
+			 * with force_no_recompute, so no tree is built on the target cloud.
+			 */
+			class SearchTree : public pcl::search::KdTree<pcl::PointXYZ>
+			{
+				public:
+					typedef boost::shared_ptr<SearchTree> Ptr;
+
+					explicit SearchTree(const IncrementalTargetCloud& target);
+
+					using pcl::search::KdTree<pcl::PointXYZ>::nearestKSearch;
+					using pcl::search::KdTree<pcl::PointXYZ>::radiusSearch;
+
+					/**
+					 * Only the points within the search distance of the target are found. If no point is found, the output vectors hold a single sentinel at infinite
+					 * distance, since pcl correspondence estimation reads the first element without checking the returned number of points.
+					 */
+					int nearestKSearch(const pcl::PointXYZ& point, int k, std::vector<int>& indicesList, std::vector<float>& squaredDistancesList) const override;
+					int radiusSearch(const pcl::PointXYZ& point, double radius, std::vector<int>& indicesList, std::vector<float>& squaredDistancesList, unsigned int maximumNumberOfNeighbours = 0) const override;
+
+				private:
+					const IncrementalTargetCloud& target;
+			};
+
+			IncrementalTargetCloud();
+			~IncrementalTargetCloud();
+
+			/**
+			 * Sets the side of the voxels, the stored points are merged into the voxels of the new resolution.
+			 */
+			void SetResolution(float resolution);
+
+			/**
+			 * Adds the points of a cloud, either in the reference system of the target or in the reference system given by the pose of the cloud in the target.
+			 * Invalid points are skipped.
+			 */
+			void AddPoints(const PointCloudWrapper::PointCloud& cloud);
+			void AddPoints(const PointCloudWrapper::PointCloud& cloud, const PoseWrapper::Pose3D& cloudPose);
+
+			/**
+			 * Removes the points farther than radius from the position of center. Search cells entirely within the radius are not visited point by point.
+			 */
+			void RemovePointsOutside(const PoseWrapper::Pose3D& center, float radius);
+
+			void Clear();
+			unsigned GetNumberOfPoints() const;
+
+			/**
+			 * The cloud of the slots, it has to be used together with the search tree since the slots of removed points are not valid points.
+			 */
+			pcl::PointCloud<pcl::PointXYZ>::ConstPtr GetCloud() const;
+
+			/**
+			 * Retrieves the search tree for nearest neighbours within searchDistance, the search cells are rebuilt only if they are too small for searchDistance.
+			 */
+			SearchTree::Ptr GetSearchTree(float searchDistance);
+
+			/**
+			 * Finds the stored point nearest to a query within the search distance of the latest call to GetSearchTree.
+			 * @return the slot index of the point, or -1 if there is none.
+			 */
+			int FindNearestPoint(const pcl::PointXYZ& point, float& squaredDistance) const;
+
+		private:
+
+			static const float DEFAULT_RESOLUTION;
+
+			struct CellKey
+			{
+				int32_t x;
+				int32_t y;
+				int32_t z;
+				bool operator==(const CellKey& other) const
+				{
+					return x == other.x && y == other.y && z == other.z;
+				}
+			};
+
+			struct CellKeyHash
+			{
+				size_t operator()(const CellKey& key) const
+				{
+					return static_cast<size_t>( (static_cast<uint32_t>(key.x) * 73856093u) ^ (static_cast<uint32_t>(key.y) * 19349663u) ^ (static_cast<uint32_t>(key.z) * 83492791u) );
+				}
+			};
+
+			typedef std::unordered_map<CellKey, uint32_t, CellKeyHash> VoxelsMap;
+			typedef std::unordered_map<CellKey, std::vector<uint32_t>, CellKeyHash> SearchCellsMap;
+
+			float resolution;
+			int32_t searchCellFactor; //the side of a search cell in voxels
+			float searchDistance;
+
+			pcl::PointCloud<pcl::PointXYZ>::Ptr cloud;
+			std::vector<uint32_t> slotPointsCountList;
+			std::vector<CellKey> slotVoxelKeysList;
+			std::vector<uint32_t> freeSlotsList;
+			unsigned numberOfPoints;
+
+			VoxelsMap voxelsMap;
+			SearchCellsMap searchCellsMap;
+			SearchTree::Ptr searchTree;
+
+			void AddPoint(const pcl::PointXYZ& point);
+			void RemoveSlot(uint32_t slot);
+			void RebuildSearchCells();
+			void CollectNeighbours(const pcl::PointXYZ& point, float radius, std::vector<std::pair<float, int> >& neighboursList) const;
+
+			CellKey ComputeVoxelKey(const pcl::PointXYZ& point) const;
+			CellKey ComputeSearchCellKey(const CellKey& voxelKey) const;
+			static int32_t FloorDivide(int32_t dividend, int32_t divisor);
+	};
+}
+}
+}
+
+#endif // REGISTRATION3D_INCREMENTALTARGETCLOUD_HPP
+
+/** @} */
@@ -52,6 +52,11 @@ bool Registration3DInterface::successOutput() const
     return outSuccess;
 }
 
+bool Registration3DInterface::setSinkTarget(Registration3D::IncrementalTargetCloud* target)
+{
+    return (target == NULL);
+}
+
 }
 }
 
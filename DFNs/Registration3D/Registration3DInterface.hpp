@@ -14,6 +14,11 @@ namespace CDFF
 {
 namespace DFN
 {
+    namespace Registration3D
+    {
+        class IncrementalTargetCloud;
+    }
+
     /**
      * DFN that registers a source point cloud on a sink point cloud
      */
@@ -74,6 +79,18 @@ namespace DFN
              */
             virtual bool successOutput() const;
 
+            /**
+             * Replaces the input port "sinkCloud" by a sink maintained by the
+             * caller across calls, together with its search structure, so
+             * that the implementation does not rebuild a search structure on
+             * the sink at every call. The sink is in the coordinate frame of
+             * the output transform, so the transform guess should be used.
+             * A null target restores the input port "sinkCloud".
+             * @param target: the sink, it is not owned by the DFN
+             * @return whether the implementation supports an incremental sink
+             */
+            virtual bool setSinkTarget(Registration3D::IncrementalTargetCloud* target);
+
         protected:
 
             asn1SccPointcloud inSourceCloud;
@@ -82,6 +99,7 @@ namespace DFN
             bool inUseGuess = false;
             asn1SccPose outTransform;
             bool outSuccess = false;
+            Registration3D::IncrementalTargetCloud* sinkTarget = NULL;
     };
 }
 }
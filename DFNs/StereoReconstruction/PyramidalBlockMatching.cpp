@@ -0,0 +1,706 @@
+/**
+ * @author Alessandro Bianco
+ */
+
+/**
+ * @addtogroup DFNs
+ * @{
+ */
+
+#include "PyramidalBlockMatching.hpp"
+
+#include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+using namespace FrameWrapper;
+using namespace PointCloudWrapper;
+
+namespace CDFF
+{
+namespace DFN
+{
+namespace StereoReconstruction
+{
+
+namespace
+{
+	/**
+	 * The disparity in sixteenths of pixel of the minimum of the parabola through the costs of the best disparity and of its two neighbours
+	 */
+	int16_t ComputeSubpixelDisparity(int bestDisparity, int previousCost, int bestCost, int nextCost, int disparityScale)
+	{
+		int denominator = std::max(1, previousCost + nextCost - 2 * bestCost);
+		int subpixelOffset = ( (previousCost - nextCost) * disparityScale + denominator ) / (2 * denominator);
+		return static_cast<int16_t>(bestDisparity * disparityScale + subpixelOffset);
+	}
+
+	/**
+	 * Each pixel of the downsampled rows is the rounded average of a 2x2 block of the finer image
+	 */
+	void DownsampleRows(const std::vector<uint8_t>& image, int imageWidth, std::vector<uint8_t>& downsampledImage, int downsampledWidth, int firstRow, int endRow)
+	{
+		for (int row = firstRow; row < endRow; row++)
+		{
+			const uint8_t* upperRow = image.data() + (2 * row) * imageWidth;
+			const uint8_t* lowerRow = upperRow + imageWidth;
+			uint8_t* downsampledRow = downsampledImage.data() + row * downsampledWidth;
+			for (int column = 0; column < downsampledWidth; column++)
+			{
+				downsampledRow[column] = static_cast<uint8_t>( (upperRow[2 * column] + upperRow[2 * column + 1] + lowerRow[2 * column] + lowerRow[2 * column + 1] + 2) >> 2 );
+			}
+		}
+	}
+}
+
+PyramidalBlockMatching::PyramidalBlockMatching()
+{
+	parameters = DEFAULT_PARAMETERS;
+
+	parametersHelper.AddParameter<float>("ReconstructionSpace", "LimitX", parameters.reconstructionSpace.limitX, DEFAULT_PARAMETERS.reconstructionSpace.limitX);
+	parametersHelper.AddParameter<float>("ReconstructionSpace", "LimitY", parameters.reconstructionSpace.limitY, DEFAULT_PARAMETERS.reconstructionSpace.limitY);
+	parametersHelper.AddParameter<float>("ReconstructionSpace", "LimitZ", parameters.reconstructionSpace.limitZ, DEFAULT_PARAMETERS.reconstructionSpace.limitZ);
+
+	parametersHelper.AddParameter<int>("Disparities", "NumberOfIntervals", parameters.disparities.numberOfIntervals, DEFAULT_PARAMETERS.disparities.numberOfIntervals);
+	parametersHelper.AddParameter<int>("Disparities", "UniquenessRatio", parameters.disparities.uniquenessRatio, DEFAULT_PARAMETERS.disparities.uniquenessRatio);
+	parametersHelper.AddParameter<int>("Disparities", "MaximumLeftRightDifference", parameters.disparities.maximumLeftRightDifference, DEFAULT_PARAMETERS.disparities.maximumLeftRightDifference);
+
+	parametersHelper.AddParameter<int>("Pyramid", "NumberOfLevels", parameters.pyramid.numberOfLevels, DEFAULT_PARAMETERS.pyramid.numberOfLevels);
+	parametersHelper.AddParameter<int>("Pyramid", "SearchRadius", parameters.pyramid.searchRadius, DEFAULT_PARAMETERS.pyramid.searchRadius);
+	parametersHelper.AddParameter<int>("Pyramid", "BlockSize", parameters.pyramid.blockSize, DEFAULT_PARAMETERS.pyramid.blockSize);
+
+	parametersHelper.AddParameter<int>("GeneralParameters", "NumberOfThreads", parameters.numberOfThreads, DEFAULT_PARAMETERS.numberOfThreads);
+	parametersHelper.AddParameter<float>("GeneralParameters", "PointCloudSamplingDensity", parameters.pointCloudSamplingDensity, DEFAULT_PARAMETERS.pointCloudSamplingDensity);
+	parametersHelper.AddParameter<bool>("GeneralParameters", "UseDisparityToDepthMap", parameters.useDisparityToDepthMap, DEFAULT_PARAMETERS.useDisparityToDepthMap);
+
+	for (unsigned row = 0; row < 4; row++)
+	{
+		for (unsigned column = 0; column < 4; column++)
+		{
+			std::stringstream elementStream;
+			elementStream << "Element_" << row <<"_"<< column;
+			parametersHelper.AddParameter<double>("DisparityToDepthMap",elementStream.str(), parameters.disparityToDepthMap[4*row+column], DEFAULT_PARAMETERS.disparityToDepthMap[4*row+column]);
+		}
+	}
+
+	parametersHelper.AddParameter<float>("StereoCamera", "LeftFocalLength", parameters.stereoCameraParameters.leftFocalLength, DEFAULT_PARAMETERS.stereoCameraParameters.leftFocalLength);
+	parametersHelper.AddParameter<float>("StereoCamera", "LeftPrinciplePointX", parameters.stereoCameraParameters.leftPrinciplePointX, DEFAULT_PARAMETERS.stereoCameraParameters.leftPrinciplePointX);
+	parametersHelper.AddParameter<float>("StereoCamera", "LeftPrinciplePointY", parameters.stereoCameraParameters.leftPrinciplePointY, DEFAULT_PARAMETERS.stereoCameraParameters.leftPrinciplePointY);
+	parametersHelper.AddParameter<float>("StereoCamera", "Baseline", parameters.stereoCameraParameters.baseline, DEFAULT_PARAMETERS.stereoCameraParameters.baseline);
+
+	numberOfBands = 1;
+	imageWidth = 0;
+	imageHeight = 0;
+	configurationFilePath = "";
+}
+
+PyramidalBlockMatching::~PyramidalBlockMatching()
+{
+}
+
+void PyramidalBlockMatching::configure()
+{
+	parametersHelper.ReadFile(configurationFilePath);
+	ValidateParameters();
+
+	numberOfBands = parameters.numberOfThreads;
+	if (numberOfBands == 0)
+	{
+		numberOfBands = std::max(1u, std::thread::hardware_concurrency());
+	}
+	levelsList.clear();
+}
+
+void PyramidalBlockMatching::process()
+{
+	// Read data from input ports
+	ValidateInputs();
+	PrepareLevels();
+	PyramidLevel& finestLevel = levelsList.at(0);
+	ConvertToGrey(inLeft, finestLevel.leftImage);
+	ConvertToGrey(inRight, finestLevel.rightImage);
+
+	// Process data
+	{
+		TRACE_SCOPE_CATEGORY("PyramidalBlockMatching::ComputePyramid", "DFN");
+		for (unsigned levelIndex = 0; levelIndex < levelsList.size(); levelIndex++)
+		{
+			PyramidLevel& level = levelsList.at(levelIndex);
+			if (levelIndex > 0)
+			{
+				const PyramidLevel& finerLevel = levelsList.at(levelIndex - 1);
+				ProcessRowBands(level.height, [&](int firstRow, int endRow) { ComputeDownsampledImages(finerLevel, level, firstRow, endRow); });
+			}
+			ProcessRowBands(level.height, [&](int firstRow, int endRow)
+			{
+				ComputeCensus(level.leftImage, level, level.leftCensus, firstRow, endRow);
+				ComputeCensus(level.rightImage, level, level.rightCensus, firstRow, endRow);
+			});
+		}
+	}
+
+	{
+		TRACE_SCOPE_CATEGORY("PyramidalBlockMatching::ComputeDisparities", "DFN");
+		PyramidLevel& coarsestLevel = levelsList.back();
+		ProcessRowBands(coarsestLevel.height, [&](int firstRow, int endRow) { ComputeCoarsestDisparities(coarsestLevel, firstRow, endRow); });
+		for (int levelIndex = static_cast<int>(levelsList.size()) - 2; levelIndex >= 0; levelIndex--)
+		{
+			const PyramidLevel& coarserLevel = levelsList.at(levelIndex + 1);
+			PyramidLevel& level = levelsList.at(levelIndex);
+			ProcessRowBands(level.height, [&](int firstRow, int endRow) { RefineDisparities(coarserLevel, level, firstRow, endRow); });
+		}
+	}
+
+	#ifdef TESTING
+	disparityMatrix = cv::Mat(imageHeight, imageWidth, CV_16S, disparityImage.data()).clone();
+	#endif
+
+	// Write data to output port
+	ComputePointCloud();
+}
+
+const std::vector<int16_t>& PyramidalBlockMatching::GetDisparityImage() const
+{
+	return disparityImage;
+}
+
+const int16_t PyramidalBlockMatching::INVALID_DISPARITY = std::numeric_limits<int16_t>::min();
+const int PyramidalBlockMatching::DISPARITY_SCALE = 16;
+const int PyramidalBlockMatching::CENSUS_RADIUS = 2;
+const int PyramidalBlockMatching::MAXIMUM_PIXEL_COST = (2 * CENSUS_RADIUS + 1) * (2 * CENSUS_RADIUS + 1) - 1;
+
+const PyramidalBlockMatching::PyramidalBlockMatchingOptionsSet PyramidalBlockMatching::DEFAULT_PARAMETERS =
+{
+	//.reconstructionSpace =
+	{
+		/*.limitX =*/ 20,
+		/*.limitY =*/ 20,
+		/*.limitZ =*/ 10
+	},
+	//.disparities =
+	{
+		/*.numberOfIntervals =*/ 128,
+		/*.uniquenessRatio =*/ 5,
+		/*.maximumLeftRightDifference =*/ 1
+	},
+	//.pyramid =
+	{
+		/*.numberOfLevels =*/ 3,
+		/*.searchRadius =*/ 2,
+		/*.blockSize =*/ 5
+	},
+	/*.numberOfThreads =*/ 0,
+	/*.pointCloudSamplingDensity =*/ 1,
+	/*.useDisparityToDepthMap =*/ false,
+	//.disparityToDepthMap =
+	{
+		1, 0, 0, 0,
+		0, 1, 0, 0,
+		0, 0, 0, 1,
+		0, 0, -1, 0
+	},
+	//.stereoCameraParameters =
+	{
+		/*.leftFocalLength =*/ 1,
+		/*.leftPrinciplePointX =*/ 0,
+		/*.leftPrinciplePointY =*/ 0,
+		/*.baseline =*/ 1
+	}
+};
+
+void PyramidalBlockMatching::ConvertToGrey(const Frame& frame, std::vector<uint8_t>& greyImage)
+{
+	const int numberOfPixels = imageWidth * imageHeight;
+	const uint8_t* data = reinterpret_cast<const uint8_t*>(frame.data.data.arr);
+
+	FrameMode mode = GetFrameMode(frame);
+	if (mode == MODE_GRAYSCALE)
+	{
+		std::copy(data, data + numberOfPixels, greyImage.begin());
+		return;
+	}
+
+	//Integer approximation of 0.299 R + 0.587 G + 0.114 B
+	const int redIndex = (mode == MODE_RGB) ? 0 : 2;
+	const int blueIndex = 2 - redIndex;
+	for (int pixelIndex = 0; pixelIndex < numberOfPixels; pixelIndex++)
+	{
+		const uint8_t* pixel = data + 3 * pixelIndex;
+		greyImage[pixelIndex] = static_cast<uint8_t>( (77 * pixel[redIndex] + 150 * pixel[1] + 29 * pixel[blueIndex] + 128) >> 8 );
+	}
+}
+
+/**
+ * Each level halves the size of the finer one and the number of disparities, rounding the disparities up. Levels are added while the coarsest one can hold a matching block.
+ */
+void PyramidalBlockMatching::PrepareLevels()
+{
+	int numberOfLevels = 1;
+	while (numberOfLevels < parameters.pyramid.numberOfLevels && (imageWidth >> numberOfLevels) >= parameters.pyramid.blockSize &&
+		(imageHeight >> numberOfLevels) >= parameters.pyramid.blockSize)
+	{
+		numberOfLevels++;
+	}
+
+	disparityImage.resize(imageWidth * imageHeight);
+	if (static_cast<int>(levelsList.size()) == numberOfLevels && levelsList.at(0).width == imageWidth && levelsList.at(0).height == imageHeight)
+	{
+		return;
+	}
+
+	levelsList.clear();
+	levelsList.resize(numberOfLevels);
+	for (int levelIndex = 0; levelIndex < numberOfLevels; levelIndex++)
+	{
+		PyramidLevel& level = levelsList.at(levelIndex);
+		level.width = imageWidth >> levelIndex;
+		level.height = imageHeight >> levelIndex;
+		level.numberOfDisparities = std::max(1, (parameters.disparities.numberOfIntervals + (1 << levelIndex) - 1) >> levelIndex);
+
+		const int numberOfPixels = level.width * level.height;
+		level.leftImage.resize(numberOfPixels);
+		level.rightImage.resize(numberOfPixels);
+		level.leftCensus.resize(numberOfPixels);
+		level.rightCensus.resize(numberOfPixels);
+		//The finest level writes its disparities directly into the disparity image
+		if (levelIndex > 0)
+		{
+			level.disparities.resize(numberOfPixels);
+		}
+	}
+}
+
+void PyramidalBlockMatching::ComputeDownsampledImages(const PyramidLevel& finerLevel, PyramidLevel& level, int firstRow, int endRow)
+{
+	DownsampleRows(finerLevel.leftImage, finerLevel.width, level.leftImage, level.width, firstRow, endRow);
+	DownsampleRows(finerLevel.rightImage, finerLevel.width, level.rightImage, level.width, firstRow, endRow);
+}
+
+/**
+ * Each bit of the census signature of a pixel tells whether a pixel of the 5x5 window around it is darker than the pixel itself, the window is clamped at the image borders.
+ */
+void PyramidalBlockMatching::ComputeCensus(const std::vector<uint8_t>& image, const PyramidLevel& level, std::vector<uint32_t>& census, int firstRow, int endRow)
+{
+	for (int row = firstRow; row < endRow; row++)
+	{
+		const uint8_t* centerRow = image.data() + row * level.width;
+		uint32_t* censusRow = census.data() + row * level.width;
+		for (int column = 0; column < level.width; column++)
+		{
+			const uint8_t center = centerRow[column];
+			uint32_t signature = 0;
+			for (int windowRow = -CENSUS_RADIUS; windowRow <= CENSUS_RADIUS; windowRow++)
+			{
+				const uint8_t* neighbourRow = image.data() + std::min(level.height - 1, std::max(0, row + windowRow)) * level.width;
+				for (int windowColumn = -CENSUS_RADIUS; windowColumn <= CENSUS_RADIUS; windowColumn++)
+				{
+					const int neighbourColumn = std::min(level.width - 1, std::max(0, column + windowColumn));
+					signature = (signature << 1) | ( (neighbourRow[neighbourColumn] < center) ? 1 : 0 );
+				}
+			}
+			censusRow[column] = signature;
+		}
+	}
+}
+
+/**
+ * The costs of all the disparities of the band are computed at once: for each disparity the pixel costs of a row are summed over the block width with a sliding window,
+ * and the row sums over the block height. The disparity of a pixel is the one of minimum cost, if no disparity that is not adjacent to it has a cost within the uniqueness
+ * margin and if it agrees with the disparity of the matched right pixel, which is the disparity of minimum cost among the left pixels matching that right pixel.
+ */
+void PyramidalBlockMatching::ComputeCoarsestDisparities(PyramidLevel& level, int firstRow, int endRow)
+{
+	const int width = level.width;
+	const int numberOfDisparities = level.numberOfDisparities;
+	const int halfBlock = parameters.pyramid.blockSize / 2;
+	const int numberOfRows = endRow - firstRow;
+	const int numberOfSummedRows = numberOfRows + 2 * halfBlock;
+	const bool finestLevel = (&level == &levelsList.at(0));
+
+	std::vector<int16_t> costs(numberOfRows * width * numberOfDisparities);
+	std::vector<int> pixelCosts(width);
+	std::vector<int> rowSums(numberOfSummedRows * width);
+	for (int disparity = 0; disparity < numberOfDisparities; disparity++)
+	{
+		for (int summedRow = 0; summedRow < numberOfSummedRows; summedRow++)
+		{
+			const int row = std::min(level.height - 1, std::max(0, firstRow - halfBlock + summedRow));
+			const uint32_t* leftCensusRow = level.leftCensus.data() + row * width;
+			const uint32_t* rightCensusRow = level.rightCensus.data() + row * width;
+			for (int column = 0; column < width; column++)
+			{
+				pixelCosts[column] = (column >= disparity) ? __builtin_popcount(leftCensusRow[column] ^ rightCensusRow[column - disparity]) : MAXIMUM_PIXEL_COST;
+			}
+
+			int sum = 0;
+			for (int column = -halfBlock; column <= halfBlock; column++)
+			{
+				sum += pixelCosts[std::min(width - 1, std::max(0, column))];
+			}
+			int* sumsRow = rowSums.data() + summedRow * width;
+			for (int column = 0; column < width; column++)
+			{
+				sumsRow[column] = sum;
+				sum += pixelCosts[std::min(width - 1, column + halfBlock + 1)] - pixelCosts[std::max(0, column - halfBlock)];
+			}
+		}
+
+		for (int row = 0; row < numberOfRows; row++)
+		{
+			int16_t* costsRow = costs.data() + row * width * numberOfDisparities;
+			for (int column = 0; column < width; column++)
+			{
+				int blockCost = 0;
+				for (int summedRow = row; summedRow <= row + 2 * halfBlock; summedRow++)
+				{
+					blockCost += rowSums[summedRow * width + column];
+				}
+				costsRow[column * numberOfDisparities + disparity] = static_cast<int16_t>(blockCost);
+			}
+		}
+	}
+
+	const int uniquenessRatio = parameters.disparities.uniquenessRatio;
+	const bool checkLeftRight = (parameters.disparities.maximumLeftRightDifference >= 0);
+	std::vector<int> rightMinimumCosts(width);
+	std::vector<int> rightDisparities(width);
+	for (int row = 0; row < numberOfRows; row++)
+	{
+		const int16_t* costsRow = costs.data() + row * width * numberOfDisparities;
+		int16_t* disparityRow = finestLevel ? (disparityImage.data() + (firstRow + row) * width) : (level.disparities.data() + (firstRow + row) * width);
+		if (checkLeftRight)
+		{
+			std::fill(rightMinimumCosts.begin(), rightMinimumCosts.end(), std::numeric_limits<int>::max());
+			std::fill(rightDisparities.begin(), rightDisparities.end(), -1);
+		}
+
+		for (int column = 0; column < width; column++)
+		{
+			const int16_t* pixelCosts = costsRow + column * numberOfDisparities;
+			int bestDisparity = 0;
+			for (int disparity = 1; disparity < numberOfDisparities; disparity++)
+			{
+				if (pixelCosts[disparity] < pixelCosts[bestDisparity])
+				{
+					bestDisparity = disparity;
+				}
+			}
+
+			if (checkLeftRight)
+			{
+				for (int disparity = 0; disparity <= std::min(column, numberOfDisparities - 1); disparity++)
+				{
+					if (pixelCosts[disparity] < rightMinimumCosts[column - disparity])
+					{
+						rightMinimumCosts[column - disparity] = pixelCosts[disparity];
+						rightDisparities[column - disparity] = disparity;
+					}
+				}
+			}
+
+			int secondBestCost = std::numeric_limits<int>::max();
+			for (int disparity = 0; disparity < numberOfDisparities; disparity++)
+			{
+				if (std::abs(disparity - bestDisparity) > 1)
+				{
+					secondBestCost = std::min(secondBestCost, static_cast<int>(pixelCosts[disparity]));
+				}
+			}
+			const int bestCost = pixelCosts[bestDisparity];
+			bool unique = (secondBestCost == std::numeric_limits<int>::max() || secondBestCost * (100 - uniquenessRatio) >= bestCost * 100);
+			if (!unique || column < bestDisparity)
+			{
+				disparityRow[column] = INVALID_DISPARITY;
+			}
+			else if (finestLevel && bestDisparity > 0 && bestDisparity < numberOfDisparities - 1)
+			{
+				disparityRow[column] = ComputeSubpixelDisparity(bestDisparity, pixelCosts[bestDisparity - 1], bestCost, pixelCosts[bestDisparity + 1], DISPARITY_SCALE);
+			}
+			else
+			{
+				disparityRow[column] = static_cast<int16_t>( finestLevel ? bestDisparity * DISPARITY_SCALE : bestDisparity );
+			}
+		}
+
+		if (checkLeftRight)
+		{
+			const int scale = finestLevel ? DISPARITY_SCALE : 1;
+			for (int column = 0; column < width; column++)
+			{
+				if (disparityRow[column] == INVALID_DISPARITY)
+				{
+					continue;
+				}
+				int disparity = (disparityRow[column] + scale / 2) / scale;
+				if (column < disparity || std::abs(rightDisparities[column - disparity] - disparity) > parameters.disparities.maximumLeftRightDifference)
+				{
+					disparityRow[column] = INVALID_DISPARITY;
+				}
+			}
+		}
+	}
+}
+
+/**
+ * The search window of a pixel spans twice the smallest and twice the largest valid disparity of the 3x3 neighbourhood of the pixel at the coarser level, extended by the
+ * search radius. A pixel whose best disparity lies on a border of the window that does not come from the image is left without disparity, since its minimum may lie outside.
+ */
+void PyramidalBlockMatching::RefineDisparities(const PyramidLevel& coarserLevel, PyramidLevel& level, int firstRow, int endRow)
+{
+	const int searchRadius = parameters.pyramid.searchRadius;
+	const int uniquenessRatio = parameters.disparities.uniquenessRatio;
+	const bool finestLevel = (&level == &levelsList.at(0));
+	std::vector<int> windowCosts(level.numberOfDisparities);
+
+	for (int row = firstRow; row < endRow; row++)
+	{
+		int16_t* disparityRow = finestLevel ? (disparityImage.data() + row * level.width) : (level.disparities.data() + row * level.width);
+		const int coarserRow = std::min(coarserLevel.height - 1, row / 2);
+		for (int column = 0; column < level.width; column++)
+		{
+			const int coarserColumn = std::min(coarserLevel.width - 1, column / 2);
+			int smallestDisparity = std::numeric_limits<int>::max();
+			int largestDisparity = -1;
+			for (int neighbourRow = std::max(0, coarserRow - 1); neighbourRow <= std::min(coarserLevel.height - 1, coarserRow + 1); neighbourRow++)
+			{
+				const int16_t* coarserDisparityRow = coarserLevel.disparities.data() + neighbourRow * coarserLevel.width;
+				for (int neighbourColumn = std::max(0, coarserColumn - 1); neighbourColumn <= std::min(coarserLevel.width - 1, coarserColumn + 1); neighbourColumn++)
+				{
+					if (coarserDisparityRow[neighbourColumn] != INVALID_DISPARITY)
+					{
+						smallestDisparity = std::min(smallestDisparity, static_cast<int>(coarserDisparityRow[neighbourColumn]));
+						largestDisparity = std::max(largestDisparity, static_cast<int>(coarserDisparityRow[neighbourColumn]));
+					}
+				}
+			}
+
+			if (largestDisparity < 0)
+			{
+				disparityRow[column] = INVALID_DISPARITY;
+				continue;
+			}
+			const int largestSearchable = std::min(level.numberOfDisparities - 1, column);
+			const int lowestDisparity = std::max(0, 2 * smallestDisparity - searchRadius);
+			const int highestDisparity = std::min(largestSearchable, 2 * largestDisparity + searchRadius);
+			if (lowestDisparity > highestDisparity)
+			{
+				disparityRow[column] = INVALID_DISPARITY;
+				continue;
+			}
+
+			int bestDisparity = lowestDisparity;
+			for (int disparity = lowestDisparity; disparity <= highestDisparity; disparity++)
+			{
+				windowCosts[disparity - lowestDisparity] = ComputeBlockCost(level, row, column, disparity);
+				if (windowCosts[disparity - lowestDisparity] < windowCosts[bestDisparity - lowestDisparity])
+				{
+					bestDisparity = disparity;
+				}
+			}
+			if ( (bestDisparity == lowestDisparity && lowestDisparity > 0) || (bestDisparity == highestDisparity && highestDisparity < largestSearchable) )
+			{
+				disparityRow[column] = INVALID_DISPARITY;
+				continue;
+			}
+
+			const int bestCost = windowCosts[bestDisparity - lowestDisparity];
+			int secondBestCost = std::numeric_limits<int>::max();
+			for (int disparity = lowestDisparity; disparity <= highestDisparity; disparity++)
+			{
+				if (std::abs(disparity - bestDisparity) > 1)
+				{
+					secondBestCost = std::min(secondBestCost, windowCosts[disparity - lowestDisparity]);
+				}
+			}
+			if (secondBestCost != std::numeric_limits<int>::max() && secondBestCost * (100 - uniquenessRatio) < bestCost * 100)
+			{
+				disparityRow[column] = INVALID_DISPARITY;
+			}
+			else if (!finestLevel)
+			{
+				disparityRow[column] = static_cast<int16_t>(bestDisparity);
+			}
+			else if (bestDisparity > lowestDisparity && bestDisparity < highestDisparity)
+			{
+				disparityRow[column] = ComputeSubpixelDisparity(bestDisparity, windowCosts[bestDisparity - 1 - lowestDisparity], bestCost,
+					windowCosts[bestDisparity + 1 - lowestDisparity], DISPARITY_SCALE);
+			}
+			else
+			{
+				disparityRow[column] = static_cast<int16_t>(bestDisparity * DISPARITY_SCALE);
+			}
+		}
+
+		if (parameters.disparities.maximumLeftRightDifference >= 0)
+		{
+			InvalidateOccludedPixels(disparityRow, level.width, finestLevel ? DISPARITY_SCALE : 1);
+		}
+	}
+}
+
+/**
+ * Without the costs of the right image the left-right check of the finer levels relies on the ordering of the matches: a left pixel whose match in the right image
+ * lies beyond the match of a pixel on its right is hidden in the right image by a closer surface, so it keeps a disparity only if the difference is within the
+ * maximum left-right difference.
+ */
+void PyramidalBlockMatching::InvalidateOccludedPixels(int16_t* disparityRow, int width, int scale)
+{
+	int smallestRightColumn = std::numeric_limits<int>::max();
+	for (int column = width - 1; column >= 0; column--)
+	{
+		if (disparityRow[column] == INVALID_DISPARITY)
+		{
+			continue;
+		}
+		const int rightColumn = column - (disparityRow[column] + scale / 2) / scale;
+		if (rightColumn - smallestRightColumn > parameters.disparities.maximumLeftRightDifference)
+		{
+			disparityRow[column] = INVALID_DISPARITY;
+			continue;
+		}
+		smallestRightColumn = std::min(smallestRightColumn, rightColumn);
+	}
+}
+
+/**
+ * The sum of the Hamming distances of the census signatures over the block, the window is clamped at the image borders and the pixels matched outside the right image
+ * take the largest cost.
+ */
+int PyramidalBlockMatching::ComputeBlockCost(const PyramidLevel& level, int row, int column, int disparity)
+{
+	const int halfBlock = parameters.pyramid.blockSize / 2;
+	int cost = 0;
+	for (int windowRow = row - halfBlock; windowRow <= row + halfBlock; windowRow++)
+	{
+		const int clampedRow = std::min(level.height - 1, std::max(0, windowRow));
+		const uint32_t* leftCensusRow = level.leftCensus.data() + clampedRow * level.width;
+		const uint32_t* rightCensusRow = level.rightCensus.data() + clampedRow * level.width;
+		for (int windowColumn = column - halfBlock; windowColumn <= column + halfBlock; windowColumn++)
+		{
+			const int leftColumn = std::min(level.width - 1, std::max(0, windowColumn));
+			cost += (leftColumn >= disparity) ? __builtin_popcount(leftCensusRow[leftColumn] ^ rightCensusRow[leftColumn - disparity]) : MAXIMUM_PIXEL_COST;
+		}
+	}
+	return cost;
+}
+
+void PyramidalBlockMatching::ProcessRowBands(int numberOfRows, const std::function<void(int, int)>& bandFunction)
+{
+	const int numberOfUsedBands = std::max(1, std::min(numberOfBands, numberOfRows));
+	std::vector<std::thread> threadsList;
+	for (int bandIndex = 1; bandIndex < numberOfUsedBands; bandIndex++)
+	{
+		threadsList.push_back( std::thread(bandFunction, (numberOfRows * bandIndex) / numberOfUsedBands, (numberOfRows * (bandIndex + 1)) / numberOfUsedBands) );
+	}
+	bandFunction(0, numberOfRows / numberOfUsedBands);
+	for (unsigned threadIndex = 0; threadIndex < threadsList.size(); threadIndex++)
+	{
+		threadsList.at(threadIndex).join();
+	}
+}
+
+/**
+ * The points are written directly into the output point cloud, keeping one valid point every 1/pointCloudSamplingDensity.
+ */
+void PyramidalBlockMatching::ComputePointCloud()
+{
+	TRACE_SCOPE_CATEGORY("PyramidalBlockMatching::ComputePointCloud", "DFN");
+	ClearPoints(outPointcloud);
+
+	unsigned validPointCount = 0;
+	unsigned pickUpPeriod = static_cast<unsigned>(1 / parameters.pointCloudSamplingDensity);
+	int numberOfPoints = 0;
+	for (int row = 0; row < imageHeight; row++)
+	{
+		for (int column = 0; column < imageWidth && numberOfPoints < MAX_CLOUD_SIZE; column++)
+		{
+			int16_t disparity = disparityImage[row * imageWidth + column];
+			float x, y, z;
+			if (disparity == INVALID_DISPARITY || !ComputePoint(row, column, static_cast<float>(disparity) / DISPARITY_SCALE, x, y, z))
+			{
+				continue;
+			}
+			validPointCount++;
+			if (validPointCount % pickUpPeriod == 0)
+			{
+				AddPoint(outPointcloud, x, y, z);
+				numberOfPoints++;
+			}
+		}
+	}
+}
+
+bool PyramidalBlockMatching::ComputePoint(int row, int column, float disparity, float& x, float& y, float& z)
+{
+	if (parameters.useDisparityToDepthMap)
+	{
+		const double* map = parameters.disparityToDepthMap;
+		double homogeneousX = map[0] * column + map[1] * row + map[2] * disparity + map[3];
+		double homogeneousY = map[4] * column + map[5] * row + map[6] * disparity + map[7];
+		double homogeneousZ = map[8] * column + map[9] * row + map[10] * disparity + map[11];
+		double homogeneousW = map[12] * column + map[13] * row + map[14] * disparity + map[15];
+		if (homogeneousW == 0)
+		{
+			return false;
+		}
+		x = homogeneousX / homogeneousW;
+		y = homogeneousY / homogeneousW;
+		z = homogeneousZ / homogeneousW;
+	}
+	else
+	{
+		if (disparity <= 0)
+		{
+			return false;
+		}
+		const StereoCameraParameters& camera = parameters.stereoCameraParameters;
+		z = camera.baseline * camera.leftFocalLength / disparity;
+		x = (static_cast<float>(column) - camera.leftPrinciplePointX) * z / camera.leftFocalLength;
+		y = (static_cast<float>(row) - camera.leftPrinciplePointY) * z / camera.leftFocalLength;
+	}
+
+	return std::abs(x) <= parameters.reconstructionSpace.limitX && std::abs(y) <= parameters.reconstructionSpace.limitY &&
+		z > 0 && z <= parameters.reconstructionSpace.limitZ;
+}
+
+void PyramidalBlockMatching::ValidateParameters()
+{
+	ASSERT(parameters.disparities.numberOfIntervals > 0, "PyramidalBlockMatching Configuration Error: number of disparities has to be positive");
+	ASSERT(parameters.disparities.uniquenessRatio >= 0 && parameters.disparities.uniquenessRatio < 100, "PyramidalBlockMatching Configuration Error: UniquenessRatio has to be in [0, 100)");
+	ASSERT(parameters.pyramid.numberOfLevels >= 1, "PyramidalBlockMatching Configuration Error: NumberOfLevels has to be at least 1");
+	ASSERT(parameters.pyramid.searchRadius >= 1, "PyramidalBlockMatching Configuration Error: SearchRadius has to be at least 1");
+	ASSERT(parameters.pyramid.blockSize % 2 == 1 && parameters.pyramid.blockSize <= 21, "PyramidalBlockMatching Configuration Error: BlockSize has to be odd and at most 21 for 16 bit costs");
+	ASSERT(parameters.numberOfThreads >= 0, "PyramidalBlockMatching Configuration Error: NumberOfThreads cannot be negative");
+	ASSERT( parameters.reconstructionSpace.limitX > 0, "PyramidalBlockMatching Configuration Error: Limits for reconstruction space have to be positive");
+	ASSERT( parameters.reconstructionSpace.limitY > 0, "PyramidalBlockMatching Configuration Error: Limits for reconstruction space have to be positive");
+	ASSERT( parameters.reconstructionSpace.limitZ > 0, "PyramidalBlockMatching Configuration Error: Limits for reconstruction space have to be positive");
+	ASSERT( parameters.stereoCameraParameters.leftFocalLength > 0, "PyramidalBlockMatching Configuration Error: Focal Length has to be positive");
+	ASSERT( parameters.stereoCameraParameters.baseline > 0, "PyramidalBlockMatching Configuration Error: Baseline has to be positive");
+	ASSERT(parameters.pointCloudSamplingDensity > 0 && parameters.pointCloudSamplingDensity <= 1, "PyramidalBlockMatching Configuration Error: pointCloudSamplingDensity has to be in the set (0, 1]");
+}
+
+void PyramidalBlockMatching::ValidateInputs()
+{
+	ASSERT(GetFrameWidth(inLeft) == GetFrameWidth(inRight) && GetFrameHeight(inLeft) == GetFrameHeight(inRight), "PyramidalBlockMatching Error: left and right images have different sizes");
+	ASSERT(GetFrameMode(inLeft) == GetFrameMode(inRight), "PyramidalBlockMatching Error: left and right images have different modes");
+	FrameMode mode = GetFrameMode(inLeft);
+	ASSERT(mode == MODE_GRAYSCALE || mode == MODE_RGB || mode == MODE_BGR, "PyramidalBlockMatching Error: only grayscale, RGB and BGR images are supported");
+
+	imageWidth = GetFrameWidth(inLeft);
+	imageHeight = GetFrameHeight(inLeft);
+	int channels = (mode == MODE_GRAYSCALE) ? 1 : 3;
+	ASSERT(GetNumberOfDataBytes(inLeft) == imageWidth * imageHeight * channels && GetNumberOfDataBytes(inRight) == imageWidth * imageHeight * channels,
+		"PyramidalBlockMatching Error: image data size does not match image dimensions");
+	ASSERT(imageWidth > 0 && imageHeight > 0, "PyramidalBlockMatching Error: empty images");
+}
+
+}
+}
+}
+
+/** @} */
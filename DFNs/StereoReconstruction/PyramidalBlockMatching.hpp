@@ -0,0 +1,190 @@
+/**
+ * @author Alessandro Bianco
+ */
+
+/**
+ * @addtogroup DFNs
+ * @{
+ */
+
+#ifndef STEREORECONSTRUCTION_PYRAMIDALBLOCKMATCHING_HPP
+#define STEREORECONSTRUCTION_PYRAMIDALBLOCKMATCHING_HPP
+
+#include "StereoReconstructionInterface.hpp"
+
+#include <Types/CPP/Frame.hpp>
+#include <Types/CPP/PointCloud.hpp>
+#include <Helpers/ParametersListHelper.hpp>
+
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+namespace CDFF
+{
+namespace DFN
+{
+namespace StereoReconstruction
+{
+	/**
+	 * Scene reconstruction (as a 3D pointcloud) from 2D rectified stereo images, using coarse-to-fine block matching on an image pyramid.
+	 * The implementation does not depend on OpenCV or PCL.
+	 *
+	 * Processing steps: (i) grayscaling of the images and construction of a pyramid by 2x2 averaging, (ii) census transform of every level on a 5x5 window,
+	 * (iii) block matching of the census signatures over the full disparity range at the coarsest level, with a uniqueness check and a left-right check,
+	 * (iv) at each finer level, block matching of every pixel only within a narrow window around twice the disparities of its 3x3 neighbourhood at the coarser level,
+	 * (v) sub-pixel parabola fit at the finest level, (vi) scene reconstruction written directly into the output pointcloud.
+	 *
+	 * The full disparity range is searched only at the coarsest level, which has 4^(numberOfLevels-1) times fewer pixels and 2^(numberOfLevels-1) times fewer disparities
+	 * than the images, so the work at the finer levels grows with the number of pixels and not with the number of disparities. Each level is split into row bands
+	 * processed by parallel threads.
+	 *
+	 * @param disparities.numberOfIntervals
+	 *        the number of disparities searched at full resolution, starting from zero
+	 * @param disparities.uniquenessRatio
+	 *        margin in percentage by which the best cost has to win over the cost of any disparity not adjacent to the best one
+	 * @param disparities.maximumLeftRightDifference
+	 *        the maximum difference in pixels between the left and the right disparity of a pixel at the coarsest level, and between the right image matches of pixels
+	 *        that break the left to right ordering at the finer levels; a negative value disables the left-right check
+	 *
+	 * @param pyramid.numberOfLevels
+	 *        the number of pyramid levels including the full resolution one, fewer levels are used if the coarsest level would be smaller than the matching block
+	 * @param pyramid.searchRadius
+	 *        the number of disparities searched at a finer level on each side of the disparities predicted by the coarser level
+	 * @param pyramid.blockSize
+	 *        the side of the square block whose census costs are summed, it must be odd
+	 *
+	 * @param numberOfThreads
+	 *        the number of threads and of row bands, zero means the number of hardware threads
+	 *
+	 * @param pointCloudSamplingDensity
+	 *        downsampling ratio in (0, 1]: only one valid point every 1/pointCloudSamplingDensity is added to the pointcloud.
+	 *
+	 * @param useDisparityToDepthMap
+	 *        defines whether the camera parameters are provided as a disparity-to-depth matrix or as the focal length, principle points, and baseline
+	 * @param disparityToDepthMap
+	 *        camera parameters in the form of a 4-by-4 disparity-to-depth matrix: provide the elements of this matrix via parameters called Element_X_Y, where X and Y are between 0 and 3
+	 * @param stereoCameraParameters
+	 *        camera parameters in the form of the focal length and principal point of the left camera and the distance between the two cameras:
+	 *        the parameters to use to provide this information are called LeftFocalLength, LeftPrinciplePointX, LeftPrinciplePointY, and Baseline, respectively
+	 * @param reconstructionSpace
+	 *        a bounding box for the reconstructed scene, provided via parameters called LimitX, LimitY, LimitZ. A reconstructed point
+	 *        of coordinates (x,y,z) is accepted into the pointcloud if -LimitX <= x <= LimitX, -LimitY <= y <= LimitY, 0 < z <= LimitZ.
+	 */
+	class PyramidalBlockMatching : public StereoReconstructionInterface
+	{
+		public:
+
+			PyramidalBlockMatching();
+			virtual ~PyramidalBlockMatching();
+
+			virtual void configure() override;
+			virtual void process() override;
+
+			/**
+			 * The disparity of each pixel of the latest processed left image in sixteenths of pixel, row by row, INVALID_DISPARITY where no disparity was found.
+			 */
+			const std::vector<int16_t>& GetDisparityImage() const;
+
+			static const int16_t INVALID_DISPARITY;
+			static const int DISPARITY_SCALE;
+
+		private:
+
+			static const int CENSUS_RADIUS;
+			static const int MAXIMUM_PIXEL_COST;
+
+			//DFN Parameters
+			struct ReconstructionSpace
+			{
+				float limitX;
+				float limitY;
+				float limitZ;
+			};
+
+			struct DisparitiesOptionsSet
+			{
+				int numberOfIntervals;
+				int uniquenessRatio;
+				int maximumLeftRightDifference;
+			};
+
+			struct PyramidOptionsSet
+			{
+				int numberOfLevels;
+				int searchRadius;
+				int blockSize;
+			};
+
+			struct StereoCameraParameters
+			{
+				float leftFocalLength;
+				float leftPrinciplePointX;
+				float leftPrinciplePointY;
+				float baseline;
+			};
+
+			typedef double DisparityToDepthMap[16];
+			struct PyramidalBlockMatchingOptionsSet
+			{
+				ReconstructionSpace reconstructionSpace;
+				DisparitiesOptionsSet disparities;
+				PyramidOptionsSet pyramid;
+				int numberOfThreads;
+				float pointCloudSamplingDensity;
+				bool useDisparityToDepthMap;
+				DisparityToDepthMap disparityToDepthMap;
+				StereoCameraParameters stereoCameraParameters;
+			};
+
+			Helpers::ParametersListHelper parametersHelper;
+			PyramidalBlockMatchingOptionsSet parameters;
+			static const PyramidalBlockMatchingOptionsSet DEFAULT_PARAMETERS;
+
+			//The images and the results of one pyramid level, they are kept across calls so that no memory is allocated when the image size does not change
+			struct PyramidLevel
+			{
+				int width;
+				int height;
+				int numberOfDisparities;
+				std::vector<uint8_t> leftImage;
+				std::vector<uint8_t> rightImage;
+				std::vector<uint32_t> leftCensus;
+				std::vector<uint32_t> rightCensus;
+				std::vector<int16_t> disparities; //whole pixel disparities, INVALID_DISPARITY where no disparity was found
+			};
+
+			int numberOfBands;
+			int imageWidth;
+			int imageHeight;
+			std::vector<PyramidLevel> levelsList;
+			std::vector<int16_t> disparityImage;
+
+			//Core computation methods
+			void ConvertToGrey(const FrameWrapper::Frame& frame, std::vector<uint8_t>& greyImage);
+			void PrepareLevels();
+			void ComputeDownsampledImages(const PyramidLevel& finerLevel, PyramidLevel& level, int firstRow, int endRow);
+			void ComputeCensus(const std::vector<uint8_t>& image, const PyramidLevel& level, std::vector<uint32_t>& census, int firstRow, int endRow);
+			void ComputeCoarsestDisparities(PyramidLevel& level, int firstRow, int endRow);
+			void RefineDisparities(const PyramidLevel& coarserLevel, PyramidLevel& level, int firstRow, int endRow);
+			int ComputeBlockCost(const PyramidLevel& level, int row, int column, int disparity);
+			void InvalidateOccludedPixels(int16_t* disparityRow, int width, int scale);
+			void ComputePointCloud();
+			bool ComputePoint(int row, int column, float disparity, float& x, float& y, float& z);
+
+			/**
+			 * Splits the rows of a level into bands and calls the function on each band, each band in its own thread and the first band in the calling thread.
+			 */
+			void ProcessRowBands(int numberOfRows, const std::function<void(int, int)>& bandFunction);
+
+			//Input Validation methods
+			void ValidateParameters();
+			void ValidateInputs();
+	};
+}
+}
+}
+
+#endif // STEREORECONSTRUCTION_PYRAMIDALBLOCKMATCHING_HPP
+
+/** @} */
@@ -0,0 +1,794 @@
+/**
+ * @author Alessandro Bianco
+ */
+
+/**
+ * @addtogroup DFNs
+ * @{
+ */
+
+#include "SemiGlobalMatching.hpp"
+
+#include <Errors/Assert.hpp>
+#include <Helpers/DisparityRangeHelper.hpp>
+#include <Macros/TracingMacros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+	#include <immintrin.h>
+	#define SGM_HAVE_X86_SIMD
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#include <arm_neon.h>
+	#define SGM_HAVE_NEON
+#endif
+
+using namespace FrameWrapper;
+using namespace PointCloudWrapper;
+
+namespace CDFF
+{
+namespace DFN
+{
+namespace StereoReconstruction
+{
+
+namespace
+{
+	const int16_t PADDING_COST = std::numeric_limits<int16_t>::max();
+
+	int16_t UpdatePathScalar(const int16_t* cost, const int16_t* previous, int16_t previousMinimum, int16_t* current, int16_t* sum,
+		int numberOfDisparities, int16_t smallPenalty, int16_t largePenalty)
+	{
+		const int jumpCost = previousMinimum + largePenalty;
+		int16_t currentMinimum = PADDING_COST;
+		for (int disparity = 0; disparity < numberOfDisparities; disparity++)
+		{
+			int best = std::min( static_cast<int>(previous[disparity + 1]), jumpCost );
+			best = std::min(best, previous[disparity] + smallPenalty);
+			best = std::min(best, previous[disparity + 2] + smallPenalty);
+			int16_t value = static_cast<int16_t>( cost[disparity] + best - previousMinimum );
+			current[disparity + 1] = value;
+			sum[disparity] += value;
+			currentMinimum = std::min(currentMinimum, value);
+		}
+		return currentMinimum;
+	}
+
+#ifdef SGM_HAVE_X86_SIMD
+	int16_t UpdatePathSse2(const int16_t* cost, const int16_t* previous, int16_t previousMinimum, int16_t* current, int16_t* sum,
+		int numberOfDisparities, int16_t smallPenalty, int16_t largePenalty)
+	{
+		const __m128i smallPenaltyVector = _mm_set1_epi16(smallPenalty);
+		const __m128i jumpCostVector = _mm_set1_epi16( static_cast<int16_t>(previousMinimum + largePenalty) );
+		const __m128i previousMinimumVector = _mm_set1_epi16(previousMinimum);
+		__m128i minimumVector = _mm_set1_epi16(PADDING_COST);
+		for (int disparity = 0; disparity < numberOfDisparities; disparity += 8)
+		{
+			__m128i best = _mm_min_epi16( _mm_loadu_si128( reinterpret_cast<const __m128i*>(previous + disparity + 1) ), jumpCostVector );
+			best = _mm_min_epi16( best, _mm_adds_epi16( _mm_loadu_si128( reinterpret_cast<const __m128i*>(previous + disparity) ), smallPenaltyVector ) );
+			best = _mm_min_epi16( best, _mm_adds_epi16( _mm_loadu_si128( reinterpret_cast<const __m128i*>(previous + disparity + 2) ), smallPenaltyVector ) );
+			__m128i value = _mm_sub_epi16( _mm_add_epi16( _mm_loadu_si128( reinterpret_cast<const __m128i*>(cost + disparity) ), best ), previousMinimumVector );
+			_mm_storeu_si128( reinterpret_cast<__m128i*>(current + disparity + 1), value );
+			__m128i* sumPointer = reinterpret_cast<__m128i*>(sum + disparity);
+			_mm_storeu_si128( sumPointer, _mm_add_epi16( _mm_loadu_si128(sumPointer), value ) );
+			minimumVector = _mm_min_epi16(minimumVector, value);
+		}
+		minimumVector = _mm_min_epi16( minimumVector, _mm_srli_si128(minimumVector, 8) );
+		minimumVector = _mm_min_epi16( minimumVector, _mm_srli_si128(minimumVector, 4) );
+		minimumVector = _mm_min_epi16( minimumVector, _mm_srli_si128(minimumVector, 2) );
+		return static_cast<int16_t>( _mm_extract_epi16(minimumVector, 0) );
+	}
+
+	__attribute__((target("avx2")))
+	int16_t UpdatePathAvx2(const int16_t* cost, const int16_t* previous, int16_t previousMinimum, int16_t* current, int16_t* sum,
+		int numberOfDisparities, int16_t smallPenalty, int16_t largePenalty)
+	{
+		const __m256i smallPenaltyVector = _mm256_set1_epi16(smallPenalty);
+		const __m256i jumpCostVector = _mm256_set1_epi16( static_cast<int16_t>(previousMinimum + largePenalty) );
+		const __m256i previousMinimumVector = _mm256_set1_epi16(previousMinimum);
+		__m256i minimumVector = _mm256_set1_epi16(PADDING_COST);
+		for (int disparity = 0; disparity < numberOfDisparities; disparity += 16)
+		{
+			__m256i best = _mm256_min_epi16( _mm256_loadu_si256( reinterpret_cast<const __m256i*>(previous + disparity + 1) ), jumpCostVector );
+			best = _mm256_min_epi16( best, _mm256_adds_epi16( _mm256_loadu_si256( reinterpret_cast<const __m256i*>(previous + disparity) ), smallPenaltyVector ) );
+			best = _mm256_min_epi16( best, _mm256_adds_epi16( _mm256_loadu_si256( reinterpret_cast<const __m256i*>(previous + disparity + 2) ), smallPenaltyVector ) );
+			__m256i value = _mm256_sub_epi16( _mm256_add_epi16( _mm256_loadu_si256( reinterpret_cast<const __m256i*>(cost + disparity) ), best ), previousMinimumVector );
+			_mm256_storeu_si256( reinterpret_cast<__m256i*>(current + disparity + 1), value );
+			__m256i* sumPointer = reinterpret_cast<__m256i*>(sum + disparity);
+			_mm256_storeu_si256( sumPointer, _mm256_add_epi16( _mm256_loadu_si256(sumPointer), value ) );
+			minimumVector = _mm256_min_epi16(minimumVector, value);
+		}
+		__m128i halfMinimumVector = _mm_min_epi16( _mm256_castsi256_si128(minimumVector), _mm256_extracti128_si256(minimumVector, 1) );
+		halfMinimumVector = _mm_minpos_epu16( _mm_xor_si128(halfMinimumVector, _mm_set1_epi16(static_cast<int16_t>(0x8000))) );
+		return static_cast<int16_t>( _mm_extract_epi16(halfMinimumVector, 0) ^ 0x8000 );
+	}
+#endif
+
+#ifdef SGM_HAVE_NEON
+	int16_t UpdatePathNeon(const int16_t* cost, const int16_t* previous, int16_t previousMinimum, int16_t* current, int16_t* sum,
+		int numberOfDisparities, int16_t smallPenalty, int16_t largePenalty)
+	{
+		const int16x8_t smallPenaltyVector = vdupq_n_s16(smallPenalty);
+		const int16x8_t jumpCostVector = vdupq_n_s16( static_cast<int16_t>(previousMinimum + largePenalty) );
+		const int16x8_t previousMinimumVector = vdupq_n_s16(previousMinimum);
+		int16x8_t minimumVector = vdupq_n_s16(PADDING_COST);
+		for (int disparity = 0; disparity < numberOfDisparities; disparity += 8)
+		{
+			int16x8_t best = vminq_s16( vld1q_s16(previous + disparity + 1), jumpCostVector );
+			best = vminq_s16( best, vqaddq_s16( vld1q_s16(previous + disparity), smallPenaltyVector ) );
+			best = vminq_s16( best, vqaddq_s16( vld1q_s16(previous + disparity + 2), smallPenaltyVector ) );
+			int16x8_t value = vsubq_s16( vaddq_s16( vld1q_s16(cost + disparity), best ), previousMinimumVector );
+			vst1q_s16(current + disparity + 1, value);
+			vst1q_s16( sum + disparity, vaddq_s16( vld1q_s16(sum + disparity), value ) );
+			minimumVector = vminq_s16(minimumVector, value);
+		}
+		int16x4_t halfMinimumVector = vmin_s16( vget_low_s16(minimumVector), vget_high_s16(minimumVector) );
+		halfMinimumVector = vpmin_s16(halfMinimumVector, halfMinimumVector);
+		halfMinimumVector = vpmin_s16(halfMinimumVector, halfMinimumVector);
+		return vget_lane_s16(halfMinimumVector, 0);
+	}
+#endif
+}
+
+SemiGlobalMatching::SemiGlobalMatching()
+{
+	parameters = DEFAULT_PARAMETERS;
+
+	parametersHelper.AddParameter<float>("ReconstructionSpace", "LimitX", parameters.reconstructionSpace.limitX, DEFAULT_PARAMETERS.reconstructionSpace.limitX);
+	parametersHelper.AddParameter<float>("ReconstructionSpace", "LimitY", parameters.reconstructionSpace.limitY, DEFAULT_PARAMETERS.reconstructionSpace.limitY);
+	parametersHelper.AddParameter<float>("ReconstructionSpace", "LimitZ", parameters.reconstructionSpace.limitZ, DEFAULT_PARAMETERS.reconstructionSpace.limitZ);
+
+	parametersHelper.AddParameter<int>("Disparities", "Minimum", parameters.disparities.minimum, DEFAULT_PARAMETERS.disparities.minimum);
+	parametersHelper.AddParameter<int>("Disparities", "NumberOfIntervals", parameters.disparities.numberOfIntervals, DEFAULT_PARAMETERS.disparities.numberOfIntervals);
+	parametersHelper.AddParameter<int>("Disparities", "SmallPenalty", parameters.disparities.smallPenalty, DEFAULT_PARAMETERS.disparities.smallPenalty);
+	parametersHelper.AddParameter<int>("Disparities", "LargePenalty", parameters.disparities.largePenalty, DEFAULT_PARAMETERS.disparities.largePenalty);
+	parametersHelper.AddParameter<int>("Disparities", "UniquenessRatio", parameters.disparities.uniquenessRatio, DEFAULT_PARAMETERS.disparities.uniquenessRatio);
+	parametersHelper.AddParameter<int>("Disparities", "MaximumLeftRightDifference", parameters.disparities.maximumLeftRightDifference, DEFAULT_PARAMETERS.disparities.maximumLeftRightDifference);
+
+	parametersHelper.AddParameter<int>("GeneralParameters", "NumberOfPaths", parameters.numberOfPaths, DEFAULT_PARAMETERS.numberOfPaths);
+	parametersHelper.AddParameter<int>("GeneralParameters", "NumberOfThreads", parameters.numberOfThreads, DEFAULT_PARAMETERS.numberOfThreads);
+	parametersHelper.AddParameter<int>("GeneralParameters", "BandOverlap", parameters.bandOverlap, DEFAULT_PARAMETERS.bandOverlap);
+	parametersHelper.AddParameter<bool>("TemporalRange", "UsePrediction", parameters.temporalRange.usePrediction, DEFAULT_PARAMETERS.temporalRange.usePrediction);
+	parametersHelper.AddParameter<int>("TemporalRange", "Margin", parameters.temporalRange.margin, DEFAULT_PARAMETERS.temporalRange.margin);
+	parametersHelper.AddParameter<int>("TemporalRange", "RefreshPeriod", parameters.temporalRange.refreshPeriod, DEFAULT_PARAMETERS.temporalRange.refreshPeriod);
+	parametersHelper.AddParameter<float>("GeneralParameters", "PointCloudSamplingDensity", parameters.pointCloudSamplingDensity, DEFAULT_PARAMETERS.pointCloudSamplingDensity);
+	parametersHelper.AddParameter<bool>("GeneralParameters", "UseDisparityToDepthMap", parameters.useDisparityToDepthMap, DEFAULT_PARAMETERS.useDisparityToDepthMap);
+
+	for (unsigned row = 0; row < 4; row++)
+	{
+		for (unsigned column = 0; column < 4; column++)
+		{
+			std::stringstream elementStream;
+			elementStream << "Element_" << row <<"_"<< column;
+			parametersHelper.AddParameter<double>("DisparityToDepthMap",elementStream.str(), parameters.disparityToDepthMap[4*row+column], DEFAULT_PARAMETERS.disparityToDepthMap[4*row+column]);
+		}
+	}
+
+	parametersHelper.AddParameter<float>("StereoCamera", "LeftFocalLength", parameters.stereoCameraParameters.leftFocalLength, DEFAULT_PARAMETERS.stereoCameraParameters.leftFocalLength);
+	parametersHelper.AddParameter<float>("StereoCamera", "LeftPrinciplePointX", parameters.stereoCameraParameters.leftPrinciplePointX, DEFAULT_PARAMETERS.stereoCameraParameters.leftPrinciplePointX);
+	parametersHelper.AddParameter<float>("StereoCamera", "LeftPrinciplePointY", parameters.stereoCameraParameters.leftPrinciplePointY, DEFAULT_PARAMETERS.stereoCameraParameters.leftPrinciplePointY);
+	parametersHelper.AddParameter<float>("StereoCamera", "Baseline", parameters.stereoCameraParameters.baseline, DEFAULT_PARAMETERS.stereoCameraParameters.baseline);
+
+	pathUpdate = SelectPathUpdateFunction();
+	imageWidth = 0;
+	imageHeight = 0;
+	previousDisparitiesAvailable = false;
+	searchFullRange = true;
+	framesSinceFullRange = 0;
+	configurationFilePath = "";
+}
+
+SemiGlobalMatching::~SemiGlobalMatching()
+{
+}
+
+void SemiGlobalMatching::configure()
+{
+	parametersHelper.ReadFile(configurationFilePath);
+	ValidateParameters();
+	bandsList.clear();
+}
+
+void SemiGlobalMatching::process()
+{
+	// Read data from input ports
+	ValidateInputs();
+	ConvertToGrey(inLeft, leftGreyImage);
+	ConvertToGrey(inRight, rightGreyImage);
+
+	// Process data, each band is processed by its own thread and the first band by the calling thread
+	PrepareBands();
+	searchFullRange = !parameters.temporalRange.usePrediction || !previousDisparitiesAvailable || framesSinceFullRange >= parameters.temporalRange.refreshPeriod;
+	framesSinceFullRange = searchFullRange ? 0 : framesSinceFullRange + 1;
+	{
+		TRACE_SCOPE_CATEGORY("SemiGlobalMatching::ComputeDisparities", "DFN");
+		std::vector<std::thread> threadsList;
+		for (unsigned bandIndex = 1; bandIndex < bandsList.size(); bandIndex++)
+		{
+			threadsList.push_back( std::thread(&SemiGlobalMatching::ComputeBandDisparities, this, std::ref(bandsList.at(bandIndex))) );
+		}
+		ComputeBandDisparities(bandsList.at(0));
+		for (unsigned threadIndex = 0; threadIndex < threadsList.size(); threadIndex++)
+		{
+			threadsList.at(threadIndex).join();
+		}
+	}
+	previousDisparitiesAvailable = true;
+
+	#ifdef TESTING
+	disparityMatrix = cv::Mat(imageHeight, imageWidth, CV_16S, disparityImage.data()).clone();
+	#endif
+
+	// Write data to output port
+	ComputePointCloud();
+}
+
+const std::vector<int16_t>& SemiGlobalMatching::GetDisparityImage() const
+{
+	return disparityImage;
+}
+
+const int16_t SemiGlobalMatching::INVALID_DISPARITY = std::numeric_limits<int16_t>::min();
+const int SemiGlobalMatching::DISPARITY_SCALE = 16;
+const int SemiGlobalMatching::CENSUS_WIDTH = 9;
+const int SemiGlobalMatching::CENSUS_HEIGHT = 7;
+const int16_t SemiGlobalMatching::MAXIMUM_PENALTY = 2000;
+
+const SemiGlobalMatching::SemiGlobalMatchingOptionsSet SemiGlobalMatching::DEFAULT_PARAMETERS =
+{
+	//.reconstructionSpace =
+	{
+		/*.limitX =*/ 20,
+		/*.limitY =*/ 20,
+		/*.limitZ =*/ 10
+	},
+	//.disparities =
+	{
+		/*.minimum =*/ 0,
+		/*.numberOfIntervals =*/ 64,
+		/*.smallPenalty =*/ 10,
+		/*.largePenalty =*/ 120,
+		/*.uniquenessRatio =*/ 5,
+		/*.maximumLeftRightDifference =*/ 1
+	},
+	/*.numberOfPaths =*/ 8,
+	/*.numberOfThreads =*/ 0,
+	/*.bandOverlap =*/ 16,
+	//.temporalRange =
+	{
+		/*.usePrediction =*/ false,
+		/*.margin =*/ 8,
+		/*.refreshPeriod =*/ 10
+	},
+	/*.pointCloudSamplingDensity =*/ 1,
+	/*.useDisparityToDepthMap =*/ false,
+	//.disparityToDepthMap =
+	{
+		1, 0, 0, 0,
+		0, 1, 0, 0,
+		0, 0, 0, 1,
+		0, 0, -1, 0
+	},
+	//.stereoCameraParameters =
+	{
+		/*.leftFocalLength =*/ 1,
+		/*.leftPrinciplePointX =*/ 0,
+		/*.leftPrinciplePointY =*/ 0,
+		/*.baseline =*/ 1
+	}
+};
+
+void SemiGlobalMatching::ConvertToGrey(const Frame& frame, std::vector<uint8_t>& greyImage)
+{
+	const int numberOfPixels = imageWidth * imageHeight;
+	const uint8_t* data = reinterpret_cast<const uint8_t*>(frame.data.data.arr);
+	greyImage.resize(numberOfPixels);
+
+	FrameMode mode = GetFrameMode(frame);
+	if (mode == MODE_GRAYSCALE)
+	{
+		std::copy(data, data + numberOfPixels, greyImage.begin());
+		return;
+	}
+
+	//Integer approximation of 0.299 R + 0.587 G + 0.114 B
+	const int redIndex = (mode == MODE_RGB) ? 0 : 2;
+	const int blueIndex = 2 - redIndex;
+	for (int pixelIndex = 0; pixelIndex < numberOfPixels; pixelIndex++)
+	{
+		const uint8_t* pixel = data + 3 * pixelIndex;
+		greyImage[pixelIndex] = static_cast<uint8_t>( (77 * pixel[redIndex] + 150 * pixel[1] + 29 * pixel[blueIndex] + 128) >> 8 );
+	}
+}
+
+/**
+ * The bands split the rows evenly, each one extended by the overlap rows on both sides, and keep their buffers while the image size does not change.
+ */
+void SemiGlobalMatching::PrepareBands()
+{
+	int numberOfBands = parameters.numberOfThreads;
+	if (numberOfBands == 0)
+	{
+		numberOfBands = std::max(1u, std::thread::hardware_concurrency());
+	}
+	numberOfBands = std::max(1, std::min(numberOfBands, imageHeight / std::max(1, parameters.bandOverlap)));
+
+	disparityImage.resize(imageWidth * imageHeight);
+	if (static_cast<int>(bandsList.size()) == numberOfBands && bandsList.at(0).leftCensus.size() > 0 && bandsList.back().endRow == imageHeight &&
+		static_cast<int>(bandsList.at(0).rightDisparities.size()) == imageWidth)
+	{
+		return;
+	}
+
+	//The buffers are sized for the full range, a predicted range uses only a part of them
+	const int numberOfDisparities = parameters.disparities.numberOfIntervals;
+	const int pathLength = numberOfDisparities + 2;
+	previousDisparitiesAvailable = false;
+	bandsList.clear();
+	bandsList.resize(numberOfBands);
+	for (int bandIndex = 0; bandIndex < numberOfBands; bandIndex++)
+	{
+		BandWorkspace& band = bandsList.at(bandIndex);
+		band.firstRow = (imageHeight * bandIndex) / numberOfBands;
+		band.endRow = (imageHeight * (bandIndex + 1)) / numberOfBands;
+		band.firstAggregatedRow = std::max(0, band.firstRow - parameters.bandOverlap);
+		band.endAggregatedRow = std::min(imageHeight, band.endRow + parameters.bandOverlap);
+
+		const int numberOfRows = band.endAggregatedRow - band.firstAggregatedRow;
+		band.leftCensus.resize(numberOfRows * imageWidth);
+		band.rightCensus.resize(numberOfRows * imageWidth);
+		band.costs.resize(numberOfRows * imageWidth * numberOfDisparities);
+		band.sums.resize(numberOfRows * imageWidth * numberOfDisparities);
+		band.previousRows.resize(3 * (imageWidth + 2) * pathLength);
+		band.currentRows.resize(3 * (imageWidth + 2) * pathLength);
+		band.previousRowMinima.resize(3 * (imageWidth + 2));
+		band.currentRowMinima.resize(3 * (imageWidth + 2));
+		band.horizontalPaths.resize(2 * pathLength);
+		band.rightMinimumCosts.resize(imageWidth);
+		band.rightDisparities.resize(imageWidth);
+	}
+}
+
+/**
+ * A predicted range that misses the disparities of the scene leaves most pixels without a unique match inside it, so a band that loses more than a quarter of its previous
+ * valid disparities is searched again over the full range.
+ */
+void SemiGlobalMatching::ComputeBandDisparities(BandWorkspace& band)
+{
+	PredictDisparityRange(band);
+	ComputeCensus(leftGreyImage, band, band.leftCensus);
+	ComputeCensus(rightGreyImage, band, band.rightCensus);
+	SearchDisparityRange(band);
+
+	const int fullNumberOfDisparities = parameters.disparities.numberOfIntervals;
+	if (band.numberOfDisparities < fullNumberOfDisparities && 4 * CountValidDisparities(band) < 3 * band.previousValidCount)
+	{
+		band.minimumDisparity = parameters.disparities.minimum;
+		band.numberOfDisparities = fullNumberOfDisparities;
+		SearchDisparityRange(band);
+	}
+}
+
+void SemiGlobalMatching::SearchDisparityRange(BandWorkspace& band)
+{
+	ComputeCosts(band);
+
+	std::fill(band.sums.begin(), band.sums.begin() + (band.endAggregatedRow - band.firstAggregatedRow) * imageWidth * band.numberOfDisparities, 0);
+	AggregateCosts(band, true);
+	AggregateCosts(band, false);
+
+	SelectDisparities(band);
+}
+
+/**
+ * The band searches the full range when the whole range is refreshed, otherwise the range predicted from its disparities in the previous frame. The predicted range is a
+ * multiple of 16 disparities, as the vectorized aggregation needs.
+ */
+void SemiGlobalMatching::PredictDisparityRange(BandWorkspace& band)
+{
+	const int fullNumberOfDisparities = parameters.disparities.numberOfIntervals;
+	band.minimumDisparity = parameters.disparities.minimum;
+	band.numberOfDisparities = fullNumberOfDisparities;
+	band.previousValidCount = 0;
+	if (searchFullRange)
+	{
+		return;
+	}
+
+	//The previous disparities of the band rows are read before the band overwrites them
+	band.previousValidCount = CountValidDisparities(band);
+	Helpers::DisparityRange fullRange = {band.minimumDisparity, band.numberOfDisparities};
+	Helpers::DisparityRange range = Helpers::PredictDisparityRange(disparityImage.data() + band.firstRow * imageWidth, band.endRow - band.firstRow, imageWidth, imageWidth,
+		DISPARITY_SCALE, static_cast<int16_t>(INVALID_DISPARITY + 1), fullRange, parameters.temporalRange.margin);
+	band.minimumDisparity = range.minimumDisparity;
+	band.numberOfDisparities = range.numberOfDisparities;
+}
+
+/**
+ * Each bit of the census signature of a pixel tells whether a pixel of the window around it is darker than the pixel itself, the window is clamped at the image borders.
+ * Bit 9 * r + c refers to the pixel in row r and column c of the window, the center bit is always zero. On x86 the nine comparisons of a window row are made at once.
+ */
+void SemiGlobalMatching::ComputeCensus(const std::vector<uint8_t>& greyImage, const BandWorkspace& band, std::vector<uint64_t>& census)
+{
+	const int halfWidth = CENSUS_WIDTH / 2;
+	const int halfHeight = CENSUS_HEIGHT / 2;
+	const uint8_t* windowRowsList[CENSUS_HEIGHT];
+	for (int row = band.firstAggregatedRow; row < band.endAggregatedRow; row++)
+	{
+		for (int windowRow = 0; windowRow < CENSUS_HEIGHT; windowRow++)
+		{
+			windowRowsList[windowRow] = greyImage.data() + std::min(imageHeight - 1, std::max(0, row + windowRow - halfHeight)) * imageWidth;
+		}
+		const uint8_t* centerRow = windowRowsList[halfHeight];
+		uint64_t* censusRow = census.data() + (row - band.firstAggregatedRow) * imageWidth;
+
+		int firstVectorColumn = imageWidth;
+		int endVectorColumn = imageWidth;
+#ifdef SGM_HAVE_X86_SIMD
+		//The sixteen bytes loaded from the first column of the window have to lie within the row
+		firstVectorColumn = std::min(imageWidth, halfWidth);
+		endVectorColumn = std::max(firstVectorColumn, imageWidth + halfWidth - 15);
+		const __m128i signFlip = _mm_set1_epi8( static_cast<char>(0x80) );
+		for (int column = firstVectorColumn; column < endVectorColumn; column++)
+		{
+			const __m128i center = _mm_set1_epi8( static_cast<char>(centerRow[column] ^ 0x80) );
+			uint64_t signature = 0;
+			for (int windowRow = 0; windowRow < CENSUS_HEIGHT; windowRow++)
+			{
+				__m128i neighbours = _mm_loadu_si128( reinterpret_cast<const __m128i*>(windowRowsList[windowRow] + column - halfWidth) );
+				uint64_t rowMask = static_cast<uint64_t>( _mm_movemask_epi8( _mm_cmplt_epi8( _mm_xor_si128(neighbours, signFlip), center ) ) ) & 0x1FF;
+				signature |= rowMask << (CENSUS_WIDTH * windowRow);
+			}
+			censusRow[column] = signature;
+		}
+#endif
+
+		for (int column = 0; column < imageWidth; column++)
+		{
+			if (column == firstVectorColumn)
+			{
+				column = endVectorColumn;
+				if (column == imageWidth)
+				{
+					break;
+				}
+			}
+			const uint8_t center = centerRow[column];
+			uint64_t signature = 0;
+			for (int windowRow = 0; windowRow < CENSUS_HEIGHT; windowRow++)
+			{
+				const uint8_t* neighbourRow = windowRowsList[windowRow];
+				for (int windowColumn = 0; windowColumn < CENSUS_WIDTH; windowColumn++)
+				{
+					const int neighbourColumn = std::min(imageWidth - 1, std::max(0, column + windowColumn - halfWidth));
+					uint64_t bit = (neighbourRow[neighbourColumn] < center) ? 1 : 0;
+					signature |= bit << (CENSUS_WIDTH * windowRow + windowColumn);
+				}
+			}
+			censusRow[column] = signature;
+		}
+	}
+}
+
+/**
+ * The cost of a disparity is the Hamming distance between the census signatures of the matched pixels, the disparities that fall outside the right image take the largest cost.
+ */
+void SemiGlobalMatching::ComputeCosts(BandWorkspace& band)
+{
+	const int numberOfDisparities = band.numberOfDisparities;
+	const int16_t outsideCost = CENSUS_WIDTH * CENSUS_HEIGHT - 1;
+	const int numberOfRows = band.endAggregatedRow - band.firstAggregatedRow;
+	for (int row = 0; row < numberOfRows; row++)
+	{
+		const uint64_t* leftCensusRow = band.leftCensus.data() + row * imageWidth;
+		const uint64_t* rightCensusRow = band.rightCensus.data() + row * imageWidth;
+		int16_t* costsRow = band.costs.data() + row * imageWidth * numberOfDisparities;
+		for (int column = 0; column < imageWidth; column++)
+		{
+			const uint64_t leftSignature = leftCensusRow[column];
+			int16_t* pixelCosts = costsRow + column * numberOfDisparities;
+			for (int disparity = 0; disparity < numberOfDisparities; disparity++)
+			{
+				int rightColumn = column - band.minimumDisparity - disparity;
+				pixelCosts[disparity] = (rightColumn >= 0 && rightColumn < imageWidth) ?
+					static_cast<int16_t>( __builtin_popcountll(leftSignature ^ rightCensusRow[rightColumn]) ) : outsideCost;
+			}
+		}
+	}
+}
+
+/**
+ * The forward pass aggregates the paths coming from the left, from above, and, with 8 paths, from the top left and the top right; the backward pass aggregates the opposite paths.
+ * The pixel buffers of the previous row have one extra pixel on both sides, which stays at zero and starts the diagonal paths entering the image from its sides.
+ */
+void SemiGlobalMatching::AggregateCosts(BandWorkspace& band, bool forward)
+{
+	const int numberOfDisparities = band.numberOfDisparities;
+	const int pathLength = numberOfDisparities + 2;
+	const int numberOfRowPaths = (parameters.numberOfPaths == 8) ? 3 : 1;
+	const int16_t smallPenalty = parameters.disparities.smallPenalty;
+	const int16_t largePenalty = parameters.disparities.largePenalty;
+	const int step = forward ? 1 : -1;
+
+	//All paths start at zero cost, with the padding disparities at the largest cost
+	const int rowPathsSize = 3 * (imageWidth + 2) * pathLength;
+	const int horizontalPathsSize = 2 * pathLength;
+	for (std::pair<std::vector<int16_t>*, int> buffer : { std::make_pair(&band.previousRows, rowPathsSize), std::make_pair(&band.currentRows, rowPathsSize),
+		std::make_pair(&band.horizontalPaths, horizontalPathsSize) })
+	{
+		for (int pathStart = 0; pathStart < buffer.second; pathStart += pathLength)
+		{
+			std::fill(buffer.first->begin() + pathStart + 1, buffer.first->begin() + pathStart + pathLength - 1, 0);
+			(*buffer.first)[pathStart] = PADDING_COST;
+			(*buffer.first)[pathStart + pathLength - 1] = PADDING_COST;
+		}
+	}
+	std::fill(band.previousRowMinima.begin(), band.previousRowMinima.end(), 0);
+	std::fill(band.currentRowMinima.begin(), band.currentRowMinima.end(), 0);
+
+	const int numberOfRows = band.endAggregatedRow - band.firstAggregatedRow;
+	for (int rowIndex = 0; rowIndex < numberOfRows; rowIndex++)
+	{
+		const int row = forward ? rowIndex : (numberOfRows - 1 - rowIndex);
+		int16_t* previousHorizontal = band.horizontalPaths.data();
+		int16_t* currentHorizontal = band.horizontalPaths.data() + pathLength;
+		int16_t previousHorizontalMinimum = 0;
+		std::fill(previousHorizontal + 1, previousHorizontal + pathLength - 1, 0);
+
+		for (int columnIndex = 0; columnIndex < imageWidth; columnIndex++)
+		{
+			const int column = forward ? columnIndex : (imageWidth - 1 - columnIndex);
+			const int pixelIndex = row * imageWidth + column;
+			const int16_t* cost = band.costs.data() + pixelIndex * numberOfDisparities;
+			int16_t* sum = band.sums.data() + pixelIndex * numberOfDisparities;
+
+			previousHorizontalMinimum = pathUpdate(cost, previousHorizontal, previousHorizontalMinimum, currentHorizontal, sum, numberOfDisparities, smallPenalty, largePenalty);
+			std::swap(previousHorizontal, currentHorizontal);
+
+			//Path 0 comes from the same column, paths 1 and 2 from the previous and the next column along the direction of the pass
+			const int bufferColumn = column + 1;
+			const int predecessorColumnsList[3] = { bufferColumn, bufferColumn - step, bufferColumn + step };
+			for (int path = 0; path < numberOfRowPaths; path++)
+			{
+				const int predecessorIndex = path * (imageWidth + 2) + predecessorColumnsList[path];
+				const int currentIndex = path * (imageWidth + 2) + bufferColumn;
+				band.currentRowMinima[currentIndex] = pathUpdate(cost, band.previousRows.data() + predecessorIndex * pathLength, band.previousRowMinima[predecessorIndex],
+					band.currentRows.data() + currentIndex * pathLength, sum, numberOfDisparities, smallPenalty, largePenalty);
+			}
+		}
+		std::swap(band.previousRows, band.currentRows);
+		std::swap(band.previousRowMinima, band.currentRowMinima);
+	}
+}
+
+/**
+ * The disparity of a pixel is the one of minimum aggregated cost, if no disparity that is not adjacent to it has a cost within the uniqueness margin. The sub-pixel disparity
+ * is the minimum of the parabola through the adjacent costs. The left-right check compares it with the disparity of the matched right pixel, which is the disparity of minimum
+ * cost among the left pixels matching that right pixel. On an edge of a predicted range the cost may still be decreasing towards a disparity outside the range, so a minimum
+ * there is not accepted unless the edge is also an edge of the full range.
+ */
+void SemiGlobalMatching::SelectDisparities(BandWorkspace& band)
+{
+	const int numberOfDisparities = band.numberOfDisparities;
+	const int minimumDisparity = band.minimumDisparity;
+	const int uniquenessRatio = parameters.disparities.uniquenessRatio;
+	const bool checkLeftRight = (parameters.disparities.maximumLeftRightDifference >= 0);
+	const bool lowerEdgeOpen = (minimumDisparity > parameters.disparities.minimum);
+	const bool upperEdgeOpen = (minimumDisparity + numberOfDisparities < parameters.disparities.minimum + parameters.disparities.numberOfIntervals);
+
+	for (int row = band.firstRow; row < band.endRow; row++)
+	{
+		const int16_t* sumsRow = band.sums.data() + (row - band.firstAggregatedRow) * imageWidth * numberOfDisparities;
+		int16_t* disparityRow = disparityImage.data() + row * imageWidth;
+		if (checkLeftRight)
+		{
+			std::fill(band.rightMinimumCosts.begin(), band.rightMinimumCosts.end(), PADDING_COST);
+			std::fill(band.rightDisparities.begin(), band.rightDisparities.end(), -1);
+		}
+
+		for (int column = 0; column < imageWidth; column++)
+		{
+			const int16_t* sums = sumsRow + column * numberOfDisparities;
+			int bestDisparity = 0;
+			int16_t bestCost = sums[0];
+			for (int disparity = 1; disparity < numberOfDisparities; disparity++)
+			{
+				if (sums[disparity] < bestCost)
+				{
+					bestCost = sums[disparity];
+					bestDisparity = disparity;
+				}
+			}
+
+			if (checkLeftRight)
+			{
+				for (int disparity = 0; disparity < numberOfDisparities; disparity++)
+				{
+					int rightColumn = column - minimumDisparity - disparity;
+					if (rightColumn >= 0 && rightColumn < imageWidth && sums[disparity] < band.rightMinimumCosts[rightColumn])
+					{
+						band.rightMinimumCosts[rightColumn] = sums[disparity];
+						band.rightDisparities[rightColumn] = disparity;
+					}
+				}
+			}
+
+			int secondBestCost = PADDING_COST;
+			for (int disparity = 0; disparity < bestDisparity - 1; disparity++)
+			{
+				secondBestCost = std::min(secondBestCost, static_cast<int>(sums[disparity]));
+			}
+			for (int disparity = bestDisparity + 2; disparity < numberOfDisparities; disparity++)
+			{
+				secondBestCost = std::min(secondBestCost, static_cast<int>(sums[disparity]));
+			}
+			bool unique = (secondBestCost * (100 - uniquenessRatio) >= bestCost * 100);
+			bool onOpenEdge = (bestDisparity == 0 && lowerEdgeOpen) || (bestDisparity == numberOfDisparities - 1 && upperEdgeOpen);
+			if (!unique || onOpenEdge || column - minimumDisparity - bestDisparity < 0)
+			{
+				disparityRow[column] = INVALID_DISPARITY;
+				continue;
+			}
+
+			int subpixelOffset = 0;
+			if (bestDisparity > 0 && bestDisparity < numberOfDisparities - 1)
+			{
+				int previousCost = sums[bestDisparity - 1];
+				int nextCost = sums[bestDisparity + 1];
+				int denominator = std::max(1, previousCost + nextCost - 2 * bestCost);
+				subpixelOffset = ( (previousCost - nextCost) * DISPARITY_SCALE + denominator ) / (2 * denominator);
+			}
+			disparityRow[column] = static_cast<int16_t>( (minimumDisparity + bestDisparity) * DISPARITY_SCALE + subpixelOffset );
+		}
+
+		if (checkLeftRight)
+		{
+			for (int column = 0; column < imageWidth; column++)
+			{
+				if (disparityRow[column] == INVALID_DISPARITY)
+				{
+					continue;
+				}
+				int disparity = (disparityRow[column] - minimumDisparity * DISPARITY_SCALE + DISPARITY_SCALE / 2) / DISPARITY_SCALE;
+				int rightColumn = column - minimumDisparity - disparity;
+				if (rightColumn < 0 || rightColumn >= imageWidth || std::abs(band.rightDisparities[rightColumn] - disparity) > parameters.disparities.maximumLeftRightDifference)
+				{
+					disparityRow[column] = INVALID_DISPARITY;
+				}
+			}
+		}
+	}
+}
+
+int SemiGlobalMatching::CountValidDisparities(const BandWorkspace& band)
+{
+	const int16_t* bandDisparities = disparityImage.data() + band.firstRow * imageWidth;
+	return static_cast<int>( (band.endRow - band.firstRow) * imageWidth - std::count(bandDisparities, bandDisparities + (band.endRow - band.firstRow) * imageWidth, INVALID_DISPARITY) );
+}
+
+/**
+ * The points are written directly into the output point cloud, keeping one valid point every 1/pointCloudSamplingDensity.
+ */
+void SemiGlobalMatching::ComputePointCloud()
+{
+	TRACE_SCOPE_CATEGORY("SemiGlobalMatching::ComputePointCloud", "DFN");
+	ClearPoints(outPointcloud);
+
+	unsigned validPointCount = 0;
+	unsigned pickUpPeriod = static_cast<unsigned>(1 / parameters.pointCloudSamplingDensity);
+	int numberOfPoints = 0;
+	for (int row = 0; row < imageHeight; row++)
+	{
+		for (int column = 0; column < imageWidth && numberOfPoints < MAX_CLOUD_SIZE; column++)
+		{
+			int16_t disparity = disparityImage[row * imageWidth + column];
+			float x, y, z;
+			if (disparity == INVALID_DISPARITY || !ComputePoint(row, column, static_cast<float>(disparity) / DISPARITY_SCALE, x, y, z))
+			{
+				continue;
+			}
+			validPointCount++;
+			if (validPointCount % pickUpPeriod == 0)
+			{
+				AddPoint(outPointcloud, x, y, z);
+				numberOfPoints++;
+			}
+		}
+	}
+}
+
+bool SemiGlobalMatching::ComputePoint(int row, int column, float disparity, float& x, float& y, float& z)
+{
+	if (parameters.useDisparityToDepthMap)
+	{
+		const double* map = parameters.disparityToDepthMap;
+		double homogeneousX = map[0] * column + map[1] * row + map[2] * disparity + map[3];
+		double homogeneousY = map[4] * column + map[5] * row + map[6] * disparity + map[7];
+		double homogeneousZ = map[8] * column + map[9] * row + map[10] * disparity + map[11];
+		double homogeneousW = map[12] * column + map[13] * row + map[14] * disparity + map[15];
+		if (homogeneousW == 0)
+		{
+			return false;
+		}
+		x = homogeneousX / homogeneousW;
+		y = homogeneousY / homogeneousW;
+		z = homogeneousZ / homogeneousW;
+	}
+	else
+	{
+		if (disparity <= 0)
+		{
+			return false;
+		}
+		const StereoCameraParameters& camera = parameters.stereoCameraParameters;
+		z = camera.baseline * camera.leftFocalLength / disparity;
+		x = (static_cast<float>(column) - camera.leftPrinciplePointX) * z / camera.leftFocalLength;
+		y = (static_cast<float>(row) - camera.leftPrinciplePointY) * z / camera.leftFocalLength;
+	}
+
+	return std::abs(x) <= parameters.reconstructionSpace.limitX && std::abs(y) <= parameters.reconstructionSpace.limitY &&
+		z > 0 && z <= parameters.reconstructionSpace.limitZ;
+}
+
+SemiGlobalMatching::PathUpdateFunction SemiGlobalMatching::SelectPathUpdateFunction()
+{
+#if defined(SGM_HAVE_X86_SIMD)
+	if (__builtin_cpu_supports("avx2"))
+	{
+		return &UpdatePathAvx2;
+	}
+	return &UpdatePathSse2;
+#elif defined(SGM_HAVE_NEON)
+	return &UpdatePathNeon;
+#else
+	return &UpdatePathScalar;
+#endif
+}
+
+void SemiGlobalMatching::ValidateParameters()
+{
+	ASSERT(parameters.disparities.numberOfIntervals > 0 && parameters.disparities.numberOfIntervals % 16 == 0, "SemiGlobalMatching Configuration Error: number of disparities needs to be a positive multiple of 16");
+	ASSERT(parameters.disparities.smallPenalty > 0, "SemiGlobalMatching Configuration Error: SmallPenalty has to be positive");
+	ASSERT(parameters.disparities.largePenalty > parameters.disparities.smallPenalty, "SemiGlobalMatching Configuration Error: LargePenalty has to be greater than SmallPenalty");
+	ASSERT(parameters.disparities.largePenalty <= MAXIMUM_PENALTY, "SemiGlobalMatching Configuration Error: LargePenalty is too large for 16 bit aggregation");
+	ASSERT(parameters.disparities.uniquenessRatio >= 0 && parameters.disparities.uniquenessRatio < 100, "SemiGlobalMatching Configuration Error: UniquenessRatio has to be in [0, 100)");
+	ASSERT(parameters.numberOfPaths == 8 || parameters.numberOfPaths == 4, "SemiGlobalMatching Configuration Error: NumberOfPaths has to be 4 or 8");
+	ASSERT(parameters.numberOfThreads >= 0, "SemiGlobalMatching Configuration Error: NumberOfThreads cannot be negative");
+	ASSERT(parameters.bandOverlap >= 0, "SemiGlobalMatching Configuration Error: BandOverlap cannot be negative");
+	ASSERT(parameters.temporalRange.margin >= 0, "SemiGlobalMatching Configuration Error: Margin of the temporal range cannot be negative");
+	ASSERT(parameters.temporalRange.refreshPeriod >= 0, "SemiGlobalMatching Configuration Error: RefreshPeriod of the temporal range cannot be negative");
+	ASSERT( parameters.reconstructionSpace.limitX > 0, "SemiGlobalMatching Configuration Error: Limits for reconstruction space have to be positive");
+	ASSERT( parameters.reconstructionSpace.limitY > 0, "SemiGlobalMatching Configuration Error: Limits for reconstruction space have to be positive");
+	ASSERT( parameters.reconstructionSpace.limitZ > 0, "SemiGlobalMatching Configuration Error: Limits for reconstruction space have to be positive");
+	ASSERT( parameters.stereoCameraParameters.leftFocalLength > 0, "SemiGlobalMatching Configuration Error: Focal Length has to be positive");
+	ASSERT( parameters.stereoCameraParameters.baseline > 0, "SemiGlobalMatching Configuration Error: Baseline has to be positive");
+	ASSERT(parameters.pointCloudSamplingDensity > 0 && parameters.pointCloudSamplingDensity <= 1, "SemiGlobalMatching Configuration Error: pointCloudSamplingDensity has to be in the set (0, 1]");
+}
+
+void SemiGlobalMatching::ValidateInputs()
+{
+	ASSERT(GetFrameWidth(inLeft) == GetFrameWidth(inRight) && GetFrameHeight(inLeft) == GetFrameHeight(inRight), "SemiGlobalMatching Error: left and right images have different sizes");
+	ASSERT(GetFrameMode(inLeft) == GetFrameMode(inRight), "SemiGlobalMatching Error: left and right images have different modes");
+	FrameMode mode = GetFrameMode(inLeft);
+	ASSERT(mode == MODE_GRAYSCALE || mode == MODE_RGB || mode == MODE_BGR, "SemiGlobalMatching Error: only grayscale, RGB and BGR images are supported");
+
+	imageWidth = GetFrameWidth(inLeft);
+	imageHeight = GetFrameHeight(inLeft);
+	int channels = (mode == MODE_GRAYSCALE) ? 1 : 3;
+	ASSERT(GetNumberOfDataBytes(inLeft) == imageWidth * imageHeight * channels && GetNumberOfDataBytes(inRight) == imageWidth * imageHeight * channels,
+		"SemiGlobalMatching Error: image data size does not match image dimensions");
+	ASSERT(imageWidth > 0 && imageHeight > 0, "SemiGlobalMatching Error: empty images");
+}
+
+}
+}
+}
+
+/** @} */
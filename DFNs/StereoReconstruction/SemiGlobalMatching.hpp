@@ -0,0 +1,233 @@
+/**
+ * @author Alessandro Bianco
+ */
+
+/**
+ * @addtogroup DFNs
+ * @{
+ */
+
+#ifndef STEREORECONSTRUCTION_SEMIGLOBALMATCHING_HPP
+#define STEREORECONSTRUCTION_SEMIGLOBALMATCHING_HPP
+
+#include "StereoReconstructionInterface.hpp"
+
+#include <Types/CPP/Frame.hpp>
+#include <Types/CPP/PointCloud.hpp>
+#include <Helpers/ParametersListHelper.hpp>
+
+#include <vector>
+#include <cstdint>
+
+namespace CDFF
+{
+namespace DFN
+{
+namespace StereoReconstruction
+{
+	/**
+	 * Scene reconstruction (as a 3D pointcloud) from 2D rectified stereo images, using a native implementation of the semi-global matching algorithm
+	 * that does not depend on OpenCV or PCL.
+	 *
+	 * Processing steps: (i) grayscaling of the images, (ii) census transform of the images on a 9x7 window, (iii) computation of the matching costs as the Hamming distance
+	 * of the census signatures, (iv) aggregation of the costs along 8 or 4 paths with 16 bit vectorized arithmetic (AVX2 or SSE2 on x86, NEON on ARM, chosen at run time),
+	 * (v) selection of the disparity with a uniqueness check, a sub-pixel parabola fit and a left-right consistency check, (vi) scene reconstruction written directly into
+	 * the output pointcloud.
+	 *
+	 * The image is divided into horizontal bands processed by parallel threads. The paths that cross the border of a band start a number of overlapping rows
+	 * before the band, so that they reach the band after a warm up; with a single thread the aggregation is exact.
+	 *
+	 * Optionally each band searches only the disparity range predicted from its disparities in the previous frame, which suits the slowly changing views of a
+	 * moving rover; the costs and the aggregation shrink with the range, and the full range is searched again periodically. A minimum on an edge of the predicted
+	 * range is not accepted, and a band that keeps less than three quarters of its previous valid disparities is searched again over the full range in the same frame.
+	 *
+	 * @param disparities.minimum
+	 *        the smallest disparity searched
+	 * @param disparities.numberOfIntervals
+	 *        the number of disparities searched, must be a positive multiple of 16
+	 * @param disparities.smallPenalty
+	 *        the aggregation penalty of a disparity change of one pixel between neighbouring pixels
+	 * @param disparities.largePenalty
+	 *        the aggregation penalty of a larger disparity change, it has to be greater than the small penalty
+	 * @param disparities.uniquenessRatio
+	 *        margin in percentage by which the best cost has to win over the cost of any disparity not adjacent to the best one
+	 * @param disparities.maximumLeftRightDifference
+	 *        the maximum difference in pixels between the left and the right disparity of a pixel, a negative value disables the left-right check
+	 *
+	 * @param numberOfPaths
+	 *        the number of aggregation paths, either 8 or 4 (horizontal and vertical only)
+	 * @param numberOfThreads
+	 *        the number of threads and of image bands, zero means the number of hardware threads
+	 * @param bandOverlap
+	 *        the number of rows by which the paths crossing the band borders start before the band
+	 *
+	 * @param temporalRange.usePrediction
+	 *        whether each band searches only around the disparities it had in the previous frame, without the 1% most extreme ones on each side
+	 * @param temporalRange.margin
+	 *        the number of disparities by which the predicted range is extended on each side, it has to cover the disparity change between two frames
+	 * @param temporalRange.refreshPeriod
+	 *        the number of frames with a predicted range after which the full range is searched again
+	 *
+	 * @param pointCloudSamplingDensity
+	 *        downsampling ratio in (0, 1]: only one valid point every 1/pointCloudSamplingDensity is added to the pointcloud.
+	 *
+	 * @param useDisparityToDepthMap
+	 *        defines whether the camera parameters are provided as a disparity-to-depth matrix or as the focal length, principle points, and baseline
+	 * @param disparityToDepthMap
+	 *        camera parameters in the form of a 4-by-4 disparity-to-depth matrix: provide the elements of this matrix via parameters called Element_X_Y, where X and Y are between 0 and 3
+	 * @param stereoCameraParameters
+	 *        camera parameters in the form of the focal length and principal point of the left camera and the distance between the two cameras:
+	 *        the parameters to use to provide this information are called LeftFocalLength, LeftPrinciplePointX, LeftPrinciplePointY, and Baseline, respectively
+	 * @param reconstructionSpace
+	 *        a bounding box for the reconstructed scene, provided via parameters called LimitX, LimitY, LimitZ. A reconstructed point
+	 *        of coordinates (x,y,z) is accepted into the pointcloud if -LimitX <= x <= LimitX, -LimitY <= y <= LimitY, 0 < z <= LimitZ.
+	 *
+	 * @reference The algorithm is adapted from Heiko Hirschmueller (2008), "Stereo Processing by Semiglobal Matching and Mutual Information",
+	 *            IEEE Transactions on Pattern Analysis and Machine Intelligence, 30(2), 328-341, with the census cost of Ramin Zabih and John Woodfill (1994),
+	 *            "Non-parametric Local Transforms for Computing Visual Correspondence", European Conference on Computer Vision.
+	 */
+	class SemiGlobalMatching : public StereoReconstructionInterface
+	{
+		public:
+
+			SemiGlobalMatching();
+			virtual ~SemiGlobalMatching();
+
+			virtual void configure() override;
+			virtual void process() override;
+
+			/**
+			 * The disparity of each pixel of the latest processed left image in sixteenths of pixel, row by row, INVALID_DISPARITY where no disparity was found.
+			 */
+			const std::vector<int16_t>& GetDisparityImage() const;
+
+			static const int16_t INVALID_DISPARITY;
+			static const int DISPARITY_SCALE;
+
+		private:
+
+			static const int CENSUS_WIDTH;
+			static const int CENSUS_HEIGHT;
+			static const int16_t MAXIMUM_PENALTY;
+
+			//DFN Parameters
+			struct ReconstructionSpace
+			{
+				float limitX;
+				float limitY;
+				float limitZ;
+			};
+
+			struct DisparitiesOptionsSet
+			{
+				int minimum;
+				int numberOfIntervals;
+				int smallPenalty;
+				int largePenalty;
+				int uniquenessRatio;
+				int maximumLeftRightDifference;
+			};
+
+			struct TemporalRangeOptionsSet
+			{
+				bool usePrediction;
+				int margin;
+				int refreshPeriod;
+			};
+
+			struct StereoCameraParameters
+			{
+				float leftFocalLength;
+				float leftPrinciplePointX;
+				float leftPrinciplePointY;
+				float baseline;
+			};
+
+			typedef double DisparityToDepthMap[16];
+			struct SemiGlobalMatchingOptionsSet
+			{
+				ReconstructionSpace reconstructionSpace;
+				DisparitiesOptionsSet disparities;
+				int numberOfPaths;
+				int numberOfThreads;
+				int bandOverlap;
+				TemporalRangeOptionsSet temporalRange;
+				float pointCloudSamplingDensity;
+				bool useDisparityToDepthMap;
+				DisparityToDepthMap disparityToDepthMap;
+				StereoCameraParameters stereoCameraParameters;
+			};
+
+			Helpers::ParametersListHelper parametersHelper;
+			SemiGlobalMatchingOptionsSet parameters;
+			static const SemiGlobalMatchingOptionsSet DEFAULT_PARAMETERS;
+
+			/**
+			 * The update of one aggregation path at one pixel: current = cost + min(previous(d), previous(d-1) + P1, previous(d+1) + P1, previousMinimum + P2) - previousMinimum,
+			 * the current costs are also added to the sum of the paths. The previous and current buffers have one padding element before and after the disparities.
+			 * @return the minimum of the current costs.
+			 */
+			typedef int16_t (*PathUpdateFunction)(const int16_t* cost, const int16_t* previous, int16_t previousMinimum, int16_t* current, int16_t* sum,
+				int numberOfDisparities, int16_t smallPenalty, int16_t largePenalty);
+
+			//The buffers of one image band, they are kept across calls so that no memory is allocated when the image size does not change
+			struct BandWorkspace
+			{
+				int firstRow; //the first row whose disparity is computed by the band
+				int endRow; //one past the last row whose disparity is computed by the band
+				int firstAggregatedRow; //the first row of the band including the overlap
+				int endAggregatedRow; //one past the last row of the band including the overlap
+				int minimumDisparity; //the disparity range searched by the band, either the full range or the range predicted from the previous frame
+				int numberOfDisparities;
+				int previousValidCount; //the number of valid disparities of the band rows in the previous frame
+				std::vector<uint64_t> leftCensus;
+				std::vector<uint64_t> rightCensus;
+				std::vector<int16_t> costs;
+				std::vector<int16_t> sums;
+				std::vector<int16_t> previousRows; //the path costs of the previous row for the vertical and diagonal paths
+				std::vector<int16_t> currentRows;
+				std::vector<int16_t> previousRowMinima;
+				std::vector<int16_t> currentRowMinima;
+				std::vector<int16_t> horizontalPaths;
+				std::vector<int16_t> rightMinimumCosts; //the best cost for each right image pixel in the current row, for the left-right check
+				std::vector<int16_t> rightDisparities;
+			};
+
+			PathUpdateFunction pathUpdate;
+			int imageWidth;
+			int imageHeight;
+			std::vector<uint8_t> leftGreyImage;
+			std::vector<uint8_t> rightGreyImage;
+			std::vector<int16_t> disparityImage;
+			std::vector<BandWorkspace> bandsList;
+			bool previousDisparitiesAvailable;
+			bool searchFullRange;
+			int framesSinceFullRange;
+
+			//Core computation methods
+			void ConvertToGrey(const FrameWrapper::Frame& frame, std::vector<uint8_t>& greyImage);
+			void PrepareBands();
+			void ComputeBandDisparities(BandWorkspace& band);
+			void PredictDisparityRange(BandWorkspace& band);
+			void ComputeCensus(const std::vector<uint8_t>& greyImage, const BandWorkspace& band, std::vector<uint64_t>& census);
+			void SearchDisparityRange(BandWorkspace& band);
+			void ComputeCosts(BandWorkspace& band);
+			void AggregateCosts(BandWorkspace& band, bool forward);
+			void SelectDisparities(BandWorkspace& band);
+			int CountValidDisparities(const BandWorkspace& band);
+			void ComputePointCloud();
+			bool ComputePoint(int row, int column, float disparity, float& x, float& y, float& z);
+
+			static PathUpdateFunction SelectPathUpdateFunction();
+
+			//Input Validation methods
+			void ValidateParameters();
+			void ValidateInputs();
+	};
+}
+}
+}
+
+#endif // STEREORECONSTRUCTION_SEMIGLOBALMATCHING_HPP
+
+/** @} */
@@ -14,6 +14,39 @@ namespace DFN
 namespace StereoRectification
 {
 
+namespace
+{
+    /**
+     * @brief Grayscale version of an image in the given color mode, images that already have one channel are returned as they are
+     */
+    cv::Mat ToGrayscale(const cv::Mat& image, asn1SccFrame_mode_t mode)
+    {
+        cv::Mat grayscale;
+        if(image.channels() == 3){
+            cv::cvtColor(image, grayscale, mode == asn1Sccmode_RGB ? cv::COLOR_RGB2GRAY : cv::COLOR_BGR2GRAY);
+        }
+        else if(image.channels() == 4){
+            cv::cvtColor(image, grayscale, mode == asn1Sccmode_RGBA ? cv::COLOR_RGBA2GRAY : cv::COLOR_BGRA2GRAY);
+        }
+        else{
+            grayscale = image;
+        }
+        return grayscale;
+    }
+
+    /**
+     * @brief Converts a pair of CV_32F maps to the packed fixed-point form used by cv::remap
+     */
+    void ConvertToFixedPoint(cv::Mat& mapx, cv::Mat& mapy)
+    {
+        cv::Mat map1;
+        cv::Mat map2;
+        cv::convertMaps(mapx, mapy, map1, map2, CV_16SC2);
+        mapx = map1;
+        mapy = map2;
+    }
+}
+
 StereoRectification::StereoRectification()
 :parameters(DEFAULT_PARAMETERS)
 {
@@ -22,6 +55,8 @@ StereoRectification::StereoRectification()
     parametersHelper.AddParameter<double>("StereoRectificationParams", "scaling", parameters.scaling, DEFAULT_PARAMETERS.scaling);
     parametersHelper.AddParameter<bool>("StereoRectificationParams", "fisheye", parameters.fisheye, DEFAULT_PARAMETERS.fisheye);
     parametersHelper.AddParameter<std::string>("StereoRectificationParams", "calibrationFilePath", parameters.calibrationFilePath, DEFAULT_PARAMETERS.calibrationFilePath);
+    parametersHelper.AddParameter<bool>("StereoRectificationParams", "fixedPointMaps", parameters.fixedPointMaps, DEFAULT_PARAMETERS.fixedPointMaps);
+    parametersHelper.AddParameter<bool>("StereoRectificationParams", "grayscale", parameters.grayscale, DEFAULT_PARAMETERS.grayscale);
 
     configurationFilePath = "";
 }
@@ -52,7 +87,8 @@ void StereoRectification::process()
             parameters.xratio != _xratio ||
             parameters.yratio != _yratio ||
             parameters.scaling != _scaling ||
-            parameters.fisheye != _fisheye){
+            parameters.fisheye != _fisheye ||
+            parameters.fixedPointMaps != _fixedPointMaps){
 
         _sensorIdLeft = std::string(reinterpret_cast<char const *>(inOriginalStereoPair.left.intrinsic.sensorId.arr));
         _sensorIdRight = std::string(reinterpret_cast<char const *>(inOriginalStereoPair.right.intrinsic.sensorId.arr));
@@ -61,6 +97,7 @@ void StereoRectification::process()
         _yratio = parameters.yratio;
         _scaling = parameters.scaling;
         _fisheye = parameters.fisheye;
+        _fixedPointMaps = parameters.fixedPointMaps;
 
         cv::FileStorage fs( _calibrationFilePath + "/" + _sensorIdLeft + std::string("-") + _sensorIdRight + ".yml", cv::FileStorage::READ );
         if( fs.isOpened() ){
@@ -105,6 +142,11 @@ void StereoRectification::process()
                 cv::initUndistortRectifyMap(cameraMatrixR, distCoeffsR, RRight, _PRight, newSize, CV_32F, _rmapx, _rmapy);
             }
 
+            if(_fixedPointMaps){
+                ConvertToFixedPoint(_lmapx, _lmapy);
+                ConvertToFixedPoint(_rmapx, _rmapy);
+            }
+
             _baseline = 1.0 / Q.at<double>(3,2);
 
             _initialized = true;
@@ -116,8 +158,19 @@ void StereoRectification::process()
     }
 
     if( _initialized ){
-        cv::remap(inLeft, outLeft, _lmapx, _lmapy, cv::INTER_LINEAR);
-        cv::remap(inRight, outRight, _rmapx, _rmapy, cv::INTER_LINEAR);
+        // Left and right images are converted and remapped concurrently
+        cv::parallel_for_(cv::Range(0, 2), [&](const cv::Range& range){
+            for(int side = range.start; side < range.end; side++){
+                if(side == 0){
+                    cv::Mat source = parameters.grayscale ? ToGrayscale(inLeft, inOriginalStereoPair.left.metadata.mode) : inLeft;
+                    cv::remap(source, outLeft, _lmapx, _lmapy, cv::INTER_LINEAR);
+                }
+                else{
+                    cv::Mat source = parameters.grayscale ? ToGrayscale(inRight, inOriginalStereoPair.right.metadata.mode) : inRight;
+                    cv::remap(source, outRight, _rmapx, _rmapy, cv::INTER_LINEAR);
+                }
+            }
+        }, 2);
 
         // Getting image pair
         outRectifiedStereoPair.msgVersion = frame_Version;
@@ -146,6 +199,9 @@ void StereoRectification::process()
 
             img.extrinsic = inOriginalStereoPair.left.extrinsic;
             img.metadata = inOriginalStereoPair.left.metadata;
+            if(parameters.grayscale){
+                img.metadata.mode = asn1Sccmode_GRAY;
+            }
 
             // Array3D
             {
@@ -183,6 +239,9 @@ void StereoRectification::process()
 
             img.extrinsic = inOriginalStereoPair.right.extrinsic;
             img.metadata = inOriginalStereoPair.right.metadata;
+            if(parameters.grayscale){
+                img.metadata.mode = asn1Sccmode_GRAY;
+            }
 
             // Array3D
             {
@@ -211,7 +270,9 @@ const StereoRectification::StereoRectificationParams StereoRectification::DEFAUL
     .yratio = 1,
     .scaling = -1,
     .fisheye = false,
-    .calibrationFilePath = ""
+    .calibrationFilePath = "",
+    .fixedPointMaps = true,
+    .grayscale = false
 };
 
 }
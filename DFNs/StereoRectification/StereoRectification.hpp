@@ -69,6 +69,18 @@ namespace StereoRectification
                  * then this parameter should be "/path/to/calibration"
                  */
                 std::string calibrationFilePath;
+
+                /**
+                 * @brief Set to true to convert the rectification maps once to the packed fixed-point form of OpenCV (CV_16SC2 coordinates and an interpolation table index),
+                 * so that each remap reads fewer bytes and uses integer arithmetic, at the cost of a 1/32 pixel precision.
+                 * Set to false to keep the CV_32F maps.
+                 */
+                bool fixedPointMaps;
+
+                /**
+                 * @brief Set to true to convert color images to grayscale before they are remapped, the rectified images are then grayscale.
+                 */
+                bool grayscale;
             };
 
             Helpers::ParametersListHelper parametersHelper;
@@ -85,6 +97,7 @@ namespace StereoRectification
             double _scaling = -1;
             bool _centerPrincipalPoint = false;
             bool _fisheye = false;
+            bool _fixedPointMaps = false;
             bool _initialized = false;
 
             cv::Mat _lmapx;
@@ -92,6 +92,26 @@ DFNCommonInterface* DfpcConfigurator::GetDfn(std::string dfnName, bool optional)
 		}
 	}
 
+DFNCommonInterface* DfpcConfigurator::GetDfnInstance(std::string dfnName, unsigned instanceIndex)
+	{
+	DFNCommonInterface* dfn = GetDfn(dfnName);
+	if (instanceIndex == 0)
+		{
+		return dfn;
+		}
+
+	std::vector<DFNCommonInterface*>& instancesList = instancesSet[dfnName];
+	const std::pair<std::string, std::string>& implementation = implementationsSet[dfnName];
+	while (instancesList.size() < instanceIndex)
+		{
+		DFNCommonInterface* instance = DFNsBuilder::CreateDFN(implementation.first, implementation.second);
+		instance->setConfigurationFile( configurationFilesSet[dfnName] );
+		instance->configure();
+		instancesList.push_back(instance);
+		}
+	return instancesList.at(instanceIndex-1);
+	}
+
 /* --------------------------------------------------------------------------
  *
  * Private Member Functions
@@ -115,6 +135,7 @@ void DfpcConfigurator::ConstructDFNs(YAML::Node configuration)
 
 		DFNCommonInterface* dfn = DFNsBuilder::CreateDFN(dfnType, dfnImplementation);
 		dfnsSet[dfnName] = dfn;
+		implementationsSet[dfnName] = std::make_pair(dfnType, dfnImplementation);
 		}
 	}
 
@@ -167,6 +188,16 @@ void DfpcConfigurator::ConfigureDfns()
 		dfn->setConfigurationFile( configurationFilesSet[dfnName] );
 		dfn->configure();
 		}
+
+	for(std::map<std::string, std::vector<DFNCommonInterface*> >::iterator instancesIterator = instancesSet.begin(); instancesIterator != instancesSet.end(); ++instancesIterator)
+		{
+		for(unsigned instanceIndex = 0; instanceIndex < instancesIterator->second.size(); instanceIndex++)
+			{
+			DFNCommonInterface* instance = instancesIterator->second.at(instanceIndex);
+			instance->setConfigurationFile( configurationFilesSet[instancesIterator->first] );
+			instance->configure();
+			}
+		}
 	}
 
 void DfpcConfigurator::DestroyDfns()
@@ -176,7 +207,16 @@ void DfpcConfigurator::DestroyDfns()
 		DFNCommonInterface* dfn = dfnsIterator->second;
 		delete(dfn);
 		}
+	for(std::map<std::string, std::vector<DFNCommonInterface*> >::iterator instancesIterator = instancesSet.begin(); instancesIterator != instancesSet.end(); ++instancesIterator)
+		{
+		for(unsigned instanceIndex = 0; instanceIndex < instancesIterator->second.size(); instanceIndex++)
+			{
+			delete(instancesIterator->second.at(instanceIndex));
+			}
+		}
 	dfnsSet.clear();
+	instancesSet.clear();
+	implementationsSet.clear();
 	configurationFilesSet.clear();
 	}
 
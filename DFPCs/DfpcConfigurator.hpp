@@ -14,6 +14,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string>
+#include <vector>
 #include <yaml-cpp/yaml.h>
 
 namespace CDFF
@@ -61,11 +62,22 @@ namespace DFPC
 		*/
 		CDFF::DFN::DFNCommonInterface* GetDfn(std::string dfnName, bool optional = false);
 
+		/*
+		* @brief this method gives further instances of a DFN, so that independent inputs can be processed by different threads. The instances are created on the first request with the same
+		*		implementation and configuration file of the original DFN, and are owned by the configurator.
+		*
+		* @param dfnName, the name of the DFN as mentioned in the original configuration file;
+		* @param instanceIndex, the index of the instance, index 0 is the DFN returned by GetDfn.
+		*/
+		CDFF::DFN::DFNCommonInterface* GetDfnInstance(std::string dfnName, unsigned instanceIndex);
+
 	protected:
 		std::string extraParametersConfigurationFilePath;
 
 		std::map<std::string, CDFF::DFN::DFNCommonInterface*> dfnsSet;
 		std::map<std::string, std::string> configurationFilesSet;
+		std::map<std::string, std::pair<std::string, std::string> > implementationsSet;
+		std::map<std::string, std::vector<CDFF::DFN::DFNCommonInterface*> > instancesSet;
 
 	private:
 		void ConstructDFNs(YAML::Node configuration);
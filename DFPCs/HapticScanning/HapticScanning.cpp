@@ -4,6 +4,7 @@
  */
 
 #include "HapticScanning.hpp"
+#include <Macros/TracingMacros.hpp>
 
 #include <Executors/ForceMeshGenerator/ForceMeshGeneratorExecutor.hpp>
 
@@ -30,6 +31,7 @@ void HapticScanning::setup()
 
 void HapticScanning::run()
 {
+    TRACE_SCOPE_CATEGORY("HapticScanning::run", "DFPC");
     CDFF::DFN::Executors::Execute(m_force_mesh_generator, inArmBasePose, inArmEndEffectorPose, inArmEndEffectorWrench, outPointCloud);
 }
 
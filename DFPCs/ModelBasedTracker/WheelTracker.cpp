@@ -4,6 +4,7 @@
  */
 
 #include "WheelTracker.hpp"
+#include <Macros/TracingMacros.hpp>
 #include <opencv2/highgui/highgui.hpp>
 
 #include <Converters/StdVectorOfStringsToStringSequenceConverter.hpp>
@@ -75,6 +76,7 @@ void WheelTracker::setup()
 
 void WheelTracker::run()
 {
+    TRACE_SCOPE_CATEGORY("WheelTracker::run", "DFPC");
     m_background_subtractor->imageInput(inImage);
     m_background_subtractor->process();
     const asn1SccFrame & frame_without_background = m_background_subtractor->imageOutput();
@@ -4,6 +4,7 @@
  */
 
 #include "WheeledRobotTracker.hpp"
+#include <Macros/TracingMacros.hpp>
 
 #include <Converters/StdVectorOfStringsToStringSequenceConverter.hpp>
 #include <iostream>
@@ -85,6 +86,7 @@ std::string WheeledRobotTracker::getRobotConfigurationFileName()
 
 void WheeledRobotTracker::run()
 {
+    TRACE_SCOPE_CATEGORY("WheeledRobotTracker::run", "DFPC");
     asn1SccPose_Initialize(&outPose);
 
     //Update setup if the robot name has changed
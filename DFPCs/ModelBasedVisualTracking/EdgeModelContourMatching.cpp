@@ -9,6 +9,7 @@
 
 #include "EdgeModelContourMatching.hpp"
 #include <Errors/Assert.hpp>
+#include <Macros/TracingMacros.hpp>
 #include <Types/C/RigidBodyState.h>
 
 #include <opencv2/core/core.hpp>
@@ -66,6 +67,7 @@ void EdgeModelContourMatching::allocateImageMemory()
 
 void EdgeModelContourMatching::run()
 {
+    TRACE_SCOPE_CATEGORY("EdgeModelContourMatching::run", "DFPC");
     ASSERT(numberOfCameras < 3, "Too many camera: maximum is two");
     for (int c = 0; c < numberOfCameras; c++)
     {
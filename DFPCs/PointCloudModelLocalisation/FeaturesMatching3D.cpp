@@ -29,6 +29,7 @@
 #include "FeaturesMatching3D.hpp"
 #include <Errors/Assert.hpp>
 #include <Errors/AssertOnTest.hpp>
+#include <Macros/TracingMacros.hpp>
 
 #include <Executors/FeaturesExtraction3D/FeaturesExtraction3DExecutor.hpp>
 #include <Executors/FeaturesDescription3D/FeaturesDescription3DExecutor.hpp>
@@ -71,6 +72,7 @@ FeaturesMatching3D::~FeaturesMatching3D()
 
 void FeaturesMatching3D::run() 
 	{
+	TRACE_SCOPE_CATEGORY("FeaturesMatching3D::run", "DFPC");
 	DEBUG_PRINT_TO_LOG("FeaturesMatching3D start", "");
 
 	if (!modelFeaturesAvailable)
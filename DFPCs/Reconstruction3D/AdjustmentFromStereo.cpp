@@ -29,6 +29,7 @@
 #include "AdjustmentFromStereo.hpp"
 #include <Errors/Assert.hpp>
 #include <Errors/AssertOnTest.hpp>
+#include <Macros/TracingMacros.hpp>
 #include <Types/CPP/VisualPointFeatureVector3D.hpp>
 
 #include <Executors/ImageFiltering/ImageFilteringExecutor.hpp>
@@ -41,6 +42,10 @@
 #include <Executors/PerspectiveNPointSolving/PerspectiveNPointSolvingExecutor.hpp>
 #include <Executors/PointCloudReconstruction2DTo3D/PointCloudReconstruction2DTo3DExecutor.hpp>
 
+#include <algorithm>
+#include <exception>
+#include <thread>
+
 namespace CDFF
 {
 namespace DFPC
@@ -74,9 +79,15 @@ AdjustmentFromStereo::AdjustmentFromStereo() :
 	parameters = DEFAULT_PARAMETERS;
 
 	parametersHelper.AddParameter<float>("GeneralParameters", "PointCloudMapResolution", parameters.pointCloudMapResolution, DEFAULT_PARAMETERS.pointCloudMapResolution);
+	parametersHelper.AddParameter<int>("GeneralParameters", "PointCloudMapMemoryBudget", parameters.pointCloudMapMemoryBudget, DEFAULT_PARAMETERS.pointCloudMapMemoryBudget);
+	parametersHelper.AddParameter<std::string>("GeneralParameters", "PointCloudMapSwapFolder", parameters.pointCloudMapSwapFolder, DEFAULT_PARAMETERS.pointCloudMapSwapFolder);
+	parametersHelper.AddParameter<int>("GeneralParameters", "PointCloudMapLevelsOfDetail", parameters.pointCloudMapLevelsOfDetail, DEFAULT_PARAMETERS.pointCloudMapLevelsOfDetail);
+	parametersHelper.AddParameter<float>("GeneralParameters", "PointCloudMapLevelOfDetailDistance", parameters.pointCloudMapLevelOfDetailDistance, DEFAULT_PARAMETERS.pointCloudMapLevelOfDetailDistance);
+	parametersHelper.AddParameter<int>("GeneralParameters", "PointCloudMapOutputBudget", parameters.pointCloudMapOutputBudget, DEFAULT_PARAMETERS.pointCloudMapOutputBudget);
 	parametersHelper.AddParameter<float>("GeneralParameters", "SearchRadius", parameters.searchRadius, DEFAULT_PARAMETERS.searchRadius);
 	parametersHelper.AddParameter<int>("GeneralParameters", "NumberOfAdjustedStereoPairs", parameters.numberOfAdjustedStereoPairs, DEFAULT_PARAMETERS.numberOfAdjustedStereoPairs);
 	parametersHelper.AddParameter<bool>("GeneralParameters", "UseBundleInitialEstimation", parameters.useBundleInitialEstimation, DEFAULT_PARAMETERS.useBundleInitialEstimation);
+	parametersHelper.AddParameter<int>("GeneralParameters", "NumberOfMatchingThreads", parameters.numberOfMatchingThreads, DEFAULT_PARAMETERS.numberOfMatchingThreads);
 	parametersHelper.AddParameter<float>("GeneralParameters", "Baseline", parameters.baseline, DEFAULT_PARAMETERS.baseline);
 
 	currentInputNumber = 0;
@@ -117,12 +128,18 @@ AdjustmentFromStereo::~AdjustmentFromStereo()
 	DeleteIfNotNull(presentKeypointVector);
 	DeleteIfNotNull(keypointCloud);
 
+	for(unsigned mapIndex = 0; mapIndex < temporalCorrespondenceMapsList.size(); mapIndex++)
+		{
+		delete(temporalCorrespondenceMapsList.at(mapIndex));
+		}
+
 	delete(EMPTY_FEATURE_VECTOR);
 	}
 
 
 void AdjustmentFromStereo::run() 
 	{
+	TRACE_SCOPE_CATEGORY("AdjustmentFromStereo::run", "DFPC");
 	DEBUG_PRINT_TO_LOG("Adjustment from stereo start", "");
  
 	bundleHistory->AddImages(inLeftImage, inRightImage);
@@ -165,7 +182,7 @@ void AdjustmentFromStereo::run()
 			AddLastPointCloudToMap(cameraPoses);
 			}
 		Copy( pointCloudMap.GetLatestPose(), outPose);
-		PointCloudWrapper::PointCloudConstPtr outputPointCloud = pointCloudMap.GetScenePointCloudInOrigin(&outPose, parameters.searchRadius);
+		PointCloudWrapper::PointCloudConstPtr outputPointCloud = pointCloudMap.GetScenePointCloudInOrigin(&outPose, parameters.searchRadius, parameters.pointCloudMapOutputBudget);
 		Copy(*outputPointCloud, outPointCloud); 
 
 		DEBUG_PRINT_TO_LOG("pose", ToString(outPose));
@@ -186,11 +203,14 @@ void AdjustmentFromStereo::setup()
 
 	DeleteIfNotNull(bundleHistory);
 	bundleHistory = new BundleHistory(parameters.numberOfAdjustedStereoPairs + 1);
+	bundleHistory->SetImagesRetention(false);
 
 	DeleteIfNotNull(correspondencesRecorder);
 	correspondencesRecorder = new MultipleCorrespondences2DRecorder(parameters.numberOfAdjustedStereoPairs, true);	
 
 	pointCloudMap.SetResolution(parameters.pointCloudMapResolution);
+	pointCloudMap.SetMemoryBudget(static_cast<size_t>(parameters.pointCloudMapMemoryBudget) * 1024 * 1024, parameters.pointCloudMapSwapFolder);
+	pointCloudMap.SetLevelsOfDetail(parameters.pointCloudMapLevelsOfDetail, parameters.pointCloudMapLevelOfDetailDistance);
 
 	SetPosition(rightToLeftCameraPose, -parameters.baseline, 0, 0);
 	SetOrientation(rightToLeftCameraPose, 0, 0, 0, 1);
@@ -214,8 +234,14 @@ const AdjustmentFromStereo::AdjustmentFromStereoOptionsSet AdjustmentFromStereo:
 	{
 	/*.searchRadius =*/ 20,
 	/*.pointCloudMapResolution =*/ 1e-2,
+	/*.pointCloudMapMemoryBudget =*/ 0,
+	/*.pointCloudMapSwapFolder =*/ ".",
+	/*.pointCloudMapLevelsOfDetail =*/ 1,
+	/*.pointCloudMapLevelOfDetailDistance =*/ 5,
+	/*.pointCloudMapOutputBudget =*/ 0,
 	/*.numberOfAdjustedStereoPairs =*/ 4,
 	/*.useBundleInitialEstimation =*/ true,
+	/*.numberOfMatchingThreads =*/ 0,
 	/*.baseline =*/ 1
 	};
 
@@ -230,6 +256,11 @@ void AdjustmentFromStereo::ConfigureExtraParameters()
 	parametersHelper.ReadFile( configurator.GetExtraParametersConfigurationFilePath() );
 
 	ASSERT(parameters.pointCloudMapResolution > 0, "AdjustmentFromStereo Error, Point Cloud Map resolution is not positive");
+	ASSERT(parameters.pointCloudMapMemoryBudget >= 0, "AdjustmentFromStereo Error, Point Cloud Map memory budget is negative");
+	ASSERT(parameters.pointCloudMapLevelsOfDetail >= 1 && parameters.pointCloudMapLevelsOfDetail <= static_cast<int>(PointCloudMap::MAXIMUM_NUMBER_OF_LEVELS), "AdjustmentFromStereo Error, Point Cloud Map levels of detail out of range");
+	ASSERT(parameters.pointCloudMapLevelOfDetailDistance > 0, "AdjustmentFromStereo Error, Point Cloud Map level of detail distance is not positive");
+	ASSERT(parameters.pointCloudMapOutputBudget >= 0, "AdjustmentFromStereo Error, Point Cloud Map output budget is negative");
+	ASSERT(parameters.numberOfMatchingThreads >= 0, "AdjustmentFromStereo Error, number of matching threads is negative");
 	}
 
 void AdjustmentFromStereo::InstantiateDFNs()
@@ -248,6 +279,25 @@ void AdjustmentFromStereo::InstantiateDFNs()
 		perspectiveNPointSolver = static_cast<PerspectiveNPointSolvingInterface*>( configurator.GetDfn("perspectiveNPointSolver") );
 		reconstructor3dfrom2dmatches = static_cast<PointCloudReconstruction2DTo3DInterface*>( configurator.GetDfn("reconstructor3dfrom2dmatches") );
 		}
+
+	// Each current feature vector is matched against the left and right features of the previous N-1 image pairs
+	int maximumNumberOfJobs = 4 * (parameters.numberOfAdjustedStereoPairs - 1);
+	int numberOfThreads = parameters.numberOfMatchingThreads;
+	if (numberOfThreads == 0)
+		{
+		numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+		}
+	numberOfThreads = std::max(1, std::min(numberOfThreads, maximumNumberOfJobs));
+
+	temporalMatchersList.resize(numberOfThreads);
+	for(int threadIndex = 0; threadIndex < numberOfThreads; threadIndex++)
+		{
+		temporalMatchersList.at(threadIndex) = static_cast<FeaturesMatching2DInterface*>( configurator.GetDfnInstance("featuresMatcher2d", threadIndex) );
+		}
+	for(int mapIndex = temporalCorrespondenceMapsList.size(); mapIndex < maximumNumberOfJobs; mapIndex++)
+		{
+		temporalCorrespondenceMapsList.push_back( NewCorrespondenceMap2D() );
+		}
 	}
 
 void AdjustmentFromStereo::ComputeStereoPointCloud(FrameWrapper::FrameConstPtr filteredLeftImage, FrameWrapper::FrameConstPtr filteredRightImage)
@@ -336,14 +386,21 @@ void AdjustmentFromStereo::CreateWorkingCorrespondences()
 	VisualPointFeatureVector2DConstPtr rightFeatureVector = bundleHistory->GetFeatures(0, RIGHT_FEATURE_CATEGORY);
 	CorrespondenceMap2DConstPtr leftRightCorrespondenceMap = bundleHistory->GetMatches(0);
 
+	temporalMatchingJobsList.clear();
+	AddTemporalMatchingJobs(leftFeatureVector);
+	AddTemporalMatchingJobs(rightFeatureVector);
+	ExecuteTemporalMatchingJobs();
+
 	correspondencesRecorder->InitializeNewSequence();
 	correspondencesRecorder->AddCorrespondences(leftRightCorrespondenceMap);
-	CreateWorkingCorrespondences(leftFeatureVector);
-	CreateWorkingCorrespondences(rightFeatureVector);
+	for(unsigned jobIndex = 0; jobIndex < temporalMatchingJobsList.size(); jobIndex++)
+		{
+		correspondencesRecorder->AddCorrespondences( temporalCorrespondenceMapsList.at(jobIndex) );
+		}
 	correspondencesRecorder->CompleteNewSequence();
 	}
 
-void AdjustmentFromStereo::CreateWorkingCorrespondences(VisualPointFeatureVector2DWrapper::VisualPointFeatureVector2DConstPtr featureVector)
+void AdjustmentFromStereo::AddTemporalMatchingJobs(VisualPointFeatureVector2DWrapper::VisualPointFeatureVector2DConstPtr featureVector)
 	{
 	for(int backwardSteps = 1; backwardSteps < parameters.numberOfAdjustedStereoPairs; backwardSteps++)
 		{
@@ -356,16 +413,61 @@ void AdjustmentFromStereo::CreateWorkingCorrespondences(VisualPointFeatureVector
 			break;
 			}
 
-		CorrespondenceMap2DConstPtr leftTimeCorrespondenceMap = NULL;
-		Executors::Execute(featuresMatcher2d, featureVector, pastLeftFeatureVector, leftTimeCorrespondenceMap);
-		correspondencesRecorder->AddCorrespondences(leftTimeCorrespondenceMap);
+		TemporalMatchingJob leftTimeJob = { featureVector, pastLeftFeatureVector };
+		temporalMatchingJobsList.push_back(leftTimeJob);
 
-		CorrespondenceMap2DConstPtr rightTimeCorrespondenceMap = NULL;
-		Executors::Execute(featuresMatcher2d, featureVector, pastRightFeatureVector, rightTimeCorrespondenceMap);
-		correspondencesRecorder->AddCorrespondences(rightTimeCorrespondenceMap);
+		TemporalMatchingJob rightTimeJob = { featureVector, pastRightFeatureVector };
+		temporalMatchingJobsList.push_back(rightTimeJob);
 		} 
 	}
 
+void AdjustmentFromStereo::ExecuteTemporalMatchingJobs()
+	{
+	TRACE_SCOPE_CATEGORY("AdjustmentFromStereo::ExecuteTemporalMatchingJobs", "DFPC");
+	int numberOfJobs = temporalMatchingJobsList.size();
+	int numberOfThreads = std::min( static_cast<int>(temporalMatchersList.size()), numberOfJobs );
+
+	// The thread with index t executes the jobs t, t + numberOfThreads, t + 2*numberOfThreads, ... with its own matcher, the results are copied out of the matcher as they are overwritten by the next job
+	std::vector<std::exception_ptr> errorsList(numberOfThreads);
+	auto executeJobs = [&](int threadIndex)
+		{
+		try
+			{
+			for(int jobIndex = threadIndex; jobIndex < numberOfJobs; jobIndex += numberOfThreads)
+				{
+				const TemporalMatchingJob& job = temporalMatchingJobsList.at(jobIndex);
+				Executors::Execute(temporalMatchersList.at(threadIndex), *job.sourceFeatureVector, *job.sinkFeatureVector, *temporalCorrespondenceMapsList.at(jobIndex) );
+				}
+			}
+		catch(...)
+			{
+			errorsList.at(threadIndex) = std::current_exception();
+			}
+		};
+
+	std::vector<std::thread> threadsList;
+	for(int threadIndex = 1; threadIndex < numberOfThreads; threadIndex++)
+		{
+		threadsList.push_back( std::thread(executeJobs, threadIndex) );
+		}
+	if (numberOfThreads > 0)
+		{
+		executeJobs(0);
+		}
+	for(unsigned threadIndex = 0; threadIndex < threadsList.size(); threadIndex++)
+		{
+		threadsList.at(threadIndex).join();
+		}
+
+	for(int threadIndex = 0; threadIndex < numberOfThreads; threadIndex++)
+		{
+		if (errorsList.at(threadIndex))
+			{
+			std::rethrow_exception( errorsList.at(threadIndex) );
+			}
+		}
+	}
+
 bool AdjustmentFromStereo::ComputeCameraPoses(PoseWrapper::Poses3DSequenceConstPtr& cameraPoses)
 	{
 	DEBUG_PRINT_TO_LOG("About to execute bundle adjustment", "");
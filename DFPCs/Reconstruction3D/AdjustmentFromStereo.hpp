@@ -25,9 +25,15 @@
  * 
  * This DFPC is configured according to the following parameters (beyond those that are needed to configure the DFN components):
  * @param SearchRadius, the output is given by the point of the reconstructed cloud contained within a sphere of center given by the current camera pose and radius given by this parameter;
- * @param PointCloudMapResolution, the voxel resolution of the output point cloud, if the cloud is denser it will be filtered by PCL voxel filter;
+ * @param PointCloudMapResolution, the voxel resolution of the output point cloud, points falling in the same voxel are merged into their centroid;
+ * @param PointCloudMapMemoryBudget, the memory in megabytes the point cloud map may use before its tiles farthest from the camera are swapped to disk, zero means no limit;
+ * @param PointCloudMapSwapFolder, the existing folder where the point cloud map writes its swap files;
+ * @param PointCloudMapLevelsOfDetail, the number of voxel resolutions kept by the point cloud map, each one twice as coarse as the previous one, 1 disables the levels of detail;
+ * @param PointCloudMapLevelOfDetailDistance, the output points are at full resolution up to this distance from the camera, then the resolution halves each time the distance doubles;
+ * @param PointCloudMapOutputBudget, the maximum number of points of the output point cloud, the levels of detail are made coarser to fit it, zero means the maximum size of a point cloud;
  * @param NumberOfAdjustedStereoPairs, it is the number N of stereo pairs that will be used for bundle adjustment, it can be one of {2, 3, 4};
  * @param UseBundleInitialEstimation, this says whether bundle adjustment should be done with an initial estimation (computed by comparing 2 sets of image pairs) or without initial estimation;
+ * @param NumberOfMatchingThreads, the number of threads that match the current features against the features of the previous N image pairs, each with its own instance of the matcher DFN, zero means one per hardware thread;
  * @param Baseline, the baseline of the stereo camera pair.
  *
  * Notes: no set of DFNs implementation has produced good result for this DFPC implementation during testing.
@@ -123,8 +129,14 @@ namespace Reconstruction3D
 			{
 			float searchRadius;
 			float pointCloudMapResolution;
+			int pointCloudMapMemoryBudget;
+			std::string pointCloudMapSwapFolder;
+			int pointCloudMapLevelsOfDetail;
+			float pointCloudMapLevelOfDetailDistance;
+			int pointCloudMapOutputBudget;
 			int numberOfAdjustedStereoPairs;
 			bool useBundleInitialEstimation;
+			int numberOfMatchingThreads;
 			float baseline;
 			};
 
@@ -162,6 +174,16 @@ namespace Reconstruction3D
 		int oldestCameraIndex;
 		bool firstTimeBundle;
 
+		//Matching of the current features against the past features, the jobs are split among the matcher instances and their results are stored in job order
+		struct TemporalMatchingJob
+			{
+			VisualPointFeatureVector2DWrapper::VisualPointFeatureVector2DConstPtr sourceFeatureVector;
+			VisualPointFeatureVector2DWrapper::VisualPointFeatureVector2DConstPtr sinkFeatureVector;
+			};
+		std::vector<CDFF::DFN::FeaturesMatching2DInterface*> temporalMatchersList;
+		std::vector<TemporalMatchingJob> temporalMatchingJobsList;
+		std::vector<CorrespondenceMap2DWrapper::CorrespondenceMap2DPtr> temporalCorrespondenceMapsList;
+
 		//Intermediate data
 		CorrespondenceMap2DWrapper::CorrespondenceMap2DPtr cleanCorrespondenceMap;
 		PointCloudWrapper::PointCloudPtr triangulatedKeypointCloud;
@@ -186,7 +208,8 @@ namespace Reconstruction3D
 
 		//Core computation methods for managing the set of correspondences over N pairs of images.
 		void CreateWorkingCorrespondences();
-		void CreateWorkingCorrespondences(VisualPointFeatureVector2DWrapper::VisualPointFeatureVector2DConstPtr featureVector);
+		void AddTemporalMatchingJobs(VisualPointFeatureVector2DWrapper::VisualPointFeatureVector2DConstPtr featureVector);
+		void ExecuteTemporalMatchingJobs();
 
 		//Core computation methods for managing the set of correspondences over N pairs of images.
 		bool ComputeCameraPoses(PoseWrapper::Poses3DSequenceConstPtr& cameraPoses);
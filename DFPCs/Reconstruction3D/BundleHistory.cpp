@@ -20,63 +20,81 @@ BundleHistory::BundleHistory(int size) :
 	{
 	mostRecentEntryIndex = NO_RECENT_ENTRY;
 	oldestEntryIndex = 0;
-	for (int index = 0; index < size; index++)
-		{
-		leftImageList.at(index) = NULL;
-		rightImageList.at(index) = NULL;
-		}
+	retainImages = true;
 	}
 
 BundleHistory::~BundleHistory()
 	{
-	for(int index= 0; index < size; index++)
-		{
-		DeleteAllDataAt(index);
-		}
 	}
 
 void BundleHistory::AddImages(const Frame& leftImage, const Frame& rightImage)
 	{
-	FramePtr leftCopy = NewFrame();
-	FramePtr rightCopy = NewFrame();
-	Copy(leftImage, *leftCopy);
-	Copy(rightImage, *rightCopy);
+	if (!retainImages)
+		{
+		AddImages(FrameSharedConstPtr(), FrameSharedConstPtr());
+		return;
+		}
+	// The oldest entry is released first, so that its buffers can hold the new images
+	if ( mostRecentEntryIndex != NO_RECENT_ENTRY && (mostRecentEntryIndex+1) % size == oldestEntryIndex)
+		{
+		ResetAllDataAt(oldestEntryIndex);
+		}
+	FrameSharedConstPtr leftCopy = CopyToBuffer(leftImage, frameBuffersList, NewSharedFrame);
+	FrameSharedConstPtr rightCopy = CopyToBuffer(rightImage, frameBuffersList, NewSharedFrame);
 	AddImages(leftCopy, rightCopy);
 	}
 
 void BundleHistory::AddFeatures(const VisualPointFeatureVector2D& featureVector, std::string featureCategory)
 	{
-	VisualPointFeatureVector2DPtr copy = NewVisualPointFeatureVector2D();
-	Copy(featureVector, *copy);
-	AddFeatures(copy, featureCategory);
+	if (discardedCategoriesSet.count(featureCategory) > 0)
+		{
+		return;
+		}
+	AddToCategory(featureVectorList, VisualPointFeatureVector2DSharedConstPtr(), featureCategory);
+	AddFeatures( CopyToBuffer(featureVector, featureVectorBuffersList, NewSharedVisualPointFeatureVector2D), featureCategory );
 	}
 
 void BundleHistory::AddFeatures3d(const VisualPointFeatureVector3D& featureVector, std::string featureCategory)
 	{
-	VisualPointFeatureVector3DPtr copy = NewVisualPointFeatureVector3D();
-	Copy(featureVector, *copy);
-	AddFeatures3d(copy, featureCategory);
+	if (discardedCategoriesSet.count(featureCategory) > 0)
+		{
+		return;
+		}
+	AddToCategory(featureVector3dList, VisualPointFeatureVector3DSharedConstPtr(), featureCategory);
+	AddFeatures3d( CopyToBuffer(featureVector, featureVector3dBuffersList, NewSharedVisualPointFeatureVector3D), featureCategory );
 	}
 
 void BundleHistory::AddMatches(const CorrespondenceMap2D& leftRightCorrespondenceMap, std::string correspondenceCategory)
 	{
-	CorrespondenceMap2DPtr copy = NewCorrespondenceMap2D();
-	Copy(leftRightCorrespondenceMap, *copy);
-	AddMatches(copy, correspondenceCategory);
+	if (discardedCategoriesSet.count(correspondenceCategory) > 0)
+		{
+		return;
+		}
+	AddToCategory(leftRightCorrespondenceMapList, CorrespondenceMap2DSharedConstPtr(), correspondenceCategory);
+	AddMatches( CopyToBuffer(leftRightCorrespondenceMap, correspondenceMapBuffersList, NewSharedCorrespondenceMap2D), correspondenceCategory );
 	}
 
 void BundleHistory::AddPointCloud(const PointCloud& pointCloud, std::string cloudCategory)
 	{
-	PointCloudPtr copy = NewPointCloud();
-	Copy(pointCloud, *copy);
-	AddPointCloud(copy, cloudCategory);
+	if (discardedCategoriesSet.count(cloudCategory) > 0)
+		{
+		return;
+		}
+	AddToCategory(pointCloudList, PointCloudSharedConstPtr(), cloudCategory);
+	AddPointCloud( CopyToBuffer(pointCloud, pointCloudBuffersList, NewSharedPointCloud), cloudCategory );
 	}
 
-void BundleHistory::AddImages(FrameConstPtr leftImage, FrameConstPtr rightImage)
+void BundleHistory::AddImages(FrameSharedConstPtr leftImage, FrameSharedConstPtr rightImage)
 	{
+	if (!retainImages)
+		{
+		leftImage.reset();
+		rightImage.reset();
+		}
+
 	if ( mostRecentEntryIndex != NO_RECENT_ENTRY && (mostRecentEntryIndex+1) % size == oldestEntryIndex)
 		{
-		DeleteAllDataAt(oldestEntryIndex);
+		ResetAllDataAt(oldestEntryIndex);
 		leftImageList.at(oldestEntryIndex) = leftImage;
 		rightImageList.at(oldestEntryIndex) = rightImage;
 		mostRecentEntryIndex = oldestEntryIndex;
@@ -90,78 +108,52 @@ void BundleHistory::AddImages(FrameConstPtr leftImage, FrameConstPtr rightImage)
 		}
 	}
 
-void BundleHistory::AddFeatures(VisualPointFeatureVector2DConstPtr featureVector, std::string featureCategory)
+void BundleHistory::AddFeatures(VisualPointFeatureVector2DSharedConstPtr featureVector, std::string featureCategory)
 	{
-	std::map<std::string, FeatureVectorList>::iterator list = featureVectorList.find(featureCategory);
-	
-	if (list == featureVectorList.end())
-		{
-		featureVectorList[featureCategory] = FeatureVectorList(size);
-		for (int index = 0; index < size; index++)
-			{
-			featureVectorList[featureCategory].at(index) = NULL;
-			}
-		}
-	else
-		{
-		delete( featureVectorList[featureCategory].at(mostRecentEntryIndex) );
-		}
-	featureVectorList[featureCategory].at(mostRecentEntryIndex) = featureVector;
+	AddToCategory(featureVectorList, featureVector, featureCategory);
 	}
 
-void BundleHistory::AddFeatures3d(VisualPointFeatureVector3DConstPtr featureVector, std::string featureCategory)
+void BundleHistory::AddFeatures3d(VisualPointFeatureVector3DSharedConstPtr featureVector, std::string featureCategory)
 	{
-	std::map<std::string, FeatureVector3dList>::iterator list = featureVector3dList.find(featureCategory);
-	
-	if (list == featureVector3dList.end())
-		{
-		featureVector3dList[featureCategory] = FeatureVector3dList(size);
-		for (int index = 0; index < size; index++)
-			{
-			featureVector3dList[featureCategory].at(index) = NULL;
-			}
-		}
-	else
-		{
-		delete( featureVector3dList[featureCategory].at(mostRecentEntryIndex) );
-		}
-	featureVector3dList[featureCategory].at(mostRecentEntryIndex) = featureVector;
+	AddToCategory(featureVector3dList, featureVector, featureCategory);
 	}
 
-void BundleHistory::AddMatches(CorrespondenceMap2DConstPtr leftRightCorrespondenceMap, std::string correspondenceCategory)
+void BundleHistory::AddMatches(CorrespondenceMap2DSharedConstPtr leftRightCorrespondenceMap, std::string correspondenceCategory)
 	{
-	std::map<std::string, CorrespondenceMapList>::iterator list = leftRightCorrespondenceMapList.find(correspondenceCategory);
-	if (list == leftRightCorrespondenceMapList.end())
-		{
-		leftRightCorrespondenceMapList[correspondenceCategory] = CorrespondenceMapList(size);
-		for (int index = 0; index < size; index++)
-			{
-			leftRightCorrespondenceMapList[correspondenceCategory].at(index) = NULL;
-			}
-		}
-	else
-		{
-		delete( leftRightCorrespondenceMapList[correspondenceCategory].at(mostRecentEntryIndex) );
-		}
-	leftRightCorrespondenceMapList[correspondenceCategory].at(mostRecentEntryIndex) = leftRightCorrespondenceMap;
+	AddToCategory(leftRightCorrespondenceMapList, leftRightCorrespondenceMap, correspondenceCategory);
 	}
 
-void BundleHistory::AddPointCloud(PointCloudConstPtr pointCloud, std::string cloudCategory)
+void BundleHistory::AddPointCloud(PointCloudSharedConstPtr pointCloud, std::string cloudCategory)
 	{
-	std::map<std::string, PointCloudList>::iterator list = pointCloudList.find(cloudCategory);
-	if (list == pointCloudList.end())
+	AddToCategory(pointCloudList, pointCloud, cloudCategory);
+	}
+
+void BundleHistory::SetImagesRetention(bool retainImages)
+	{
+	this->retainImages = retainImages;
+	if (!retainImages)
 		{
-		pointCloudList[cloudCategory] = PointCloudList(size);
 		for (int index = 0; index < size; index++)
 			{
-			pointCloudList[cloudCategory].at(index) = NULL;
+			leftImageList.at(index).reset();
+			rightImageList.at(index).reset();
 			}
+		frameBuffersList.clear();
 		}
-	else
+	}
+
+void BundleHistory::SetCategoryRetention(std::string category, bool retain)
+	{
+	if (retain)
 		{
-		delete( pointCloudList[cloudCategory].at(mostRecentEntryIndex) );
+		discardedCategoriesSet.erase(category);
+		return;
 		}
-	pointCloudList[cloudCategory].at(mostRecentEntryIndex) = pointCloud;
+	discardedCategoriesSet.insert(category);
+	featureVectorList.erase(category);
+	featureVector3dList.erase(category);
+	leftRightCorrespondenceMapList.erase(category);
+	pointCloudList.erase(category);
 	}
 		
 FrameWrapper::FrameConstPtr BundleHistory::GetLeftImage(int backwardSteps)
@@ -172,7 +164,7 @@ FrameWrapper::FrameConstPtr BundleHistory::GetLeftImage(int backwardSteps)
 		return NULL;
 		}
 
-	return leftImageList.at(index);
+	return leftImageList.at(index).get();
 	}
 
 FrameWrapper::FrameConstPtr BundleHistory::GetRightImage(int backwardSteps)
@@ -183,7 +175,7 @@ FrameWrapper::FrameConstPtr BundleHistory::GetRightImage(int backwardSteps)
 		return NULL;
 		}
 
-	return rightImageList.at(index);
+	return rightImageList.at(index).get();
 	}
 
 VisualPointFeatureVector2DWrapper::VisualPointFeatureVector2DConstPtr BundleHistory::GetFeatures(int backwardSteps, std::string featureCategory)
@@ -199,7 +191,7 @@ VisualPointFeatureVector2DWrapper::VisualPointFeatureVector2DConstPtr BundleHist
 		return NULL;
 		}
 
-	return featureVectorList[featureCategory].at(index);
+	return list->second.at(index).get();
 	}
 
 VisualPointFeatureVector3DWrapper::VisualPointFeatureVector3DConstPtr BundleHistory::GetFeatures3d(int backwardSteps, std::string featureCategory)
@@ -215,7 +207,7 @@ VisualPointFeatureVector3DWrapper::VisualPointFeatureVector3DConstPtr BundleHist
 		return NULL;
 		}
 
-	return featureVector3dList[featureCategory].at(index);
+	return list->second.at(index).get();
 	}
 
 CorrespondenceMap2DWrapper::CorrespondenceMap2DConstPtr BundleHistory::GetMatches(int backwardSteps, std::string correspondenceCategory)
@@ -231,7 +223,7 @@ CorrespondenceMap2DWrapper::CorrespondenceMap2DConstPtr BundleHistory::GetMatche
 		return NULL;
 		}
 
-	return leftRightCorrespondenceMapList[correspondenceCategory].at(index);
+	return list->second.at(index).get();
 	}
 
 PointCloudWrapper::PointCloudConstPtr BundleHistory::GetPointCloud(int backwardSteps, std::string cloudCategory)
@@ -247,7 +239,7 @@ PointCloudWrapper::PointCloudConstPtr BundleHistory::GetPointCloud(int backwardS
 		return NULL;
 		}
 
-	return pointCloudList[cloudCategory].at(index);
+	return list->second.at(index).get();
 	}
 
 void BundleHistory::RemoveEntry(int backwardSteps)
@@ -262,7 +254,7 @@ void BundleHistory::RemoveEntry(int backwardSteps)
 		RemoveOldestEntry();
 		}
 
-	DeleteAllDataAt(index);
+	ResetAllDataAt(index);
 	while (index != mostRecentEntryIndex)
 		{
 		int nextIndex = (index+1) % size;
@@ -270,16 +262,13 @@ void BundleHistory::RemoveEntry(int backwardSteps)
 		leftImageList.at(index) = leftImageList.at(nextIndex);
 		rightImageList.at(index) = rightImageList.at(nextIndex);
 		ReplaceIndexByIndexOnMap(featureVectorList, index, nextIndex);
+		ReplaceIndexByIndexOnMap(featureVector3dList, index, nextIndex);
 		ReplaceIndexByIndexOnMap(leftRightCorrespondenceMapList, index, nextIndex);
 		ReplaceIndexByIndexOnMap(pointCloudList, index, nextIndex);
 		index = nextIndex;		
 		}
 	
-	leftImageList.at(mostRecentEntryIndex) = NULL;
-	rightImageList.at(mostRecentEntryIndex) = NULL;
-	ReplaceIndexByNullOnMap(featureVectorList, mostRecentEntryIndex);
-	ReplaceIndexByNullOnMap(leftRightCorrespondenceMapList, mostRecentEntryIndex);
-	ReplaceIndexByNullOnMap(pointCloudList, mostRecentEntryIndex);
+	ResetAllDataAt(mostRecentEntryIndex);
 
 	if (mostRecentEntryIndex == oldestEntryIndex)
 		{
@@ -293,7 +282,7 @@ void BundleHistory::RemoveEntry(int backwardSteps)
 
 void BundleHistory::RemoveOldestEntry()
 	{
-	DeleteAllDataAt(oldestEntryIndex);
+	ResetAllDataAt(oldestEntryIndex);
 	if (mostRecentEntryIndex == NO_RECENT_ENTRY)
 		{
 		return;
@@ -306,6 +295,41 @@ void BundleHistory::RemoveOldestEntry()
 	oldestEntryIndex = (oldestEntryIndex + 1) % size;
 	}
 
+template <typename Type>
+std::shared_ptr<const Type> BundleHistory::CopyToBuffer(const Type& data, std::vector< std::shared_ptr<Type> >& buffersList, std::shared_ptr<Type> (*newBuffer)())
+	{
+	// A buffer referenced only by this list is not in the history and was released by every caller
+	for(typename std::vector< std::shared_ptr<Type> >::iterator buffer = buffersList.begin(); buffer != buffersList.end(); ++buffer)
+		{
+		if (buffer->use_count() == 1)
+			{
+			Copy(data, **buffer);
+			return *buffer;
+			}
+		}
+
+	std::shared_ptr<Type> buffer = newBuffer();
+	Copy(data, *buffer);
+	buffersList.push_back(buffer);
+	return buffer;
+	}
+
+template <typename Type>
+void BundleHistory::AddToCategory(std::map<std::string, std::vector< std::shared_ptr<const Type> > >& categoriesMap, std::shared_ptr<const Type> data, std::string category)
+	{
+	if (mostRecentEntryIndex == NO_RECENT_ENTRY || discardedCategoriesSet.count(category) > 0)
+		{
+		return;
+		}
+
+	typename std::map<std::string, std::vector< std::shared_ptr<const Type> > >::iterator list = categoriesMap.find(category);
+	if (list == categoriesMap.end())
+		{
+		list = categoriesMap.insert( std::make_pair(category, std::vector< std::shared_ptr<const Type> >(size)) ).first;
+		}
+	list->second.at(mostRecentEntryIndex) = data;
+	}
+
 int BundleHistory::BackwardStepsToIndex(int backwardSteps)
 	{
 	if (backwardSteps >= size)
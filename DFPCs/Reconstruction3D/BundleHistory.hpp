@@ -9,6 +9,8 @@
 
 #include <vector>
 #include <map>
+#include <set>
+#include <memory>
 
 namespace CDFF
 {
@@ -21,15 +23,16 @@ namespace Reconstruction3D
 /*This class keeps memory of the most recent computation history for a sequence of stereo image pairs. It allows storage of the latest N entries, composed by a pair of stereo images,
 a set of 2D features, a set of 3D features, a set of 2D Matches, and a set of point clouds. Only the stereo images are a mondatory component of each entry, all other components are optional.
 When new data is added beyond the N entries, the oldest entry is removed and forgotten. 
+The history shares the ownership of its data: data added through shared pointers is not copied, data added by reference is copied into buffers that are reused once their entry is forgotten.
 */
 class BundleHistory
 	{
 	public:
-		typedef std::vector<FrameWrapper::FrameConstPtr> ImageList;
-		typedef std::vector<VisualPointFeatureVector2DWrapper::VisualPointFeatureVector2DConstPtr> FeatureVectorList;
-		typedef std::vector<VisualPointFeatureVector3DWrapper::VisualPointFeatureVector3DConstPtr> FeatureVector3dList;
-		typedef std::vector<CorrespondenceMap2DWrapper::CorrespondenceMap2DConstPtr> CorrespondenceMapList;
-		typedef std::vector<PointCloudWrapper::PointCloudConstPtr> PointCloudList;
+		typedef std::vector<FrameWrapper::FrameSharedConstPtr> ImageList;
+		typedef std::vector<VisualPointFeatureVector2DWrapper::VisualPointFeatureVector2DSharedConstPtr> FeatureVectorList;
+		typedef std::vector<VisualPointFeatureVector3DWrapper::VisualPointFeatureVector3DSharedConstPtr> FeatureVector3dList;
+		typedef std::vector<CorrespondenceMap2DWrapper::CorrespondenceMap2DSharedConstPtr> CorrespondenceMapList;
+		typedef std::vector<PointCloudWrapper::PointCloudSharedConstPtr> PointCloudList;
 
 		BundleHistory() = delete;
 		explicit BundleHistory(int size);
@@ -69,6 +72,27 @@ class BundleHistory
 		*  @param cloudCategory, the string identifier of the vector in the entry; This allow storage of multiple vectors under different identifiers.
  		*/	
 		void AddPointCloud(const PointCloudWrapper::PointCloud& cloud, std::string cloudCategory = "DEFAULT");
+
+		/* @brief These methods are the same as the methods above, but the history keeps a reference to the input instead of a copy. The input must not be modified afterwards.
+ 		*/
+		void AddImages(FrameWrapper::FrameSharedConstPtr leftImage, FrameWrapper::FrameSharedConstPtr rightImage);
+		void AddFeatures(VisualPointFeatureVector2DWrapper::VisualPointFeatureVector2DSharedConstPtr featureVector, std::string featureCategory = "DEFAULT");
+		void AddFeatures3d(VisualPointFeatureVector3DWrapper::VisualPointFeatureVector3DSharedConstPtr featureVector, std::string featureCategory = "DEFAULT");
+		void AddMatches(CorrespondenceMap2DWrapper::CorrespondenceMap2DSharedConstPtr correspondenceMap, std::string correspondenceCategory = "DEFAULT");
+		void AddPointCloud(PointCloudWrapper::PointCloudSharedConstPtr cloud, std::string cloudCategory = "DEFAULT");
+
+		/* @brief This method sets whether the images are stored. When they are not, AddImages only opens a new entry and GetLeftImage and GetRightImage return NULL.
+		*
+		*  @param retainImages, whether the images are stored.
+ 		*/
+		void SetImagesRetention(bool retainImages);
+
+		/* @brief This method sets whether the data of a category is stored, data added under a category that is not retained is dropped. The category identifier applies to all kinds of data.
+		*
+		*  @param category, the string identifier of the category;
+		*  @param retain, whether the data of the category is stored.
+ 		*/
+		void SetCategoryRetention(std::string category, bool retain);
 		
 
 		/* @brief This method retrieves the left image associate to an entry.
@@ -139,12 +163,21 @@ class BundleHistory
 		std::map<std::string, CorrespondenceMapList> leftRightCorrespondenceMapList;
 		std::map<std::string, PointCloudList> pointCloudList;
 
-		//Support methods for adding data to the queue
-		void AddImages(FrameWrapper::FrameConstPtr leftImage, FrameWrapper::FrameConstPtr rightImage);
-		void AddFeatures(VisualPointFeatureVector2DWrapper::VisualPointFeatureVector2DConstPtr featureVector, std::string featureCategory = "DEFAULT");
-		void AddFeatures3d(VisualPointFeatureVector3DWrapper::VisualPointFeatureVector3DConstPtr featureVector, std::string featureCategory = "DEFAULT");
-		void AddMatches(CorrespondenceMap2DWrapper::CorrespondenceMap2DConstPtr leftRightCorrespondenceMap, std::string correspondenceCategory = "DEFAULT");
-		void AddPointCloud(PointCloudWrapper::PointCloudConstPtr, std::string cloudCategory = "DEFAULT");
+		bool retainImages;
+		std::set<std::string> discardedCategoriesSet;
+
+		//Buffers holding the copies of the data added by reference, a buffer is free when no entry and no caller references it any more
+		std::vector<FrameWrapper::FrameSharedPtr> frameBuffersList;
+		std::vector<VisualPointFeatureVector2DWrapper::VisualPointFeatureVector2DSharedPtr> featureVectorBuffersList;
+		std::vector<VisualPointFeatureVector3DWrapper::VisualPointFeatureVector3DSharedPtr> featureVector3dBuffersList;
+		std::vector<CorrespondenceMap2DWrapper::CorrespondenceMap2DSharedPtr> correspondenceMapBuffersList;
+		std::vector<PointCloudWrapper::PointCloudSharedPtr> pointCloudBuffersList;
+
+		template <typename Type>
+		std::shared_ptr<const Type> CopyToBuffer(const Type& data, std::vector< std::shared_ptr<Type> >& buffersList, std::shared_ptr<Type> (*newBuffer)());
+
+		template <typename Type>
+		void AddToCategory(std::map<std::string, std::vector< std::shared_ptr<const Type> > >& categoriesMap, std::shared_ptr<const Type> data, std::string category);
 
 		// Conversion method between the queue index and the time step distance between an entry and the most recent one
 		int BackwardStepsToIndex(int backwardSteps);
@@ -154,31 +187,22 @@ class BundleHistory
 	*
 	*/
 		template <typename Type>
-		inline void DeleteIfNotNull(Type* &pointer)
-			{
-			if (pointer != NULL)
-				{
-				delete (pointer);
-				pointer = NULL;
-				}
-			}
-
-		template <typename Type>
-		inline void DeleteMapEntry(std::map<std::string, Type>& vectorMap, int index)
+		inline void ResetMapEntry(std::map<std::string, Type>& vectorMap, int index)
 			{
 			for(typename std::map<std::string, Type>::iterator iterator = vectorMap.begin(); iterator != vectorMap.end(); ++iterator)
 				{
-				DeleteIfNotNull( iterator->second.at(index) );
+				iterator->second.at(index).reset();
 				}
 			}
 
-		inline void DeleteAllDataAt(int index)
+		inline void ResetAllDataAt(int index)
 			{
-			DeleteIfNotNull( leftImageList.at(index) );
-			DeleteIfNotNull( rightImageList.at(index) );
-			DeleteMapEntry( featureVectorList, index );
-			DeleteMapEntry( leftRightCorrespondenceMapList, index );
-			DeleteMapEntry( pointCloudList, index );
+			leftImageList.at(index).reset();
+			rightImageList.at(index).reset();
+			ResetMapEntry( featureVectorList, index );
+			ResetMapEntry( featureVector3dList, index );
+			ResetMapEntry( leftRightCorrespondenceMapList, index );
+			ResetMapEntry( pointCloudList, index );
 			}
 
 		template <typename Type>
@@ -190,15 +214,6 @@ class BundleHistory
 				}
 			}
 
-		template <typename Type>
-		inline void ReplaceIndexByNullOnMap(std::map<std::string, Type>& vectorMap, int replacedIndex)
-			{
-			for(typename std::map<std::string, Type>::iterator iterator = vectorMap.begin(); iterator != vectorMap.end(); ++iterator)
-				{
-				iterator->second.at(replacedIndex) = NULL;
-				}
-			}
-
 	};
 
 }
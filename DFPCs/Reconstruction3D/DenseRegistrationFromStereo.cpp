@@ -29,6 +29,7 @@
 #include "DenseRegistrationFromStereo.hpp"
 #include <Errors/Assert.hpp>
 #include <Errors/AssertOnTest.hpp>
+#include <Macros/TracingMacros.hpp>
 
 #include <Executors/ImageFiltering/ImageFilteringExecutor.hpp>
 #include <Executors/StereoReconstruction/StereoReconstructionExecutor.hpp>
@@ -73,9 +74,15 @@ DenseRegistrationFromStereo::DenseRegistrationFromStereo() :
 	parameters = DEFAULT_PARAMETERS;
 
 	parametersHelper.AddParameter<float>("GeneralParameters", "PointCloudMapResolution", parameters.pointCloudMapResolution, DEFAULT_PARAMETERS.pointCloudMapResolution);
+	parametersHelper.AddParameter<int>("GeneralParameters", "PointCloudMapMemoryBudget", parameters.pointCloudMapMemoryBudget, DEFAULT_PARAMETERS.pointCloudMapMemoryBudget);
+	parametersHelper.AddParameter<std::string>("GeneralParameters", "PointCloudMapSwapFolder", parameters.pointCloudMapSwapFolder, DEFAULT_PARAMETERS.pointCloudMapSwapFolder);
+	parametersHelper.AddParameter<int>("GeneralParameters", "PointCloudMapLevelsOfDetail", parameters.pointCloudMapLevelsOfDetail, DEFAULT_PARAMETERS.pointCloudMapLevelsOfDetail);
+	parametersHelper.AddParameter<float>("GeneralParameters", "PointCloudMapLevelOfDetailDistance", parameters.pointCloudMapLevelOfDetailDistance, DEFAULT_PARAMETERS.pointCloudMapLevelOfDetailDistance);
+	parametersHelper.AddParameter<int>("GeneralParameters", "PointCloudMapOutputBudget", parameters.pointCloudMapOutputBudget, DEFAULT_PARAMETERS.pointCloudMapOutputBudget);
 	parametersHelper.AddParameter<float>("GeneralParameters", "SearchRadius", parameters.searchRadius, DEFAULT_PARAMETERS.searchRadius);
 	parametersHelper.AddParameter<bool>("GeneralParameters", "MatchToReconstructedCloud", parameters.matchToReconstructedCloud, DEFAULT_PARAMETERS.matchToReconstructedCloud);
 	parametersHelper.AddParameter<bool>("GeneralParameters", "UseAssemblerDfn", parameters.useAssemblerDfn, DEFAULT_PARAMETERS.useAssemblerDfn);
+	parametersHelper.AddParameter<bool>("GeneralParameters", "UseIncrementalTarget", parameters.useIncrementalTarget, DEFAULT_PARAMETERS.useIncrementalTarget);
 
 	ADD_PARAMETER_WITH_HELPER(CloudUpdateType, CloudUpdateTypeHelper, "GeneralParameters", "CloudUpdateType", cloudUpdateType);
 	parametersHelper.AddParameter<int>("GeneralParameters", "CloudUpdateTime", parameters.cloudUpdateTime, DEFAULT_PARAMETERS.cloudUpdateTime);
@@ -83,6 +90,9 @@ DenseRegistrationFromStereo::DenseRegistrationFromStereo() :
 	parametersHelper.AddParameter<double>("GeneralParameters", "CloudUpdateOrientationDistance", parameters.cloudUpdateOrientationDistance, DEFAULT_PARAMETERS.cloudUpdateOrientationDistance);
 	parametersHelper.AddParameter<float>("GeneralParameters", "OverlapThreshold", parameters.overlapThreshold, DEFAULT_PARAMETERS.overlapThreshold);
 	parametersHelper.AddParameter<float>("GeneralParameters", "OverlapInlierDistance", parameters.overlapInlierDistance, DEFAULT_PARAMETERS.overlapInlierDistance);
+	parametersHelper.AddParameter<float>("GeneralParameters", "KeyframeTranslation", parameters.keyframeTranslation, DEFAULT_PARAMETERS.keyframeTranslation);
+	parametersHelper.AddParameter<float>("GeneralParameters", "KeyframeRotation", parameters.keyframeRotation, DEFAULT_PARAMETERS.keyframeRotation);
+	parametersHelper.AddParameter<float>("GeneralParameters", "KeyframeOverlap", parameters.keyframeOverlap, DEFAULT_PARAMETERS.keyframeOverlap);
 
 	parametersHelper.AddParameter<bool>("GeneralParameters", "SaveCloudsToFile", parameters.saveCloudsToFile, DEFAULT_PARAMETERS.saveCloudsToFile);
 	parametersHelper.AddParameter<int>("GeneralParameters", "CloudSaveTime", parameters.cloudSaveTime, DEFAULT_PARAMETERS.cloudSaveTime);
@@ -100,7 +110,10 @@ DenseRegistrationFromStereo::DenseRegistrationFromStereo() :
 	cloudFilter = NULL;
 
 	bundleHistory = new BundleHistory(2);
+	bundleHistory->SetImagesRetention(false);
 	outputPoseAtLastMergeSet = false;
+	isKeyframe = true;
+	registrationTargetCenterSet = false;
 	}
 
 DenseRegistrationFromStereo::~DenseRegistrationFromStereo()
@@ -111,6 +124,7 @@ DenseRegistrationFromStereo::~DenseRegistrationFromStereo()
 
 void DenseRegistrationFromStereo::run() 
 	{
+	TRACE_SCOPE_CATEGORY("DenseRegistrationFromStereo::run", "DFPC");
 	DEBUG_PRINT_TO_LOG("Registration from stereo start", "");
 
 	bundleHistory->AddImages(inLeftImage, inRightImage);
@@ -140,10 +154,14 @@ void DenseRegistrationFromStereo::run()
 		{
 		UpdatePointCloudOnDistanceCovered(imageCloud);
 		}
-	else
+	else if (parameters.cloudUpdateType == CloudUpdateType::MaximumOverlapping)
 		{
 		UpdatePointCloudOnMaximumOverlapping(imageCloud);
 		}
+	else
+		{
+		UpdatePointCloudOnKeyframe(imageCloud);
+		}
 
 	SaveOutputCloud();
 	}
@@ -155,6 +173,10 @@ void DenseRegistrationFromStereo::setup()
 	InstantiateDFNs();
 
 	pointCloudMap.SetResolution(parameters.pointCloudMapResolution);
+	pointCloudMap.SetMemoryBudget(static_cast<size_t>(parameters.pointCloudMapMemoryBudget) * 1024 * 1024, parameters.pointCloudMapSwapFolder);
+	pointCloudMap.SetLevelsOfDetail(parameters.pointCloudMapLevelsOfDetail, parameters.pointCloudMapLevelOfDetailDistance);
+	keyframeSelector.SetThresholds(parameters.keyframeTranslation, parameters.keyframeRotation, parameters.keyframeOverlap, 0);
+	registrationTarget.SetResolution(parameters.pointCloudMapResolution);
 	}
 
 /* --------------------------------------------------------------------------
@@ -168,14 +190,23 @@ const DenseRegistrationFromStereo::RegistrationFromStereoOptionsSet DenseRegistr
 	{
 	/*.searchRadius =*/ 20,
 	/*.pointCloudMapResolution =*/ 1e-2,
+	/*.pointCloudMapMemoryBudget =*/ 0,
+	/*.pointCloudMapSwapFolder =*/ ".",
+	/*.pointCloudMapLevelsOfDetail =*/ 1,
+	/*.pointCloudMapLevelOfDetailDistance =*/ 5,
+	/*.pointCloudMapOutputBudget =*/ 0,
 	/*.matchToReconstructedCloud =*/ false,
 	/*.useAssemblerDfn=*/ false,
+	/*.useIncrementalTarget=*/ false,
 	/*.cloudUpdateType=*/ CloudUpdateType::TimePassed,
 	/*.cloudUpdateTime=*/ 50,
 	/*.cloudUpdateTranslationDistance=*/ 0.5,
 	/*.cloudUpdateOrientationDistance=*/ 0.5,
 	/*.overlapThreshold=*/ 0.80,
 	/*.overlapInlierDistance=*/ 0.01,
+	/*.keyframeTranslation=*/ 0.5,
+	/*.keyframeRotation=*/ 0.5,
+	/*.keyframeOverlap=*/ 0.8,
 	/*.saveCloudsToFile=*/ false,
 	/*.cloudSaveTime=*/ 100,
 	/*.cloudSavePath=*/ ""
@@ -201,10 +232,14 @@ DenseRegistrationFromStereo::CloudUpdateType DenseRegistrationFromStereo::CloudU
 	{
 		return CloudUpdateType::MaximumOverlapping;
 	}
+	else if (cloudUpdateType == "Keyframe" || cloudUpdateType == "3")
+	{
+		return CloudUpdateType::KeyframeSelected;
+	}
 	else
 	{
 		std::string errorString = "DenseRegistrationFromStereo ConfigurationError: cloudUpdateType has to be one of ";
-		errorString += "{Time, Distance, Overlapping}";
+		errorString += "{Time, Distance, Overlapping, Keyframe}";
 		ASSERT(false, errorString);
 	}
 }
@@ -220,12 +255,23 @@ void DenseRegistrationFromStereo::ConfigureExtraParameters()
 	parametersHelper.ReadFile( configurator.GetExtraParametersConfigurationFilePath() );
 
 	ASSERT(parameters.pointCloudMapResolution > 0, "DenseRegistrationFromStereo Error, Point Cloud Map resolution is not positive");
+	ASSERT(parameters.pointCloudMapMemoryBudget >= 0, "DenseRegistrationFromStereo Error, Point Cloud Map memory budget is negative");
+	ASSERT(parameters.pointCloudMapLevelsOfDetail >= 1 && parameters.pointCloudMapLevelsOfDetail <= static_cast<int>(PointCloudMap::MAXIMUM_NUMBER_OF_LEVELS), "DenseRegistrationFromStereo Error, Point Cloud Map levels of detail out of range");
+	ASSERT(parameters.pointCloudMapLevelOfDetailDistance > 0, "DenseRegistrationFromStereo Error, Point Cloud Map level of detail distance is not positive");
+	ASSERT(parameters.pointCloudMapOutputBudget >= 0, "DenseRegistrationFromStereo Error, Point Cloud Map output budget is negative");
 	ASSERT(parameters.cloudUpdateTime > 0, "DenseRegistrationFromStereo Error, cloudUpdateTime is not positive");
 	ASSERT(parameters.cloudSaveTime > 0, "DenseRegistrationFromStereo Error, cloudUpdateTime is not positive");
 	ASSERT(parameters.cloudUpdateTranslationDistance > 0, "DenseRegistrationFromStereo Error, cloudUpdateTranslationDistance is not positive");
 	ASSERT(parameters.cloudUpdateOrientationDistance > 0, "DenseRegistrationFromStereo Error, cloudUpdateOrientationDistance is not positive");
 	ASSERT(parameters.overlapThreshold > 0, "DenseRegistrationFromStereo Error, overlapThreshold is not positive");
 	ASSERT(parameters.overlapInlierDistance > 0, "DenseRegistrationFromStereo Error, overlapInlierDistance is not positive");
+	ASSERT(parameters.keyframeOverlap <= 1, "DenseRegistrationFromStereo Error, keyframeOverlap is greater than 1");
+	if (parameters.useIncrementalTarget)
+		{
+		ASSERT(parameters.matchToReconstructedCloud, "DenseRegistrationFromStereo Error, useIncrementalTarget requires matchToReconstructedCloud");
+		ASSERT(!parameters.useAssemblerDfn, "DenseRegistrationFromStereo Error, useIncrementalTarget cannot be used with the assembler DFN");
+		ASSERT(parameters.searchRadius > 0, "DenseRegistrationFromStereo Error, useIncrementalTarget requires a positive searchRadius");
+		}
 	if (parameters.saveCloudsToFile)
 		{
 		ASSERT( access(parameters.cloudSavePath.c_str(), 0) == 0, "DenseRegistrationFromStereo Error, save folder does not exists");
@@ -242,6 +288,12 @@ void DenseRegistrationFromStereo::InstantiateDFNs()
 	reconstructor3d = static_cast<StereoReconstructionInterface*>( configurator.GetDfn("reconstructor3D") );
 	registrator3d = static_cast<Registration3DInterface*>( configurator.GetDfn("registrator3d") );
 	cloudFilter = static_cast<PointCloudFilteringInterface*>( configurator.GetDfn("cloudFilter", true) );
+	if (parameters.useIncrementalTarget)
+		{
+		bool targetSupported = registrator3d->setSinkTarget(&registrationTarget);
+		registrator3d->setSinkTarget(NULL);
+		ASSERT(targetSupported, "DenseRegistrationFromStereo Error, useIncrementalTarget requires a registration DFN that supports an incremental sink target");
+		}
 	if (parameters.useAssemblerDfn)
 		{
 		cloudAssembler = static_cast<PointCloudAssemblyInterface*>( configurator.GetDfn("cloudAssembler") );
@@ -264,13 +316,30 @@ void DenseRegistrationFromStereo::UpdatePose(PointCloudConstPtr imageCloud)
 			pointCloudMap.AddPointCloud( imageCloud, EMPTY_FEATURE_VECTOR, &zeroPose);
 			}
 		Copy(zeroPose, outPose);
+		keyframeSelector.SetKeyframe(zeroPose);
+		isKeyframe = true;
+		if (parameters.useIncrementalTarget)
+			{
+			UpdateRegistrationTarget(imageCloud);
+			}
 		}
 	else
 		{
+		//With the incremental target, the registration gives directly the pose in map, as the target is in map coordinates
 		Pose3DConstPtr poseToPreviousPose = NULL;
-		Executors::Execute(registrator3d, imageCloud, bundleHistory->GetPointCloud(1), &outPose, poseToPreviousPose, outSuccess);
+		Pose3D poseInTarget;
+		if (parameters.useIncrementalTarget)
+			{
+			Executors::Execute(registrator3d, *imageCloud, &registrationTarget, outPose, poseInTarget, outSuccess);
+			poseToPreviousPose = &poseInTarget;
+			}
+		else
+			{
+			Executors::Execute(registrator3d, imageCloud, bundleHistory->GetPointCloud(1), &outPose, poseToPreviousPose, outSuccess);
+			}
 		if (outSuccess)
 			{
+			isKeyframe = IsKeyframe(imageCloud, poseToPreviousPose);
 			if (parameters.useAssemblerDfn && parameters.matchToReconstructedCloud)
 				{
 				Copy(*poseToPreviousPose, outPose);
@@ -282,18 +351,92 @@ void DenseRegistrationFromStereo::UpdatePose(PointCloudConstPtr imageCloud)
 				}
 			else if (!parameters.useAssemblerDfn && parameters.matchToReconstructedCloud)
 				{
-				pointCloudMap.AddPointCloud( imageCloud, EMPTY_FEATURE_VECTOR, poseToPreviousPose);
+				if (isKeyframe)
+					{
+					pointCloudMap.AddPointCloud( imageCloud, EMPTY_FEATURE_VECTOR, poseToPreviousPose);
+					}
 				Copy(*poseToPreviousPose, outPose);
+				if (parameters.useIncrementalTarget)
+					{
+					UpdateRegistrationTarget(isKeyframe ? imageCloud : NULL);
+					}
 				}
 			else
 				{
-				pointCloudMap.AttachPointCloud( imageCloud, EMPTY_FEATURE_VECTOR, poseToPreviousPose);
+				if (isKeyframe)
+					{
+					pointCloudMap.AttachPointCloud( imageCloud, EMPTY_FEATURE_VECTOR, poseToPreviousPose);
+					}
+				else
+					{
+					pointCloudMap.AttachPose(poseToPreviousPose);
+					}
 				Copy( pointCloudMap.GetLatestPose(), outPose);
 				}
+
+			if (isKeyframe)
+				{
+				keyframeSelector.SetKeyframe(outPose);
+				}
 			}
 		}
 	}
 
+/**
+* The target follows the camera: the map points that entered the search radius since the previous update and the points of the added cloud are inserted, the points that left the radius
+* are removed, so that the search structure of the target is never rebuilt. The added cloud is at the current output pose, and it is already in the map.
+*/
+void DenseRegistrationFromStereo::UpdateRegistrationTarget(PointCloudConstPtr addedCloud)
+	{
+	PointCloudConstPtr enteringCloud = NULL;
+	if (!registrationTargetCenterSet)
+		{
+		enteringCloud = pointCloudMap.GetScenePointCloud(&outPose, parameters.searchRadius);
+		}
+	else
+		{
+		enteringCloud = pointCloudMap.GetScenePointCloudEnteringRadius(&registrationTargetCenter, &outPose, parameters.searchRadius);
+		if (addedCloud != NULL)
+			{
+			registrationTarget.AddPoints(*addedCloud, outPose);
+			}
+		}
+	registrationTarget.AddPoints(*enteringCloud);
+	delete(enteringCloud);
+
+	registrationTarget.RemovePointsOutside(outPose, parameters.searchRadius);
+	Copy(outPose, registrationTargetCenter);
+	registrationTargetCenterSet = true;
+	DEBUG_PRINT_TO_LOG("registration target points", registrationTarget.GetNumberOfPoints());
+	}
+
+bool DenseRegistrationFromStereo::IsKeyframe(PointCloudConstPtr imageCloud, Pose3DConstPtr poseToPreviousPose)
+	{
+	if (parameters.cloudUpdateType != CloudUpdateType::KeyframeSelected)
+		{
+		return true;
+		}
+
+	Pose3D poseInMap;
+	if (parameters.matchToReconstructedCloud)
+		{
+		Copy(*poseToPreviousPose, poseInMap);
+		}
+	else
+		{
+		poseInMap = Sum(outPose, *poseToPreviousPose);
+		}
+
+	float overlapRatio = 1;
+	if (keyframeSelector.UsesOverlap())
+		{
+		overlapRatio = parameters.useAssemblerDfn ? 
+			ComputeOverlappingRatio(imageCloud, poseInMap, bundleHistory->GetPointCloud(1)) : pointCloudMap.ComputeOverlapRatio(imageCloud, &poseInMap);
+		DEBUG_PRINT_TO_LOG("Overlap ratio", overlapRatio);
+		}
+	return keyframeSelector.IsKeyframe(poseInMap, overlapRatio);
+	}
+
 void DenseRegistrationFromStereo::UpdatePointCloudOnTimePassed(PointCloudWrapper::PointCloudConstPtr imageCloud)
 	{
 	static int mergeCounter = 0;
@@ -377,6 +520,22 @@ void DenseRegistrationFromStereo::UpdatePointCloudOnMaximumOverlapping(PointClou
 		}
 	}
 
+void DenseRegistrationFromStereo::UpdatePointCloudOnKeyframe(PointCloudWrapper::PointCloudConstPtr inputCloud)
+	{
+	if (!outSuccess)
+		{
+		bundleHistory->RemoveEntry(0);
+		}
+	else if (isKeyframe)
+		{
+		MergePointCloud(inputCloud);
+		}
+	else
+		{
+		bundleHistory->AddPointCloud(outPointCloud);
+		}
+	}
+
 void DenseRegistrationFromStereo::MergePointCloud(PointCloudConstPtr imageCloud)
 	{
 	PointCloudWrapper::PointCloudConstPtr outputPointCloud = NULL;
@@ -388,7 +547,7 @@ void DenseRegistrationFromStereo::MergePointCloud(PointCloudConstPtr imageCloud)
 		}
 	else
 		{
-		outputPointCloud = pointCloudMap.GetScenePointCloudInOrigin(&outPose, parameters.searchRadius);
+		outputPointCloud = pointCloudMap.GetScenePointCloudInOrigin(&outPose, parameters.searchRadius, parameters.pointCloudMapOutputBudget);
 		}
 
 	Copy(*outputPointCloud, outPointCloud);
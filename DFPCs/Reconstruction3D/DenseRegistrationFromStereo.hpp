@@ -37,12 +37,14 @@
 #include <ImageFiltering/ImageFilteringInterface.hpp>
 #include <StereoReconstruction/StereoReconstructionInterface.hpp>
 #include <Registration3D/Registration3DInterface.hpp>
+#include <Registration3D/IncrementalTargetCloud.hpp>
 #include <PointCloudAssembly/PointCloudAssemblyInterface.hpp>
 #include <PointCloudTransformation/PointCloudTransformationInterface.hpp>
 #include <PointCloudFiltering/PointCloudFilteringInterface.hpp>
 
 #include "PointCloudMap.hpp"
 #include "BundleHistory.hpp"
+#include "KeyframeSelector.hpp"
 
 #include <Helpers/ParametersListHelper.hpp>
 #include <DfpcConfigurator.hpp>
@@ -70,10 +72,21 @@ namespace Reconstruction3D
  * This DFPC is configured according to the following parameters (beyond those that are needed to configure the DFN components):
  *
  * @param SearchRadius, the output is given by the point of the reconstructed cloud contained within a sphere of center given by the current camera pose and radius given by this parameter;
- * @param PointCloudMapResolution, the voxel resolution of the output point cloud, if the cloud is denser it will be filtered by PCL voxel filter;
+ * @param PointCloudMapResolution, the voxel resolution of the output point cloud, points falling in the same voxel are merged into their centroid;
+ * @param PointCloudMapMemoryBudget, the memory in megabytes the point cloud map may use before its tiles farthest from the camera are swapped to disk, zero means no limit;
+ * @param PointCloudMapSwapFolder, the existing folder where the point cloud map writes its swap files;
+ * @param PointCloudMapLevelsOfDetail, the number of voxel resolutions kept by the point cloud map, each one twice as coarse as the previous one, 1 disables the levels of detail;
+ * @param PointCloudMapLevelOfDetailDistance, the output points are at full resolution up to this distance from the camera, then the resolution halves each time the distance doubles;
+ * @param PointCloudMapOutputBudget, the maximum number of points of the output point cloud, the levels of detail are made coarser to fit it, zero means the maximum size of a point cloud;
  * @param MatchToReconstructedCloud, whether the cloud is matched to the previous reconstruction or is matched to the previous frame;
  * @param UseAssemblerDfn, whether the assembler DFN is used, if this argument is false the assembly is done by simple overlapping and voxel filtering;
+ * @param UseIncrementalTarget, whether the registration DFN matches the cloud to a copy of the map within SearchRadius that is updated incrementally as the camera moves, instead of a cloud
+ * extracted from the map at every merge; it requires MatchToReconstructedCloud, it cannot be used with UseAssemblerDfn, and the registration DFN has to support an incremental sink target;
  * @param CloudUpdateTime, the number of frames between two point cloud assembly, intermediate frames are used only to update the pose and will not extend the point cloud;
+ * @param CloudUpdateType, one of Time, Distance, Overlapping or Keyframe; with Keyframe only the clouds of keyframes extend the point cloud map, the other frames only update the pose;
+ * @param KeyframeTranslation, with CloudUpdateType Keyframe a frame is a keyframe when the camera moved this distance from the latest keyframe, zero or less disables this criterion;
+ * @param KeyframeRotation, with CloudUpdateType Keyframe a frame is a keyframe when the camera rotated this angle in radians from the latest keyframe, zero or less disables this criterion;
+ * @param KeyframeOverlap, with CloudUpdateType Keyframe a frame is a keyframe when the ratio of its points that overlap the map is below this value, zero or less disables this criterion;
  * @param SaveCloudsToFile, whether to save the output clouds to file;
  * @param CloudSaveTime, the number of frames between two saving of the point cloud, clouds will not be save during intermediate frames;
  * @param cloudSavePath, the folder path where the point clouds are saved.
@@ -112,7 +125,8 @@ namespace Reconstruction3D
 			{
 			TimePassed,
 			DistanceCovered,
-			MaximumOverlapping
+			MaximumOverlapping,
+			KeyframeSelected
 			};
 		class CloudUpdateTypeHelper : public Helpers::ParameterHelper<CloudUpdateType, std::string>
 			{
@@ -126,8 +140,14 @@ namespace Reconstruction3D
 			{
 			float searchRadius;
 			float pointCloudMapResolution;
+			int pointCloudMapMemoryBudget;
+			std::string pointCloudMapSwapFolder;
+			int pointCloudMapLevelsOfDetail;
+			float pointCloudMapLevelOfDetailDistance;
+			int pointCloudMapOutputBudget;
 			bool matchToReconstructedCloud;
 			bool useAssemblerDfn;
+			bool useIncrementalTarget;
 
 			CloudUpdateType cloudUpdateType;
 			int cloudUpdateTime;
@@ -135,6 +155,9 @@ namespace Reconstruction3D
 			double cloudUpdateOrientationDistance;
 			float overlapThreshold;
 			float overlapInlierDistance;
+			float keyframeTranslation;
+			float keyframeRotation;
+			float keyframeOverlap;
 
 			bool saveCloudsToFile;
 			int cloudSaveTime;
@@ -165,6 +188,11 @@ namespace Reconstruction3D
 		PoseWrapper::Pose3D outputPoseAtLastMerge; 
 		bool outputPoseAtLastMergeSet;
 		PointCloudMap pointCloudMap; //the most recent point cloud
+		KeyframeSelector keyframeSelector;
+		bool isKeyframe; //whether the latest frame extended the point cloud map
+		CDFF::DFN::Registration3D::IncrementalTargetCloud registrationTarget; //the map points within the search radius of the latest pose, in map coordinates
+		PoseWrapper::Pose3D registrationTargetCenter;
+		bool registrationTargetCenterSet;
 		bool firstInput;
 
 		//Parameters Configuration method
@@ -175,9 +203,12 @@ namespace Reconstruction3D
 
 		//Core computation method that execute a step of the DFPC pipeline
 		void UpdatePose(PointCloudWrapper::PointCloudConstPtr inputCloud);
+		void UpdateRegistrationTarget(PointCloudWrapper::PointCloudConstPtr addedCloud);
 		void UpdatePointCloudOnTimePassed(PointCloudWrapper::PointCloudConstPtr inputCloud);
 		void UpdatePointCloudOnDistanceCovered(PointCloudWrapper::PointCloudConstPtr inputCloud);
 		void UpdatePointCloudOnMaximumOverlapping(PointCloudWrapper::PointCloudConstPtr inputCloud);
+		void UpdatePointCloudOnKeyframe(PointCloudWrapper::PointCloudConstPtr inputCloud);
+		bool IsKeyframe(PointCloudWrapper::PointCloudConstPtr inputCloud, PoseWrapper::Pose3DConstPtr poseToPreviousPose);
 		void MergePointCloud(PointCloudWrapper::PointCloudConstPtr inputCloud);
 
 		// Computation helper methods
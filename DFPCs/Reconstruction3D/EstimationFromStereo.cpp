@@ -29,6 +29,7 @@
 #include "EstimationFromStereo.hpp"
 #include <Errors/Assert.hpp>
 #include <Errors/AssertOnTest.hpp>
+#include <Macros/TracingMacros.hpp>
 #include <Types/CPP/VisualPointFeatureVector3D.hpp>
 
 #include <Executors/ImageFiltering/ImageFilteringExecutor.hpp>
@@ -75,6 +76,11 @@ EstimationFromStereo::EstimationFromStereo() :
 	parameters = DEFAULT_PARAMETERS;
 
 	parametersHelper.AddParameter<float>("GeneralParameters", "PointCloudMapResolution", parameters.pointCloudMapResolution, DEFAULT_PARAMETERS.pointCloudMapResolution);
+	parametersHelper.AddParameter<int>("GeneralParameters", "PointCloudMapMemoryBudget", parameters.pointCloudMapMemoryBudget, DEFAULT_PARAMETERS.pointCloudMapMemoryBudget);
+	parametersHelper.AddParameter<std::string>("GeneralParameters", "PointCloudMapSwapFolder", parameters.pointCloudMapSwapFolder, DEFAULT_PARAMETERS.pointCloudMapSwapFolder);
+	parametersHelper.AddParameter<int>("GeneralParameters", "PointCloudMapLevelsOfDetail", parameters.pointCloudMapLevelsOfDetail, DEFAULT_PARAMETERS.pointCloudMapLevelsOfDetail);
+	parametersHelper.AddParameter<float>("GeneralParameters", "PointCloudMapLevelOfDetailDistance", parameters.pointCloudMapLevelOfDetailDistance, DEFAULT_PARAMETERS.pointCloudMapLevelOfDetailDistance);
+	parametersHelper.AddParameter<int>("GeneralParameters", "PointCloudMapOutputBudget", parameters.pointCloudMapOutputBudget, DEFAULT_PARAMETERS.pointCloudMapOutputBudget);
 	parametersHelper.AddParameter<float>("GeneralParameters", "SearchRadius", parameters.searchRadius, DEFAULT_PARAMETERS.searchRadius);
 	parametersHelper.AddParameter<int>("GeneralParameters", "NumberOfAdjustedStereoPairs", parameters.numberOfAdjustedStereoPairs, DEFAULT_PARAMETERS.numberOfAdjustedStereoPairs);
 	parametersHelper.AddParameter<float>("GeneralParameters", "Baseline", parameters.baseline, DEFAULT_PARAMETERS.baseline);
@@ -115,6 +121,7 @@ EstimationFromStereo::~EstimationFromStereo()
 
 void EstimationFromStereo::run() 
 	{
+	TRACE_SCOPE_CATEGORY("EstimationFromStereo::run", "DFPC");
 	DEBUG_PRINT_TO_LOG("Estimation from stereo start", "");
  
 	bundleHistory->AddImages(inLeftImage, inRightImage);
@@ -158,7 +165,7 @@ void EstimationFromStereo::run()
 			}
 
 		Copy( pointCloudMap.GetLatestPose(), outPose);
-		PointCloudWrapper::PointCloudConstPtr outputPointCloud = pointCloudMap.GetScenePointCloudInOrigin(&outPose, parameters.searchRadius);
+		PointCloudWrapper::PointCloudConstPtr outputPointCloud = pointCloudMap.GetScenePointCloudInOrigin(&outPose, parameters.searchRadius, parameters.pointCloudMapOutputBudget);
 		Copy(*outputPointCloud, outPointCloud); 
 
 		DEBUG_PRINT_TO_LOG("pose", ToString(outPose));
@@ -179,11 +186,14 @@ void EstimationFromStereo::setup()
 
 	DeleteIfNotNull(bundleHistory);
 	bundleHistory = new BundleHistory(parameters.numberOfAdjustedStereoPairs + 1);
+	bundleHistory->SetImagesRetention(false);
 
 	DeleteIfNotNull(correspondencesRecorder);
 	correspondencesRecorder = new MultipleCorrespondences3DRecorder(parameters.numberOfAdjustedStereoPairs);	
 
 	pointCloudMap.SetResolution(parameters.pointCloudMapResolution);
+	pointCloudMap.SetMemoryBudget(static_cast<size_t>(parameters.pointCloudMapMemoryBudget) * 1024 * 1024, parameters.pointCloudMapSwapFolder);
+	pointCloudMap.SetLevelsOfDetail(parameters.pointCloudMapLevelsOfDetail, parameters.pointCloudMapLevelOfDetailDistance);
 
 	SetPosition(rightToLeftCameraPose, -parameters.baseline, 0, 0);
 	SetOrientation(rightToLeftCameraPose, 0, 0, 0, 1);
@@ -200,6 +210,11 @@ const EstimationFromStereo::EstimationFromStereoOptionsSet EstimationFromStereo:
 	{
 	/*.searchRadius =*/ 20,
 	/*.pointCloudMapResolution =*/ 1e-2,
+	/*.pointCloudMapMemoryBudget =*/ 0,
+	/*.pointCloudMapSwapFolder =*/ ".",
+	/*.pointCloudMapLevelsOfDetail =*/ 1,
+	/*.pointCloudMapLevelOfDetailDistance =*/ 5,
+	/*.pointCloudMapOutputBudget =*/ 0,
 	/*.numberOfAdjustedStereoPairs =*/ 4,
 	/*.baseline =*/ 1
 	};
@@ -215,6 +230,10 @@ void EstimationFromStereo::ConfigureExtraParameters()
 	parametersHelper.ReadFile( configurator.GetExtraParametersConfigurationFilePath() );
 
 	ASSERT(parameters.pointCloudMapResolution > 0, "EstimationFromStereo Error, Point Cloud Map resolution is not positive");
+	ASSERT(parameters.pointCloudMapMemoryBudget >= 0, "EstimationFromStereo Error, Point Cloud Map memory budget is negative");
+	ASSERT(parameters.pointCloudMapLevelsOfDetail >= 1 && parameters.pointCloudMapLevelsOfDetail <= static_cast<int>(PointCloudMap::MAXIMUM_NUMBER_OF_LEVELS), "EstimationFromStereo Error, Point Cloud Map levels of detail out of range");
+	ASSERT(parameters.pointCloudMapLevelOfDetailDistance > 0, "EstimationFromStereo Error, Point Cloud Map level of detail distance is not positive");
+	ASSERT(parameters.pointCloudMapOutputBudget >= 0, "EstimationFromStereo Error, Point Cloud Map output budget is negative");
 	}
 
 void EstimationFromStereo::InstantiateDFNs()
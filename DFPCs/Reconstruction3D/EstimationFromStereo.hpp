@@ -26,7 +26,12 @@
  *
  * This DFPC is configured according to the following parameters (beyond those that are needed to configure the DFN components):
  * @param SearchRadius, the output is given by the point of the reconstructed cloud contained within a sphere of center given by the current camera pose and radius given by this parameter;
- * @param PointCloudMapResolution, the voxel resolution of the output point cloud, if the cloud is denser it will be filtered by PCL voxel filter;
+ * @param PointCloudMapResolution, the voxel resolution of the output point cloud, points falling in the same voxel are merged into their centroid;
+ * @param PointCloudMapMemoryBudget, the memory in megabytes the point cloud map may use before its tiles farthest from the camera are swapped to disk, zero means no limit;
+ * @param PointCloudMapSwapFolder, the existing folder where the point cloud map writes its swap files;
+ * @param PointCloudMapLevelsOfDetail, the number of voxel resolutions kept by the point cloud map, each one twice as coarse as the previous one, 1 disables the levels of detail;
+ * @param PointCloudMapLevelOfDetailDistance, the output points are at full resolution up to this distance from the camera, then the resolution halves each time the distance doubles;
+ * @param PointCloudMapOutputBudget, the maximum number of points of the output point cloud, the levels of detail are made coarser to fit it, zero means the maximum size of a point cloud;
  * @param NumberOfAdjustedStereoPairs, it is the number N of stereo pairs that will be used for bundle adjustment, it can be one of {2, 3, 4};
  * @param Baseline, the baseline of the stereo camera pair.
  *
@@ -121,6 +126,11 @@ namespace Reconstruction3D
 			{
 			float searchRadius;
 			float pointCloudMapResolution;
+			int pointCloudMapMemoryBudget;
+			std::string pointCloudMapSwapFolder;
+			int pointCloudMapLevelsOfDetail;
+			float pointCloudMapLevelOfDetailDistance;
+			int pointCloudMapOutputBudget;
 			int numberOfAdjustedStereoPairs;
 			float baseline;
 			};
@@ -0,0 +1,241 @@
+/* --------------------------------------------------------------------------
+*
+* (C) Copyright …
+*
+* --------------------------------------------------------------------------
+*/
+
+/*!
+ * @file KeyframeSelector.cpp
+ * @date 19/10/2026
+ * @author Alessandro Bianco
+ */
+
+/*!
+ * @addtogroup DFPCs
+ *
+ * Implementation of the KeyframeSelector class.
+ *
+ * @{
+ */
+
+/* --------------------------------------------------------------------------
+ *
+ * Includes
+ *
+ * --------------------------------------------------------------------------
+ */
+#include "KeyframeSelector.hpp"
+#include <Errors/Assert.hpp>
+
+#include <cmath>
+#include <algorithm>
+
+namespace CDFF
+{
+namespace DFPC
+{
+namespace Reconstruction3D
+{
+
+using namespace PoseWrapper;
+using namespace VisualPointFeatureVector2DWrapper;
+using namespace CorrespondenceMap2DWrapper;
+using namespace BaseTypesWrapper;
+
+/* --------------------------------------------------------------------------
+ *
+ * Public Member Functions
+ *
+ * --------------------------------------------------------------------------
+ */
+KeyframeSelector::KeyframeSelector()
+	{
+	translationThreshold = 0;
+	rotationThreshold = 0;
+	overlapThreshold = 0;
+	trackSurvivalThreshold = 0;
+
+	keyframeSet = false;
+	numberOfKeyframeFeatures = 0;
+	SetPosition(keyframePose, 0, 0, 0);
+	SetOrientation(keyframePose, 0, 0, 0, 1);
+	}
+
+KeyframeSelector::~KeyframeSelector()
+	{
+
+	}
+
+void KeyframeSelector::SetThresholds(float translationThreshold, float rotationThreshold, float overlapThreshold, float trackSurvivalThreshold)
+	{
+	ASSERT(overlapThreshold <= 1, "KeyframeSelector Error, overlap threshold is greater than 1");
+	ASSERT(trackSurvivalThreshold <= 1, "KeyframeSelector Error, track survival threshold is greater than 1");
+	this->translationThreshold = translationThreshold;
+	this->rotationThreshold = rotationThreshold;
+	this->overlapThreshold = overlapThreshold;
+	this->trackSurvivalThreshold = trackSurvivalThreshold;
+	}
+
+bool KeyframeSelector::IsKeyframe(const Pose3D& poseInMap, float overlapRatio)
+	{
+	if (!keyframeSet)
+		{
+		return true;
+		}
+
+	bool noCriterionEnabled = true;
+	if (translationThreshold > 0)
+		{
+		noCriterionEnabled = false;
+		if (ComputeTranslationDistance(poseInMap, keyframePose) >= translationThreshold)
+			{
+			return true;
+			}
+		}
+	if (rotationThreshold > 0)
+		{
+		noCriterionEnabled = false;
+		if (ComputeRotationAngle(poseInMap, keyframePose) >= rotationThreshold)
+			{
+			return true;
+			}
+		}
+	if (overlapThreshold > 0)
+		{
+		noCriterionEnabled = false;
+		if (overlapRatio < overlapThreshold)
+			{
+			return true;
+			}
+		}
+	if (trackSurvivalThreshold > 0)
+		{
+		noCriterionEnabled = false;
+		if (GetTrackSurvivalRatio() < trackSurvivalThreshold)
+			{
+			return true;
+			}
+		}
+	return noCriterionEnabled;
+	}
+
+void KeyframeSelector::SetKeyframe(const Pose3D& poseInMap)
+	{
+	Copy(poseInMap, keyframePose);
+	keyframeSet = true;
+	trackedKeypointsSet.clear();
+	numberOfKeyframeFeatures = 0;
+	}
+
+void KeyframeSelector::SetKeyframe(const Pose3D& poseInMap, const VisualPointFeatureVector2D& keyframeFeatures)
+	{
+	SetKeyframe(poseInMap);
+	if (!UsesTrackSurvival())
+		{
+		return;
+		}
+
+	int numberOfFeatures = GetNumberOfPoints(keyframeFeatures);
+	for(int featureIndex = 0; featureIndex < numberOfFeatures; featureIndex++)
+		{
+		trackedKeypointsSet.insert( ComputeKeypointKey( GetXCoordinate(keyframeFeatures, featureIndex), GetYCoordinate(keyframeFeatures, featureIndex) ) );
+		}
+	numberOfKeyframeFeatures = trackedKeypointsSet.size();
+	}
+
+void KeyframeSelector::TrackFeatures(const CorrespondenceMap2D& currentToPreviousMap)
+	{
+	if (!UsesTrackSurvival() || trackedKeypointsSet.empty())
+		{
+		return;
+		}
+
+	newTrackedKeypointsSet.clear();
+	int numberOfCorrespondences = GetNumberOfCorrespondences(currentToPreviousMap);
+	for(int correspondenceIndex = 0; correspondenceIndex < numberOfCorrespondences; correspondenceIndex++)
+		{
+		Point2D sink = GetSink(currentToPreviousMap, correspondenceIndex);
+		if (trackedKeypointsSet.count( ComputeKeypointKey(sink.x, sink.y) ) > 0)
+			{
+			Point2D source = GetSource(currentToPreviousMap, correspondenceIndex);
+			newTrackedKeypointsSet.insert( ComputeKeypointKey(source.x, source.y) );
+			}
+		}
+	trackedKeypointsSet.swap(newTrackedKeypointsSet);
+	}
+
+float KeyframeSelector::GetTrackSurvivalRatio()
+	{
+	if (numberOfKeyframeFeatures == 0)
+		{
+		return 1;
+		}
+	return static_cast<float>(trackedKeypointsSet.size()) / static_cast<float>(numberOfKeyframeFeatures);
+	}
+
+bool KeyframeSelector::UsesOverlap()
+	{
+	return (overlapThreshold > 0);
+	}
+
+bool KeyframeSelector::UsesTrackSurvival()
+	{
+	return (trackSurvivalThreshold > 0);
+	}
+
+bool KeyframeSelector::HasKeyframe()
+	{
+	return keyframeSet;
+	}
+
+const Pose3D& KeyframeSelector::GetKeyframePose()
+	{
+	return keyframePose;
+	}
+
+void KeyframeSelector::Reset()
+	{
+	keyframeSet = false;
+	trackedKeypointsSet.clear();
+	numberOfKeyframeFeatures = 0;
+	}
+
+/* --------------------------------------------------------------------------
+ *
+ * Private Member Functions
+ *
+ * --------------------------------------------------------------------------
+ */
+float KeyframeSelector::ComputeRotationAngle(const Pose3D& pose1, const Pose3D& pose2)
+	{
+	double qx1 = GetXOrientation(pose1);
+	double qy1 = GetYOrientation(pose1);
+	double qz1 = GetZOrientation(pose1);
+	double qw1 = GetWOrientation(pose1);
+
+	double qx2 = GetXOrientation(pose2);
+	double qy2 = GetYOrientation(pose2);
+	double qz2 = GetZOrientation(pose2);
+	double qw2 = GetWOrientation(pose2);
+
+	double norm1 = std::sqrt(qx1*qx1 + qy1*qy1 + qz1*qz1 + qw1*qw1);
+	double norm2 = std::sqrt(qx2*qx2 + qy2*qy2 + qz2*qz2 + qw2*qw2);
+
+	//q and -q are the same rotation, the angle between the rotations is twice the angle between the closest pair of quaternions
+	double cosine = std::fabs(qx1*qx2 + qy1*qy2 + qz1*qz2 + qw1*qw2) / (norm1 * norm2);
+	return static_cast<float>( 2 * std::acos( std::min(cosine, 1.0) ) );
+	}
+
+uint32_t KeyframeSelector::ComputeKeypointKey(double x, double y)
+	{
+	uint32_t roundedX = static_cast<uint32_t>( std::lround( std::max(x, 0.0) ) ) & 0xFFFF;
+	uint32_t roundedY = static_cast<uint32_t>( std::lround( std::max(y, 0.0) ) ) & 0xFFFF;
+	return (roundedX << 16) | roundedY;
+	}
+
+}
+}
+}
+
+/** @} */
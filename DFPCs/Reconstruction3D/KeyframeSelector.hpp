@@ -0,0 +1,117 @@
+/* --------------------------------------------------------------------------
+*
+* (C) Copyright …
+*
+* --------------------------------------------------------------------------
+*/
+
+/*!
+ * @file KeyframeSelector.hpp
+ * @date 19/10/2026
+ * @author Alessandro Bianco
+ */
+
+/*!
+ * @addtogroup DFPCs
+ *
+ * This is the keyframe selector shared by the Reconstruction3D DFPCs. A frame becomes a keyframe, i.e. its point cloud is fused into the map, when the camera moved or rotated enough
+ * since the latest keyframe, when the overlap of the frame with the map is too small, or when too few of the features of the latest keyframe are still tracked.
+ * The other frames are only used for tracking the camera pose.
+ *
+ * @{
+ */
+
+#ifndef KEYFRAMESELECTOR_HPP
+#define KEYFRAMESELECTOR_HPP
+
+/* --------------------------------------------------------------------------
+ *
+ * Includes
+ *
+ * --------------------------------------------------------------------------
+ */
+#include <Types/CPP/Pose.hpp>
+#include <Types/CPP/VisualPointFeatureVector2D.hpp>
+#include <Types/CPP/CorrespondenceMap2D.hpp>
+
+#include <unordered_set>
+#include <cstdint>
+
+
+namespace CDFF
+{
+namespace DFPC
+{
+namespace Reconstruction3D
+{
+
+/* --------------------------------------------------------------------------
+ *
+ * Class definition
+ *
+ * This class decides whether a frame is a keyframe. It offers:
+ * (i) a set of criteria, each one enabled by a positive threshold; when no criterion is enabled every frame is a keyframe;
+ * (ii) the tracking of the features of the latest keyframe through the matches between consecutive frames, for the track survival criterion.
+ * --------------------------------------------------------------------------
+ */
+class KeyframeSelector
+	{
+	public:
+		KeyframeSelector();
+		~KeyframeSelector();
+
+		/* This method sets the thresholds of the criteria, a non positive threshold disables its criterion:
+		translationThreshold, the distance from the latest keyframe position at which a frame becomes a keyframe;
+		rotationThreshold, the angle in radians from the latest keyframe orientation at which a frame becomes a keyframe;
+		overlapThreshold, the ratio in [0, 1] of the frame points overlapping the map below which a frame becomes a keyframe;
+		trackSurvivalThreshold, the ratio in [0, 1] of the latest keyframe features still tracked below which a frame becomes a keyframe. */
+		void SetThresholds(float translationThreshold, float rotationThreshold, float overlapThreshold, float trackSurvivalThreshold);
+
+		/* This method decides whether the frame at the given pose in map is a keyframe, the first frame always is. The overlap ratio is only used when the overlap criterion is enabled,
+		and the track survival is the one of the latest call to TrackFeatures */
+		bool IsKeyframe(const PoseWrapper::Pose3D& poseInMap, float overlapRatio = 1);
+
+		/* These methods make the frame at the given pose in map the latest keyframe, its features are the tracks followed by TrackFeatures */
+		void SetKeyframe(const PoseWrapper::Pose3D& poseInMap);
+		void SetKeyframe(const PoseWrapper::Pose3D& poseInMap, const VisualPointFeatureVector2DWrapper::VisualPointFeatureVector2D& keyframeFeatures);
+
+		/* This method follows the tracks to the current frame, the sources of the map are keypoints of the current frame and the sinks are keypoints of the previous frame */
+		void TrackFeatures(const CorrespondenceMap2DWrapper::CorrespondenceMap2D& currentToPreviousMap);
+
+		/* This method returns the ratio of the latest keyframe features that are still tracked, 1 if the keyframe had no features */
+		float GetTrackSurvivalRatio();
+
+		bool UsesOverlap();
+		bool UsesTrackSurvival();
+		bool HasKeyframe();
+		const PoseWrapper::Pose3D& GetKeyframePose();
+
+		/* This method forgets the latest keyframe, so that the next frame is a keyframe */
+		void Reset();
+
+	protected:
+
+	private:
+		float translationThreshold;
+		float rotationThreshold;
+		float overlapThreshold;
+		float trackSurvivalThreshold;
+
+		bool keyframeSet;
+		PoseWrapper::Pose3D keyframePose;
+
+		//The keypoints of the current frame that continue a track of the latest keyframe, each keypoint is packed into a single integer by its rounded coordinates
+		std::unordered_set<uint32_t> trackedKeypointsSet;
+		std::unordered_set<uint32_t> newTrackedKeypointsSet;
+		int numberOfKeyframeFeatures;
+
+		float ComputeRotationAngle(const PoseWrapper::Pose3D& pose1, const PoseWrapper::Pose3D& pose2);
+		uint32_t ComputeKeypointKey(double x, double y);
+	};
+
+}
+}
+}
+#endif
+/* KeyframeSelector.hpp */
+/** @} */
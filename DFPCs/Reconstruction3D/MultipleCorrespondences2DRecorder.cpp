@@ -24,6 +24,8 @@ MultipleCorrespondences2DRecorder::MultipleCorrespondences2DRecorder(int maximum
 
 	workingCorrespondenceMapSequence = firstCorrespondenceMapSequence;
 	historyCorrespondenceMapSequence = secondCorrespondenceMapSequence;
+	workingSourceIndexList = &firstSourceIndexList;
+	historySourceIndexList = &secondSourceIndexList;
 
 	numberOfOldPoses = -1;
 	addingNewSequence = false;
@@ -65,13 +67,18 @@ void MultipleCorrespondences2DRecorder::InitializeNewSequence()
 		{
 		workingCorrespondenceMapSequence = firstCorrespondenceMapSequence;
 		historyCorrespondenceMapSequence = secondCorrespondenceMapSequence;
+		workingSourceIndexList = &firstSourceIndexList;
+		historySourceIndexList = &secondSourceIndexList;
 		}
 	else
 		{
 		workingCorrespondenceMapSequence = secondCorrespondenceMapSequence;
 		historyCorrespondenceMapSequence = firstCorrespondenceMapSequence;
+		workingSourceIndexList = &secondSourceIndexList;
+		historySourceIndexList = &firstSourceIndexList;
 		}
 	Clear(*workingCorrespondenceMapSequence);
+	workingSourceIndexList->clear();
 
 	if (numberOfOldPoses <= MAXIMUM_NUMBER_OF_POSES) // When numberOfOldPoses is equal to MAXIMUM_NUMBER_OF_POSES+1, it actually means any number beyond MAXIMUM_NUMBER_OF_POSES.
 		{
@@ -87,6 +94,10 @@ void MultipleCorrespondences2DRecorder::AddCorrespondences(CorrespondenceMap2DWr
 	int addedMaps = GetNumberOfCorrespondenceMaps(*workingCorrespondenceMapSequence);
 	ASSERT(addedMaps < expectedMapsToAdd, "AddCorrespondences, Unexpected number of maps in sequence");
 	AddCorrespondenceMap(*workingCorrespondenceMapSequence, *map);
+	if (useFilter)
+		{
+		workingSourceIndexList->push_back( ComputeSourceIndex(*map) );
+		}
 	}
 
 void MultipleCorrespondences2DRecorder::CompleteNewSequence()
@@ -101,6 +112,10 @@ void MultipleCorrespondences2DRecorder::CompleteNewSequence()
 			{
 			AddCorrespondenceMap(*workingCorrespondenceMapSequence, GetCorrespondenceMap(*historyCorrespondenceMapSequence, correspondenceIndex));
 			}
+		if (useFilter)
+			{
+			workingSourceIndexList->insert(workingSourceIndexList->end(), historySourceIndexList->begin(), historySourceIndexList->end());
+			}
 		}
 	else
 		{
@@ -110,6 +125,10 @@ void MultipleCorrespondences2DRecorder::CompleteNewSequence()
 			for(int sinkIndex = sourceIndex + 1; sinkIndex < 2*(MAXIMUM_NUMBER_OF_POSES-1); sinkIndex++)
 				{
 				AddCorrespondenceMap(*workingCorrespondenceMapSequence, GetCorrespondenceMap(*historyCorrespondenceMapSequence, correspondenceIndex));	
+				if (useFilter)
+					{
+					workingSourceIndexList->push_back( historySourceIndexList->at(correspondenceIndex) );
+					}
 				correspondenceIndex++;
 				}
 			correspondenceIndex += 2;
@@ -126,7 +145,7 @@ CorrespondenceMaps2DSequenceConstPtr MultipleCorrespondences2DRecorder::GetLates
 		{
 		if (useFilter)
 			{
-			return Filter(workingCorrespondenceMapSequence);
+			return Filter(workingCorrespondenceMapSequence, *workingSourceIndexList);
 			}
 		else
 			{
@@ -137,7 +156,7 @@ CorrespondenceMaps2DSequenceConstPtr MultipleCorrespondences2DRecorder::GetLates
 		{
 		if (useFilter)
 			{
-			return Filter(historyCorrespondenceMapSequence);
+			return Filter(historyCorrespondenceMapSequence, *historySourceIndexList);
 			}
 		else
 			{
@@ -165,7 +184,20 @@ void MultipleCorrespondences2DRecorder::DiscardLatestCorrespondences()
 	oneCorrespondenceWasAddedSinceLastDiscard = false;
 	}
 
-CorrespondenceMaps2DSequenceConstPtr MultipleCorrespondences2DRecorder::Filter(CorrespondenceMaps2DSequenceConstPtr sequenceToFilter)
+std::shared_ptr<const MultipleCorrespondences2DRecorder::SourceIndexMap> MultipleCorrespondences2DRecorder::ComputeSourceIndex(const CorrespondenceMap2D& map)
+	{
+	std::shared_ptr<SourceIndexMap> sourceIndex = std::make_shared<SourceIndexMap>();
+	int numberOfCorrespondences = GetNumberOfCorrespondences(map);
+	sourceIndex->reserve(numberOfCorrespondences);
+	for(int correspondenceIndex = 0; correspondenceIndex < numberOfCorrespondences; correspondenceIndex++)
+		{
+		// emplace does not replace an existing entry, so a source keypoint keeps its first correspondence
+		sourceIndex->emplace( GetSource(map, correspondenceIndex), correspondenceIndex );
+		}
+	return sourceIndex;
+	}
+
+CorrespondenceMaps2DSequenceConstPtr MultipleCorrespondences2DRecorder::Filter(CorrespondenceMaps2DSequenceConstPtr sequenceToFilter, const SourceIndexList& sourceIndexList)
 	{
 	ASSERT(!addingNewSequence, "MultipleCorrespondences2DRecorder::Filter, you can call the method only when you are not adding new sequences");
 	Copy(*sequenceToFilter, *filteredCorrespondenceMapSequence);
@@ -175,30 +207,34 @@ CorrespondenceMaps2DSequenceConstPtr MultipleCorrespondences2DRecorder::Filter(C
 		{
 		return filteredCorrespondenceMapSequence;
 		}
+	ASSERT(sourceIndexList.size() == numberOfMaps, "MultipleCorrespondences2DRecorder::Filter, the source index does not match the sequence");
 
 	std::vector < std::vector<BaseTypesWrapper::T_UInt32> > validChains;
 	const CorrespondenceMap2D& firstMap = GetCorrespondenceMap(*filteredCorrespondenceMapSequence, 0);
 	for(int correspondenceIndex = 0; correspondenceIndex < GetNumberOfCorrespondences(firstMap); correspondenceIndex++)
 		{
-		std::vector<BaseTypesWrapper::T_UInt32> newChain = ComputeChainFrom( correspondenceIndex );
+		std::vector<BaseTypesWrapper::T_UInt32> newChain = ComputeChainFrom( correspondenceIndex, sourceIndexList );
 		if (newChain.size() == numberOfMaps)
 			{
 			validChains.push_back( newChain );
 			} 
 		}
 
+	std::vector<bool> isInValidChain;
+	std::vector<BaseTypesWrapper::T_UInt32> removeIndexList;
 	for(int mapIndex = 0; mapIndex < numberOfMaps; mapIndex++)
 		{
 		const CorrespondenceMap2D& map = GetCorrespondenceMap(*filteredCorrespondenceMapSequence, mapIndex);
-		std::vector<BaseTypesWrapper::T_UInt32> removeIndexList;
+		isInValidChain.assign(GetNumberOfCorrespondences(map), false);
+		for(int chainIndex = 0; chainIndex < validChains.size(); chainIndex++)
+			{
+			isInValidChain.at( validChains.at(chainIndex).at(mapIndex) ) = true;
+			}
+
+		removeIndexList.clear();
 		for(int correspondenceIndex = 0; correspondenceIndex < GetNumberOfCorrespondences(map); correspondenceIndex++)
 			{
-			bool found = false;
-			for(int chainIndex = 0; chainIndex < validChains.size() && !found; chainIndex++)
-				{
-				found = (validChains.at(chainIndex).at(mapIndex) == correspondenceIndex );
-				}
-			if (!found)
+			if (!isInValidChain.at(correspondenceIndex))
 				{
 				removeIndexList.push_back(correspondenceIndex);
 				}
@@ -209,7 +245,7 @@ CorrespondenceMaps2DSequenceConstPtr MultipleCorrespondences2DRecorder::Filter(C
 	return filteredCorrespondenceMapSequence;
 	}
 
-std::vector<BaseTypesWrapper::T_UInt32> MultipleCorrespondences2DRecorder::ComputeChainFrom(int correspondenceIndex)
+std::vector<BaseTypesWrapper::T_UInt32> MultipleCorrespondences2DRecorder::ComputeChainFrom(int correspondenceIndex, const SourceIndexList& sourceIndexList)
 	{
 	std::vector<BaseTypesWrapper::T_UInt32> chain;
 	chain.push_back(correspondenceIndex);
@@ -224,14 +260,19 @@ std::vector<BaseTypesWrapper::T_UInt32> MultipleCorrespondences2DRecorder::Compu
 		for(int sinkIndex = startSink; sinkIndex < 2*MAXIMUM_NUMBER_OF_POSES; sinkIndex++)
 			{
 			mapIndex++;
+			//Until the window is full the sequence has fewer maps than a chain spans, so no chain can be completed
+			if (mapIndex >= sourceIndexList.size())
+				{
+				return std::vector<BaseTypesWrapper::T_UInt32>();
+				}
 			int index;
 			if ( sourceIndex > 0 && sinkIndex == sourceIndex + 1)
 				{
-				index = GetPointConnectedSinkToSource(lastAddedMapBySink, lastAddedIndexBySink, mapIndex);
+				index = GetPointConnectedSinkToSource(lastAddedMapBySink, lastAddedIndexBySink, *sourceIndexList.at(mapIndex));
 				}
 			else
 				{
-				index = GetPointConnectedSourceToSource(mapIndex-1, lastAddedIndex, mapIndex);
+				index = GetPointConnectedSourceToSource(mapIndex-1, lastAddedIndex, *sourceIndexList.at(mapIndex));
 				}
 			if (index == -1)
 				{
@@ -253,40 +294,20 @@ std::vector<BaseTypesWrapper::T_UInt32> MultipleCorrespondences2DRecorder::Compu
 	return chain;
 	}
 
-int MultipleCorrespondences2DRecorder::GetPointConnectedSourceToSource(int mapIndex1, int correspondenceIndex, int mapIndex2)
+int MultipleCorrespondences2DRecorder::GetPointConnectedSourceToSource(int mapIndex1, int correspondenceIndex, const SourceIndexMap& sourceIndex2)
 	{
 	const CorrespondenceMap2D& map1 = GetCorrespondenceMap(*filteredCorrespondenceMapSequence, mapIndex1);
-	const CorrespondenceMap2D& map2 = GetCorrespondenceMap(*filteredCorrespondenceMapSequence, mapIndex2);
 
-	BaseTypesWrapper::Point2D sourcePoint1 = GetSource(map1, correspondenceIndex);
-
-	for(int index = 0; index < GetNumberOfCorrespondences(map2); index++)
-		{
-		BaseTypesWrapper::Point2D sourcePoint2 = GetSource(map2, index);
-		if (sourcePoint2.x == sourcePoint1.x && sourcePoint2.y == sourcePoint1.y)
-			{
-			return index;
-			}
-		}
-	return -1;
+	SourceIndexMap::const_iterator connection = sourceIndex2.find( GetSource(map1, correspondenceIndex) );
+	return (connection == sourceIndex2.end() ? -1 : static_cast<int>(connection->second));
 	}
 
-int MultipleCorrespondences2DRecorder::GetPointConnectedSinkToSource(int mapIndex1, int correspondenceIndex, int mapIndex2)
+int MultipleCorrespondences2DRecorder::GetPointConnectedSinkToSource(int mapIndex1, int correspondenceIndex, const SourceIndexMap& sourceIndex2)
 	{
 	const CorrespondenceMap2D& map1 = GetCorrespondenceMap(*filteredCorrespondenceMapSequence, mapIndex1);
-	const CorrespondenceMap2D& map2 = GetCorrespondenceMap(*filteredCorrespondenceMapSequence, mapIndex2);
 
-	BaseTypesWrapper::Point2D sinkPoint1 = GetSink(map1, correspondenceIndex);
-
-	for(int index = 0; index < GetNumberOfCorrespondences(map2); index++)
-		{
-		BaseTypesWrapper::Point2D sourcePoint2 = GetSource(map2, index);
-		if (sourcePoint2.x == sinkPoint1.x && sourcePoint2.y == sinkPoint1.y)
-			{
-			return index;
-			}
-		}
-	return -1;
+	SourceIndexMap::const_iterator connection = sourceIndex2.find( GetSink(map1, correspondenceIndex) );
+	return (connection == sourceIndex2.end() ? -1 : static_cast<int>(connection->second));
 	}
 
 bool MultipleCorrespondences2DRecorder::LastSinkIsValid(const std::vector<BaseTypesWrapper::T_UInt32>& chain, int sourceIndex)
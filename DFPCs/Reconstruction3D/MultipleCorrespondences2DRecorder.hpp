@@ -36,6 +36,10 @@
 #include <Types/CPP/CorrespondenceMap2D.hpp>
 #include <Types/CPP/PointCloud.hpp>
 
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
 
 namespace CDFF
 {
@@ -51,6 +55,7 @@ namespace Reconstruction3D
  * This class has the purpose of storing a sequence of 2D correspondence maps between image features. It offers:
  * (i) a mechanism for adding correspondence maps one by one;
  * (ii) a method for storing the latest two sequences of correspondence maps in an efficient way, and discard the most recent one if no longer useful.
+ * When points that do not appear in all matches are filtered, each map is indexed by source keypoint as it is added, so that a track can be followed across all maps in constant time per map.
  * --------------------------------------------------------------------------
  */
 class MultipleCorrespondences2DRecorder
@@ -99,10 +104,37 @@ class MultipleCorrespondences2DRecorder
 
 		CorrespondenceMap2DWrapper::CorrespondenceMaps2DSequencePtr filteredCorrespondenceMapSequence;
 
-		CorrespondenceMap2DWrapper::CorrespondenceMaps2DSequenceConstPtr Filter(CorrespondenceMap2DWrapper::CorrespondenceMaps2DSequenceConstPtr sequenceToFilter);
-		std::vector<BaseTypesWrapper::T_UInt32> ComputeChainFrom(int correspondenceIndex);
-		int GetPointConnectedSourceToSource(int mapIndex1, int correspondenceIndex, int mapIndex2);
-		int GetPointConnectedSinkToSource(int mapIndex1, int correspondenceIndex, int mapIndex2);
+		struct KeypointHash
+			{
+			size_t operator()(const BaseTypesWrapper::Point2D& point) const
+				{
+				//Adding zero turns -0.0 into 0.0, which KeypointEqual considers equal, so that both get the same hash
+				return std::hash<double>()(point.x + 0.0) ^ (std::hash<double>()(point.y + 0.0) * 31u);
+				}
+			};
+
+		struct KeypointEqual
+			{
+			bool operator()(const BaseTypesWrapper::Point2D& point1, const BaseTypesWrapper::Point2D& point2) const
+				{
+				return point1.x == point2.x && point1.y == point2.y;
+				}
+			};
+
+		//For each source keypoint of a map, the index of the first correspondence of the map with that source. The index of a map does not change while the map moves from a sequence to the next one, so it is shared.
+		typedef std::unordered_map<BaseTypesWrapper::Point2D, BaseTypesWrapper::T_UInt32, KeypointHash, KeypointEqual> SourceIndexMap;
+		typedef std::vector< std::shared_ptr<const SourceIndexMap> > SourceIndexList;
+
+		SourceIndexList firstSourceIndexList;
+		SourceIndexList secondSourceIndexList;
+		SourceIndexList* workingSourceIndexList;
+		SourceIndexList* historySourceIndexList;
+
+		std::shared_ptr<const SourceIndexMap> ComputeSourceIndex(const CorrespondenceMap2DWrapper::CorrespondenceMap2D& map);
+		CorrespondenceMap2DWrapper::CorrespondenceMaps2DSequenceConstPtr Filter(CorrespondenceMap2DWrapper::CorrespondenceMaps2DSequenceConstPtr sequenceToFilter, const SourceIndexList& sourceIndexList);
+		std::vector<BaseTypesWrapper::T_UInt32> ComputeChainFrom(int correspondenceIndex, const SourceIndexList& sourceIndexList);
+		int GetPointConnectedSourceToSource(int mapIndex1, int correspondenceIndex, const SourceIndexMap& sourceIndex2);
+		int GetPointConnectedSinkToSource(int mapIndex1, int correspondenceIndex, const SourceIndexMap& sourceIndex2);
 		bool LastSinkIsValid(const std::vector<BaseTypesWrapper::T_UInt32>& chain, int sourceIndex);
 
 	};
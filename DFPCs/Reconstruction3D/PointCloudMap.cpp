@@ -29,7 +29,13 @@
 #include "PointCloudMap.hpp"
 #include <Errors/Assert.hpp>
 #include <Errors/AssertOnTest.hpp>
-#include <pcl/filters/voxel_grid.h>
+#include <cmath>
+#include <algorithm>
+#include <sstream>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
 
 namespace CDFF
 {
@@ -49,23 +55,32 @@ using namespace BaseTypesWrapper;
  *
  * --------------------------------------------------------------------------
  */
-PointCloudMap::PointCloudMap() :
-	pointCloud( new pcl::PointCloud<pcl::PointXYZ>() )
+PointCloudMap::PointCloudMap()
 	{
 	resolution = DEFAULT_RESOLUTION;
+	numberOfLevels = 1;
+	levelDistance = DEFAULT_LEVEL_DISTANCE;
 	SetPosition(poseOfLatestPointCloud, 0, 0, 0);
 	SetOrientation(poseOfLatestPointCloud, 0, 0, 0, 1);
 	descriptorLength = 0;
+	numberOfCreatedTiles = 0;
+	numberOfStoredVoxels = 0;
+	numberOfStoredFeatures = 0;
+
+	memoryBudget = 0;
+	residentMemoryUsage = 0;
+	swapFolderPath = ".";
+	mapIdentifier = mapsCounter++;
 	}
 
 PointCloudMap::~PointCloudMap()
 	{
-
+	RemoveSwapFiles();
 	}
 
 void PointCloudMap::AddPointCloud(PointCloudConstPtr pointCloudInput, VisualPointFeatureVector3DConstPtr pointCloudFeaturesVector, Pose3DConstPtr cloudPoseInMap)
 	{
-	if (featuresList.size() == 0 && GetNumberOfPoints(*pointCloudFeaturesVector) > 0)
+	if (numberOfStoredFeatures == 0 && GetNumberOfPoints(*pointCloudFeaturesVector) > 0)
 		{
 		descriptorLength = GetNumberOfDescriptorComponents(*pointCloudFeaturesVector, 0);
 		}
@@ -80,6 +95,7 @@ void PointCloudMap::AddPointCloud(PointCloudConstPtr pointCloudInput, VisualPoin
 	AddPointCloud(pointCloudInput, affineTransform);
 
 	Copy(*cloudPoseInMap, poseOfLatestPointCloud);
+	EnforceMemoryBudget();
 	}
 
 void PointCloudMap::AttachPointCloud(PointCloudConstPtr pointCloudInput, VisualPointFeatureVector3DConstPtr pointCloudFeaturesVector, Pose3DConstPtr cloudPoseDisplacement)
@@ -110,86 +126,159 @@ void PointCloudMap::AttachPointCloud(PointCloudConstPtr pointCloudInput, VisualP
 	AddPointCloud(pointCloudInput, pointCloudFeaturesVector, &cloudPoseInMap);
 	}
 
-PointCloudConstPtr PointCloudMap::GetScenePointCloud(Pose3DConstPtr origin,  float radius)
+void PointCloudMap::AttachPose(Pose3DConstPtr poseDisplacement)
 	{
-	pcl::PointXYZ pclOrigin( GetXPosition(*origin), GetYPosition(*origin), GetZPosition(*origin));
-	PointCloudPtr pointCloudOutput = NewPointCloud();
+	Pose3D poseInMap = Sum(poseOfLatestPointCloud, *poseDisplacement);
+	Copy(poseInMap, poseOfLatestPointCloud);
+	}
 
-	uint64_t pointIndex = 0;
-	for(pointIndex = 0; pointIndex < pointCloud->points.size() && pointIndex < PointCloudWrapper::MAX_CLOUD_SIZE; pointIndex++)
+float PointCloudMap::ComputeOverlapRatio(PointCloudConstPtr pointCloudInput, Pose3DConstPtr cloudPoseInMap)
+	{
+	AffineTransform affineTransform = ConvertCloudPoseToInversionTransform(cloudPoseInMap);
+	Tile* cachedTile = NULL;
+	VoxelKey cachedTileKey;
+	unsigned numberOfValidPoints = 0;
+	unsigned numberOfOverlappingPoints = 0;
+
+	unsigned numberOfPoints = GetNumberOfPoints(*pointCloudInput);
+	for(unsigned pointIndex = 0; pointIndex < numberOfPoints; pointIndex++)
 		{
-		pcl::PointXYZ cloudPoint = pointCloud->points.at(pointIndex);
-		float pointToOriginDistance = PointDistance(pclOrigin, cloudPoint);
-		if ( pointToOriginDistance <= radius )
+		pcl::PointXYZ point( GetXCoordinate(*pointCloudInput, pointIndex), GetYCoordinate(*pointCloudInput, pointIndex), GetZCoordinate(*pointCloudInput, pointIndex) );
+		if ( !std::isfinite(point.x) || !std::isfinite(point.y) || !std::isfinite(point.z) )
 			{
-			AddPoint(*pointCloudOutput, cloudPoint.x, cloudPoint.y, cloudPoint.z);
+			continue;
+			}
+		numberOfValidPoints++;
+		bool reloaded = false;
+		if ( IsNeighbourhoodOccupied( ComputeVoxelKey( TransformPoint(point, affineTransform) ), cachedTile, cachedTileKey, reloaded) )
+			{
+			numberOfOverlappingPoints++;
+			}
+		//The tiles read back from their swap files may exceed the memory budget, the cached tile is dropped as it may be evicted
+		if (reloaded)
+			{
+			cachedTile = NULL;
+			EnforceMemoryBudget();
 			}
 		}
 
-	if (pointIndex < pointCloud->points.size())
+	return (numberOfValidPoints == 0) ? 0 : static_cast<float>(numberOfOverlappingPoints) / static_cast<float>(numberOfValidPoints);
+	}
+
+PointCloudConstPtr PointCloudMap::GetScenePointCloud(Pose3DConstPtr origin,  float radius)
+	{
+	pcl::PointXYZ pclOrigin( GetXPosition(*origin), GetYPosition(*origin), GetZPosition(*origin));
+	std::vector<pcl::PointXYZ> selectedPointsList;
+	SelectVoxels(pclOrigin, radius, selectedPointsList);
+
+	std::vector<T_Double> coordinatesList(3 * selectedPointsList.size());
+	for(unsigned selectionIndex = 0; selectionIndex < selectedPointsList.size(); selectionIndex++)
 		{
-		PRINT_TO_LOG("Stored point cloud is too large, only a part will be used for matching", "");
+		const pcl::PointXYZ& cloudPoint = selectedPointsList[selectionIndex];
+		coordinatesList[3*selectionIndex] = cloudPoint.x;
+		coordinatesList[3*selectionIndex + 1] = cloudPoint.y;
+		coordinatesList[3*selectionIndex + 2] = cloudPoint.z;
 		}
 
+	PointCloudPtr pointCloudOutput = NewPointCloud();
+	AddPoints(*pointCloudOutput, coordinatesList.data(), selectedPointsList.size());
 	return pointCloudOutput;
 	}
 
 PointCloudConstPtr PointCloudMap::GetScenePointCloudInOrigin(Pose3DConstPtr origin,  float radius)
 	{
 	pcl::PointXYZ pclOrigin( GetXPosition(*origin), GetYPosition(*origin), GetZPosition(*origin));
-	PointCloudPtr pointCloudOutput = NewPointCloud();
+	std::vector<pcl::PointXYZ> selectedPointsList;
+	SelectVoxels(pclOrigin, radius, selectedPointsList);
 
 	AffineTransform affineTransform = ConvertCloudPoseToInversionTransform(origin);
-	uint64_t pointIndex = 0;
-	for(pointIndex = 0; pointIndex < pointCloud->points.size() && pointIndex < PointCloudWrapper::MAX_CLOUD_SIZE; pointIndex++)
+	return ConvertToPointCloud(selectedPointsList, affineTransform);
+	}
+
+PointCloudConstPtr PointCloudMap::GetScenePointCloudEnteringRadius(Pose3DConstPtr previousOrigin, Pose3DConstPtr origin, float radius)
+	{
+	ASSERT(radius >= 0, "PointCloudMap Error, radius of the entering points cannot be negative");
+	pcl::PointXYZ previousCenter( GetXPosition(*previousOrigin), GetYPosition(*previousOrigin), GetZPosition(*previousOrigin));
+	pcl::PointXYZ center( GetXPosition(*origin), GetYPosition(*origin), GetZPosition(*origin));
+	std::vector<TileSelection> selectedTilesList;
+	SelectTiles(center, radius, selectedTilesList);
+
+	const float squaredRadius = radius * radius;
+	std::vector<pcl::PointXYZ> selectedPointsList;
+	for(unsigned tileIndex = 0; tileIndex < selectedTilesList.size(); tileIndex++)
 		{
-		pcl::PointXYZ cloudPoint = pointCloud->points.at(pointIndex);
-		float pointToOriginDistance = PointDistance(pclOrigin, cloudPoint);
-		if ( pointToOriginDistance <= radius )
+		//Tiles entirely within the previous sphere have no entering point and are not read
+		const TileSelection& selection = selectedTilesList.at(tileIndex);
+		TileSelection previousSelection = selection;
+		ClassifyTile(*(selection.key), previousCenter, radius, previousSelection);
+		if (previousSelection.fullyInside)
 			{
-			pcl::PointXYZ transformedCloudPoint = TransformPoint(cloudPoint, affineTransform);
-			AddPoint(*pointCloudOutput, transformedCloudPoint.x, transformedCloudPoint.y, transformedCloudPoint.z);
+			continue;
+			}
+
+		TileView view;
+		OpenTileView(*(selection.key), *(selection.tile), view);
+		for(unsigned voxelIndex = 0; voxelIndex < selection.tile->levelsList[0].numberOfVoxels; voxelIndex++)
+			{
+			const Voxel& voxel = view.voxelsLists[0][voxelIndex];
+			pcl::PointXYZ point(voxel.x, voxel.y, voxel.z);
+			if ( (selection.fullyInside || SquaredPointDistance(center, point) <= squaredRadius) && SquaredPointDistance(previousCenter, point) > squaredRadius )
+				{
+				selectedPointsList.push_back(point);
+				}
 			}
+		CloseTileView(view);
 		}
 
-	if (pointIndex < pointCloud->points.size())
+	//An overflowing selection keeps evenly spaced points, so that every entering tile keeps the same share of its points
+	const size_t maximumNumberOfPoints = MAX_CLOUD_SIZE;
+	const size_t numberOfEnteringPoints = selectedPointsList.size();
+	if (numberOfEnteringPoints > maximumNumberOfPoints)
 		{
-		PRINT_TO_LOG("Stored point cloud is too large, only a part will be used for matching", "");
+		PRINT_TO_LOG("Entering point cloud is too large, it is subsampled uniformly", "");
+		for(size_t sampleIndex = 0; sampleIndex < maximumNumberOfPoints; sampleIndex++)
+			{
+			selectedPointsList[sampleIndex] = selectedPointsList[ (sampleIndex * numberOfEnteringPoints) / maximumNumberOfPoints ];
+			}
+		selectedPointsList.resize(maximumNumberOfPoints);
 		}
 
-	return pointCloudOutput;
+	return ConvertToPointCloud(selectedPointsList, AffineTransform::Identity());
+	}
+
+PointCloudConstPtr PointCloudMap::GetScenePointCloudInOrigin(Pose3DConstPtr origin,  float radius, unsigned maximumNumberOfPoints)
+	{
+	pcl::PointXYZ pclOrigin( GetXPosition(*origin), GetYPosition(*origin), GetZPosition(*origin));
+	std::vector<pcl::PointXYZ> selectedPointsList;
+	SelectLevelOfDetailVoxels(pclOrigin, radius, maximumNumberOfPoints, selectedPointsList);
+
+	AffineTransform affineTransform = ConvertCloudPoseToInversionTransform(origin);
+	return ConvertToPointCloud(selectedPointsList, affineTransform);
 	}
 
 VisualPointFeatureVector3DConstPtr PointCloudMap::GetSceneFeaturesVector(Pose3DConstPtr origin,  float radius)
 	{
-	DEBUG_PRINT_TO_LOG("Number of points in stored cloud:", pointCloud->points.size());
-	DEBUG_PRINT_TO_LOG("Number of features in stored cloud:", featuresList.size());
+	DEBUG_PRINT_TO_LOG("Number of points in stored cloud:", numberOfStoredVoxels);
+	DEBUG_PRINT_TO_LOG("Number of features in stored cloud:", numberOfStoredFeatures);
 
 	pcl::PointXYZ pclOrigin( GetXPosition(*origin), GetYPosition(*origin), GetZPosition(*origin));
-	VisualPointFeatureVector3DPtr featuresVector = NewVisualPointFeatureVector3D();
+	std::vector<pcl::PointXYZ> selectedFeaturesList;
+	std::vector<float> selectedDescriptorsList;
+	SelectFeatures(pclOrigin, radius, selectedFeaturesList, selectedDescriptorsList);
 
-	uint64_t featureCounter = 0;
-	uint64_t featureIndex = 0;
-	for(featureIndex = 0; featureIndex < featuresList.size() && featureCounter<VisualPointFeatureVector3DWrapper::MAX_FEATURE_3D_POINTS; featureIndex++)
+	VisualPointFeatureVector3DPtr featuresVector = NewVisualPointFeatureVector3D();
+	for(unsigned featureIndex = 0; featureIndex < selectedFeaturesList.size(); featureIndex++)
 		{
-		FeaturePoint featurePoint = featuresList.at(featureIndex); 
-		float featureToOriginDistance = PointDistance(pclOrigin, featurePoint.point);
-		if ( featureToOriginDistance <= radius )
+		const pcl::PointXYZ& featurePoint = selectedFeaturesList[featureIndex];
+		AddPoint(*featuresVector, featurePoint.x, featurePoint.y, featurePoint.z);
+
+		const float* descriptor = selectedDescriptorsList.data() + featureIndex * descriptorLength;
+		for(unsigned componentIndex = 0; componentIndex < descriptorLength; componentIndex++)
 			{
-			AddPoint(*featuresVector, featurePoint.point.x, featurePoint.point.y, featurePoint.point.z);
-			for(unsigned componentIndex = 0; componentIndex < descriptorLength; componentIndex++)
-				{
-				AddDescriptorComponent(*featuresVector, featureCounter, featurePoint.descriptor[componentIndex]);
-				}
-			featureCounter++;
+			AddDescriptorComponent(*featuresVector, featureIndex, descriptor[componentIndex]);
 			}
 		}
 
-	if (featureIndex < featuresList.size())
-		{
-		PRINT_TO_LOG("Stored feature vector is too large, only a part will be used for matching", "");
-		}
-
 	return featuresVector;
 	}
 
@@ -200,7 +289,47 @@ const PoseWrapper::Pose3D& PointCloudMap::GetLatestPose()
 
 void PointCloudMap::SetResolution(float resolution)
 	{
-	this->resolution = resolution;
+	ASSERT(resolution > 0, "PointCloudMap Error, resolution has to be positive");
+	if (resolution != this->resolution)
+		{
+		Rebuild(resolution, numberOfLevels);
+		}
+	}
+
+void PointCloudMap::SetLevelsOfDetail(unsigned numberOfLevels, float levelDistance)
+	{
+	ASSERT(numberOfLevels >= 1 && numberOfLevels <= MAXIMUM_NUMBER_OF_LEVELS, "PointCloudMap Error, number of levels of detail out of range");
+	ASSERT(levelDistance > 0, "PointCloudMap Error, level of detail distance has to be positive");
+	this->levelDistance = levelDistance;
+	if (numberOfLevels != this->numberOfLevels)
+		{
+		Rebuild(resolution, numberOfLevels);
+		}
+	}
+
+void PointCloudMap::SetMemoryBudget(size_t memoryBudget, std::string swapFolderPath)
+	{
+	if (swapFolderPath != this->swapFolderPath)
+		{
+		//The swap files are looked up in the current folder, so they are read back before the folder changes
+		for(TilesMap::iterator tile = tilesMap.begin(); tile != tilesMap.end(); ++tile)
+			{
+			if (!tile->second.resident)
+				{
+				LoadTile(tile->first, tile->second);
+				}
+			}
+		RemoveSwapFiles();
+		this->swapFolderPath = swapFolderPath;
+		}
+
+	this->memoryBudget = memoryBudget;
+	EnforceMemoryBudget();
+	}
+
+size_t PointCloudMap::GetResidentMemoryUsage()
+	{
+	return residentMemoryUsage;
 	}
 
 /* --------------------------------------------------------------------------
@@ -210,6 +339,13 @@ void PointCloudMap::SetResolution(float resolution)
  * --------------------------------------------------------------------------
  */
 const float PointCloudMap::DEFAULT_RESOLUTION = 0.01;
+const float PointCloudMap::DEFAULT_LEVEL_DISTANCE = 5;
+
+//The estimates include the entries of the hash maps, which are allocated one node at a time
+const size_t PointCloudMap::VOXEL_MEMORY_USAGE = sizeof(Voxel) + sizeof(VoxelKey) + sizeof(uint32_t) + 3 * sizeof(void*);
+const size_t PointCloudMap::FEATURE_MEMORY_USAGE = sizeof(pcl::PointXYZ) + sizeof(uint32_t) + 2 * sizeof(void*);
+
+std::atomic<unsigned> PointCloudMap::mapsCounter(0);
 
 /* --------------------------------------------------------------------------
  *
@@ -219,40 +355,695 @@ const float PointCloudMap::DEFAULT_RESOLUTION = 0.01;
  */
 void PointCloudMap::AddPointCloud(PointCloudConstPtr pointCloudInput, const AffineTransform& affineTransform)
 	{
-	unsigned previousPointCloudSize = pointCloud->points.size();
+	Tile* cachedTile = NULL;
+	VoxelKey cachedTileKey;
 	unsigned numberOfNewPoints = GetNumberOfPoints(*pointCloudInput);
-	pointCloud->points.resize( previousPointCloudSize + numberOfNewPoints );
-
 	for(unsigned pointIndex = 0; pointIndex < numberOfNewPoints; pointIndex++)
 		{
 		pcl::PointXYZ newPoint( GetXCoordinate(*pointCloudInput, pointIndex), GetYCoordinate(*pointCloudInput, pointIndex), GetZCoordinate(*pointCloudInput, pointIndex) );
+		if ( !std::isfinite(newPoint.x) || !std::isfinite(newPoint.y) || !std::isfinite(newPoint.z) )
+			{
+			continue;
+			}
 		pcl::PointXYZ transformedNewPoint = TransformPoint(newPoint, affineTransform);
-		pointCloud->points.at(pointIndex + previousPointCloudSize) = transformedNewPoint;		
+		AddPointToVoxel(transformedNewPoint, 1, cachedTile, cachedTileKey);
+		}
+	}
+
+void PointCloudMap::AddPointToVoxel(const pcl::PointXYZ& point, uint32_t numberOfPoints, Tile*& cachedTile, VoxelKey& cachedTileKey)
+	{
+	//Consecutive points of a cloud are usually in the same tile, the tile of the previous point is kept to save a look up in the tiles map
+	VoxelKey key = ComputeVoxelKey(point);
+	VoxelKey tileKey = ComputeTileKey(key);
+	if (cachedTile == NULL || !(tileKey == cachedTileKey))
+		{
+		cachedTile = &GetResidentTile(tileKey);
+		cachedTileKey = tileKey;
 		}
+	Tile& tile = *cachedTile;
+	tile.modified = true;
 
-	pcl::VoxelGrid<pcl::PointXYZ> grid;
-	grid.setInputCloud(pointCloud);
-	grid.setLeafSize(resolution, resolution, resolution);
-	grid.filter(*pointCloud);
+	if (AddPointToLevel(tile.levelsList[0], key, point, numberOfPoints))
+		{
+		numberOfStoredVoxels++;
+		residentMemoryUsage += VOXEL_MEMORY_USAGE;
+		}
+	for(unsigned level = 1; level < numberOfLevels; level++)
+		{
+		if (AddPointToLevel(tile.levelsList[level], ComputeLevelKey(key, level), point, numberOfPoints))
+			{
+			residentMemoryUsage += VOXEL_MEMORY_USAGE;
+			}
+		}
+	}
+
+bool PointCloudMap::AddPointToLevel(VoxelLevel& level, const VoxelKey& key, const pcl::PointXYZ& point, uint32_t numberOfPoints)
+	{
+	std::pair<std::unordered_map<VoxelKey, uint32_t, VoxelKeyHash>::iterator, bool> insertion = level.voxelsIndexMap.insert( std::make_pair(key, level.numberOfVoxels) );
+	if (insertion.second)
+		{
+		Voxel newVoxel = { point.x, point.y, point.z, numberOfPoints };
+		level.voxelsList.push_back(newVoxel);
+		level.numberOfVoxels++;
+		return true;
+		}
+
+	Voxel& voxel = level.voxelsList.at(insertion.first->second);
+	voxel.numberOfPoints += numberOfPoints;
+	float weight = static_cast<float>(numberOfPoints) / static_cast<float>(voxel.numberOfPoints);
+	voxel.x += (point.x - voxel.x) * weight;
+	voxel.y += (point.y - voxel.y) * weight;
+	voxel.z += (point.z - voxel.z) * weight;
+	return false;
+	}
+
+bool PointCloudMap::IsNeighbourhoodOccupied(const VoxelKey& key, Tile*& cachedTile, VoxelKey& cachedTileKey, bool& reloaded)
+	{
+	for(int32_t dx = -1; dx <= 1; dx++)
+		{
+		for(int32_t dy = -1; dy <= 1; dy++)
+			{
+			for(int32_t dz = -1; dz <= 1; dz++)
+				{
+				VoxelKey neighbourKey = { key.x + dx, key.y + dy, key.z + dz };
+				VoxelKey tileKey = ComputeTileKey(neighbourKey);
+				//As in AddPointToVoxel, the tile of the previous look up is kept to save a look up in the tiles map
+				if (cachedTile == NULL || !(tileKey == cachedTileKey))
+					{
+					cachedTile = FindResidentTile(tileKey, reloaded);
+					cachedTileKey = tileKey;
+					}
+				if (cachedTile != NULL && cachedTile->levelsList[0].voxelsIndexMap.count(neighbourKey) > 0)
+					{
+					return true;
+					}
+				}
+			}
+		}
+	return false;
 	}
 
 void PointCloudMap::AddFeatureCloud(VisualPointFeatureVector3DConstPtr pointCloudFeaturesVector, const AffineTransform& affineTransform)
 	{
+	std::vector<float> descriptor(descriptorLength);
 	for(unsigned featureIndex = 0; featureIndex < GetNumberOfPoints(*pointCloudFeaturesVector); featureIndex++)
 		{
 		pcl::PointXYZ point(GetXCoordinate(*pointCloudFeaturesVector, featureIndex),GetYCoordinate(*pointCloudFeaturesVector, featureIndex),GetZCoordinate(*pointCloudFeaturesVector, featureIndex));
 		pcl::PointXYZ transformedPoint = TransformPoint(point, affineTransform);
 		if (NoCloseFeature(transformedPoint))
 			{
-			FeaturePoint featurePoint;
-			featurePoint.point = transformedPoint;
 			for(unsigned componentIndex = 0; componentIndex < descriptorLength; componentIndex++)
 				{
-				featurePoint.descriptor[componentIndex] = GetDescriptorComponent(*pointCloudFeaturesVector, featureIndex, componentIndex);
+				descriptor[componentIndex] = GetDescriptorComponent(*pointCloudFeaturesVector, featureIndex, componentIndex);
+				}
+			AddFeatureToTile(transformedPoint, descriptor.data());
+			}
+		}
+	}
+
+void PointCloudMap::AddFeatureToTile(const pcl::PointXYZ& point, const float* descriptor)
+	{
+	VoxelKey voxelKey = ComputeVoxelKey(point);
+	Tile& tile = GetResidentTile( ComputeTileKey(voxelKey) );
+	tile.modified = true;
+
+	tile.featuresVoxelsMap[voxelKey].push_back(tile.numberOfFeatures);
+	tile.featuresList.push_back(point);
+	tile.featureDescriptorsList.insert(tile.featureDescriptorsList.end(), descriptor, descriptor + descriptorLength);
+	tile.numberOfFeatures++;
+	numberOfStoredFeatures++;
+	residentMemoryUsage += FEATURE_MEMORY_USAGE + descriptorLength * sizeof(float);
+	}
+
+PointCloudMap::VoxelKey PointCloudMap::ComputeVoxelKey(const pcl::PointXYZ& point)
+	{
+	VoxelKey key;
+	key.x = static_cast<int32_t>( std::floor(point.x / resolution) );
+	key.y = static_cast<int32_t>( std::floor(point.y / resolution) );
+	key.z = static_cast<int32_t>( std::floor(point.z / resolution) );
+	return key;
+	}
+
+PointCloudMap::VoxelKey PointCloudMap::ComputeTileKey(const VoxelKey& voxelKey)
+	{
+	VoxelKey key;
+	key.x = FloorDivide(voxelKey.x, TILE_SIZE);
+	key.y = FloorDivide(voxelKey.y, TILE_SIZE);
+	key.z = FloorDivide(voxelKey.z, TILE_SIZE);
+	return key;
+	}
+
+PointCloudMap::VoxelKey PointCloudMap::ComputeLevelKey(const VoxelKey& voxelKey, unsigned level)
+	{
+	VoxelKey key;
+	key.x = FloorDivide(voxelKey.x, 1 << level);
+	key.y = FloorDivide(voxelKey.y, 1 << level);
+	key.z = FloorDivide(voxelKey.z, 1 << level);
+	return key;
+	}
+
+int32_t PointCloudMap::FloorDivide(int32_t dividend, int32_t divisor)
+	{
+	//Integer division truncates towards zero, the voxels with negative keys need to be rounded down instead
+	return (dividend >= 0) ? (dividend / divisor) : ( -( (-(dividend + 1)) / divisor ) - 1 );
+	}
+
+PointCloudMap::Tile& PointCloudMap::GetResidentTile(const VoxelKey& tileKey)
+	{
+	std::pair<TilesMap::iterator, bool> insertion = tilesMap.insert( std::make_pair(tileKey, Tile()) );
+	Tile& tile = insertion.first->second;
+	if (insertion.second)
+		{
+		tile.levelsList.resize(numberOfLevels);
+		for(unsigned level = 0; level < numberOfLevels; level++)
+			{
+			tile.levelsList[level].numberOfVoxels = 0;
+			}
+		tile.creationIndex = numberOfCreatedTiles;
+		tile.numberOfFeatures = 0;
+		tile.resident = true;
+		tile.modified = true;
+		tile.swapped = false;
+		numberOfCreatedTiles++;
+		}
+	else if (!tile.resident)
+		{
+		LoadTile(tileKey, tile);
+		}
+	return tile;
+	}
+
+PointCloudMap::Tile* PointCloudMap::FindResidentTile(const VoxelKey& tileKey, bool& reloaded)
+	{
+	TilesMap::iterator tile = tilesMap.find(tileKey);
+	if (tile == tilesMap.end())
+		{
+		return NULL;
+		}
+	if (!tile->second.resident)
+		{
+		LoadTile(tile->first, tile->second);
+		reloaded = true;
+		}
+	return &(tile->second);
+	}
+
+void PointCloudMap::SelectTiles(const pcl::PointXYZ& center, float radius, std::vector<TileSelection>& selectedTilesList)
+	{
+	selectedTilesList.clear();
+
+	//Only the tile keys in the bounding box of the sphere are looked up, the box is enlarged by one voxel as the tile boxes in ClassifyTile. When the box holds more keys than
+	//the map holds tiles, or the whole map is requested, walking the map is cheaper
+	const double tileLength = TILE_SIZE * resolution;
+	const double margin = radius + resolution;
+	const double centerCoordinates[3] = { center.x, center.y, center.z };
+	double minimumKey[3];
+	double maximumKey[3];
+	double numberOfKeys = 1;
+	for(unsigned axis = 0; axis < 3; axis++)
+		{
+		minimumKey[axis] = std::floor( (centerCoordinates[axis] - margin) / tileLength );
+		maximumKey[axis] = std::floor( (centerCoordinates[axis] + margin) / tileLength );
+		numberOfKeys *= maximumKey[axis] - minimumKey[axis] + 1;
+		}
+
+	if (radius < 0 || numberOfKeys > static_cast<double>( tilesMap.size() ))
+		{
+		for(TilesMap::const_iterator tile = tilesMap.begin(); tile != tilesMap.end(); ++tile)
+			{
+			TileSelection selection = { &(tile->first), &(tile->second), 0, false };
+			if (ClassifyTile(tile->first, center, radius, selection))
+				{
+				selectedTilesList.push_back(selection);
+				}
+			}
+		}
+	else
+		{
+		VoxelKey tileKey;
+		for(tileKey.x = static_cast<int32_t>(minimumKey[0]); tileKey.x <= static_cast<int32_t>(maximumKey[0]); tileKey.x++)
+			{
+			for(tileKey.y = static_cast<int32_t>(minimumKey[1]); tileKey.y <= static_cast<int32_t>(maximumKey[1]); tileKey.y++)
+				{
+				for(tileKey.z = static_cast<int32_t>(minimumKey[2]); tileKey.z <= static_cast<int32_t>(maximumKey[2]); tileKey.z++)
+					{
+					TilesMap::const_iterator tile = tilesMap.find(tileKey);
+					if (tile == tilesMap.end())
+						{
+						continue;
+						}
+					TileSelection selection = { &(tile->first), &(tile->second), 0, false };
+					if (ClassifyTile(tile->first, center, radius, selection))
+						{
+						selectedTilesList.push_back(selection);
+						}
+					}
+				}
+			}
+		}
+
+	//Tiles are visited in order of creation, so that the output does not depend on the hash map layout
+	std::sort(selectedTilesList.begin(), selectedTilesList.end(), [](const TileSelection& first, const TileSelection& second)
+		{
+		return first.tile->creationIndex < second.tile->creationIndex;
+		});
+	}
+
+bool PointCloudMap::ClassifyTile(const VoxelKey& tileKey, const pcl::PointXYZ& center, float radius, TileSelection& selection)
+	{
+	//The box of the tile is enlarged by one voxel, so that a centroid rounded across the border of its tile is never missed
+	const float tileLength = TILE_SIZE * resolution;
+	const float minimumCorner[3] = { tileKey.x * tileLength - resolution, tileKey.y * tileLength - resolution, tileKey.z * tileLength - resolution };
+	const float boxLength = tileLength + 2 * resolution;
+	const float centerCoordinates[3] = { center.x, center.y, center.z };
+
+	float nearestSquaredDistance = 0;
+	float farthestSquaredDistance = 0;
+	for(unsigned axis = 0; axis < 3; axis++)
+		{
+		float lowDifference = centerCoordinates[axis] - minimumCorner[axis];
+		float highDifference = minimumCorner[axis] + boxLength - centerCoordinates[axis];
+		if (lowDifference < 0)
+			{
+			nearestSquaredDistance += lowDifference * lowDifference;
+			}
+		else if (highDifference < 0)
+			{
+			nearestSquaredDistance += highDifference * highDifference;
+			}
+		float farthestDifference = std::max(std::abs(lowDifference), std::abs(highDifference));
+		farthestSquaredDistance += farthestDifference * farthestDifference;
+		}
+
+	float squaredRadius = radius * radius;
+	selection.nearestSquaredDistance = nearestSquaredDistance;
+	selection.fullyInside = (radius < 0 || farthestSquaredDistance <= squaredRadius);
+	return (radius < 0 || nearestSquaredDistance <= squaredRadius);
+	}
+
+void PointCloudMap::SelectVoxels(const pcl::PointXYZ& center, float radius, std::vector<pcl::PointXYZ>& selectedPointsList)
+	{
+	std::vector<TileSelection> selectedTilesList;
+	SelectTiles(center, radius, selectedTilesList);
+
+	const float squaredRadius = radius * radius;
+	const unsigned maximumNumberOfPoints = PointCloudWrapper::MAX_CLOUD_SIZE;
+	bool truncated = false;
+	selectedPointsList.clear();
+	for(unsigned tileIndex = 0; tileIndex < selectedTilesList.size() && !truncated; tileIndex++)
+		{
+		const TileSelection& selection = selectedTilesList.at(tileIndex);
+		TileView view;
+		OpenTileView(*(selection.key), *(selection.tile), view);
+		for(unsigned voxelIndex = 0; voxelIndex < selection.tile->levelsList[0].numberOfVoxels; voxelIndex++)
+			{
+			const Voxel& voxel = view.voxelsLists[0][voxelIndex];
+			pcl::PointXYZ point(voxel.x, voxel.y, voxel.z);
+			if (selection.fullyInside || SquaredPointDistance(center, point) <= squaredRadius)
+				{
+				if (selectedPointsList.size() == maximumNumberOfPoints)
+					{
+					truncated = true;
+					break;
+					}
+				selectedPointsList.push_back(point);
+				}
+			}
+		CloseTileView(view);
+		}
+
+	if (truncated)
+		{
+		PRINT_TO_LOG("Stored point cloud is too large, only a part will be used for matching", "");
+		}
+	}
+
+void PointCloudMap::SelectLevelOfDetailVoxels(const pcl::PointXYZ& center, float radius, unsigned maximumNumberOfPoints, std::vector<pcl::PointXYZ>& selectedPointsList)
+	{
+	if (maximumNumberOfPoints == 0 || maximumNumberOfPoints > static_cast<unsigned>(PointCloudWrapper::MAX_CLOUD_SIZE))
+		{
+		maximumNumberOfPoints = PointCloudWrapper::MAX_CLOUD_SIZE;
+		}
+
+	//Nearest tiles first, so that the points left out by the budget are the farthest ones
+	std::vector<TileSelection> selectedTilesList;
+	SelectTiles(center, radius, selectedTilesList);
+	std::stable_sort(selectedTilesList.begin(), selectedTilesList.end(), [](const TileSelection& first, const TileSelection& second)
+		{
+		return first.nearestSquaredDistance < second.nearestSquaredDistance;
+		});
+
+	//The level of each tile is chosen from the number of voxels stored in the tiles, so the budget is met without reading any tile; the voxels of a partially selected tile are all counted
+	std::vector<unsigned> tilesLevelsList(selectedTilesList.size());
+	float fullResolutionDistance = levelDistance;
+	while (true)
+		{
+		size_t numberOfPoints = 0;
+		for(unsigned tileIndex = 0; tileIndex < selectedTilesList.size(); tileIndex++)
+			{
+			const TileSelection& selection = selectedTilesList.at(tileIndex);
+			tilesLevelsList.at(tileIndex) = ComputeLevelOfDetail(selection.nearestSquaredDistance, fullResolutionDistance);
+			numberOfPoints += selection.tile->levelsList[ tilesLevelsList.at(tileIndex) ].numberOfVoxels;
+			}
+		if (numberOfPoints <= maximumNumberOfPoints || fullResolutionDistance < resolution)
+			{
+			break;
+			}
+		fullResolutionDistance /= 2;
+		}
+
+	const float squaredRadius = radius * radius;
+	bool truncated = false;
+	selectedPointsList.clear();
+	for(unsigned tileIndex = 0; tileIndex < selectedTilesList.size() && !truncated; tileIndex++)
+		{
+		const TileSelection& selection = selectedTilesList.at(tileIndex);
+		const unsigned level = tilesLevelsList.at(tileIndex);
+		TileView view;
+		OpenTileView(*(selection.key), *(selection.tile), view);
+		for(unsigned voxelIndex = 0; voxelIndex < selection.tile->levelsList[level].numberOfVoxels; voxelIndex++)
+			{
+			const Voxel& voxel = view.voxelsLists[level][voxelIndex];
+			pcl::PointXYZ point(voxel.x, voxel.y, voxel.z);
+			if (selection.fullyInside || SquaredPointDistance(center, point) <= squaredRadius)
+				{
+				if (selectedPointsList.size() == maximumNumberOfPoints)
+					{
+					truncated = true;
+					break;
+					}
+				selectedPointsList.push_back(point);
+				}
+			}
+		CloseTileView(view);
+		}
+
+	if (truncated)
+		{
+		PRINT_TO_LOG("Level of detail point cloud exceeds the points budget at the coarsest level, the farthest points are left out", "");
+		}
+	}
+
+unsigned PointCloudMap::ComputeLevelOfDetail(float nearestSquaredDistance, float fullResolutionDistance)
+	{
+	//Level k covers the distances in [fullResolutionDistance * 2^(k-1), fullResolutionDistance * 2^k)
+	unsigned level = 0;
+	float levelSquaredDistance = fullResolutionDistance * fullResolutionDistance;
+	while (level + 1 < numberOfLevels && nearestSquaredDistance >= levelSquaredDistance)
+		{
+		level++;
+		levelSquaredDistance *= 4;
+		}
+	return level;
+	}
+
+void PointCloudMap::SelectFeatures(const pcl::PointXYZ& center, float radius, std::vector<pcl::PointXYZ>& selectedFeaturesList, std::vector<float>& selectedDescriptorsList)
+	{
+	std::vector<TileSelection> selectedTilesList;
+	SelectTiles(center, radius, selectedTilesList);
+
+	const float squaredRadius = radius * radius;
+	const unsigned maximumNumberOfFeatures = VisualPointFeatureVector3DWrapper::MAX_FEATURE_3D_POINTS;
+	bool truncated = false;
+	selectedFeaturesList.clear();
+	selectedDescriptorsList.clear();
+	for(unsigned tileIndex = 0; tileIndex < selectedTilesList.size() && !truncated; tileIndex++)
+		{
+		const TileSelection& selection = selectedTilesList.at(tileIndex);
+		TileView view;
+		OpenTileView(*(selection.key), *(selection.tile), view);
+		for(unsigned featureIndex = 0; featureIndex < selection.tile->numberOfFeatures; featureIndex++)
+			{
+			const pcl::PointXYZ& point = view.featuresList[featureIndex];
+			if (selection.fullyInside || SquaredPointDistance(center, point) <= squaredRadius)
+				{
+				if (selectedFeaturesList.size() == maximumNumberOfFeatures)
+					{
+					truncated = true;
+					break;
+					}
+				selectedFeaturesList.push_back(point);
+				const float* descriptor = view.featureDescriptorsList + featureIndex * descriptorLength;
+				selectedDescriptorsList.insert(selectedDescriptorsList.end(), descriptor, descriptor + descriptorLength);
+				}
+			}
+		CloseTileView(view);
+		}
+
+	if (truncated)
+		{
+		PRINT_TO_LOG("Stored feature vector is too large, only a part will be used for matching", "");
+		}
+	}
+
+size_t PointCloudMap::ComputeTileMemoryUsage(const Tile& tile)
+	{
+	size_t numberOfVoxels = 0;
+	for(unsigned level = 0; level < tile.levelsList.size(); level++)
+		{
+		numberOfVoxels += tile.levelsList[level].numberOfVoxels;
+		}
+	return numberOfVoxels * VOXEL_MEMORY_USAGE + tile.numberOfFeatures * (FEATURE_MEMORY_USAGE + descriptorLength * sizeof(float));
+	}
+
+size_t PointCloudMap::ComputeTileFileLength(const Tile& tile)
+	{
+	size_t numberOfVoxels = 0;
+	for(unsigned level = 0; level < tile.levelsList.size(); level++)
+		{
+		numberOfVoxels += tile.levelsList[level].numberOfVoxels;
+		}
+	return sizeof(TileFileHeader) + numberOfVoxels * ( sizeof(Voxel) + sizeof(VoxelKey) ) + tile.numberOfFeatures * ( sizeof(pcl::PointXYZ) + descriptorLength * sizeof(float) );
+	}
+
+std::string PointCloudMap::GetTileFilePath(const VoxelKey& tileKey)
+	{
+	std::stringstream filePath;
+	filePath << swapFolderPath << "/PointCloudMap_" << getpid() << "_" << mapIdentifier << "_" << tileKey.x << "_" << tileKey.y << "_" << tileKey.z << ".tile";
+	return filePath.str();
+	}
+
+void PointCloudMap::OpenTileView(const VoxelKey& tileKey, const Tile& tile, TileView& view)
+	{
+	if (tile.resident)
+		{
+		for(unsigned level = 0; level < tile.levelsList.size(); level++)
+			{
+			view.voxelsLists[level] = tile.levelsList[level].voxelsList.data();
+			}
+		view.featuresList = tile.featuresList.data();
+		view.featureDescriptorsList = tile.featureDescriptorsList.data();
+		view.mappedAddress = NULL;
+		view.mappedLength = 0;
+		return;
+		}
+
+	//The pages of the swap file are read by the kernel as they are accessed, the tile is not brought back into memory
+	std::string filePath = GetTileFilePath(tileKey);
+	int fileDescriptor = open(filePath.c_str(), O_RDONLY);
+	ASSERT(fileDescriptor >= 0, "PointCloudMap Error, tile swap file could not be opened");
+	view.mappedLength = ComputeTileFileLength(tile);
+	view.mappedAddress = mmap(NULL, view.mappedLength, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	close(fileDescriptor);
+	ASSERT(view.mappedAddress != MAP_FAILED, "PointCloudMap Error, tile swap file could not be mapped");
+
+	const TileFileHeader* header = static_cast<const TileFileHeader*>(view.mappedAddress);
+	ASSERT(header->numberOfLevels == tile.levelsList.size() && header->numberOfFeatures == tile.numberOfFeatures, "PointCloudMap Error, tile swap file is inconsistent");
+	const char* cursor = static_cast<const char*>(view.mappedAddress) + sizeof(TileFileHeader);
+	for(unsigned level = 0; level < tile.levelsList.size(); level++)
+		{
+		view.voxelsLists[level] = reinterpret_cast<const Voxel*>(cursor);
+		cursor += tile.levelsList[level].numberOfVoxels * sizeof(Voxel);
+		}
+	view.featuresList = reinterpret_cast<const pcl::PointXYZ*>(cursor);
+	cursor += tile.numberOfFeatures * sizeof(pcl::PointXYZ);
+	view.featureDescriptorsList = reinterpret_cast<const float*>(cursor);
+	}
+
+void PointCloudMap::CloseTileView(TileView& view)
+	{
+	if (view.mappedAddress != NULL)
+		{
+		munmap(view.mappedAddress, view.mappedLength);
+		view.mappedAddress = NULL;
+		}
+	}
+
+void PointCloudMap::EnforceMemoryBudget()
+	{
+	if (memoryBudget == 0 || residentMemoryUsage <= memoryBudget)
+		{
+		return;
+		}
+
+	//The tiles farthest from the latest pose are the least likely to be needed by the next queries and insertions
+	const float tileLength = TILE_SIZE * resolution;
+	const float centerX = GetXPosition(poseOfLatestPointCloud);
+	const float centerY = GetYPosition(poseOfLatestPointCloud);
+	const float centerZ = GetZPosition(poseOfLatestPointCloud);
+	std::vector< std::pair<float, TilesMap::iterator> > residentTilesList;
+	for(TilesMap::iterator tile = tilesMap.begin(); tile != tilesMap.end(); ++tile)
+		{
+		if (tile->second.resident)
+			{
+			pcl::PointXYZ tileCenter( (tile->first.x + 0.5f) * tileLength, (tile->first.y + 0.5f) * tileLength, (tile->first.z + 0.5f) * tileLength );
+			residentTilesList.push_back( std::make_pair( SquaredPointDistance(tileCenter, pcl::PointXYZ(centerX, centerY, centerZ)), tile) );
+			}
+		}
+	std::sort(residentTilesList.begin(), residentTilesList.end(), [](const std::pair<float, TilesMap::iterator>& first, const std::pair<float, TilesMap::iterator>& second)
+		{
+		return first.first > second.first;
+		});
+
+	for(unsigned tileIndex = 0; tileIndex < residentTilesList.size() && residentMemoryUsage > memoryBudget; tileIndex++)
+		{
+		TilesMap::iterator tile = residentTilesList.at(tileIndex).second;
+		EvictTile(tile->first, tile->second);
+		}
+	}
+
+void PointCloudMap::EvictTile(const VoxelKey& tileKey, Tile& tile)
+	{
+	//A tile that was read back and not modified is still identical to its swap file
+	if (tile.modified || !tile.swapped)
+		{
+		std::string filePath = GetTileFilePath(tileKey);
+		size_t fileLength = ComputeTileFileLength(tile);
+		int fileDescriptor = open(filePath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+		ASSERT(fileDescriptor >= 0, "PointCloudMap Error, tile swap file could not be created");
+		bool resized = (ftruncate(fileDescriptor, fileLength) == 0);
+		void* address = resized ? mmap(NULL, fileLength, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0) : MAP_FAILED;
+		close(fileDescriptor);
+		ASSERT(address != MAP_FAILED, "PointCloudMap Error, tile swap file could not be mapped");
+
+		TileFileHeader header = { tile.numberOfFeatures, descriptorLength, static_cast<uint32_t>(tile.levelsList.size()), {0}, {0} };
+		for(unsigned level = 0; level < tile.levelsList.size(); level++)
+			{
+			header.numberOfVoxels[level] = tile.levelsList[level].numberOfVoxels;
+			}
+		char* cursor = static_cast<char*>(address);
+		*reinterpret_cast<TileFileHeader*>(cursor) = header;
+		cursor += sizeof(TileFileHeader);
+		for(unsigned level = 0; level < tile.levelsList.size(); level++)
+			{
+			const VoxelLevel& voxelLevel = tile.levelsList[level];
+			std::copy(voxelLevel.voxelsList.begin(), voxelLevel.voxelsList.end(), reinterpret_cast<Voxel*>(cursor));
+			cursor += voxelLevel.numberOfVoxels * sizeof(Voxel);
+			}
+		std::copy(tile.featuresList.begin(), tile.featuresList.end(), reinterpret_cast<pcl::PointXYZ*>(cursor));
+		cursor += tile.numberOfFeatures * sizeof(pcl::PointXYZ);
+		std::copy(tile.featureDescriptorsList.begin(), tile.featureDescriptorsList.end(), reinterpret_cast<float*>(cursor));
+		cursor += tile.featureDescriptorsList.size() * sizeof(float);
+		for(unsigned level = 0; level < tile.levelsList.size(); level++)
+			{
+			const VoxelLevel& voxelLevel = tile.levelsList[level];
+			VoxelKey* keysList = reinterpret_cast<VoxelKey*>(cursor);
+			for(std::unordered_map<VoxelKey, uint32_t, VoxelKeyHash>::const_iterator voxel = voxelLevel.voxelsIndexMap.begin(); voxel != voxelLevel.voxelsIndexMap.end(); ++voxel)
+				{
+				keysList[voxel->second] = voxel->first;
 				}
-			featuresList.push_back(featurePoint);			
+			cursor += voxelLevel.numberOfVoxels * sizeof(VoxelKey);
+			}
+		munmap(address, fileLength);
+		tile.swapped = true;
+		}
+
+	residentMemoryUsage -= ComputeTileMemoryUsage(tile);
+	for(unsigned level = 0; level < tile.levelsList.size(); level++)
+		{
+		std::vector<Voxel>().swap(tile.levelsList[level].voxelsList);
+		std::unordered_map<VoxelKey, uint32_t, VoxelKeyHash>().swap(tile.levelsList[level].voxelsIndexMap);
+		}
+	std::vector<pcl::PointXYZ>().swap(tile.featuresList);
+	std::vector<float>().swap(tile.featureDescriptorsList);
+	CellsMap().swap(tile.featuresVoxelsMap);
+	tile.resident = false;
+	tile.modified = false;
+	}
+
+void PointCloudMap::LoadTile(const VoxelKey& tileKey, Tile& tile)
+	{
+	TileView view;
+	OpenTileView(tileKey, tile, view);
+
+	tile.featuresList.assign(view.featuresList, view.featuresList + tile.numberOfFeatures);
+	tile.featureDescriptorsList.assign(view.featureDescriptorsList, view.featureDescriptorsList + tile.numberOfFeatures * descriptorLength);
+	for(uint32_t featureIndex = 0; featureIndex < tile.numberOfFeatures; featureIndex++)
+		{
+		tile.featuresVoxelsMap[ ComputeVoxelKey(tile.featuresList.at(featureIndex)) ].push_back(featureIndex);
+		}
+
+	const VoxelKey* keysList = reinterpret_cast<const VoxelKey*>(view.featureDescriptorsList + tile.numberOfFeatures * descriptorLength);
+	for(unsigned level = 0; level < tile.levelsList.size(); level++)
+		{
+		VoxelLevel& voxelLevel = tile.levelsList[level];
+		voxelLevel.voxelsList.assign(view.voxelsLists[level], view.voxelsLists[level] + voxelLevel.numberOfVoxels);
+		voxelLevel.voxelsIndexMap.reserve(voxelLevel.numberOfVoxels);
+		for(uint32_t voxelIndex = 0; voxelIndex < voxelLevel.numberOfVoxels; voxelIndex++)
+			{
+			voxelLevel.voxelsIndexMap[ keysList[voxelIndex] ] = voxelIndex;
 			}
+		keysList += voxelLevel.numberOfVoxels;
 		}
+	CloseTileView(view);
+
+	tile.resident = true;
+	tile.modified = false;
+	residentMemoryUsage += ComputeTileMemoryUsage(tile);
+	}
+
+void PointCloudMap::RemoveSwapFiles()
+	{
+	for(TilesMap::iterator tile = tilesMap.begin(); tile != tilesMap.end(); ++tile)
+		{
+		if (tile->second.swapped)
+			{
+			unlink( GetTileFilePath(tile->first).c_str() );
+			tile->second.swapped = false;
+			}
+		}
+	}
+
+void PointCloudMap::Rebuild(float newResolution, unsigned newNumberOfLevels)
+	{
+	//The full resolution voxels and the features are collected in tile creation order and added again, the levels are rebuilt from the voxels weighted by their number of points
+	std::vector<TileSelection> selectedTilesList;
+	SelectTiles(pcl::PointXYZ(0, 0, 0), -1, selectedTilesList);
+	std::vector<Voxel> oldVoxelsList;
+	std::vector<pcl::PointXYZ> oldFeaturesList;
+	std::vector<float> oldDescriptorsList;
+	for(unsigned tileIndex = 0; tileIndex < selectedTilesList.size(); tileIndex++)
+		{
+		const Tile& tile = *(selectedTilesList.at(tileIndex).tile);
+		TileView view;
+		OpenTileView(*(selectedTilesList.at(tileIndex).key), tile, view);
+		oldVoxelsList.insert(oldVoxelsList.end(), view.voxelsLists[0], view.voxelsLists[0] + tile.levelsList[0].numberOfVoxels);
+		oldFeaturesList.insert(oldFeaturesList.end(), view.featuresList, view.featuresList + tile.numberOfFeatures);
+		oldDescriptorsList.insert(oldDescriptorsList.end(), view.featureDescriptorsList, view.featureDescriptorsList + tile.numberOfFeatures * descriptorLength);
+		CloseTileView(view);
+		}
+
+	RemoveSwapFiles();
+	tilesMap.clear();
+	numberOfCreatedTiles = 0;
+	numberOfStoredVoxels = 0;
+	numberOfStoredFeatures = 0;
+	residentMemoryUsage = 0;
+	resolution = newResolution;
+	numberOfLevels = newNumberOfLevels;
+
+	Tile* cachedTile = NULL;
+	VoxelKey cachedTileKey;
+	for(unsigned voxelIndex = 0; voxelIndex < oldVoxelsList.size(); voxelIndex++)
+		{
+		const Voxel& voxel = oldVoxelsList.at(voxelIndex);
+		AddPointToVoxel(pcl::PointXYZ(voxel.x, voxel.y, voxel.z), voxel.numberOfPoints, cachedTile, cachedTileKey);
+		}
+	for(unsigned featureIndex = 0; featureIndex < oldFeaturesList.size(); featureIndex++)
+		{
+		AddFeatureToTile(oldFeaturesList.at(featureIndex), oldDescriptorsList.data() + featureIndex * descriptorLength);
+		}
+	EnforceMemoryBudget();
 	}
 
 PointCloudMap::AffineTransform PointCloudMap::ConvertCloudPoseToInversionTransform(PoseWrapper::Pose3DConstPtr cloudPoseInMap)
@@ -274,25 +1065,68 @@ pcl::PointXYZ PointCloudMap::TransformPoint(const pcl::PointXYZ& point, const Af
 	return transformedPoint;
 	}
 
-float PointCloudMap::PointDistance(const pcl::PointXYZ& p, const pcl::PointXYZ& q)
+float PointCloudMap::SquaredPointDistance(const pcl::PointXYZ& p, const pcl::PointXYZ& q)
 	{
 	float differenceX = p.x - q.x;
 	float differenceY = p.y - q.y;
 	float differenceZ = p.z - q.z;
-	return std::sqrt( differenceX*differenceX + differenceY*differenceY + differenceZ*differenceZ);
+	return differenceX*differenceX + differenceY*differenceY + differenceZ*differenceZ;
+	}
+
+PointCloudConstPtr PointCloudMap::ConvertToPointCloud(const std::vector<pcl::PointXYZ>& pointsList, const AffineTransform& affineTransform)
+	{
+	std::vector<T_Double> coordinatesList(3 * pointsList.size());
+	for(unsigned pointIndex = 0; pointIndex < pointsList.size(); pointIndex++)
+		{
+		pcl::PointXYZ transformedCloudPoint = TransformPoint(pointsList[pointIndex], affineTransform);
+		coordinatesList[3*pointIndex] = transformedCloudPoint.x;
+		coordinatesList[3*pointIndex + 1] = transformedCloudPoint.y;
+		coordinatesList[3*pointIndex + 2] = transformedCloudPoint.z;
+		}
+
+	PointCloudPtr pointCloudOutput = NewPointCloud();
+	AddPoints(*pointCloudOutput, coordinatesList.data(), pointsList.size());
+	return pointCloudOutput;
 	}
 
 bool PointCloudMap::NoCloseFeature(const pcl::PointXYZ& point)
 	{
-	for(unsigned featureIndex = 0; featureIndex < featuresList.size(); featureIndex++)
+	//A feature closer than resolution can only be in the voxel of point or in one of its 26 neighbours, which may belong to a neighbouring tile
+	const float squaredResolution = resolution * resolution;
+	VoxelKey centralKey = ComputeVoxelKey(point);
+	VoxelKey key;
+	bool reloaded = false;
+	bool closeFeatureFound = false;
+	for(key.x = centralKey.x - 1; key.x <= centralKey.x + 1 && !closeFeatureFound; key.x++)
 		{
-		float distance = PointDistance(point, featuresList.at(featureIndex).point);
-		if (distance < resolution)
+		for(key.y = centralKey.y - 1; key.y <= centralKey.y + 1 && !closeFeatureFound; key.y++)
 			{
-			return false;
+			for(key.z = centralKey.z - 1; key.z <= centralKey.z + 1 && !closeFeatureFound; key.z++)
+				{
+				Tile* tile = FindResidentTile( ComputeTileKey(key), reloaded );
+				if (tile == NULL)
+					{
+					continue;
+					}
+				CellsMap::const_iterator voxel = tile->featuresVoxelsMap.find(key);
+				if (voxel == tile->featuresVoxelsMap.end())
+					{
+					continue;
+					}
+				for(std::vector<uint32_t>::const_iterator featureIndex = voxel->second.begin(); featureIndex != voxel->second.end() && !closeFeatureFound; ++featureIndex)
+					{
+					closeFeatureFound = (SquaredPointDistance(point, tile->featuresList[*featureIndex]) < squaredResolution);
+					}
+				}
 			}
 		}
-	return true;
+
+	//The tiles read back from their swap files are evicted again only now that no pointer to them is held
+	if (reloaded)
+		{
+		EnforceMemoryBudget();
+		}
+	return !closeFeatureFound;
 	}
 
 }
@@ -300,4 +1134,3 @@ bool PointCloudMap::NoCloseFeature(const pcl::PointXYZ& point)
 }
 
 /** @} */
-
@@ -19,6 +19,9 @@
  * The map offer methods for adding more point cloud at give poses, for storing features and descriptor of point cloud for future matchings and for extracting a revelant part of the map centered at
  * a given position.
  *
+ * The map is partitioned in cubic tiles of voxels. Under a memory budget, the tiles farthest from the latest pose are swapped to memory-mapped files, so that long traverses
+ * do not exhaust the memory.
+ *
  * @{
  */
 
@@ -40,7 +43,12 @@
 #include <pcl/point_types.h>
 
 #include <stdlib.h>
+#include <stdint.h>
 #include <memory>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <unordered_map>
 
 namespace CDFF
 {
@@ -87,6 +95,23 @@ namespace Reconstruction3D
 		void AttachPointCloud(PointCloudWrapper::PointCloudConstPtr pointCloudInput, VisualPointFeatureVector3DWrapper::VisualPointFeatureVector3DConstPtr pointCloudFeaturesVector,
 						PoseWrapper::Pose3DConstPtr cloudPoseDisplacement);
 
+		/*
+		* @brief Moves the latest pose by a displacement without adding any point, for the frames that are only used for tracking the camera.
+		*
+		* @param poseDisplacement, the pose of the camera with respect to the latest pose
+		*
+		*/
+		void AttachPose(PoseWrapper::Pose3DConstPtr poseDisplacement);
+
+		/*
+		* @brief Computes the ratio of the points of a cloud that overlap the map, a point overlaps the map if its voxel or one of the neighbouring voxels contains mapped points.
+		*
+		* @param pointCloudInput, the point cloud to compare with the map;
+		* @param cloudPoseInMap, the pose of the point cloud with respect to the origin of the map
+		* @output, the ratio in [0, 1] of the valid points of the cloud that overlap the map, zero if the cloud has no valid points.
+		*/
+		float ComputeOverlapRatio(PointCloudWrapper::PointCloudConstPtr pointCloudInput, PoseWrapper::Pose3DConstPtr cloudPoseInMap);
+
 		/*
 		* @brief Retrieves a point cloud given by all the mapped points which are within a given radius from a center, the output points coordinate are relative to the scene origin.
 		*
@@ -105,6 +130,29 @@ namespace Reconstruction3D
 		*/
 		PointCloudWrapper::PointCloudConstPtr GetScenePointCloudInOrigin(PoseWrapper::Pose3DConstPtr origin,  float radius);
 
+		/*
+		* @brief Retrieves the mapped points that are within a given radius from a center but were not within the same radius from a previous center, the output points coordinates
+		* are relative to the scene origin. It is meant for keeping up to date a copy of the map around the camera, by adding only the points that entered the radius as the camera moved.
+		*
+		* @param previousOrigin, the previous reference center
+		* @param origin, the current reference center
+		* @param radius, the reference distance from the centers, it cannot be negative.
+		* @output, the entering points in the coordinate system relative to the very first camera pose; when they are more than the capacity of a point cloud, evenly spaced points are kept.
+		*/
+		PointCloudWrapper::PointCloudConstPtr GetScenePointCloudEnteringRadius(PoseWrapper::Pose3DConstPtr previousOrigin, PoseWrapper::Pose3DConstPtr origin, float radius);
+
+		/*
+		* @brief Retrieves a level of detail point cloud of the mapped points within a given radius from a center, the output points coordinates are relative to the origin input.
+		* The points are taken at full resolution near the center and from coarser levels farther away, see SetLevelsOfDetail; the levels are made coarser until the output fits
+		* the points budget, the remaining excess points, if any, are the ones farthest from the center.
+		*
+		* @param origin, the reference center for the retrivial, and centre of the coordinate system for the output point cloud.
+		* @param radius, the reference distance from the center, if radius is negative all points are selected.
+		* @param maximumNumberOfPoints, the points budget of the output, zero means the maximum size of a point cloud.
+		* @output, the scene point cloud in the coordinate system relative to origin.
+		*/
+		PointCloudWrapper::PointCloudConstPtr GetScenePointCloudInOrigin(PoseWrapper::Pose3DConstPtr origin,  float radius, unsigned maximumNumberOfPoints);
+
 		/*
 		* @brief Retrieves the feature points located within a given radius from a center
 		*
@@ -121,12 +169,38 @@ namespace Reconstruction3D
 		const PoseWrapper::Pose3D& GetLatestPose();
 
 		/*
-		* @brief Set the resolution of the point cloud
+		* @brief Set the resolution of the point cloud, if the map is not empty the stored points are redistributed among the voxels of the new resolution.
 		*
 		* @param resolution, the resolution of the point cloud
 		*
 		*/
-		void SetResolution(float resolution);		
+		void SetResolution(float resolution);
+
+		/*
+		* @brief Set the levels of detail maintained by the map, the voxels of level k have side resolution * 2^k. Level 0 is used up to levelDistance from the center of a level of detail
+		* query, level k up to levelDistance * 2^k; the levels are updated incrementally as points are added.
+		*
+		* @param numberOfLevels, the number of levels including the full resolution one, between 1 and MAXIMUM_NUMBER_OF_LEVELS;
+		* @param levelDistance, the distance from the center within which the full resolution is used.
+		*
+		*/
+		void SetLevelsOfDetail(unsigned numberOfLevels, float levelDistance);
+		static const unsigned MAXIMUM_NUMBER_OF_LEVELS = 7;
+
+		/*
+		* @brief Bounds the memory used by the map. When the map grows beyond the budget, the tiles farthest from the latest pose are written to memory-mapped swap files
+		* and released; they are read back when a query or an insertion needs them.
+		*
+		* @param memoryBudget, the approximate number of bytes the map may keep in memory, zero means no limit;
+		* @param swapFolderPath, the existing folder where the swap files are written.
+		*
+		*/
+		void SetMemoryBudget(size_t memoryBudget, std::string swapFolderPath);
+
+		/*
+		* @brief Retrieves the approximate number of bytes used by the tiles that are in memory.
+		*/
+		size_t GetResidentMemoryUsage();
 
 	/* --------------------------------------------------------------------
 	 * Protected
@@ -140,31 +214,150 @@ namespace Reconstruction3D
 	 * --------------------------------------------------------------------
 	 */	
 	private:
-		static const unsigned MAX_DESCRIPTOR_LENGTH = 352;
 		static const float DEFAULT_RESOLUTION;
-		typedef float Descriptor[MAX_DESCRIPTOR_LENGTH];
+		static const float DEFAULT_LEVEL_DISTANCE;
 		typedef Eigen::Transform<float, 3, Eigen::Affine, Eigen::DontAlign> AffineTransform;
 
-		struct FeaturePoint
+		//Integer coordinates of a voxel, the voxel (x, y, z) contains the points in [x*resolution, (x+1)*resolution) x [y*resolution, (y+1)*resolution) x [z*resolution, (z+1)*resolution)
+		struct VoxelKey
+			{
+			int32_t x;
+			int32_t y;
+			int32_t z;
+			bool operator==(const VoxelKey& other) const
+				{
+				return x == other.x && y == other.y && z == other.z;
+				}
+			};
+
+		struct VoxelKeyHash
+			{
+			size_t operator()(const VoxelKey& key) const
+				{
+				return static_cast<size_t>( (static_cast<uint32_t>(key.x) * 73856093u) ^ (static_cast<uint32_t>(key.y) * 19349663u) ^ (static_cast<uint32_t>(key.z) * 83492791u) );
+				}
+			};
+
+		//The voxel stores the running centroid of all the points that fell into it, so that adding a point does not require to revisit the previous ones
+		struct Voxel
+			{
+			float x;
+			float y;
+			float z;
+			uint32_t numberOfPoints;
+			};
+
+		typedef std::unordered_map<VoxelKey, std::vector<uint32_t>, VoxelKeyHash> CellsMap;
+
+		//The voxels of one level of detail of a tile, in order of creation
+		struct VoxelLevel
+			{
+			std::vector<Voxel> voxelsList;
+			std::unordered_map<VoxelKey, uint32_t, VoxelKeyHash> voxelsIndexMap;
+			uint32_t numberOfVoxels;
+			};
+
+		//A tile is a cube of TILE_SIZE x TILE_SIZE x TILE_SIZE voxels of level 0, the voxels of the coarser levels nest exactly in it. Voxels and features are stored in the tile that contains them
+		//in order of creation, the descriptor of the i-th feature occupies the elements [i*descriptorLength, (i+1)*descriptorLength) of featureDescriptorsList. When a tile is not resident its
+		//content is only in its swap file.
+		static const int32_t TILE_SIZE = 64;
+		struct Tile
+			{
+			std::vector<VoxelLevel> levelsList;
+			std::vector<pcl::PointXYZ> featuresList;
+			std::vector<float> featureDescriptorsList;
+			CellsMap featuresVoxelsMap; //features by voxel, for the detection of duplicates
+			uint32_t creationIndex;
+			uint32_t numberOfFeatures;
+			bool resident;
+			bool modified; //the content differs from the swap file
+			bool swapped; //the swap file exists
+			};
+		typedef std::unordered_map<VoxelKey, Tile, VoxelKeyHash> TilesMap;
+
+		//Read only access to the content of a tile, either in memory or in a temporary mapping of its swap file
+		struct TileView
+			{
+			const Voxel* voxelsLists[MAXIMUM_NUMBER_OF_LEVELS];
+			const pcl::PointXYZ* featuresList;
+			const float* featureDescriptorsList;
+			void* mappedAddress;
+			size_t mappedLength;
+			};
+
+		struct TileSelection
+			{
+			const VoxelKey* key;
+			const Tile* tile;
+			float nearestSquaredDistance;
+			bool fullyInside;
+			};
+
+		//Swap file layout: the header, the voxels of each level, the features, the descriptors and the keys of the voxels of each level
+		struct TileFileHeader
 			{
-			pcl::PointXYZ point;
-			Descriptor descriptor;
+			uint32_t numberOfFeatures;
+			uint32_t descriptorLength;
+			uint32_t numberOfLevels;
+			uint32_t numberOfVoxels[MAXIMUM_NUMBER_OF_LEVELS];
+			uint32_t reserved[2];
 			};
 
+		static const size_t VOXEL_MEMORY_USAGE;
+		static const size_t FEATURE_MEMORY_USAGE;
+		static std::atomic<unsigned> mapsCounter;
+
 		float resolution;
+		unsigned numberOfLevels;
+		float levelDistance;
 		unsigned descriptorLength;
 		PoseWrapper::Pose3D poseOfLatestPointCloud;
-		std::vector<FeaturePoint> featuresList;
-		pcl::PointCloud<pcl::PointXYZ>::Ptr pointCloud;
-	
+		TilesMap tilesMap;
+		uint32_t numberOfCreatedTiles;
+		uint32_t numberOfStoredVoxels;
+		uint32_t numberOfStoredFeatures;
+
+		size_t memoryBudget;
+		size_t residentMemoryUsage;
+		std::string swapFolderPath;
+		unsigned mapIdentifier;
+
 		void AddPointCloud(PointCloudWrapper::PointCloudConstPtr pointCloudInput, const AffineTransform& affineTransform);
+		void AddPointToVoxel(const pcl::PointXYZ& point, uint32_t numberOfPoints, Tile*& cachedTile, VoxelKey& cachedTileKey);
+		bool AddPointToLevel(VoxelLevel& level, const VoxelKey& key, const pcl::PointXYZ& point, uint32_t numberOfPoints);
+		bool IsNeighbourhoodOccupied(const VoxelKey& key, Tile*& cachedTile, VoxelKey& cachedTileKey, bool& reloaded);
 		void AddFeatureCloud(VisualPointFeatureVector3DWrapper::VisualPointFeatureVector3DConstPtr pointCloudFeaturesVector, const AffineTransform& affineTransform);
+		void AddFeatureToTile(const pcl::PointXYZ& point, const float* descriptor);
+		bool NoCloseFeature(const pcl::PointXYZ& point);
+		VoxelKey ComputeVoxelKey(const pcl::PointXYZ& point);
+		VoxelKey ComputeTileKey(const VoxelKey& voxelKey);
+		VoxelKey ComputeLevelKey(const VoxelKey& voxelKey, unsigned level);
+		static int32_t FloorDivide(int32_t dividend, int32_t divisor);
+
+		Tile& GetResidentTile(const VoxelKey& tileKey);
+		Tile* FindResidentTile(const VoxelKey& tileKey, bool& reloaded);
+		void SelectTiles(const pcl::PointXYZ& center, float radius, std::vector<TileSelection>& selectedTilesList);
+		bool ClassifyTile(const VoxelKey& tileKey, const pcl::PointXYZ& center, float radius, TileSelection& selection);
+		void SelectVoxels(const pcl::PointXYZ& center, float radius, std::vector<pcl::PointXYZ>& selectedPointsList);
+		void SelectLevelOfDetailVoxels(const pcl::PointXYZ& center, float radius, unsigned maximumNumberOfPoints, std::vector<pcl::PointXYZ>& selectedPointsList);
+		unsigned ComputeLevelOfDetail(float nearestSquaredDistance, float fullResolutionDistance);
+		void Rebuild(float newResolution, unsigned newNumberOfLevels);
+		void SelectFeatures(const pcl::PointXYZ& center, float radius, std::vector<pcl::PointXYZ>& selectedFeaturesList, std::vector<float>& selectedDescriptorsList);
+
+		size_t ComputeTileMemoryUsage(const Tile& tile);
+		size_t ComputeTileFileLength(const Tile& tile);
+		std::string GetTileFilePath(const VoxelKey& tileKey);
+		void OpenTileView(const VoxelKey& tileKey, const Tile& tile, TileView& view);
+		void CloseTileView(TileView& view);
+		void EnforceMemoryBudget();
+		void EvictTile(const VoxelKey& tileKey, Tile& tile);
+		void LoadTile(const VoxelKey& tileKey, Tile& tile);
+		void RemoveSwapFiles();
 
 		AffineTransform ConvertCloudPoseToInversionTransform(PoseWrapper::Pose3DConstPtr cloudPoseInMap);
 		pcl::PointXYZ TransformPoint(const pcl::PointXYZ& point, const AffineTransform& affineTransform);
-		float PointDistance(const pcl::PointXYZ& p, const pcl::PointXYZ& q);
-
-		bool NoCloseFeature(const pcl::PointXYZ& point);
+		float SquaredPointDistance(const pcl::PointXYZ& p, const pcl::PointXYZ& q);
+		PointCloudWrapper::PointCloudConstPtr ConvertToPointCloud(const std::vector<pcl::PointXYZ>& pointsList, const AffineTransform& affineTransform);
     };
 }
 }
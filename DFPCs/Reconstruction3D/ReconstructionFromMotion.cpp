@@ -29,6 +29,7 @@
 #include "ReconstructionFromMotion.hpp"
 #include <Errors/Assert.hpp>
 #include <Errors/AssertOnTest.hpp>
+#include <Macros/TracingMacros.hpp>
 
 #include <Executors/ImageFiltering/ImageFilteringExecutor.hpp>
 #include <Executors/PointCloudReconstruction2DTo3D/PointCloudReconstruction2DTo3DExecutor.hpp>
@@ -77,6 +78,11 @@ ReconstructionFromMotion::ReconstructionFromMotion() :
 	parametersHelper.AddParameter<float>("RightToLeftCameraPose", "OrientationW", parameters.rightToLeftCameraPose.orientationW, DEFAULT_PARAMETERS.rightToLeftCameraPose.orientationW);
 
 	parametersHelper.AddParameter<float>("GeneralParameters", "PointCloudMapResolution", parameters.pointCloudMapResolution, DEFAULT_PARAMETERS.pointCloudMapResolution);
+	parametersHelper.AddParameter<int>("GeneralParameters", "PointCloudMapMemoryBudget", parameters.pointCloudMapMemoryBudget, DEFAULT_PARAMETERS.pointCloudMapMemoryBudget);
+	parametersHelper.AddParameter<std::string>("GeneralParameters", "PointCloudMapSwapFolder", parameters.pointCloudMapSwapFolder, DEFAULT_PARAMETERS.pointCloudMapSwapFolder);
+	parametersHelper.AddParameter<int>("GeneralParameters", "PointCloudMapLevelsOfDetail", parameters.pointCloudMapLevelsOfDetail, DEFAULT_PARAMETERS.pointCloudMapLevelsOfDetail);
+	parametersHelper.AddParameter<float>("GeneralParameters", "PointCloudMapLevelOfDetailDistance", parameters.pointCloudMapLevelOfDetailDistance, DEFAULT_PARAMETERS.pointCloudMapLevelOfDetailDistance);
+	parametersHelper.AddParameter<int>("GeneralParameters", "PointCloudMapOutputBudget", parameters.pointCloudMapOutputBudget, DEFAULT_PARAMETERS.pointCloudMapOutputBudget);
 	parametersHelper.AddParameter<float>("GeneralParameters", "SearchRadius", parameters.searchRadius, DEFAULT_PARAMETERS.searchRadius);
 	parametersHelper.AddParameter<int>("GeneralParameters", "TrackedHistorySize", parameters.trackedHistorySize, DEFAULT_PARAMETERS.trackedHistorySize);
 	parametersHelper.AddParameter<bool>("GeneralParameters", "UseAssemblerDfn", parameters.useAssemblerDfn, DEFAULT_PARAMETERS.useAssemblerDfn);
@@ -119,6 +125,7 @@ ReconstructionFromMotion::~ReconstructionFromMotion()
 
 void ReconstructionFromMotion::run() 
 	{
+	TRACE_SCOPE_CATEGORY("ReconstructionFromMotion::run", "DFPC");
 	DEBUG_PRINT_TO_LOG("Structure from motion start", "");
 	outSuccess = ComputeCameraMovement();
 
@@ -148,6 +155,11 @@ const ReconstructionFromMotion::ReconstructionFromMotionOptionsSet Reconstructio
 	{
 	/*.searchRadius =*/ -1,
 	/*.pointCloudMapResolution =*/ 1e-2,
+	/*.pointCloudMapMemoryBudget =*/ 0,
+	/*.pointCloudMapSwapFolder =*/ ".",
+	/*.pointCloudMapLevelsOfDetail =*/ 1,
+	/*.pointCloudMapLevelOfDetailDistance =*/ 5,
+	/*.pointCloudMapOutputBudget =*/ 0,
 	//.rightToLeftCameraPose = 
 		{
 		/*.positionX =*/ 0.122,
@@ -178,9 +190,16 @@ void ReconstructionFromMotion::ConfigureExtraParameters()
 
 	DeleteIfNotNull(bundleHistory);
 	bundleHistory = new BundleHistory(parameters.trackedHistorySize + 1);
+	bundleHistory->SetImagesRetention(false);
 
 	ASSERT(parameters.pointCloudMapResolution > 0, "RegistrationFromStereo Error, Point Cloud Map resolution is not positive");
+	ASSERT(parameters.pointCloudMapMemoryBudget >= 0, "ReconstructionFromMotion Error, Point Cloud Map memory budget is negative");
+	ASSERT(parameters.pointCloudMapLevelsOfDetail >= 1 && parameters.pointCloudMapLevelsOfDetail <= static_cast<int>(PointCloudMap::MAXIMUM_NUMBER_OF_LEVELS), "ReconstructionFromMotion Error, Point Cloud Map levels of detail out of range");
+	ASSERT(parameters.pointCloudMapLevelOfDetailDistance > 0, "ReconstructionFromMotion Error, Point Cloud Map level of detail distance is not positive");
+	ASSERT(parameters.pointCloudMapOutputBudget >= 0, "ReconstructionFromMotion Error, Point Cloud Map output budget is negative");
 	pointCloudMap.SetResolution(parameters.pointCloudMapResolution);
+	pointCloudMap.SetMemoryBudget(static_cast<size_t>(parameters.pointCloudMapMemoryBudget) * 1024 * 1024, parameters.pointCloudMapSwapFolder);
+	pointCloudMap.SetLevelsOfDetail(parameters.pointCloudMapLevelsOfDetail, parameters.pointCloudMapLevelOfDetailDistance);
 	}
 
 bool ReconstructionFromMotion::ComputeCameraMovement()
@@ -284,7 +303,7 @@ void ReconstructionFromMotion::UpdateScene(PointCloudConstPtr inputCloud)
 			}
 
 		Copy( pointCloudMap.GetLatestPose(), outPose);
-		outputPointCloud = pointCloudMap.GetScenePointCloudInOrigin(&outPose, parameters.searchRadius);
+		outputPointCloud = pointCloudMap.GetScenePointCloudInOrigin(&outPose, parameters.searchRadius, parameters.pointCloudMapOutputBudget);
 		}
 
 	Copy(*outputPointCloud, outPointCloud);
@@ -29,6 +29,7 @@
 #include "ReconstructionFromStereo.hpp"
 #include <Errors/Assert.hpp>
 #include <Errors/AssertOnTest.hpp>
+#include <Macros/TracingMacros.hpp>
 
 #include <Executors/ImageFiltering/ImageFilteringExecutor.hpp>
 #include <Executors/StereoReconstruction/StereoReconstructionExecutor.hpp>
@@ -71,7 +72,16 @@ ReconstructionFromStereo::ReconstructionFromStereo() :
 	parameters = DEFAULT_PARAMETERS;
 
 	parametersHelper.AddParameter<float>("GeneralParameters", "PointCloudMapResolution", parameters.pointCloudMapResolution, DEFAULT_PARAMETERS.pointCloudMapResolution);
+	parametersHelper.AddParameter<int>("GeneralParameters", "PointCloudMapMemoryBudget", parameters.pointCloudMapMemoryBudget, DEFAULT_PARAMETERS.pointCloudMapMemoryBudget);
+	parametersHelper.AddParameter<std::string>("GeneralParameters", "PointCloudMapSwapFolder", parameters.pointCloudMapSwapFolder, DEFAULT_PARAMETERS.pointCloudMapSwapFolder);
+	parametersHelper.AddParameter<int>("GeneralParameters", "PointCloudMapLevelsOfDetail", parameters.pointCloudMapLevelsOfDetail, DEFAULT_PARAMETERS.pointCloudMapLevelsOfDetail);
+	parametersHelper.AddParameter<float>("GeneralParameters", "PointCloudMapLevelOfDetailDistance", parameters.pointCloudMapLevelOfDetailDistance, DEFAULT_PARAMETERS.pointCloudMapLevelOfDetailDistance);
+	parametersHelper.AddParameter<int>("GeneralParameters", "PointCloudMapOutputBudget", parameters.pointCloudMapOutputBudget, DEFAULT_PARAMETERS.pointCloudMapOutputBudget);
 	parametersHelper.AddParameter<float>("GeneralParameters", "SearchRadius", parameters.searchRadius, DEFAULT_PARAMETERS.searchRadius);
+	parametersHelper.AddParameter<float>("GeneralParameters", "KeyframeTranslation", parameters.keyframeTranslation, DEFAULT_PARAMETERS.keyframeTranslation);
+	parametersHelper.AddParameter<float>("GeneralParameters", "KeyframeRotation", parameters.keyframeRotation, DEFAULT_PARAMETERS.keyframeRotation);
+	parametersHelper.AddParameter<float>("GeneralParameters", "KeyframeOverlap", parameters.keyframeOverlap, DEFAULT_PARAMETERS.keyframeOverlap);
+	parametersHelper.AddParameter<float>("GeneralParameters", "KeyframeTrackSurvival", parameters.keyframeTrackSurvival, DEFAULT_PARAMETERS.keyframeTrackSurvival);
 	parametersHelper.AddParameter<float>("GeneralParameters", "Baseline", parameters.baseline, DEFAULT_PARAMETERS.baseline);
 
 	optionalLeftFilter = NULL;
@@ -90,6 +100,7 @@ ReconstructionFromStereo::ReconstructionFromStereo() :
 	cleanCorrespondenceMap = NewCorrespondenceMap2D();
 
 	bundleHistory = new BundleHistory(2);
+	bundleHistory->SetImagesRetention(false);
 
 	configurationFilePath = "";
 	firstInput = true;
@@ -109,6 +120,7 @@ ReconstructionFromStereo::~ReconstructionFromStereo()
 
 void ReconstructionFromStereo::run() 
 	{
+	TRACE_SCOPE_CATEGORY("ReconstructionFromStereo::run", "DFPC");
 	DEBUG_PRINT_TO_LOG("Structure from stereo start", "");
 
 	bundleHistory->AddImages(inLeftImage, inRightImage);
@@ -118,9 +130,6 @@ void ReconstructionFromStereo::run()
 	Executors::Execute(optionalLeftFilter, inLeftImage, filteredLeftImage);
 	Executors::Execute(optionalRightFilter, inRightImage, filteredRightImage);
 
-	PointCloudConstPtr imageCloud = NULL;
-	Executors::Execute(reconstructor3d, filteredLeftImage, filteredRightImage, imageCloud);
-
 	ComputeCurrentMatches(filteredLeftImage, filteredRightImage);
 
 	if (firstInput)
@@ -131,19 +140,34 @@ void ReconstructionFromStereo::run()
 		Pose3D zeroPose;
 		SetPosition(zeroPose, 0, 0, 0);
 		SetOrientation(zeroPose, 0, 0, 0, 1);
+
+		PointCloudConstPtr imageCloud = NULL;
+		Executors::Execute(reconstructor3d, filteredLeftImage, filteredRightImage, imageCloud);
 		pointCloudMap.AddPointCloud( imageCloud, EMPTY_FEATURE_VECTOR, &zeroPose);
+		keyframeSelector.SetKeyframe(zeroPose, *bundleHistory->GetFeatures(0, LEFT_FEATURE_CATEGORY));
 		}
 	else
 		{
 		Pose3DConstPtr previousPoseToPose = NULL;
 		outSuccess = ComputeCameraMovement(previousPoseToPose);
-		pointCloudMap.AttachPointCloud( imageCloud, EMPTY_FEATURE_VECTOR, previousPoseToPose);
+		Pose3D poseInMap = Sum(pointCloudMap.GetLatestPose(), *previousPoseToPose);
+		if (IsKeyframe(poseInMap))
+			{
+			PointCloudConstPtr imageCloud = NULL;
+			Executors::Execute(reconstructor3d, filteredLeftImage, filteredRightImage, imageCloud);
+			pointCloudMap.AttachPointCloud( imageCloud, EMPTY_FEATURE_VECTOR, previousPoseToPose);
+			keyframeSelector.SetKeyframe(poseInMap, *bundleHistory->GetFeatures(0, LEFT_FEATURE_CATEGORY));
+			}
+		else
+			{
+			pointCloudMap.AttachPose(previousPoseToPose);
+			}
 		}
 
 	if (outSuccess)
 		{
 		Copy( pointCloudMap.GetLatestPose(), outPose);
-		PointCloudWrapper::PointCloudConstPtr outputPointCloud = pointCloudMap.GetScenePointCloudInOrigin(&outPose, parameters.searchRadius);
+		PointCloudWrapper::PointCloudConstPtr outputPointCloud = pointCloudMap.GetScenePointCloudInOrigin(&outPose, parameters.searchRadius, parameters.pointCloudMapOutputBudget);
 		Copy(*outputPointCloud, outPointCloud); 
 
 		DEBUG_PRINT_TO_LOG("pose", ToString(outPose));
@@ -160,6 +184,9 @@ void ReconstructionFromStereo::setup()
 	ConfigureExtraParameters();
 
 	pointCloudMap.SetResolution(parameters.pointCloudMapResolution);
+	pointCloudMap.SetMemoryBudget(static_cast<size_t>(parameters.pointCloudMapMemoryBudget) * 1024 * 1024, parameters.pointCloudMapSwapFolder);
+	pointCloudMap.SetLevelsOfDetail(parameters.pointCloudMapLevelsOfDetail, parameters.pointCloudMapLevelOfDetailDistance);
+	keyframeSelector.SetThresholds(parameters.keyframeTranslation, parameters.keyframeRotation, parameters.keyframeOverlap, parameters.keyframeTrackSurvival);
 
 	SetPosition(rightToLeftCameraPose, -parameters.baseline, 0, 0);
 	SetOrientation(rightToLeftCameraPose, 0, 0, 0, 1);
@@ -176,6 +203,15 @@ const ReconstructionFromStereo::ReconstructionFromStereoOptionsSet Reconstructio
 	{
 	/*.searchRadius =*/ -1,
 	/*.pointCloudMapResolution =*/ 1e-2,
+	/*.pointCloudMapMemoryBudget =*/ 0,
+	/*.pointCloudMapSwapFolder =*/ ".",
+	/*.pointCloudMapLevelsOfDetail =*/ 1,
+	/*.pointCloudMapLevelOfDetailDistance =*/ 5,
+	/*.pointCloudMapOutputBudget =*/ 0,
+	/*.keyframeTranslation =*/ 0,
+	/*.keyframeRotation =*/ 0,
+	/*.keyframeOverlap =*/ 0,
+	/*.keyframeTrackSurvival =*/ 0,
 	/*.baseline =*/ 1
 	};
 
@@ -190,6 +226,12 @@ void ReconstructionFromStereo::ConfigureExtraParameters()
 	parametersHelper.ReadFile( configurator.GetExtraParametersConfigurationFilePath() );
 
 	ASSERT(parameters.pointCloudMapResolution > 0, "RegistrationFromStereo Error, Point Cloud Map resolution is not positive");
+	ASSERT(parameters.pointCloudMapMemoryBudget >= 0, "ReconstructionFromStereo Error, Point Cloud Map memory budget is negative");
+	ASSERT(parameters.pointCloudMapLevelsOfDetail >= 1 && parameters.pointCloudMapLevelsOfDetail <= static_cast<int>(PointCloudMap::MAXIMUM_NUMBER_OF_LEVELS), "ReconstructionFromStereo Error, Point Cloud Map levels of detail out of range");
+	ASSERT(parameters.pointCloudMapLevelOfDetailDistance > 0, "ReconstructionFromStereo Error, Point Cloud Map level of detail distance is not positive");
+	ASSERT(parameters.pointCloudMapOutputBudget >= 0, "ReconstructionFromStereo Error, Point Cloud Map output budget is negative");
+	ASSERT(parameters.keyframeOverlap <= 1, "ReconstructionFromStereo Error, keyframe overlap is greater than 1");
+	ASSERT(parameters.keyframeTrackSurvival <= 1, "ReconstructionFromStereo Error, keyframe track survival is greater than 1");
 	}
 
 void ReconstructionFromStereo::InstantiateDFNs()
@@ -264,6 +306,7 @@ bool ReconstructionFromStereo::ComputeCameraMovement(Pose3DConstPtr& previousPos
 	DEBUG_PRINT_TO_LOG("Inlier Correspondences Number", GetNumberOfCorrespondences(*pastInlierCorrespondenceMap) );
 	
 	CorrespondenceMap2DConstPtr pastCorrespondenceMap = pastSuccess ? pastInlierCorrespondenceMap : pastLeftCorrespondenceMap;
+	keyframeSelector.TrackFeatures(*pastCorrespondenceMap);
 	CorrespondenceMap2DConstPtr currentCorrespondenceMap = bundleHistory->GetMatches(0);
 	PointCloudConstPtr currentPointCloud = bundleHistory->GetPointCloud(0, TRIANGULATION_CLOUD_CATEGORY);
 
@@ -296,6 +339,21 @@ bool ReconstructionFromStereo::ComputeCameraMovement(Pose3DConstPtr& previousPos
 	return success;
 	}
 
+bool ReconstructionFromStereo::IsKeyframe(const Pose3D& poseInMap)
+	{
+	float overlapRatio = 1;
+	if (keyframeSelector.UsesOverlap())
+		{
+		overlapRatio = pointCloudMap.ComputeOverlapRatio( bundleHistory->GetPointCloud(0, TRIANGULATION_CLOUD_CATEGORY), &poseInMap);
+		DEBUG_PRINT_TO_LOG("Overlap ratio", overlapRatio);
+		}
+	DEBUG_PRINT_TO_LOG("Track survival ratio", keyframeSelector.GetTrackSurvivalRatio());
+
+	bool keyframe = keyframeSelector.IsKeyframe(poseInMap, overlapRatio);
+	DEBUG_PRINT_TO_LOG("keyframe", (keyframe ? "yes" : "no") );
+	return keyframe;
+	}
+
 void ReconstructionFromStereo::CleanUnmatchedFeatures(CorrespondenceMap2DWrapper::CorrespondenceMap2DConstPtr map, PointCloudWrapper::PointCloudPtr cloud)
 	{
 	ASSERT( GetNumberOfCorrespondences(*map) == GetNumberOfPoints(*cloud), "CleanUmatchedFeatures error: expected same number of points in map and cloud");
@@ -19,10 +19,20 @@
  *  (i) the left and right images are used to reconstruct a 3D point cloud throught computation of a disparity map;
  *  (ii) camera movement is estimated by matching features in the past left image with the 3d points extracted from the current stereo pair,
  *  (iii) point clouds at different time instants are merged together taking into account the movement of the camera.
+ *  Only the point clouds of keyframes are reconstructed and merged, the other frames are used only for tracking the camera; by default every frame is a keyframe.
  *
  * This DFPC is configured according to the following parameters (beyond those that are needed to configure the DFN components):
  * @param SearchRadius, the output is given by the point of the reconstructed cloud contained within a sphere of center given by the current camera pose and radius given by this parameter;
- * @param PointCloudMapResolution, the voxel resolution of the output point cloud, if the cloud is denser it will be filtered by PCL voxel filter;
+ * @param PointCloudMapResolution, the voxel resolution of the output point cloud, points falling in the same voxel are merged into their centroid;
+ * @param PointCloudMapMemoryBudget, the memory in megabytes the point cloud map may use before its tiles farthest from the camera are swapped to disk, zero means no limit;
+ * @param PointCloudMapSwapFolder, the existing folder where the point cloud map writes its swap files;
+ * @param PointCloudMapLevelsOfDetail, the number of voxel resolutions kept by the point cloud map, each one twice as coarse as the previous one, 1 disables the levels of detail;
+ * @param PointCloudMapLevelOfDetailDistance, the output points are at full resolution up to this distance from the camera, then the resolution halves each time the distance doubles;
+ * @param PointCloudMapOutputBudget, the maximum number of points of the output point cloud, the levels of detail are made coarser to fit it, zero means the maximum size of a point cloud;
+ * @param KeyframeTranslation, a frame is a keyframe when the camera moved this distance from the latest keyframe, zero or less disables this criterion;
+ * @param KeyframeRotation, a frame is a keyframe when the camera rotated this angle in radians from the latest keyframe, zero or less disables this criterion;
+ * @param KeyframeOverlap, a frame is a keyframe when the ratio of its triangulated keypoints that overlap the map is below this value, zero or less disables this criterion;
+ * @param KeyframeTrackSurvival, a frame is a keyframe when the ratio of the latest keyframe features still tracked is below this value, zero or less disables this criterion;
  * @param Baseline, the baseline of the stereo camera pair.
  *
  * Notes: no set of DFNs implementation has produced good result for this DFPC implementation during testing.
@@ -51,6 +61,7 @@
 
 #include "PointCloudMap.hpp"
 #include "BundleHistory.hpp"
+#include "KeyframeSelector.hpp"
 
 #include <Helpers/ParametersListHelper.hpp>
 #include <DfpcConfigurator.hpp>
@@ -110,6 +121,15 @@ namespace Reconstruction3D
 			{
 			float searchRadius;
 			float pointCloudMapResolution;
+			int pointCloudMapMemoryBudget;
+			std::string pointCloudMapSwapFolder;
+			int pointCloudMapLevelsOfDetail;
+			float pointCloudMapLevelOfDetailDistance;
+			int pointCloudMapOutputBudget;
+			float keyframeTranslation;
+			float keyframeRotation;
+			float keyframeOverlap;
+			float keyframeTrackSurvival;
 			float baseline;
 			};
 
@@ -147,6 +167,7 @@ namespace Reconstruction3D
 		BundleHistory* bundleHistory;
 		PoseWrapper::Pose3D rightToLeftCameraPose;
 		PointCloudMap pointCloudMap;
+		KeyframeSelector keyframeSelector;
 		bool firstInput;
 
 		//Parameters Configuration method
@@ -158,6 +179,7 @@ namespace Reconstruction3D
 		//Core computation methods that execute a step of the DFPC pipeline
 		void ComputeCurrentMatches(FrameWrapper::FrameConstPtr filteredLeftImage, FrameWrapper::FrameConstPtr filteredRightImage);
 		bool ComputeCameraMovement(PoseWrapper::Pose3DConstPtr& previousPoseToPose);
+		bool IsKeyframe(const PoseWrapper::Pose3D& poseInMap);
 		void CleanUnmatchedFeatures(CorrespondenceMap2DWrapper::CorrespondenceMap2DConstPtr map, PointCloudWrapper::PointCloudPtr cloud);
 
 		/*
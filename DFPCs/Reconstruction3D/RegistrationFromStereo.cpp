@@ -29,6 +29,7 @@
 #include "RegistrationFromStereo.hpp"
 #include <Errors/Assert.hpp>
 #include <Errors/AssertOnTest.hpp>
+#include <Macros/TracingMacros.hpp>
 
 #include <Executors/ImageFiltering/ImageFilteringExecutor.hpp>
 #include <Executors/StereoReconstruction/StereoReconstructionExecutor.hpp>
@@ -64,6 +65,11 @@ RegistrationFromStereo::RegistrationFromStereo()
 	parameters = DEFAULT_PARAMETERS;
 
 	parametersHelper.AddParameter<float>("GeneralParameters", "PointCloudMapResolution", parameters.pointCloudMapResolution, DEFAULT_PARAMETERS.pointCloudMapResolution);
+	parametersHelper.AddParameter<int>("GeneralParameters", "PointCloudMapMemoryBudget", parameters.pointCloudMapMemoryBudget, DEFAULT_PARAMETERS.pointCloudMapMemoryBudget);
+	parametersHelper.AddParameter<std::string>("GeneralParameters", "PointCloudMapSwapFolder", parameters.pointCloudMapSwapFolder, DEFAULT_PARAMETERS.pointCloudMapSwapFolder);
+	parametersHelper.AddParameter<int>("GeneralParameters", "PointCloudMapLevelsOfDetail", parameters.pointCloudMapLevelsOfDetail, DEFAULT_PARAMETERS.pointCloudMapLevelsOfDetail);
+	parametersHelper.AddParameter<float>("GeneralParameters", "PointCloudMapLevelOfDetailDistance", parameters.pointCloudMapLevelOfDetailDistance, DEFAULT_PARAMETERS.pointCloudMapLevelOfDetailDistance);
+	parametersHelper.AddParameter<int>("GeneralParameters", "PointCloudMapOutputBudget", parameters.pointCloudMapOutputBudget, DEFAULT_PARAMETERS.pointCloudMapOutputBudget);
 	parametersHelper.AddParameter<float>("GeneralParameters", "SearchRadius", parameters.searchRadius, DEFAULT_PARAMETERS.searchRadius);
 	parametersHelper.AddParameter<bool>("GeneralParameters", "MatchToReconstructedCloud", parameters.matchToReconstructedCloud, DEFAULT_PARAMETERS.matchToReconstructedCloud);
 	parametersHelper.AddParameter<bool>("GeneralParameters", "UseAssemblerDfn", parameters.useAssemblerDfn, DEFAULT_PARAMETERS.useAssemblerDfn);
@@ -85,6 +91,7 @@ RegistrationFromStereo::RegistrationFromStereo()
 	registrator3d = NULL;
 
 	bundleHistory = new BundleHistory(2);
+	bundleHistory->SetImagesRetention(false);
 	}
 
 RegistrationFromStereo::~RegistrationFromStereo()
@@ -94,6 +101,7 @@ RegistrationFromStereo::~RegistrationFromStereo()
 
 void RegistrationFromStereo::run() 
 	{
+	TRACE_SCOPE_CATEGORY("RegistrationFromStereo::run", "DFPC");
 	DEBUG_PRINT_TO_LOG("Registration from stereo start", "");
 
 	bundleHistory->AddImages(inLeftImage, inRightImage);
@@ -139,6 +147,8 @@ void RegistrationFromStereo::setup()
 	InstantiateDFNs();
 
 	pointCloudMap.SetResolution(parameters.pointCloudMapResolution);
+	pointCloudMap.SetMemoryBudget(static_cast<size_t>(parameters.pointCloudMapMemoryBudget) * 1024 * 1024, parameters.pointCloudMapSwapFolder);
+	pointCloudMap.SetLevelsOfDetail(parameters.pointCloudMapLevelsOfDetail, parameters.pointCloudMapLevelOfDetailDistance);
 	}
 
 /* --------------------------------------------------------------------------
@@ -152,6 +162,11 @@ const RegistrationFromStereo::RegistrationFromStereoOptionsSet RegistrationFromS
 	{
 	/*.searchRadius =*/ 20,
 	/*.pointCloudMapResolution =*/ 1e-2,
+	/*.pointCloudMapMemoryBudget =*/ 0,
+	/*.pointCloudMapSwapFolder =*/ ".",
+	/*.pointCloudMapLevelsOfDetail =*/ 1,
+	/*.pointCloudMapLevelOfDetailDistance =*/ 5,
+	/*.pointCloudMapOutputBudget =*/ 0,
 	/*.matchToReconstructedCloud =*/ false,
 	/*.useAssemblerDfn=*/ false,
 	/*.useRegistratorDfn=*/ false
@@ -168,6 +183,10 @@ void RegistrationFromStereo::ConfigureExtraParameters()
 	parametersHelper.ReadFile( configurator.GetExtraParametersConfigurationFilePath() );
 
 	ASSERT(parameters.pointCloudMapResolution > 0, "RegistrationFromStereo Error, Point Cloud Map resolution is not positive");
+	ASSERT(parameters.pointCloudMapMemoryBudget >= 0, "RegistrationFromStereo Error, Point Cloud Map memory budget is negative");
+	ASSERT(parameters.pointCloudMapLevelsOfDetail >= 1 && parameters.pointCloudMapLevelsOfDetail <= static_cast<int>(PointCloudMap::MAXIMUM_NUMBER_OF_LEVELS), "RegistrationFromStereo Error, Point Cloud Map levels of detail out of range");
+	ASSERT(parameters.pointCloudMapLevelOfDetailDistance > 0, "RegistrationFromStereo Error, Point Cloud Map level of detail distance is not positive");
+	ASSERT(parameters.pointCloudMapOutputBudget >= 0, "RegistrationFromStereo Error, Point Cloud Map output budget is negative");
 	}
 
 void RegistrationFromStereo::InstantiateDFNs()
@@ -279,11 +298,10 @@ void RegistrationFromStereo::UpdatePointCloud(PointCloudConstPtr imageCloud, Vis
 		{
 		if (parameters.matchToReconstructedCloud)
 			{
-			VisualPointFeatureVector3DConstPtr fullCloudFeatureVector = pointCloudMap.GetSceneFeaturesVector(&outPose, parameters.searchRadius);
-			bundleHistory->AddFeatures3d(*fullCloudFeatureVector);
-			DeleteIfNotNull(fullCloudFeatureVector);
+			VisualPointFeatureVector3DSharedConstPtr fullCloudFeatureVector( pointCloudMap.GetSceneFeaturesVector(&outPose, parameters.searchRadius) );
+			bundleHistory->AddFeatures3d(fullCloudFeatureVector);
 			}
-		outputPointCloud = pointCloudMap.GetScenePointCloudInOrigin(&outPose, parameters.searchRadius);
+		outputPointCloud = pointCloudMap.GetScenePointCloudInOrigin(&outPose, parameters.searchRadius, parameters.pointCloudMapOutputBudget);
 		}
 
 	Copy(*outputPointCloud, outPointCloud);
@@ -28,6 +28,7 @@
  */
 #include "RegistrationAndMatching.hpp"
 #include "Errors/Assert.hpp"
+#include <Macros/TracingMacros.hpp>
 #include <Visualizers/OpenCVVisualizer.hpp>
 #include <Visualizers/PCLVisualizer.hpp>
 #include <fstream>
@@ -64,6 +65,7 @@ RegistrationAndMatching::~RegistrationAndMatching()
 
 void RegistrationAndMatching::run() 
 	{
+	TRACE_SCOPE_CATEGORY("RegistrationAndMatching::run", "DFPC");
 	registrationFromStereo->leftImageInput(inLeftImage);
 	registrationFromStereo->rightImageInput(inRightImage);
 	registrationFromStereo->run();
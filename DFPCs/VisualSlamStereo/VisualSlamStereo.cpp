@@ -4,6 +4,7 @@
  */
 
 #include "VisualSlamStereo.hpp"
+#include <Macros/TracingMacros.hpp>
 
 namespace CDFF
 {
@@ -30,6 +31,7 @@ void VisualSlamStereo::setup()
 
 void VisualSlamStereo::run()
 {
+    TRACE_SCOPE_CATEGORY("VisualSlamStereo::run", "DFPC");
     ASSERT( slam!= nullptr, "VisualSlamStereo, Slam DFN is null");
     slam->framePairInput(inFramePair);
     slam->process();
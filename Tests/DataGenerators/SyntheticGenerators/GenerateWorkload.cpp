@@ -0,0 +1,64 @@
+/* --------------------------------------------------------------------------
+*
+* (C) Copyright …
+*
+* ---------------------------------------------------------------------------
+*/
+
+/*!
+ * @file GenerateWorkload.cpp
+ * @date 19/10/2026
+ * @author Alessandro Bianco
+ */
+
+/*!
+ * @addtogroup DataGenerators
+ * 
+ * This is the main program for generating synthetic workloads of arbitrary size for scaling studies.
+ * 
+ * 
+ * @{
+ */
+
+/* --------------------------------------------------------------------------
+ *
+ * Includes
+ *
+ * --------------------------------------------------------------------------
+ */
+#include "WorkloadGenerator.hpp"
+#include <Errors/Assert.hpp>
+#include <iostream>
+
+using namespace DataGenerators;
+
+const std::string USAGE =
+" \n \
+This program generates a synthetic trajectory of a stereo camera looking down at a procedural textured terrain. Frames are generated and written one at a time, so the number of frames \
+and the number of points per cloud are only limited by disk space. For each frame it writes: \n \
+a. a rectified stereo image pair (left_N.png, right_N.png) listed with its time in ImagesList.txt, in the format read by the visual odometry tests and by the key performance \
+measures tests of the Reconstruction3D DFPCs, and listed without header and time in StereoPairsList.txt, in the format read by the performance tests of the Reconstruction3D DFPCs; \n \
+b. the point cloud seen by the left camera in the camera system (cloud_N.ply) listed in CloudsList.txt together with the camera pose; \n \
+c. the same point cloud encoded as an ASN.1 bitstream (cloud_N.bin), if the cloud is not larger than the ASN.1 point cloud limit; \n \
+d. the camera pose in PosesList.txt. \n \
+All list files except StereoPairsList.txt start with three comment lines, the second one contains the camera parameters. \n \n \
+This program requires the following parameters: \n \
+1. the output folder path, it has to exist; \n \
+2. optionally, the path to a yaml configuration file, every parameter not found in the file takes its default value. Available parameters: NumberOfFrames, PointsPerCloud, \
+Overlap (fraction of the view shared by consecutive frames in [0, 1)), DisplacementNoiseStandardDeviation, OutliersRate (in [0, 1]), CameraAltitude, ReliefAmplitude, ImageWidth, \
+ImageHeight, FocalLength, Baseline, FramePeriod, RandomSeed, GenerateImages, GenerateClouds, WriteAsn1Clouds. \n \n \
+Example usage: ./generate_workload ../tests/Data/Workload/ ../tests/ConfigurationFiles/DataGenerators/WorkloadGenerator.yaml \n \n ";
+
+int main(int argc, char** argv)
+	{
+	ASSERT(argc >= 2, USAGE);
+	std::string outputFolderPath = argv[1];
+	std::string configurationFilePath = (argc >= 3) ? argv[2] : "";
+
+	WorkloadGenerator generator(outputFolderPath, configurationFilePath);
+	generator.Generate();
+
+	return 0;
+	}
+
+/** @} */
@@ -0,0 +1,415 @@
+/* --------------------------------------------------------------------------
+*
+* (C) Copyright …
+*
+* ---------------------------------------------------------------------------
+*/
+
+/*!
+ * @file WorkloadGenerator.cpp
+ * @date 19/10/2026
+ * @author Alessandro Bianco
+ */
+
+/*!
+ * @addtogroup DataGenerators
+ *
+ * Implementation of the WorkloadGenerator class.
+ *
+ *
+ * @{
+ */
+
+/* --------------------------------------------------------------------------
+ *
+ * Includes
+ *
+ * --------------------------------------------------------------------------
+ */
+#include "WorkloadGenerator.hpp"
+#include <Errors/Assert.hpp>
+#include <Types/CPP/PointCloud.hpp>
+
+#include <opencv2/imgproc/imgproc.hpp>
+#include <opencv2/highgui/highgui.hpp>
+#include <pcl/io/ply_io.h>
+#include <yaml-cpp/yaml.h>
+
+#include <cmath>
+#include <algorithm>
+#include <stdint.h>
+#include <iostream>
+
+using namespace PoseWrapper;
+using namespace PointCloudWrapper;
+
+namespace DataGenerators
+{
+
+/* --------------------------------------------------------------------------
+ *
+ * Public Member Functions
+ *
+ * --------------------------------------------------------------------------
+ */
+WorkloadGenerator::WorkloadGenerator(std::string outputFolderPath, std::string configurationFilePath)
+	{
+	this->outputFolderPath = outputFolderPath;
+	parameters = DEFAULT_PARAMETERS;
+	if (configurationFilePath != "")
+		{
+		LoadConfiguration(configurationFilePath);
+		}
+	ValidateParameters();
+
+	randomEngine.seed(parameters.randomSeed);
+
+	//The footprint of the camera is computed on the plane at height zero, which is the mean height of the terrain
+	groundWidth = parameters.cameraAltitude * static_cast<double>(parameters.imageWidth) / parameters.focalLength;
+	groundHeight = parameters.cameraAltitude * static_cast<double>(parameters.imageHeight) / parameters.focalLength;
+	cameraStep = (1 - parameters.overlap) * groundWidth;
+	samplingStep = std::sqrt( groundWidth * groundHeight / static_cast<double>(parameters.pointsPerCloud) );
+	}
+
+WorkloadGenerator::~WorkloadGenerator()
+	{
+
+	}
+
+void WorkloadGenerator::Generate()
+	{
+	std::ofstream posesListFile, cloudsListFile, imagesListFile, stereoPairsListFile;
+	OpenListFile(posesListFile, "PosesList.txt", true);
+	if (parameters.generateClouds)
+		{
+		OpenListFile(cloudsListFile, "CloudsList.txt", true);
+		}
+	if (parameters.generateImages)
+		{
+		OpenListFile(imagesListFile, "ImagesList.txt", true);
+		OpenListFile(stereoPairsListFile, "StereoPairsList.txt", false);
+		}
+
+	for(int frameIndex = 0; frameIndex < parameters.numberOfFrames; frameIndex++)
+		{
+		Pose3D cameraPose = ComputeCameraPose(frameIndex);
+		posesListFile << (frameIndex * parameters.framePeriod) << " " << GetXPosition(cameraPose) << " " << GetYPosition(cameraPose) << " " << GetZPosition(cameraPose) << " "
+			<< GetXOrientation(cameraPose) << " " << GetYOrientation(cameraPose) << " " << GetZOrientation(cameraPose) << " " << GetWOrientation(cameraPose) << std::endl;
+
+		if (parameters.generateClouds)
+			{
+			pcl::PointCloud<pcl::PointXYZ>::Ptr cloud = ComputePointCloud(frameIndex);
+			SavePointCloud(frameIndex, cloud, cloudsListFile);
+			}
+		if (parameters.generateImages)
+			{
+			SaveImagePair(frameIndex, imagesListFile, stereoPairsListFile);
+			}
+		std::cout << "Generated frame " << (frameIndex + 1) << " of " << parameters.numberOfFrames << std::endl;
+		}
+
+	posesListFile.close();
+	cloudsListFile.close();
+	imagesListFile.close();
+	stereoPairsListFile.close();
+	}
+
+pcl::PointCloud<pcl::PointXYZ>::Ptr WorkloadGenerator::ComputePointCloud(int frameIndex)
+	{
+	std::normal_distribution<double> displacementErrorSource(0, parameters.displacementNoiseStandardDeviation);
+	std::uniform_real_distribution<double> outlierSource(0, 1);
+	const double cameraX = frameIndex * cameraStep;
+
+	//Points are taken on a grid fixed in the world system, so that the overlapping part of two frames contains the same terrain points
+	const int minimumColumn = static_cast<int>( std::ceil( (cameraX - groundWidth/2) / samplingStep ) );
+	const int maximumColumn = static_cast<int>( std::floor( (cameraX + groundWidth/2) / samplingStep ) );
+	const int minimumRow = static_cast<int>( std::ceil( (-groundHeight/2) / samplingStep ) );
+	const int maximumRow = static_cast<int>( std::floor( (groundHeight/2) / samplingStep ) );
+
+	pcl::PointCloud<pcl::PointXYZ>::Ptr cloud(new pcl::PointCloud<pcl::PointXYZ>);
+	cloud->points.reserve( (maximumColumn - minimumColumn + 1) * (maximumRow - minimumRow + 1) );
+	for(int column = minimumColumn; column <= maximumColumn; column++)
+		{
+		for(int row = minimumRow; row <= maximumRow; row++)
+			{
+			pcl::PointXYZ point;
+			if (outlierSource(randomEngine) < parameters.outliersRate)
+				{
+				point.x = (outlierSource(randomEngine) - 0.5) * groundWidth;
+				point.y = (outlierSource(randomEngine) - 0.5) * groundHeight;
+				point.z = (outlierSource(randomEngine) + 0.5) * parameters.cameraAltitude;
+				}
+			else
+				{
+				double worldX = column * samplingStep;
+				double worldY = row * samplingStep;
+				point.x = worldX - cameraX + displacementErrorSource(randomEngine);
+				point.y = -worldY + displacementErrorSource(randomEngine);
+				point.z = parameters.cameraAltitude - ComputeTerrainHeight(worldX, worldY) + displacementErrorSource(randomEngine);
+				}
+			cloud->points.push_back(point);
+			}
+		}
+
+	cloud->width = cloud->points.size();
+	cloud->height = 1;
+	cloud->is_dense = true;
+	return cloud;
+	}
+
+void WorkloadGenerator::ComputeImagePair(int frameIndex, cv::Mat& leftImage, cv::Mat& rightImage)
+	{
+	const double cameraX = frameIndex * cameraStep;
+	ComputeImage(cameraX, 0, leftImage);
+	ComputeImage(cameraX + parameters.baseline, 0, rightImage);
+	}
+
+Pose3D WorkloadGenerator::ComputeCameraPose(int frameIndex)
+	{
+	//Rotation of 180 degrees around the x axis, the camera z axis points down and the camera y axis is opposite to the world y axis.
+	Pose3D cameraPose;
+	SetPosition(cameraPose, frameIndex * cameraStep, 0, parameters.cameraAltitude);
+	SetOrientation(cameraPose, 1, 0, 0, 0);
+	return cameraPose;
+	}
+
+/* --------------------------------------------------------------------------
+ *
+ * Private Member Variables
+ *
+ * --------------------------------------------------------------------------
+ */
+const WorkloadGenerator::WorkloadParameters WorkloadGenerator::DEFAULT_PARAMETERS =
+	{
+	/*.numberOfFrames =*/ 10,
+	/*.pointsPerCloud =*/ 100000,
+	/*.overlap =*/ 0.8,
+	/*.displacementNoiseStandardDeviation =*/ 0.002,
+	/*.outliersRate =*/ 0.01,
+	/*.cameraAltitude =*/ 2.0,
+	/*.reliefAmplitude =*/ 0.2,
+	/*.imageWidth =*/ 640,
+	/*.imageHeight =*/ 480,
+	/*.focalLength =*/ 500,
+	/*.baseline =*/ 0.12,
+	/*.framePeriod =*/ 0.1,
+	/*.randomSeed =*/ 0,
+	/*.generateImages =*/ true,
+	/*.generateClouds =*/ true,
+	/*.writeAsn1Clouds =*/ true
+	};
+
+const int WorkloadGenerator::NUMBER_OF_HEADER_LINES = 3;
+
+/* --------------------------------------------------------------------------
+ *
+ * Private Member Functions
+ *
+ * --------------------------------------------------------------------------
+ */
+void WorkloadGenerator::LoadConfiguration(std::string configurationFilePath)
+	{
+	YAML::Node configuration;
+	try
+		{
+		configuration = YAML::LoadFile( configurationFilePath );
+		}
+	catch(YAML::Exception& e)
+		{
+		ASSERT(false, "Error: the workload configuration file could not be loaded");
+		}
+
+	#define LOAD_PARAMETER(name, field, type) \
+		if (configuration[name]) \
+			{ \
+			parameters.field = configuration[name].as<type>(); \
+			}
+
+	LOAD_PARAMETER("NumberOfFrames", numberOfFrames, int)
+	LOAD_PARAMETER("PointsPerCloud", pointsPerCloud, int)
+	LOAD_PARAMETER("Overlap", overlap, double)
+	LOAD_PARAMETER("DisplacementNoiseStandardDeviation", displacementNoiseStandardDeviation, double)
+	LOAD_PARAMETER("OutliersRate", outliersRate, double)
+	LOAD_PARAMETER("CameraAltitude", cameraAltitude, double)
+	LOAD_PARAMETER("ReliefAmplitude", reliefAmplitude, double)
+	LOAD_PARAMETER("ImageWidth", imageWidth, int)
+	LOAD_PARAMETER("ImageHeight", imageHeight, int)
+	LOAD_PARAMETER("FocalLength", focalLength, double)
+	LOAD_PARAMETER("Baseline", baseline, double)
+	LOAD_PARAMETER("FramePeriod", framePeriod, double)
+	LOAD_PARAMETER("RandomSeed", randomSeed, unsigned)
+	LOAD_PARAMETER("GenerateImages", generateImages, bool)
+	LOAD_PARAMETER("GenerateClouds", generateClouds, bool)
+	LOAD_PARAMETER("WriteAsn1Clouds", writeAsn1Clouds, bool)
+
+	#undef LOAD_PARAMETER
+	}
+
+void WorkloadGenerator::ValidateParameters()
+	{
+	ASSERT(parameters.numberOfFrames > 0, "Workload Generator Configuration Error: NumberOfFrames has to be positive");
+	ASSERT(parameters.pointsPerCloud > 0, "Workload Generator Configuration Error: PointsPerCloud has to be positive");
+	ASSERT(parameters.overlap >= 0 && parameters.overlap < 1, "Workload Generator Configuration Error: Overlap has to be in [0, 1)");
+	ASSERT(parameters.displacementNoiseStandardDeviation >= 0, "Workload Generator Configuration Error: DisplacementNoiseStandardDeviation cannot be negative");
+	ASSERT(parameters.outliersRate >= 0 && parameters.outliersRate <= 1, "Workload Generator Configuration Error: OutliersRate has to be in [0, 1]");
+	ASSERT(parameters.cameraAltitude > 0, "Workload Generator Configuration Error: CameraAltitude has to be positive");
+	ASSERT(parameters.reliefAmplitude >= 0 && parameters.reliefAmplitude < parameters.cameraAltitude / 2,
+		"Workload Generator Configuration Error: ReliefAmplitude has to be non negative and smaller than half the CameraAltitude");
+	ASSERT(parameters.imageWidth > 0 && parameters.imageHeight > 0, "Workload Generator Configuration Error: image size has to be positive");
+	ASSERT(parameters.focalLength > 0, "Workload Generator Configuration Error: FocalLength has to be positive");
+	ASSERT(parameters.baseline > 0, "Workload Generator Configuration Error: Baseline has to be positive");
+	}
+
+void WorkloadGenerator::OpenListFile(std::ofstream& listFile, std::string fileName, bool writeHeader)
+	{
+	std::string filePath = outputFolderPath + "/" + fileName;
+	listFile.open(filePath.c_str());
+	ASSERT(listFile.good(), "Error: it was not possible to open an output list file");
+	if (!writeHeader)
+		{
+		return;
+		}
+
+	//The readers of the list files skip the first NUMBER_OF_HEADER_LINES lines
+	listFile << "# Synthetic workload: frames " << parameters.numberOfFrames << ", points per cloud " << parameters.pointsPerCloud << ", overlap " << parameters.overlap
+		<< ", noise " << parameters.displacementNoiseStandardDeviation << ", outliers rate " << parameters.outliersRate << std::endl;
+	listFile << "# Camera: focal length " << parameters.focalLength << ", principal point " << (parameters.imageWidth / 2.0) << " " << (parameters.imageHeight / 2.0)
+		<< ", image size " << parameters.imageWidth << " " << parameters.imageHeight << ", baseline " << parameters.baseline << std::endl;
+	for(int lineIndex = 2; lineIndex < NUMBER_OF_HEADER_LINES; lineIndex++)
+		{
+		listFile << "#" << std::endl;
+		}
+	}
+
+double WorkloadGenerator::ComputeTerrainHeight(double x, double y)
+	{
+	//The wave lengths are proportional to the camera footprint, so that the relief looks the same at any scale
+	const double frequency = 2 * M_PI / groundWidth;
+	return parameters.reliefAmplitude * ( 0.6 * std::sin(frequency * x) * std::cos(frequency * y) + 0.4 * std::sin(2.7 * frequency * x + 0.3) * std::sin(1.9 * frequency * y) );
+	}
+
+unsigned char WorkloadGenerator::ComputeTerrainTexture(double x, double y)
+	{
+	static const int NUMBER_OF_OCTAVES = 3;
+	//The finest texture cell is about four pixels wide
+	double cellSize = 4 * parameters.cameraAltitude / parameters.focalLength;
+	double value = 0;
+	double weight = 0.5;
+	for(int octave = 0; octave < NUMBER_OF_OCTAVES; octave++)
+		{
+		double cellX = x / cellSize;
+		double cellY = y / cellSize;
+		int lowX = static_cast<int>( std::floor(cellX) );
+		int lowY = static_cast<int>( std::floor(cellY) );
+		double fractionX = cellX - lowX;
+		double fractionY = cellY - lowY;
+
+		double top = (1 - fractionX) * ComputeLatticeNoise(lowX, lowY, octave) + fractionX * ComputeLatticeNoise(lowX + 1, lowY, octave);
+		double bottom = (1 - fractionX) * ComputeLatticeNoise(lowX, lowY + 1, octave) + fractionX * ComputeLatticeNoise(lowX + 1, lowY + 1, octave);
+		value += weight * ( (1 - fractionY) * top + fractionY * bottom );
+
+		cellSize *= 4;
+		weight /= 2;
+		}
+	return static_cast<unsigned char>( std::min(255.0, 255.0 * value / 0.875) );
+	}
+
+double WorkloadGenerator::ComputeLatticeNoise(int x, int y, int octave)
+	{
+	uint32_t hash = static_cast<uint32_t>(x) * 73856093u ^ static_cast<uint32_t>(y) * 19349663u ^ static_cast<uint32_t>(octave) * 83492791u ^ parameters.randomSeed;
+	hash ^= hash >> 13;
+	hash *= 0x5bd1e995u;
+	hash ^= hash >> 15;
+	return static_cast<double>(hash & 0xFFFF) / 65535.0;
+	}
+
+void WorkloadGenerator::ComputeImage(double cameraX, double cameraY, cv::Mat& image)
+	{
+	static const int NUMBER_OF_INTERSECTION_ITERATIONS = 5;
+	const double principalPointX = parameters.imageWidth / 2.0;
+	const double principalPointY = parameters.imageHeight / 2.0;
+
+	cv::Mat grayImage(parameters.imageHeight, parameters.imageWidth, CV_8UC1);
+	for(int row = 0; row < parameters.imageHeight; row++)
+		{
+		unsigned char* rowPointer = grayImage.ptr<unsigned char>(row);
+		double directionY = (row - principalPointY) / parameters.focalLength;
+		for(int column = 0; column < parameters.imageWidth; column++)
+			{
+			double directionX = (column - principalPointX) / parameters.focalLength;
+
+			//Fixed point iteration for the intersection of the pixel ray with the terrain, it converges because the relief is smooth compared to the camera altitude
+			double depth = parameters.cameraAltitude;
+			double worldX = cameraX, worldY = cameraY;
+			for(int iteration = 0; iteration < NUMBER_OF_INTERSECTION_ITERATIONS; iteration++)
+				{
+				worldX = cameraX + directionX * depth;
+				worldY = cameraY - directionY * depth;
+				depth = parameters.cameraAltitude - ComputeTerrainHeight(worldX, worldY);
+				}
+
+			rowPointer[column] = ComputeTerrainTexture(worldX, worldY);
+			}
+		}
+
+	cv::cvtColor(grayImage, image, cv::COLOR_GRAY2BGR);
+	}
+
+void WorkloadGenerator::SavePointCloud(int frameIndex, pcl::PointCloud<pcl::PointXYZ>::ConstPtr cloud, std::ofstream& cloudsListFile)
+	{
+	std::string plyFileName = "cloud_" + std::to_string(frameIndex) + ".ply";
+	pcl::PLYWriter writer;
+	writer.write(outputFolderPath + "/" + plyFileName, *cloud, true);
+
+	if (parameters.writeAsn1Clouds)
+		{
+		if (cloud->points.size() <= static_cast<unsigned>(MAX_CLOUD_SIZE))
+			{
+			SaveAsn1PointCloud(outputFolderPath + "/cloud_" + std::to_string(frameIndex) + ".bin", cloud);
+			}
+		else
+			{
+			std::cout << "Cloud " << frameIndex << " has " << cloud->points.size() << " points, more than the ASN.1 limit " << MAX_CLOUD_SIZE << ": only the ply file was written" << std::endl;
+			}
+		}
+
+	Pose3D cameraPose = ComputeCameraPose(frameIndex);
+	cloudsListFile << plyFileName << " " << GetXPosition(cameraPose) << " " << GetYPosition(cameraPose) << " " << GetZPosition(cameraPose) << " " <<
+		GetXOrientation(cameraPose) << " " << GetYOrientation(cameraPose) << " " << GetZOrientation(cameraPose) << " " << GetWOrientation(cameraPose) << std::endl;
+	}
+
+void WorkloadGenerator::SaveAsn1PointCloud(std::string filePath, pcl::PointCloud<pcl::PointXYZ>::ConstPtr cloud)
+	{
+	PointCloudPtr asn1Cloud = NewPointCloud();
+	for(unsigned pointIndex = 0; pointIndex < cloud->points.size(); pointIndex++)
+		{
+		const pcl::PointXYZ& point = cloud->points.at(pointIndex);
+		AddPoint(*asn1Cloud, point.x, point.y, point.z);
+		}
+
+	BitStream bitStream = ConvertToBitStream(*asn1Cloud);
+	std::ofstream binaryFile(filePath.c_str(), std::ios::binary);
+	binaryFile.write( reinterpret_cast<const char*>(bitStream.buf), BitStream_GetLength(&bitStream) );
+	binaryFile.close();
+
+	BaseTypesWrapper::DeallocateBitStreamBuffer(bitStream);
+	delete(asn1Cloud);
+	}
+
+void WorkloadGenerator::SaveImagePair(int frameIndex, std::ofstream& imagesListFile, std::ofstream& stereoPairsListFile)
+	{
+	cv::Mat leftImage, rightImage;
+	ComputeImagePair(frameIndex, leftImage, rightImage);
+
+	std::string leftImageFileName = "left_" + std::to_string(frameIndex) + ".png";
+	std::string rightImageFileName = "right_" + std::to_string(frameIndex) + ".png";
+	cv::imwrite(outputFolderPath + "/" + leftImageFileName, leftImage);
+	cv::imwrite(outputFolderPath + "/" + rightImageFileName, rightImage);
+
+	imagesListFile << (frameIndex * parameters.framePeriod) << " " << leftImageFileName << " " << rightImageFileName << std::endl;
+	stereoPairsListFile << leftImageFileName << " " << rightImageFileName << std::endl;
+	}
+
+}
+
+/** @} */
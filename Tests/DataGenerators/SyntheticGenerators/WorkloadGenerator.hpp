@@ -0,0 +1,136 @@
+/* --------------------------------------------------------------------------
+*
+* (C) Copyright …
+*
+* --------------------------------------------------------------------------
+*/
+
+/*!
+ * @file WorkloadGenerator.hpp
+ * @date 19/10/2026
+ * @author Alessandro Bianco
+ */
+
+/*!
+ * @addtogroup DataGenerators
+ *
+ *  This class generates synthetic workloads of arbitrary size for scaling studies of the DFNs and DFPCs. A stereo camera flies at constant altitude above a procedural
+ *  textured terrain, the frames are generated one at a time so that memory use depends only on the size of a single frame. For each frame the class writes a rectified
+ *  stereo image pair and the point cloud of the terrain seen by the left camera, with controllable size, overlap with the previous frame, noise and outliers rate.
+ *
+ *
+ * @{
+ */
+
+#ifndef WORKLOAD_GENERATOR_HPP
+#define WORKLOAD_GENERATOR_HPP
+
+/* --------------------------------------------------------------------------
+ *
+ * Includes
+ *
+ * --------------------------------------------------------------------------
+ */
+#include <opencv2/core/core.hpp>
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <Types/CPP/Pose.hpp>
+
+#include <random>
+#include <string>
+#include <fstream>
+
+namespace DataGenerators {
+
+/* --------------------------------------------------------------------------
+ *
+ * Class definition
+ *
+ * --------------------------------------------------------------------------
+ */
+    class WorkloadGenerator
+    {
+	/* --------------------------------------------------------------------
+	 * Public
+	 * --------------------------------------------------------------------
+	 */
+        public:
+		/* @brief, the constructor takes as input the path of the output folder and the path of the yaml configuration file, missing parameters take default values
+		*/
+        	WorkloadGenerator(std::string outputFolderPath, std::string configurationFilePath);
+        	~WorkloadGenerator();
+
+		/* @brief, generates and writes all frames, one at a time.
+		*/
+		void Generate();
+
+		/* @brief, the terrain point cloud seen by the left camera at frameIndex, in the camera system.
+		*/
+		pcl::PointCloud<pcl::PointXYZ>::Ptr ComputePointCloud(int frameIndex);
+
+		/* @brief, the rectified left and right images seen by the camera at frameIndex, the right camera is displaced by the baseline along the x axis of the left camera.
+		*/
+		void ComputeImagePair(int frameIndex, cv::Mat& leftImage, cv::Mat& rightImage);
+
+		/* @brief, the pose of the left camera at frameIndex: the camera looks down (z axis of the camera system towards -z) and moves along the x axis.
+		*/
+		PoseWrapper::Pose3D ComputeCameraPose(int frameIndex);
+
+	/* --------------------------------------------------------------------
+	 * Protected
+	 * --------------------------------------------------------------------
+	 */
+        protected:
+
+	/* --------------------------------------------------------------------
+	 * Private
+	 * --------------------------------------------------------------------
+	 */
+	private:
+		struct WorkloadParameters
+			{
+			int numberOfFrames;
+			int pointsPerCloud;
+			double overlap;
+			double displacementNoiseStandardDeviation;
+			double outliersRate;
+			double cameraAltitude;
+			double reliefAmplitude;
+			int imageWidth;
+			int imageHeight;
+			double focalLength;
+			double baseline;
+			double framePeriod;
+			unsigned randomSeed;
+			bool generateImages;
+			bool generateClouds;
+			bool writeAsn1Clouds;
+			};
+
+		static const WorkloadParameters DEFAULT_PARAMETERS;
+		static const int NUMBER_OF_HEADER_LINES;
+
+		WorkloadParameters parameters;
+		std::string outputFolderPath;
+		std::default_random_engine randomEngine;
+
+		double groundWidth, groundHeight, cameraStep, samplingStep;
+
+		void LoadConfiguration(std::string configurationFilePath);
+		void ValidateParameters();
+		void OpenListFile(std::ofstream& listFile, std::string fileName, bool writeHeader);
+
+		double ComputeTerrainHeight(double x, double y);
+		unsigned char ComputeTerrainTexture(double x, double y);
+		double ComputeLatticeNoise(int x, int y, int octave);
+		void ComputeImage(double cameraX, double cameraY, cv::Mat& image);
+
+		void SavePointCloud(int frameIndex, pcl::PointCloud<pcl::PointXYZ>::ConstPtr cloud, std::ofstream& cloudsListFile);
+		void SaveAsn1PointCloud(std::string filePath, pcl::PointCloud<pcl::PointXYZ>::ConstPtr cloud);
+		void SaveImagePair(int frameIndex, std::ofstream& imagesListFile, std::ofstream& stereoPairsListFile);
+    };
+
+}
+#endif
+/* WorkloadGenerator.hpp */
+/** @} */
@@ -129,17 +129,13 @@ void OrbDetectorDescriptorTestInterface::DisplayResult()
 
 	for(int featureIndex = 0; featureIndex < GetNumberOfPoints(featuresVector); featureIndex++)
 		{
-		ASSERT(GetNumberOfDescriptorComponents(featuresVector, featureIndex) == ORB_DESCRIPTOR_SIZE, "Orb descriptor size does not match size of received feature");
-		for(int componentIndex = 0; componentIndex < ORB_DESCRIPTOR_SIZE; componentIndex++)
-			{
-			ASSERT(GetDescriptorComponent(featuresVector, featureIndex, componentIndex) == GetDescriptorComponent(featuresVector, featureIndex, componentIndex), "Invalid Descriptor");
-			}
+		ASSERT(GetNumberOfBinaryDescriptorBytes(featuresVector, featureIndex) == ORB_DESCRIPTOR_SIZE, "Orb descriptor size does not match size of received feature");
 
 		cv::Point drawPoint(GetXCoordinate(featuresVector, featureIndex), GetYCoordinate(featuresVector, featureIndex) );
 
-		int r = 255*( (GetDescriptorComponent(featuresVector, featureIndex, featureIndexForRedColor) - minR)/(maxR - minR) );
-		int g = 255*( (GetDescriptorComponent(featuresVector, featureIndex, featureIndexForGreenColor) - minG)/(maxG - minG) );
-		int b = 255*( (GetDescriptorComponent(featuresVector, featureIndex, featureIndexForBlueColor) - minB)/(maxB - minB) );
+		int r = 255*( (GetBinaryDescriptor(featuresVector, featureIndex)[featureIndexForRedColor] - minR)/(maxR - minR) );
+		int g = 255*( (GetBinaryDescriptor(featuresVector, featureIndex)[featureIndexForGreenColor] - minG)/(maxG - minG) );
+		int b = 255*( (GetBinaryDescriptor(featuresVector, featureIndex)[featureIndexForBlueColor] - minB)/(maxB - minB) );
 
 		cv::circle(outputImage, drawPoint, 5, cv::Scalar(r, g, b), 2, 8, 0);
 		}
@@ -159,7 +155,7 @@ void OrbDetectorDescriptorTestInterface::DisplayResult()
 			keypointsMatrix.at<uint16_t>(featureIndex, 1) = GetYCoordinate(featuresVector, featureIndex);
 			for(int componentIndex = 0; componentIndex < ORB_DESCRIPTOR_SIZE; componentIndex++)
 				{
-				descriptorsMatrix.at<float>(featureIndex, componentIndex) = GetDescriptorComponent(featuresVector, featureIndex, componentIndex);
+				descriptorsMatrix.at<float>(featureIndex, componentIndex) = GetBinaryDescriptor(featuresVector, featureIndex)[componentIndex];
 				}
 			}
 		cv::FileStorage file("../../tests/Data/Images/OrbFeaturesScene1.yml", cv::FileStorage::WRITE);
@@ -175,18 +171,18 @@ void OrbDetectorDescriptorTestInterface::GetComponentRange(const VisualPointFeat
 		return;
 		}
 
-	min = GetDescriptorComponent(featuresVector, 0, componentIndex);
+	min = GetBinaryDescriptor(featuresVector, 0)[componentIndex];
 	max = min;
 	for(int featureIndex = 1; featureIndex < GetNumberOfPoints(featuresVector); featureIndex++)
 		{
-		ASSERT(GetNumberOfDescriptorComponents(featuresVector, featureIndex) == ORB_DESCRIPTOR_SIZE, "Orb descriptor size does not match size of received feature");
-		if (max < GetDescriptorComponent(featuresVector, featureIndex, componentIndex) )
+		ASSERT(GetNumberOfBinaryDescriptorBytes(featuresVector, featureIndex) == ORB_DESCRIPTOR_SIZE, "Orb descriptor size does not match size of received feature");
+		if (max < GetBinaryDescriptor(featuresVector, featureIndex)[componentIndex] )
 			{
-			max = GetDescriptorComponent(featuresVector, featureIndex, componentIndex);
+			max = GetBinaryDescriptor(featuresVector, featureIndex)[componentIndex];
 			}
-		if (min > GetDescriptorComponent(featuresVector, featureIndex, componentIndex) )
+		if (min > GetBinaryDescriptor(featuresVector, featureIndex)[componentIndex] )
 			{
-			min = GetDescriptorComponent(featuresVector, featureIndex, componentIndex);
+			min = GetBinaryDescriptor(featuresVector, featureIndex)[componentIndex];
 			}
 		}
 	if (max == min)
@@ -31,6 +31,7 @@
 #include <opencv2/highgui/highgui.hpp>
 #include <pcl/io/ply_io.h>
 #include <ctime>
+#include <Macros/TracingMacros.hpp>
 
 using namespace CDFF::DFPC;
 using namespace Converters;
@@ -40,6 +41,8 @@ using namespace FrameWrapper;
 using namespace VisualPointFeatureVector3DWrapper;
 using namespace SupportTypes;
 
+#define TRACE_FILE_PATH "Reconstruction3DTrace.json"
+
 #define DELETE_IF_NOT_NULL(pointer) \
 	if (pointer != NULL) \
 		{ \
@@ -132,6 +135,7 @@ void ReconstructionExecutor::ExecuteDfpc(const std::string& transformFilePath)
 
 	int successCounter = 0;
 	float processingTime = 0;
+	TRACE_START();
 	for(int imageIndex = 0; imageIndex < leftImageFileNamesList.size(); imageIndex++)
 		{
 		std::stringstream leftImageFilePath, rightImageFilePath;
@@ -163,6 +167,8 @@ void ReconstructionExecutor::ExecuteDfpc(const std::string& transformFilePath)
 		outputSuccess = dfpc->successOutput();
 		successCounter = (outputSuccess ? successCounter+1 : successCounter);
 		}
+	TRACE_STOP();
+	TRACE_EXPORT(TRACE_FILE_PATH);
 
 	PRINT_TO_LOG("Processing took (seconds): ", processingTime);
 	PRINT_TO_LOG("The reconstruction was successful on this number of images:", successCounter);
@@ -0,0 +1,82 @@
+/* --------------------------------------------------------------------------
+*
+* (C) Copyright …
+*
+* ---------------------------------------------------------------------------
+*/
+
+/*!
+ * @file DisparityRangeHelper.cpp
+ * @date 19/10/2026
+ */
+
+/*!
+ * @addtogroup CommonTests
+ *
+ * Testing the prediction of the disparity range from the previous disparities.
+ *
+ * @{
+ */
+
+/* --------------------------------------------------------------------------
+ *
+ * Includes
+ *
+ * --------------------------------------------------------------------------
+ */
+#include <catch.hpp>
+#include <Helpers/DisparityRangeHelper.hpp>
+#include <algorithm>
+#include <vector>
+
+using namespace Helpers;
+
+TEST_CASE( "Predicted range around the previous disparities", "[PredictAroundPrevious]" )
+	{
+	const DisparityRange fullRange = {0, 128};
+	std::vector<int16_t> disparities(100, 40 * 16);
+
+	DisparityRange range = PredictDisparityRange(disparities.data(), 10, 10, 10, 16, 0, fullRange, 4);
+	REQUIRE(range.minimumDisparity == 36);
+	REQUIRE(range.numberOfDisparities == 16);
+
+	//A range that would go beyond the full range is moved inside it
+	std::fill(disparities.begin(), disparities.end(), 125 * 16);
+	range = PredictDisparityRange(disparities.data(), 10, 10, 10, 16, 0, fullRange, 4);
+	REQUIRE(range.minimumDisparity == 112);
+	REQUIRE(range.numberOfDisparities == 16);
+	}
+
+TEST_CASE( "Full range with too few valid disparities", "[PredictFewValid]" )
+	{
+	const DisparityRange fullRange = {0, 128};
+	std::vector<int16_t> disparities(100, -16);
+	for (int index = 0; index < 4; index++)
+		{
+		disparities.at(index) = 40 * 16;
+		}
+
+	DisparityRange range = PredictDisparityRange(disparities.data(), 10, 10, 10, 16, 0, fullRange, 4);
+	REQUIRE(range.minimumDisparity == 0);
+	REQUIRE(range.numberOfDisparities == 128);
+	}
+
+TEST_CASE( "Outliers and row padding are ignored", "[PredictOutliers]" )
+	{
+	//Ten rows of twenty disparities, followed by five padding values that are not part of the band
+	const DisparityRange fullRange = {10, 64};
+	const int ROW_STRIDE = 25;
+	std::vector<int16_t> disparities(10 * ROW_STRIDE, 60 * 16);
+	for (int row = 0; row < 10; row++)
+		{
+		std::fill(disparities.begin() + row * ROW_STRIDE, disparities.begin() + row * ROW_STRIDE + 20, 30 * 16);
+		}
+	disparities.at(0) = 11 * 16;
+	disparities.at(1) = 90 * 16;
+
+	DisparityRange range = PredictDisparityRange(disparities.data(), 10, 20, ROW_STRIDE, 16, 0, fullRange, 0);
+	REQUIRE(range.minimumDisparity == 30);
+	REQUIRE(range.numberOfDisparities == 16);
+	}
+
+/** @} */
@@ -0,0 +1,301 @@
+/* --------------------------------------------------------------------------
+*
+* (C) Copyright …
+*
+* ---------------------------------------------------------------------------
+*/
+
+/*!
+ * @file RobustEstimator.cpp
+ * @date 19/10/2026
+ * @author Alessandro Bianco
+ */
+
+/*!
+ * @addtogroup CommonTests
+ *
+ * Testing the robust estimator on the fundamental matrix and the perspective-n-point problems.
+ *
+ *
+ * @{
+ */
+
+/* --------------------------------------------------------------------------
+ *
+ * Includes
+ *
+ * --------------------------------------------------------------------------
+ */
+#include <catch.hpp>
+#include <RobustEstimation/RobustEstimator.hpp>
+#include <RobustEstimation/FundamentalMatrixProblem.hpp>
+#include <RobustEstimation/PerspectiveNPointProblem.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include <random>
+#include <algorithm>
+#include <chrono>
+
+using namespace RobustEstimation;
+
+/* --------------------------------------------------------------------------
+ *
+ * Test Helpers
+ *
+ * --------------------------------------------------------------------------
+ */
+namespace
+	{
+	const int NUMBER_OF_CORRESPONDENCES = 500;
+
+	/**
+	 * Points in front of two cameras with a 640x480 image, the second camera is rotated and translated; the first numberOfOutliers correspondences are replaced
+	 * by random ones, so that they come in a block as the estimator must not rely on the order of the data. The source of a correspondence is in the first image
+	 * and the sink in the second.
+	 */
+	void CreateTwoViewCorrespondences(int numberOfOutliers, FundamentalMatrixProblem& problem, Eigen::Matrix3d& fundamentalMatrix, std::vector<float>& scores)
+		{
+		std::mt19937 generator(11);
+		std::uniform_real_distribution<double> lateralDistribution(-2, 2);
+		std::uniform_real_distribution<double> depthDistribution(4, 8);
+		std::uniform_real_distribution<double> columnDistribution(0, 640);
+		std::uniform_real_distribution<double> rowDistribution(0, 480);
+		std::normal_distribution<double> noiseDistribution(0, 0.3);
+
+		Eigen::Matrix3d cameraMatrix;
+		cameraMatrix << 500, 0, 320, 0, 500, 240, 0, 0, 1;
+		Eigen::Matrix3d rotation = Eigen::AngleAxisd(0.1, Eigen::Vector3d(0.2, 1, 0.1).normalized()).toRotationMatrix();
+		Eigen::Vector3d translation(-1, 0.2, 0.1);
+		Eigen::Matrix3d translationCrossProduct;
+		translationCrossProduct << 0, -translation(2), translation(1), translation(2), 0, -translation(0), -translation(1), translation(0), 0;
+		fundamentalMatrix = cameraMatrix.inverse().transpose() * translationCrossProduct * rotation * cameraMatrix.inverse();
+		fundamentalMatrix /= fundamentalMatrix.norm();
+
+		problem.ClearCorrespondences();
+		scores.clear();
+		for (int index = 0; index < NUMBER_OF_CORRESPONDENCES; index++)
+			{
+			Eigen::Vector3d point(lateralDistribution(generator), lateralDistribution(generator), depthDistribution(generator));
+			Eigen::Vector3d source = cameraMatrix * point;
+			Eigen::Vector3d sink = cameraMatrix * (rotation * point + translation);
+			if (index >= numberOfOutliers)
+				{
+				problem.AddCorrespondence(source(0) / source(2) + noiseDistribution(generator), source(1) / source(2) + noiseDistribution(generator),
+					sink(0) / sink(2) + noiseDistribution(generator), sink(1) / sink(2) + noiseDistribution(generator));
+				scores.push_back(0.5 + 0.5 * static_cast<float>(index % 2));
+				}
+			else
+				{
+				problem.AddCorrespondence(columnDistribution(generator), rowDistribution(generator), columnDistribution(generator), rowDistribution(generator));
+				scores.push_back(0.5 * static_cast<float>(index % 2));
+				}
+			}
+		}
+
+	double ComputeMatrixDistance(const std::vector<double>& model, const Eigen::Matrix3d& fundamentalMatrix)
+		{
+		Eigen::Matrix3d estimatedMatrix = Eigen::Map<const Eigen::Matrix<double, 3, 3, Eigen::RowMajor> >(model.data());
+		estimatedMatrix /= estimatedMatrix.norm();
+		return std::min( (estimatedMatrix - fundamentalMatrix).norm(), (estimatedMatrix + fundamentalMatrix).norm() );
+		}
+
+	int CountTrueInliers(const std::vector<int>& inliers, int numberOfOutliers)
+		{
+		return std::count_if(inliers.begin(), inliers.end(), [numberOfOutliers](int index) { return index >= numberOfOutliers; });
+		}
+
+	/**
+	 * Points in front of a camera with a 640x480 image, and their projections with noise; the projections of the first numberOfOutliers points are replaced by
+	 * random ones.
+	 */
+	void CreatePerspectiveProjections(int numberOfOutliers, PerspectiveNPointProblem& problem, Eigen::Matrix<double, 3, 4>& pose)
+		{
+		std::mt19937 generator(13);
+		std::uniform_real_distribution<double> lateralDistribution(-2, 2);
+		std::uniform_real_distribution<double> depthDistribution(4, 8);
+		std::uniform_real_distribution<double> columnDistribution(0, 640);
+		std::uniform_real_distribution<double> rowDistribution(0, 480);
+		std::normal_distribution<double> noiseDistribution(0, 0.5);
+
+		Eigen::Matrix3d rotation = Eigen::AngleAxisd(0.3, Eigen::Vector3d(1, -0.5, 0.2).normalized()).toRotationMatrix();
+		Eigen::Vector3d translation(0.5, -0.2, 1);
+		pose << rotation, translation;
+
+		problem.SetCameraMatrix(500, 510, 320, 240);
+		problem.ClearPoints();
+		for (int index = 0; index < NUMBER_OF_CORRESPONDENCES; index++)
+			{
+			Eigen::Vector3d cameraPoint(lateralDistribution(generator), lateralDistribution(generator), depthDistribution(generator));
+			Eigen::Vector3d point = rotation.transpose() * (cameraPoint - translation);
+			if (index >= numberOfOutliers)
+				{
+				problem.AddPoint(point(0), point(1), point(2), 500 * cameraPoint(0) / cameraPoint(2) + 320 + noiseDistribution(generator),
+					510 * cameraPoint(1) / cameraPoint(2) + 240 + noiseDistribution(generator));
+				}
+			else
+				{
+				problem.AddPoint(point(0), point(1), point(2), columnDistribution(generator), rowDistribution(generator));
+				}
+			}
+		}
+
+	void ValidatePose(const std::vector<double>& model, const Eigen::Matrix<double, 3, 4>& pose)
+		{
+		REQUIRE( model.size() == 12 );
+		Eigen::Matrix<double, 3, 4> estimatedPose = Eigen::Map<const Eigen::Matrix<double, 3, 4, Eigen::RowMajor> >(model.data());
+		REQUIRE( (estimatedPose.leftCols<3>() - pose.leftCols<3>()).norm() < 0.01 );
+		REQUIRE( (estimatedPose.col(3) - pose.col(3)).norm() < 0.05 );
+		}
+	}
+
+/* --------------------------------------------------------------------------
+ *
+ * Test Cases
+ *
+ * --------------------------------------------------------------------------
+ */
+TEST_CASE( "Fundamental matrix estimation with outliers", "[FundamentalMatrixWithOutliers]" )
+	{
+	const int numberOfOutliers = 150;
+	FundamentalMatrixProblem problem;
+	Eigen::Matrix3d fundamentalMatrix;
+	std::vector<float> scores;
+	CreateTwoViewCorrespondences(numberOfOutliers, problem, fundamentalMatrix, scores);
+
+	RobustEstimator::Options options = RobustEstimator::DEFAULT_OPTIONS;
+	options.inlierThreshold = 1.0;
+	options.numberOfThreads = 4;
+
+	bool useProsacList[2] = { false, true };
+	for (int useProsacIndex = 0; useProsacIndex < 2; useProsacIndex++)
+		{
+		options.useProsac = useProsacList[useProsacIndex];
+		RobustEstimator estimator;
+		estimator.SetOptions(options);
+
+		std::vector<double> model;
+		std::vector<int> inliers;
+		REQUIRE( estimator.Estimate(problem, scores, model, inliers) );
+		REQUIRE( model.size() == 9 );
+		REQUIRE( ComputeMatrixDistance(model, fundamentalMatrix) < 0.05 );
+		REQUIRE( CountTrueInliers(inliers, numberOfOutliers) >= 0.9 * (NUMBER_OF_CORRESPONDENCES - numberOfOutliers) );
+		REQUIRE( inliers.size() - CountTrueInliers(inliers, numberOfOutliers) < 0.05 * numberOfOutliers );
+		REQUIRE( std::is_sorted(inliers.begin(), inliers.end()) );
+
+		//With 70% inliers, 99% confidence needs a few tens of samples of seven correspondences
+		REQUIRE( estimator.GetNumberOfIterations() < options.maximumIterations / 10 );
+		}
+	}
+
+TEST_CASE( "Fundamental matrix estimation without SPRT", "[FundamentalMatrixWithoutSprt]" )
+	{
+	const int numberOfOutliers = 250;
+	FundamentalMatrixProblem problem;
+	Eigen::Matrix3d fundamentalMatrix;
+	std::vector<float> scores;
+	CreateTwoViewCorrespondences(numberOfOutliers, problem, fundamentalMatrix, scores);
+
+	RobustEstimator::Options options = RobustEstimator::DEFAULT_OPTIONS;
+	options.useSprt = false;
+	options.numberOfThreads = 1;
+	RobustEstimator estimator;
+	estimator.SetOptions(options);
+
+	std::vector<double> model;
+	std::vector<int> inliers;
+	REQUIRE( estimator.Estimate(problem, std::vector<float>(), model, inliers) );
+	REQUIRE( ComputeMatrixDistance(model, fundamentalMatrix) < 0.05 );
+	REQUIRE( CountTrueInliers(inliers, numberOfOutliers) >= 0.9 * (NUMBER_OF_CORRESPONDENCES - numberOfOutliers) );
+	REQUIRE( estimator.GetNumberOfRejectedModels() == 0 );
+	REQUIRE( estimator.GetNumberOfIterations() < options.maximumIterations );
+	}
+
+TEST_CASE( "Fundamental matrix estimation failure", "[FundamentalMatrixFailure]" )
+	{
+	FundamentalMatrixProblem problem;
+	for (int index = 0; index < 20; index++)
+		{
+		problem.AddCorrespondence(0, 0, 0, 0);
+		}
+
+	RobustEstimator estimator;
+	std::vector<double> model;
+	std::vector<int> inliers;
+	REQUIRE( estimator.Estimate(problem, std::vector<float>(), model, inliers) == false );
+	REQUIRE( inliers.size() == 0 );
+
+	problem.ClearCorrespondences();
+	problem.AddCorrespondence(0, 0, 1, 1);
+	REQUIRE( estimator.Estimate(problem, std::vector<float>(), model, inliers) == false );
+	}
+
+TEST_CASE( "Perspective-n-point estimation with outliers", "[PerspectiveNPointWithOutliers]" )
+	{
+	const int numberOfOutliers = 300;
+	PerspectiveNPointProblem problem;
+	Eigen::Matrix<double, 3, 4> pose;
+	CreatePerspectiveProjections(numberOfOutliers, problem, pose);
+
+	RobustEstimator::Options options = RobustEstimator::DEFAULT_OPTIONS;
+	options.inlierThreshold = 4.0;
+	options.numberOfThreads = 4;
+	RobustEstimator estimator;
+	estimator.SetOptions(options);
+
+	std::vector<double> model;
+	std::vector<int> inliers;
+	REQUIRE( estimator.Estimate(problem, std::vector<float>(), model, inliers) );
+	ValidatePose(model, pose);
+	REQUIRE( CountTrueInliers(inliers, numberOfOutliers) >= 0.9 * (NUMBER_OF_CORRESPONDENCES - numberOfOutliers) );
+	REQUIRE( inliers.size() - CountTrueInliers(inliers, numberOfOutliers) < 0.05 * numberOfOutliers );
+	REQUIRE( estimator.GetNumberOfIterations() < options.maximumIterations );
+	}
+
+TEST_CASE( "Perspective-n-point estimation with preemptive scoring", "[PerspectiveNPointPreemptive]" )
+	{
+	const int numberOfOutliers = 300;
+	PerspectiveNPointProblem problem;
+	Eigen::Matrix<double, 3, 4> pose;
+	CreatePerspectiveProjections(numberOfOutliers, problem, pose);
+
+	RobustEstimator::Options options = RobustEstimator::DEFAULT_OPTIONS;
+	options.inlierThreshold = 4.0;
+	options.numberOfThreads = 4;
+	options.preemptiveHypotheses = 200;
+	RobustEstimator estimator;
+	estimator.SetOptions(options);
+
+	std::vector<double> model;
+	std::vector<int> inliers;
+	REQUIRE( estimator.Estimate(problem, std::vector<float>(), model, inliers) );
+	ValidatePose(model, pose);
+	REQUIRE( CountTrueInliers(inliers, numberOfOutliers) >= 0.9 * (NUMBER_OF_CORRESPONDENCES - numberOfOutliers) );
+	REQUIRE( estimator.GetNumberOfIterations() == options.preemptiveHypotheses );
+	}
+
+TEST_CASE( "Estimation within a time budget", "[TimeBudget]" )
+	{
+	const int numberOfOutliers = 490;
+	PerspectiveNPointProblem problem;
+	Eigen::Matrix<double, 3, 4> pose;
+	CreatePerspectiveProjections(numberOfOutliers, problem, pose);
+
+	RobustEstimator::Options options = RobustEstimator::DEFAULT_OPTIONS;
+	options.inlierThreshold = 4.0;
+	options.maximumIterations = 1000000;
+	options.maximumTime = 0.05;
+	RobustEstimator estimator;
+	estimator.SetOptions(options);
+
+	std::vector<double> model;
+	std::vector<int> inliers;
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	estimator.Estimate(problem, std::vector<float>(), model, inliers);
+	double elapsedTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	REQUIRE( elapsedTime < 1.0 );
+	REQUIRE( estimator.GetNumberOfIterations() < options.maximumIterations );
+	}
+
+/** @} */
@@ -0,0 +1,104 @@
+/* --------------------------------------------------------------------------
+*
+* (C) Copyright …
+*
+* ---------------------------------------------------------------------------
+*/
+
+/*!
+ * @file ChromeTracer.cpp
+ * @date 19/10/2026
+ * @author Alessandro Bianco
+ */
+
+/*!
+ * @addtogroup CommonTests
+ *
+ * Testing the Chrome tracer.
+ *
+ *
+ * @{
+ */
+
+/* --------------------------------------------------------------------------
+ *
+ * Includes
+ *
+ * --------------------------------------------------------------------------
+ */
+#include <catch.hpp>
+#include <Tracers/ChromeTracer.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace Tracers;
+
+namespace
+	{
+	std::string ExportToString()
+		{
+		const std::string filePath = "ChromeTracerTest.json";
+		REQUIRE( ChromeTracer::Export(filePath) );
+
+		std::ifstream file(filePath.c_str());
+		std::stringstream stream;
+		stream << file.rdbuf();
+		return stream.str();
+		}
+
+	unsigned CountOccurrences(const std::string& text, const std::string& pattern)
+		{
+		unsigned counter = 0;
+		for(size_t position = text.find(pattern); position != std::string::npos; position = text.find(pattern, position + 1))
+			{
+			counter++;
+			}
+		return counter;
+		}
+	}
+
+TEST_CASE( "Events are recorded only while started", "[RecordWhileStarted]" )
+	{
+	ChromeTracer::Clear();
+	ChromeTracer::Stop();
+		{
+		ScopedTraceEvent event("NotRecorded", "Test");
+		}
+
+	ChromeTracer::Start();
+		{
+		ScopedTraceEvent event("Recorded", "Test");
+		}
+	ChromeTracer::Stop();
+
+	std::string trace = ExportToString();
+	REQUIRE( CountOccurrences(trace, "\"NotRecorded\"") == 0 );
+	REQUIRE( CountOccurrences(trace, "\"Recorded\"") == 1 );
+	REQUIRE( CountOccurrences(trace, "\"ph\":\"X\"") == 1 );
+	REQUIRE( trace.find("\"traceEvents\":[") != std::string::npos );
+	}
+
+TEST_CASE( "Events from several threads are exported", "[MultipleThreads]" )
+	{
+	ChromeTracer::Clear();
+	ChromeTracer::Start();
+
+	std::thread worker([]()
+		{
+		ScopedTraceEvent event("Worker", "Test");
+		});
+	worker.join();
+		{
+		ScopedTraceEvent event("Main", "Test");
+		}
+	ChromeTracer::Stop();
+
+	std::string trace = ExportToString();
+	REQUIRE( CountOccurrences(trace, "\"Worker\"") == 1 );
+	REQUIRE( CountOccurrences(trace, "\"Main\"") == 1 );
+	REQUIRE( CountOccurrences(trace, "\"thread_name\"") >= 2 );
+	}
+
+/** @} */
@@ -31,6 +31,9 @@
 #include <opencv2/highgui/highgui.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
 
+#include <algorithm>
+#include <vector>
+
 /* --------------------------------------------------------------------------
  *
  * Test Cases
@@ -136,4 +139,125 @@ TEST_CASE( "Call to process (Disparity Image)", "[process]" )
 }
 
 
+TEST_CASE( "Call to process with parallel bands (Disparity Image)", "[process]" )
+{
+    // Loads two grayscaled rectified images
+    cv::Mat cvLeftImage = cv::imread("../tests/Data/Images/MinnieStereo/MinnieRectLeft.png", cv::IMREAD_GRAYSCALE);
+    cv::Mat cvRightImage = cv::imread("../tests/Data/Images/MinnieStereo/MinnieRectRight.png", cv::IMREAD_GRAYSCALE);
+
+    // Initialise a frame pair with the image data only
+    asn1SccFramePair *framePair = new asn1SccFramePair();
+    asn1SccFramePair_Initialize(framePair);
+    framePair->msgVersion = frame_Version;
+    framePair->baseline = 0.270268442641143;
+    for(int side = 0; side < 2; side++)
+    {
+        const cv::Mat &cvImage = (side == 0) ? cvLeftImage : cvRightImage;
+        asn1SccArray3D &imageOnly = (side == 0) ? framePair->left.data : framePair->right.data;
+        imageOnly.msgVersion = array3D_Version;
+        imageOnly.rows = static_cast<asn1SccT_UInt32>(cvImage.rows);
+        imageOnly.cols = static_cast<asn1SccT_UInt32>(cvImage.cols);
+        imageOnly.channels = static_cast<asn1SccT_UInt32>(cvImage.channels());
+        imageOnly.depth = static_cast<asn1SccArray3D_depth_t>(cvImage.depth());
+        imageOnly.rowSize = cvImage.step[0];
+        imageOnly.data.nCount = static_cast<int>(imageOnly.rows * imageOnly.rowSize);
+        memcpy(imageOnly.data.arr, cvImage.data, static_cast<size_t>(imageOnly.data.nCount));
+    }
+
+    // Block matching is local, so bands with enough overlap give the same disparities as the whole image
+    CDFF::DFN::DisparityImage::DisparityImage *disparityImage = new CDFF::DFN::DisparityImage::DisparityImage();
+    disparityImage->parameters.stereoMatcher.algorithm = 0;
+    disparityImage->parameters.stereoMatcher.numDisparities = 64;
+    disparityImage->configure();
+    disparityImage->framePairInput(*framePair);
+    disparityImage->process();
+    const asn1SccFrame &output = disparityImage->disparityOutput();
+    std::vector<uint8_t> fullImageDisparity(output.data.data.arr, output.data.data.arr + output.data.data.nCount);
+
+    disparityImage->parameters.bands.numBands = 4;
+    disparityImage->configure();
+    disparityImage->process();
+    REQUIRE( output.data.rows == framePair->left.data.rows );
+    REQUIRE( output.data.data.nCount == static_cast<int>(fullImageDisparity.size()) );
+    REQUIRE( std::equal(fullImageDisparity.begin(), fullImageDisparity.end(), output.data.data.arr) );
+
+    // Semi global matching runs on bands too
+    disparityImage->parameters.stereoMatcher.algorithm = 1;
+    disparityImage->configure();
+    disparityImage->process();
+    REQUIRE( output.data.rows == framePair->left.data.rows );
+    REQUIRE( output.data.cols == framePair->left.data.cols );
+    REQUIRE( output.data.data.nCount == static_cast<int>(output.data.rowSize * output.data.rows) );
+
+    // Cleanup
+    delete(framePair);
+    delete(disparityImage);
+}
+TEST_CASE( "Call to process with a predicted disparity range (Disparity Image)", "[process]" )
+{
+    // Loads two grayscaled rectified images
+    cv::Mat cvLeftImage = cv::imread("../tests/Data/Images/MinnieStereo/MinnieRectLeft.png", cv::IMREAD_GRAYSCALE);
+    cv::Mat cvRightImage = cv::imread("../tests/Data/Images/MinnieStereo/MinnieRectRight.png", cv::IMREAD_GRAYSCALE);
+
+    // Initialise a frame pair with the image data only
+    asn1SccFramePair *framePair = new asn1SccFramePair();
+    asn1SccFramePair_Initialize(framePair);
+    framePair->msgVersion = frame_Version;
+    framePair->baseline = 0.270268442641143;
+    for(int side = 0; side < 2; side++)
+    {
+        const cv::Mat &cvImage = (side == 0) ? cvLeftImage : cvRightImage;
+        asn1SccArray3D &imageOnly = (side == 0) ? framePair->left.data : framePair->right.data;
+        imageOnly.msgVersion = array3D_Version;
+        imageOnly.rows = static_cast<asn1SccT_UInt32>(cvImage.rows);
+        imageOnly.cols = static_cast<asn1SccT_UInt32>(cvImage.cols);
+        imageOnly.channels = static_cast<asn1SccT_UInt32>(cvImage.channels());
+        imageOnly.depth = static_cast<asn1SccArray3D_depth_t>(cvImage.depth());
+        imageOnly.rowSize = cvImage.step[0];
+        imageOnly.data.nCount = static_cast<int>(imageOnly.rows * imageOnly.rowSize);
+        memcpy(imageOnly.data.arr, cvImage.data, static_cast<size_t>(imageOnly.data.nCount));
+    }
+
+    // The first frame searches the whole range
+    CDFF::DFN::DisparityImage::DisparityImage *disparityImage = new CDFF::DFN::DisparityImage::DisparityImage();
+    disparityImage->parameters.stereoMatcher.algorithm = 0;
+    disparityImage->parameters.stereoMatcher.numDisparities = 128;
+    disparityImage->parameters.bands.numBands = 4;
+    disparityImage->parameters.temporal.usePrediction = true;
+    disparityImage->parameters.temporal.refreshPeriod = 10;
+    disparityImage->configure();
+    disparityImage->framePairInput(*framePair);
+    disparityImage->process();
+    const asn1SccFrame &output = disparityImage->disparityOutput();
+    cv::Mat fullRangeDisparity = cv::Mat(static_cast<int>(output.data.rows), static_cast<int>(output.data.cols), CV_16S, const_cast<asn1SccFrame&>(output).data.data.arr, output.data.rowSize).clone();
+
+    // The same pair again, each band searches only around its previous disparities
+    disparityImage->process();
+    cv::Mat predictedRangeDisparity = cv::Mat(static_cast<int>(output.data.rows), static_cast<int>(output.data.cols), CV_16S, const_cast<asn1SccFrame&>(output).data.data.arr, output.data.rowSize);
+    REQUIRE( predictedRangeDisparity.size() == fullRangeDisparity.size() );
+
+    // Where both searches found a match, the matches agree unless the full range match was an outlier of the band
+    int bothValid = 0;
+    int agreeing = 0;
+    for(int row = 0; row < fullRangeDisparity.rows; row++)
+    {
+        for(int col = 0; col < fullRangeDisparity.cols; col++)
+        {
+            short fullRange = fullRangeDisparity.at<short>(row, col);
+            short predictedRange = predictedRangeDisparity.at<short>(row, col);
+            if(fullRange >= 0 && predictedRange >= 0)
+            {
+                bothValid++;
+                agreeing += (std::abs(fullRange - predictedRange) <= 16) ? 1 : 0;
+            }
+        }
+    }
+    REQUIRE( bothValid > 0 );
+    REQUIRE( agreeing >= 0.9 * bothValid );
+
+    // Cleanup
+    delete(framePair);
+    delete(disparityImage);
+}
+
 /** @} */
@@ -31,6 +31,8 @@
 #include <opencv2/highgui/highgui.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
 
+#include <cmath>
+
 /* --------------------------------------------------------------------------
  *
  * Test Cases
@@ -97,4 +99,73 @@ TEST_CASE( "Call to process (Disparity To PointCloud)", "[process]" )
 }
 
 
+TEST_CASE( "Call to process with invalid pixels and subsampling (Disparity To PointCloud)", "[process]" )
+{
+	// A 16 bit disparity image of 7 rows and 11 columns, every fifth pixel is invalid and the others have disparity 10
+	asn1SccFrame *dispImage = new asn1SccFrame();
+	asn1SccFrame_Initialize(dispImage);
+	dispImage->msgVersion = frame_Version;
+	dispImage->metadata.msgVersion = frame_Version;
+	dispImage->metadata.status = asn1Sccstatus_VALID;
+	dispImage->metadata.pixelModel = asn1Sccpix_DISP;
+	dispImage->metadata.mode = asn1Sccmode_UNDEF;
+	dispImage->metadata.pixelCoeffs.arr[0] = 1.0 / 16.0;
+	dispImage->metadata.pixelCoeffs.arr[1] = 0;
+	dispImage->metadata.pixelCoeffs.arr[2] = 0.2;
+
+	dispImage->intrinsic.msgVersion = frame_Version;
+	dispImage->intrinsic.cameraModel = asn1Scccam_PINHOLE;
+	dispImage->intrinsic.cameraMatrix.arr[0].arr[0] = 500;
+	dispImage->intrinsic.cameraMatrix.arr[0].arr[2] = 5;
+	dispImage->intrinsic.cameraMatrix.arr[1].arr[1] = 400;
+	dispImage->intrinsic.cameraMatrix.arr[1].arr[2] = 3;
+	dispImage->intrinsic.cameraMatrix.arr[2].arr[2] = 1;
+
+	cv::Mat cvDispImage(7, 11, CV_16SC1);
+	for (int pixel = 0; pixel < 77; pixel++)
+	{
+		cvDispImage.at<int16_t>(pixel / 11, pixel % 11) = (pixel % 5 == 0) ? -16 : 160;
+	}
+	asn1SccArray3D &imageOnly = dispImage->data;
+	imageOnly.msgVersion = array3D_Version;
+	imageOnly.rows = static_cast<asn1SccT_UInt32>(cvDispImage.rows);
+	imageOnly.cols = static_cast<asn1SccT_UInt32>(cvDispImage.cols);
+	imageOnly.channels = static_cast<asn1SccT_UInt32>(cvDispImage.channels());
+	imageOnly.depth = static_cast<asn1SccArray3D_depth_t>(cvDispImage.depth());
+	imageOnly.rowSize = cvDispImage.step[0];
+	imageOnly.data.nCount = static_cast<int>(imageOnly.rows * imageOnly.rowSize);
+	memcpy(imageOnly.data.arr, cvDispImage.data, static_cast<size_t>(imageOnly.data.nCount));
+
+	CDFF::DFN::DisparityToPointCloud::DisparityToPointCloud *disparityToPointCloud = new CDFF::DFN::DisparityToPointCloud::DisparityToPointCloud();
+	disparityToPointCloud->dispImageInput(*dispImage);
+	const asn1SccPointcloud &output = disparityToPointCloud->pointCloudOutput();
+
+	// Organized output, invalid pixels are NaN
+	disparityToPointCloud->configure();
+	disparityToPointCloud->process();
+	REQUIRE(output.metadata.isOrdered == true);
+	REQUIRE(output.data.points.nCount == 77);
+	REQUIRE(std::isnan(output.data.points.arr[0].arr[2]));
+	REQUIRE(output.data.points.arr[12].arr[0] == Approx(-0.08));
+	REQUIRE(output.data.points.arr[12].arr[1] == Approx(-0.05));
+	REQUIRE(output.data.points.arr[12].arr[2] == Approx(10));
+
+	// Every other row and column, invalid pixels dropped: 5 of the 24 sampled pixels are invalid
+	disparityToPointCloud->parameters.organized = false;
+	disparityToPointCloud->parameters.stride = 2;
+	disparityToPointCloud->configure();
+	disparityToPointCloud->process();
+	REQUIRE(output.metadata.isOrdered == false);
+	REQUIRE(output.data.points.nCount == 19);
+	REQUIRE(output.metadata.width == 19);
+	for (int point = 0; point < output.data.points.nCount; point++)
+	{
+		REQUIRE(output.data.points.arr[point].arr[2] == Approx(10));
+	}
+
+	// Cleanup
+	delete(dispImage);
+	delete(disparityToPointCloud);
+}
+
 /** @} */
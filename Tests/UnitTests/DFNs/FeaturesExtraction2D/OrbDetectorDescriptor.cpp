@@ -61,6 +61,55 @@ TEST_CASE( "Call to process (ORB)", "[process]" )
 	const VisualPointFeatureVector2D& output = orb->featuresOutput();
 }
 
+TEST_CASE( "Call to process with grid detection (ORB)", "[process]" )
+{
+	// Prepare input data: a faint texture over the whole image and a strong texture in the top left corner only
+	cv::Mat inputImage(500, 500, CV_8UC1);
+	cv::randu(inputImage, cv::Scalar(100), cv::Scalar(130));
+	cv::Mat strongTexture = inputImage( cv::Rect(0, 0, 150, 150) );
+	cv::randu(strongTexture, cv::Scalar(0), cv::Scalar(255));
+	MatToFrameConverter matToFrame;
+	FrameConstPtr inputFrame = matToFrame.Convert(inputImage);
+
+	// Instantiate DFN
+	OrbDetectorDescriptor* orb = new OrbDetectorDescriptor;
+
+	// Setup DFN
+	orb->setConfigurationFile("../tests/ConfigurationFiles/DFNs/FeaturesExtraction2D/OrbDetectorDescriptor_Conf2.yaml");
+	orb->configure();
+
+	// Send input data to DFN
+	orb->frameInput(*inputFrame);
+
+	// Run DFN
+	orb->process();
+
+	// Query output data from DFN
+	const VisualPointFeatureVector2D& output = orb->featuresOutput();
+
+	// Check output, the cells of the faint texture use the minimum threshold so most keypoints lie outside the strong texture
+	REQUIRE( GetNumberOfPoints(output) > 0 );
+	REQUIRE( GetNumberOfPoints(output) <= 500 );
+	int outsidePoints = 0;
+	for (int pointIndex = 0; pointIndex < GetNumberOfPoints(output); pointIndex++)
+	{
+		if (GetXCoordinate(output, pointIndex) >= 150 || GetYCoordinate(output, pointIndex) >= 150)
+		{
+			outsidePoints++;
+		}
+	}
+	REQUIRE( outsidePoints > GetNumberOfPoints(output) / 2 );
+	REQUIRE( GetDescriptorType(output) == BINARY_DESCRIPTORS );
+	REQUIRE( GetNumberOfBinaryDescriptorBytes(output, 0) == 32 );
+
+	// A second frame of the same size reuses the pyramid and gives the same features
+	int numberOfPoints = GetNumberOfPoints(output);
+	orb->process();
+	REQUIRE( GetNumberOfPoints(orb->featuresOutput()) == numberOfPoints );
+
+	delete orb;
+}
+
 TEST_CASE( "Call to configure (ORB)", "[configure]" )
 {
 	// Instantiate DFN
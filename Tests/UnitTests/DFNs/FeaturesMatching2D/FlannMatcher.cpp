@@ -43,6 +43,55 @@ using namespace FrameWrapper;
 using namespace VisualPointFeatureVector2DWrapper;
 using namespace CorrespondenceMap2DWrapper;
 
+/* --------------------------------------------------------------------------
+ *
+ * Helpers
+ *
+ * --------------------------------------------------------------------------
+ */
+
+/**
+ * Ten points with distinct descriptors; the sink point in row y has the descriptor of the source point in row (y + shift) % 10, slightly perturbed.
+ * The extra sink points have descriptors far from every source descriptor.
+ */
+static void CreateShiftedFeatures(VisualPointFeatureVector2D& sourceFeatures, VisualPointFeatureVector2D& sinkFeatures, int shift, int numberOfExtraPoints)
+{
+	ClearPoints(sourceFeatures);
+	ClearPoints(sinkFeatures);
+	for (int pointIndex = 0; pointIndex < 10; pointIndex++)
+	{
+		int sourceIndex = (pointIndex + shift) % 10;
+		AddPoint(sourceFeatures, 10, pointIndex);
+		AddPoint(sinkFeatures, 20, pointIndex);
+		for (int componentIndex = 0; componentIndex < 8; componentIndex++)
+		{
+			AddDescriptorComponent(sourceFeatures, pointIndex, (componentIndex == pointIndex % 8) ? 1 + pointIndex : 0);
+			AddDescriptorComponent(sinkFeatures, pointIndex, ((componentIndex == sourceIndex % 8) ? 1 + sourceIndex : 0) + 0.001);
+		}
+	}
+	for (int pointIndex = 10; pointIndex < 10 + numberOfExtraPoints; pointIndex++)
+	{
+		AddPoint(sinkFeatures, 20, pointIndex);
+		for (int componentIndex = 0; componentIndex < 8; componentIndex++)
+		{
+			AddDescriptorComponent(sinkFeatures, pointIndex, 100 * pointIndex + componentIndex);
+		}
+	}
+}
+
+/**
+ * Every match pairs the source point in row y with the sink point in row (y + 10 - shift) % 10, the one carrying its descriptor.
+ */
+static void RequireShiftedMatches(const CorrespondenceMap2D& matches, int shift, int expectedNumberOfCorrespondences)
+{
+	REQUIRE( GetNumberOfCorrespondences(matches) == expectedNumberOfCorrespondences );
+	for (int correspondenceIndex = 0; correspondenceIndex < expectedNumberOfCorrespondences; correspondenceIndex++)
+	{
+		int sourceRow = static_cast<int>( GetSource(matches, correspondenceIndex).y );
+		REQUIRE( GetSink(matches, correspondenceIndex).y == (sourceRow + 10 - shift) % 10 );
+	}
+}
+
 /* --------------------------------------------------------------------------
  *
  * Test Cases
@@ -112,6 +161,88 @@ TEST_CASE( "Call to process (FLANN registration)", "[process]" )
 	delete flann;
 }
 
+TEST_CASE( "Call to process with a cached index (FLANN registration)", "[process]" )
+{
+	// Prepare input data, ten points with distinct descriptors
+	VisualPointFeatureVector2DPtr sourceFeatures = NewVisualPointFeatureVector2D();
+	VisualPointFeatureVector2DPtr sinkFeatures = NewVisualPointFeatureVector2D();
+	for (int pointIndex = 0; pointIndex < 10; pointIndex++)
+	{
+		AddPoint(*sourceFeatures, 10, pointIndex);
+		AddPoint(*sinkFeatures, 20, pointIndex);
+		for (int componentIndex = 0; componentIndex < 8; componentIndex++)
+		{
+			float component = (componentIndex == pointIndex % 8) ? 1 + pointIndex : 0;
+			AddDescriptorComponent(*sourceFeatures, pointIndex, component);
+			AddDescriptorComponent(*sinkFeatures, pointIndex, component + 0.001);
+		}
+	}
+
+	// Instantiate DFN
+	FlannMatcher* flann = new FlannMatcher;
+	flann->sourceFeaturesInput(*sourceFeatures);
+	flann->sinkFeaturesInput(*sinkFeatures);
+
+	// The second call finds the index of the first one, the matches are the same
+	flann->process();
+	const CorrespondenceMap2D& output = flann->matchesOutput();
+	int numberOfCorrespondences = GetNumberOfCorrespondences(output);
+	REQUIRE( numberOfCorrespondences > 0 );
+	flann->process();
+	REQUIRE( GetNumberOfCorrespondences(output) == numberOfCorrespondences );
+	for (int correspondenceIndex = 0; correspondenceIndex < numberOfCorrespondences; correspondenceIndex++)
+	{
+		REQUIRE( GetSource(output, correspondenceIndex).y == GetSink(output, correspondenceIndex).y );
+	}
+
+	// Cleanup
+	delete flann;
+	delete sourceFeatures;
+	delete sinkFeatures;
+}
+
+TEST_CASE( "Call to process with changing sink descriptors (FLANN registration)", "[process]" )
+{
+	VisualPointFeatureVector2DPtr sourceFeatures = NewVisualPointFeatureVector2D();
+	VisualPointFeatureVector2DPtr sinkFeatures = NewVisualPointFeatureVector2D();
+	CreateShiftedFeatures(*sourceFeatures, *sinkFeatures, 0, 0);
+
+	FlannMatcher* flann = new FlannMatcher;
+	flann->sourceFeaturesInput(*sourceFeatures);
+	flann->sinkFeaturesInput(*sinkFeatures);
+	flann->process();
+	const CorrespondenceMap2D& output = flann->matchesOutput();
+	int numberOfCorrespondences = GetNumberOfCorrespondences(output);
+	REQUIRE( numberOfCorrespondences > 0 );
+	RequireShiftedMatches(output, 0, numberOfCorrespondences);
+
+	// Same number and size of sink descriptors, in a different order: the index of the first call must not be reused
+	CreateShiftedFeatures(*sourceFeatures, *sinkFeatures, 3, 0);
+	flann->sourceFeaturesInput(*sourceFeatures);
+	flann->sinkFeaturesInput(*sinkFeatures);
+	flann->process();
+	RequireShiftedMatches(output, 3, numberOfCorrespondences);
+
+	// More sink descriptors, the extra ones are never the nearest
+	CreateShiftedFeatures(*sourceFeatures, *sinkFeatures, 5, 2);
+	flann->sourceFeaturesInput(*sourceFeatures);
+	flann->sinkFeaturesInput(*sinkFeatures);
+	flann->process();
+	RequireShiftedMatches(output, 5, numberOfCorrespondences);
+
+	// The first sink descriptors again, their index is still in the cache
+	CreateShiftedFeatures(*sourceFeatures, *sinkFeatures, 0, 0);
+	flann->sourceFeaturesInput(*sourceFeatures);
+	flann->sinkFeaturesInput(*sinkFeatures);
+	flann->process();
+	RequireShiftedMatches(output, 0, numberOfCorrespondences);
+
+	// Cleanup
+	delete flann;
+	delete sourceFeatures;
+	delete sinkFeatures;
+}
+
 TEST_CASE( "Call to configure (FLANN registration)", "[configure]" )
 {
 	// Instantiate DFN
@@ -0,0 +1,417 @@
+/**
+ * @author Alessandro Bianco
+ */
+
+/**
+ * Unit tests for the DFN HammingMatcher
+ */
+
+/**
+ * @addtogroup DFNsTest
+ * @{
+ */
+
+#include <catch.hpp>
+#include <FeaturesMatching2D/HammingMatcher.hpp>
+#include <Types/CPP/VisualPointFeatureVector2D.hpp>
+#include <Types/CPP/CorrespondenceMap2D.hpp>
+
+#include <random>
+#include <cmath>
+
+using namespace CDFF::DFN::FeaturesMatching2D;
+using namespace VisualPointFeatureVector2DWrapper;
+using namespace CorrespondenceMap2DWrapper;
+
+namespace
+{
+	const int NUMBER_OF_POINTS = 300;
+	const int DESCRIPTOR_BYTES = 32;
+
+	/**
+	 * The sink point matching the source point at (i, 0) is at (i, 1) and is stored at a shuffled index, its descriptor differs from the source one in 10 random bits.
+	 */
+	void CreateFeatures(VisualPointFeatureVector2D& sourceFeatures, VisualPointFeatureVector2D& sinkFeatures)
+	{
+		std::mt19937 generator(3);
+		ClearPoints(sourceFeatures);
+		ClearPoints(sinkFeatures);
+		SetDescriptorType(sourceFeatures, BINARY_DESCRIPTORS);
+		SetDescriptorType(sinkFeatures, BINARY_DESCRIPTORS);
+
+		std::vector<uint8_t> descriptorsList(NUMBER_OF_POINTS * DESCRIPTOR_BYTES);
+		for (int pointIndex = 0; pointIndex < NUMBER_OF_POINTS; pointIndex++)
+		{
+			uint8_t* descriptor = descriptorsList.data() + pointIndex * DESCRIPTOR_BYTES;
+			for (int byte = 0; byte < DESCRIPTOR_BYTES; byte++)
+			{
+				descriptor[byte] = static_cast<uint8_t>( generator() );
+			}
+			AddPoint(sourceFeatures, pointIndex, 0);
+			SetBinaryDescriptor(sourceFeatures, pointIndex, descriptor, DESCRIPTOR_BYTES);
+		}
+
+		for (int sinkIndex = 0; sinkIndex < NUMBER_OF_POINTS; sinkIndex++)
+		{
+			int pointIndex = (sinkIndex * 7) % NUMBER_OF_POINTS;
+			uint8_t descriptor[DESCRIPTOR_BYTES];
+			std::copy(descriptorsList.data() + pointIndex * DESCRIPTOR_BYTES, descriptorsList.data() + (pointIndex + 1) * DESCRIPTOR_BYTES, descriptor);
+			for (int flip = 0; flip < 10; flip++)
+			{
+				int bit = generator() % (DESCRIPTOR_BYTES * 8);
+				descriptor[bit / 8] ^= static_cast<uint8_t>(1 << (bit % 8));
+			}
+			AddPoint(sinkFeatures, pointIndex, 1);
+			SetBinaryDescriptor(sinkFeatures, sinkIndex, descriptor, DESCRIPTOR_BYTES);
+		}
+	}
+
+	/**
+	 * Rectified stereo layout: the sink point matching the source point (x, y) is at (x - 5, y) and its descriptor differs from the source one in 10 random bits;
+	 * an exact copy of each sink descriptor is also placed 50 rows below, where only a search unconstrained by the rows can pick it.
+	 */
+	void CreateStereoFeatures(VisualPointFeatureVector2D& sourceFeatures, VisualPointFeatureVector2D& sinkFeatures)
+	{
+		std::mt19937 generator(5);
+		ClearPoints(sourceFeatures);
+		ClearPoints(sinkFeatures);
+		SetDescriptorType(sourceFeatures, BINARY_DESCRIPTORS);
+		SetDescriptorType(sinkFeatures, BINARY_DESCRIPTORS);
+
+		for (int pointIndex = 0; pointIndex < NUMBER_OF_POINTS; pointIndex++)
+		{
+			int x = 10 + (pointIndex % 30) * 20;
+			int y = 10 + (pointIndex / 30) * 40;
+			uint8_t descriptor[DESCRIPTOR_BYTES];
+			for (int byte = 0; byte < DESCRIPTOR_BYTES; byte++)
+			{
+				descriptor[byte] = static_cast<uint8_t>( generator() );
+			}
+			AddPoint(sourceFeatures, x, y);
+			SetBinaryDescriptor(sourceFeatures, pointIndex, descriptor, DESCRIPTOR_BYTES);
+
+			for (int flip = 0; flip < 10; flip++)
+			{
+				int bit = generator() % (DESCRIPTOR_BYTES * 8);
+				descriptor[bit / 8] ^= static_cast<uint8_t>(1 << (bit % 8));
+			}
+			AddPoint(sinkFeatures, x - 5, y);
+			SetBinaryDescriptor(sinkFeatures, 2 * pointIndex, descriptor, DESCRIPTOR_BYTES);
+			AddPoint(sinkFeatures, x - 5, y + 50);
+			SetBinaryDescriptor(sinkFeatures, 2 * pointIndex + 1, descriptor, DESCRIPTOR_BYTES);
+		}
+	}
+
+	/**
+	 * Moving camera layout: the sink point matching the source point (x, y) is at (x + 7, y + 13) and its descriptor differs from the source one in 10 random bits.
+	 * Two more source points carry an exact copy of the sink descriptor: a rival at (x + 1, y), close enough to the true source that the sink prefers it in the cross check,
+	 * and a decoy at (x + 14, y + 26), which only a cross check that applies the offset in the wrong direction would reach from the sink.
+	 */
+	void CreateMovedFeatures(VisualPointFeatureVector2D& sourceFeatures, VisualPointFeatureVector2D& sinkFeatures)
+	{
+		std::mt19937 generator(7);
+		ClearPoints(sourceFeatures);
+		ClearPoints(sinkFeatures);
+		SetDescriptorType(sourceFeatures, BINARY_DESCRIPTORS);
+		SetDescriptorType(sinkFeatures, BINARY_DESCRIPTORS);
+
+		for (int pointIndex = 0; pointIndex < NUMBER_OF_POINTS; pointIndex++)
+		{
+			int x = 10 + (pointIndex % 30) * 20;
+			int y = 10 + (pointIndex / 30) * 40;
+			uint8_t descriptor[DESCRIPTOR_BYTES];
+			for (int byte = 0; byte < DESCRIPTOR_BYTES; byte++)
+			{
+				descriptor[byte] = static_cast<uint8_t>( generator() );
+			}
+			AddPoint(sourceFeatures, x, y);
+			SetBinaryDescriptor(sourceFeatures, 3 * pointIndex, descriptor, DESCRIPTOR_BYTES);
+
+			for (int flip = 0; flip < 10; flip++)
+			{
+				int bit = generator() % (DESCRIPTOR_BYTES * 8);
+				descriptor[bit / 8] ^= static_cast<uint8_t>(1 << (bit % 8));
+			}
+			AddPoint(sinkFeatures, x + 7, y + 13);
+			SetBinaryDescriptor(sinkFeatures, pointIndex, descriptor, DESCRIPTOR_BYTES);
+			AddPoint(sourceFeatures, x + 1, y);
+			SetBinaryDescriptor(sourceFeatures, 3 * pointIndex + 1, descriptor, DESCRIPTOR_BYTES);
+			AddPoint(sourceFeatures, x + 14, y + 26);
+			SetBinaryDescriptor(sourceFeatures, 3 * pointIndex + 2, descriptor, DESCRIPTOR_BYTES);
+		}
+	}
+
+	/**
+	 * General two view layout: the source camera has focal length 500 and principal point (320, 240), the sink camera is rotated by 2 degrees about the x axis and 4 degrees about the y axis
+	 * and translated by (-0.3, 0.02, 0.04); the source point (x, y) is seen at depth between 4 and 5.8, its sink point is the rounded projection in the sink camera and its descriptor
+	 * differs from the source one in 10 random bits. An exact copy of each sink descriptor is also placed 10 rows below, more than 9 pixels away from the epipolar line.
+	 * The expected sink point of the source point at index i is stored at index i of expectedSinks.
+	 * The matching fundamental matrix, normalised so that its last element is 1, is in HammingMatcher_Conf3.yaml.
+	 */
+	void CreateEpipolarFeatures(VisualPointFeatureVector2D& sourceFeatures, VisualPointFeatureVector2D& sinkFeatures, std::vector<BaseTypesWrapper::Point2D>& expectedSinks)
+	{
+		const double focalLength = 500;
+		const double principalPointX = 320;
+		const double principalPointY = 240;
+		const double angleX = 2 * M_PI / 180;
+		const double angleY = 4 * M_PI / 180;
+
+		std::mt19937 generator(9);
+		ClearPoints(sourceFeatures);
+		ClearPoints(sinkFeatures);
+		SetDescriptorType(sourceFeatures, BINARY_DESCRIPTORS);
+		SetDescriptorType(sinkFeatures, BINARY_DESCRIPTORS);
+		expectedSinks.resize(NUMBER_OF_POINTS);
+
+		for (int pointIndex = 0; pointIndex < NUMBER_OF_POINTS; pointIndex++)
+		{
+			int x = 10 + (pointIndex % 30) * 20;
+			int y = 40 + (pointIndex / 30) * 40;
+			double depth = 4 + (pointIndex % 7) * 0.3;
+			double sourceX = depth * (x - principalPointX) / focalLength;
+			double sourceY = depth * (y - principalPointY) / focalLength;
+
+			double rotatedY = std::cos(angleX) * sourceY - std::sin(angleX) * depth;
+			double rotatedZ = std::sin(angleX) * sourceY + std::cos(angleX) * depth;
+			double sinkX = std::cos(angleY) * sourceX + std::sin(angleY) * rotatedZ - 0.3;
+			double sinkY = rotatedY + 0.02;
+			double sinkZ = -std::sin(angleY) * sourceX + std::cos(angleY) * rotatedZ + 0.04;
+			expectedSinks.at(pointIndex).x = std::lround(principalPointX + focalLength * sinkX / sinkZ);
+			expectedSinks.at(pointIndex).y = std::lround(principalPointY + focalLength * sinkY / sinkZ);
+
+			uint8_t descriptor[DESCRIPTOR_BYTES];
+			for (int byte = 0; byte < DESCRIPTOR_BYTES; byte++)
+			{
+				descriptor[byte] = static_cast<uint8_t>( generator() );
+			}
+			AddPoint(sourceFeatures, x, y);
+			SetBinaryDescriptor(sourceFeatures, pointIndex, descriptor, DESCRIPTOR_BYTES);
+
+			for (int flip = 0; flip < 10; flip++)
+			{
+				int bit = generator() % (DESCRIPTOR_BYTES * 8);
+				descriptor[bit / 8] ^= static_cast<uint8_t>(1 << (bit % 8));
+			}
+			AddPoint(sinkFeatures, expectedSinks.at(pointIndex).x, expectedSinks.at(pointIndex).y);
+			SetBinaryDescriptor(sinkFeatures, 2 * pointIndex, descriptor, DESCRIPTOR_BYTES);
+			AddPoint(sinkFeatures, expectedSinks.at(pointIndex).x, expectedSinks.at(pointIndex).y + 10);
+			SetBinaryDescriptor(sinkFeatures, 2 * pointIndex + 1, descriptor, DESCRIPTOR_BYTES);
+		}
+	}
+
+	int CountCorrectMatches(const CorrespondenceMap2D& matches)
+	{
+		int correctMatches = 0;
+		for (int correspondenceIndex = 0; correspondenceIndex < GetNumberOfCorrespondences(matches); correspondenceIndex++)
+		{
+			if (GetSource(matches, correspondenceIndex).x == GetSink(matches, correspondenceIndex).x)
+			{
+				correctMatches++;
+			}
+		}
+		return correctMatches;
+	}
+
+	int CountCorrectStereoMatches(const CorrespondenceMap2D& matches)
+	{
+		int correctMatches = 0;
+		for (int correspondenceIndex = 0; correspondenceIndex < GetNumberOfCorrespondences(matches); correspondenceIndex++)
+		{
+			BaseTypesWrapper::Point2D source = GetSource(matches, correspondenceIndex);
+			BaseTypesWrapper::Point2D sink = GetSink(matches, correspondenceIndex);
+			if (source.x == sink.x + 5 && source.y == sink.y)
+			{
+				correctMatches++;
+			}
+		}
+		return correctMatches;
+	}
+
+	int CountCorrectEpipolarMatches(const CorrespondenceMap2D& matches, const std::vector<BaseTypesWrapper::Point2D>& expectedSinks)
+	{
+		int correctMatches = 0;
+		for (int correspondenceIndex = 0; correspondenceIndex < GetNumberOfCorrespondences(matches); correspondenceIndex++)
+		{
+			BaseTypesWrapper::Point2D source = GetSource(matches, correspondenceIndex);
+			BaseTypesWrapper::Point2D sink = GetSink(matches, correspondenceIndex);
+			int pointIndex = (static_cast<int>(source.y) - 40) / 40 * 30 + (static_cast<int>(source.x) - 10) / 20;
+			if (sink.x == expectedSinks.at(pointIndex).x && sink.y == expectedSinks.at(pointIndex).y)
+			{
+				correctMatches++;
+			}
+		}
+		return correctMatches;
+	}
+
+	int CountMatchesWithOffset(const CorrespondenceMap2D& matches, int offsetX, int offsetY)
+	{
+		int offsetMatches = 0;
+		for (int correspondenceIndex = 0; correspondenceIndex < GetNumberOfCorrespondences(matches); correspondenceIndex++)
+		{
+			BaseTypesWrapper::Point2D source = GetSource(matches, correspondenceIndex);
+			BaseTypesWrapper::Point2D sink = GetSink(matches, correspondenceIndex);
+			if (sink.x == source.x + offsetX && sink.y == source.y + offsetY)
+			{
+				offsetMatches++;
+			}
+		}
+		return offsetMatches;
+	}
+}
+
+TEST_CASE( "Call to process with brute force (Hamming matcher)", "[process]" )
+{
+	VisualPointFeatureVector2DPtr sourceFeatures = NewVisualPointFeatureVector2D();
+	VisualPointFeatureVector2DPtr sinkFeatures = NewVisualPointFeatureVector2D();
+	CreateFeatures(*sourceFeatures, *sinkFeatures);
+
+	HammingMatcher* matcher = new HammingMatcher;
+	matcher->sourceFeaturesInput(*sourceFeatures);
+	matcher->sinkFeaturesInput(*sinkFeatures);
+	matcher->process();
+
+	const CorrespondenceMap2D& output = matcher->matchesOutput();
+	REQUIRE( GetNumberOfCorrespondences(output) == NUMBER_OF_POINTS );
+	REQUIRE( CountCorrectMatches(output) == NUMBER_OF_POINTS );
+	REQUIRE( GetProbability(output, 0) == Approx(1 - 10.0 / 256).epsilon(0.05) );
+
+	// A sink descriptor duplicated at another point makes its match ambiguous, the ratio test rejects it
+	SetBinaryDescriptor(*sinkFeatures, 1, GetBinaryDescriptor(*sinkFeatures, 0), DESCRIPTOR_BYTES);
+	matcher->sinkFeaturesInput(*sinkFeatures);
+	matcher->process();
+	REQUIRE( GetNumberOfCorrespondences(output) <= NUMBER_OF_POINTS - 2 );
+	REQUIRE( CountCorrectMatches(output) == GetNumberOfCorrespondences(output) );
+
+	delete matcher;
+	delete sourceFeatures;
+	delete sinkFeatures;
+}
+
+TEST_CASE( "Call to process with multi-probe hashing (Hamming matcher)", "[process]" )
+{
+	VisualPointFeatureVector2DPtr sourceFeatures = NewVisualPointFeatureVector2D();
+	VisualPointFeatureVector2DPtr sinkFeatures = NewVisualPointFeatureVector2D();
+	CreateFeatures(*sourceFeatures, *sinkFeatures);
+
+	HammingMatcher* matcher = new HammingMatcher;
+	matcher->setConfigurationFile("../tests/ConfigurationFiles/DFNs/FeaturesMatching2D/HammingMatcher_Conf1.yaml");
+	matcher->configure();
+	matcher->sourceFeaturesInput(*sourceFeatures);
+	matcher->sinkFeaturesInput(*sinkFeatures);
+	matcher->process();
+
+	// Hashing may miss a few matches but it does not return wrong ones on well separated descriptors
+	const CorrespondenceMap2D& output = matcher->matchesOutput();
+	REQUIRE( GetNumberOfCorrespondences(output) >= NUMBER_OF_POINTS * 9 / 10 );
+	REQUIRE( CountCorrectMatches(output) == GetNumberOfCorrespondences(output) );
+
+	delete matcher;
+	delete sourceFeatures;
+	delete sinkFeatures;
+}
+
+TEST_CASE( "Call to process with guided search (Hamming matcher)", "[process]" )
+{
+	VisualPointFeatureVector2DPtr sourceFeatures = NewVisualPointFeatureVector2D();
+	VisualPointFeatureVector2DPtr sinkFeatures = NewVisualPointFeatureVector2D();
+	CreateStereoFeatures(*sourceFeatures, *sinkFeatures);
+
+	// Brute force cannot tell a sink point from its copy on another row, the ratio test rejects every match
+	HammingMatcher* matcher = new HammingMatcher;
+	matcher->sourceFeaturesInput(*sourceFeatures);
+	matcher->sinkFeaturesInput(*sinkFeatures);
+	matcher->process();
+	REQUIRE( GetNumberOfCorrespondences(matcher->matchesOutput()) == 0 );
+
+	// The row band constraint only searches the sink points on the same row
+	matcher->setConfigurationFile("../tests/ConfigurationFiles/DFNs/FeaturesMatching2D/HammingMatcher_Conf2.yaml");
+	matcher->configure();
+	matcher->process();
+	const CorrespondenceMap2D& output = matcher->matchesOutput();
+	REQUIRE( GetNumberOfCorrespondences(output) == NUMBER_OF_POINTS );
+	REQUIRE( CountCorrectStereoMatches(output) == NUMBER_OF_POINTS );
+
+	delete matcher;
+	delete sourceFeatures;
+	delete sinkFeatures;
+}
+
+TEST_CASE( "Call to process with guided search along epipolar lines (Hamming matcher)", "[process]" )
+{
+	VisualPointFeatureVector2DPtr sourceFeatures = NewVisualPointFeatureVector2D();
+	VisualPointFeatureVector2DPtr sinkFeatures = NewVisualPointFeatureVector2D();
+	std::vector<BaseTypesWrapper::Point2D> expectedSinks;
+	CreateEpipolarFeatures(*sourceFeatures, *sinkFeatures, expectedSinks);
+
+	// Brute force cannot tell a sink point from its copy off the epipolar line, the ratio test rejects every match
+	HammingMatcher* matcher = new HammingMatcher;
+	matcher->sourceFeaturesInput(*sourceFeatures);
+	matcher->sinkFeaturesInput(*sinkFeatures);
+	matcher->process();
+	REQUIRE( GetNumberOfCorrespondences(matcher->matchesOutput()) == 0 );
+
+	// The fundamental matrix is not symmetric, so the true sink points are within the search radius only of the line F * source,
+	// and the source points only of the line F^T * sink in the cross check; the copies lie off the line and are never matched
+	matcher->setConfigurationFile("../tests/ConfigurationFiles/DFNs/FeaturesMatching2D/HammingMatcher_Conf3.yaml");
+	matcher->configure();
+	matcher->process();
+	const CorrespondenceMap2D& output = matcher->matchesOutput();
+	REQUIRE( GetNumberOfCorrespondences(output) == NUMBER_OF_POINTS );
+	REQUIRE( CountCorrectEpipolarMatches(output, expectedSinks) == NUMBER_OF_POINTS );
+
+	delete matcher;
+	delete sourceFeatures;
+	delete sinkFeatures;
+}
+
+TEST_CASE( "Call to process with guided search around the predicted location (Hamming matcher)", "[process]" )
+{
+	VisualPointFeatureVector2DPtr sourceFeatures = NewVisualPointFeatureVector2D();
+	VisualPointFeatureVector2DPtr sinkFeatures = NewVisualPointFeatureVector2D();
+	CreateMovedFeatures(*sourceFeatures, *sinkFeatures);
+
+	// Without the predicted offset no sink point is within the search radius of any source point
+	HammingMatcher* matcher = new HammingMatcher;
+	matcher->setConfigurationFile("../tests/ConfigurationFiles/DFNs/FeaturesMatching2D/HammingMatcher_Conf6.yaml");
+	matcher->configure();
+	matcher->sourceFeaturesInput(*sourceFeatures);
+	matcher->sinkFeaturesInput(*sinkFeatures);
+	matcher->process();
+	const CorrespondenceMap2D& output = matcher->matchesOutput();
+	REQUIRE( GetNumberOfCorrespondences(output) == 0 );
+
+	// Without cross check both the true source and its rival are matched to each sink point, the decoys find no sink point
+	matcher->setConfigurationFile("../tests/ConfigurationFiles/DFNs/FeaturesMatching2D/HammingMatcher_Conf5.yaml");
+	matcher->configure();
+	matcher->process();
+	REQUIRE( GetNumberOfCorrespondences(output) == 2 * NUMBER_OF_POINTS );
+	REQUIRE( CountMatchesWithOffset(output, 7, 13) == NUMBER_OF_POINTS );
+	REQUIRE( CountMatchesWithOffset(output, 6, 13) == NUMBER_OF_POINTS );
+
+	// The cross check searches back around the sink point minus the offset, where the rival is the closest descriptor
+	matcher->setConfigurationFile("../tests/ConfigurationFiles/DFNs/FeaturesMatching2D/HammingMatcher_Conf4.yaml");
+	matcher->configure();
+	matcher->process();
+	REQUIRE( GetNumberOfCorrespondences(output) == NUMBER_OF_POINTS );
+	REQUIRE( CountMatchesWithOffset(output, 6, 13) == NUMBER_OF_POINTS );
+
+	delete matcher;
+	delete sourceFeatures;
+	delete sinkFeatures;
+}
+
+TEST_CASE( "Call to configure (Hamming matcher)", "[configure]" )
+{
+	HammingMatcher* matcher = new HammingMatcher;
+	matcher->setConfigurationFile("../tests/ConfigurationFiles/DFNs/FeaturesMatching2D/HammingMatcher_Conf1.yaml");
+	matcher->configure();
+	matcher->setConfigurationFile("../tests/ConfigurationFiles/DFNs/FeaturesMatching2D/HammingMatcher_Conf2.yaml");
+	matcher->configure();
+	matcher->setConfigurationFile("../tests/ConfigurationFiles/DFNs/FeaturesMatching2D/HammingMatcher_Conf3.yaml");
+	matcher->configure();
+	matcher->setConfigurationFile("../tests/ConfigurationFiles/DFNs/FeaturesMatching2D/HammingMatcher_Conf4.yaml");
+	matcher->configure();
+	delete matcher;
+}
+
+/** @} */
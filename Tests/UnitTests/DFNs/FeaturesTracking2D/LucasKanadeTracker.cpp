@@ -0,0 +1,104 @@
+/**
+ * @author Alessandro Bianco
+ */
+
+/**
+ * Unit tests for the DFN LucasKanadeTracker
+ */
+
+/**
+ * @addtogroup DFNsTest
+ * @{
+ */
+
+#include <catch.hpp>
+#include <FeaturesTracking2D/LucasKanadeTracker.hpp>
+#include <Converters/MatToFrameConverter.hpp>
+#include <Types/CPP/CorrespondenceMap2D.hpp>
+
+#include <opencv2/imgproc/imgproc.hpp>
+
+using namespace CDFF::DFN::FeaturesTracking2D;
+using namespace Converters;
+using namespace FrameWrapper;
+using namespace CorrespondenceMap2DWrapper;
+
+namespace
+{
+	/**
+	 * A smooth random texture, shifted by the given number of pixels.
+	 */
+	cv::Mat CreateTexture(float shiftX, float shiftY)
+	{
+		cv::Mat noise(480, 640, CV_8UC1);
+		cv::RNG generator(7);
+		generator.fill(noise, cv::RNG::UNIFORM, cv::Scalar(0), cv::Scalar(256));
+		cv::Mat texture;
+		cv::GaussianBlur(noise, texture, cv::Size(0, 0), 2);
+
+		cv::Mat shift = (cv::Mat_<double>(2, 3) << 1, 0, shiftX, 0, 1, shiftY);
+		cv::Mat shiftedTexture;
+		cv::warpAffine(texture, shiftedTexture, shift, texture.size(), cv::INTER_LINEAR, cv::BORDER_REFLECT);
+		return shiftedTexture;
+	}
+}
+
+TEST_CASE( "Call to process (Lucas-Kanade tracker)", "[process]" )
+{
+	MatToFrameConverter matToFrame;
+	FrameConstPtr firstFrame = matToFrame.Convert( CreateTexture(0, 0) );
+	FrameConstPtr secondFrame = matToFrame.Convert( CreateTexture(3, 2) );
+
+	LucasKanadeTracker* tracker = new LucasKanadeTracker;
+
+	// The first image has nothing to be tracked from
+	tracker->frameInput(*firstFrame);
+	tracker->process();
+	const CorrespondenceMap2D& output = tracker->matchesOutput();
+	REQUIRE( GetNumberOfCorrespondences(output) == 0 );
+
+	// The keypoints detected on the first image follow the shift
+	tracker->frameInput(*secondFrame);
+	tracker->process();
+	int numberOfMatches = GetNumberOfCorrespondences(output);
+	REQUIRE( numberOfMatches > 200 );
+	REQUIRE( numberOfMatches <= 500 );
+	for (int correspondenceIndex = 0; correspondenceIndex < numberOfMatches; correspondenceIndex++)
+	{
+		BaseTypesWrapper::Point2D source = GetSource(output, correspondenceIndex);
+		BaseTypesWrapper::Point2D sink = GetSink(output, correspondenceIndex);
+		REQUIRE( sink.x - source.x == Approx(3).margin(0.5) );
+		REQUIRE( sink.y - source.y == Approx(2).margin(0.5) );
+		REQUIRE( GetProbability(output, correspondenceIndex) > 0.5 );
+	}
+
+	// The tracked keypoints are kept and the empty cells are filled, so at least as many keypoints are tracked on a still image
+	tracker->process();
+	REQUIRE( GetNumberOfCorrespondences(output) >= numberOfMatches );
+	for (int correspondenceIndex = 0; correspondenceIndex < GetNumberOfCorrespondences(output); correspondenceIndex++)
+	{
+		REQUIRE( GetSink(output, correspondenceIndex).x == Approx( GetSource(output, correspondenceIndex).x ).margin(0.1) );
+		REQUIRE( GetSink(output, correspondenceIndex).y == Approx( GetSource(output, correspondenceIndex).y ).margin(0.1) );
+	}
+
+	// A new image size restarts the tracking
+	FrameConstPtr smallFrame = matToFrame.Convert( CreateTexture(0, 0)( cv::Rect(0, 0, 320, 240) ).clone() );
+	tracker->frameInput(*smallFrame);
+	tracker->process();
+	REQUIRE( GetNumberOfCorrespondences(output) == 0 );
+
+	delete tracker;
+	delete firstFrame;
+	delete secondFrame;
+	delete smallFrame;
+}
+
+TEST_CASE( "Call to configure (Lucas-Kanade tracker)", "[configure]" )
+{
+	LucasKanadeTracker* tracker = new LucasKanadeTracker;
+	tracker->setConfigurationFile("../tests/ConfigurationFiles/DFNs/FeaturesTracking2D/LucasKanadeTracker_Conf1.yaml");
+	tracker->configure();
+	delete tracker;
+}
+
+/** @} */
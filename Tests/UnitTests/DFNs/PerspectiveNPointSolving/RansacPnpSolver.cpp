@@ -0,0 +1,186 @@
+/**
+ * @author Alessandro Bianco
+ */
+
+/**
+ * Unit tests for the DFN RansacPnpSolver
+ */
+
+/**
+ * @addtogroup DFNsTest
+ * @{
+ */
+
+#include <catch.hpp>
+#include <PerspectiveNPointSolving/RansacPnpSolver.hpp>
+#include <Types/CPP/PointCloud.hpp>
+#include <Types/CPP/VisualPointFeatureVector2D.hpp>
+#include <Types/CPP/Pose.hpp>
+
+#include <Eigen/Geometry>
+#include <random>
+#include <cmath>
+
+using namespace CDFF::DFN::PerspectiveNPointSolving;
+using namespace PointCloudWrapper;
+using namespace VisualPointFeatureVector2DWrapper;
+using namespace PoseWrapper;
+
+namespace
+{
+	const int NUMBER_OF_POINTS = 200;
+
+	/**
+	 * The points are projected by the camera of the configuration files, the projections of the first numberOfOutliers points are replaced by random pixels.
+	 * The projections are rounded to integer pixels, as the projections input stores them.
+	 */
+	void CreateInputs(const Eigen::Quaterniond& orientation, const Eigen::Vector3d& position, int numberOfOutliers, PointCloud& points, VisualPointFeatureVector2D& projections)
+	{
+		std::mt19937 generator(5);
+		std::uniform_real_distribution<double> sideDistribution(-1, 1);
+		std::uniform_real_distribution<double> depthDistribution(4, 6);
+		std::uniform_int_distribution<int> columnDistribution(0, 639);
+		std::uniform_int_distribution<int> rowDistribution(0, 479);
+
+		ClearPoints(points);
+		ClearPoints(projections);
+		for (int pointIndex = 0; pointIndex < NUMBER_OF_POINTS; pointIndex++)
+		{
+			Eigen::Vector3d cameraPoint(sideDistribution(generator), sideDistribution(generator), depthDistribution(generator));
+			Eigen::Vector3d point = orientation.inverse() * (cameraPoint - position);
+			AddPoint(points, point.x(), point.y(), point.z());
+
+			if (pointIndex < numberOfOutliers)
+			{
+				AddPoint(projections, columnDistribution(generator), rowDistribution(generator));
+			}
+			else
+			{
+				double x = 500 * cameraPoint.x() / cameraPoint.z() + 320;
+				double y = 510 * cameraPoint.y() / cameraPoint.z() + 240;
+				AddPoint(projections, static_cast<uint16_t>(std::lround(x)), static_cast<uint16_t>(std::lround(y)));
+			}
+		}
+	}
+
+	void ValidatePose(const Pose3D& pose, const Eigen::Quaterniond& orientation, const Eigen::Vector3d& position)
+	{
+		Eigen::Quaterniond estimatedOrientation(GetWOrientation(pose), GetXOrientation(pose), GetYOrientation(pose), GetZOrientation(pose));
+		Eigen::Vector3d estimatedPosition(GetXPosition(pose), GetYPosition(pose), GetZPosition(pose));
+		REQUIRE( estimatedOrientation.angularDistance(orientation) < 0.02 );
+		REQUIRE( (estimatedPosition - position).norm() < 0.05 );
+	}
+}
+
+TEST_CASE( "Call to process (RANSAC PnP solver)", "[process]" )
+{
+	// Prepare input data, half of the projections are outliers
+	Eigen::Quaterniond orientation(Eigen::AngleAxisd(0.3, Eigen::Vector3d(1, 2, 3).normalized()));
+	Eigen::Vector3d position(0.2, -0.1, 0.5);
+	PointCloud* points = new PointCloud;
+	VisualPointFeatureVector2D* projections = new VisualPointFeatureVector2D;
+	CreateInputs(orientation, position, NUMBER_OF_POINTS / 2, *points, *projections);
+
+	// Instantiate DFN
+	RansacPnpSolver* pnp = new RansacPnpSolver;
+
+	// Setup DFN
+	pnp->setConfigurationFile("../tests/ConfigurationFiles/DFNs/PerspectiveNPointSolving/RansacPnpSolver_Conf1.yaml");
+	pnp->configure();
+
+	// Send input data to DFN
+	pnp->pointsInput(*points);
+	pnp->projectionsInput(*projections);
+
+	// Run DFN
+	pnp->process();
+
+	// Query output data from DFN
+	const Pose3D& camera = pnp->cameraOutput();
+	bool success = pnp->successOutput();
+
+	REQUIRE( success == true );
+	ValidatePose(camera, orientation, position);
+
+	// Cleanup
+	delete pnp;
+	delete points;
+	delete projections;
+}
+
+TEST_CASE( "Call to process with preemptive scoring (RANSAC PnP solver)", "[processPreemptive]" )
+{
+	// Prepare input data, a fifth of the projections are outliers
+	Eigen::Quaterniond orientation(Eigen::AngleAxisd(-0.2, Eigen::Vector3d(0, 1, 1).normalized()));
+	Eigen::Vector3d position(-0.3, 0.1, 0.2);
+	PointCloud* points = new PointCloud;
+	VisualPointFeatureVector2D* projections = new VisualPointFeatureVector2D;
+	CreateInputs(orientation, position, NUMBER_OF_POINTS / 5, *points, *projections);
+
+	// Instantiate DFN
+	RansacPnpSolver* pnp = new RansacPnpSolver;
+
+	// Setup DFN
+	pnp->setConfigurationFile("../tests/ConfigurationFiles/DFNs/PerspectiveNPointSolving/RansacPnpSolver_Conf2.yaml");
+	pnp->configure();
+
+	// Send input data to DFN
+	pnp->pointsInput(*points);
+	pnp->projectionsInput(*projections);
+
+	// Run DFN
+	pnp->process();
+
+	// Query output data from DFN
+	const Pose3D& camera = pnp->cameraOutput();
+	bool success = pnp->successOutput();
+
+	REQUIRE( success == true );
+	ValidatePose(camera, orientation, position);
+
+	// Cleanup
+	delete pnp;
+	delete points;
+	delete projections;
+}
+
+TEST_CASE( "Call to process with too few points (RANSAC PnP solver)", "[processFewPoints]" )
+{
+	PointCloud* points = new PointCloud;
+	VisualPointFeatureVector2D* projections = new VisualPointFeatureVector2D;
+	ClearPoints(*points);
+	ClearPoints(*projections);
+	for (int pointIndex = 0; pointIndex < 3; pointIndex++)
+	{
+		AddPoint(*points, pointIndex, 0, 5);
+		AddPoint(*projections, 320 + 100 * pointIndex, 240);
+	}
+
+	RansacPnpSolver* pnp = new RansacPnpSolver;
+	pnp->pointsInput(*points);
+	pnp->projectionsInput(*projections);
+	pnp->process();
+
+	REQUIRE( pnp->successOutput() == false );
+
+	delete pnp;
+	delete points;
+	delete projections;
+}
+
+TEST_CASE( "Call to configure (RANSAC PnP solver)", "[configure]" )
+{
+	// Instantiate DFN
+	RansacPnpSolver* pnp = new RansacPnpSolver;
+
+	// Setup DFN
+	pnp->setConfigurationFile("../tests/ConfigurationFiles/DFNs/PerspectiveNPointSolving/RansacPnpSolver_Conf1.yaml");
+	pnp->configure();
+	pnp->setConfigurationFile("../tests/ConfigurationFiles/DFNs/PerspectiveNPointSolving/RansacPnpSolver_Conf2.yaml");
+	pnp->configure();
+
+	// Cleanup
+	delete pnp;
+}
+
+/** @} */
@@ -13,6 +13,7 @@
 
 #include <catch.hpp>
 #include <Registration3D/Icp3D.hpp>
+#include <Registration3D/IncrementalTargetCloud.hpp>
 #include <Converters/PclPointCloudToPointCloudConverter.hpp>
 #include <Errors/Assert.hpp>
 
@@ -62,6 +63,55 @@ TEST_CASE( "Call to process (Registration 3D Icp)", "[process]" )
 	delete sinkPointCloud;
 }
 
+TEST_CASE( "Call to process with an incremental sink target (Registration 3D Icp)", "[processOnTarget]" )
+{
+	// Prepare input data (a sphere, and the same sphere moved along the x axis)
+	PointCloudPtr sinkPointCloud = NewPointCloud();
+	PointCloudPtr sourcePointCloud = NewPointCloud();
+	for (float alpha = 0; alpha < 2 * M_PI; alpha += 0.1)
+	{
+		for (float beta = 0; beta < 2 * M_PI; beta += 0.1)
+		{
+			float x = std::cos(alpha) * std::cos(beta);
+			float y = std::sin(alpha);
+			float z = std::sin(beta);
+			AddPoint(*sinkPointCloud, x, y, z);
+			AddPoint(*sourcePointCloud, x + 0.02, y, z);
+		}
+	}
+	IncrementalTargetCloud target;
+	target.SetResolution(0.01);
+	target.AddPoints(*sinkPointCloud);
+
+	Pose3D guess;
+	SetPosition(guess, 0, 0, 0);
+	SetOrientation(guess, 0, 0, 0, 1);
+
+	// Instantiate DFN
+	Icp3D *icp = new Icp3D;
+	REQUIRE( icp->setSinkTarget(&target) );
+
+	// Send input data to DFN
+	icp->sourceCloudInput(*sourcePointCloud);
+	icp->useGuessInput(true);
+	icp->transformGuessInput(guess);
+
+	// Run DFN
+	icp->process();
+
+	// Query output data from DFN
+	const Pose3D& transform = icp->transformOutput();
+	REQUIRE( icp->successOutput() );
+	REQUIRE( GetXPosition(transform) == Approx(-0.02).margin(0.005) );
+	REQUIRE( GetYPosition(transform) == Approx(0).margin(0.005) );
+	REQUIRE( GetZPosition(transform) == Approx(0).margin(0.005) );
+
+	// Cleanup
+	delete icp;
+	delete sourcePointCloud;
+	delete sinkPointCloud;
+}
+
 TEST_CASE( "Call to configure (Registration 3D Icp)", "[configure]" )
 {
 	// Instantiate DFN
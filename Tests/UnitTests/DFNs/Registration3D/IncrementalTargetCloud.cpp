@@ -0,0 +1,123 @@
+/**
+ * @author Alessandro Bianco
+ */
+
+/**
+ * Unit tests for the incremental sink target of the DFN Registration3D
+ */
+
+/**
+ * @addtogroup DFNsTest
+ * @{
+ */
+
+#include <catch.hpp>
+#include <Registration3D/IncrementalTargetCloud.hpp>
+#include <Types/CPP/PointCloud.hpp>
+#include <Types/CPP/Pose.hpp>
+
+#include <cmath>
+
+using namespace CDFF::DFN::Registration3D;
+using namespace PointCloudWrapper;
+using namespace PoseWrapper;
+
+namespace
+{
+	//A 21x21 grid of points on the plane z = 0, with spacing 0.1
+	PointCloudPtr CreateGridCloud()
+	{
+		PointCloudPtr cloud = NewPointCloud();
+		for (int row = -10; row <= 10; row++)
+		{
+			for (int column = -10; column <= 10; column++)
+			{
+				AddPoint(*cloud, 0.1 * row, 0.1 * column, 0);
+			}
+		}
+		return cloud;
+	}
+
+	Pose3D CreatePose(float x, float y, float z)
+	{
+		Pose3D pose;
+		SetPosition(pose, x, y, z);
+		SetOrientation(pose, 0, 0, 0, 1);
+		return pose;
+	}
+}
+
+TEST_CASE( "Points are merged into voxels and removed outside a radius (Incremental target cloud)", "[IncrementalTarget]" )
+{
+	IncrementalTargetCloud target;
+	target.SetResolution(0.05);
+
+	PointCloudPtr cloud = CreateGridCloud();
+	target.AddPoints(*cloud);
+	REQUIRE( target.GetNumberOfPoints() == 441 );
+
+	//The same points at the same place fall in the occupied voxels
+	target.AddPoints(*cloud);
+	REQUIRE( target.GetNumberOfPoints() == 441 );
+
+	//The points within 0.35 of the origin are those with row^2 + column^2 <= 12.25
+	Pose3D origin = CreatePose(0, 0, 0);
+	target.RemovePointsOutside(origin, 0.35);
+	REQUIRE( target.GetNumberOfPoints() == 37 );
+
+	//The slots of removed points are reused, the cloud grows only by the points that do not fit in them
+	Pose3D cloudPose = CreatePose(0, 0, 1);
+	target.AddPoints(*cloud, cloudPose);
+	REQUIRE( target.GetNumberOfPoints() == 478 );
+	REQUIRE( target.GetCloud()->points.size() == 478 );
+
+	target.Clear();
+	REQUIRE( target.GetNumberOfPoints() == 0 );
+
+	delete cloud;
+}
+
+TEST_CASE( "The search tree finds the nearest point within the search distance (Incremental target cloud)", "[IncrementalTarget]" )
+{
+	IncrementalTargetCloud target;
+	target.SetResolution(0.02);
+	PointCloudPtr cloud = CreateGridCloud();
+	target.AddPoints(*cloud);
+
+	IncrementalTargetCloud::SearchTree::Ptr tree = target.GetSearchTree(0.08);
+	const pcl::PointCloud<pcl::PointXYZ>& targetCloud = *(target.GetCloud());
+
+	std::vector<int> indicesList;
+	std::vector<float> squaredDistancesList;
+	int found = tree->nearestKSearch(pcl::PointXYZ(0.33, -0.52, 0.01), 1, indicesList, squaredDistancesList);
+	REQUIRE( found == 1 );
+	REQUIRE( targetCloud.points.at(indicesList.at(0)).x == Approx(0.3) );
+	REQUIRE( targetCloud.points.at(indicesList.at(0)).y == Approx(-0.5) );
+	REQUIRE( squaredDistancesList.at(0) == Approx(0.03*0.03 + 0.02*0.02 + 0.01*0.01) );
+
+	//The radius is limited by the search distance, a larger search distance enlarges the search cells
+	found = tree->radiusSearch(pcl::PointXYZ(0, 0, 0), 0.15, indicesList, squaredDistancesList);
+	REQUIRE( found == 1 );
+	tree = target.GetSearchTree(0.15);
+	found = tree->radiusSearch(pcl::PointXYZ(0, 0, 0), 0.15, indicesList, squaredDistancesList);
+	REQUIRE( found == 9 );
+	REQUIRE( squaredDistancesList.at(0) == Approx(0) );
+
+	//Beyond the search distance nothing is found, the sentinel lies at infinite distance so that it is rejected by any threshold
+	found = tree->nearestKSearch(pcl::PointXYZ(0, 0, 0.5), 1, indicesList, squaredDistancesList);
+	REQUIRE( found == 0 );
+	REQUIRE( indicesList.size() == 1 );
+	REQUIRE( squaredDistancesList.at(0) > 1e30 );
+
+	//Removed points are not found any more
+	Pose3D center = CreatePose(1, 1, 0);
+	target.RemovePointsOutside(center, 0.5);
+	float squaredDistance;
+	REQUIRE( target.FindNearestPoint(pcl::PointXYZ(0, 0, 0), squaredDistance) == -1 );
+	REQUIRE( target.FindNearestPoint(pcl::PointXYZ(0.71, 0.69, 0), squaredDistance) >= 0 );
+	REQUIRE( squaredDistance == Approx(0.01*0.01 + 0.01*0.01) );
+
+	delete cloud;
+}
+
+/** @} */
@@ -0,0 +1,151 @@
+/**
+ * @author Alessandro Bianco
+ */
+
+/**
+ * Unit tests for the DFN PyramidalBlockMatching
+ */
+
+/**
+ * @addtogroup DFNsTest
+ * @{
+ */
+
+#include <catch.hpp>
+#include <StereoReconstruction/PyramidalBlockMatching.hpp>
+#include <Converters/MatToFrameConverter.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+using namespace CDFF::DFN::StereoReconstruction;
+using namespace Converters;
+using namespace PointCloudWrapper;
+using namespace FrameWrapper;
+
+namespace
+{
+	//A smoothed random texture seen by the right camera shifted by a constant disparity, the smoothing keeps the texture visible at the coarser pyramid levels
+	void CreateShiftedPair(int disparity, cv::Mat& leftImage, cv::Mat& rightImage)
+	{
+		cv::Mat texture(240, 320 + disparity, CV_8UC1);
+		cv::randu(texture, cv::Scalar(0), cv::Scalar(255));
+		cv::GaussianBlur(texture, texture, cv::Size(5, 5), 1);
+		cv::normalize(texture, texture, 0, 255, cv::NORM_MINMAX);
+		leftImage = texture(cv::Rect(0, 0, 320, 240)).clone();
+		rightImage = texture(cv::Rect(disparity, 0, 320, 240)).clone();
+	}
+
+	int CountCorrectDisparities(const std::vector<int16_t>& disparityImage, int disparity)
+	{
+		int correctDisparities = 0;
+		for (unsigned pixelIndex = 0; pixelIndex < disparityImage.size(); pixelIndex++)
+		{
+			if (std::abs(disparityImage.at(pixelIndex) - disparity * PyramidalBlockMatching::DISPARITY_SCALE) <= PyramidalBlockMatching::DISPARITY_SCALE / 4)
+			{
+				correctDisparities++;
+			}
+		}
+		return correctDisparities;
+	}
+}
+
+TEST_CASE( "DFN PyramidalBlockMatching: processing step", "[process]" )
+{
+	// Prepare input data
+	cv::Mat leftImage, rightImage;
+	CreateShiftedPair(20, leftImage, rightImage);
+
+	MatToFrameConverter matToFrame;
+	const Frame* left = matToFrame.Convert(leftImage);
+	const Frame* right = matToFrame.Convert(rightImage);
+
+	// Instantiate DFN
+	PyramidalBlockMatching* pyramidalBlockMatching = new PyramidalBlockMatching;
+
+	// Setup DFN
+	pyramidalBlockMatching->setConfigurationFile("../tests/ConfigurationFiles/DFNs/StereoReconstruction/PyramidalBlockMatching_Conf1.yaml");
+	pyramidalBlockMatching->configure();
+
+	// Send input data to DFN
+	pyramidalBlockMatching->leftInput(*left);
+	pyramidalBlockMatching->rightInput(*right);
+
+	// Run DFN
+	pyramidalBlockMatching->process();
+
+	// Query output data from DFN
+	const PointCloud& reconstructedScene = pyramidalBlockMatching->pointcloudOutput();
+	const std::vector<int16_t>& disparityImage = pyramidalBlockMatching->GetDisparityImage();
+
+	// Check output, the pixels whose match falls outside the right image have no disparity
+	REQUIRE( CountCorrectDisparities(disparityImage, 20) > 0.85 * 320 * 240 );
+	REQUIRE( GetNumberOfPoints(reconstructedScene) > 0.85 * 320 * 240 );
+
+	int correctPoints = 0;
+	for (int pointIndex = 0; pointIndex < GetNumberOfPoints(reconstructedScene); pointIndex++)
+	{
+		if (std::abs(GetZCoordinate(reconstructedScene, pointIndex) - 5) < 0.25)
+		{
+			correctPoints++;
+		}
+	}
+	REQUIRE( correctPoints > 0.9 * GetNumberOfPoints(reconstructedScene) );
+
+	// A second call with the same image size reuses the pyramid and gives the same result
+	std::vector<int16_t> firstDisparityImage = disparityImage;
+	pyramidalBlockMatching->process();
+	REQUIRE( pyramidalBlockMatching->GetDisparityImage() == firstDisparityImage );
+
+	// Cleanup
+	delete pyramidalBlockMatching;
+	delete left;
+	delete right;
+}
+
+TEST_CASE( "DFN PyramidalBlockMatching: disparity that is not a multiple of the pyramid scale", "[process]" )
+{
+	// Prepare input data, at the coarsest level the disparity falls between two pixels
+	cv::Mat leftImage, rightImage;
+	CreateShiftedPair(13, leftImage, rightImage);
+	cv::Mat leftColorImage, rightColorImage;
+	cv::cvtColor(leftImage, leftColorImage, cv::COLOR_GRAY2BGR);
+	cv::cvtColor(rightImage, rightColorImage, cv::COLOR_GRAY2BGR);
+
+	MatToFrameConverter matToFrame;
+	const Frame* left = matToFrame.Convert(leftColorImage);
+	const Frame* right = matToFrame.Convert(rightColorImage);
+
+	// Instantiate DFN
+	PyramidalBlockMatching* pyramidalBlockMatching = new PyramidalBlockMatching;
+	pyramidalBlockMatching->setConfigurationFile("../tests/ConfigurationFiles/DFNs/StereoReconstruction/PyramidalBlockMatching_Conf1.yaml");
+	pyramidalBlockMatching->configure();
+
+	// Send input data to DFN, run DFN and check that the disparity is found
+	pyramidalBlockMatching->leftInput(*left);
+	pyramidalBlockMatching->rightInput(*right);
+	pyramidalBlockMatching->process();
+
+	REQUIRE( CountCorrectDisparities(pyramidalBlockMatching->GetDisparityImage(), 13) > 0.9 * 320 * 240 );
+	cv::Mat disparityMatrix = pyramidalBlockMatching->disparityMatrixOutput();
+	REQUIRE( disparityMatrix.type() == CV_16S );
+	REQUIRE( std::abs(disparityMatrix.at<int16_t>(120, 160) - 13 * PyramidalBlockMatching::DISPARITY_SCALE) <= PyramidalBlockMatching::DISPARITY_SCALE / 4 );
+
+	// Cleanup
+	delete pyramidalBlockMatching;
+	delete left;
+	delete right;
+}
+
+TEST_CASE( "DFN PyramidalBlockMatching: configuration", "[configure]" )
+{
+	// Instantiate DFN
+	PyramidalBlockMatching* pyramidalBlockMatching = new PyramidalBlockMatching;
+
+	// Setup DFN
+	pyramidalBlockMatching->setConfigurationFile("../tests/ConfigurationFiles/DFNs/StereoReconstruction/PyramidalBlockMatching_Conf1.yaml");
+	pyramidalBlockMatching->configure();
+
+	// Cleanup
+	delete pyramidalBlockMatching;
+}
+
+/** @} */
@@ -0,0 +1,232 @@
+/**
+ * @author Alessandro Bianco
+ */
+
+/**
+ * Unit tests for the DFN SemiGlobalMatching
+ */
+
+/**
+ * @addtogroup DFNsTest
+ * @{
+ */
+
+#include <catch.hpp>
+#include <StereoReconstruction/SemiGlobalMatching.hpp>
+#include <Converters/MatToFrameConverter.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+using namespace CDFF::DFN::StereoReconstruction;
+using namespace Converters;
+using namespace PointCloudWrapper;
+using namespace FrameWrapper;
+
+namespace
+{
+	//A random texture seen by the right camera shifted by a constant disparity
+	void CreateShiftedPair(int disparity, cv::Mat& leftImage, cv::Mat& rightImage)
+	{
+		cv::Mat texture(240, 320 + disparity, CV_8UC1);
+		cv::randu(texture, cv::Scalar(0), cv::Scalar(255));
+		leftImage = texture(cv::Rect(0, 0, 320, 240)).clone();
+		rightImage = texture(cv::Rect(disparity, 0, 320, 240)).clone();
+	}
+}
+
+TEST_CASE( "DFN SemiGlobalMatching: processing step", "[process]" )
+{
+	// Prepare input data
+	cv::Mat leftImage, rightImage;
+	CreateShiftedPair(10, leftImage, rightImage);
+
+	MatToFrameConverter matToFrame;
+	const Frame* left = matToFrame.Convert(leftImage);
+	const Frame* right = matToFrame.Convert(rightImage);
+
+	// Instantiate DFN
+	SemiGlobalMatching* semiGlobalMatching = new SemiGlobalMatching;
+
+	// Setup DFN
+	semiGlobalMatching->setConfigurationFile("../tests/ConfigurationFiles/DFNs/StereoReconstruction/SemiGlobalMatching_Conf1.yaml");
+	semiGlobalMatching->configure();
+
+	// Send input data to DFN
+	semiGlobalMatching->leftInput(*left);
+	semiGlobalMatching->rightInput(*right);
+
+	// Run DFN
+	semiGlobalMatching->process();
+
+	// Query output data from DFN
+	const PointCloud& reconstructedScene = semiGlobalMatching->pointcloudOutput();
+	const std::vector<int16_t>& disparityImage = semiGlobalMatching->GetDisparityImage();
+
+	// Check output, the pixels whose match falls outside the right image have no disparity
+	int correctDisparities = 0;
+	for (unsigned pixelIndex = 0; pixelIndex < disparityImage.size(); pixelIndex++)
+	{
+		if (std::abs(disparityImage.at(pixelIndex) - 10 * SemiGlobalMatching::DISPARITY_SCALE) <= SemiGlobalMatching::DISPARITY_SCALE / 4)
+		{
+			correctDisparities++;
+		}
+	}
+	REQUIRE( correctDisparities > 0.9 * 320 * 240 );
+	REQUIRE( GetNumberOfPoints(reconstructedScene) > 0.9 * 320 * 240 );
+
+	int correctPoints = 0;
+	for (int pointIndex = 0; pointIndex < GetNumberOfPoints(reconstructedScene); pointIndex++)
+	{
+		if (std::abs(GetZCoordinate(reconstructedScene, pointIndex) - 10) < 0.25)
+		{
+			correctPoints++;
+		}
+	}
+	REQUIRE( correctPoints > 0.9 * GetNumberOfPoints(reconstructedScene) );
+
+	// A second call with the same image size reuses the workspace and gives the same result
+	semiGlobalMatching->process();
+	REQUIRE( semiGlobalMatching->GetDisparityImage() == disparityImage );
+
+	// Cleanup
+	delete semiGlobalMatching;
+	delete left;
+	delete right;
+}
+
+TEST_CASE( "DFN SemiGlobalMatching: color images", "[process]" )
+{
+	// Prepare input data
+	cv::Mat leftImage, rightImage;
+	CreateShiftedPair(5, leftImage, rightImage);
+	cv::Mat leftColorImage, rightColorImage;
+	cv::cvtColor(leftImage, leftColorImage, cv::COLOR_GRAY2BGR);
+	cv::cvtColor(rightImage, rightColorImage, cv::COLOR_GRAY2BGR);
+
+	MatToFrameConverter matToFrame;
+	const Frame* left = matToFrame.Convert(leftColorImage);
+	const Frame* right = matToFrame.Convert(rightColorImage);
+
+	// Instantiate DFN
+	SemiGlobalMatching* semiGlobalMatching = new SemiGlobalMatching;
+	semiGlobalMatching->configure();
+
+	// Send input data to DFN, run DFN and check that the disparity is found
+	semiGlobalMatching->leftInput(*left);
+	semiGlobalMatching->rightInput(*right);
+	semiGlobalMatching->process();
+
+	cv::Mat disparityMatrix = semiGlobalMatching->disparityMatrixOutput();
+	REQUIRE( disparityMatrix.type() == CV_16S );
+	REQUIRE( std::abs(disparityMatrix.at<int16_t>(120, 160) - 5 * SemiGlobalMatching::DISPARITY_SCALE) <= SemiGlobalMatching::DISPARITY_SCALE / 4 );
+
+	// Cleanup
+	delete semiGlobalMatching;
+	delete left;
+	delete right;
+}
+
+TEST_CASE( "DFN SemiGlobalMatching: temporal disparity range", "[process]" )
+{
+	// Prepare input data
+	cv::Mat leftImage, rightImage;
+	CreateShiftedPair(10, leftImage, rightImage);
+
+	MatToFrameConverter matToFrame;
+	const Frame* left = matToFrame.Convert(leftImage);
+	const Frame* right = matToFrame.Convert(rightImage);
+
+	// Instantiate DFN, the configuration searches 128 disparities and predicts the range for two frames after each full search
+	SemiGlobalMatching* semiGlobalMatching = new SemiGlobalMatching;
+	semiGlobalMatching->setConfigurationFile("../tests/ConfigurationFiles/DFNs/StereoReconstruction/SemiGlobalMatching_Conf2.yaml");
+	semiGlobalMatching->configure();
+	semiGlobalMatching->leftInput(*left);
+	semiGlobalMatching->rightInput(*right);
+
+	// The first frame searches the full range, the next two a range around its disparities and the fourth the full range again
+	for (int frame = 0; frame < 4; frame++)
+	{
+		semiGlobalMatching->process();
+
+		const std::vector<int16_t>& disparityImage = semiGlobalMatching->GetDisparityImage();
+		int correctDisparities = 0;
+		for (unsigned pixelIndex = 0; pixelIndex < disparityImage.size(); pixelIndex++)
+		{
+			if (std::abs(disparityImage.at(pixelIndex) - 10 * SemiGlobalMatching::DISPARITY_SCALE) <= SemiGlobalMatching::DISPARITY_SCALE / 4)
+			{
+				correctDisparities++;
+			}
+		}
+		REQUIRE( correctDisparities > 0.9 * 320 * 240 );
+	}
+
+	// Cleanup
+	delete semiGlobalMatching;
+	delete left;
+	delete right;
+}
+
+TEST_CASE( "DFN SemiGlobalMatching: disparity outside the predicted range", "[process]" )
+{
+	// Prepare input data, the disparity jumps from 10 to 60 between the two frames
+	cv::Mat nearLeftImage, nearRightImage, farLeftImage, farRightImage;
+	CreateShiftedPair(10, farLeftImage, farRightImage);
+	CreateShiftedPair(60, nearLeftImage, nearRightImage);
+
+	MatToFrameConverter matToFrame;
+	const Frame* farLeft = matToFrame.Convert(farLeftImage);
+	const Frame* farRight = matToFrame.Convert(farRightImage);
+	const Frame* nearLeft = matToFrame.Convert(nearLeftImage);
+	const Frame* nearRight = matToFrame.Convert(nearRightImage);
+
+	// Instantiate DFN, the first frame searches the full range and the second one the range predicted from the first
+	SemiGlobalMatching* semiGlobalMatching = new SemiGlobalMatching;
+	semiGlobalMatching->setConfigurationFile("../tests/ConfigurationFiles/DFNs/StereoReconstruction/SemiGlobalMatching_Conf2.yaml");
+	semiGlobalMatching->configure();
+	semiGlobalMatching->leftInput(*farLeft);
+	semiGlobalMatching->rightInput(*farRight);
+	semiGlobalMatching->process();
+
+	// The predicted range ends well below 60, the bands find no unique match inside it and search the full range again
+	semiGlobalMatching->leftInput(*nearLeft);
+	semiGlobalMatching->rightInput(*nearRight);
+	semiGlobalMatching->process();
+
+	const std::vector<int16_t>& disparityImage = semiGlobalMatching->GetDisparityImage();
+	int correctDisparities = 0;
+	int wrongDisparities = 0;
+	for (unsigned pixelIndex = 0; pixelIndex < disparityImage.size(); pixelIndex++)
+	{
+		if (std::abs(disparityImage.at(pixelIndex) - 60 * SemiGlobalMatching::DISPARITY_SCALE) <= SemiGlobalMatching::DISPARITY_SCALE / 4)
+		{
+			correctDisparities++;
+		}
+		else if (disparityImage.at(pixelIndex) != SemiGlobalMatching::INVALID_DISPARITY)
+		{
+			wrongDisparities++;
+		}
+	}
+	REQUIRE( correctDisparities > 0.9 * (320 - 60) * 240 );
+	REQUIRE( wrongDisparities < 0.05 * 320 * 240 );
+
+	// Cleanup
+	delete semiGlobalMatching;
+	delete farLeft;
+	delete farRight;
+	delete nearLeft;
+	delete nearRight;
+}
+
+TEST_CASE( "DFN SemiGlobalMatching: configuration", "[configure]" )
+{
+	// Instantiate DFN
+	SemiGlobalMatching* semiGlobalMatching = new SemiGlobalMatching;
+
+	// Setup DFN
+	semiGlobalMatching->setConfigurationFile("../tests/ConfigurationFiles/DFNs/StereoReconstruction/SemiGlobalMatching_Conf1.yaml");
+	semiGlobalMatching->configure();
+
+	// Cleanup
+	delete semiGlobalMatching;
+}
+
+/** @} */
@@ -166,5 +166,84 @@ TEST_CASE( "Call to process (StereoRectification)", "[process]" )
     delete(inputFramePair);
 }
 
+namespace
+{
+    void FillFrame(asn1SccFrame& frame, const cv::Mat& image, asn1SccFrame_mode_t mode, const std::string& sensorId)
+    {
+        frame.msgVersion = frame_Version;
+
+        frame.metadata.msgVersion = frame_Version;
+        frame.metadata.status = asn1Sccstatus_VALID;
+        frame.metadata.pixelModel = asn1Sccpix_UNDEF;
+        frame.metadata.mode = mode;
+
+        frame.intrinsic.sensorId.nCount = static_cast<int>(sensorId.size() +1);
+        memcpy(frame.intrinsic.sensorId.arr, sensorId.c_str(), static_cast<size_t>(frame.intrinsic.sensorId.nCount));
+
+        frame.data.msgVersion = array3D_Version;
+        frame.data.rows = static_cast<asn1SccT_UInt32>(image.rows);
+        frame.data.cols = static_cast<asn1SccT_UInt32>(image.cols);
+        frame.data.channels = static_cast<asn1SccT_UInt32>(image.channels());
+        frame.data.depth = static_cast<asn1SccArray3D_depth_t>(image.depth());
+        frame.data.rowSize = image.step[0];
+        frame.data.data.nCount = static_cast<int>(frame.data.rows * frame.data.rowSize);
+        memcpy(frame.data.data.arr, image.data, static_cast<size_t>(frame.data.data.nCount));
+    }
+
+    cv::Mat ToMat(const asn1SccFrame& frame)
+    {
+        return cv::Mat(static_cast<int>(frame.data.rows), static_cast<int>(frame.data.cols), CV_MAKETYPE(static_cast<int>(frame.data.depth), static_cast<int>(frame.data.channels)), const_cast<asn1SccFrame&>(frame).data.data.arr, frame.data.rowSize).clone();
+    }
+}
+
+TEST_CASE( "Fixed-point maps and fused grayscale conversion (StereoRectification)", "[process]" )
+{
+    cv::Mat inputImageLeft = cv::imread("../tests/Data/Images/MinnieStereo/MinnieRawLeft.png", cv::IMREAD_COLOR);
+    cv::Mat inputImageRight = cv::imread("../tests/Data/Images/MinnieStereo/MinnieRawRight.png", cv::IMREAD_COLOR);
+
+    asn1SccFramePair *inputFramePair = new asn1SccFramePair();
+    asn1SccFramePair_Initialize(inputFramePair);
+    inputFramePair->msgVersion = frame_Version;
+    FillFrame(inputFramePair->left, inputImageLeft, asn1Sccmode_BGR, "tisc-33UP2000_17810171");
+    FillFrame(inputFramePair->right, inputImageRight, asn1Sccmode_BGR, "tisc-33UP2000_17810152");
+
+    CDFF::DFN::StereoRectification::StereoRectification* rectification = new CDFF::DFN::StereoRectification::StereoRectification();
+    rectification->parameters.calibrationFilePath = "../tests/Data/Images/MinnieStereo";
+    rectification->parameters.grayscale = true;
+
+    // Reference with floating point maps
+    rectification->parameters.fixedPointMaps = false;
+    rectification->originalStereoPairInput(*inputFramePair);
+    rectification->process();
+    cv::Mat floatLeft = ToMat(rectification->rectifiedStereoPairOutput().left);
+    cv::Mat floatRight = ToMat(rectification->rectifiedStereoPairOutput().right);
+
+    // The maps are regenerated in fixed-point form
+    rectification->parameters.fixedPointMaps = true;
+    rectification->process();
+    const asn1SccFramePair& output = rectification->rectifiedStereoPairOutput();
+
+    REQUIRE( output.left.data.channels == 1 );
+    REQUIRE( output.right.data.channels == 1 );
+    REQUIRE( output.left.metadata.mode == asn1Sccmode_GRAY );
+    REQUIRE( output.right.metadata.mode == asn1Sccmode_GRAY );
+
+    // The 1/32 pixel quantization of the maps changes the interpolated intensities by a few gray levels at most
+    cv::Mat fixedLeft = ToMat(output.left);
+    cv::Mat fixedRight = ToMat(output.right);
+    REQUIRE( fixedLeft.size() == floatLeft.size() );
+    REQUIRE( fixedRight.size() == floatRight.size() );
+    cv::Mat leftDifference, rightDifference;
+    cv::absdiff(fixedLeft, floatLeft, leftDifference);
+    cv::absdiff(fixedRight, floatRight, rightDifference);
+    double maximumDifference;
+    cv::minMaxLoc(leftDifference, NULL, &maximumDifference);
+    CHECK( maximumDifference <= 8 );
+    REQUIRE( cv::mean(leftDifference)[0] < 1 );
+    REQUIRE( cv::mean(rightDifference)[0] < 1 );
+
+    delete(rectification);
+    delete(inputFramePair);
+}
 
 /** @} */
@@ -127,4 +127,25 @@ TEST_CASE( "Success Call to Configure With Chain Parameters (DFPC configurator)"
 	REQUIRE( dynamic_cast<ShotDescriptor3D*>( configurator.GetDfn("3dDescriptor") ) != NULL);
 	}
 
+TEST_CASE( "Further DFN instances (DFPC configurator)", "[dfnInstances]" ) 
+	{
+	DfpcConfigurator configurator;
+	configurator.configure("../tests/ConfigurationFiles/DFPCs/dfns_chain_conf01.yaml");
+
+	CDFF::DFN::DFNCommonInterface* dfn = configurator.GetDfn("ZedImageUndistortion");
+	CDFF::DFN::DFNCommonInterface* secondInstance = configurator.GetDfnInstance("ZedImageUndistortion", 2);
+	CDFF::DFN::DFNCommonInterface* firstInstance = configurator.GetDfnInstance("ZedImageUndistortion", 1);
+
+	REQUIRE( configurator.GetDfnInstance("ZedImageUndistortion", 0) == dfn );
+	REQUIRE( dynamic_cast<ImageUndistortion*>( firstInstance ) != NULL );
+	REQUIRE( dynamic_cast<ImageUndistortion*>( secondInstance ) != NULL );
+	REQUIRE( firstInstance != dfn );
+	REQUIRE( secondInstance != dfn );
+	REQUIRE( secondInstance != firstInstance );
+	REQUIRE( configurator.GetDfnInstance("ZedImageUndistortion", 1) == firstInstance );
+
+	configurator.configure("../tests/ConfigurationFiles/DFPCs/dfns_chain_conf01.yaml");
+	REQUIRE( configurator.GetDfnInstance("ZedImageUndistortion", 2) == secondInstance );
+	}
+
 /** @} */
@@ -210,3 +210,52 @@ TEST_CASE( "Add and Get (BundleHistory)", "[AddAndGet]" )
 	delete(pointCloud2);
 	}
 
+
+TEST_CASE( "Shared data and recycled buffers (BundleHistory)", "[SharedData]" )
+	{
+	BundleHistory* bundleHistory = new BundleHistory(2);
+
+	FramePtr frame = NewFrame();
+	SetFrameSize(*frame, 1, 1);
+	AppendData(*frame, byte(0x2) );
+	PointCloudPtr pointCloud = NewPointCloud();
+	AddPoint(*pointCloud, 1, 1, 1);
+	PointCloudSharedPtr sharedCloud = NewSharedPointCloud();
+	AddPoint(*sharedCloud, 2, 2, 2);
+
+	bundleHistory->AddImages(*frame, *frame);
+	bundleHistory->AddPointCloud(sharedCloud, "shared");
+	bundleHistory->AddPointCloud(*pointCloud, "copied");
+	bundleHistory->AddPointCloud(*pointCloud, "discarded");
+	PointCloudConstPtr oldestCopy = bundleHistory->GetPointCloud(0, "copied");
+
+	REQUIRE( bundleHistory->GetPointCloud(0, "shared") == sharedCloud.get() );
+	REQUIRE( oldestCopy != pointCloud );
+	REQUIRE( GetXCoordinate(*oldestCopy, 0) == 1 );
+
+	bundleHistory->SetCategoryRetention("discarded", false);
+	bundleHistory->SetImagesRetention(false);
+	REQUIRE( bundleHistory->GetPointCloud(0, "discarded") == NULL );
+	REQUIRE( bundleHistory->GetLeftImage(0) == NULL );
+
+	bundleHistory->AddImages(*frame, *frame);
+	bundleHistory->AddPointCloud(*pointCloud, "copied");
+	bundleHistory->AddPointCloud(*pointCloud, "discarded");
+	REQUIRE( bundleHistory->GetPointCloud(0, "copied") != oldestCopy );
+	REQUIRE( bundleHistory->GetPointCloud(0, "discarded") == NULL );
+	REQUIRE( bundleHistory->GetLeftImage(0) == NULL );
+	REQUIRE( bundleHistory->GetRightImage(0) == NULL );
+
+	// The third entry replaces the oldest one, whose copy is reused
+	bundleHistory->AddImages(*frame, *frame);
+	AddPoint(*pointCloud, 3, 3, 3);
+	bundleHistory->AddPointCloud(*pointCloud, "copied");
+	REQUIRE( bundleHistory->GetPointCloud(0, "copied") == oldestCopy );
+	REQUIRE( GetNumberOfPoints(*oldestCopy) == 2 );
+	REQUIRE( bundleHistory->GetPointCloud(1, "copied") != NULL );
+	REQUIRE( GetNumberOfPoints(*bundleHistory->GetPointCloud(1, "copied")) == 1 );
+
+	delete(bundleHistory);
+	delete(frame);
+	delete(pointCloud);
+	}
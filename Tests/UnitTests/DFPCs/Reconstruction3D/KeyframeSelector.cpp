@@ -0,0 +1,146 @@
+/* --------------------------------------------------------------------------
+*
+* (C) Copyright …
+*
+* ---------------------------------------------------------------------------
+*/
+
+/*!
+ * @file KeyframeSelector.cpp
+ * @date 19/10/2026
+ * @author Alessandro Bianco
+ */
+
+/*!
+ * @addtogroup DFNsTest
+ * 
+ * Unit Test for the KeyframeSelector Class.
+ * 
+ * 
+ * @{
+ */
+
+/* --------------------------------------------------------------------------
+ *
+ * Includes
+ *
+ * --------------------------------------------------------------------------
+ */
+#include <catch.hpp>
+#include <Reconstruction3D/KeyframeSelector.hpp>
+#include <Errors/Assert.hpp>
+
+#include <cmath>
+
+using namespace CorrespondenceMap2DWrapper;
+using namespace VisualPointFeatureVector2DWrapper;
+using namespace PoseWrapper;
+using namespace CDFF::DFPC::Reconstruction3D;
+using namespace BaseTypesWrapper;
+
+/* --------------------------------------------------------------------------
+ *
+ * Test Cases
+ *
+ * --------------------------------------------------------------------------
+ */
+
+Pose3D MakePose(float x, float y, float z, float angleAroundZ)
+	{
+	Pose3D pose;
+	SetPosition(pose, x, y, z);
+	SetOrientation(pose, 0, 0, std::sin(angleAroundZ / 2), std::cos(angleAroundZ / 2));
+	return pose;
+	}
+
+TEST_CASE( "Without criteria every frame is a keyframe (KeyframeSelector)", "[NoCriteria]" )
+	{
+	KeyframeSelector selector;
+	REQUIRE( !selector.HasKeyframe() );
+	REQUIRE( selector.IsKeyframe( MakePose(0, 0, 0, 0) ) );
+
+	selector.SetKeyframe( MakePose(0, 0, 0, 0) );
+	REQUIRE( selector.HasKeyframe() );
+	REQUIRE( selector.IsKeyframe( MakePose(0, 0, 0, 0), 0 ) );
+	REQUIRE( !selector.UsesOverlap() );
+	REQUIRE( !selector.UsesTrackSurvival() );
+	}
+
+TEST_CASE( "Motion and overlap criteria (KeyframeSelector)", "[MotionAndOverlap]" )
+	{
+	KeyframeSelector selector;
+	selector.SetThresholds(1, 0.5, 0.6, 0);
+	REQUIRE( selector.IsKeyframe( MakePose(0, 0, 0, 0) ) );
+	selector.SetKeyframe( MakePose(0, 0, 0, 0) );
+
+	REQUIRE( !selector.IsKeyframe( MakePose(0.5, 0.5, 0, 0.3), 0.7 ) );
+	REQUIRE( selector.IsKeyframe( MakePose(0.8, 0.8, 0, 0), 0.7 ) );
+	REQUIRE( selector.IsKeyframe( MakePose(0, 0, 0, 0.6), 0.7 ) );
+	REQUIRE( selector.IsKeyframe( MakePose(0, 0, 0, -0.6), 0.7 ) );
+	REQUIRE( selector.IsKeyframe( MakePose(0, 0, 0, 0), 0.5 ) );
+
+	//The criteria are measured from the latest keyframe
+	selector.SetKeyframe( MakePose(0.8, 0.8, 0, 0.6) );
+	REQUIRE( !selector.IsKeyframe( MakePose(0.8, 0.8, 0, 0.6), 0.7 ) );
+	REQUIRE( selector.IsKeyframe( MakePose(0, 0, 0, 0), 0.7 ) );
+
+	selector.Reset();
+	REQUIRE( selector.IsKeyframe( MakePose(0.8, 0.8, 0, 0.6), 0.7 ) );
+	}
+
+TEST_CASE( "Tracks of the keyframe features (KeyframeSelector)", "[TrackSurvival]" )
+	{
+	KeyframeSelector selector;
+	selector.SetThresholds(0, 0, 0, 0.5);
+	REQUIRE( selector.UsesTrackSurvival() );
+
+	VisualPointFeatureVector2DPtr keyframeFeatures = NewVisualPointFeatureVector2D();
+	for(int featureIndex = 0; featureIndex < 10; featureIndex++)
+		{
+		AddPoint(*keyframeFeatures, 10 * featureIndex, 20);
+		}
+	selector.SetKeyframe( MakePose(0, 0, 0, 0), *keyframeFeatures);
+	REQUIRE( selector.GetTrackSurvivalRatio() == 1 );
+
+	//Six features are tracked into the next frame, the keypoints move by one pixel, and one new feature does not belong to any track
+	CorrespondenceMap2DPtr firstMap = NewCorrespondenceMap2D();
+	for(int featureIndex = 0; featureIndex < 6; featureIndex++)
+		{
+		Point2D source = { 10.0 * featureIndex + 1, 21 };
+		Point2D sink = { 10.0 * featureIndex, 20 };
+		AddCorrespondence(*firstMap, source, sink, 1);
+		}
+	Point2D newSource = { 200, 200 };
+	Point2D newSink = { 300, 300 };
+	AddCorrespondence(*firstMap, newSource, newSink, 1);
+	selector.TrackFeatures(*firstMap);
+	REQUIRE( std::fabs(selector.GetTrackSurvivalRatio() - 0.6) < 1e-6 );
+	REQUIRE( !selector.IsKeyframe( MakePose(0, 0, 0, 0) ) );
+
+	//Only the tracks that continued into the previous frame can be followed, the match of the new feature does not extend any track
+	CorrespondenceMap2DPtr secondMap = NewCorrespondenceMap2D();
+	for(int featureIndex = 0; featureIndex < 4; featureIndex++)
+		{
+		Point2D source = { 10.0 * featureIndex + 2, 22 };
+		Point2D sink = { 10.0 * featureIndex + 1, 21 };
+		AddCorrespondence(*secondMap, source, sink, 1);
+		}
+	Point2D lostSource = { 90, 22 };
+	Point2D lostSink = { 90, 20 };
+	AddCorrespondence(*secondMap, lostSource, lostSink, 1);
+	AddCorrespondence(*secondMap, newSink, newSource, 1);
+	selector.TrackFeatures(*secondMap);
+	REQUIRE( std::fabs(selector.GetTrackSurvivalRatio() - 0.4) < 1e-6 );
+	REQUIRE( selector.IsKeyframe( MakePose(0, 0, 0, 0) ) );
+
+	//A new keyframe starts new tracks
+	selector.SetKeyframe( MakePose(0, 0, 0, 0), *keyframeFeatures);
+	REQUIRE( selector.GetTrackSurvivalRatio() == 1 );
+	REQUIRE( !selector.IsKeyframe( MakePose(0, 0, 0, 0) ) );
+
+	delete(keyframeFeatures);
+	delete(firstMap);
+	delete(secondMap);
+	}
+
+/** @} */
@@ -30,11 +30,227 @@
 #include <Reconstruction3D/MultipleCorrespondences2DRecorder.hpp>
 #include <Errors/Assert.hpp>
 
+#include <random>
+
 using namespace CorrespondenceMap2DWrapper;
 using namespace PointCloudWrapper;
 using namespace CDFF::DFPC::Reconstruction3D;
 using namespace BaseTypesWrapper;
 
+/* --------------------------------------------------------------------------
+ *
+ * Helpers
+ *
+ * --------------------------------------------------------------------------
+ */
+
+//The keypoint of track t in the left (side 0) or right (side 1) image of pose p is (t, 2*p + side); visibilityList[t][2*p + side] tells whether the track is seen in that image
+typedef std::vector< std::vector<bool> > VisibilityList;
+
+static Point2D TrackKeypoint(int track, int pose, int side)
+	{
+	Point2D keypoint;
+	keypoint.x = track;
+	keypoint.y = 2*pose + side;
+	return keypoint;
+	}
+
+/*
+* The map from an image of sourcePose to an image of sinkPose contains the tracks visible in both. When a generator is given, some correspondences are preceded or followed by
+* a correspondence with the same source and a wrong sink, and some correspondences between keypoints that belong to no track are added.
+*/
+static CorrespondenceMap2DPtr CreateMap(const VisibilityList& visibilityList, int sourcePose, int sourceSide, int sinkPose, int sinkSide, std::mt19937* generator)
+	{
+	CorrespondenceMap2DPtr map = NewCorrespondenceMap2D();
+	std::uniform_int_distribution<int> eventDistribution(0, 9);
+	for(int track = 0; track < static_cast<int>(visibilityList.size()); track++)
+		{
+		if (!visibilityList.at(track).at(2*sourcePose + sourceSide) || !visibilityList.at(track).at(2*sinkPose + sinkSide))
+			{
+			continue;
+			}
+		Point2D source = TrackKeypoint(track, sourcePose, sourceSide);
+		Point2D wrongSink = TrackKeypoint(track + 1000, sinkPose, sinkSide);
+		int event = (generator == NULL) ? -1 : eventDistribution(*generator);
+		if (event == 0)
+			{
+			AddCorrespondence(*map, source, wrongSink, 1);
+			}
+		AddCorrespondence(*map, source, TrackKeypoint(track, sinkPose, sinkSide), 1);
+		if (event == 1)
+			{
+			AddCorrespondence(*map, source, wrongSink, 1);
+			}
+		if (event == 2)
+			{
+			AddCorrespondence(*map, TrackKeypoint(track + 2000, sourcePose, sourceSide), TrackKeypoint(track + 2000, sinkPose, sinkSide), 1);
+			}
+		}
+	return map;
+	}
+
+/*
+* Adds the maps of a new pose in the order expected by the recorder: left to right image of the new pose, then from the left image and from the right image of the new pose to the left and
+* right images of the older poses in the window, the most recent one first.
+*/
+static void AddPose(const VisibilityList& visibilityList, int pose, int maximumNumberOfPoses, std::mt19937* generator, const std::vector<MultipleCorrespondences2DRecorder*>& recordersList)
+	{
+	std::vector<CorrespondenceMap2DPtr> mapsList;
+	mapsList.push_back( CreateMap(visibilityList, pose, 0, pose, 1, generator) );
+	for(int side = 0; side < 2; side++)
+		{
+		for(int oldPose = pose - 1; oldPose >= 0 && oldPose > pose - maximumNumberOfPoses; oldPose--)
+			{
+			mapsList.push_back( CreateMap(visibilityList, pose, side, oldPose, 0, generator) );
+			mapsList.push_back( CreateMap(visibilityList, pose, side, oldPose, 1, generator) );
+			}
+		}
+
+	for(unsigned recorderIndex = 0; recorderIndex < recordersList.size(); recorderIndex++)
+		{
+		recordersList.at(recorderIndex)->InitializeNewSequence();
+		for(unsigned mapIndex = 0; mapIndex < mapsList.size(); mapIndex++)
+			{
+			recordersList.at(recorderIndex)->AddCorrespondences( mapsList.at(mapIndex) );
+			}
+		recordersList.at(recorderIndex)->CompleteNewSequence();
+		}
+
+	for(unsigned mapIndex = 0; mapIndex < mapsList.size(); mapIndex++)
+		{
+		delete(mapsList.at(mapIndex));
+		}
+	}
+
+static int FindSource(const CorrespondenceMap2D& map, Point2D point)
+	{
+	for(int index = 0; index < GetNumberOfCorrespondences(map); index++)
+		{
+		if (GetSource(map, index).x == point.x && GetSource(map, index).y == point.y)
+			{
+			return index;
+			}
+		}
+	return -1;
+	}
+
+/*
+* Reference filter, the linear search the recorder used before its maps were indexed by source keypoint: each correspondence of the first map is followed to the next maps by searching
+* its source, or the sink of the first map of the previous source image, and the last sink of each source image is checked against the one of the same track in the map reaching that image.
+*/
+static void FilterByLinearSearch(const CorrespondenceMaps2DSequence& sequence, int maximumNumberOfPoses, CorrespondenceMaps2DSequence& filteredSequence)
+	{
+	Copy(sequence, filteredSequence);
+	const int numberOfMaps = GetNumberOfCorrespondenceMaps(sequence);
+	REQUIRE( numberOfMaps == maximumNumberOfPoses * (2*maximumNumberOfPoses - 1) );
+
+	std::vector< std::vector<int> > validChainsList;
+	for(int firstIndex = 0; firstIndex < GetNumberOfCorrespondences( GetCorrespondenceMap(sequence, 0) ); firstIndex++)
+		{
+		std::vector<int> chain(1, firstIndex);
+		int mapIndex = 0;
+		int lastMapBySink = 0;
+		int lastIndexBySink = firstIndex;
+		bool valid = true;
+		for(int sourceImage = 0; sourceImage < 2*maximumNumberOfPoses - 1 && valid; sourceImage++)
+			{
+			for(int sinkImage = (sourceImage == 0 ? 2 : sourceImage + 1); sinkImage < 2*maximumNumberOfPoses && valid; sinkImage++)
+				{
+				mapIndex++;
+				bool firstOfSource = (sourceImage > 0 && sinkImage == sourceImage + 1);
+				Point2D point = firstOfSource ? GetSink( GetCorrespondenceMap(sequence, lastMapBySink), lastIndexBySink ) : GetSource( GetCorrespondenceMap(sequence, mapIndex - 1), chain.back() );
+				int index = FindSource( GetCorrespondenceMap(sequence, mapIndex), point );
+				valid = (index >= 0);
+				if (valid && mapIndex >= 2*maximumNumberOfPoses - 1)
+					{
+					int otherMapIndex = mapIndex - (2*maximumNumberOfPoses - 1 - sourceImage);
+					Point2D sink = GetSink( GetCorrespondenceMap(sequence, mapIndex), index );
+					Point2D otherSink = GetSink( GetCorrespondenceMap(sequence, otherMapIndex), chain.at(otherMapIndex) );
+					valid = (sink.x == otherSink.x && sink.y == otherSink.y);
+					}
+				if (valid)
+					{
+					chain.push_back(index);
+					if (firstOfSource)
+						{
+						lastMapBySink = mapIndex;
+						lastIndexBySink = index;
+						}
+					}
+				}
+			}
+		if (valid)
+			{
+			validChainsList.push_back(chain);
+			}
+		}
+
+	for(int mapIndex = 0; mapIndex < numberOfMaps; mapIndex++)
+		{
+		std::vector<BaseTypesWrapper::T_UInt32> removeIndexList;
+		for(int index = 0; index < GetNumberOfCorrespondences( GetCorrespondenceMap(sequence, mapIndex) ); index++)
+			{
+			bool found = false;
+			for(unsigned chainIndex = 0; chainIndex < validChainsList.size() && !found; chainIndex++)
+				{
+				found = (validChainsList.at(chainIndex).at(mapIndex) == index);
+				}
+			if (!found)
+				{
+				removeIndexList.push_back(index);
+				}
+			}
+		RemoveCorrespondences(filteredSequence, mapIndex, removeIndexList);
+		}
+	}
+
+static bool SameSequence(const CorrespondenceMaps2DSequence& sequence1, const CorrespondenceMaps2DSequence& sequence2)
+	{
+	if (GetNumberOfCorrespondenceMaps(sequence1) != GetNumberOfCorrespondenceMaps(sequence2))
+		{
+		return false;
+		}
+	for(unsigned mapIndex = 0; mapIndex < GetNumberOfCorrespondenceMaps(sequence1); mapIndex++)
+		{
+		const CorrespondenceMap2D& map1 = GetCorrespondenceMap(sequence1, mapIndex);
+		const CorrespondenceMap2D& map2 = GetCorrespondenceMap(sequence2, mapIndex);
+		if (GetNumberOfCorrespondences(map1) != GetNumberOfCorrespondences(map2))
+			{
+			return false;
+			}
+		for(int index = 0; index < GetNumberOfCorrespondences(map1); index++)
+			{
+			if (GetSource(map1, index).x != GetSource(map2, index).x || GetSource(map1, index).y != GetSource(map2, index).y ||
+				GetSink(map1, index).x != GetSink(map2, index).x || GetSink(map1, index).y != GetSink(map2, index).y)
+				{
+				return false;
+				}
+			}
+		}
+	return true;
+	}
+
+//Every map of the sequence contains exactly the listed tracks, in order
+static bool ContainsExactlyTracks(const CorrespondenceMaps2DSequence& sequence, const std::vector<int>& tracksList)
+	{
+	for(unsigned mapIndex = 0; mapIndex < GetNumberOfCorrespondenceMaps(sequence); mapIndex++)
+		{
+		const CorrespondenceMap2D& map = GetCorrespondenceMap(sequence, mapIndex);
+		if (GetNumberOfCorrespondences(map) != static_cast<int>(tracksList.size()))
+			{
+			return false;
+			}
+		for(int index = 0; index < GetNumberOfCorrespondences(map); index++)
+			{
+			if (GetSource(map, index).x != tracksList.at(index) || GetSink(map, index).x != tracksList.at(index))
+				{
+				return false;
+				}
+			}
+		}
+	return true;
+	}
+
 /* --------------------------------------------------------------------------
  *
  * Test Cases
@@ -693,4 +909,123 @@ TEST_CASE( "Add and Get with Filter(MultipleCorrespondences2DRecorder)", "[AddAn
 	delete(mapR4R2);
 	}
 
+TEST_CASE( "Filtered tracks follow the sliding window (MultipleCorrespondences2DRecorder)", "[Filter]" )
+	{
+	const int MAXIMUM_NUMBER_OF_POSES = 3;
+	const int NUMBER_OF_POSES = 5;
+
+	//Track 0 is always visible, track 1 until pose 2, track 2 from pose 1, track 3 from pose 2 but not in the right image of pose 3, track 4 except in the left image of pose 0,
+	//track 5 from pose 2
+	VisibilityList visibilityList(6, std::vector<bool>(2*NUMBER_OF_POSES, true));
+	for(int image = 0; image < 2*NUMBER_OF_POSES; image++)
+		{
+		visibilityList.at(1).at(image) = (image < 6);
+		visibilityList.at(2).at(image) = (image >= 2);
+		visibilityList.at(3).at(image) = (image >= 4 && image != 7);
+		visibilityList.at(5).at(image) = (image >= 4);
+		}
+	visibilityList.at(4).at(0) = false;
+
+	MultipleCorrespondences2DRecorder* recorder = new MultipleCorrespondences2DRecorder(MAXIMUM_NUMBER_OF_POSES, true);
+	std::vector<MultipleCorrespondences2DRecorder*> recordersList(1, recorder);
+	for(int pose = 0; pose < 3; pose++)
+		{
+		AddPose(visibilityList, pose, MAXIMUM_NUMBER_OF_POSES, NULL, recordersList);
+		}
+	CorrespondenceMaps2DSequenceConstPtr sequence2 = recorder->GetLatestCorrespondences();
+	REQUIRE( GetNumberOfCorrespondenceMaps(*sequence2) == 15 );
+	REQUIRE( ContainsExactlyTracks(*sequence2, std::vector<int>{0, 1}) );
+
+	AddPose(visibilityList, 3, MAXIMUM_NUMBER_OF_POSES, NULL, recordersList);
+	CorrespondenceMaps2DSequenceConstPtr sequence3 = recorder->GetLatestCorrespondences();
+	REQUIRE( GetNumberOfCorrespondenceMaps(*sequence3) == 15 );
+	REQUIRE( ContainsExactlyTracks(*sequence3, std::vector<int>{0, 2, 4}) );
+
+	//A discarded pose restores the filtered window of the previous one
+	VisibilityList hiddenList(6, std::vector<bool>(2*NUMBER_OF_POSES, false));
+	AddPose(hiddenList, 4, MAXIMUM_NUMBER_OF_POSES, NULL, recordersList);
+	REQUIRE( ContainsExactlyTracks(*recorder->GetLatestCorrespondences(), std::vector<int>()) );
+	recorder->DiscardLatestCorrespondences();
+	REQUIRE( ContainsExactlyTracks(*recorder->GetLatestCorrespondences(), std::vector<int>{0, 2, 4}) );
+
+	AddPose(visibilityList, 4, MAXIMUM_NUMBER_OF_POSES, NULL, recordersList);
+	CorrespondenceMaps2DSequenceConstPtr sequence4 = recorder->GetLatestCorrespondences();
+	REQUIRE( GetNumberOfCorrespondenceMaps(*sequence4) == 15 );
+	REQUIRE( ContainsExactlyTracks(*sequence4, std::vector<int>{0, 2, 4, 5}) );
+
+	delete(recorder);
+	}
+
+TEST_CASE( "Tracks needing maps beyond the sequence are rejected (MultipleCorrespondences2DRecorder)", "[Filter]" )
+	{
+	const int MAXIMUM_NUMBER_OF_POSES = 3;
+	VisibilityList visibilityList(4, std::vector<bool>(2*MAXIMUM_NUMBER_OF_POSES, true));
+
+	MultipleCorrespondences2DRecorder* recorder = new MultipleCorrespondences2DRecorder(MAXIMUM_NUMBER_OF_POSES, true);
+	std::vector<MultipleCorrespondences2DRecorder*> recordersList(1, recorder);
+
+	//A single map is shorter than any chain and is returned as it is
+	AddPose(visibilityList, 0, MAXIMUM_NUMBER_OF_POSES, NULL, recordersList);
+	CorrespondenceMaps2DSequenceConstPtr sequence0 = recorder->GetLatestCorrespondences();
+	REQUIRE( GetNumberOfCorrespondenceMaps(*sequence0) == 1 );
+	REQUIRE( ContainsExactlyTracks(*sequence0, std::vector<int>{0, 1, 2, 3}) );
+
+	//With two poses every chain continues into the maps of a third pose, which are not in the sequence yet, so no track is kept
+	AddPose(visibilityList, 1, MAXIMUM_NUMBER_OF_POSES, NULL, recordersList);
+	CorrespondenceMaps2DSequenceConstPtr sequence1 = recorder->GetLatestCorrespondences();
+	REQUIRE( GetNumberOfCorrespondenceMaps(*sequence1) == 6 );
+	REQUIRE( ContainsExactlyTracks(*sequence1, std::vector<int>()) );
+
+	//Once the window is full the tracks are kept
+	AddPose(visibilityList, 2, MAXIMUM_NUMBER_OF_POSES, NULL, recordersList);
+	CorrespondenceMaps2DSequenceConstPtr sequence2 = recorder->GetLatestCorrespondences();
+	REQUIRE( GetNumberOfCorrespondenceMaps(*sequence2) == 15 );
+	REQUIRE( ContainsExactlyTracks(*sequence2, std::vector<int>{0, 1, 2, 3}) );
+
+	delete(recorder);
+	}
+
+TEST_CASE( "Filter agrees with a linear search of the tracks (MultipleCorrespondences2DRecorder)", "[Filter]" )
+	{
+	const int NUMBER_OF_TRACKS = 60;
+	const int NUMBER_OF_POSES = 8;
+	std::mt19937 generator(7);
+	std::bernoulli_distribution visibleDistribution(0.93);
+
+	for(int maximumNumberOfPoses = 2; maximumNumberOfPoses <= 4; maximumNumberOfPoses++)
+		{
+		VisibilityList visibilityList(NUMBER_OF_TRACKS, std::vector<bool>(2*NUMBER_OF_POSES));
+		for(int track = 0; track < NUMBER_OF_TRACKS; track++)
+			{
+			for(int image = 0; image < 2*NUMBER_OF_POSES; image++)
+				{
+				visibilityList.at(track).at(image) = visibleDistribution(generator);
+				}
+			}
 
+		//The unfiltered recorder provides the input of the reference filter
+		MultipleCorrespondences2DRecorder* filteredRecorder = new MultipleCorrespondences2DRecorder(maximumNumberOfPoses, true);
+		MultipleCorrespondences2DRecorder* recorder = new MultipleCorrespondences2DRecorder(maximumNumberOfPoses, false);
+		std::vector<MultipleCorrespondences2DRecorder*> recordersList;
+		recordersList.push_back(filteredRecorder);
+		recordersList.push_back(recorder);
+		CorrespondenceMaps2DSequencePtr referenceSequence = NewCorrespondenceMaps2DSequence();
+		int numberOfKeptTracks = 0;
+		for(int pose = 0; pose < NUMBER_OF_POSES; pose++)
+			{
+			AddPose(visibilityList, pose, maximumNumberOfPoses, &generator, recordersList);
+			if (pose + 1 < maximumNumberOfPoses)
+				{
+				continue;
+				}
+			FilterByLinearSearch(*recorder->GetLatestCorrespondences(), maximumNumberOfPoses, *referenceSequence);
+			REQUIRE( SameSequence(*filteredRecorder->GetLatestCorrespondences(), *referenceSequence) );
+			numberOfKeptTracks += GetNumberOfCorrespondences( GetCorrespondenceMap(*referenceSequence, 0) );
+			}
+		REQUIRE( numberOfKeptTracks > 0 );
+
+		delete(filteredRecorder);
+		delete(recorder);
+		delete(referenceSequence);
+		}
+	}
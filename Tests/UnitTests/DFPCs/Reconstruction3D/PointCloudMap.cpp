@@ -30,6 +30,10 @@
 #include <Reconstruction3D/PointCloudMap.hpp>
 #include <Errors/Assert.hpp>
 
+#include <stdlib.h>
+#include <unistd.h>
+#include <vector>
+
 using namespace VisualPointFeatureVector3DWrapper;
 using namespace PointCloudWrapper;
 using namespace CDFF::DFPC::Reconstruction3D;
@@ -437,3 +441,492 @@ TEST_CASE( "Add and Get 3 (PointCloudMap)", "[AddAndGet]" )
 	delete(featureCloud1);
 	delete(featureCloud2);
 	}
+
+TEST_CASE( "Points in the same voxel are merged (PointCloudMap)", "[VoxelMerging]" ) 
+	{
+	PointCloudMap* map = new PointCloudMap();
+	map->SetResolution(0.1);
+
+	PointCloudPtr cloud1 = NewPointCloud();
+	PointCloudPtr cloud2 = NewPointCloud();
+	AddPoint(*cloud1, 1.01, 1.01, 1.01);
+	AddPoint(*cloud1, 2.05, 2.05, 2.05);
+	AddPoint(*cloud2, 1.03, 1.03, 1.03);
+	AddPoint(*cloud2, 1.08, 1.08, 1.08);
+
+	VisualPointFeatureVector3DPtr emptyVector = NewVisualPointFeatureVector3D();
+	Pose3DPtr pose = NewPose3D();
+	SetPosition(*pose, 0, 0, 0);
+	SetOrientation(*pose, 0, 0, 0, 1);
+
+	map->AddPointCloud(cloud1, emptyVector, pose);
+	map->AddPointCloud(cloud2, emptyVector, pose);
+
+	PointCloudConstPtr sceneCloud1 = map->GetScenePointCloud(pose, 100);
+	REQUIRE( GetNumberOfPoints(*sceneCloud1) == 2 );
+	REQUIRE( CLOSE_POINT( *sceneCloud1, 0, 1.04, 1.04, 1.04) );
+	REQUIRE( CLOSE_POINT( *sceneCloud1, 1, 2.05, 2.05, 2.05) );
+
+	//All points fall in the same voxel at the coarser resolution, the centroid is weighted by the number of points merged in each voxel
+	map->SetResolution(10);
+	PointCloudConstPtr sceneCloud2 = map->GetScenePointCloud(pose, 100);
+	REQUIRE( GetNumberOfPoints(*sceneCloud2) == 1 );
+	REQUIRE( CLOSE_POINT( *sceneCloud2, 0, 1.2925, 1.2925, 1.2925) );
+
+	delete(map);
+	delete(cloud1);
+	delete(cloud2);
+	delete(emptyVector);
+	delete(pose);
+	delete(sceneCloud1);
+	delete(sceneCloud2);
+	}
+
+TEST_CASE( "Radius queries match an exhaustive search (PointCloudMap)", "[RadiusQuery]" ) 
+	{
+	PointCloudMap* map = new PointCloudMap();
+	map->SetResolution(0.05);
+
+	PointCloudPtr cloud = NewPointCloud();
+	VisualPointFeatureVector3DPtr featuresVector = NewVisualPointFeatureVector3D();
+	for(int pointIndex = 0; pointIndex < 5000; pointIndex++)
+		{
+		float x = static_cast<float>( (pointIndex * 7919) % 1000 ) / 100 - 5;
+		float y = static_cast<float>( (pointIndex * 104729) % 1000 ) / 100 - 5;
+		float z = static_cast<float>( (pointIndex * 3571) % 1000 ) / 100 - 5;
+		AddPoint(*cloud, x, y, z);
+		if (pointIndex % 10 == 0)
+			{
+			AddPoint(*featuresVector, x, y, z);
+			}
+		}
+
+	Pose3DPtr pose = NewPose3D();
+	SetPosition(*pose, 0, 0, 0);
+	SetOrientation(*pose, 0, 0, 0, 1);
+	map->AddPointCloud(cloud, featuresVector, pose);
+
+	PointCloudConstPtr fullCloud = map->GetScenePointCloud(pose, -1);
+	VisualPointFeatureVector3DConstPtr fullFeaturesVector = map->GetSceneFeaturesVector(pose, -1);
+	REQUIRE( GetNumberOfPoints(*fullCloud) > 0 );
+	REQUIRE( GetNumberOfPoints(*fullFeaturesVector) > 0 );
+
+	const float radiusList[4] = { 0.3, 1.7, 4.2, 20 };
+	for(int radiusIndex = 0; radiusIndex < 4; radiusIndex++)
+		{
+		float radius = radiusList[radiusIndex];
+		Pose3DPtr origin = NewPose3D();
+		SetPosition(*origin, 0.9, -1.3, 2.1);
+		SetOrientation(*origin, 0, 0, 0, 1);
+
+		int expectedNumberOfPoints = 0;
+		for(int pointIndex = 0; pointIndex < GetNumberOfPoints(*fullCloud); pointIndex++)
+			{
+			float dx = GetXCoordinate(*fullCloud, pointIndex) - 0.9;
+			float dy = GetYCoordinate(*fullCloud, pointIndex) + 1.3;
+			float dz = GetZCoordinate(*fullCloud, pointIndex) - 2.1;
+			expectedNumberOfPoints += (dx*dx + dy*dy + dz*dz <= radius*radius) ? 1 : 0;
+			}
+		int expectedNumberOfFeatures = 0;
+		for(int featureIndex = 0; featureIndex < GetNumberOfPoints(*fullFeaturesVector); featureIndex++)
+			{
+			float dx = GetXCoordinate(*fullFeaturesVector, featureIndex) - 0.9;
+			float dy = GetYCoordinate(*fullFeaturesVector, featureIndex) + 1.3;
+			float dz = GetZCoordinate(*fullFeaturesVector, featureIndex) - 2.1;
+			expectedNumberOfFeatures += (dx*dx + dy*dy + dz*dz <= radius*radius) ? 1 : 0;
+			}
+
+		PointCloudConstPtr sceneCloud = map->GetScenePointCloud(origin, radius);
+		VisualPointFeatureVector3DConstPtr sceneFeaturesVector = map->GetSceneFeaturesVector(origin, radius);
+		REQUIRE( GetNumberOfPoints(*sceneCloud) == expectedNumberOfPoints );
+		REQUIRE( GetNumberOfPoints(*sceneFeaturesVector) == expectedNumberOfFeatures );
+
+		delete(origin);
+		delete(sceneCloud);
+		delete(sceneFeaturesVector);
+		}
+
+	delete(map);
+	delete(cloud);
+	delete(featuresVector);
+	delete(pose);
+	delete(fullCloud);
+	delete(fullFeaturesVector);
+	}
+
+TEST_CASE( "Close features are merged and descriptors are kept (PointCloudMap)", "[FeaturesDeduplication]" ) 
+	{
+	const int DESCRIPTOR_LENGTH = 33;
+	PointCloudMap* map = new PointCloudMap();
+	map->SetResolution(0.01);
+
+	PointCloudPtr emptyCloud = NewPointCloud();
+	VisualPointFeatureVector3DPtr featuresVector = NewVisualPointFeatureVector3D();
+	const float xList[4] = { 0, 0.005, 0.011, -0.009 };
+	for(int featureIndex = 0; featureIndex < 4; featureIndex++)
+		{
+		AddPoint(*featuresVector, xList[featureIndex], 0, 0);
+		for(int componentIndex = 0; componentIndex < DESCRIPTOR_LENGTH; componentIndex++)
+			{
+			AddDescriptorComponent(*featuresVector, featureIndex, featureIndex * 100 + componentIndex);
+			}
+		}
+
+	Pose3DPtr pose = NewPose3D();
+	SetPosition(*pose, 0, 0, 0);
+	SetOrientation(*pose, 0, 0, 0, 1);
+	map->AddPointCloud(emptyCloud, featuresVector, pose);
+
+	//The second and fourth features are closer than the resolution to the first one
+	VisualPointFeatureVector3DConstPtr sceneFeaturesVector = map->GetSceneFeaturesVector(pose, -1);
+	REQUIRE( GetNumberOfPoints(*sceneFeaturesVector) == 2 );
+	REQUIRE( CLOSE( GetXCoordinate(*sceneFeaturesVector, 0), 0) );
+	REQUIRE( CLOSE( GetXCoordinate(*sceneFeaturesVector, 1), 0.011) );
+	for(int featureIndex = 0; featureIndex < 2; featureIndex++)
+		{
+		REQUIRE( GetNumberOfDescriptorComponents(*sceneFeaturesVector, featureIndex) == DESCRIPTOR_LENGTH );
+		}
+	REQUIRE( GetDescriptorComponent(*sceneFeaturesVector, 0, 5) == 5 );
+	REQUIRE( GetDescriptorComponent(*sceneFeaturesVector, 1, 7) == 207 );
+
+	//A new cloud is deduplicated against the features already in the map
+	map->AddPointCloud(emptyCloud, featuresVector, pose);
+	VisualPointFeatureVector3DConstPtr sceneFeaturesVector2 = map->GetSceneFeaturesVector(pose, -1);
+	REQUIRE( GetNumberOfPoints(*sceneFeaturesVector2) == 2 );
+
+	delete(map);
+	delete(emptyCloud);
+	delete(featuresVector);
+	delete(pose);
+	delete(sceneFeaturesVector);
+	delete(sceneFeaturesVector2);
+	}
+
+TEST_CASE( "Evicted tiles give the same results (PointCloudMap)", "[MemoryBudget]" ) 
+	{
+	const int DESCRIPTOR_LENGTH = 4;
+	const size_t MEMORY_BUDGET = 30000;
+	PointCloudMap* unlimitedMap = new PointCloudMap();
+	PointCloudMap* budgetMap = new PointCloudMap();
+	unlimitedMap->SetResolution(0.1);
+	budgetMap->SetResolution(0.1);
+	unlimitedMap->SetLevelsOfDetail(3, 8);
+	budgetMap->SetLevelsOfDetail(3, 8);
+
+	//The swap files go to a temporary folder of this test, which is empty again once the map is destroyed
+	char swapFolderPath[] = "/tmp/PointCloudMapTest_XXXXXX";
+	REQUIRE( mkdtemp(swapFolderPath) != NULL );
+	budgetMap->SetMemoryBudget(MEMORY_BUDGET, swapFolderPath);
+
+	//The clouds are 10 meters apart along the x axis, the last one revisits the area of the first one
+	const int NUMBER_OF_CLOUDS = 12;
+	Pose3DPtr pose = NewPose3D();
+	for(int cloudIndex = 0; cloudIndex <= NUMBER_OF_CLOUDS; cloudIndex++)
+		{
+		PointCloudPtr cloud = NewPointCloud();
+		VisualPointFeatureVector3DPtr featuresVector = NewVisualPointFeatureVector3D();
+		for(int pointIndex = 0; pointIndex < 500; pointIndex++)
+			{
+			float x = static_cast<float>( (pointIndex * 7919 + cloudIndex) % 500 ) / 100;
+			float y = static_cast<float>( (pointIndex * 104729) % 500 ) / 100 - 2.5;
+			float z = static_cast<float>( (pointIndex * 3571) % 500 ) / 100 - 2.5;
+			AddPoint(*cloud, x, y, z);
+			if (pointIndex % 10 == 0)
+				{
+				AddPoint(*featuresVector, x, y, z);
+				for(int componentIndex = 0; componentIndex < DESCRIPTOR_LENGTH; componentIndex++)
+					{
+					AddDescriptorComponent(*featuresVector, pointIndex / 10, cloudIndex * 1000 + pointIndex + componentIndex);
+					}
+				}
+			}
+
+		SetPosition(*pose, -10 * (cloudIndex % NUMBER_OF_CLOUDS), 0, 0);
+		SetOrientation(*pose, 0, 0, 0, 1);
+		unlimitedMap->AddPointCloud(cloud, featuresVector, pose);
+		budgetMap->AddPointCloud(cloud, featuresVector, pose);
+		REQUIRE( budgetMap->GetResidentMemoryUsage() <= MEMORY_BUDGET );
+
+		delete(cloud);
+		delete(featuresVector);
+		}
+	REQUIRE( unlimitedMap->GetResidentMemoryUsage() > MEMORY_BUDGET );
+
+	const float radiusList[3] = { -1, 3, 12 };
+	for(int radiusIndex = 0; radiusIndex < 3; radiusIndex++)
+		{
+		SetPosition(*pose, 52.5, 0.3, -0.2);
+		PointCloudConstPtr unlimitedCloud = unlimitedMap->GetScenePointCloud(pose, radiusList[radiusIndex]);
+		PointCloudConstPtr budgetCloud = budgetMap->GetScenePointCloud(pose, radiusList[radiusIndex]);
+		REQUIRE( GetNumberOfPoints(*unlimitedCloud) > 0 );
+		REQUIRE( GetNumberOfPoints(*budgetCloud) == GetNumberOfPoints(*unlimitedCloud) );
+		for(int pointIndex = 0; pointIndex < GetNumberOfPoints(*unlimitedCloud); pointIndex++)
+			{
+			REQUIRE( CLOSE_POINT(*budgetCloud, pointIndex, GetXCoordinate(*unlimitedCloud, pointIndex), GetYCoordinate(*unlimitedCloud, pointIndex), GetZCoordinate(*unlimitedCloud, pointIndex)) );
+			}
+
+		VisualPointFeatureVector3DConstPtr unlimitedFeatures = unlimitedMap->GetSceneFeaturesVector(pose, radiusList[radiusIndex]);
+		VisualPointFeatureVector3DConstPtr budgetFeatures = budgetMap->GetSceneFeaturesVector(pose, radiusList[radiusIndex]);
+		REQUIRE( GetNumberOfPoints(*unlimitedFeatures) > 0 );
+		REQUIRE( GetNumberOfPoints(*budgetFeatures) == GetNumberOfPoints(*unlimitedFeatures) );
+		for(int featureIndex = 0; featureIndex < GetNumberOfPoints(*unlimitedFeatures); featureIndex++)
+			{
+			REQUIRE( CLOSE_POINT(*budgetFeatures, featureIndex, GetXCoordinate(*unlimitedFeatures, featureIndex), GetYCoordinate(*unlimitedFeatures, featureIndex), GetZCoordinate(*unlimitedFeatures, featureIndex)) );
+			REQUIRE( GetDescriptorComponent(*budgetFeatures, featureIndex, DESCRIPTOR_LENGTH - 1) == GetDescriptorComponent(*unlimitedFeatures, featureIndex, DESCRIPTOR_LENGTH - 1) );
+			}
+
+		PointCloudConstPtr unlimitedDetailCloud = unlimitedMap->GetScenePointCloudInOrigin(pose, radiusList[radiusIndex], 2000);
+		PointCloudConstPtr budgetDetailCloud = budgetMap->GetScenePointCloudInOrigin(pose, radiusList[radiusIndex], 2000);
+		REQUIRE( GetNumberOfPoints(*budgetDetailCloud) == GetNumberOfPoints(*unlimitedDetailCloud) );
+		for(int pointIndex = 0; pointIndex < GetNumberOfPoints(*unlimitedDetailCloud); pointIndex++)
+			{
+			REQUIRE( CLOSE_POINT(*budgetDetailCloud, pointIndex, GetXCoordinate(*unlimitedDetailCloud, pointIndex), GetYCoordinate(*unlimitedDetailCloud, pointIndex), GetZCoordinate(*unlimitedDetailCloud, pointIndex)) );
+			}
+
+		delete(unlimitedCloud);
+		delete(budgetCloud);
+		delete(unlimitedDetailCloud);
+		delete(budgetDetailCloud);
+		delete(unlimitedFeatures);
+		delete(budgetFeatures);
+		}
+
+	//The overlap with the area of the first clouds reads back their evicted tiles, the budget is still met afterwards
+	PointCloudPtr overlapCloud = NewPointCloud();
+	for(int pointIndex = 0; pointIndex < 500; pointIndex++)
+		{
+		AddPoint(*overlapCloud, static_cast<float>(pointIndex % 100) / 10, static_cast<float>(pointIndex / 100) / 2 - 1, 0);
+		}
+	for(int cloudIndex = 1; cloudIndex < NUMBER_OF_CLOUDS; cloudIndex += 3)
+		{
+		SetPosition(*pose, -10 * cloudIndex, 0, 0);
+		SetOrientation(*pose, 0, 0, 0, 1);
+		float unlimitedRatio = unlimitedMap->ComputeOverlapRatio(overlapCloud, pose);
+		REQUIRE( unlimitedRatio > 0 );
+		REQUIRE( CLOSE( budgetMap->ComputeOverlapRatio(overlapCloud, pose), unlimitedRatio) );
+		REQUIRE( budgetMap->GetResidentMemoryUsage() <= MEMORY_BUDGET );
+		}
+
+	delete(unlimitedMap);
+	delete(budgetMap);
+	delete(pose);
+	delete(overlapCloud);
+	REQUIRE( rmdir(swapFolderPath) == 0 );
+	}
+
+TEST_CASE( "Level of detail output is coarser far away and fits the points budget (PointCloudMap)", "[LevelOfDetail]" ) 
+	{
+	PointCloudMap* map = new PointCloudMap();
+	map->SetResolution(0.02);
+
+	//A flat grid with one point per voxel at full resolution, a tile is 1.28 meters wide
+	PointCloudPtr cloud = NewPointCloud();
+	for(int xIndex = 0; xIndex < 300; xIndex++)
+		{
+		for(int yIndex = 0; yIndex < 300; yIndex++)
+			{
+			AddPoint(*cloud, xIndex * 0.04 - 5.99, yIndex * 0.04 - 5.99, 0.01);
+			}
+		}
+	VisualPointFeatureVector3DPtr emptyVector = NewVisualPointFeatureVector3D();
+	Pose3DPtr pose = NewPose3D();
+	SetPosition(*pose, 0, 0, 0);
+	SetOrientation(*pose, 0, 0, 0, 1);
+	map->AddPointCloud(cloud, emptyVector, pose);
+	map->SetLevelsOfDetail(4, 2);
+
+	Pose3DPtr origin = NewPose3D();
+	SetPosition(*origin, 0.64, 0.64, 0);
+	SetOrientation(*origin, 0, 0, 0, 1);
+	PointCloudConstPtr fullCloud = map->GetScenePointCloudInOrigin(origin, -1);
+	PointCloudConstPtr detailCloud = map->GetScenePointCloudInOrigin(origin, -1, 0);
+	PointCloudConstPtr budgetCloud = map->GetScenePointCloudInOrigin(origin, -1, 5000);
+	REQUIRE( GetNumberOfPoints(*fullCloud) == 90000 );
+	REQUIRE( GetNumberOfPoints(*detailCloud) < GetNumberOfPoints(*fullCloud) );
+	REQUIRE( GetNumberOfPoints(*budgetCloud) > 0 );
+	REQUIRE( GetNumberOfPoints(*budgetCloud) <= 5000 );
+
+	//Near the center the points are at full resolution
+	const float distanceList[2] = { 1, 0.3 };
+	PointCloudConstPtr cloudsList[2] = { detailCloud, budgetCloud };
+	for(int cloudIndex = 0; cloudIndex < 2; cloudIndex++)
+		{
+		int numberOfCloseFullPoints = 0;
+		for(int pointIndex = 0; pointIndex < GetNumberOfPoints(*fullCloud); pointIndex++)
+			{
+			float x = GetXCoordinate(*fullCloud, pointIndex);
+			float y = GetYCoordinate(*fullCloud, pointIndex);
+			numberOfCloseFullPoints += (x*x + y*y < distanceList[cloudIndex] * distanceList[cloudIndex]) ? 1 : 0;
+			}
+		int numberOfCloseDetailPoints = 0;
+		for(int pointIndex = 0; pointIndex < GetNumberOfPoints(*cloudsList[cloudIndex]); pointIndex++)
+			{
+			float x = GetXCoordinate(*cloudsList[cloudIndex], pointIndex);
+			float y = GetYCoordinate(*cloudsList[cloudIndex], pointIndex);
+			numberOfCloseDetailPoints += (x*x + y*y < distanceList[cloudIndex] * distanceList[cloudIndex]) ? 1 : 0;
+			}
+		REQUIRE( numberOfCloseFullPoints > 0 );
+		REQUIRE( numberOfCloseDetailPoints == numberOfCloseFullPoints );
+		}
+
+	//With a single level the output is the full resolution cloud
+	map->SetLevelsOfDetail(1, 2);
+	PointCloudConstPtr singleLevelCloud = map->GetScenePointCloudInOrigin(origin, -1, 0);
+	REQUIRE( GetNumberOfPoints(*singleLevelCloud) == GetNumberOfPoints(*fullCloud) );
+
+	delete(map);
+	delete(cloud);
+	delete(emptyVector);
+	delete(pose);
+	delete(origin);
+	delete(fullCloud);
+	delete(detailCloud);
+	delete(budgetCloud);
+	delete(singleLevelCloud);
+	}
+
+TEST_CASE( "Attached poses move the camera and overlap is measured against the map (PointCloudMap)", "[Keyframes]" ) 
+	{
+	PointCloudMap* map = new PointCloudMap();
+	map->SetResolution(0.1);
+
+	//A plane of 10x10 points with a spacing equal to the resolution, in front of the camera
+	PointCloudPtr cloud = NewPointCloud();
+	for(int x = 0; x < 10; x++)
+		{
+		for(int y = 0; y < 10; y++)
+			{
+			AddPoint(*cloud, 0.1*x + 0.05, 0.1*y + 0.05, 1.05);
+			}
+		}
+	VisualPointFeatureVector3DPtr emptyVector = NewVisualPointFeatureVector3D();
+	Pose3DPtr pose = NewPose3D();
+	SetPosition(*pose, 0, 0, 0);
+	SetOrientation(*pose, 0, 0, 0, 1);
+	map->AddPointCloud(cloud, emptyVector, pose);
+	REQUIRE( CLOSE( map->ComputeOverlapRatio(cloud, pose), 1) );
+
+	//Attaching a pose moves the camera without adding points
+	Pose3DPtr displacement = NewPose3D();
+	SetPosition(*displacement, 0.5, 0, 0);
+	SetOrientation(*displacement, 0, 0, 0, 1);
+	map->AttachPose(displacement);
+	REQUIRE( CLOSE_POSITION(map->GetLatestPose(), 0.5, 0, 0) );
+	REQUIRE( CLOSE_ORIENTATION(map->GetLatestPose(), 0, 0, 0, 1) );
+	PointCloudConstPtr sceneCloud = map->GetScenePointCloud(pose, -1);
+	REQUIRE( GetNumberOfPoints(*sceneCloud) == 100 );
+
+	//Half of the plane seen from the moved camera is in the map, and one more column of points is within one voxel from it
+	REQUIRE( CLOSE( map->ComputeOverlapRatio(cloud, &map->GetLatestPose()), 0.6) );
+
+	//The following cloud is attached relative to the attached pose
+	map->AttachPointCloud(cloud, emptyVector, displacement);
+	REQUIRE( CLOSE_POSITION(map->GetLatestPose(), 1, 0, 0) );
+	PointCloudConstPtr extendedCloud = map->GetScenePointCloud(pose, -1);
+	REQUIRE( GetNumberOfPoints(*extendedCloud) == 200 );
+
+	//Far away the cloud does not overlap the map
+	SetPosition(*pose, 100, 0, 0);
+	REQUIRE( CLOSE( map->ComputeOverlapRatio(cloud, pose), 0) );
+
+	delete(map);
+	delete(cloud);
+	delete(emptyVector);
+	delete(pose);
+	delete(displacement);
+	delete(sceneCloud);
+	delete(extendedCloud);
+	}
+
+TEST_CASE( "Entering points are those within the current radius only (PointCloudMap)", "[RadiusQuery]" ) 
+	{
+	PointCloudMap* map = new PointCloudMap();
+	map->SetResolution(0.1);
+
+	//A line of 100 points along the x axis, one per voxel
+	PointCloudPtr cloud = NewPointCloud();
+	for(int x = 0; x < 100; x++)
+		{
+		AddPoint(*cloud, 0.1*x + 0.05, 0.05, 0.05);
+		}
+	VisualPointFeatureVector3DPtr emptyVector = NewVisualPointFeatureVector3D();
+	Pose3DPtr previousPose = NewPose3D();
+	SetPosition(*previousPose, 0, 0, 0);
+	SetOrientation(*previousPose, 0, 0, 0, 1);
+	map->AddPointCloud(cloud, emptyVector, previousPose);
+
+	//Within 3 of x = 2 and not within 3 of x = 0 are the points with x in [3, 5]
+	Pose3DPtr pose = NewPose3D();
+	SetPosition(*pose, 2, 0, 0);
+	SetOrientation(*pose, 0, 0, 0, 1);
+	PointCloudConstPtr enteringCloud = map->GetScenePointCloudEnteringRadius(previousPose, pose, 3);
+	REQUIRE( GetNumberOfPoints(*enteringCloud) == 20 );
+	for(int pointIndex = 0; pointIndex < GetNumberOfPoints(*enteringCloud); pointIndex++)
+		{
+		REQUIRE( GetXCoordinate(*enteringCloud, pointIndex) > 3 );
+		REQUIRE( GetXCoordinate(*enteringCloud, pointIndex) < 5 );
+		}
+
+	//Nothing enters when the center does not move
+	PointCloudConstPtr emptyCloud = map->GetScenePointCloudEnteringRadius(pose, pose, 3);
+	REQUIRE( GetNumberOfPoints(*emptyCloud) == 0 );
+
+	delete(map);
+	delete(cloud);
+	delete(emptyVector);
+	delete(previousPose);
+	delete(pose);
+	delete(enteringCloud);
+	delete(emptyCloud);
+	}
+
+TEST_CASE( "Entering points beyond the cloud capacity are subsampled evenly (PointCloudMap)", "[RadiusQuery]" ) 
+	{
+	PointCloudMap* map = new PointCloudMap();
+	map->SetResolution(0.1);
+
+	//A flat grid 100 meters long with one point per voxel, added as two clouds of 250000 points
+	VisualPointFeatureVector3DPtr emptyVector = NewVisualPointFeatureVector3D();
+	Pose3DPtr pose = NewPose3D();
+	SetPosition(*pose, 0, 0, 0);
+	SetOrientation(*pose, 0, 0, 0, 1);
+	for(int half = 0; half < 2; half++)
+		{
+		PointCloudPtr cloud = NewPointCloud();
+		for(int xIndex = 0; xIndex < 1000; xIndex++)
+			{
+			for(int yIndex = 250 * half; yIndex < 250 * (half + 1); yIndex++)
+				{
+				AddPoint(*cloud, 0.1*xIndex + 0.05, 0.1*yIndex + 0.05, 0.05);
+				}
+			}
+		map->AddPointCloud(cloud, emptyVector, pose);
+		delete(cloud);
+		}
+
+	//All 500000 points enter the radius, each 10 meters strip along x keeps a tenth of the output
+	Pose3DPtr previousPose = NewPose3D();
+	SetPosition(*previousPose, 1000, 0, 0);
+	SetOrientation(*previousPose, 0, 0, 0, 1);
+	SetPosition(*pose, 50, 25, 0);
+	PointCloudConstPtr enteringCloud = map->GetScenePointCloudEnteringRadius(previousPose, pose, 200);
+	REQUIRE( GetNumberOfPoints(*enteringCloud) == MAX_CLOUD_SIZE );
+
+	std::vector<int> stripsList(10, 0);
+	for(int pointIndex = 0; pointIndex < GetNumberOfPoints(*enteringCloud); pointIndex++)
+		{
+		stripsList.at( static_cast<int>(GetXCoordinate(*enteringCloud, pointIndex) / 10) )++;
+		}
+	for(int stripIndex = 0; stripIndex < 10; stripIndex++)
+		{
+		REQUIRE( std::abs(stripsList.at(stripIndex) - MAX_CLOUD_SIZE / 10) < MAX_CLOUD_SIZE / 1000 );
+		}
+
+	delete(map);
+	delete(emptyVector);
+	delete(previousPose);
+	delete(pose);
+	delete(enteringCloud);
+	}
+
+/** @} */
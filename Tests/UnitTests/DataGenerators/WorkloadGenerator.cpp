@@ -0,0 +1,147 @@
+/**
+ * @author Alessandro Bianco
+ */
+
+/**
+ * Unit tests for the synthetic WorkloadGenerator: the generated lists are read back as the tests that consume them read them
+ */
+
+/**
+ * @addtogroup DataGeneratorsTest
+ * @{
+ */
+
+#include <catch.hpp>
+#include <DataGenerators/SyntheticGenerators/WorkloadGenerator.hpp>
+
+#include <opencv2/highgui/highgui.hpp>
+#include <pcl/io/ply_io.h>
+#include <boost/algorithm/string.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+using namespace DataGenerators;
+
+namespace
+{
+	const int NUMBER_OF_FRAMES = 3;
+
+	/**
+	 * As Reconstruction3DTestInterface::ReadImagesList of the Reconstruction3D performance tests: every line is a left and a right image file name.
+	 */
+	void ReadStereoPairsList(const std::string& filePath, std::vector<std::string>& leftList, std::vector<std::string>& rightList)
+	{
+		std::ifstream containerFile(filePath.c_str());
+		REQUIRE( containerFile.good() );
+		std::string line;
+		while (std::getline(containerFile, line))
+		{
+			std::vector<std::string> stringsList;
+			boost::split(stringsList, line, boost::is_any_of(" "));
+			REQUIRE( stringsList.size() == 2 );
+			leftList.push_back(stringsList.at(0));
+			rightList.push_back(stringsList.at(1));
+		}
+	}
+
+	/**
+	 * As ReconstructionExecutor::LoadInputImagesList of the Reconstruction3D key performance measures tests and VisualOdometry::LoadImageFileNames: three header lines,
+	 * then a time, a left and a right image file name on each line.
+	 */
+	void ReadTimedImagesList(const std::string& filePath, std::vector<std::string>& leftList, std::vector<std::string>& rightList)
+	{
+		std::ifstream containerFile(filePath.c_str());
+		REQUIRE( containerFile.good() );
+		std::string line;
+		std::getline(containerFile, line);
+		std::getline(containerFile, line);
+		std::getline(containerFile, line);
+		while (std::getline(containerFile, line))
+		{
+			std::vector<std::string> stringsList;
+			boost::split(stringsList, line, boost::is_any_of(" "));
+			REQUIRE( stringsList.size() == 3 );
+			REQUIRE( std::stod(stringsList.at(0)) >= 0 );
+			leftList.push_back(stringsList.at(1));
+			rightList.push_back(stringsList.at(2));
+		}
+	}
+
+	/**
+	 * As VisualOdometry::LoadPoses: three header lines, then a time, a position and a quaternion on each line.
+	 */
+	int ReadPosesList(const std::string& filePath)
+	{
+		std::ifstream containerFile(filePath.c_str());
+		REQUIRE( containerFile.good() );
+		std::string line;
+		std::getline(containerFile, line);
+		std::getline(containerFile, line);
+		std::getline(containerFile, line);
+		int numberOfPoses = 0;
+		while (std::getline(containerFile, line))
+		{
+			std::vector<std::string> stringsList;
+			boost::split(stringsList, line, boost::is_any_of(" "));
+			REQUIRE( stringsList.size() == 8 );
+			REQUIRE( std::stod(stringsList.at(0)) >= 0 );
+			numberOfPoses++;
+		}
+		return numberOfPoses;
+	}
+}
+
+TEST_CASE( "Generated lists are readable by the workload consumers (Workload generator)", "[lists]" )
+{
+	char outputFolderPath[] = "/tmp/WorkloadGeneratorTest_XXXXXX";
+	REQUIRE( mkdtemp(outputFolderPath) != NULL );
+	const std::string folder = outputFolderPath;
+
+	WorkloadGenerator generator(folder, "../tests/ConfigurationFiles/DataGenerators/WorkloadGenerator_Small.yaml");
+	generator.Generate();
+
+	std::vector<std::string> leftList, rightList, timedLeftList, timedRightList;
+	ReadStereoPairsList(folder + "/StereoPairsList.txt", leftList, rightList);
+	ReadTimedImagesList(folder + "/ImagesList.txt", timedLeftList, timedRightList);
+	REQUIRE( static_cast<int>(leftList.size()) == NUMBER_OF_FRAMES );
+	REQUIRE( leftList == timedLeftList );
+	REQUIRE( rightList == timedRightList );
+	REQUIRE( ReadPosesList(folder + "/PosesList.txt") == NUMBER_OF_FRAMES );
+
+	std::vector<std::string> filesList;
+	for (int frameIndex = 0; frameIndex < NUMBER_OF_FRAMES; frameIndex++)
+	{
+		cv::Mat leftImage = cv::imread(folder + "/" + leftList.at(frameIndex), cv::IMREAD_COLOR);
+		cv::Mat rightImage = cv::imread(folder + "/" + rightList.at(frameIndex), cv::IMREAD_COLOR);
+		REQUIRE( leftImage.cols == 64 );
+		REQUIRE( leftImage.rows == 48 );
+		REQUIRE( rightImage.size() == leftImage.size() );
+
+		std::string cloudFileName = "cloud_" + std::to_string(frameIndex) + ".ply";
+		pcl::PointCloud<pcl::PointXYZ> cloud;
+		REQUIRE( pcl::io::loadPLYFile(folder + "/" + cloudFileName, cloud) == 0 );
+		REQUIRE( cloud.points.size() > 0 );
+
+		filesList.push_back(leftList.at(frameIndex));
+		filesList.push_back(rightList.at(frameIndex));
+		filesList.push_back(cloudFileName);
+	}
+
+	// Cleanup
+	filesList.push_back("StereoPairsList.txt");
+	filesList.push_back("ImagesList.txt");
+	filesList.push_back("PosesList.txt");
+	filesList.push_back("CloudsList.txt");
+	for (unsigned fileIndex = 0; fileIndex < filesList.size(); fileIndex++)
+	{
+		REQUIRE( remove( (folder + "/" + filesList.at(fileIndex)).c_str() ) == 0 );
+	}
+	REQUIRE( rmdir(outputFolderPath) == 0 );
+}
+
+/** @} */